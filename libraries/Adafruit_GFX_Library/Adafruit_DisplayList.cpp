@@ -0,0 +1,914 @@
+/*!
+ * @file Adafruit_DisplayList.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Records drawing as a compact
+ * list of commands and plays it back a strip at a time into a small
+ * GFXcanvas16, which goes to the display in one burst per strip. See
+ * Adafruit_DisplayList.h.
+ *
+ * Each command is an opcode byte, the first and last rows it can touch (so
+ * strips it misses are skipped without looking further), then its
+ * arguments, 16-bit values stored low byte first. Most primitives of
+ * Adafruit_GFX come down to fills, pixels and lines; circles, rounded
+ * rectangles and triangles are kept whole, text as characters, and bitmaps
+ * by address. Playback calls the same Adafruit_GFX functions on the strip
+ * canvas, so what comes out is what drawing on the display would give.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_DisplayList.h"
+
+enum {
+  DL_FILL,   ///< x, y, w, h, color
+  DL_PIXEL,  ///< x, y, color
+  DL_LINE,   ///< x0, y0, x1, y1, color
+  DL_FONT,   ///< GFXfont pointer and runBits, for the characters that follow
+  DL_CHAR,   ///< x, y, color, bg, c, size_x, size_y
+  DL_MONO,   ///< x, y, w, h, color, bg, size_x, size_y, then the bitmap
+  DL_BITMAP, ///< x, y, w, h, color, bg, flags, bitmap pointer
+  DL_RGB,    ///< x, y, w, h, flags, bitmap pointer
+  DL_CIRCLE, ///< x, y, r, color, fill
+  DL_ROUND,  ///< x, y, w, h, radius, color, fill
+  DL_TRI,    ///< x0, y0, x1, y1, x2, y2, color, fill
+  DL_ARC,    ///< x, y, r0, r1, start, end, color
+  DL_THICK   ///< x0, y0, x1, y1, color, width
+};
+
+#define DL_HEADER 5  ///< Opcode, first and last row
+#define DL_PROGMEM 1 ///< Bitmap flag: bitmap is in PROGMEM
+#define DL_OPAQUE 2  ///< Bitmap flag: clear bits are drawn in bg
+
+static inline int16_t get16(const uint8_t *p) {
+  return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static inline const void *getPtr(const uint8_t *p) {
+  const void *ptr;
+  memcpy(&ptr, p, sizeof(ptr));
+  return ptr;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a display list
+   @param    w          Display width in pixels, at the rotation it will be
+                        rendered at
+   @param    h          Display height in pixels, likewise
+   @param    listBytes  RAM for recorded commands. Around 10 bytes per
+                        rectangle, line or character.
+   @param    stripRows  Height of the strips the frame is rendered in. Each
+                        takes w * stripRows * 2 bytes, twice over where
+                        there's SPI DMA, so rendering can overlap sending.
+*/
+/**************************************************************************/
+Adafruit_DisplayList::Adafruit_DisplayList(uint16_t w, uint16_t h,
+                                           uint16_t listBytes,
+                                           uint8_t stripRows)
+    : Adafruit_GFX(w, h), listSize(listBytes), listLen(0), full(false),
+      inText(false), lastFont(NULL), strip(w, stripRows)
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+      ,
+      strip2(w, stripRows)
+#endif
+{
+  if (!(list = (uint8_t *)malloc(listBytes)))
+    listSize = 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the display list, free memory
+*/
+/**************************************************************************/
+Adafruit_DisplayList::~Adafruit_DisplayList(void) {
+  if (list)
+    free(list);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Start a command, if it is on screen and there is room for it
+   @param    op        Command opcode
+   @param    y0        First row the command can draw on
+   @param    y1        Last row the command can draw on
+   @param    argBytes  Bytes of arguments that will follow
+   @returns  true if the caller should go on to put the arguments
+*/
+/**************************************************************************/
+bool Adafruit_DisplayList::record(uint8_t op, int16_t y0, int16_t y1,
+                                  uint8_t argBytes) {
+  if (inText || (y1 < 0) || (y0 >= _height) || (y1 < y0))
+    return false;
+  if (listLen + DL_HEADER + argBytes > listSize) {
+    full = true;
+    return false;
+  }
+  list[listLen++] = op;
+  put16(y0);
+  put16(y1);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add a 16-bit argument to the command being recorded
+   @param    v   Value, signed or not
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::put16(uint16_t v) {
+  list[listLen++] = v;
+  list[listLen++] = v >> 8;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add a pointer argument to the command being recorded
+   @param    p   Pointer
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::putPtr(const void *p) {
+  memcpy(&list[listLen], &p, sizeof(p));
+  listLen += sizeof(p);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Forget everything recorded, to start a new frame
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::clear(void) {
+  listLen = 0;
+  full = false;
+  lastFont = NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a pixel
+   @param    x   x coordinate
+   @param    y   y coordinate
+   @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= _width))
+    return;
+  if (record(DL_PIXEL, y, y, 6)) {
+    put16(x);
+    put16(y);
+    put16(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rectangle
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillRect(int16_t x, int16_t y, int16_t w,
+                                    int16_t h, uint16_t color) {
+  if (w < 0) { // Like Adafruit_SPITFT, negative sizes go left and up
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if ((w == 0) || (x >= _width) || (x + w <= 0))
+    return;
+  if (record(DL_FILL, y, y + h - 1, 10)) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a vertical line
+   @param    x   Top-most x coordinate
+   @param    y   Top-most y coordinate
+   @param    h   Height in pixels
+   @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                         uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a horizontal line
+   @param    x   Left-most x coordinate
+   @param    y   Left-most y coordinate
+   @param    w   Width in pixels
+   @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                         uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Start a new frame, filled with one color. Everything recorded
+   before is covered, so it is dropped from the list.
+   @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillScreen(uint16_t color) {
+  clear();
+  fillRect(0, 0, _width, _height, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a line, drawn with the same Bresenham steps as it would
+   be on the display
+   @param    x0  Start point x coordinate
+   @param    y0  Start point y coordinate
+   @param    x1  End point x coordinate
+   @param    y1  End point y coordinate
+   @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::writeLine(int16_t x0, int16_t y0, int16_t x1,
+                                     int16_t y1, uint16_t color) {
+  if (record(DL_LINE, (y0 < y1) ? y0 : y1, (y0 < y1) ? y1 : y0, 10)) {
+    put16(x0);
+    put16(y0);
+    put16(x1);
+    put16(y1);
+    put16(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a 1-bit bitmap with a background, copying the bitmap
+   into the list, since it is usually a character cell on the stack
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  RAM-resident bitmap, rows padded to whole bytes
+   @param    w       Width of bitmap in pixels, before scaling
+   @param    h       Height of bitmap in pixels, before scaling
+   @param    size_x  Horizontal magnification
+   @param    size_y  Vertical magnification
+   @param    color   16-bit 5-6-5 Color for set bits
+   @param    bg      16-bit 5-6-5 Color for clear bits
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::writeMonoBitmap(int16_t x, int16_t y,
+                                           const uint8_t *bitmap, int16_t w,
+                                           int16_t h, uint8_t size_x,
+                                           uint8_t size_y, uint16_t color,
+                                           uint16_t bg) {
+  uint16_t bytes = ((w + 7) / 8) * h;
+  if (bytes > 255 - 14) { // Too big to copy, record it as runs instead
+    Adafruit_GFX::writeMonoBitmap(x, y, bitmap, w, h, size_x, size_y, color,
+                                  bg);
+    return;
+  }
+  if ((x >= _width) || (x + w * size_x <= 0))
+    return;
+  if (record(DL_MONO, y, y + h * size_y - 1, 14 + bytes)) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+    put16(bg);
+    list[listLen++] = size_x;
+    list[listLen++] = size_y;
+    memcpy(&list[listLen], bitmap, bytes);
+    listLen += bytes;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a circle outline
+    @param    x0   Center-point x coordinate
+    @param    y0   Center-point y coordinate
+    @param    r   Radius of circle
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawCircle(int16_t x0, int16_t y0, int16_t r,
+                                      uint16_t color) {
+  if (record(DL_CIRCLE, y0 - r, y0 + r, 9)) {
+    put16(x0);
+    put16(y0);
+    put16(r);
+    put16(color);
+    list[listLen++] = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a circle with filled color
+    @param    x0   Center-point x coordinate
+    @param    y0   Center-point y coordinate
+    @param    r   Radius of circle
+    @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillCircle(int16_t x0, int16_t y0, int16_t r,
+                                      uint16_t color) {
+  if (record(DL_CIRCLE, y0 - r, y0 + r, 9)) {
+    put16(x0);
+    put16(y0);
+    put16(r);
+    put16(color);
+    list[listLen++] = 1;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a rounded rectangle with no fill color
+    @param    x0   Top left corner x coordinate
+    @param    y0   Top left corner y coordinate
+    @param    w   Width in pixels
+    @param    h   Height in pixels
+    @param    radius   Radius of corner rounding
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawRoundRect(int16_t x0, int16_t y0, int16_t w,
+                                         int16_t h, int16_t radius,
+                                         uint16_t color) {
+  if (record(DL_ROUND, y0, y0 + h - 1, 13)) {
+    put16(x0);
+    put16(y0);
+    put16(w);
+    put16(h);
+    put16(radius);
+    put16(color);
+    list[listLen++] = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a rounded rectangle with fill color
+    @param    x0   Top left corner x coordinate
+    @param    y0   Top left corner y coordinate
+    @param    w   Width in pixels
+    @param    h   Height in pixels
+    @param    radius   Radius of corner rounding
+    @param    color 16-bit 5-6-5 Color to draw/fill with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillRoundRect(int16_t x0, int16_t y0, int16_t w,
+                                         int16_t h, int16_t radius,
+                                         uint16_t color) {
+  if (record(DL_ROUND, y0, y0 + h - 1, 13)) {
+    put16(x0);
+    put16(y0);
+    put16(w);
+    put16(h);
+    put16(radius);
+    put16(color);
+    list[listLen++] = 1;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a triangle, outline or filled
+    @param    fill  1 to fill, 0 for the outline
+    @param    x0  Vertex #0 x coordinate
+    @param    y0  Vertex #0 y coordinate
+    @param    x1  Vertex #1 x coordinate
+    @param    y1  Vertex #1 y coordinate
+    @param    x2  Vertex #2 x coordinate
+    @param    y2  Vertex #2 y coordinate
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::recordTriangle(uint8_t fill, int16_t x0, int16_t y0,
+                                          int16_t x1, int16_t y1, int16_t x2,
+                                          int16_t y2, uint16_t color) {
+  int16_t top = y0, bottom = y0;
+  if (y1 < top)
+    top = y1;
+  if (y2 < top)
+    top = y2;
+  if (y1 > bottom)
+    bottom = y1;
+  if (y2 > bottom)
+    bottom = y2;
+  if (record(DL_TRI, top, bottom, 15)) {
+    put16(x0);
+    put16(y0);
+    put16(x1);
+    put16(y1);
+    put16(x2);
+    put16(y2);
+    put16(color);
+    list[listLen++] = fill;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a triangle with no fill color
+    @param    x0  Vertex #0 x coordinate
+    @param    y0  Vertex #0 y coordinate
+    @param    x1  Vertex #1 x coordinate
+    @param    y1  Vertex #1 y coordinate
+    @param    x2  Vertex #2 x coordinate
+    @param    y2  Vertex #2 y coordinate
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                        int16_t y1, int16_t x2, int16_t y2,
+                                        uint16_t color) {
+  recordTriangle(0, x0, y0, x1, y1, x2, y2, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a triangle with color-fill
+    @param    x0  Vertex #0 x coordinate
+    @param    y0  Vertex #0 y coordinate
+    @param    x1  Vertex #1 x coordinate
+    @param    y1  Vertex #1 y coordinate
+    @param    x2  Vertex #2 x coordinate
+    @param    y2  Vertex #2 y coordinate
+    @param    color 16-bit 5-6-5 Color to fill/draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                        int16_t y1, int16_t x2, int16_t y2,
+                                        uint16_t color) {
+  recordTriangle(1, x0, y0, x1, y1, x2, y2, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record part of a ring with filled color
+    @param    x0      Center-point x coordinate
+    @param    y0      Center-point y coordinate
+    @param    r0      Inner radius, 0 for a pie slice
+    @param    r1      Outer radius
+    @param    start   Starting angle in degrees, 0 being 3 o'clock
+    @param    end     Ending angle in degrees, clockwise from start
+    @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::fillArc(int16_t x0, int16_t y0, int16_t r0,
+                                   int16_t r1, int16_t start, int16_t end,
+                                   uint16_t color) {
+  if (record(DL_ARC, y0 - r1, y0 + r1, 14)) {
+    put16(x0);
+    put16(y0);
+    put16(r0);
+    put16(r1);
+    put16(start);
+    put16(end);
+    put16(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a line more than a pixel wide
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    width  Thickness in pixels, across the line
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawThickLine(int16_t x0, int16_t y0, int16_t x1,
+                                         int16_t y1, uint8_t width,
+                                         uint16_t color) {
+  int16_t reach = width / 2 + 1; // Past the ends, when squared off
+  if (record(DL_THICK, min(y0, y1) - reach, max(y0, y1) + reach, 11)) {
+    put16(x0);
+    put16(y0);
+    put16(x1);
+    put16(y1);
+    put16(color);
+    list[listLen++] = width;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record a character at the cursor, and move the cursor on, as
+            Adafruit_GFX::write() would. The character is kept as one
+            command, not as the pixels drawChar() would make of it.
+    @param  c  The 8-bit ascii character to write
+    @returns 1
+*/
+/**************************************************************************/
+size_t Adafruit_DisplayList::write(uint8_t c) {
+  int16_t x = cursor_x, y = cursor_y;
+  inText = true;
+  Adafruit_GFX::write(c); // Moves the cursor, wrapping like a display would
+  inText = false;
+  if ((c == '\n') || (c == '\r'))
+    return 1;
+  if (cursor_y != y) { // Wrapped to a new line before drawing
+    x = 0;
+    y = cursor_y;
+  }
+
+  // The rows this character covers, if it draws anything at all
+  int16_t bx = x, by = y, minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  bool wrapped = wrap;
+  wrap = false;
+  charBounds(c, &bx, &by, &minx, &miny, &maxx, &maxy);
+  wrap = wrapped;
+  if ((maxx < minx) || (maxy < miny) || (maxx < 0) || (minx >= _width))
+    return 1;
+
+  if (gfxFont != lastFont) {
+    if (!record(DL_FONT, -32768, 32767, sizeof(void *) + 1))
+      return 1;
+    putPtr(gfxFont);
+    list[listLen++] = gfxFontRunBits;
+    lastFont = gfxFont;
+  }
+  if (record(DL_CHAR, miny, maxy, 11)) {
+    put16(x);
+    put16(y);
+    put16(textcolor);
+    put16(textbgcolor);
+    list[listLen++] = c;
+    list[listLen++] = textsize_x;
+    list[listLen++] = textsize_y;
+  }
+  return 1;
+}
+
+/**************************************************************************/
+/*!
+   @brief      Record a PROGMEM-resident 1-bit image, set bits only
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap, which must stay put
+    until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawBitmap(int16_t x, int16_t y,
+                                      const uint8_t bitmap[], int16_t w,
+                                      int16_t h, uint16_t color) {
+  if (record(DL_BITMAP, y, y + h - 1, 13 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+    put16(color);
+    list[listLen++] = DL_PROGMEM;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief      Record a PROGMEM-resident 1-bit image, with a background
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap, which must stay put
+    until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawBitmap(int16_t x, int16_t y,
+                                      const uint8_t bitmap[], int16_t w,
+                                      int16_t h, uint16_t color, uint16_t bg) {
+  if (record(DL_BITMAP, y, y + h - 1, 13 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+    put16(bg);
+    list[listLen++] = DL_PROGMEM | DL_OPAQUE;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief      Record a RAM-resident 1-bit image, set bits only
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap, which must stay put
+    and unchanged until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                      int16_t w, int16_t h, uint16_t color) {
+  if (record(DL_BITMAP, y, y + h - 1, 13 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+    put16(color);
+    list[listLen++] = 0;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief      Record a RAM-resident 1-bit image, with a background
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap, which must stay put
+    and unchanged until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                      int16_t w, int16_t h, uint16_t color,
+                                      uint16_t bg) {
+  if (record(DL_BITMAP, y, y + h - 1, 13 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    put16(color);
+    put16(bg);
+    list[listLen++] = DL_OPAQUE;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a PROGMEM-resident 16-bit image (RGB 5/6/5)
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap, which must stay
+    put until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawRGBBitmap(int16_t x, int16_t y,
+                                         const uint16_t bitmap[], int16_t w,
+                                         int16_t h) {
+  if (record(DL_RGB, y, y + h - 1, 9 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    list[listLen++] = DL_PROGMEM;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Record a RAM-resident 16-bit image (RGB 5/6/5)
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap, which must stay
+    put and unchanged until render()
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::drawRGBBitmap(int16_t x, int16_t y,
+                                         uint16_t *bitmap, int16_t w,
+                                         int16_t h) {
+  if (record(DL_RGB, y, y + h - 1, 9 + sizeof(void *))) {
+    put16(x);
+    put16(y);
+    put16(w);
+    put16(h);
+    list[listLen++] = 0;
+    putPtr(bitmap);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Play the list back into one strip of the frame
+   @param    s    Canvas the strip is drawn in, as wide as the frame
+   @param    top  Frame row the top of the canvas is at
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::renderStrip(GFXcanvas16 &s, int16_t top) {
+  int16_t bottom = top + s.height() - 1;
+  const uint8_t *p = list, *end = list + listLen;
+  s.fillScreen(0); // What's not drawn on comes out black
+  s.setFont(NULL);
+  while (p < end) {
+    uint8_t op = p[0];
+    bool hit = (get16(&p[3]) >= top) && (get16(&p[1]) <= bottom);
+    const uint8_t *a = &p[DL_HEADER];
+    int16_t x = get16(a), y = get16(&a[2]) - top;
+    switch (op) {
+    case DL_FILL:
+      if (hit)
+        s.fillRect(x, y, get16(&a[4]), get16(&a[6]), get16(&a[8]));
+      p = &a[10];
+      break;
+    case DL_PIXEL:
+      if (hit)
+        s.drawPixel(x, y, get16(&a[4]));
+      p = &a[6];
+      break;
+    case DL_LINE:
+      if (hit)
+        s.drawLine(x, y, get16(&a[4]), get16(&a[6]) - top, get16(&a[8]));
+      p = &a[10];
+      break;
+    case DL_FONT:
+      // A GFXfontRLE starts with its GFXfont, so both have the same address
+      if (a[sizeof(void *)])
+        s.setFontRLE((const GFXfontRLE *)getPtr(a));
+      else
+        s.setFont((const GFXfont *)getPtr(a));
+      p = &a[sizeof(void *) + 1];
+      break;
+    case DL_CHAR:
+      if (hit)
+        s.drawChar(x, y, a[8], get16(&a[4]), get16(&a[6]), a[9], a[10]);
+      p = &a[11];
+      break;
+    case DL_MONO: {
+      int16_t w = get16(&a[4]), h = get16(&a[6]);
+      if (hit)
+        s.writeMonoBitmap(x, y, &a[14], w, h, a[12], a[13], get16(&a[8]),
+                          get16(&a[10]));
+      p = &a[14 + ((w + 7) / 8) * h];
+      break;
+    }
+    case DL_BITMAP:
+      if (hit) {
+        const uint8_t *bitmap = (const uint8_t *)getPtr(&a[13]);
+        int16_t w = get16(&a[4]), h = get16(&a[6]);
+        uint16_t color = get16(&a[8]), bg = get16(&a[10]);
+        if (a[12] & DL_PROGMEM) {
+          if (a[12] & DL_OPAQUE)
+            s.drawBitmap(x, y, bitmap, w, h, color, bg);
+          else
+            s.drawBitmap(x, y, bitmap, w, h, color);
+        } else {
+          if (a[12] & DL_OPAQUE)
+            s.drawBitmap(x, y, (uint8_t *)bitmap, w, h, color, bg);
+          else
+            s.drawBitmap(x, y, (uint8_t *)bitmap, w, h, color);
+        }
+      }
+      p = &a[13 + sizeof(void *)];
+      break;
+    case DL_RGB:
+      if (hit) {
+        const uint16_t *bitmap = (const uint16_t *)getPtr(&a[9]);
+        if (a[8] & DL_PROGMEM)
+          s.drawRGBBitmap(x, y, bitmap, get16(&a[4]), get16(&a[6]));
+        else
+          s.drawRGBBitmap(x, y, (uint16_t *)bitmap, get16(&a[4]),
+                          get16(&a[6]));
+      }
+      p = &a[9 + sizeof(void *)];
+      break;
+    case DL_CIRCLE:
+      if (hit) {
+        if (a[8])
+          s.fillCircle(x, y, get16(&a[4]), get16(&a[6]));
+        else
+          s.drawCircle(x, y, get16(&a[4]), get16(&a[6]));
+      }
+      p = &a[9];
+      break;
+    case DL_ROUND:
+      if (hit) {
+        if (a[12])
+          s.fillRoundRect(x, y, get16(&a[4]), get16(&a[6]), get16(&a[8]),
+                          get16(&a[10]));
+        else
+          s.drawRoundRect(x, y, get16(&a[4]), get16(&a[6]), get16(&a[8]),
+                          get16(&a[10]));
+      }
+      p = &a[13];
+      break;
+    case DL_TRI:
+      if (hit) {
+        if (a[14])
+          s.fillTriangle(x, y, get16(&a[4]), get16(&a[6]) - top, get16(&a[8]),
+                         get16(&a[10]) - top, get16(&a[12]));
+        else
+          s.drawTriangle(x, y, get16(&a[4]), get16(&a[6]) - top, get16(&a[8]),
+                         get16(&a[10]) - top, get16(&a[12]));
+      }
+      p = &a[15];
+      break;
+    case DL_ARC:
+      if (hit)
+        s.fillArc(x, y, get16(&a[4]), get16(&a[6]), get16(&a[8]),
+                  get16(&a[10]), get16(&a[12]));
+      p = &a[14];
+      break;
+    case DL_THICK:
+      if (hit)
+        s.drawThickLine(x, y, get16(&a[4]), get16(&a[6]) - top, a[10],
+                        get16(&a[8]));
+      p = &a[11];
+      break;
+    default:
+      return; // Can't happen, but don't run off into the weeds
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the recorded frame on a TFT. The whole screen is one
+   address window, and each strip goes out in one writePixels() burst.
+   With SPI DMA, the next strip is drawn while the last one is sent.
+   @param    tft  Display, at the rotation the list was sized for
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::render(Adafruit_SPITFT &tft) {
+  if (!strip.getBuffer())
+    return;
+  int16_t rows = strip.height();
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, _width, _height);
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  GFXcanvas16 *s = &strip, *next = strip2.getBuffer() ? &strip2 : &strip;
+  for (int16_t top = 0; top < _height; top += rows) {
+    int16_t n = _height - top;
+    renderStrip(*s, top);
+    // Swapped to the display's byte order, DMA sends straight from the
+    // strip, and writePixels() returns as soon as it has started. It first
+    // waits for the transfer before, from the strip that is drawn next.
+    s->byteSwap();
+    tft.writePixels(s->getBuffer(), (uint32_t)_width * ((n < rows) ? n : rows),
+                    false, true);
+    GFXcanvas16 *t = s;
+    s = next;
+    next = t;
+    if (s == next)
+      tft.dmaWait(); // No second strip, so wait before reusing the first
+  }
+  tft.dmaWait();
+#else
+  for (int16_t top = 0; top < _height; top += rows) {
+    int16_t n = _height - top;
+    renderStrip(strip, top);
+    tft.writePixels(strip.getBuffer(),
+                    (uint32_t)_width * ((n < rows) ? n : rows));
+  }
+#endif
+  tft.endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the recorded frame on any other display, or a canvas, a
+   strip at a time with drawRGBBitmap()
+   @param    display  Where to draw, the same size as the list
+*/
+/**************************************************************************/
+void Adafruit_DisplayList::render(Adafruit_GFX &display) {
+  if (!strip.getBuffer())
+    return;
+  int16_t rows = strip.height();
+  for (int16_t top = 0; top < _height; top += rows) {
+    renderStrip(strip, top);
+    display.drawRGBBitmap(0, top, strip, 0, 0, _width, rows); // Clips
+  }
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,122 @@
+/*!
+ * @file Adafruit_DisplayList.h
+ *
+ * Part of Adafruit's GFX graphics library. A display list records what is
+ * drawn to it, compactly, instead of drawing it, then renders the whole
+ * frame into a small strip canvas a band at a time and sends each band to
+ * the display in one burst. Full-screen redraws come out without flicker
+ * and without a full-screen framebuffer: a 320x240 frame takes the list
+ * plus one 320x16 strip (10 KB), where a GFXcanvas16 would take 150 KB.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_DISPLAYLIST_H_
+#define _ADAFRUIT_DISPLAYLIST_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+/*!
+    @brief  Records drawing into a list of commands, and renders the list
+            to a display in horizontal strips. Draw to it with the usual
+            Adafruit_GFX calls, sized as the display is at its current
+            rotation, then call render(). Commands that don't fit in the
+            list are dropped, see overflowed().
+*/
+class Adafruit_DisplayList : public Adafruit_GFX {
+public:
+  Adafruit_DisplayList(uint16_t w, uint16_t h, uint16_t listBytes = 2048,
+                       uint8_t stripRows = 16);
+  ~Adafruit_DisplayList(void);
+
+  // Recording: the Adafruit_GFX primitives everything else is built on
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  void writeMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                       int16_t h, uint8_t size_x, uint8_t size_y,
+                       uint16_t color, uint16_t bg);
+  size_t write(uint8_t c);
+  using Print::write;
+
+  // Shapes kept whole, rather than as the many pixels and lines they make
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                     int16_t radius, uint16_t color);
+  void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                     int16_t radius, uint16_t color);
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                    int16_t y2, uint16_t color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                    int16_t y2, uint16_t color);
+  void fillArc(int16_t x0, int16_t y0, int16_t r0, int16_t r1, int16_t start,
+               int16_t end, uint16_t color);
+  void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                     uint8_t width, uint16_t color);
+
+  // Bitmaps are recorded by address, and must stay put until render()
+  using Adafruit_GFX::drawBitmap;
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color, uint16_t bg);
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w,
+                     int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                     int16_t h);
+
+  void clear(void);
+  void render(Adafruit_SPITFT &tft);
+  void render(Adafruit_GFX &display);
+
+  /**********************************************************************/
+  /*!
+    @brief   Bytes of the list used so far
+    @returns Bytes used, out of the listBytes given to the constructor
+  */
+  /**********************************************************************/
+  uint16_t used(void) const { return listLen; }
+
+  /**********************************************************************/
+  /*!
+    @brief   Whether anything was dropped since clear() for lack of room
+    @returns true if the list ran out of space
+  */
+  /**********************************************************************/
+  bool overflowed(void) const { return full; }
+
+protected:
+  bool record(uint8_t op, int16_t y0, int16_t y1, uint8_t argBytes);
+  void put16(uint16_t v);
+  void putPtr(const void *p);
+  void recordTriangle(uint8_t fill, int16_t x0, int16_t y0, int16_t x1,
+                      int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+  void renderStrip(GFXcanvas16 &strip, int16_t top);
+
+private:
+  uint8_t *list;           ///< Recorded commands
+  uint16_t listSize;       ///< Bytes allocated for the list
+  uint16_t listLen;        ///< Bytes of the list in use
+  bool full;               ///< A command didn't fit since clear()
+  bool inText;             ///< write() is drawing, don't record primitives
+  const GFXfont *lastFont; ///< Font of the last character recorded
+  GFXcanvas16 strip;       ///< Band of the frame being rendered
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  GFXcanvas16 strip2; ///< Rendered into while DMA sends the other strip
+#endif
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_DISPLAYLIST_H_
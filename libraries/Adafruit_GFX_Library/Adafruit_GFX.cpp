@@ -32,6 +32,7 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 #include "Adafruit_GFX.h"
+#include <math.h>
 #include "glcdfont.c"
 #ifdef __AVR__
 #include <avr/pgmspace.h>
@@ -99,6 +100,567 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
   }
 #endif
 
+// Clip a w x h copy from (sx,sy) in a source of sw x sh pixels to (dx,dy) in
+// a destination of dw x dh pixels, all in raw (rotation 0) coordinates.
+// Returns false if nothing is left to copy.
+static bool clipBlit(int16_t sw, int16_t sh, int16_t dw, int16_t dh,
+                     int16_t &sx, int16_t &sy, int16_t &w, int16_t &h,
+                     int16_t &dx, int16_t &dy) {
+  if (sx < 0) {
+    w += sx;
+    dx -= sx;
+    sx = 0;
+  }
+  if (sy < 0) {
+    h += sy;
+    dy -= sy;
+    sy = 0;
+  }
+  if (dx < 0) {
+    w += dx;
+    sx -= dx;
+    dx = 0;
+  }
+  if (dy < 0) {
+    h += dy;
+    sy -= dy;
+    dy = 0;
+  }
+  if (w > sw - sx)
+    w = sw - sx;
+  if (h > sh - sy)
+    h = sh - sy;
+  if (w > dw - dx)
+    w = dw - dx;
+  if (h > dh - dy)
+    h = dh - dy;
+  return (w > 0) && (h > 0);
+}
+
+// Combine n bytes of src into dst with a raster op.  Pixels of 8 and 16 bits
+// combine the same way byte by byte, so this serves both deeper canvases.
+// Works a 32-bit word at a time when both rows share an alignment, and
+// handles rows that overlap within one canvas.
+static void ropBytes(uint8_t *dst, const uint8_t *src, size_t n, GFXrop rop) {
+  if (rop == GFX_ROP_COPY) {
+    memmove(dst, src, n);
+    return;
+  }
+  if ((dst > src) && (dst < src + n)) { // Overlapping, go from the end
+    while (n--) {
+      switch (rop) {
+      case GFX_ROP_AND:
+        dst[n] &= src[n];
+        break;
+      case GFX_ROP_OR:
+        dst[n] |= src[n];
+        break;
+      default:
+        dst[n] ^= src[n];
+        break;
+      }
+    }
+    return;
+  }
+  // Word at a time needs both pointers 32-bit aligned, and rows starting
+  // at different distances past a word boundary never will be. Writing
+  // ahead never clobbers unread source here, as dst is not above src.
+  if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0) {
+    while ((n > 0) && ((uintptr_t)dst & 3)) {
+      switch (rop) {
+      case GFX_ROP_AND:
+        *dst++ &= *src++;
+        break;
+      case GFX_ROP_OR:
+        *dst++ |= *src++;
+        break;
+      default:
+        *dst++ ^= *src++;
+        break;
+      }
+      n--;
+    }
+    uint32_t *d32 = (uint32_t *)dst;
+    const uint32_t *s32 = (const uint32_t *)src;
+    size_t words = n / 4;
+    switch (rop) {
+    case GFX_ROP_AND:
+      for (size_t i = 0; i < words; i++)
+        d32[i] &= s32[i];
+      break;
+    case GFX_ROP_OR:
+      for (size_t i = 0; i < words; i++)
+        d32[i] |= s32[i];
+      break;
+    default:
+      for (size_t i = 0; i < words; i++)
+        d32[i] ^= s32[i];
+      break;
+    }
+    dst += words * 4;
+    src += words * 4;
+    n -= words * 4;
+  }
+  while (n--) {
+    switch (rop) {
+    case GFX_ROP_AND:
+      *dst++ &= *src++;
+      break;
+    case GFX_ROP_OR:
+      *dst++ |= *src++;
+      break;
+    default:
+      *dst++ ^= *src++;
+      break;
+    }
+  }
+}
+
+// Limit a scroll distance to the size of the canvas
+static int16_t clampScroll(int16_t d, int16_t size) {
+  return (d > size) ? size : (d < -size) ? -size : d;
+}
+
+// Expand w bits of a 1-bit canvas row, starting at bit sx, into pixels. Set
+// bits become color and clear bits bg, or are left alone if bg == color.
+template <typename T>
+static void expandBits(T *dst, const uint8_t *src, int16_t sx, int16_t w,
+                       T color, T bg) {
+  src += sx / 8;
+  uint8_t bits = *src++ << (sx & 7);
+  int8_t left = 8 - (sx & 7); // Bits still to use in 'bits'
+  for (int16_t i = 0; i < w; i++, left--, bits <<= 1) {
+    if (!left) {
+      bits = *src++;
+      left = 8;
+    }
+    if (bits & 0x80)
+      dst[i] = color;
+    else if (bg != color)
+      dst[i] = bg;
+  }
+}
+
+// Copy w pixels, skipping those of the transparent color. Goes right to
+// left if backwards, for rows overlapping within one canvas.
+template <typename T>
+static void keyPixels(T *dst, const T *src, int16_t w, T transparent,
+                      bool backwards) {
+  if (backwards) {
+    for (int16_t i = w - 1; i >= 0; i--) {
+      if (src[i] != transparent)
+        dst[i] = src[i];
+    }
+  } else {
+    for (int16_t i = 0; i < w; i++) {
+      if (src[i] != transparent)
+        dst[i] = src[i];
+    }
+  }
+}
+
+// Mix fg into bg by a, 0 (none) to 32 (all), both 5-6-5. Green is spread
+// into the top half of a 32-bit word, so all three channels mix in one
+// multiply with room to carry between them.
+static inline uint16_t mix565(uint16_t bg, uint16_t fg, uint32_t a) {
+  uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+  uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+  b = (b + (((f - b) * a) >> 5)) & 0x07E0F81F;
+  return (uint16_t)(b | (b >> 16));
+}
+
+// SCANLINE FILLS ----------------------------------------------------------
+
+// Polygons, arcs and thick lines are all filled as spans found a row at a
+// time. The scanners below work in 1/16 pixel units, pixel centers falling
+// on multiples of 16. Plain fills sample each pixel at its center and count
+// the outline as inside, so a rectangle from (0,0) to (9,9) fills 10x10 as
+// fillRect() would. Anti-aliased fills take four samples a pixel, at +/-4
+// units each way, where a sample on the outline is in only on the top and
+// left sides, so shapes that share an edge don't both cover it.
+
+/// One polygon edge, top to bottom. Its crossing with the current row is
+/// x + e / (yBot - yTop), kept exact from row to row the way Bresenham's
+/// line algorithm does.
+struct GFXedge {
+  int32_t yTop, yBot; ///< Rows it spans, yTop < yBot
+  int32_t xTop, dx;   ///< Where it starts, and how far across it goes
+  int32_t x, e;       ///< Crossing with the current row
+  int32_t q, r;       ///< What x and e gain from one row to the next
+  int8_t dir;         ///< +1 if the outline runs down it, -1 if up
+};
+
+// Floor of n / d for d > 0, and what's left over
+static int32_t floorDiv(int64_t n, int32_t d, int32_t *rem) {
+  int32_t q = (int32_t)(n / d), r = (int32_t)(n - (int64_t)q * d);
+  if (r < 0) {
+    q--;
+    r += d;
+  }
+  *rem = r;
+  return q;
+}
+
+// Add the edge (x0,y0)-(x1,y1) to a table kept in order of yTop. Horizontal
+// edges are left out: the rows either side of them account for them.
+static void addEdge(GFXedge *edges, uint16_t &n, int32_t x0, int32_t y0,
+                    int32_t x1, int32_t y1) {
+  if (y0 == y1)
+    return;
+  int8_t dir = 1;
+  if (y0 > y1) {
+    int32_t t = x0;
+    x0 = x1;
+    x1 = t;
+    t = y0;
+    y0 = y1;
+    y1 = t;
+    dir = -1;
+  }
+  uint16_t i = n++;
+  for (; i && (edges[i - 1].yTop > y0); i--)
+    edges[i] = edges[i - 1];
+  edges[i].yTop = y0;
+  edges[i].yBot = y1;
+  edges[i].xTop = x0;
+  edges[i].dx = x1 - x0;
+  edges[i].dir = dir;
+}
+
+// Round 1/16 pixel units from float
+static inline int32_t toUnits(float v) { return (int32_t)floorf(v + 0.5f); }
+
+// First and last sample rows (in units) from top to bottom that are on a
+// screen of height pixels: each 16p for plain fills, 8k+4 for anti-aliased
+static int32_t firstRow(int32_t top, bool aa) {
+  if (aa)
+    return (top < -4) ? -4 : ((top + 3) >> 3) * 8 + 4;
+  return (top < 0) ? 0 : ((top + 15) >> 4) << 4;
+}
+
+static int32_t lastRow(int32_t bottom, bool aa, int16_t height) {
+  int32_t last = 16 * (int32_t)height - (aa ? 12 : 16);
+  return (bottom < last) ? bottom : last;
+}
+
+// Find the spans inside a table of n edges, a row at a time, and pass them
+// to sink.span(). Inside is anywhere the outline winds around a nonzero
+// number of times, so outlines that cross themselves fill solid. Plain fills
+// take in the polygon just above and just below each row, so flat tops and
+// bottoms and lone points that land on a row are drawn. act has room for n
+// edge numbers, the active edge table.
+template <class Sink>
+static void scanEdges(GFXedge *edges, uint16_t n, uint16_t *act, bool aa,
+                      int16_t height, Sink &sink) {
+  if (!n)
+    return;
+  int32_t step = aa ? 8 : 16, bottom = edges[0].yBot;
+  for (uint16_t i = 1; i < n; i++) {
+    if (edges[i].yBot > bottom)
+      bottom = edges[i].yBot;
+  }
+  int32_t last = lastRow(bottom, aa, height);
+  uint16_t next = 0, na = 0;
+  for (int32_t y = firstRow(edges[0].yTop, aa); y <= last; y += step) {
+    // Drop edges that ended above this row, and start those that begin
+    uint16_t j = 0;
+    for (uint16_t i = 0; i < na; i++) {
+      if ((edges[act[i]].yBot > y) || (!aa && (edges[act[i]].yBot == y)))
+        act[j++] = act[i];
+    }
+    na = j;
+    for (; (next < n) && (edges[next].yTop <= y); next++) {
+      GFXedge &e = edges[next];
+      if ((e.yBot > y) || (!aa && (e.yBot == y))) {
+        int32_t dy = e.yBot - e.yTop;
+        e.x = e.xTop + floorDiv((int64_t)(y - e.yTop) * e.dx, dy, &e.e);
+        e.q = floorDiv((int64_t)step * e.dx, dy, &e.r);
+        act[na++] = next;
+      }
+    }
+
+    // Put them in order across the row; mostly they still are from the last
+    for (uint16_t i = 1; i < na; i++) {
+      uint16_t k = act[i], m = i;
+      const GFXedge &e = edges[k];
+      for (; m; m--) {
+        const GFXedge &p = edges[act[m - 1]];
+        if ((p.x < e.x) || ((p.x == e.x) && ((p.e > 0) <= (e.e > 0))))
+          break;
+        act[m] = act[m - 1];
+      }
+      act[m] = k;
+    }
+
+    // Walk across, counting windings below the row and above it
+    int16_t below = 0, above = 0;
+    const GFXedge *left = NULL;
+    for (uint16_t i = 0; i < na; i++) {
+      const GFXedge &e = edges[act[i]];
+      bool was = below || above;
+      if (e.yBot > y)
+        below += e.dir;
+      if (!aa && (e.yTop < y))
+        above += e.dir;
+      bool now = below || above;
+      if (now && !was)
+        left = &e;
+      else if (was && !now)
+        sink.span(y, left->x, left->e > 0, e.x, e.e > 0);
+    }
+
+    for (uint16_t i = 0; i < na; i++) { // Step down to the next row
+      GFXedge &e = edges[act[i]];
+      e.x += e.q;
+      e.e += e.r;
+      if (e.e >= e.yBot - e.yTop) {
+        e.x++;
+        e.e -= e.yBot - e.yTop;
+      }
+    }
+  }
+}
+
+// Fill a polygon of n x,y pairs, in pixels
+template <class Sink>
+static void scanPolygon(const int16_t *points, uint16_t n, bool aa,
+                        int16_t height, Sink &sink) {
+  if (!n || (n > SIZE_MAX / (sizeof(GFXedge) + sizeof(uint16_t))))
+    return;
+  GFXedge *edges = (GFXedge *)malloc(n * (sizeof(GFXedge) + sizeof(uint16_t)));
+  if (!edges)
+    return;
+  uint16_t ne = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    uint16_t j = (i + 1 < n) ? i + 1 : 0;
+    addEdge(edges, ne, points[2 * i] * 16L, points[2 * i + 1] * 16L,
+            points[2 * j] * 16L, points[2 * j + 1] * 16L);
+  }
+  scanEdges(edges, ne, (uint16_t *)&edges[n], aa, height, sink);
+  free(edges);
+}
+
+// Hand a span found in floating point pixels to sink.span()
+template <class Sink>
+static void floatSpan(Sink &sink, int32_t y, float l, float r) {
+  l *= 16;
+  r *= 16;
+  float fl = floorf(l), fr = floorf(r);
+  sink.span(y, (int32_t)fl, l > fl, (int32_t)fr, r > fr);
+}
+
+// Where m * x <= c along a row, as lo to hi (lo > hi if nowhere)
+static void halfLine(float m, float c, float &lo, float &hi) {
+  const float far = 1e9f;
+  if (fabsf(m) < 1e-6f) {
+    lo = (c >= 0) ? -far : far;
+    hi = -lo;
+  } else if (m > 0) {
+    lo = -far;
+    hi = c / m;
+  } else {
+    lo = c / m;
+    hi = far;
+  }
+}
+
+// Fill the part of a ring, r0 to r1 pixels out from (cx,cy), from start
+// degrees clockwise to end, 0 being 3 o'clock. Each row is solved directly:
+// where it meets the two circles, then which side of the two edge rays.
+template <class Sink>
+static void scanArc(float cx, float cy, float r0, float r1, int16_t start,
+                    int16_t end, bool aa, int16_t height, Sink &sink) {
+  if ((r1 < 0) || (r0 > r1))
+    return;
+  int32_t sweep = (int32_t)end - start;
+  bool full = (sweep >= 360) || (sweep <= -360);
+  sweep %= 360;
+  if (sweep < 0)
+    sweep += 360;
+  if (!full && !sweep)
+    return;
+  float ax = 0, ay = 0, bx = 0, by = 0;
+  if (!full) {
+    const float rad = (float)(M_PI / 180);
+    ax = cosf(start * rad);
+    ay = sinf(start * rad);
+    bx = cosf((start + sweep) * rad);
+    by = sinf((start + sweep) * rad);
+  }
+
+  int32_t last = lastRow((int32_t)ceilf((cy + r1) * 16), aa, height);
+  for (int32_t y = firstRow((int32_t)floorf((cy - r1) * 16), aa); y <= last;
+       y += aa ? 8 : 16) {
+    float dy = y / 16.0f - cy, h = r1 * r1 - dy * dy;
+    if (h < 0)
+      continue;
+    // Across the ring: one stretch, or two either side of the hole
+    float ring[4], wedge[4];
+    uint8_t nRing = 1, nWedge = 1;
+    ring[1] = sqrtf(h);
+    ring[0] = -ring[1];
+    if (dy * dy < r0 * r0) {
+      ring[3] = ring[1];
+      ring[2] = sqrtf(r0 * r0 - dy * dy);
+      ring[1] = -ring[2];
+      nRing = 2;
+    }
+    // Within the sweep: clockwise of the start ray and anticlockwise of the
+    // end ray, or either for sweeps over half a turn
+    if (full) {
+      wedge[0] = ring[0];
+      wedge[1] = ring[2 * nRing - 1];
+    } else {
+      halfLine(ay, ax * dy, wedge[0], wedge[1]);
+      halfLine(-by, -bx * dy, wedge[2], wedge[3]);
+      if (sweep <= 180) {
+        wedge[0] = max(wedge[0], wedge[2]);
+        wedge[1] = min(wedge[1], wedge[3]);
+      } else if (wedge[2] > wedge[3]) {
+        // Just the first
+      } else if (wedge[0] > wedge[1]) {
+        wedge[0] = wedge[2];
+        wedge[1] = wedge[3];
+      } else if ((wedge[2] <= wedge[1]) && (wedge[0] <= wedge[3])) {
+        wedge[0] = min(wedge[0], wedge[2]); // They overlap
+        wedge[1] = max(wedge[1], wedge[3]);
+      } else {
+        nWedge = 2;
+        if (wedge[2] < wedge[0]) {
+          float t0 = wedge[0], t1 = wedge[1];
+          wedge[0] = wedge[2];
+          wedge[1] = wedge[3];
+          wedge[2] = t0;
+          wedge[3] = t1;
+        }
+      }
+    }
+    for (uint8_t i = 0; i < nRing; i++) {
+      for (uint8_t j = 0; j < nWedge; j++) {
+        float l = max(ring[2 * i], wedge[2 * j]);
+        float r = min(ring[2 * i + 1], wedge[2 * j + 1]);
+        if (l <= r)
+          floatSpan(sink, y, cx + l, cx + r);
+      }
+    }
+  }
+}
+
+// Edges of a line w pixels thick from (x0,y0) to (x1,y1), squared off at
+// the ends. A line with no length is a w x w square.
+static void thickLineEdges(GFXedge *edges, uint16_t &n, float x0, float y0,
+                           float x1, float y1, float w) {
+  float dx = x1 - x0, dy = y1 - y0, len = sqrtf(dx * dx + dy * dy);
+  float k = w * 8; // Half the width, in units
+  x0 *= 16;
+  y0 *= 16;
+  x1 *= 16;
+  y1 *= 16;
+  if (len == 0) {
+    x0 -= k;
+    x1 += k;
+    dx = 1;
+    dy = 0;
+    len = 1;
+  }
+  float nx = -dy * k / len, ny = dx * k / len;
+  int32_t cx[4] = {toUnits(x0 + nx), toUnits(x1 + nx), toUnits(x1 - nx),
+                   toUnits(x0 - nx)};
+  int32_t cy[4] = {toUnits(y0 + ny), toUnits(y1 + ny), toUnits(y1 - ny),
+                   toUnits(y0 - ny)};
+  for (uint8_t i = 0; i < 4; i++)
+    addEdge(edges, n, cx[i], cy[i], cx[(i + 1) & 3], cy[(i + 1) & 3]);
+}
+
+// Spans found by the scanners, drawn with writeFastHLine()
+struct GFXspanLines {
+  Adafruit_GFX *gfx; ///< Where to draw
+  uint16_t color;    ///< 16-bit 5-6-5 Color to draw with
+
+  // Pixels whose centers are in the span, or the one nearest the middle
+  // of a span too thin to hold any
+  void span(int32_t y, int32_t lx, bool lf, int32_t rx, bool rf) {
+    (void)rf;
+    int32_t l = (lx + 15 + lf) >> 4, r = rx >> 4;
+    if (l > r)
+      l = r = (lx + rx + 16) >> 5;
+    if ((r < 0) || (l >= gfx->width()))
+      return;
+    if (l < 0)
+      l = 0;
+    if (r >= gfx->width())
+      r = gfx->width() - 1;
+    gfx->writeFastHLine(l, y >> 4, r - l + 1, color);
+  }
+};
+
+// Spans found by the scanners, counted up into how many of each pixel's
+// four samples they cover, then blended onto a GFXcanvas16 a row at a time
+class GFXspanCover {
+public:
+  GFXspanCover(GFXcanvas16 *c, uint16_t color)
+      : canvas(c), color(color), row(0), lo(INT16_MAX), hi(-1) {
+    cover = (uint8_t *)calloc(c->width(), 1);
+  }
+  ~GFXspanCover(void) {
+    flush();
+    free(cover);
+  }
+
+  // Samples from the first at or right of the left end to the last left of
+  // the right end. Sample k is at 8k+4 units, in pixel (k+1)/2.
+  void span(int32_t y, int32_t lx, bool lf, int32_t rx, bool rf) {
+    int32_t k0 = (lx + 3 + lf) >> 3, k1 = (rx - 5 + rf) >> 3;
+    int32_t kMax = 2 * (int32_t)canvas->width() - 2;
+    if (k0 < -1)
+      k0 = -1;
+    if (k1 > kMax)
+      k1 = kMax;
+    if (!cover || (k0 > k1))
+      return;
+    int16_t p = (y + 4) >> 4;
+    if (p != row) {
+      flush();
+      row = p;
+    }
+    for (int32_t k = k0; k <= k1; k++)
+      cover[(k + 1) >> 1]++;
+    lo = min(lo, (int16_t)((k0 + 1) >> 1));
+    hi = max(hi, (int16_t)((k1 + 1) >> 1));
+  }
+
+  // Draw the row: fully covered runs as lines, the edges blended
+  void flush(void) {
+    int16_t run = -1;
+    for (int16_t x = lo; x <= hi; x++) {
+      uint8_t c = cover[x];
+      cover[x] = 0;
+      if (c == 4) {
+        if (run < 0)
+          run = x;
+        continue;
+      }
+      if (run >= 0) {
+        canvas->drawFastHLine(run, row, x - run, color);
+        run = -1;
+      }
+      if (c)
+        canvas->drawPixel(x, row,
+                          mix565(canvas->getPixel(x, row), color, c * 8));
+    }
+    if (run >= 0)
+      canvas->drawFastHLine(run, row, hi + 1 - run, color);
+    lo = INT16_MAX;
+    hi = -1;
+  }
+
+private:
+  GFXcanvas16 *canvas;
+  uint16_t color;
+  uint8_t *cover; // Samples covered in each pixel of the row, 0 to 4
+  int16_t row, lo, hi;
+};
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX context for graphics! Can only be done by a
@@ -117,6 +679,7 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  gfxFontRunBits = 0;
 }
 
 /**************************************************************************/
@@ -244,6 +807,45 @@ void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
   fillRect(x, y, w, h, color);
 }
 
+/**************************************************************************/
+/*!
+   @brief    Write a 1-bit bitmap from RAM with a solid background, each bit
+   magnified to a size_x by size_y block. Used for opaque text. This version
+   writes each run of same-colored bits in a row as one line or rectangle;
+   overwrite in subclasses that can stream a whole area of pixels at once!
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  Byte array, rows MSB first, each padded to whole bytes
+    @param    w   Width of bitmap in bits
+    @param    h   Height of bitmap in bits
+    @param    size_x  Magnification in X-axis, 1 is 'original' size
+    @param    size_y  Magnification in Y-axis, 1 is 'original' size
+    @param    color 16-bit 5-6-5 Color for set bits
+    @param    bg 16-bit 5-6-5 Color for clear bits
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                                   int16_t w, int16_t h, uint8_t size_x,
+                                   uint8_t size_y, uint16_t color,
+                                   uint16_t bg) {
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++, y += size_y, bitmap += byteWidth) {
+    int16_t i = 0;
+    while (i < w) {
+      uint8_t set = bitmap[i >> 3] & (0x80 >> (i & 7));
+      int16_t start = i;
+      while ((++i < w) && (!(bitmap[i >> 3] & (0x80 >> (i & 7))) == !set))
+        ;
+      if (size_y == 1)
+        writeFastHLine(x + start * size_x, y, (i - start) * size_x,
+                       set ? color : bg);
+      else
+        writeFillRect(x + start * size_x, y, (i - start) * size_x, size_y,
+                      set ? color : bg);
+    }
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    End a display-writing routine, overwrite in subclasses if
@@ -700,6 +1302,171 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+   @brief   Draw a polygon outline, closed back to its first point
+    @param    points  x,y pairs of its corners, n of them, in RAM
+    @param    n       Number of corners
+    @param    color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawPolygon(const int16_t *points, uint16_t n,
+                               uint16_t color) {
+  for (uint16_t i = 0; i < n; i++) {
+    uint16_t j = (i + 1 < n) ? i + 1 : 0;
+    drawLine(points[2 * i], points[2 * i + 1], points[2 * j],
+             points[2 * j + 1], color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a polygon with filled color: convex or concave, and may cross
+   itself (where the outline winds round a point at all, it is filled).
+   Drawn as one writeFastHLine() per span, so one address window each on a
+   display. Temporarily needs about 40 bytes of RAM per corner.
+    @param    points  x,y pairs of its corners, n of them, in RAM
+    @param    n       Number of corners
+    @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillPolygon(const int16_t *points, uint16_t n,
+                               uint16_t color) {
+  GFXspanLines lines = {this, color};
+  startWrite();
+  scanPolygon(points, n, false, _height, lines);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw part of a ring with filled color, e.g. a gauge's scale or a
+   pie chart slice. Goes clockwise from start to end.
+    @param    x0      Center-point x coordinate
+    @param    y0      Center-point y coordinate
+    @param    r0      Inner radius, 0 for a pie slice
+    @param    r1      Outer radius
+    @param    start   Starting angle in degrees, 0 being 3 o'clock and 90
+                      6 o'clock
+    @param    end     Ending angle in degrees. A whole ring if 360 or more
+                      from start.
+    @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillArc(int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+                           int16_t start, int16_t end, uint16_t color) {
+  GFXspanLines lines = {this, color};
+  startWrite();
+  scanArc(x0, y0, r0, r1, start, end, false, _height, lines);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a line more than a pixel wide, squared off at the ends, e.g.
+   a gauge needle
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    width  Thickness in pixels, across the line
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawThickLine(int16_t x0, int16_t y0, int16_t x1,
+                                 int16_t y1, uint8_t width, uint16_t color) {
+  if (width <= 1) {
+    drawLine(x0, y0, x1, y1, color);
+    return;
+  }
+  GFXedge edges[4];
+  uint16_t act[4], n = 0;
+  GFXspanLines lines = {this, color};
+  thickLineEdges(edges, n, x0, y0, x1, y1, width);
+  startWrite();
+  scanEdges(edges, n, act, false, _height, lines);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw connected lines more than a pixel wide, e.g. a chart trace,
+   with the corners between them filled in. Squared off at the two ends.
+    @param    points  x,y pairs of the points to join, n of them, in RAM
+    @param    n       Number of points
+    @param    width   Thickness in pixels, across the lines
+    @param    color   16-bit 5-6-5 Color to draw with
+    @param    join    How to fill the outside of each corner
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawThickPolyline(const int16_t *points, uint16_t n,
+                                     uint8_t width, uint16_t color,
+                                     GFXjoin join) {
+  if (width <= 1) {
+    for (uint16_t i = 1; i < n; i++)
+      drawLine(points[2 * i - 2], points[2 * i - 1], points[2 * i],
+               points[2 * i + 1], color);
+    return;
+  }
+  GFXedge edges[4];
+  uint16_t act[4], ne;
+  GFXspanLines lines = {this, color};
+  float hw = width * 8.0f; // Half the width, in 1/16 pixel units
+  float pdx = 0, pdy = 0;  // Direction of the last segment drawn
+  startWrite();
+  for (uint16_t i = 1; i < n; i++) {
+    float x0 = points[2 * i - 2], y0 = points[2 * i - 1];
+    float dx = points[2 * i] - x0, dy = points[2 * i + 1] - y0;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len == 0)
+      continue; // Nothing to join to
+    dx /= len;
+    dy /= len;
+    float cross = pdx * dy - pdy * dx, dot = pdx * dx + pdy * dy;
+    if ((pdx || pdy) && (cross || (dot < 0))) {
+      // Fill the outside of the corner, which is the left of a right turn
+      if (join == GFX_JOIN_ROUND) {
+        scanArc(x0, y0, 0, width / 2.0f, 0, 360, false, _height, lines);
+      } else {
+        float s = (cross > 0) ? -hw : hw, vx = x0 * 16, vy = y0 * 16;
+        float ax = vx - pdy * s, ay = vy + pdx * s;
+        float bx = vx - dy * s, by = vy + dx * s;
+        int32_t cx[4] = {toUnits(vx), toUnits(ax), toUnits(bx), 0};
+        int32_t cy[4] = {toUnits(vy), toUnits(ay), toUnits(by), 0};
+        uint8_t corners = 3;
+        if ((join == GFX_JOIN_MITER) && (1 + dot >= 0.125f)) {
+          // No more than 4 half-widths out, or it's a bevel
+          float m = s / (1 + dot);
+          cx[3] = cx[2];
+          cy[3] = cy[2];
+          cx[2] = toUnits(vx - (pdy + dy) * m);
+          cy[2] = toUnits(vy + (pdx + dx) * m);
+          corners = 4;
+        }
+        ne = 0;
+        for (uint8_t c = 0; c < corners; c++) {
+          uint8_t d = (c + 1 < corners) ? c + 1 : 0;
+          addEdge(edges, ne, cx[c], cy[c], cx[d], cy[d]);
+        }
+        scanEdges(edges, ne, act, false, _height, lines);
+      }
+    }
+    ne = 0;
+    thickLineEdges(edges, ne, x0, y0, points[2 * i], points[2 * i + 1],
+                   width);
+    scanEdges(edges, ne, act, false, _height, lines);
+    pdx = dx;
+    pdy = dy;
+  }
+  if (n && !pdx && !pdy) { // All one point
+    ne = 0;
+    thickLineEdges(edges, ne, points[0], points[1], points[0], points[1],
+                   width);
+    scanEdges(edges, ne, act, false, _height, lines);
+  }
+  endWrite();
+}
+
 // BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
 
 /**************************************************************************/
@@ -1096,9 +1863,66 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
   }
   endWrite();
 }
+/**************************************************************************/
+/*!
+   @brief   Draw a rectangle of a 16-bit canvas (RGB 5/6/5) at the specified
+   (x,y) position, e.g. a sprite sheet frame or the changed part of an
+   offscreen UI. For 16-bit display devices; no color reduction performed.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    canvas  16-bit canvas to draw from
+    @param    cx  Left edge of the rectangle in the canvas, raw (rotation 0)
+    @param    cy  Top edge of the rectangle in the canvas, raw (rotation 0)
+    @param    w   Width of the rectangle in pixels
+    @param    h   Height of the rectangle in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y,
+                                 const GFXcanvas16 &canvas, int16_t cx,
+                                 int16_t cy, int16_t w, int16_t h) {
+  uint16_t *bitmap = canvas.getBuffer();
+  if (!bitmap || !clipBlit(canvas.WIDTH, canvas.HEIGHT, _width, _height, cx,
+                           cy, w, h, x, y))
+    return;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      writePixel(x + i, y, bitmap[(cy + j) * canvas.WIDTH + cx + i]);
+    }
+  }
+  endWrite();
+}
 
 // TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
 
+// Writes run set pixels of a glyph row from (x,y), magnified if need be
+static void writeGlyphRun(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t run,
+                          uint8_t size_x, uint8_t size_y, uint16_t color) {
+  if (size_x == 1 && size_y == 1)
+    gfx->writeFastHLine(x, y, run, color);
+  else
+    gfx->writeFillRect(x, y, run * size_x, size_y, color);
+}
+
+// Reads the MSB-first fields of a run-length coded glyph (see gfxfont.h)
+struct GFXrunReader {
+  const uint8_t *p;
+  uint8_t bits, left;
+  uint8_t read(uint8_t n) {
+    uint8_t v = 0;
+    while (n--) {
+      if (!left) {
+        bits = pgm_read_byte(p++);
+        left = 8;
+      }
+      v = (v << 1) | (bits >> 7);
+      bits <<= 1;
+      left--;
+    }
+    return v;
+  }
+};
+
 // Draw a character
 /**************************************************************************/
 /*!
@@ -1147,29 +1971,38 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       c++; // Handle 'classic' charset behavior
 
     startWrite();
-    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
-      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
-                          color);
-        } else if (bg != color) {
+    if (bg != color) { // Opaque, turn the 6x8 cell into rows and write it all
+      uint8_t cell[8] = {0}; // Last column stays clear, the gap between chars
+      for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
+        uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+        for (int8_t j = 0; line; j++, line >>= 1) {
+          if (line & 1)
+            cell[j] |= 0x80 >> i;
+        }
+      }
+      writeMonoBitmap(x, y, cell, 6, 8, size_x, size_y, color, bg);
+    } else { // Transparent, write each run of set pixels down a column
+      for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
+        uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+        for (int8_t j = 0; line;) {
+          if (!(line & 1)) {
+            j++;
+            line >>= 1;
+            continue;
+          }
+          int8_t start = j;
+          do {
+            j++;
+            line >>= 1;
+          } while (line & 1);
           if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
+            writeFastVLine(x + i, y + start, j - start, color);
           else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+            writeFillRect(x + i * size_x, y + start * size_y, size_x,
+                          (j - start) * size_y, color);
         }
       }
     }
-    if (bg != color) { // If opaque, draw vertical line for last column
-      if (size_x == 1 && size_y == 1)
-        writeFastVLine(x + 5, y, 8, bg);
-      else
-        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
-    }
     endWrite();
 
   } else { // Custom font
@@ -1186,7 +2019,7 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
     int8_t xo = pgm_read_byte(&glyph->xOffset),
            yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
+    uint8_t yy, bits = 0, bit = 0;
     int16_t xo16 = 0, yo16 = 0;
 
     if (size_x > 1 || size_y > 1) {
@@ -1212,21 +2045,81 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     // displays supporting setAddrWindow() and pushColors()), but haven't
     // implemented this yet.
 
+    // Each run of set bits in a row is written as one line (or rectangle,
+    // if magnified), rather than a pixel at a time. The bitmap is one
+    // continuous stream of bits, rows aren't padded to whole bytes.
+    // Run-length coded glyphs already are runs, only split at row ends.
+    uint8_t runBits = gfxFontRunBits;
     startWrite();
+    if (runBits) {
+      GFXrunReader in = {&bitmap[bo], 0, 0};
+      uint8_t xx = 0, start = 0, run = 0, b0 = runBits >> 4, b1 = runBits & 15;
+      yy = 0;
+      while (w && yy < h) {
+        uint8_t clear = in.read(b0), set = in.read(b1);
+        if (!clear && !set)
+          break; // Rest of the glyph is clear
+        do {
+          uint8_t skip = clear, more = set;
+          if (skip && run) { // A run can carry on through several pairs
+            writeGlyphRun(this, x + (xo + start) * size_x,
+                          y + (yo + yy) * size_y, run, size_x, size_y, color);
+            run = 0;
+          }
+          while (skip >= w - xx) {
+            skip -= w - xx;
+            xx = 0;
+            yy++;
+          }
+          xx += skip;
+          while (more && yy < h) {
+            uint8_t n = (more < w - xx) ? more : w - xx;
+            if (!run)
+              start = xx;
+            run += n;
+            more -= n;
+            xx += n;
+            if (xx == w) {
+              writeGlyphRun(this, x + (xo + start) * size_x,
+                            y + (yo + yy) * size_y, run, size_x, size_y,
+                            color);
+              run = 0;
+              xx = 0;
+              yy++;
+            }
+          }
+        } while (yy < h && in.read(1));
+      }
+      if (run)
+        writeGlyphRun(this, x + (xo + start) * size_x, y + (yo + yy) * size_y,
+                      run, size_x, size_y, color);
+      endWrite();
+      return;
+    }
     for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
-        if (!(bit++ & 7)) {
-          bits = pgm_read_byte(&bitmap[bo++]);
+      uint8_t start = 0, run = 0;
+      for (int16_t xx = 0; xx <= w; xx++) { // One past the end, to end a run
+        bool set = false;
+        if (xx < w) {
+          if (!(bit++ & 7)) {
+            bits = pgm_read_byte(&bitmap[bo++]);
+          }
+          set = bits & 0x80;
+          bits <<= 1;
         }
-        if (bits & 0x80) {
+        if (set) {
+          if (!run++)
+            start = xx;
+        } else if (run) {
           if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
+            writeFastHLine(x + xo + start, y + yo + yy, run, color);
           } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
+            writeFillRect(x + (xo16 + start) * size_x,
+                          y + (yo16 + yy) * size_y, run * size_x, size_y,
+                          color);
           }
+          run = 0;
         }
-        bits <<= 1;
       }
     }
     endWrite();
@@ -1348,6 +2241,20 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     cursor_y -= 6;
   }
   gfxFont = (GFXfont *)f;
+  gfxFontRunBits = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief Set a run-length coded font (see fontconvert -r) to display when
+           print()ing. Use setFont() to go back to a raw font or the
+           built in one.
+    @param  f  The GFXfontRLE object
+*/
+/**************************************************************************/
+void Adafruit_GFX::setFontRLE(const GFXfontRLE *f) {
+  setFont(&f->font);
+  gfxFontRunBits = pgm_read_byte(&f->runBits);
 }
 
 /**************************************************************************/
@@ -2107,6 +3014,113 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief  Combine a rectangle of one 1-bit canvas into this one, eight
+   pixels at a time. Coordinates are raw (rotation 0), as the buffers are
+   laid out, and the rectangle is clipped to both canvases. The source may
+   be this canvas, and may overlap the destination.
+   @param  src   Canvas to copy from
+   @param  sx    Left edge of the rectangle in src
+   @param  sy    Top edge of the rectangle in src
+   @param  w     Width of the rectangle in pixels
+   @param  h     Height of the rectangle in pixels
+   @param  dx    Where the left edge goes in this canvas
+   @param  dy    Where the top edge goes in this canvas
+   @param  rop   How source bits combine with the ones already here
+*/
+/**************************************************************************/
+void GFXcanvas1::blit(const GFXcanvas1 &src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h, int16_t dx, int16_t dy,
+                      GFXrop rop) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  int16_t srcBytes = (src.WIDTH + 7) / 8, dstBytes = (WIDTH + 7) / 8;
+  // Within one canvas, work away from the side being written to
+  bool up = (&src == this) && (dy > sy), left = (&src == this) && (dx > sx);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    const uint8_t *s = &src.buffer[(sy + row) * srcBytes];
+    uint8_t *d = &buffer[(dy + row) * dstBytes];
+    int16_t x = left ? (dx + w) : dx; // Edge of what's left of this row
+    while (left ? (x > dx) : (x < dx + w)) {
+      // One destination byte's worth: bits x0 to x0 + n - 1
+      int16_t x0, n;
+      if (left) {
+        x0 = (x - 1) & ~7;
+        if (x0 < dx)
+          x0 = dx;
+        n = x - x0;
+        x = x0;
+      } else {
+        x0 = x;
+        n = 8 - (x & 7);
+        if (n > dx + w - x)
+          n = dx + w - x;
+        x += n;
+      }
+      // Gather n source bits, MSB first, then line them up with x0
+      int16_t xs = sx + (x0 - dx);
+      uint16_t window = s[xs / 8] << 8;
+      if ((xs & 7) + n > 8)
+        window |= s[xs / 8 + 1];
+      uint8_t bits = (uint8_t)((window << (xs & 7)) >> 8) >> (x0 & 7);
+      uint8_t mask = (0xFF >> (x0 & 7)) & (0xFF << (8 - (x0 & 7) - n));
+      uint8_t *p = &d[x0 / 8];
+      switch (rop) {
+      case GFX_ROP_COPY:
+        *p = (*p & ~mask) | (bits & mask);
+        break;
+      case GFX_ROP_AND:
+        *p &= bits | ~mask;
+        break;
+      case GFX_ROP_OR:
+        *p |= bits & mask;
+        break;
+      case GFX_ROP_XOR:
+        *p ^= bits & mask;
+        break;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the whole canvas contents in place, e.g. for a scrolling
+   chart or terminal. Raw (rotation 0) directions; what scrolls off is lost
+   and the uncovered area is filled.
+   @param  dx    Pixels to move right (negative = left)
+   @param  dy    Pixels to move down (negative = up)
+   @param  fill  Binary (on or off) color for the uncovered area
+*/
+/**************************************************************************/
+void GFXcanvas1::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (!buffer)
+    return;
+  dx = clampScroll(dx, WIDTH);
+  dy = clampScroll(dy, HEIGHT);
+  int16_t rowBytes = (WIDTH + 7) / 8;
+  if (dx == 0) { // Whole rows, just move the bytes
+    if (dy > 0)
+      memmove(&buffer[dy * rowBytes], buffer, (HEIGHT - dy) * rowBytes);
+    else if (dy < 0)
+      memmove(buffer, &buffer[-dy * rowBytes], (HEIGHT + dy) * rowBytes);
+  } else {
+    blit(*this, 0, 0, WIDTH, HEIGHT, dx, dy);
+  }
+  for (int16_t y = 0; y < HEIGHT; y++) {
+    if ((dy > 0) ? (y < dy) : (y >= HEIGHT + dy))
+      drawFastRawHLine(0, y, WIDTH, fill);
+    else if (dx > 0)
+      drawFastRawHLine(0, y, dx, fill);
+    else if (dx < 0)
+      drawFastRawHLine(WIDTH + dx, y, -dx, fill);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 8-bit canvas context for graphics
@@ -2375,6 +3389,133 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   memset(buffer + y * WIDTH + x, color, w);
 }
 
+/**************************************************************************/
+/*!
+   @brief  Combine a rectangle of another 8-bit canvas into this one, a row
+   at a time. Coordinates are raw (rotation 0), as the buffers are laid
+   out, and the rectangle is clipped to both canvases. The source may be
+   this canvas, and may overlap the destination.
+   @param  src   Canvas to copy from
+   @param  sx    Left edge of the rectangle in src
+   @param  sy    Top edge of the rectangle in src
+   @param  w     Width of the rectangle in pixels
+   @param  h     Height of the rectangle in pixels
+   @param  dx    Where the left edge goes in this canvas
+   @param  dy    Where the top edge goes in this canvas
+   @param  rop   How source pixels combine with the ones already here
+*/
+/**************************************************************************/
+void GFXcanvas8::blit(const GFXcanvas8 &src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h, int16_t dx, int16_t dy,
+                      GFXrop rop) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  bool up = (&src == this) && (dy > sy);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    ropBytes(&buffer[(dy + row) * WIDTH + dx],
+             &src.buffer[(sy + row) * src.WIDTH + sx], w, rop);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Copy a rectangle of another 8-bit canvas into this one, leaving
+   out pixels of one color (a sprite's background). Otherwise the same as
+   the raster op blit().
+   @param  src          Canvas to copy from
+   @param  sx           Left edge of the rectangle in src
+   @param  sy           Top edge of the rectangle in src
+   @param  w            Width of the rectangle in pixels
+   @param  h            Height of the rectangle in pixels
+   @param  dx           Where the left edge goes in this canvas
+   @param  dy           Where the top edge goes in this canvas
+   @param  transparent  Source color that isn't copied
+*/
+/**************************************************************************/
+void GFXcanvas8::blitKeyed(const GFXcanvas8 &src, int16_t sx, int16_t sy,
+                           int16_t w, int16_t h, int16_t dx, int16_t dy,
+                           uint8_t transparent) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  bool up = (&src == this) && (dy > sy), left = (&src == this) && (dx > sx);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    keyPixels(&buffer[(dy + row) * WIDTH + dx],
+              &src.buffer[(sy + row) * src.WIDTH + sx], w, transparent, left);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a rectangle of a 1-bit canvas into this one in two colors,
+   like drawBitmap() but from a canvas and without going pixel by pixel.
+   Coordinates are raw (rotation 0) and the rectangle is clipped to both
+   canvases.
+   @param  src    1-bit canvas to copy from
+   @param  sx     Left edge of the rectangle in src
+   @param  sy     Top edge of the rectangle in src
+   @param  w      Width of the rectangle in pixels
+   @param  h      Height of the rectangle in pixels
+   @param  dx     Where the left edge goes in this canvas
+   @param  dy     Where the top edge goes in this canvas
+   @param  color  Color for set bits
+   @param  bg     Color for clear bits, or the same as color to leave them
+                  transparent
+*/
+/**************************************************************************/
+void GFXcanvas8::blit(const GFXcanvas1 &src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h, int16_t dx, int16_t dy,
+                      uint8_t color, uint8_t bg) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  int16_t srcBytes = (src.WIDTH + 7) / 8;
+  for (int16_t j = 0; j < h; j++) {
+    expandBits(&buffer[(dy + j) * WIDTH + dx],
+               &src.buffer[(sy + j) * srcBytes], sx, w, color, bg);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the whole canvas contents in place, e.g. for a scrolling
+   chart or terminal. Raw (rotation 0) directions; what scrolls off is lost
+   and the uncovered area is filled.
+   @param  dx    Pixels to move right (negative = left)
+   @param  dy    Pixels to move down (negative = up)
+   @param  fill  8-bit color for the uncovered area. Only lower byte of
+   uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (!buffer)
+    return;
+  dx = clampScroll(dx, WIDTH);
+  dy = clampScroll(dy, HEIGHT);
+  if (dx == 0) { // Whole rows, one move
+    if (dy > 0)
+      memmove(&buffer[dy * WIDTH], buffer, (HEIGHT - dy) * WIDTH);
+    else if (dy < 0)
+      memmove(buffer, &buffer[-dy * WIDTH], (HEIGHT + dy) * WIDTH);
+  } else {
+    blit(*this, 0, 0, WIDTH, HEIGHT, dx, dy);
+  }
+  for (int16_t y = 0; y < HEIGHT; y++) {
+    if ((dy > 0) ? (y < dy) : (y >= HEIGHT + dy))
+      drawFastRawHLine(0, y, WIDTH, fill);
+    else if (dx > 0)
+      drawFastRawHLine(0, y, dx, fill);
+    else if (dx < 0)
+      drawFastRawHLine(WIDTH + dx, y, -dx, fill);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 16-bit canvas context for graphics
@@ -2668,3 +3809,256 @@ void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
     buffer[i] = color;
   }
 }
+
+/**************************************************************************/
+/*!
+   @brief  Combine a rectangle of another 16-bit canvas into this one, a
+   row at a time. Coordinates are raw (rotation 0), as the buffers are laid
+   out, and the rectangle is clipped to both canvases. The source may be
+   this canvas, and may overlap the destination.
+   @param  src   Canvas to copy from
+   @param  sx    Left edge of the rectangle in src
+   @param  sy    Top edge of the rectangle in src
+   @param  w     Width of the rectangle in pixels
+   @param  h     Height of the rectangle in pixels
+   @param  dx    Where the left edge goes in this canvas
+   @param  dy    Where the top edge goes in this canvas
+   @param  rop   How source pixels combine with the ones already here
+*/
+/**************************************************************************/
+void GFXcanvas16::blit(const GFXcanvas16 &src, int16_t sx, int16_t sy,
+                       int16_t w, int16_t h, int16_t dx, int16_t dy,
+                       GFXrop rop) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  bool up = (&src == this) && (dy > sy);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    ropBytes((uint8_t *)&buffer[(dy + row) * WIDTH + dx],
+             (const uint8_t *)&src.buffer[(sy + row) * src.WIDTH + sx], w * 2,
+             rop);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Copy a rectangle of another 16-bit canvas into this one, leaving
+   out pixels of one color (a sprite's background). Otherwise the same as
+   the raster op blit().
+   @param  src          Canvas to copy from
+   @param  sx           Left edge of the rectangle in src
+   @param  sy           Top edge of the rectangle in src
+   @param  w            Width of the rectangle in pixels
+   @param  h            Height of the rectangle in pixels
+   @param  dx           Where the left edge goes in this canvas
+   @param  dy           Where the top edge goes in this canvas
+   @param  transparent  Source color that isn't copied
+*/
+/**************************************************************************/
+void GFXcanvas16::blitKeyed(const GFXcanvas16 &src, int16_t sx, int16_t sy,
+                            int16_t w, int16_t h, int16_t dx, int16_t dy,
+                            uint16_t transparent) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  bool up = (&src == this) && (dy > sy), left = (&src == this) && (dx > sx);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    keyPixels(&buffer[(dy + row) * WIDTH + dx],
+              &src.buffer[(sy + row) * src.WIDTH + sx], w, transparent, left);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a rectangle of a 1-bit canvas into this one in two colors,
+   like drawBitmap() but from a canvas and without going pixel by pixel.
+   Coordinates are raw (rotation 0) and the rectangle is clipped to both
+   canvases.
+   @param  src    1-bit canvas to copy from
+   @param  sx     Left edge of the rectangle in src
+   @param  sy     Top edge of the rectangle in src
+   @param  w      Width of the rectangle in pixels
+   @param  h      Height of the rectangle in pixels
+   @param  dx     Where the left edge goes in this canvas
+   @param  dy     Where the top edge goes in this canvas
+   @param  color  16-bit 5-6-5 color for set bits
+   @param  bg     16-bit 5-6-5 color for clear bits, or the same as color to
+                  leave them transparent
+*/
+/**************************************************************************/
+void GFXcanvas16::blit(const GFXcanvas1 &src, int16_t sx, int16_t sy,
+                       int16_t w, int16_t h, int16_t dx, int16_t dy,
+                       uint16_t color, uint16_t bg) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  int16_t srcBytes = (src.WIDTH + 7) / 8;
+  for (int16_t j = 0; j < h; j++) {
+    expandBits(&buffer[(dy + j) * WIDTH + dx],
+               &src.buffer[(sy + j) * srcBytes], sx, w, color, bg);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a rectangle of an 8-bit canvas into this one, looking up
+   each pixel's 16-bit color in a palette. Coordinates are raw (rotation 0)
+   and the rectangle is clipped to both canvases.
+   @param  src      8-bit canvas to copy from
+   @param  sx       Left edge of the rectangle in src
+   @param  sy       Top edge of the rectangle in src
+   @param  w        Width of the rectangle in pixels
+   @param  h        Height of the rectangle in pixels
+   @param  dx       Where the left edge goes in this canvas
+   @param  dy       Where the top edge goes in this canvas
+   @param  palette  RAM-resident table of 256 16-bit 5-6-5 colors
+*/
+/**************************************************************************/
+void GFXcanvas16::blit(const GFXcanvas8 &src, int16_t sx, int16_t sy,
+                       int16_t w, int16_t h, int16_t dx, int16_t dy,
+                       const uint16_t *palette) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  for (int16_t j = 0; j < h; j++) {
+    uint16_t *d = &buffer[(dy + j) * WIDTH + dx];
+    const uint8_t *s = &src.buffer[(sy + j) * src.WIDTH + sx];
+    for (int16_t i = 0; i < w; i++)
+      d[i] = palette[s[i]];
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Mix a rectangle of another 16-bit canvas into this one, for
+   fades and see-through overlays. Coordinates are raw (rotation 0) and the
+   rectangle is clipped to both canvases. Both canvases must hold native
+   5-6-5 colors, i.e. not byteSwap()ed.
+   @param  src    Canvas to mix in
+   @param  sx     Left edge of the rectangle in src
+   @param  sy     Top edge of the rectangle in src
+   @param  w      Width of the rectangle in pixels
+   @param  h      Height of the rectangle in pixels
+   @param  dx     Where the left edge goes in this canvas
+   @param  dy     Where the top edge goes in this canvas
+   @param  alpha  How much of src to mix in, 0 (none) to 255 (all). Used
+                  in 32 steps.
+*/
+/**************************************************************************/
+void GFXcanvas16::blend(const GFXcanvas16 &src, int16_t sx, int16_t sy,
+                        int16_t w, int16_t h, int16_t dx, int16_t dy,
+                        uint8_t alpha) {
+  if (!buffer || !src.buffer ||
+      !clipBlit(src.WIDTH, src.HEIGHT, WIDTH, HEIGHT, sx, sy, w, h, dx, dy))
+    return;
+
+  uint32_t a = (alpha + 4) >> 3; // 0 to 32
+  bool up = (&src == this) && (dy > sy), left = (&src == this) && (dx > sx);
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? (h - 1 - j) : j;
+    uint16_t *d = &buffer[(dy + row) * WIDTH + dx];
+    const uint16_t *s = &src.buffer[(sy + row) * src.WIDTH + sx];
+    for (int16_t k = 0; k < w; k++) {
+      int16_t i = left ? (w - 1 - k) : k;
+      d[i] = mix565(d[i], s[i], a);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the whole canvas contents in place, e.g. for a scrolling
+   chart or terminal. Raw (rotation 0) directions; what scrolls off is lost
+   and the uncovered area is filled.
+   @param  dx    Pixels to move right (negative = left)
+   @param  dy    Pixels to move down (negative = up)
+   @param  fill  16-bit 5-6-5 color for the uncovered area
+*/
+/**************************************************************************/
+void GFXcanvas16::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (!buffer)
+    return;
+  dx = clampScroll(dx, WIDTH);
+  dy = clampScroll(dy, HEIGHT);
+  if (dx == 0) { // Whole rows, one move
+    if (dy > 0)
+      memmove(&buffer[dy * WIDTH], buffer, (HEIGHT - dy) * WIDTH * 2);
+    else if (dy < 0)
+      memmove(buffer, &buffer[-dy * WIDTH], (HEIGHT + dy) * WIDTH * 2);
+  } else {
+    blit(*this, 0, 0, WIDTH, HEIGHT, dx, dy);
+  }
+  for (int16_t y = 0; y < HEIGHT; y++) {
+    if ((dy > 0) ? (y < dy) : (y >= HEIGHT + dy))
+      drawFastRawHLine(0, y, WIDTH, fill);
+    else if (dx > 0)
+      drawFastRawHLine(0, y, dx, fill);
+    else if (dx < 0)
+      drawFastRawHLine(WIDTH + dx, y, -dx, fill);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a polygon with anti-aliased edges: edge pixels are blended
+   with what's under them by how much of the pixel the polygon covers, from
+   four samples each. Corners are at pixel centers, so a polygon's outline
+   runs through the middle of its edge pixels. Otherwise like fillPolygon().
+    @param    points  x,y pairs of its corners, n of them, in RAM
+    @param    n       Number of corners
+    @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillPolygonAA(const int16_t *points, uint16_t n,
+                                uint16_t color) {
+  GFXspanCover cover(this, color);
+  scanPolygon(points, n, true, _height, cover);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill part of a ring with anti-aliased edges. Otherwise like
+   fillArc().
+    @param    x0      Center-point x coordinate
+    @param    y0      Center-point y coordinate
+    @param    r0      Inner radius, 0 for a pie slice
+    @param    r1      Outer radius
+    @param    start   Starting angle in degrees, 0 being 3 o'clock and 90
+                      6 o'clock
+    @param    end     Ending angle in degrees. A whole ring if 360 or more
+                      from start.
+    @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillArcAA(int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+                            int16_t start, int16_t end, uint16_t color) {
+  GFXspanCover cover(this, color);
+  scanArc(x0, y0, r0, r1, start, end, true, _height, cover);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a thick line with anti-aliased edges. Otherwise like
+   drawThickLine(), except that it is drawn this way at any width.
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    width  Thickness in pixels, across the line
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawThickLineAA(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, uint8_t width, uint16_t color) {
+  GFXedge edges[4];
+  uint16_t act[4], n = 0;
+  GFXspanCover cover(this, color);
+  thickLineEdges(edges, n, x0, y0, x1, y1, width);
+  scanEdges(edges, n, act, true, _height, cover);
+}
@@ -9,6 +9,23 @@
 #endif
 #include "gfxfont.h"
 
+class GFXcanvas16;
+
+/// Raster operations for combining a source canvas with a destination canvas
+enum GFXrop {
+  GFX_ROP_COPY, ///< Destination = source
+  GFX_ROP_AND,  ///< Destination = destination AND source
+  GFX_ROP_OR,   ///< Destination = destination OR source
+  GFX_ROP_XOR   ///< Destination = destination XOR source
+};
+
+/// How drawThickPolyline() fills the outside corner where two segments meet
+enum GFXjoin {
+  GFX_JOIN_BEVEL, ///< Cut straight across
+  GFX_JOIN_MITER, ///< Extended to a point, or bevelled if that's too long
+  GFX_JOIN_ROUND  ///< Rounded off
+};
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -39,6 +56,9 @@ public:
   virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                          uint16_t color);
+  virtual void writeMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                               int16_t w, int16_t h, uint8_t size_x,
+                               uint8_t size_y, uint16_t color, uint16_t bg);
   virtual void endWrite(void);
 
   // CONTROL API
@@ -74,6 +94,14 @@ public:
                     int16_t y2, uint16_t color);
   void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
                     int16_t y2, uint16_t color);
+  void drawPolygon(const int16_t *points, uint16_t n, uint16_t color);
+  void fillPolygon(const int16_t *points, uint16_t n, uint16_t color);
+  void fillArc(int16_t x0, int16_t y0, int16_t r0, int16_t r1, int16_t start,
+               int16_t end, uint16_t color);
+  void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                     uint8_t width, uint16_t color);
+  void drawThickPolyline(const int16_t *points, uint16_t n, uint8_t width,
+                         uint16_t color, GFXjoin join = GFX_JOIN_ROUND);
   void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
                      int16_t radius, uint16_t color);
   void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
@@ -104,6 +132,8 @@ public:
                      const uint8_t mask[], int16_t w, int16_t h);
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
                      int16_t w, int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, const GFXcanvas16 &canvas,
+                     int16_t cx, int16_t cy, int16_t w, int16_t h);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                 uint16_t bg, uint8_t size);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
@@ -117,6 +147,7 @@ public:
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
+  void setFontRLE(const GFXfontRLE *f);
 
   /**********************************************************************/
   /*!
@@ -243,6 +274,7 @@ protected:
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+  uint8_t gfxFontRunBits; ///< GFXfontRLE::runBits of gfxFont, 0 if raw
 };
 
 /// A simple drawn button UI element
@@ -313,6 +345,9 @@ public:
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   bool getPixel(int16_t x, int16_t y) const;
+  void blit(const GFXcanvas1 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, GFXrop rop = GFX_ROP_COPY);
+  void scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -322,6 +357,9 @@ public:
   uint8_t *getBuffer(void) const { return buffer; }
 
 protected:
+  // The deeper canvases expand 1-bit canvases into themselves
+  friend class GFXcanvas8;
+  friend class GFXcanvas16;
   bool getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -345,6 +383,13 @@ public:
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint8_t getPixel(int16_t x, int16_t y) const;
+  void blit(const GFXcanvas8 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, GFXrop rop = GFX_ROP_COPY);
+  void blitKeyed(const GFXcanvas8 &src, int16_t sx, int16_t sy, int16_t w,
+                 int16_t h, int16_t dx, int16_t dy, uint8_t transparent);
+  void blit(const GFXcanvas1 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, uint8_t color, uint8_t bg);
+  void scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
   /**********************************************************************/
   /*!
    @brief    Get a pointer to the internal buffer memory
@@ -354,6 +399,8 @@ public:
   uint8_t *getBuffer(void) const { return buffer; }
 
 protected:
+  // GFXcanvas16 expands 8-bit canvases into itself through a palette
+  friend class GFXcanvas16;
   uint8_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -373,6 +420,22 @@ public:
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint16_t getPixel(int16_t x, int16_t y) const;
+  void blit(const GFXcanvas16 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, GFXrop rop = GFX_ROP_COPY);
+  void blitKeyed(const GFXcanvas16 &src, int16_t sx, int16_t sy, int16_t w,
+                 int16_t h, int16_t dx, int16_t dy, uint16_t transparent);
+  void blit(const GFXcanvas1 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, uint16_t color, uint16_t bg);
+  void blit(const GFXcanvas8 &src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy, const uint16_t *palette);
+  void blend(const GFXcanvas16 &src, int16_t sx, int16_t sy, int16_t w,
+             int16_t h, int16_t dx, int16_t dy, uint8_t alpha);
+  void scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+  void fillPolygonAA(const int16_t *points, uint16_t n, uint16_t color);
+  void fillArcAA(int16_t x0, int16_t y0, int16_t r0, int16_t r1, int16_t start,
+                 int16_t end, uint16_t color);
+  void drawThickLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                       uint8_t width, uint16_t color);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -382,6 +445,8 @@ public:
   uint16_t *getBuffer(void) const { return buffer; }
 
 protected:
+  // Displays push canvas regions straight from the buffer
+  friend class Adafruit_SPITFT;
   uint16_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -1539,6 +1539,61 @@ void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
   }
 }
 
+/*!
+    @brief  Write a 1-bit bitmap from RAM with a solid background, such as a
+            character cell of opaque text, each bit magnified to a size_x
+            by size_y block. If the whole (magnified) bitmap is on screen,
+            this sets the address window once and streams every pixel
+            through writePixels(), rather than one window per run.
+            Otherwise it falls back to Adafruit_GFX::writeMonoBitmap(),
+            which clips. Not self-contained; should follow startWrite().
+    @param  x       Horizontal position of top left corner.
+    @param  y       Vertical position of top left corner.
+    @param  bitmap  Byte array, rows MSB first, each padded to whole bytes.
+    @param  w       Width of bitmap in bits.
+    @param  h       Height of bitmap in bits.
+    @param  size_x  Horizontal magnification, 1 is 'original' size.
+    @param  size_y  Vertical magnification, 1 is 'original' size.
+    @param  color   16-bit color for set bits, in '565' RGB format.
+    @param  bg      16-bit color for clear bits, in '565' RGB format.
+*/
+void Adafruit_SPITFT::writeMonoBitmap(int16_t x, int16_t y,
+                                      const uint8_t *bitmap, int16_t w,
+                                      int16_t h, uint8_t size_x,
+                                      uint8_t size_y, uint16_t color,
+                                      uint16_t bg) {
+  int16_t pw = w * size_x, ph = h * size_y; // Size in pixels
+  if ((w <= 0) || (h <= 0) || (x < 0) || (y < 0) || (x + pw > _width) ||
+      (y + ph > _height)) {
+    Adafruit_GFX::writeMonoBitmap(x, y, bitmap, w, h, size_x, size_y, color,
+                                  bg);
+    return;
+  }
+
+  // Pixels are expanded into a small buffer and pushed a piece at a time.
+  // writePixels() may byte-swap the buffer in place, so it's refilled for
+  // every piece, even when a row is repeated for vertical magnification.
+  uint16_t pixels[32];
+  int16_t byteWidth = (w + 7) / 8;
+  setAddrWindow(x, y, pw, ph);
+  for (int16_t j = 0; j < h; j++, bitmap += byteWidth) {
+    for (uint8_t r = 0; r < size_y; r++) {
+      uint8_t n = 0;
+      for (int16_t i = 0; i < w; i++) {
+        uint16_t c = (bitmap[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+        for (uint8_t s = 0; s < size_x; s++) {
+          pixels[n++] = c;
+          if (n == sizeof(pixels) / sizeof(pixels[0])) {
+            writePixels(pixels, n);
+            n = 0;
+          }
+        }
+      }
+      writePixels(pixels, n); // Does nothing if n is 0
+    }
+  }
+}
+
 /*!
     @brief  A lower-level version of writeFillRect(). This version requires
             all inputs are in-bounds, that width and height are positive,
@@ -1804,6 +1859,72 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Draw a rectangle of a 16-bit canvas (565 RGB) at the specified
+            (x,y) position, e.g. a sprite sheet frame or the changed part
+            of an offscreen UI. Like the bitmap version, the clipped area
+            goes out in one address window, a canvas row per writePixels()
+            burst, with no copy. Handles its own transaction and edge
+            clipping/rejection.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  canvas  16-bit canvas to draw from, holding native (not
+                    byteSwap()ed) colors.
+    @param  cx      Left edge of the rectangle in the canvas, raw
+                    (rotation 0) coordinates.
+    @param  cy      Top edge of the rectangle in the canvas, raw
+                    (rotation 0) coordinates.
+    @param  w       Width of the rectangle in pixels.
+    @param  h       Height of the rectangle in pixels.
+*/
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y,
+                                    const GFXcanvas16 &canvas, int16_t cx,
+                                    int16_t cy, int16_t w, int16_t h) {
+  uint16_t *pcolors = canvas.getBuffer();
+  if (!pcolors)
+    return;
+
+  if (cx < 0) { // Clip to the canvas first...
+    w += cx;
+    x -= cx;
+    cx = 0;
+  }
+  if (cy < 0) {
+    h += cy;
+    y -= cy;
+    cy = 0;
+  }
+  if (w > canvas.WIDTH - cx)
+    w = canvas.WIDTH - cx;
+  if (h > canvas.HEIGHT - cy)
+    h = canvas.HEIGHT - cy;
+  if (x < 0) { // ...then to the screen
+    w += x;
+    cx -= x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    cy -= y;
+    y = 0;
+  }
+  if (w > _width - x)
+    w = _width - x;
+  if (h > _height - y)
+    h = _height - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  pcolors += cy * canvas.WIDTH + cx;
+  startWrite();
+  setAddrWindow(x, y, w, h); // Clipped area
+  while (h--) {              // For each (clipped) canvas row...
+    writePixels(pcolors, w); // Push one (clipped) row
+    pcolors += canvas.WIDTH; // Advance pointer by one full canvas row
+  }
+  endWrite();
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
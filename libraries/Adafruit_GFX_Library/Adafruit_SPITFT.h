@@ -217,6 +217,9 @@ public:
                      uint16_t color);
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                       int16_t h, uint8_t size_x, uint8_t size_y,
+                       uint16_t color, uint16_t bg);
   // This is a new function, similar to writeFillRect() except that
   // all arguments MUST be onscreen, sorted and clipped. If higher-level
   // primitives can handle their own sorting/clipping, it avoids repeating
@@ -244,6 +247,8 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, const GFXcanvas16 &canvas,
+                     int16_t cx, int16_t cy, int16_t w, int16_t h);
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
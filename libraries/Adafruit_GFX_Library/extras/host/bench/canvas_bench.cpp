@@ -0,0 +1,132 @@
+/*!
+ * @file canvas_bench.cpp
+ *
+ * Host time for the canvas operations against the same job done a pixel at
+ * a time with getPixel() and drawPixel(), which is how sketches had to do it
+ * before, and the bus cost of pushing a canvas region to MockTFT with
+ * drawRGBBitmap() against drawing it pixel by pixel. Host times are only
+ * good for comparing the two ways on the same machine.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <chrono> // Before Arduino.h, whose min() and max() are macros
+
+#include "mock_tft.h"
+
+// Run job() reps times and return microseconds per run
+template <class F> static double timeUs(int reps, F job) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++)
+    job();
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - t0)
+             .count() /
+         reps;
+}
+
+static void report(const char *name, double before, double now) {
+  printf("%-34s %10.1f us before %10.1f us now %6.1fx\n", name, before, now,
+         before / now);
+}
+
+int main() {
+  const int16_t W = 320, H = 240;
+  GFXcanvas16 screen(W, H), sprite(48, 48), overlay(W, 40);
+  GFXcanvas8 indexed(W, 40);
+  GFXcanvas1 mono(W, 40);
+  uint16_t palette[256];
+  for (int i = 0; i < 256; i++)
+    palette[i] = i * 257;
+  for (int16_t y = 0; y < 48; y++)
+    for (int16_t x = 0; x < 48; x++)
+      sprite.drawPixel(x, y, ((x - 24) * (x - 24) + (y - 24) * (y - 24) < 500)
+                                 ? 0x07E0 + x
+                                 : 0xF81F);
+  mono.setCursor(0, 0);
+  mono.setTextSize(2);
+  mono.print("Scrolling ticker text, 1 bit per pixel");
+  indexed.fillScreen(3);
+  overlay.fillScreen(0x001F);
+
+  printf("on a 320x240 GFXcanvas16\n");
+  report("scroll up 1 line",
+         timeUs(50,
+                [&] {
+                  for (int16_t y = 0; y < H - 1; y++)
+                    for (int16_t x = 0; x < W; x++)
+                      screen.drawPixel(x, y, screen.getPixel(x, y + 1));
+                  screen.drawFastHLine(0, H - 1, W, 0);
+                }),
+         timeUs(50, [&] { screen.scroll(0, -1); }));
+  report("scroll left 1 column",
+         timeUs(50,
+                [&] {
+                  for (int16_t y = 0; y < H; y++)
+                    for (int16_t x = 0; x < W - 1; x++)
+                      screen.drawPixel(x, y, screen.getPixel(x + 1, y));
+                  screen.drawFastVLine(W - 1, 0, H, 0);
+                }),
+         timeUs(50, [&] { screen.scroll(-1, 0); }));
+  report("48x48 sprite, transparent key",
+         timeUs(500,
+                [&] {
+                  for (int16_t y = 0; y < 48; y++)
+                    for (int16_t x = 0; x < 48; x++) {
+                      uint16_t c = sprite.getPixel(x, y);
+                      if (c != 0xF81F)
+                        screen.drawPixel(100 + x, 50 + y, c);
+                    }
+                }),
+         timeUs(500,
+                [&] { screen.blitKeyed(sprite, 0, 0, 48, 48, 100, 50, 0xF81F); }));
+  report("320x40 1-bit band, two colors",
+         timeUs(50,
+                [&] {
+                  screen.drawBitmap(0, 100, mono.getBuffer(), W, 40, 0xFFFF,
+                                    0x0000);
+                }),
+         timeUs(50,
+                [&] { screen.blit(mono, 0, 0, W, 40, 0, 100, 0xFFFF, 0); }));
+  report("320x40 8-bit band, palette",
+         timeUs(50,
+                [&] {
+                  for (int16_t y = 0; y < 40; y++)
+                    for (int16_t x = 0; x < W; x++)
+                      screen.drawPixel(x, 150 + y,
+                                       palette[indexed.getPixel(x, y)]);
+                }),
+         timeUs(50,
+                [&] { screen.blit(indexed, 0, 0, W, 40, 0, 150, palette); }));
+  report("320x40 overlay, alpha 50%",
+         timeUs(50,
+                [&] {
+                  for (int16_t y = 0; y < 40; y++)
+                    for (int16_t x = 0; x < W; x++) {
+                      uint16_t s = overlay.getPixel(x, y),
+                               d = screen.getPixel(x, 200 + y);
+                      uint16_t r = ((s >> 11) + (d >> 11)) / 2,
+                               g = (((s >> 5) & 63) + ((d >> 5) & 63)) / 2,
+                               b = ((s & 31) + (d & 31)) / 2;
+                      screen.drawPixel(x, 200 + y, (r << 11) | (g << 5) | b);
+                    }
+                }),
+         timeUs(50,
+                [&] { screen.blend(overlay, 0, 0, W, 40, 0, 200, 128); }));
+
+  MockTFT tft(W, H);
+  tft.begin();
+  tft.clearStats();
+  for (int16_t y = 0; y < 48; y++)
+    for (int16_t x = 0; x < 48; x++)
+      tft.drawPixel(10 + x, 10 + y, sprite.getPixel(x, y));
+  uint32_t pixelBytes = tft.busBytes;
+  tft.clearStats();
+  tft.drawRGBBitmap(10, 10, sprite, 0, 0, 48, 48);
+  printf("\n48x48 canvas region to a TFT at 40 MHz SPI\n");
+  printf("%-34s %10lu bytes %8.2f ms\n", "drawPixel() each pixel",
+         (unsigned long)pixelBytes, pixelBytes * 8 / 40000.0);
+  printf("%-34s %10lu bytes %8.2f ms\n", "drawRGBBitmap() from the canvas",
+         (unsigned long)tft.busBytes, tft.busMicros(40000000UL) / 1000);
+  return 0;
+}
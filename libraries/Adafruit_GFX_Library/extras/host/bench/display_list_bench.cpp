@@ -0,0 +1,92 @@
+/*!
+ * @file display_list_bench.cpp
+ *
+ * A dashboard frame on a 320x240 MockTFT, drawn straight to the display
+ * (clear, then draw over it, which is what flickers) and through an
+ * Adafruit_DisplayList rendered in 320x16 strips: bytes of RAM, address
+ * windows, bytes over SPI and the time that takes at 40 MHz, pixels
+ * written (more than 76800 means some were drawn twice in one frame), and
+ * host time, which is only good for comparing the two.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <chrono> // Before Arduino.h, whose min() and max() are macros
+
+#include "mock_tft.h"
+#include <Adafruit_DisplayList.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSansBold18pt7b.h>
+
+template <class G> static void dashboard(G &g, int frame) {
+  g.fillScreen(0x0000);
+  g.fillRoundRect(4, 4, 312, 40, 8, 0x001F);
+  g.setFont(&FreeSansBold18pt7b);
+  g.setTextColor(0xFFFF);
+  g.setCursor(14, 36);
+  g.print("Boiler 2");
+  g.setFont(&FreeSans9pt7b);
+  const char *labels[] = {"Flow", "Return", "Pressure", "Burner"};
+  for (int i = 0; i < 4; i++) {
+    int16_t x = 8 + (i % 2) * 156, y = 52 + (i / 2) * 90;
+    g.drawRoundRect(x, y, 148, 82, 6, 0x7BEF);
+    g.setCursor(x + 8, y + 20);
+    g.print(labels[i]);
+    g.fillCircle(x + 110, y + 48, 24, 0x2945);
+    g.drawLine(x + 110, y + 48, x + 110 + (frame * 7 + i * 13) % 40 - 20,
+               y + 30, 0xFFE0);
+    g.setCursor(x + 8, y + 60);
+    g.print(40 + (frame + i * 11) % 50);
+  }
+  for (int16_t i = 0; i < 60; i++) // A bar graph along the bottom
+    g.fillRect(10 + i * 5, 236 - (i * 7 + frame) % 40, 4,
+               (i * 7 + frame) % 40, 0x07E0);
+}
+
+// Run job(frame) for each frame and return microseconds per frame
+template <class F> static double timeUs(int frames, F job) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; f++)
+    job(f);
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - t0)
+             .count() /
+         frames;
+}
+
+static void report(const char *name, MockTFT &tft, int frames, uint32_t ram,
+                   double hostUs) {
+  printf("%-28s %7lu bytes RAM %7.0f windows %8.0f bytes %6.2f ms bus "
+         "%7.0f pixels %8.1f us host\n",
+         name, (unsigned long)ram, (double)tft.windows / frames,
+         (double)tft.busBytes / frames,
+         tft.busMicros(40000000UL) / 1000 / frames,
+         (double)tft.pixels / frames, hostUs);
+}
+
+int main() {
+  const int frames = 20;
+  MockTFT tft(240, 320);
+  tft.begin();
+  tft.setRotation(1);
+
+  tft.clearStats();
+  double direct = timeUs(frames, [&](int f) { dashboard(tft, f); });
+  report("direct to the TFT", tft, frames, 0, direct);
+
+  Adafruit_DisplayList list(tft.width(), tft.height(), 2048, 16);
+  uint16_t used = 0;
+  tft.clearStats();
+  double listed = timeUs(frames, [&](int f) {
+    dashboard(list, f);
+    used = list.used();
+    list.render(tft);
+  });
+  report("display list, 320x16 strips", tft, frames,
+         2048 + tft.width() * 16 * 2, listed);
+  printf("list: %u of 2048 bytes used%s\n", used,
+         list.overflowed() ? ", OVERFLOWED" : "");
+  printf("a 320x240 GFXcanvas16 would take %lu bytes\n",
+         (unsigned long)tft.width() * tft.height() * 2);
+  return 0;
+}
@@ -0,0 +1,166 @@
+/*!
+ * @file render_bench.cpp
+ *
+ * How fast Adafruit_GFX draws on the host, and what it asks of a display.
+ * Each primitive is run many times at random places on a 320x240
+ * GFXHostDisplay: calls per second of host time (only good for comparing
+ * builds on the same machine), then per call the driver primitives it made
+ * (drawPixel(), writeFillRect() and so on), address windows, and bytes
+ * on SPI. The same for the canvases, which have no bus. Then a dashboard
+ * frame: per bus, the bytes and time it takes. Give a file name ending in
+ * .png or .ppm to save the frame.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <chrono> // Before Arduino.h, whose min() and max() are macros
+
+#include "host_display.h"
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSansBold18pt7b.h>
+#include <stdio.h>
+
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+// Run job() reps times, return calls per second of host time
+template <class F> static double perSecond(long reps, F job) {
+  seed = 12345;
+  auto t0 = std::chrono::steady_clock::now();
+  for (long i = 0; i < reps; i++)
+    job();
+  return reps / std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t0)
+                    .count();
+}
+
+template <class F>
+static void report(GFXHostDisplay &d, const char *name, long reps, F job) {
+  d.clearStats();
+  double rate = perSecond(reps, job);
+  uint32_t calls = 0;
+  for (uint8_t op = 0; op < GFX_HOST_OPS; op++)
+    calls += d.calls[op];
+  printf("%-26s %11.0f /s %9.1f calls %8.1f windows %9.1f SPI bytes\n", name,
+         rate, (double)calls / reps, (double)d.windows / reps,
+         (double)d.busBytes[GFX_HOST_SPI] / reps);
+}
+
+template <class F> static void report(const char *name, long reps, F job) {
+  printf("%-26s %11.0f /s\n", name, perSecond(reps, job));
+}
+
+static void dashboard(Adafruit_GFX &g, int frame) {
+  g.fillScreen(0x0000);
+  g.fillRoundRect(4, 4, 312, 40, 8, 0x001F);
+  g.setFont(&FreeSansBold18pt7b);
+  g.setTextColor(0xFFFF);
+  g.setCursor(14, 36);
+  g.print("Boiler 2");
+  g.setFont(&FreeSans9pt7b);
+  const char *labels[] = {"Flow", "Return", "Pressure", "Burner"};
+  for (int i = 0; i < 4; i++) {
+    int16_t x = 8 + (i % 2) * 156, y = 52 + (i / 2) * 90;
+    g.drawRoundRect(x, y, 148, 82, 6, 0x7BEF);
+    g.setCursor(x + 8, y + 20);
+    g.print(labels[i]);
+    g.fillCircle(x + 110, y + 48, 24, 0x2945);
+    g.drawLine(x + 110, y + 48, x + 110 + (frame * 7 + i * 13) % 40 - 20,
+               y + 30, 0xFFE0);
+    g.setCursor(x + 8, y + 60);
+    g.print(40 + (frame + i * 11) % 50);
+  }
+  for (int16_t i = 0; i < 60; i++) // A bar graph along the bottom
+    g.fillRect(10 + i * 5, 236 - (i * 7 + frame) % 40, 4,
+               (i * 7 + frame) % 40, 0x07E0);
+}
+
+int main(int argc, char *argv[]) {
+  GFXHostDisplay d(320, 240);
+  const int16_t W = d.width(), H = d.height();
+  printf("on a %dx%d GFXHostDisplay, per call\n", W, H);
+  report(d, "drawPixel()", 1000000,
+         [&] { d.drawPixel(rnd(W), rnd(H), 0xFFFF); });
+  report(d, "drawLine(), any angle", 20000, [&] {
+    d.drawLine(rnd(W), rnd(H), rnd(W), rnd(H), 0xF800);
+  });
+  report(d, "drawFastHLine(), 100 wide", 200000,
+         [&] { d.drawFastHLine(rnd(W), rnd(H), 100, 0x07E0); });
+  report(d, "fillRect(), 40x30", 100000,
+         [&] { d.fillRect(rnd(W), rnd(H), 40, 30, 0x001F); });
+  report(d, "drawRect(), 40x30", 100000,
+         [&] { d.drawRect(rnd(W), rnd(H), 40, 30, 0x001F); });
+  report(d, "drawCircle(), r 20", 20000,
+         [&] { d.drawCircle(rnd(W), rnd(H), 20, 0xFFE0); });
+  report(d, "fillCircle(), r 20", 20000,
+         [&] { d.fillCircle(rnd(W), rnd(H), 20, 0xFFE0); });
+  report(d, "fillRoundRect(), 60x40 r 8", 20000,
+         [&] { d.fillRoundRect(rnd(W), rnd(H), 60, 40, 8, 0x7BEF); });
+  report(d, "fillTriangle()", 20000, [&] {
+    d.fillTriangle(rnd(W), rnd(H), rnd(W), rnd(H), rnd(W), rnd(H), 0xF81F);
+  });
+  d.setFont(NULL);
+  report(d, "drawChar(), classic", 100000, [&] {
+    d.drawChar(rnd(W), rnd(H), 'A' + rnd(26), 0xFFFF, 0xFFFF, 1);
+  });
+  report(d, "drawChar(), classic opaque", 100000, [&] {
+    d.drawChar(rnd(W), rnd(H), 'A' + rnd(26), 0xFFFF, 0x0000, 1);
+  });
+  d.setFont(&FreeSans9pt7b);
+  report(d, "drawChar(), FreeSans9pt7b", 100000, [&] {
+    d.drawChar(rnd(W), rnd(H), 'A' + rnd(26), 0xFFFF, 0xFFFF, 1);
+  });
+  int16_t bx, by;
+  uint16_t bw, bh;
+  report(d, "getTextBounds(), 20 chars", 100000, [&] {
+    d.getTextBounds("Temperature  21.4 C", rnd(W), rnd(H), &bx, &by, &bw,
+                    &bh);
+  });
+
+  GFXcanvas1 c1(W, H);
+  GFXcanvas8 c8(W, H);
+  GFXcanvas16 c16(W, H);
+  printf("\non %dx%d canvases, per call\n", W, H);
+  report("GFXcanvas1 fillCircle()", 20000,
+         [&] { c1.fillCircle(rnd(W), rnd(H), 20, 1); });
+  report("GFXcanvas8 fillCircle()", 20000,
+         [&] { c8.fillCircle(rnd(W), rnd(H), 20, 0xE0); });
+  report("GFXcanvas16 fillCircle()", 20000,
+         [&] { c16.fillCircle(rnd(W), rnd(H), 20, 0xFFE0); });
+  report("GFXcanvas16 drawLine()", 20000, [&] {
+    c16.drawLine(rnd(W), rnd(H), rnd(W), rnd(H), 0xF800);
+  });
+  c16.setFont(&FreeSans9pt7b);
+  report("GFXcanvas16 drawChar()", 100000, [&] {
+    c16.drawChar(rnd(W), rnd(H), 'A' + rnd(26), 0xFFFF, 0xFFFF, 1);
+  });
+  report("GFXcanvas16 fillScreen()", 2000, [&] { c16.fillScreen(rnd(2)); });
+
+  const int frames = 50;
+  d.clearStats();
+  double fps = perSecond(frames, [&] {
+    static int frame = 0;
+    dashboard(d, frame++);
+  });
+  printf("\ndashboard frame: %.0f frames/s on the host, %.0f windows, "
+         "%.0f transactions\n",
+         fps, (double)d.windows / frames, (double)d.transactions / frames);
+  for (uint8_t b = 0; b < GFX_HOST_BUSES; b++)
+    printf("  %-16s %9.0f bytes %8.0f transfers %9.2f ms\n", d.buses[b].name,
+           (double)d.busBytes[b] / frames, (double)d.transfers[b] / frames,
+           d.busMicros(b) / 1000 / frames);
+
+  if (argc > 1) {
+    size_t n = strlen(argv[1]);
+    bool png = n > 4 && !strcmp(argv[1] + n - 4, ".png");
+    if (!(png ? d.writePNG(argv[1]) : d.writePPM(argv[1]))) {
+      printf("couldn't write %s\n", argv[1]);
+      return 1;
+    }
+  }
+  return 0;
+}
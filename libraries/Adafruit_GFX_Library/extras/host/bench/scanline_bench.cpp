@@ -0,0 +1,106 @@
+/*!
+ * @file scanline_bench.cpp
+ *
+ * Bus cost on a 320x240 MockTFT of gauge and chart parts drawn the way
+ * sketches had to before, out of many drawLine() or fillTriangle() calls,
+ * against the span fills: address windows, bytes, the bus time at 40 MHz
+ * SPI, and host time, which is only good for comparing the two. Also the
+ * host time of the anti-aliased fills on a GFXcanvas16 against the plain
+ * ones.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <chrono> // Before Arduino.h, whose min() and max() are macros
+#include <math.h>
+
+#include "mock_tft.h"
+
+// Run job() reps times and return microseconds per run
+template <class F> static double timeUs(int reps, F job) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++)
+    job();
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - t0)
+             .count() /
+         reps;
+}
+
+template <class F>
+static void report(MockTFT &tft, const char *name, int reps, F job) {
+  tft.clearStats();
+  double us = timeUs(reps, job);
+  printf("%-34s %6.0f windows %8.0f bytes %6.2f ms bus %8.1f us host\n",
+         name, (double)tft.windows / reps, (double)tft.busBytes / reps,
+         tft.busMicros(40000000UL) / 1000 / reps, us);
+}
+
+int main() {
+  MockTFT tft(240, 320);
+  tft.begin();
+  tft.setRotation(1);
+  const int16_t cx = 160, cy = 120;
+
+  printf("gauge scale: a 270 degree ring, 60 to 70 pixels out\n");
+  report(tft, "drawLine() every half degree", 20, [&] {
+    for (int i = 0; i <= 540; i++) {
+      float a = (135 + i / 2.0f) * (float)M_PI / 180;
+      tft.drawLine(cx + 60 * cosf(a), cy + 60 * sinf(a), cx + 70 * cosf(a),
+                   cy + 70 * sinf(a), 0x07E0);
+    }
+  });
+  report(tft, "fillArc()", 20,
+         [&] { tft.fillArc(cx, cy, 60, 70, 135, 405, 0x07E0); });
+
+  printf("\ngauge needle, 6 pixels wide and 55 long\n");
+  report(tft, "6 drawLine() side by side", 200, [&] {
+    for (int i = -3; i < 3; i++)
+      tft.drawLine(cx + i, cy + i, cx + 39 + i, cy - 39 + i, 0xF800);
+  });
+  report(tft, "drawThickLine()", 200,
+         [&] { tft.drawThickLine(cx, cy, cx + 39, cy - 39, 6, 0xF800); });
+
+  printf("\npie chart slice, radius 100, 100 degrees\n");
+  report(tft, "fillTriangle() fan, a degree each", 20, [&] {
+    for (int i = 0; i < 100; i++) {
+      float a = i * (float)M_PI / 180, b = (i + 1) * (float)M_PI / 180;
+      tft.fillTriangle(cx, cy, cx + 100 * cosf(a), cy + 100 * sinf(a),
+                       cx + 100 * cosf(b), cy + 100 * sinf(b), 0x001F);
+    }
+  });
+  report(tft, "fillArc() with no hole", 20,
+         [&] { tft.fillArc(cx, cy, 0, 100, 0, 100, 0x001F); });
+
+  int16_t chart[2 * 64];
+  for (int i = 0; i < 64; i++) {
+    chart[2 * i] = 10 + i * 300 / 63;
+    chart[2 * i + 1] = 120 + (int16_t)(80 * sinf(i / 6.0f));
+  }
+  printf("\nchart trace, 64 points, 3 pixels wide\n");
+  report(tft, "3 drawLine() traces", 20, [&] {
+    for (int k = -1; k <= 1; k++)
+      for (int i = 1; i < 64; i++)
+        tft.drawLine(chart[2 * i - 2], chart[2 * i - 1] + k, chart[2 * i],
+                     chart[2 * i + 1] + k, 0xFFE0);
+  });
+  report(tft, "drawThickPolyline(), round joins", 20,
+         [&] { tft.drawThickPolyline(chart, 64, 3, 0xFFE0); });
+
+  GFXcanvas16 canvas(320, 240);
+  printf("\non a 320x240 GFXcanvas16\n");
+  double plain =
+      timeUs(100, [&] { canvas.fillArc(cx, cy, 60, 70, 135, 405, 0x07E0); });
+  double aa =
+      timeUs(100, [&] { canvas.fillArcAA(cx, cy, 60, 70, 135, 405, 0x07E0); });
+  printf("%-34s %8.1f us plain %8.1f us anti-aliased\n", "gauge scale", plain,
+         aa);
+  plain = timeUs(1000, [&] {
+    canvas.drawThickLine(cx, cy, cx + 39, cy - 39, 6, 0xF800);
+  });
+  aa = timeUs(1000, [&] {
+    canvas.drawThickLineAA(cx, cy, cx + 39, cy - 39, 6, 0xF800);
+  });
+  printf("%-34s %8.1f us plain %8.1f us anti-aliased\n", "needle", plain, aa);
+  return 0;
+}
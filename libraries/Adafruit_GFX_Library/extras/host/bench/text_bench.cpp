@@ -0,0 +1,97 @@
+/*!
+ * @file text_bench.cpp
+ *
+ * What a screenful of text costs on MockTFT, drawn with drawChar() as it is
+ * now and as it was (a pixel at a time, see tests/legacy_text.h): address
+ * windows set, bytes over SPI, the time that takes at 40 MHz, and the host
+ * time spent drawing. The bus figures are exact for an ILI9341-style
+ * controller; the host time is only good for comparing the two. Then the
+ * same for the GFXfonts run-length coded (tests/pack_font.h), and how big
+ * their bitmaps are each way.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <chrono> // Before Arduino.h, whose min() and max() are macros
+#include <vector>
+
+#include "../tests/legacy_text.h"
+#include "../tests/pack_font.h"
+#include "mock_tft.h"
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSansBold18pt7b.h>
+
+static const char *lines[] = {
+    "Temperature  21.4 C", "Humidity     48 %",  "Pressure     1013 hPa",
+    "Wind         12 km/h NW", "Battery      3.92 V", "Uptime 02:14:37"};
+
+// Draw the lines with either drawChar(), and report. With rle, f is its font.
+static void bench(MockTFT &tft, const char *name, const GFXfont *f,
+                  uint8_t size, bool opaque, bool legacy,
+                  const GFXfontRLE *rle = NULL) {
+  const int frames = 20;
+  uint16_t color = 0xFFE0, bg = opaque ? 0x001F : color;
+  int16_t lineHeight = f ? f->yAdvance * size : 8 * size;
+  if (rle)
+    tft.setFontRLE(rle);
+  else
+    tft.setFont(f);
+  tft.clearStats();
+  auto t0 = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; frame++) {
+    int16_t y = f ? lineHeight : 0;
+    for (const char *line : lines) {
+      int16_t x = 0;
+      for (const char *p = line; *p; p++) {
+        unsigned char c = *p;
+        if (legacy)
+          legacyDrawChar(tft, f, x, y, c, color, bg, size, size);
+        else
+          tft.drawChar(x, y, c, color, bg, size, size);
+        x += f ? f->glyph[c - f->first].xAdvance * size : 6 * size;
+      }
+      y += lineHeight;
+    }
+  }
+  double hostUs = std::chrono::duration<double, std::micro>(
+                      std::chrono::steady_clock::now() - t0)
+                      .count() /
+                  frames;
+  printf("%-22s %-7s %8.0f windows %9.0f bytes %8.2f ms bus %8.1f us host\n",
+         name, legacy ? "before" : "now", (double)tft.windows / frames,
+         (double)tft.busBytes / frames, tft.busMicros(40000000UL) / 1000 / frames,
+         hostUs);
+}
+
+int main() {
+  MockTFT tft(320, 240);
+  tft.begin();
+  printf("per frame of %u lines on a 320x240 TFT\n",
+         (unsigned)(sizeof(lines) / sizeof(lines[0])));
+  for (int legacy = 1; legacy >= 0; legacy--)
+    bench(tft, "classic, transparent", NULL, 1, false, legacy);
+  for (int legacy = 1; legacy >= 0; legacy--)
+    bench(tft, "classic, opaque", NULL, 1, true, legacy);
+  for (int legacy = 1; legacy >= 0; legacy--)
+    bench(tft, "classic x2, opaque", NULL, 2, true, legacy);
+  for (int legacy = 1; legacy >= 0; legacy--)
+    bench(tft, "FreeSans9pt7b", &FreeSans9pt7b, 1, false, legacy);
+  for (int legacy = 1; legacy >= 0; legacy--)
+    bench(tft, "FreeSansBold18pt7b", &FreeSansBold18pt7b, 1, false, legacy);
+
+  const GFXfont *fonts[] = {&FreeSans9pt7b, &FreeSansBold18pt7b};
+  const char *names[] = {"FreeSans9pt7b, packed", "FreeSansBold18pt7b, packed"};
+  for (int i = 0; i < 2; i++) {
+    PackedFont packed(fonts[i]);
+    bench(tft, names[i], &packed.font.font, 1, false, false, &packed.font);
+  }
+  for (int i = 0; i < 2; i++) {
+    PackedFont packed(fonts[i]);
+    size_t raw = PackedFont::rawSize(fonts[i]);
+    printf("%-22s bitmaps %5lu bytes raw, %5lu run-length coded (%+.0f%%), "
+           "runBits 0x%02X\n",
+           names[i], (unsigned long)raw, (unsigned long)packed.bitmap.size(),
+           100.0 * packed.bitmap.size() / raw - 100, packed.font.runBits);
+  }
+  return 0;
+}
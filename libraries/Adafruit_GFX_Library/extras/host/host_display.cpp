@@ -0,0 +1,503 @@
+/*!
+ * @file host_display.cpp
+ *
+ * GFXHostDisplay, see host_display.h.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_display.h"
+#include <stdio.h>
+
+// The buses a new GFXHostDisplay starts with
+static const GFXHostBus defaultBuses[GFX_HOST_BUSES] = {
+    {"SPI", 11, 2, 1, 0, 0, 8, 40000000UL},
+    {"I2C", 11, 2, 1, 31, 2, 9, 400000UL},
+    {"8-bit parallel", 11, 2, 1, 0, 0, 1, 8000000UL}};
+
+static const char *const opNames[GFX_HOST_OPS] = {
+    "drawPixel",
+    "writePixel",
+    "writeFillRect",
+    "writeFastVLine",
+    "writeFastHLine",
+    "writeLine",
+    "writeMonoBitmap",
+    "startWrite",
+    "endWrite",
+    "drawFastVLine",
+    "drawFastHLine",
+    "fillRect",
+    "fillScreen",
+    "drawLine",
+    "drawRect",
+    "setRotation",
+    "invertDisplay"};
+
+/*!
+    @brief  A display in memory, cleared to black.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+GFXHostDisplay::GFXHostDisplay(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), frame(w, h) {
+  memcpy(buses, defaultBuses, sizeof(buses));
+  callLog = logBuffer = NULL;
+  logLength = logSize = 0;
+  depth = 0;
+  logging = false;
+  clearStats();
+}
+
+GFXHostDisplay::~GFXHostDisplay(void) { free(logBuffer); }
+
+/*!
+    @brief  Zero the counts, and empty the log.
+*/
+void GFXHostDisplay::clearStats(void) {
+  memset(calls, 0, sizeof(calls));
+  memset(busBytes, 0, sizeof(busBytes));
+  memset(transfers, 0, sizeof(transfers));
+  windows = pixels = transactions = 0;
+  logLength = 0;
+}
+
+/*!
+    @brief  Start or stop logging each call in callLog[].
+    @param  on  true to log.
+*/
+void GFXHostDisplay::setLogging(bool on) { logging = on; }
+
+/*!
+    @brief  Time the bytes counted so far would take on a bus.
+    @param  bus  GFXHostBusType.
+    @return Microseconds.
+*/
+double GFXHostDisplay::busMicros(uint8_t bus) const {
+  return (double)busBytes[bus] * buses[bus].clocksPerByte * 1e6 /
+         buses[bus].hz;
+}
+
+/*!
+    @brief  Name of a primitive, for reports.
+    @param  op  GFXHostOp.
+    @return The function's name.
+*/
+const char *GFXHostDisplay::opName(uint8_t op) {
+  return (op < GFX_HOST_OPS) ? opNames[op] : "?";
+}
+
+// Count a call, and log it if asked to
+void GFXHostDisplay::record(uint8_t op, int16_t x, int16_t y, int16_t w,
+                            int16_t h, uint16_t color) {
+  calls[op]++;
+  if (!logging)
+    return;
+  if (logLength == logSize) {
+    uint32_t size = logSize ? logSize * 2 : 1024;
+    GFXHostCall *more =
+        (GFXHostCall *)realloc(logBuffer, size * sizeof(GFXHostCall));
+    if (!more)
+      return;
+    callLog = logBuffer = more;
+    logSize = size;
+  }
+  GFXHostCall call = {op, x, y, w, h, color};
+  logBuffer[logLength++] = call;
+}
+
+// Count bytes on one bus, split into transfers if it has a limit
+void GFXHostDisplay::send(uint8_t bus, uint32_t bytes) {
+  const GFXHostBus &b = buses[bus];
+  uint32_t n = b.chunk ? (bytes + b.chunk - 1) / b.chunk : 1;
+  transfers[bus] += n;
+  busBytes[bus] += bytes + n * b.chunkBytes;
+}
+
+// A command with no arguments, on every bus
+void GFXHostDisplay::command(void) {
+  if (!depth)
+    transactions++;
+  for (uint8_t b = 0; b < GFX_HOST_BUSES; b++)
+    send(b, buses[b].commandBytes);
+}
+
+// Fill an area the way a display controller would: clip it, then one
+// address window and its pixels, on every bus
+void GFXHostDisplay::area(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  int16_t x2 = x + w - 1, y2 = y + h - 1;
+  if (!w || !h || x >= _width || y >= _height || x2 < 0 || y2 < 0)
+    return;
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (x2 >= _width)
+    x2 = _width - 1;
+  if (y2 >= _height)
+    y2 = _height - 1;
+  w = x2 - x + 1;
+  h = y2 - y + 1;
+  frame.fillRect(x, y, w, h, color);
+  uint32_t n = (uint32_t)w * h;
+  windows++;
+  pixels += n;
+  if (!depth)
+    transactions++;
+  for (uint8_t b = 0; b < GFX_HOST_BUSES; b++) {
+    send(b, buses[b].windowBytes);
+    send(b, n * buses[b].pixelBytes);
+  }
+}
+
+/*!
+    @brief  Draw a pixel, in its own transaction.
+    @param  x      x coordinate.
+    @param  y      y coordinate.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  record(GFX_HOST_DRAW_PIXEL, x, y, 1, 1, color);
+  area(x, y, 1, 1, color);
+}
+
+/*!
+    @brief  Begin a transaction: chip select goes low, if it isn't already.
+*/
+void GFXHostDisplay::startWrite(void) {
+  record(GFX_HOST_START_WRITE, 0, 0, 0, 0, 0);
+  if (!depth++)
+    transactions++;
+}
+
+/*!
+    @brief  Draw a pixel inside a transaction.
+    @param  x      x coordinate.
+    @param  y      y coordinate.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::writePixel(int16_t x, int16_t y, uint16_t color) {
+  record(GFX_HOST_WRITE_PIXEL, x, y, 1, 1, color);
+  area(x, y, 1, 1, color);
+}
+
+/*!
+    @brief  Fill a rectangle inside a transaction.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width, may be negative.
+    @param  h      Height, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   uint16_t color) {
+  record(GFX_HOST_WRITE_FILL_RECT, x, y, w, h, color);
+  area(x, y, w, h, color);
+}
+
+/*!
+    @brief  Draw a vertical line inside a transaction.
+    @param  x      x coordinate.
+    @param  y      Top end.
+    @param  h      Length, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  record(GFX_HOST_WRITE_FAST_VLINE, x, y, 1, h, color);
+  area(x, y, 1, h, color);
+}
+
+/*!
+    @brief  Draw a horizontal line inside a transaction.
+    @param  x      Left end.
+    @param  y      y coordinate.
+    @param  w      Length, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  record(GFX_HOST_WRITE_FAST_HLINE, x, y, w, 1, color);
+  area(x, y, w, 1, color);
+}
+
+/*!
+    @brief  Draw a line inside a transaction, with Adafruit_GFX's generic
+            code, which counts as the primitives it calls.
+    @param  x0     Start x.
+    @param  y0     Start y.
+    @param  x1     End x.
+    @param  y1     End y.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                               uint16_t color) {
+  record(GFX_HOST_WRITE_LINE, x0, y0, x1, y1, color);
+  Adafruit_GFX::writeLine(x0, y0, x1, y1, color);
+}
+
+/*!
+    @brief  Draw a 1-bit bitmap inside a transaction, with Adafruit_GFX's
+            generic code, which counts as the primitives it calls.
+    @param  x       Left edge.
+    @param  y       Top edge.
+    @param  bitmap  Bitmap in RAM, rows padded to whole bytes.
+    @param  w       Width of bitmap in pixels, before scaling.
+    @param  h       Height of bitmap in pixels, before scaling.
+    @param  size_x  Horizontal magnification.
+    @param  size_y  Vertical magnification.
+    @param  color   16-bit 5-6-5 color of set bits.
+    @param  bg      16-bit 5-6-5 color of clear bits.
+*/
+void GFXHostDisplay::writeMonoBitmap(int16_t x, int16_t y,
+                                     const uint8_t *bitmap, int16_t w,
+                                     int16_t h, uint8_t size_x, uint8_t size_y,
+                                     uint16_t color, uint16_t bg) {
+  record(GFX_HOST_WRITE_MONO_BITMAP, x, y, w * size_x, h * size_y, color);
+  Adafruit_GFX::writeMonoBitmap(x, y, bitmap, w, h, size_x, size_y, color, bg);
+}
+
+/*!
+    @brief  End a transaction: chip select goes high once the outermost
+            startWrite() is ended.
+*/
+void GFXHostDisplay::endWrite(void) {
+  record(GFX_HOST_END_WRITE, 0, 0, 0, 0, 0);
+  if (depth)
+    depth--;
+}
+
+/*!
+    @brief  Rotate drawing, and getPixel() and snapshots with it.
+    @param  r  0 to 3, quarter turns clockwise.
+*/
+void GFXHostDisplay::setRotation(uint8_t r) {
+  record(GFX_HOST_SET_ROTATION, r, 0, 0, 0, 0);
+  Adafruit_GFX::setRotation(r);
+  frame.setRotation(r);
+}
+
+/*!
+    @brief  Counts one command on each bus. Snapshots aren't inverted.
+    @param  i  true to invert.
+*/
+void GFXHostDisplay::invertDisplay(bool i) {
+  record(GFX_HOST_INVERT_DISPLAY, i, 0, 0, 0, 0);
+  command();
+}
+
+/*!
+    @brief  Draw a vertical line, in its own transaction.
+    @param  x      x coordinate.
+    @param  y      Top end.
+    @param  h      Length, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                   uint16_t color) {
+  record(GFX_HOST_DRAW_FAST_VLINE, x, y, 1, h, color);
+  area(x, y, 1, h, color);
+}
+
+/*!
+    @brief  Draw a horizontal line, in its own transaction.
+    @param  x      Left end.
+    @param  y      y coordinate.
+    @param  w      Length, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                   uint16_t color) {
+  record(GFX_HOST_DRAW_FAST_HLINE, x, y, w, 1, color);
+  area(x, y, w, 1, color);
+}
+
+/*!
+    @brief  Fill a rectangle, in its own transaction.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width, may be negative.
+    @param  h      Height, may be negative.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t color) {
+  record(GFX_HOST_FILL_RECT, x, y, w, h, color);
+  area(x, y, w, h, color);
+}
+
+/*!
+    @brief  Fill the whole display, in its own transaction.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::fillScreen(uint16_t color) {
+  record(GFX_HOST_FILL_SCREEN, 0, 0, _width, _height, color);
+  area(0, 0, _width, _height, color);
+}
+
+/*!
+    @brief  Draw a line with Adafruit_GFX's generic code, which counts as
+            the primitives it calls.
+    @param  x0     Start x.
+    @param  y0     Start y.
+    @param  x1     End x.
+    @param  y1     End y.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              uint16_t color) {
+  record(GFX_HOST_DRAW_LINE, x0, y0, x1, y1, color);
+  Adafruit_GFX::drawLine(x0, y0, x1, y1, color);
+}
+
+/*!
+    @brief  Draw a rectangle outline with Adafruit_GFX's generic code,
+            which counts as the primitives it calls.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width.
+    @param  h      Height.
+    @param  color  16-bit 5-6-5 color.
+*/
+void GFXHostDisplay::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t color) {
+  record(GFX_HOST_DRAW_RECT, x, y, w, h, color);
+  Adafruit_GFX::drawRect(x, y, w, h, color);
+}
+
+// 8-bit red, green and blue of a '565' color
+static void rgb888(uint16_t c, uint8_t *out) {
+  uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+  out[0] = (r << 3) | (r >> 2);
+  out[1] = (g << 2) | (g >> 4);
+  out[2] = (b << 3) | (b >> 2);
+}
+
+/*!
+    @brief  Save what's on the display, as it's rotated, as a binary PPM.
+    @param  path  File to write.
+    @return true on success.
+*/
+bool GFXHostDisplay::writePPM(const char *path) const {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  fprintf(f, "P6\n%d %d\n255\n", _width, _height);
+  for (int16_t y = 0; y < _height; y++) {
+    for (int16_t x = 0; x < _width; x++) {
+      uint8_t rgb[3];
+      rgb888(frame.getPixel(x, y), rgb);
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return !fclose(f);
+}
+
+// CRC-32 as PNG uses it, carried on from crc
+static uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n) {
+  crc = ~crc;
+  while (n--) {
+    crc ^= *p++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+// One PNG chunk: length, type, data, CRC
+static void pngChunk(FILE *f, const char *type, const uint8_t *data,
+                     uint32_t n) {
+  uint8_t head[8];
+  put32(head, n);
+  memcpy(head + 4, type, 4);
+  fwrite(head, 1, 8, f);
+  if (n) // IEND has no payload, and fwrite() mustn't be passed NULL
+    fwrite(data, 1, n, f);
+  uint8_t crc[4];
+  put32(crc, crc32(crc32(0, head + 4, 4), data, n));
+  fwrite(crc, 1, 4, f);
+}
+
+/*!
+    @brief  Save what's on the display, as it's rotated, as a PNG. The
+            image data is stored rather than compressed, so no zlib is
+            needed; the files are about the size of a PPM.
+    @param  path  File to write.
+    @return true on success.
+*/
+bool GFXHostDisplay::writePNG(const char *path) const {
+  // Raw image: each row is a 0 (no filter) then RGB bytes
+  uint32_t row = 1 + 3 * (uint32_t)_width, raw = row * _height;
+  // zlib stream of stored deflate blocks, at most 65535 bytes each
+  uint32_t blocks = raw ? (raw + 65534) / 65535 : 1;
+  uint32_t zlen = 2 + blocks * 5 + raw + 4;
+  uint8_t *img = (uint8_t *)malloc(raw + 1), *z = (uint8_t *)malloc(zlen);
+  FILE *f = (img && z) ? fopen(path, "wb") : NULL;
+  if (!f) {
+    free(img);
+    free(z);
+    return false;
+  }
+  for (int16_t y = 0; y < _height; y++) {
+    uint8_t *p = img + y * row;
+    *p++ = 0;
+    for (int16_t x = 0; x < _width; x++, p += 3)
+      rgb888(frame.getPixel(x, y), p);
+  }
+  uint8_t *q = z;
+  *q++ = 0x78; // Deflate, 32K window
+  *q++ = 0x01; // No dictionary, check bits
+  uint32_t a = 1, b = 0; // Adler-32
+  for (uint32_t done = 0, i = 0; i < blocks; i++) {
+    uint32_t n = raw - done;
+    if (n > 65535)
+      n = 65535;
+    *q++ = (i == blocks - 1); // Stored block, last one flagged
+    *q++ = n;
+    *q++ = n >> 8;
+    *q++ = ~n;
+    *q++ = ~n >> 8;
+    memcpy(q, img + done, n);
+    for (uint32_t k = 0; k < n; k++) {
+      a = (a + q[k]) % 65521;
+      b = (b + a) % 65521;
+    }
+    q += n;
+    done += n;
+  }
+  put32(q, (b << 16) | a);
+
+  static const uint8_t signature[8] = {0x89, 'P',  'N',  'G',
+                                       '\r', '\n', 0x1A, '\n'};
+  uint8_t ihdr[13];
+  put32(ihdr, _width);
+  put32(ihdr + 4, _height);
+  ihdr[8] = 8;  // Bits per channel
+  ihdr[9] = 2;  // RGB
+  ihdr[10] = 0; // Deflate
+  ihdr[11] = 0; // Adaptive filtering
+  ihdr[12] = 0; // Not interlaced
+  fwrite(signature, 1, 8, f);
+  pngChunk(f, "IHDR", ihdr, 13);
+  pngChunk(f, "IDAT", z, zlen);
+  pngChunk(f, "IEND", NULL, 0);
+  free(img);
+  free(z);
+  return !fclose(f);
+}
@@ -0,0 +1,148 @@
+/*!
+ * @file host_display.h
+ *
+ * A display for the host build in extras/host that draws into memory and
+ * keeps count of what Adafruit_GFX asks of it. GFXHostDisplay implements
+ * the primitives a display driver would (drawPixel(), writeFillRect(),
+ * startWrite() and the rest), counts every call to them, can log each one,
+ * and works out what each would have cost on an SPI, an I2C and a parallel
+ * bus. What it drew can be saved as a PPM or PNG file.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _HOST_DISPLAY_H_
+#define _HOST_DISPLAY_H_
+
+#include <Adafruit_GFX.h>
+
+/// Primitives GFXHostDisplay counts, one per overridden function
+enum GFXHostOp {
+  GFX_HOST_DRAW_PIXEL,
+  GFX_HOST_WRITE_PIXEL,
+  GFX_HOST_WRITE_FILL_RECT,
+  GFX_HOST_WRITE_FAST_VLINE,
+  GFX_HOST_WRITE_FAST_HLINE,
+  GFX_HOST_WRITE_LINE,
+  GFX_HOST_WRITE_MONO_BITMAP,
+  GFX_HOST_START_WRITE,
+  GFX_HOST_END_WRITE,
+  GFX_HOST_DRAW_FAST_VLINE,
+  GFX_HOST_DRAW_FAST_HLINE,
+  GFX_HOST_FILL_RECT,
+  GFX_HOST_FILL_SCREEN,
+  GFX_HOST_DRAW_LINE,
+  GFX_HOST_DRAW_RECT,
+  GFX_HOST_SET_ROTATION,
+  GFX_HOST_INVERT_DISPLAY,
+  GFX_HOST_OPS ///< Number of the above
+};
+
+/// Buses GFXHostDisplay works out the cost on, all at once
+enum GFXHostBusType {
+  GFX_HOST_SPI,      ///< 4-wire SPI, ILI9341 command set, 40 MHz
+  GFX_HOST_I2C,      ///< Same commands over 400 kHz I2C, 32-byte transfers
+  GFX_HOST_PARALLEL, ///< 8-bit 8080 parallel, 8 million writes a second
+  GFX_HOST_BUSES     ///< Number of the above
+};
+
+/// How a bus carries drawing: every area drawn takes one address window
+/// then its pixels, both split into transfers if the bus has a limit
+typedef struct {
+  const char *name;      ///< For reports
+  uint8_t windowBytes;   ///< Command and argument bytes per address window
+  uint8_t pixelBytes;    ///< Bytes per pixel
+  uint8_t commandBytes;  ///< Bytes for a one-byte command, e.g. invert
+  uint8_t chunk;         ///< Most payload bytes per transfer, 0 if no limit
+  uint8_t chunkBytes;    ///< Bytes added to each transfer, address etc.
+  uint8_t clocksPerByte; ///< Bus clocks per byte
+  uint32_t hz;           ///< Bus clock
+} GFXHostBus;
+
+/// One call to a GFXHostDisplay primitive, as logged
+typedef struct {
+  uint8_t op;     ///< GFXHostOp
+  int16_t x;      ///< x, or x0 for lines, or the rotation or invert flag
+  int16_t y;      ///< y, or y0 for lines
+  int16_t w;      ///< Width, length, or x1 for lines
+  int16_t h;      ///< Height, length, or y1 for lines
+  uint16_t color; ///< Color, if any
+} GFXHostCall;
+
+/// Adafruit_GFX drawing into memory, counting what it's asked to do
+class GFXHostDisplay : public Adafruit_GFX {
+public:
+  GFXHostDisplay(uint16_t w, uint16_t h);
+  ~GFXHostDisplay(void);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void startWrite(void);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  void writeMonoBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                       int16_t h, uint8_t size_x, uint8_t size_y,
+                       uint16_t color, uint16_t bg);
+  void endWrite(void);
+  void setRotation(uint8_t r);
+  void invertDisplay(bool i);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+  /*!
+    @brief  Read back a pixel.
+    @param  x  Column, rotated like drawing is.
+    @param  y  Row, rotated like drawing is.
+    @return 16-bit '565' color last drawn there, 0 if off the display.
+  */
+  uint16_t getPixel(int16_t x, int16_t y) const {
+    return frame.getPixel(x, y);
+  }
+  /*!
+    @brief  What was drawn, as a canvas the size of the display, unrotated.
+    @return The canvas.
+  */
+  const GFXcanvas16 &canvas(void) const { return frame; }
+
+  bool writePPM(const char *path) const;
+  bool writePNG(const char *path) const;
+
+  void clearStats(void);
+  void setLogging(bool on);
+  double busMicros(uint8_t bus) const;
+  static const char *opName(uint8_t op);
+
+  uint32_t calls[GFX_HOST_OPS];       ///< Calls to each primitive
+  uint32_t busBytes[GFX_HOST_BUSES];  ///< Bytes each bus would have carried
+  uint32_t transfers[GFX_HOST_BUSES]; ///< Transfers each bus would have made
+  uint32_t windows;                   ///< Address windows set
+  uint32_t pixels;                    ///< Pixels written
+  uint32_t transactions;              ///< Times chip select went low
+  GFXHostBus buses[GFX_HOST_BUSES];   ///< The buses, which can be changed
+  const GFXHostCall *callLog;         ///< Calls logged, when logging
+  uint32_t logLength;                 ///< Number of calls logged
+
+private:
+  void record(uint8_t op, int16_t x, int16_t y, int16_t w, int16_t h,
+              uint16_t color);
+  void area(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void send(uint8_t bus, uint32_t bytes);
+  void command(void);
+
+  GFXcanvas16 frame;
+  GFXHostCall *logBuffer;
+  uint32_t logSize;
+  uint8_t depth; // startWrite() calls not yet ended
+  bool logging;
+};
+
+#endif // _HOST_DISPLAY_H_
@@ -0,0 +1,64 @@
+/*!
+ * @file Arduino.h
+ *
+ * Just enough of the Arduino core for Adafruit_GFX and Adafruit_SPITFT to
+ * build on a desktop machine, for the tests and benchmarks in extras/host.
+ * See extras/host/README.md. Nothing here is used when building for a board.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_ARDUINO_H_
+#define _GFX_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void delay(unsigned long ms);
+inline void yield(void) {}
+
+class __FlashStringHelper;
+#define F(string_literal)                                                      \
+  (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+/// Only what Adafruit_GFX needs of the Arduino String class
+class String {
+public:
+  String(const char *s = "") : str(s) {}
+  unsigned int length(void) const { return strlen(str); }
+  const char *c_str(void) const { return str; }
+
+private:
+  const char *str;
+};
+
+#include "Print.h"
+
+#endif // _GFX_HOST_ARDUINO_H_
@@ -0,0 +1,38 @@
+/*!
+ * @file Print.h
+ *
+ * The parts of the Arduino Print class that Adafruit_GFX text uses, for the
+ * host build in extras/host.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_PRINT_H_
+#define _GFX_HOST_PRINT_H_
+
+#include <stdio.h>
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--)
+      n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *str) {
+    return write((const uint8_t *)str, strlen(str));
+  }
+  size_t print(const char *str) { return write(str); }
+  size_t print(long n) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", n);
+    return write(buf);
+  }
+  size_t print(int n) { return print((long)n); }
+  size_t println(const char *str) { return print(str) + write('\n'); }
+};
+
+#endif // _GFX_HOST_PRINT_H_
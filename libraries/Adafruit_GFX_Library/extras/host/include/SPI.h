@@ -0,0 +1,42 @@
+/*!
+ * @file SPI.h
+ *
+ * Stand-in for the Arduino SPIClass, for the host build in extras/host.
+ * Bytes aren't sent anywhere, they're handed to the mock display in
+ * mock_tft.h, along with the state of its data/command pin.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_SPI_H_
+#define _GFX_HOST_SPI_H_
+
+#include <Arduino.h>
+
+#define SPI_HAS_TRANSACTION
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST,
+              uint8_t dataMode = SPI_MODE0) {
+    (void)clock;
+    (void)bitOrder;
+    (void)dataMode;
+  }
+};
+
+class SPIClass {
+public:
+  void begin(void) {}
+  void beginTransaction(SPISettings settings) { (void)settings; }
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif // _GFX_HOST_SPI_H_
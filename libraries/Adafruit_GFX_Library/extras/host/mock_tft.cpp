@@ -0,0 +1,175 @@
+/*!
+ * @file mock_tft.cpp
+ *
+ * The Arduino core functions and SPI for the host build, and MockTFT. See
+ * mock_tft.h.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "mock_tft.h"
+
+#define MOCK_DC_PIN 9  ///< Data/command pin MockTFT uses
+#define MOCK_CS_PIN 10 ///< Chip select pin MockTFT uses
+
+SPIClass SPI;
+
+static uint8_t pinState[256];
+static MockTFT *active = NULL; // Display on the other end of SPI
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) { pinState[pin] = val; }
+
+int digitalRead(uint8_t pin) { return pinState[pin]; }
+
+void delay(unsigned long ms) { (void)ms; }
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  if (active && !pinState[MOCK_CS_PIN])
+    active->receive(data, pinState[MOCK_DC_PIN]);
+  return 0;
+}
+
+/*!
+    @brief  Mock display of a given size, on hardware SPI.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+MockTFT::MockTFT(uint16_t w, uint16_t h)
+    : Adafruit_SPITFT(w, h, &SPI, MOCK_CS_PIN, MOCK_DC_PIN, -1) {
+  frame = (uint16_t *)calloc((size_t)w * h, sizeof(uint16_t));
+  command = argCount = 0;
+  pixelHalf = false;
+  colStart = colEnd = rowStart = rowEnd = col = row = 0;
+  clearStats();
+  active = this;
+}
+
+MockTFT::~MockTFT(void) {
+  free(frame);
+  if (active == this)
+    active = NULL;
+}
+
+/*!
+    @brief  Same as a display's begin(), with no commands to send.
+    @param  freq  SPI frequency, ignored.
+*/
+void MockTFT::begin(uint32_t freq) {
+  initSPI(freq);
+  active = this;
+}
+
+/*!
+    @brief  Begin a transaction, routing the SPI stand-in to this display,
+            so that several MockTFTs can be drawn on in turn.
+*/
+void MockTFT::startWrite(void) {
+  active = this;
+  Adafruit_SPITFT::startWrite();
+}
+
+/*!
+    @brief  Set the address window the way an ILI9341 does: CASET and
+            PASET with start and end, then RAMWR.
+    @param  x  Leftmost column.
+    @param  y  Topmost row.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+void MockTFT::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  uint32_t xa = ((uint32_t)x << 16) | (x + w - 1);
+  uint32_t ya = ((uint32_t)y << 16) | (y + h - 1);
+  writeCommand(0x2A); // CASET
+  SPI_WRITE32(xa);
+  writeCommand(0x2B); // PASET
+  SPI_WRITE32(ya);
+  writeCommand(0x2C); // RAMWR
+}
+
+/*!
+    @brief  Forget the counts so far.
+*/
+void MockTFT::clearStats(void) { busBytes = windows = pixels = 0; }
+
+/*!
+    @brief  Time on the bus for what's been counted since clearStats().
+    @param  hz  SPI clock in Hz.
+    @return Microseconds.
+*/
+double MockTFT::busMicros(uint32_t hz) const {
+  return 8.0 * busBytes * 1e6 / hz;
+}
+
+/*!
+    @brief  One byte arriving at the controller.
+    @param  b     The byte.
+    @param  data  true if the data/command pin was high.
+*/
+void MockTFT::receive(uint8_t b, bool data) {
+  busBytes++;
+  if (!data) {
+    command = b;
+    argCount = 0;
+    pixelHalf = false;
+    if (b == 0x2C) { // RAMWR starts at the top left of the window
+      col = colStart;
+      row = rowStart;
+    }
+    return;
+  }
+  switch (command) {
+  case 0x2A: // CASET
+  case 0x2B: // PASET
+    if (argCount < 4)
+      args[argCount++] = b;
+    if (argCount == 4) {
+      uint16_t start = (args[0] << 8) | args[1], end = (args[2] << 8) | args[3];
+      if (command == 0x2A) {
+        colStart = start;
+        colEnd = end;
+      } else {
+        rowStart = start;
+        rowEnd = end;
+        windows++;
+      }
+    }
+    break;
+  case 0x2C: // RAMWR, big-endian pixels left to right, then down
+    if (!pixelHalf) {
+      pixelHi = b;
+      pixelHalf = true;
+      break;
+    }
+    pixelHalf = false;
+    pixels++;
+    if ((col < _width) && (row < _height)) {
+      int16_t x = col, y = row; // Back to unrotated, as the panel sees it
+      switch (rotation) {
+      case 1:
+        x = WIDTH - 1 - row;
+        y = col;
+        break;
+      case 2:
+        x = WIDTH - 1 - col;
+        y = HEIGHT - 1 - row;
+        break;
+      case 3:
+        x = row;
+        y = HEIGHT - 1 - col;
+        break;
+      }
+      frame[y * WIDTH + x] = (pixelHi << 8) | b;
+    }
+    if (col++ == colEnd) {
+      col = colStart;
+      if (row++ == rowEnd)
+        row = rowStart;
+    }
+    break;
+  }
+}
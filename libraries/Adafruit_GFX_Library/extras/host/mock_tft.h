@@ -0,0 +1,54 @@
+/*!
+ * @file mock_tft.h
+ *
+ * A recording stand-in for an SPI TFT, for the host build in extras/host.
+ * MockTFT is an Adafruit_SPITFT whose setAddrWindow() sends the same
+ * commands as an ILI9341, and a model of the controller on the other end of
+ * the SPI stand-in follows them into its own frame buffer, counting the
+ * commands, address windows and bytes that went over the bus on the way.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _MOCK_TFT_H_
+#define _MOCK_TFT_H_
+
+#include <Adafruit_SPITFT.h>
+
+/// Adafruit_SPITFT, recording what it sends
+class MockTFT : public Adafruit_SPITFT {
+public:
+  MockTFT(uint16_t w, uint16_t h);
+  ~MockTFT(void);
+
+  void begin(uint32_t freq = 0);
+  void startWrite(void);
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+  /*!
+    @brief  Read back a pixel from the model of the controller.
+    @param  x  Column, unrotated.
+    @param  y  Row, unrotated.
+    @return 16-bit '565' color last written there.
+  */
+  uint16_t getPixel(int16_t x, int16_t y) const {
+    return frame[y * WIDTH + x];
+  }
+
+  void clearStats(void);
+  double busMicros(uint32_t hz) const;
+
+  uint32_t busBytes; ///< Bytes over SPI, commands and data
+  uint32_t windows;  ///< Address windows set
+  uint32_t pixels;   ///< Pixels written to the frame buffer
+
+  void receive(uint8_t b, bool data);
+
+private:
+  uint16_t *frame;
+  uint8_t command, args[4], argCount, pixelHi;
+  bool pixelHalf;
+  uint16_t colStart, colEnd, rowStart, rowEnd, col, row;
+};
+
+#endif // _MOCK_TFT_H_
@@ -0,0 +1,323 @@
+/*!
+ * @file canvas_ops.cpp
+ *
+ * Checks the canvas blit(), blend() and scroll() operations, and drawing a
+ * canvas region with drawRGBBitmap(), against doing the same a pixel at a
+ * time with getPixel() and drawPixel(). Random rectangles, many of them
+ * clipped, at odd sizes and bit offsets, including copies within one
+ * canvas that overlap.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "mock_tft.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int n) {
+  if (!ok) {
+    if (failures < 20)
+      printf("%s differs, case %d\n", what, n);
+    failures++;
+  }
+}
+
+static void randomize(GFXcanvas1 &c) {
+  for (int16_t y = 0; y < c.height(); y++)
+    for (int16_t x = 0; x < c.width(); x++)
+      c.drawPixel(x, y, rnd(2));
+}
+
+static void randomize(GFXcanvas8 &c) {
+  for (int16_t y = 0; y < c.height(); y++)
+    for (int16_t x = 0; x < c.width(); x++)
+      c.drawPixel(x, y, rnd(4) ? rnd(256) : 7); // Plenty of the key color
+}
+
+static void randomize(GFXcanvas16 &c) {
+  for (int16_t y = 0; y < c.height(); y++)
+    for (int16_t x = 0; x < c.width(); x++)
+      c.drawPixel(x, y, rnd(4) ? rnd(0x10000) : 0xF81F);
+}
+
+static size_t bytes(const GFXcanvas1 &c) {
+  return ((c.width() + 7) / 8) * c.height();
+}
+static size_t bytes(const GFXcanvas8 &c) { return c.width() * c.height(); }
+static size_t bytes(const GFXcanvas16 &c) {
+  return c.width() * c.height() * 2;
+}
+
+template <class C> static void copy(C &to, const C &from) {
+  memcpy(to.getBuffer(), from.getBuffer(), bytes(from));
+}
+
+template <class C> static bool same(const C &a, const C &b) {
+  for (int16_t y = 0; y < a.height(); y++)
+    for (int16_t x = 0; x < a.width(); x++)
+      if (a.getPixel(x, y) != b.getPixel(x, y))
+        return false;
+  return true;
+}
+
+static uint16_t rop(GFXrop op, uint16_t s, uint16_t d) {
+  switch (op) {
+  case GFX_ROP_AND:
+    return s & d;
+  case GFX_ROP_OR:
+    return s | d;
+  case GFX_ROP_XOR:
+    return s ^ d;
+  default:
+    return s;
+  }
+}
+
+static uint16_t mix(uint16_t s, uint16_t d, uint8_t alpha) {
+  int a = (alpha + 4) >> 3;
+  int r = (d >> 11) + (((s >> 11) - (d >> 11)) * a) / 32;
+  int g = ((d >> 5) & 63) + ((((s >> 5) & 63) - ((d >> 5) & 63)) * a) / 32;
+  int b = (d & 31) + (((s & 31) - (d & 31)) * a) / 32;
+  return (r << 11) | (g << 5) | b;
+}
+
+static bool near(uint16_t a, uint16_t b) {
+  return (abs((a >> 11) - (b >> 11)) <= 1) &&
+         (abs(((a >> 5) & 63) - ((b >> 5) & 63)) <= 1) &&
+         (abs((a & 31) - (b & 31)) <= 1);
+}
+
+// Apply op(source pixel, destination pixel) over a rectangle, reading the
+// source from a snapshot, skipping what's off either canvas
+template <class S, class D, class F>
+static void reference(D &dst, const S &src, int16_t sx, int16_t sy, int16_t w,
+                      int16_t h, int16_t dx, int16_t dy, F op) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      int16_t xs = sx + i, ys = sy + j, xd = dx + i, yd = dy + j;
+      if ((xs < 0) || (ys < 0) || (xs >= src.width()) ||
+          (ys >= src.height()) || (xd < 0) || (yd < 0) ||
+          (xd >= dst.width()) || (yd >= dst.height()))
+        continue;
+      int32_t c = op(src.getPixel(xs, ys), dst.getPixel(xd, yd));
+      if (c >= 0)
+        dst.drawPixel(xd, yd, c);
+    }
+  }
+}
+
+template <class C>
+static void scrollReference(C &c, const C &before, int16_t dx, int16_t dy,
+                            uint16_t fill) {
+  for (int16_t y = 0; y < c.height(); y++) {
+    for (int16_t x = 0; x < c.width(); x++) {
+      int16_t xs = x - dx, ys = y - dy;
+      bool in = (xs >= 0) && (ys >= 0) && (xs < c.width()) &&
+                (ys < c.height());
+      c.drawPixel(x, y, in ? before.getPixel(xs, ys) : fill);
+    }
+  }
+}
+
+// A random rectangle and destination, often hanging off the edges
+static void randomRect(int16_t W, int16_t H, int16_t &sx, int16_t &sy,
+                       int16_t &w, int16_t &h, int16_t &dx, int16_t &dy) {
+  sx = rnd(W + 10) - 5;
+  sy = rnd(H + 10) - 5;
+  w = rnd(W + 5);
+  h = rnd(H + 5);
+  dx = rnd(W + 20) - 10;
+  dy = rnd(H + 20) - 10;
+}
+
+template <class C> static void testRop(int16_t W, int16_t H, int n) {
+  C a(W, H), b(W + 9, H - 3), snap(W, H), want(W, H), bsnap(W + 9, H - 3);
+  randomize(a);
+  randomize(b);
+  int16_t sx, sy, w, h, dx, dy;
+  randomRect(W, H, sx, sy, w, h, dx, dy);
+  GFXrop op = (GFXrop)rnd(4);
+  bool self = rnd(2);
+  copy(want, a);
+  if (self) {
+    copy(snap, a);
+    reference(want, snap, sx, sy, w, h, dx, dy,
+              [op](uint16_t s, uint16_t d) { return (int32_t)rop(op, s, d); });
+    a.blit(a, sx, sy, w, h, dx, dy, op);
+  } else {
+    copy(bsnap, b);
+    reference(want, bsnap, sx, sy, w, h, dx, dy,
+              [op](uint16_t s, uint16_t d) { return (int32_t)rop(op, s, d); });
+    a.blit(b, sx, sy, w, h, dx, dy, op);
+  }
+  check(same(a, want), "raster op blit", n);
+}
+
+template <class C, typename T>
+static void testKeyed(int16_t W, int16_t H, T key, int n) {
+  C a(W, H), snap(W, H), want(W, H);
+  randomize(a);
+  int16_t sx, sy, w, h, dx, dy;
+  randomRect(W, H, sx, sy, w, h, dx, dy);
+  copy(want, a);
+  copy(snap, a);
+  reference(want, snap, sx, sy, w, h, dx, dy, [key](uint16_t s, uint16_t) {
+    return (s == key) ? (int32_t)-1 : (int32_t)s;
+  });
+  a.blitKeyed(a, sx, sy, w, h, dx, dy, key);
+  check(same(a, want), "keyed blit", n);
+}
+
+template <class C, typename T>
+static void testExpand(int16_t W, int16_t H, T color, T bg, int n) {
+  GFXcanvas1 bits(W + 5, H + 2);
+  C a(W, H), want(W, H);
+  randomize(bits);
+  randomize(a);
+  copy(want, a);
+  int16_t sx, sy, w, h, dx, dy;
+  randomRect(W, H, sx, sy, w, h, dx, dy);
+  reference(want, bits, sx, sy, w, h, dx, dy,
+            [color, bg](uint16_t s, uint16_t) {
+              return s ? (int32_t)color : (bg == color) ? -1 : (int32_t)bg;
+            });
+  a.blit(bits, sx, sy, w, h, dx, dy, color, bg);
+  check(same(a, want), "1-bit expansion", n);
+}
+
+template <class C> static void testScroll(int16_t W, int16_t H, int n) {
+  C a(W, H), before(W, H), want(W, H);
+  randomize(a);
+  copy(before, a);
+  int16_t dx = rnd(2 * W + 7) - W - 3, dy = rnd(2 * H + 7) - H - 3;
+  if (rnd(4) == 0)
+    dx = 0;
+  else if (rnd(4) == 0)
+    dy = 0;
+  uint16_t fill = rnd(2);
+  scrollReference(want, before, dx, dy, fill);
+  a.scroll(dx, dy, fill);
+  check(same(a, want), "scroll", n);
+}
+
+static void testPalette(int n) {
+  GFXcanvas8 src(29, 17);
+  GFXcanvas16 a(40, 30), want(40, 30);
+  uint16_t palette[256];
+  for (int i = 0; i < 256; i++)
+    palette[i] = rnd(0x10000);
+  randomize(src);
+  randomize(a);
+  copy(want, a);
+  int16_t sx, sy, w, h, dx, dy;
+  randomRect(40, 30, sx, sy, w, h, dx, dy);
+  reference(want, src, sx, sy, w, h, dx, dy, [&palette](uint16_t s, uint16_t) {
+    return (int32_t)palette[s];
+  });
+  a.blit(src, sx, sy, w, h, dx, dy, palette);
+  check(same(a, want), "palette blit", n);
+}
+
+static void testBlend(int n) {
+  GFXcanvas16 a(41, 30), b(33, 35), want(41, 30);
+  randomize(a);
+  randomize(b);
+  copy(want, a);
+  int16_t sx, sy, w, h, dx, dy;
+  randomRect(41, 30, sx, sy, w, h, dx, dy);
+  uint8_t alpha = (n & 1) ? rnd(256) : ((n & 2) ? 255 : 0);
+  reference(want, b, sx, sy, w, h, dx, dy, [alpha](uint16_t s, uint16_t d) {
+    return (int32_t)mix(s, d, alpha);
+  });
+  a.blend(b, sx, sy, w, h, dx, dy, alpha);
+  bool ok = true;
+  for (int16_t y = 0; y < 30; y++)
+    for (int16_t x = 0; x < 41; x++)
+      if (!near(a.getPixel(x, y), want.getPixel(x, y)))
+        ok = false;
+  // All or nothing must be exact
+  if ((alpha == 0) || (alpha == 255))
+    ok = ok && same(a, want);
+  check(ok, "blend", n);
+}
+
+// A canvas region to the TFT in one address window, and through the
+// generic Adafruit_GFX path to another canvas
+static void testPush(MockTFT &tft, int n) {
+  GFXcanvas16 sprite(37, 21), screen(tft.width(), tft.height()),
+      want(tft.width(), tft.height());
+  randomize(sprite);
+  int16_t cx, cy, w, h, x, y;
+  randomRect(37, 21, cx, cy, w, h, x, y);
+  x = rnd(tft.width() + 40) - 30;
+  y = rnd(tft.height() + 30) - 20;
+  tft.fillScreen(0);
+  screen.fillScreen(0);
+  want.fillScreen(0);
+  reference(want, sprite, cx, cy, w, h, x, y,
+            [](uint16_t s, uint16_t) { return (int32_t)s; });
+  tft.clearStats();
+  tft.drawRGBBitmap(x, y, sprite, cx, cy, w, h);
+  screen.drawRGBBitmap(x, y, sprite, cx, cy, w, h);
+  check(same(screen, want), "drawRGBBitmap() from a canvas to a canvas", n);
+  bool ok = tft.windows <= 1;
+  for (int16_t py = 0; py < tft.height(); py++) {
+    for (int16_t px = 0; px < tft.width(); px++) {
+      // MockTFT reads back unrotated
+      int16_t ux = px, uy = py;
+      switch (tft.getRotation()) {
+      case 1:
+        ux = tft.height() - 1 - py;
+        uy = px;
+        break;
+      case 2:
+        ux = tft.width() - 1 - px;
+        uy = tft.height() - 1 - py;
+        break;
+      case 3:
+        ux = py;
+        uy = tft.width() - 1 - px;
+        break;
+      }
+      if (tft.getPixel(ux, uy) != want.getPixel(px, py))
+        ok = false;
+    }
+  }
+  check(ok, "drawRGBBitmap() from a canvas to MockTFT", n);
+}
+
+int main() {
+  MockTFT tft(64, 48);
+  tft.begin();
+  for (int n = 0; n < 2000; n++) {
+    int16_t W = 1 + rnd(70), H = 1 + rnd(40);
+    testRop<GFXcanvas1>(W, H, n);
+    testRop<GFXcanvas8>(W, H, n);
+    testRop<GFXcanvas16>(W, H, n);
+    testKeyed<GFXcanvas8, uint8_t>(W, H, 7, n);
+    testKeyed<GFXcanvas16, uint16_t>(W, H, 0xF81F, n);
+    testExpand<GFXcanvas8, uint8_t>(W, H, rnd(256), rnd(2) ? 0x55 : 0, n);
+    testExpand<GFXcanvas16, uint16_t>(W, H, 0x07E0, rnd(2) ? 0x07E0 : 0x1234,
+                                      n);
+    testScroll<GFXcanvas1>(W, H, n);
+    testScroll<GFXcanvas8>(W, H, n);
+    testScroll<GFXcanvas16>(W, H, n);
+    testPalette(n);
+    testBlend(n);
+    tft.setRotation(n & 3);
+    testPush(tft, n);
+  }
+
+  if (failures)
+    printf("%d cases differ\n", failures);
+  return failures ? 1 : 0;
+}
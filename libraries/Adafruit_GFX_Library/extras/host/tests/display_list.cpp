@@ -0,0 +1,190 @@
+/*!
+ * @file display_list.cpp
+ *
+ * Draws random scenes (shapes, lines, arcs, polygons, text in several fonts,
+ * one run-length coded, with wrapping, bitmaps) both straight onto MockTFT and into an
+ * Adafruit_DisplayList, then renders the list to another MockTFT, in every
+ * rotation, and to a canvas, and checks all three come out the same. The
+ * strip height doesn't divide the screen, so the last strip is a short one.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "pack_font.h"
+#include "mock_tft.h"
+#include <Adafruit_DisplayList.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSerifBoldItalic12pt7b.h>
+#include <Fonts/Picopixel.h>
+
+static uint32_t seed;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static const uint8_t PROGMEM logo[] = {0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99,
+                                       0x42, 0x3C, 0xFF, 0x00, 0x81, 0x7E};
+static uint8_t ramBits[4 * 20];
+static uint16_t sprite[17 * 9];
+static PackedFont packedSerif(&FreeSerifBoldItalic12pt7b);
+
+// The same calls on either; templated so the display list's own bitmap
+// functions are the ones called
+template <class G> static void drawScene(G &g, uint32_t sceneSeed) {
+  const GFXfont *fonts[] = {NULL, &FreeSans9pt7b, &FreeSerifBoldItalic12pt7b,
+                            &Picopixel};
+  int16_t W = g.width(), H = g.height();
+  seed = sceneSeed;
+  g.fillScreen(rnd(0x10000));
+  for (int n = 0; n < 40; n++) {
+    int16_t x = rnd(W + 40) - 20, y = rnd(H + 40) - 20;
+    int16_t w = rnd(W / 2) - 10, h = rnd(H / 2) - 10;
+    uint16_t color = rnd(0x10000), bg = rnd(0x10000);
+    switch (rnd(15)) {
+    case 0:
+      g.fillRect(x, y, w, h, color);
+      break;
+    case 1:
+      g.drawRect(x, y, w, h, color);
+      break;
+    case 2:
+      g.drawLine(x, y, rnd(W + 40) - 20, rnd(H + 40) - 20, color);
+      break;
+    case 3:
+      g.fillCircle(x, y, rnd(40), color);
+      break;
+    case 4:
+      g.drawCircle(x, y, rnd(40), color);
+      break;
+    case 5:
+      g.fillRoundRect(x, y, abs(w) + 10, abs(h) + 10, 5, color);
+      break;
+    case 6:
+      g.fillTriangle(x, y, rnd(W), rnd(H), rnd(W), rnd(H), color);
+      break;
+    case 7:
+      g.drawPixel(x, y, color);
+      break;
+    case 8:
+    case 9: {
+      int f = rnd(5);
+      if (f < 4)
+        g.setFont(fonts[f]);
+      else
+        g.setFontRLE(&packedSerif.font);
+      g.setTextSize(1 + rnd(2), 1 + rnd(2));
+      g.setTextWrap(rnd(2));
+      if (rnd(2))
+        g.setTextColor(color);
+      else
+        g.setTextColor(color, bg);
+      g.setCursor(x, y);
+      g.print("Display list 123\nwraps");
+      break;
+    }
+    case 10:
+      if (rnd(2))
+        g.drawBitmap(x, y, logo, 8, 12, color, bg);
+      else
+        g.drawBitmap(x, y, ramBits, 27, 20, color);
+      break;
+    case 11:
+      g.drawRGBBitmap(x, y, sprite, 17, 9);
+      break;
+    case 12:
+      g.fillArc(x, y, rnd(20), 20 + rnd(30), rnd(360), rnd(720), color);
+      break;
+    case 13:
+      g.drawThickLine(x, y, rnd(W), rnd(H), rnd(12), color);
+      break;
+    case 14: {
+      int16_t star[10];
+      for (int i = 0; i < 10; i++)
+        star[i] = ((i & 1) ? y : x) + rnd(60) - 30;
+      g.fillPolygon(star, 5, color);
+      break;
+    }
+    }
+  }
+}
+
+// MockTFT reads back unrotated
+static uint16_t tftPixel(MockTFT &tft, int16_t x, int16_t y) {
+  switch (tft.getRotation()) {
+  case 1:
+    return tft.getPixel(tft.height() - 1 - y, x);
+  case 2:
+    return tft.getPixel(tft.width() - 1 - x, tft.height() - 1 - y);
+  case 3:
+    return tft.getPixel(y, tft.width() - 1 - x);
+  default:
+    return tft.getPixel(x, y);
+  }
+}
+
+int main() {
+  int failures = 0;
+  seed = 99;
+  for (uint8_t &b : ramBits)
+    b = rnd(256);
+  for (uint16_t &c : sprite)
+    c = rnd(0x10000);
+
+  MockTFT tft(160, 128), direct(160, 128);
+  tft.begin();
+  direct.begin();
+  for (int scene = 0; scene < 200; scene++) {
+    tft.setRotation(scene & 3);
+    direct.setRotation(scene & 3);
+    int16_t W = tft.width(), H = tft.height();
+    GFXcanvas16 got(W, H);
+    Adafruit_DisplayList list(W, H, 8192, 13);
+    drawScene(direct, scene);
+    drawScene(list, scene);
+    if (list.overflowed()) {
+      printf("scene %d: list overflowed at %u bytes\n", scene, list.used());
+      failures++;
+      continue;
+    }
+    tft.clearStats();
+    list.render(tft);
+    list.render(got);
+
+    bool tftOk = tft.windows == 1, canvasOk = true;
+    for (int16_t y = 0; y < H; y++) {
+      for (int16_t x = 0; x < W; x++) {
+        uint16_t want = tftPixel(direct, x, y);
+        if (tftPixel(tft, x, y) != want)
+          tftOk = false;
+        if (got.getPixel(x, y) != want)
+          canvasOk = false;
+      }
+    }
+    if (!tftOk || !canvasOk) {
+      printf("scene %d, rotation %d: %s differs\n", scene, scene & 3,
+             tftOk ? "canvas" : "MockTFT");
+      failures++;
+    }
+  }
+
+  // Out of room: what didn't fit is dropped, and that is reported
+  Adafruit_DisplayList small(160, 128, 64);
+  small.fillScreen(0);
+  for (int i = 0; i < 20; i++)
+    small.drawLine(0, i, 159, 127 - i, 0xFFFF);
+  if (!small.overflowed() || (small.used() > 64)) {
+    printf("a full list isn't reported\n");
+    failures++;
+  }
+  small.fillScreen(0);
+  if (small.overflowed()) {
+    printf("fillScreen() doesn't start a new list\n");
+    failures++;
+  }
+
+  if (failures)
+    printf("%d scenes differ\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,241 @@
+/*!
+ * @file host_display.cpp
+ *
+ * Checks GFXHostDisplay: random scenes drawn on it in every rotation have
+ * to match the same drawn on a GFXcanvas16, calls and bus bytes are counted
+ * as documented (with clipping, transactions and I2C transfer splitting),
+ * calls are logged as made, and PPM and PNG snapshots read back as what
+ * was drawn.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_display.h"
+#include <Fonts/FreeSans9pt7b.h>
+#include <stdio.h>
+
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("%s\n", what);
+    failures++;
+  }
+}
+
+template <class G> static void scene(G &g, uint32_t s) {
+  seed = s;
+  g.fillScreen(rnd(0x10000));
+  for (int i = 0; i < 12; i++) {
+    int16_t x = rnd(g.width() + 40) - 20, y = rnd(g.height() + 40) - 20;
+    uint16_t color = rnd(0x10000);
+    switch (rnd(8)) {
+    case 0:
+      g.fillCircle(x, y, rnd(30), color);
+      break;
+    case 1:
+      g.drawLine(x, y, rnd(g.width()), rnd(g.height()), color);
+      break;
+    case 2:
+      g.fillTriangle(x, y, rnd(g.width()), rnd(g.height()), rnd(g.width()),
+                     rnd(g.height()), color);
+      break;
+    case 3:
+      g.drawRoundRect(x, y, rnd(60) + 8, rnd(40) + 8, 4, color);
+      break;
+    case 4:
+      g.setFont(rnd(2) ? &FreeSans9pt7b : NULL);
+      g.setTextColor(color, rnd(2) ? color : rnd(0x10000));
+      g.setCursor(x, y);
+      g.print("Host 42");
+      break;
+    case 5:
+      g.fillRect(x, y, rnd(50) + 1, rnd(50) + 1, color);
+      break;
+    case 6:
+      g.drawCircle(x, y, rnd(40), color);
+      break;
+    default:
+      g.drawRect(x, y, rnd(50), rnd(50), color);
+      break;
+    }
+  }
+}
+
+static uint32_t readFile(const char *path, uint8_t *buf, uint32_t size) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return 0;
+  uint32_t n = fread(buf, 1, size, f);
+  fclose(f);
+  return n;
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+// Does pixel data at p (RGB, 8 bits each) match the display?
+static bool sameImage(GFXHostDisplay &d, const uint8_t *p, bool filterBytes) {
+  for (int16_t y = 0; y < d.height(); y++) {
+    if (filterBytes && *p++ != 0)
+      return false;
+    for (int16_t x = 0; x < d.width(); x++, p += 3) {
+      uint16_t c = d.getPixel(x, y);
+      if ((p[0] >> 3) != (c >> 11) || (p[1] >> 2) != ((c >> 5) & 0x3F) ||
+          (p[2] >> 3) != (c & 0x1F))
+        return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  // Drawing matches a canvas, in every rotation
+  GFXHostDisplay display(96, 64);
+  GFXcanvas16 canvas(96, 64);
+  for (uint32_t s = 1; s <= 200; s++) {
+    display.setRotation(s & 3);
+    canvas.setRotation(s & 3);
+    scene(display, s);
+    scene(canvas, s);
+    bool ok = true;
+    for (int16_t y = 0; y < canvas.height(); y++)
+      for (int16_t x = 0; x < canvas.width(); x++)
+        if (display.getPixel(x, y) != canvas.getPixel(x, y))
+          ok = false;
+    if (!ok) {
+      printf("scene %lu, rotation %lu differs from a canvas\n",
+             (unsigned long)s, (unsigned long)(s & 3));
+      failures++;
+    }
+  }
+
+  // Counting: a 10x10 fill is one window of 100 pixels
+  GFXHostDisplay d(40, 30);
+  d.fillRect(10, 10, 10, 10, 0xF800);
+  check(d.calls[GFX_HOST_FILL_RECT] == 1 && d.windows == 1 &&
+            d.pixels == 100 && d.transactions == 1,
+        "fillRect() counted wrong");
+  check(d.busBytes[GFX_HOST_SPI] == 211 &&
+            d.busBytes[GFX_HOST_PARALLEL] == 211,
+        "SPI or parallel bytes wrong");
+  // I2C: 11 command bytes in one transfer, 200 pixel bytes in 7 of up to 31,
+  // each transfer 2 bytes more
+  check(d.busBytes[GFX_HOST_I2C] == 11 + 200 + 8 * 2 &&
+            d.transfers[GFX_HOST_I2C] == 8,
+        "I2C bytes or transfers wrong");
+  check(d.busMicros(GFX_HOST_SPI) > 42.19 &&
+            d.busMicros(GFX_HOST_SPI) < 42.21,
+        "SPI time wrong");
+
+  // Clipped to what's on the display, nothing at all if that's nothing
+  d.clearStats();
+  d.fillRect(-5, -5, 10, 10, 0x001F);
+  d.drawPixel(40, 0, 0xFFFF);
+  d.writeFastHLine(35, 29, -10, 0x07E0); // Negative width, leftward
+  check(d.windows == 2 && d.pixels == 25 + 10 &&
+            d.calls[GFX_HOST_DRAW_PIXEL] == 1,
+        "clipping counted wrong");
+  check(d.getPixel(0, 0) == 0x001F && d.getPixel(5, 5) == 0 &&
+            d.getPixel(26, 29) == 0x07E0 && d.getPixel(35, 29) == 0x07E0 &&
+            d.getPixel(25, 29) == 0 && d.getPixel(36, 29) == 0,
+        "clipped drawing wrong");
+
+  // One transaction for many writes, nested startWrite() included
+  d.clearStats();
+  d.startWrite();
+  d.startWrite();
+  d.writePixel(1, 1, 1);
+  d.endWrite();
+  d.writePixel(2, 1, 1);
+  d.endWrite();
+  d.writePixel(3, 1, 1); // Outside one, a transaction of its own
+  check(d.transactions == 2 && d.windows == 3, "transactions counted wrong");
+
+  // Calls the generic code makes are counted, and logged in order
+  d.clearStats();
+  d.setLogging(true);
+  d.drawLine(0, 0, 3, 2, 0x1234);
+  check(d.calls[GFX_HOST_DRAW_LINE] == 1 && d.calls[GFX_HOST_WRITE_LINE] == 1 &&
+            d.calls[GFX_HOST_START_WRITE] == 1 &&
+            d.calls[GFX_HOST_WRITE_PIXEL] == 4 &&
+            d.calls[GFX_HOST_END_WRITE] == 1,
+        "drawLine() calls counted wrong");
+  check(d.logLength == 8 && d.callLog[0].op == GFX_HOST_DRAW_LINE &&
+            d.callLog[0].w == 3 && d.callLog[0].h == 2 &&
+            d.callLog[1].op == GFX_HOST_START_WRITE &&
+            d.callLog[2].op == GFX_HOST_WRITE_LINE &&
+            d.callLog[3].op == GFX_HOST_WRITE_PIXEL &&
+            d.callLog[7].op == GFX_HOST_END_WRITE &&
+            d.callLog[6].color == 0x1234,
+        "drawLine() logged wrong");
+  for (int i = 0; i < 3000; i++) // Log grows as it needs to
+    d.drawPixel(i % 40, 0, i);
+  check(d.logLength == 3008 && d.callLog[3007].color == 2999,
+        "long log wrong");
+  d.setLogging(false);
+  d.clearStats();
+  d.invertDisplay(true);
+  check(d.logLength == 0 && d.calls[GFX_HOST_INVERT_DISPLAY] == 1 &&
+            d.busBytes[GFX_HOST_SPI] == 1 && d.busBytes[GFX_HOST_I2C] == 3,
+        "invertDisplay() counted wrong");
+
+  // Snapshots, of a scene in a rotation that makes them tall
+  display.setRotation(1);
+  scene(display, 7);
+  static uint8_t file[64 * 96 * 3 + 4096];
+  uint32_t n = display.writePPM("host_display.ppm")
+                   ? readFile("host_display.ppm", file, sizeof(file))
+                   : 0;
+  const char *ppmHead = "P6\n64 96\n255\n";
+  check(n == strlen(ppmHead) + 64 * 96 * 3 &&
+            !memcmp(file, ppmHead, strlen(ppmHead)) &&
+            sameImage(display, file + strlen(ppmHead), false),
+        "PPM wrong");
+  remove("host_display.ppm");
+
+  n = display.writePNG("host_display.png")
+          ? readFile("host_display.png", file, sizeof(file))
+          : 0;
+  remove("host_display.png");
+  // Signature, then IHDR, IDAT and IEND with their lengths; the IDAT is
+  // stored deflate blocks, so the image can be read straight out of them
+  static uint8_t image[64 * 97 * 3];
+  uint32_t got = 0;
+  bool ok = n > 8 && !memcmp(file, "\x89PNG\r\n\x1A\n", 8);
+  const uint8_t *p = file + 8, *end = file + n;
+  ok = ok && !memcmp(p + 4, "IHDR", 4) && get32(p + 8) == 64 &&
+       get32(p + 12) == 96 && p[16] == 8 && p[17] == 2;
+  p += 12 + 13;
+  ok = ok && !memcmp(p + 4, "IDAT", 4) && p[8] == 0x78 && p[9] == 0x01;
+  if (ok) {
+    const uint8_t *q = p + 10, *idatEnd = p + 8 + get32(p);
+    for (bool last = false; ok && !last;) {
+      uint16_t len = q[1] | (q[2] << 8), nlen = q[3] | (q[4] << 8);
+      last = q[0] & 1;
+      ok = ok && (q[0] >> 1) == 0 && (uint16_t)~len == nlen &&
+           got + len <= sizeof(image);
+      if (ok)
+        memcpy(image + got, q + 5, len);
+      got += len;
+      q += 5 + len;
+    }
+    ok = ok && q + 4 == idatEnd;
+    p = idatEnd + 4;
+    ok = ok && p + 12 == end && get32(p) == 0 && !memcmp(p + 4, "IEND", 4);
+  }
+  check(ok && got == 96 * (1 + 64 * 3) && sameImage(display, image, true),
+        "PNG wrong");
+
+  if (failures)
+    printf("%d checks failed\n", failures);
+  return failures ? 1 : 0;
+}
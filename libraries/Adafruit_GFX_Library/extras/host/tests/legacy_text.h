@@ -0,0 +1,85 @@
+/*!
+ * @file legacy_text.h
+ *
+ * drawChar() as it was before text was drawn in runs: one writePixel() (or
+ * writeFillRect(), when magnified) per pixel. The tests check the current
+ * drawChar() against it, and the benchmark compares the two.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _LEGACY_TEXT_H_
+#define _LEGACY_TEXT_H_
+
+#include <Adafruit_GFX.h>
+#include <glcdfont.c> // Its own copy of the classic font, it's static
+
+static inline void legacyDrawChar(Adafruit_GFX &d, const GFXfont *gfxFont,
+                                  int16_t x, int16_t y, unsigned char c,
+                                  uint16_t color, uint16_t bg, uint8_t size_x,
+                                  uint8_t size_y) {
+  if (!gfxFont) {
+    if ((x >= d.width()) || (y >= d.height()) ||
+        ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0))
+      return;
+    if (c >= 176)
+      c++; // Default, not cp437
+    d.startWrite();
+    for (int8_t i = 0; i < 5; i++) {
+      uint8_t line = font[c * 5 + i];
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (size_x == 1 && size_y == 1)
+            d.writePixel(x + i, y + j, color);
+          else
+            d.writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                            color);
+        } else if (bg != color) {
+          if (size_x == 1 && size_y == 1)
+            d.writePixel(x + i, y + j, bg);
+          else
+            d.writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                            bg);
+        }
+      }
+    }
+    if (bg != color) {
+      if (size_x == 1 && size_y == 1)
+        d.writeFastVLine(x + 5, y, 8, bg);
+      else
+        d.writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+    d.endWrite();
+  } else {
+    c -= gfxFont->first;
+    const GFXglyph *glyph = &gfxFont->glyph[c];
+    const uint8_t *bitmap = gfxFont->bitmap;
+    uint16_t bo = glyph->bitmapOffset;
+    uint8_t w = glyph->width, h = glyph->height;
+    int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+    uint8_t xx, yy, bits = 0, bit = 0;
+    int16_t xo16 = 0, yo16 = 0;
+    if (size_x > 1 || size_y > 1) {
+      xo16 = xo;
+      yo16 = yo;
+    }
+    d.startWrite();
+    for (yy = 0; yy < h; yy++) {
+      for (xx = 0; xx < w; xx++) {
+        if (!(bit++ & 7))
+          bits = bitmap[bo++];
+        if (bits & 0x80) {
+          if (size_x == 1 && size_y == 1)
+            d.writePixel(x + xo + xx, y + yo + yy, color);
+          else
+            d.writeFillRect(x + (xo16 + xx) * size_x,
+                            y + (yo16 + yy) * size_y, size_x, size_y, color);
+        }
+        bits <<= 1;
+      }
+    }
+    d.endWrite();
+  }
+}
+
+#endif // _LEGACY_TEXT_H_
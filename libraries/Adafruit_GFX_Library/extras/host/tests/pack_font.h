@@ -0,0 +1,117 @@
+/*!
+ * @file pack_font.h
+ *
+ * Run-length codes a GFXfont already in memory, as fontconvert -r does from
+ * a TrueType file (the format is described in gfxfont.h), so the tests and
+ * benchmarks can try the fonts in Fonts/ both ways. Written from the format
+ * description rather than shared with fontconvert, so each checks the other.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _PACK_FONT_H_
+#define _PACK_FONT_H_
+
+#include <vector> // Before Arduino.h, whose min() and max() are macros
+
+#include <Adafruit_GFX.h>
+
+class PackedFont {
+public:
+  // With clearBits of 0, the run widths that make the smallest font
+  PackedFont(const GFXfont *raw, uint8_t clearBits = 0, uint8_t setBits = 0) {
+    if (!clearBits) {
+      size_t best = 0;
+      for (uint8_t i = 1; i <= 8; i++) {
+        for (uint8_t j = 1; j <= 8; j++) {
+          pack(raw, i, j);
+          if (!best || bitmap.size() < best) {
+            best = bitmap.size();
+            clearBits = i;
+            setBits = j;
+          }
+        }
+      }
+    }
+    pack(raw, clearBits, setBits);
+  }
+
+  // Bytes of raw bitmap, to compare with bitmap.size()
+  static size_t rawSize(const GFXfont *raw) {
+    size_t bytes = 0;
+    for (int c = 0; c <= raw->last - raw->first; c++)
+      bytes += (raw->glyph[c].width * raw->glyph[c].height + 7) / 8;
+    return bytes;
+  }
+
+  std::vector<uint8_t> bitmap;
+  std::vector<GFXglyph> glyphs;
+  GFXfontRLE font;
+
+private:
+  uint8_t b0, b1;
+  size_t bits;
+
+  void put(uint16_t value, uint8_t n) {
+    while (n--) {
+      if (!(bits & 7))
+        bitmap.push_back(0);
+      if ((value >> n) & 1)
+        bitmap.back() |= 0x80 >> (bits & 7);
+      bits++;
+    }
+  }
+
+  // One pair, or another repeat of the last one
+  void pair(uint16_t clear, uint16_t set, int &lastClear, int &lastSet) {
+    if (clear == lastClear && set == lastSet) {
+      put(1, 1);
+      return;
+    }
+    if (lastClear >= 0)
+      put(0, 1);
+    put(clear, b0);
+    put(set, b1);
+    lastClear = clear;
+    lastSet = set;
+  }
+
+  void pack(const GFXfont *raw, uint8_t clearBits, uint8_t setBits) {
+    b0 = clearBits;
+    b1 = setBits;
+    bitmap.clear();
+    glyphs.assign(raw->glyph, raw->glyph + (raw->last - raw->first + 1));
+    bits = 0;
+    const uint16_t maxClear = (1 << b0) - 1, maxSet = (1 << b1) - 1;
+    for (GFXglyph &g : glyphs) {
+      const uint8_t *src = raw->bitmap + g.bitmapOffset;
+      g.bitmapOffset = bitmap.size();
+      int n = g.width * g.height, i = 0, lastClear = -1, lastSet = -1;
+      while (i < n) {
+        uint16_t clear = 0, set = 0;
+        for (; i < n && !(src[i / 8] & (0x80 >> (i & 7))); i++)
+          clear++;
+        for (; i < n && (src[i / 8] & (0x80 >> (i & 7))); i++)
+          set++;
+        if (!set) { // Clear to the end
+          if (lastClear >= 0)
+            put(0, 1);
+          put(0, b0 + b1);
+          break;
+        }
+        for (; clear > maxClear; clear -= maxClear)
+          pair(maxClear, 0, lastClear, lastSet);
+        for (; set > maxSet; set -= maxSet, clear = 0)
+          pair(clear, maxSet, lastClear, lastSet);
+        pair(clear, set, lastClear, lastSet);
+      }
+      bits = (bits + 7) & ~7; // Next glyph starts on a whole byte
+    }
+    font.font = *raw;
+    font.font.bitmap = bitmap.data();
+    font.font.glyph = glyphs.data();
+    font.runBits = (b0 << 4) | b1;
+  }
+};
+
+#endif // _PACK_FONT_H_
@@ -0,0 +1,130 @@
+/*!
+ * @file packed_fonts.cpp
+ *
+ * Checks run-length coded fonts: two hand-coded glyphs pin the format down
+ * bit for bit, then fonts from Fonts/ are packed (tests/pack_font.h) with
+ * the best run widths and with some awkward ones, which split long runs
+ * and repeat pairs a lot, and every glyph is drawn at random sizes and
+ * positions, many clipped, on a GFXcanvas16 and on MockTFT. Each has to
+ * match the raw font drawn on a canvas pixel for pixel, and MockTFT has to
+ * get the same address windows and bytes as with the raw font, so runs
+ * split across pairs still go out as one line.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "pack_font.h" // First, it needs <vector> before Arduino.h
+#include "mock_tft.h"
+#include <Fonts/FreeMono9pt7b.h>
+#include <Fonts/FreeSansBold24pt7b.h>
+#include <Fonts/FreeSerifItalic18pt7b.h>
+#include <Fonts/Picopixel.h>
+
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("%s\n", what);
+    failures++;
+  }
+}
+
+// '0' is .##. / #### / #..# : pairs (1,2) (1,5) (2,1), ending exactly.
+// '1' is #.. / #.. / #.. / ... : pairs (0,1) (2,1) twice, then clear.
+// With 2-bit clear runs and 3-bit set runs:
+//   01 010, 0, 01 101, 0, 10 001
+//   00 001, 0, 10 001, 1, 0, 00 000
+static const uint8_t handBitmap[] = {0x51, 0xA8, 0x80, 0x0A, 0x30, 0x00};
+static const uint8_t handRaw[] = {0x6F, 0x90, 0x92, 0x00};
+static const GFXglyph handGlyphs[] = {{0, 4, 3, 5, 0, -3},
+                                      {3, 3, 4, 4, 0, -3}};
+static const GFXglyph handRawGlyphs[] = {{0, 4, 3, 5, 0, -3},
+                                         {2, 3, 4, 4, 0, -3}};
+static const GFXfontRLE handFont = {
+    {(uint8_t *)handBitmap, (GFXglyph *)handGlyphs, '0', '1', 5}, 0x23};
+static const GFXfont handRawFont = {(uint8_t *)handRaw,
+                                    (GFXglyph *)handRawGlyphs, '0', '1', 5};
+
+int main() {
+  const int16_t W = 160, H = 128;
+  GFXcanvas16 expected(W, H), canvas(W, H);
+  MockTFT tft(W, H), rawTft(W, H);
+  rawTft.begin();
+  tft.begin();
+
+  // The packer agrees with the hand-coded bytes, and drawChar() reads them
+  PackedFont hand(&handRawFont, 2, 3);
+  check(hand.bitmap.size() == sizeof(handBitmap) &&
+            !memcmp(hand.bitmap.data(), handBitmap, sizeof(handBitmap)) &&
+            hand.glyphs[1].bitmapOffset == 3 && hand.font.runBits == 0x23,
+        "packing the hand-coded glyphs gives different bytes");
+  for (int c = '0'; c <= '1'; c++) {
+    expected.fillScreen(0);
+    canvas.fillScreen(0);
+    expected.setFont(&handRawFont);
+    expected.drawChar(2, 6, c, 0xFFFF, 0xFFFF, 1, 1);
+    canvas.setFontRLE(&handFont);
+    canvas.drawChar(2, 6, c, 0xFFFF, 0xFFFF, 1, 1);
+    check(!memcmp(expected.getBuffer(), canvas.getBuffer(), W * H * 2),
+          "a hand-coded glyph draws wrong");
+  }
+
+  const GFXfont *fonts[] = {&FreeMono9pt7b, &FreeSansBold24pt7b,
+                            &FreeSerifItalic18pt7b, &Picopixel};
+  const uint8_t widths[][2] = {{0, 0}, {1, 1}, {8, 8}, {2, 7}, {7, 2}};
+  for (const GFXfont *raw : fonts) {
+    for (const uint8_t *bw : widths) {
+      PackedFont packed(raw, bw[0], bw[1]);
+      for (int c = raw->first; c <= raw->last; c++) {
+        uint8_t sx = 1 + rnd(3), sy = rnd(2) ? sx : 1 + rnd(3);
+        int16_t x = rnd(W) - 20, y = rnd(H + 40) - 10;
+        uint16_t color = 1 + rnd(0xFFFF);
+
+        expected.fillScreen(0);
+        canvas.fillScreen(0);
+        tft.fillScreen(0);
+        rawTft.fillScreen(0);
+        rawTft.clearStats();
+        tft.clearStats();
+        expected.setFont(raw);
+        expected.drawChar(x, y, c, color, color, sx, sy);
+        canvas.setFontRLE(&packed.font);
+        canvas.drawChar(x, y, c, color, color, sx, sy);
+        tft.setFontRLE(&packed.font);
+        tft.drawChar(x, y, c, color, color, sx, sy);
+        rawTft.setFont(raw);
+        rawTft.drawChar(x, y, c, color, color, sx, sy);
+
+        bool canvasOk = true, tftOk = rawTft.windows == tft.windows &&
+                                      rawTft.busBytes == tft.busBytes;
+        for (int16_t py = 0; py < H; py++) {
+          for (int16_t px = 0; px < W; px++) {
+            uint16_t want = expected.getPixel(px, py);
+            if (canvas.getPixel(px, py) != want)
+              canvasOk = false;
+            if (tft.getPixel(px, py) != want)
+              tftOk = false;
+          }
+        }
+        if (!canvasOk || !tftOk) {
+          printf("%s differs: char %d, runBits 0x%02X, size %ux%u at "
+                 "(%d,%d)\n",
+                 canvasOk ? "MockTFT" : "GFXcanvas16", c, packed.font.runBits,
+                 sx, sy, x, y);
+          failures++;
+        }
+      }
+    }
+  }
+
+  if (failures)
+    printf("%d checks failed\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,423 @@
+/*!
+ * @file scanline_fill.cpp
+ *
+ * Checks fillPolygon(), fillArc(), the thick lines and their anti-aliased
+ * versions on random shapes against working out, pixel by pixel, whether
+ * each pixel (or each of its four samples) is inside. Polygons, convex,
+ * concave and crossing themselves, many on a coarse grid so that vertices
+ * land on rows and edges run flat, are checked exactly. Arcs and thick
+ * lines, whose outlines fall between whole pixels, are checked to a small
+ * tolerance. Plain fills may add one pixel for a span too thin to hold a
+ * pixel center, so those are allowed next to the outline. Also checks that
+ * MockTFT gets the same pixels in every rotation, one address window a
+ * span.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <math.h>
+
+#include "mock_tft.h"
+#include <stdio.h>
+
+static uint32_t seed = 2024;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int n, int16_t x, int16_t y) {
+  if (!ok) {
+    if (failures < 20)
+      printf("%s wrong at %d,%d, case %d\n", what, x, y, n);
+    failures++;
+  }
+}
+
+// The library's blend, done the long way round for reference
+static uint16_t mix(uint16_t bg, uint16_t fg, uint32_t a) {
+  uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+  uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+  b = (b + (((f - b) * a) >> 5)) & 0x07E0F81F;
+  return (uint16_t)(b | (b >> 16));
+}
+
+// POLYGONS, exactly, in 1/16 pixel units ----------------------------------
+
+static int16_t poly[2 * 12];
+static int n;
+
+// Where edge i crosses row y, against x: the sign of (crossing - x), or 2
+// if the edge doesn't reach the row. below/above: the half-open spans the
+// polygon just below and above the row sees.
+static int side(int i, int64_t x, int64_t y, bool below) {
+  int j = (i + 1 < n) ? i + 1 : 0;
+  int64_t x0 = poly[2 * i] * 16, y0 = poly[2 * i + 1] * 16,
+          x1 = poly[2 * j] * 16, y1 = poly[2 * j + 1] * 16;
+  if (y0 > y1) {
+    int64_t t = x0;
+    x0 = x1;
+    x1 = t;
+    t = y0;
+    y0 = y1;
+    y1 = t;
+  }
+  if ((y0 == y1) || (below ? ((y < y0) || (y >= y1)) : ((y <= y0) || (y > y1))))
+    return 2;
+  int64_t s = (x0 - x) * (y1 - y0) + (y - y0) * (x1 - x0);
+  return (s > 0) - (s < 0);
+}
+
+static int dir(int i) {
+  int j = (i + 1 < n) ? i + 1 : 0;
+  return (poly[2 * j + 1] > poly[2 * i + 1]) ? 1 : -1;
+}
+
+// Winding number at (x,y) counting crossings right of x (or at x, too)
+static int winding(int64_t x, int64_t y, bool below, bool atX) {
+  int w = 0;
+  for (int i = 0; i < n; i++) {
+    int s = side(i, x, y, below);
+    if ((s == 1) || (atX && (s == 0)))
+      w += dir(i);
+  }
+  return w;
+}
+
+// Plain fill: the pixel center is in the closed polygon, taken just above
+// or just below the row
+static bool polyIn(int16_t x, int16_t y) {
+  for (int b = 0; b < 2; b++)
+    if (winding(16 * x, 16 * y, b, false) || winding(16 * x, 16 * y, b, true))
+      return true;
+  return false;
+}
+
+// An outline crosses the row within a pixel of x
+static bool polyNear(int16_t x, int16_t y) {
+  for (int i = 0; i < n; i++)
+    for (int b = 0; b < 2; b++)
+      if ((side(i, 16 * x - 16, 16 * y, b) == 1) &&
+          (side(i, 16 * x + 16, 16 * y, b) == -1))
+        return true;
+  return false;
+}
+
+// Anti-aliased: samples at +/-4 units, in where the crossings at or left
+// of them wind round
+static int polyCover(int16_t x, int16_t y) {
+  int c = 0;
+  for (int sy = -4; sy <= 4; sy += 8)
+    for (int sx = -4; sx <= 4; sx += 8) {
+      int w = 0;
+      for (int i = 0; i < n; i++) {
+        int s = side(i, 16 * x + sx, 16 * y + sy, true);
+        if ((s == -1) || (s == 0))
+          w += dir(i);
+      }
+      c += (w != 0);
+    }
+  return c;
+}
+
+static void randomPolygon(int16_t W, int16_t H) {
+  n = 3 + rnd(10);
+  int grid = rnd(2) ? 8 : 1; // Coarse: flat edges and shared rows
+  for (int i = 0; i < n; i++) {
+    poly[2 * i] = (rnd(W + 40) - 20) / grid * grid;
+    poly[2 * i + 1] = (rnd(H + 40) - 20) / grid * grid;
+  }
+}
+
+// ARCS AND THICK LINES, to a tolerance ------------------------------------
+
+// How far inside the shape a point is, in pixels; negative if outside
+typedef double (*Depth)(double x, double y);
+
+static double acx, acy, ar0, ar1, astart, asweep;
+static bool afull;
+
+static double arcDepth(double x, double y) {
+  double dx = x - acx, dy = y - acy, d = sqrt(dx * dx + dy * dy);
+  double depth = fmin(d - ar0, ar1 - d);
+  if (afull)
+    return depth;
+  // Distance either side of the two rays, or to the center for points
+  // outside the sweep's half-planes
+  double a = atan2(dy, dx) * 180 / M_PI - astart;
+  a = fmod(fmod(a, 360) + 360, 360);
+  double toStart = a, toEnd = asweep - a;
+  if (a > asweep) // Outside: how far to the nearer ray
+    return -fmin(d, fmin(d * sin(fmin(a - asweep, 90) * M_PI / 180),
+                         d * sin(fmin(360 - a, 90) * M_PI / 180)));
+  double ray = d * sin(fmin(fmin(toStart, toEnd), 90) * M_PI / 180);
+  return fmin(depth, ray);
+}
+
+static double lx0, ly0, lx1, ly1, lw;
+
+static double lineDepth(double x, double y) {
+  double dx = lx1 - lx0, dy = ly1 - ly0, len = sqrt(dx * dx + dy * dy);
+  double along = ((x - lx0) * dx + (y - ly0) * dy) / len;
+  double across = fabs((x - lx0) * dy - (y - ly0) * dx) / len;
+  return fmin(fmin(along, len - along), lw / 2 - across);
+}
+
+// How far inside triangle a, b, c a point is, in pixels
+static double triangleDepth(const double *t, double x, double y) {
+  double area = (t[2] - t[0]) * (t[5] - t[1]) - (t[3] - t[1]) * (t[4] - t[0]);
+  double depth = 1e9;
+  for (int i = 0; i < 3; i++) {
+    int j = (i + 1) % 3;
+    double ex = t[2 * j] - t[2 * i], ey = t[2 * j + 1] - t[2 * i + 1];
+    double d = (ex * (y - t[2 * i + 1]) - ey * (x - t[2 * i])) /
+               sqrt(ex * ex + ey * ey);
+    depth = fmin(depth, (area > 0) ? d : -d);
+  }
+  return depth;
+}
+
+// Plain fill: pixels well inside are set, those well outside aren't unless
+// the shape is within a pixel along the row
+static void checkPlain(GFXcanvas16 &c, Depth depth, const char *what,
+                       int k) {
+  const double tol = 0.05;
+  for (int16_t y = 0; y < c.height(); y++) {
+    for (int16_t x = 0; x < c.width(); x++) {
+      double d = depth(x, y);
+      bool got = c.getPixel(x, y) != 0;
+      if (d > tol)
+        check(got, what, k, x, y);
+      else if (got && (d < -tol)) {
+        bool near = false;
+        for (int i = 1; i < 32 && !near; i++)
+          near = depth(x - 1 + i / 16.0, y) > -tol;
+        check(near, what, k, x, y);
+      }
+    }
+  }
+}
+
+// Anti-aliased: each pixel blended by some coverage between the samples
+// well inside and those not well outside
+static void checkAA(GFXcanvas16 &c, GFXcanvas16 &bg, uint16_t color,
+                    Depth depth, const char *what, int k) {
+  const double tol = 0.05;
+  for (int16_t y = 0; y < c.height(); y++) {
+    for (int16_t x = 0; x < c.width(); x++) {
+      int lo = 0, hi = 0;
+      for (int sy = -1; sy <= 1; sy += 2)
+        for (int sx = -1; sx <= 1; sx += 2) {
+          double d = depth(x + sx / 4.0, y + sy / 4.0);
+          lo += d > tol;
+          hi += d >= -tol;
+        }
+      uint16_t got = c.getPixel(x, y), under = bg.getPixel(x, y);
+      bool ok = false;
+      for (int cov = lo; cov <= hi && !ok; cov++)
+        ok = got == ((cov == 4) ? color : cov ? mix(under, color, cov * 8)
+                                              : under);
+      check(ok, what, k, x, y);
+    }
+  }
+}
+
+static void randomize(GFXcanvas16 &c) {
+  for (int16_t y = 0; y < c.height(); y++)
+    for (int16_t x = 0; x < c.width(); x++)
+      c.drawPixel(x, y, rnd(0x10000));
+}
+
+static void copy(GFXcanvas16 &to, const GFXcanvas16 &from) {
+  memcpy(to.getBuffer(), from.getBuffer(), from.width() * from.height() * 2);
+}
+
+// MockTFT reads back unrotated
+static uint16_t tftPixel(MockTFT &tft, int16_t x, int16_t y) {
+  switch (tft.getRotation()) {
+  case 1:
+    return tft.getPixel(tft.height() - 1 - y, x);
+  case 2:
+    return tft.getPixel(tft.width() - 1 - x, tft.height() - 1 - y);
+  case 3:
+    return tft.getPixel(y, tft.width() - 1 - x);
+  default:
+    return tft.getPixel(x, y);
+  }
+}
+
+int main() {
+  const int16_t W = 97, H = 73;
+  GFXcanvas16 c(W, H), bg(W, H);
+
+  for (int k = 0; k < 400; k++) { // Polygons, plain
+    randomPolygon(W, H);
+    c.fillScreen(0);
+    c.fillPolygon(poly, n, 0xFFFF);
+    for (int16_t y = 0; y < H; y++)
+      for (int16_t x = 0; x < W; x++) {
+        bool got = c.getPixel(x, y), want = polyIn(x, y);
+        check((got == want) || (got && polyNear(x, y)), "fillPolygon()", k,
+              x, y);
+      }
+  }
+
+  for (int k = 0; k < 400; k++) { // Polygons, anti-aliased
+    randomPolygon(W, H);
+    uint16_t color = rnd(0x10000);
+    randomize(bg);
+    copy(c, bg);
+    c.fillPolygonAA(poly, n, color);
+    for (int16_t y = 0; y < H; y++)
+      for (int16_t x = 0; x < W; x++) {
+        int cov = polyCover(x, y);
+        uint16_t under = bg.getPixel(x, y);
+        uint16_t want = (cov == 4) ? color
+                        : cov      ? mix(under, color, cov * 8)
+                                   : under;
+        check(c.getPixel(x, y) == want, "fillPolygonAA()", k, x, y);
+      }
+  }
+
+  for (int k = 0; k < 300; k++) { // Arcs, plain and anti-aliased
+    int16_t x0 = rnd(W + 20) - 10, y0 = rnd(H + 20) - 10, r1 = rnd(50);
+    int16_t r0 = rnd(3) ? rnd(r1 + 1) : 0, start = rnd(720) - 360;
+    int16_t end = start + (rnd(4) ? rnd(360) : 360);
+    acx = x0;
+    acy = y0;
+    ar0 = r0;
+    ar1 = r1;
+    astart = start;
+    asweep = end - start;
+    afull = asweep >= 360;
+    if (!afull && !asweep)
+      continue;
+    c.fillScreen(0);
+    c.fillArc(x0, y0, r0, r1, start, end, 0xFFFF);
+    checkPlain(c, arcDepth, "fillArc()", k);
+    uint16_t color = rnd(0x10000);
+    randomize(bg);
+    copy(c, bg);
+    c.fillArcAA(x0, y0, r0, r1, start, end, color);
+    checkAA(c, bg, color, arcDepth, "fillArcAA()", k);
+  }
+
+  for (int k = 0; k < 300; k++) { // Thick lines, plain and anti-aliased
+    int16_t x0 = rnd(W + 20) - 10, y0 = rnd(H + 20) - 10;
+    int16_t x1 = rnd(W + 20) - 10, y1 = rnd(H + 20) - 10;
+    uint8_t w = 2 + rnd(12);
+    if ((x0 == x1) && (y0 == y1))
+      continue;
+    lx0 = x0;
+    ly0 = y0;
+    lx1 = x1;
+    ly1 = y1;
+    lw = w;
+    c.fillScreen(0);
+    c.drawThickLine(x0, y0, x1, y1, w, 0xFFFF);
+    checkPlain(c, lineDepth, "drawThickLine()", k);
+    uint16_t color = rnd(0x10000);
+    randomize(bg);
+    copy(c, bg);
+    c.drawThickLineAA(x0, y0, x1, y1, w, color);
+    checkAA(c, bg, color, lineDepth, "drawThickLineAA()", k);
+  }
+
+  // Thick polylines: every segment is there in full, round joins fill a
+  // circle at each corner and the others at least the bevel, and nothing
+  // strays past the miter limit
+  for (int k = 0; k < 100; k++) {
+    int16_t pts[2 * 6];
+    int np = 2 + rnd(5);
+    for (int i = 0; i < 2 * np; i++)
+      pts[i] = 10 + rnd((i & 1) ? H - 20 : W - 20);
+    uint8_t w = 2 + rnd(10);
+    GFXjoin join = (GFXjoin)rnd(3);
+    double bevels[6][6]; // Outside corner triangles
+    int nb = 0;
+    for (int i = 1; (i < np - 1) && (join != GFX_JOIN_ROUND); i++) {
+      double vx = pts[2 * i], vy = pts[2 * i + 1];
+      double ax = vx - pts[2 * i - 2], ay = vy - pts[2 * i - 1];
+      double bx = pts[2 * i + 2] - vx, by = pts[2 * i + 3] - vy;
+      double la = hypot(ax, ay), lb = hypot(bx, by), cross = ax * by - ay * bx;
+      if (!la || !lb || !cross)
+        continue;
+      double s = ((cross > 0) ? -w : w) / 2.0;
+      double t[6] = {vx,
+                     vy,
+                     vx - ay / la * s,
+                     vy + ax / la * s,
+                     vx - by / lb * s,
+                     vy + bx / lb * s};
+      memcpy(bevels[nb++], t, sizeof(t));
+    }
+    c.fillScreen(0);
+    c.drawThickPolyline(pts, np, w, 0xFFFF, join);
+    for (int16_t y = 0; y < H; y++) {
+      for (int16_t x = 0; x < W; x++) {
+        double best = -1e9, nearest = 1e9;
+        lw = w;
+        for (int i = 1; i < np; i++) {
+          lx0 = pts[2 * i - 2];
+          ly0 = pts[2 * i - 1];
+          lx1 = pts[2 * i];
+          ly1 = pts[2 * i + 1];
+          if ((lx0 != lx1) || (ly0 != ly1))
+            best = fmax(best, lineDepth(x, y));
+        }
+        for (int i = 0; i < nb; i++)
+          best = fmax(best, triangleDepth(bevels[i], x, y));
+        for (int i = 1; i < np - 1; i++) {
+          double d = hypot(x - pts[2 * i], y - pts[2 * i + 1]);
+          nearest = fmin(nearest, d);
+          if (join == GFX_JOIN_ROUND)
+            best = fmax(best, w / 2.0 - d);
+        }
+        bool got = c.getPixel(x, y);
+        if (best > 0.05)
+          check(got, "drawThickPolyline()", k, x, y);
+        if (got && (best < -1.05))
+          check(nearest <= 2.0 * w + 1, "drawThickPolyline() corner", k, x,
+                y);
+      }
+    }
+  }
+
+  // On a display: the same pixels in every rotation, a window a span
+  MockTFT tft(W, H);
+  tft.begin();
+  for (int k = 0; k < 80; k++) {
+    tft.setRotation(k & 3);
+    GFXcanvas16 want(tft.width(), tft.height());
+    tft.fillScreen(0);
+    want.fillScreen(0);
+    int16_t x0 = rnd(tft.width()), y0 = rnd(tft.height());
+    int16_t hex[12];
+    for (int i = 0; i < 6; i++) { // Convex, so one span a row
+      hex[2 * i] = x0 + (int16_t)(30 * cos(i * M_PI / 3));
+      hex[2 * i + 1] = y0 + (int16_t)(30 * sin(i * M_PI / 3));
+    }
+    tft.clearStats();
+    tft.fillPolygon(hex, 6, 0x07E0);
+    int16_t rows = 0;
+    for (int16_t y = 0; y < tft.height(); y++)
+      rows += (y >= y0 - 25) && (y <= y0 + 25);
+    check(tft.windows == (uint32_t)rows, "fillPolygon() windows", k, x0, y0);
+    want.fillPolygon(hex, 6, 0x07E0);
+    tft.fillArc(x0, y0, 10, 20, k * 7, k * 7 + 200, 0xF800);
+    want.fillArc(x0, y0, 10, 20, k * 7, k * 7 + 200, 0xF800);
+    tft.drawThickLine(x0, y0, 3, 5, 5, 0x001F);
+    want.drawThickLine(x0, y0, 3, 5, 5, 0x001F);
+    for (int16_t y = 0; y < tft.height(); y++)
+      for (int16_t x = 0; x < tft.width(); x++)
+        check(tftPixel(tft, x, y) == want.getPixel(x, y), "MockTFT", k, x,
+              y);
+  }
+
+  if (failures)
+    printf("%d pixels wrong\n", failures);
+  return failures ? 1 : 0;
+}
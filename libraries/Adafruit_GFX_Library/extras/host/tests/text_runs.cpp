@@ -0,0 +1,74 @@
+/*!
+ * @file text_runs.cpp
+ *
+ * Draws random characters from the classic font and a few GFXfonts, at
+ * random sizes and positions (many of them clipped), transparent and on a
+ * background, and checks that drawChar() gives exactly what it did when it
+ * went a pixel at a time. Both on a GFXcanvas16, which uses the generic
+ * Adafruit_GFX text path, and on MockTFT, which uses Adafruit_SPITFT's.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "legacy_text.h"
+#include "mock_tft.h"
+#include <Fonts/FreeMono9pt7b.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSerifBoldItalic12pt7b.h>
+#include <Fonts/Picopixel.h>
+
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+int main() {
+  const int16_t W = 160, H = 128;
+  const GFXfont *fonts[] = {NULL, &FreeMono9pt7b, &FreeSans9pt7b,
+                            &FreeSerifBoldItalic12pt7b, &Picopixel};
+  GFXcanvas16 expected(W, H), canvas(W, H);
+  MockTFT tft(W, H);
+  tft.begin();
+  int failures = 0;
+
+  for (int n = 0; n < 3000; n++) {
+    int fi = rnd(5);
+    const GFXfont *f = fonts[fi];
+    unsigned char c = f ? f->first + rnd(f->last - f->first + 1) : rnd(256);
+    uint8_t sx = 1 + rnd(3), sy = rnd(2) ? sx : 1 + rnd(3);
+    int16_t x = rnd(W + 40) - 30, y = rnd(H + 60) - (f ? 10 : 30);
+    uint16_t color = rnd(0x10000), bg = rnd(2) ? color : rnd(0x10000);
+
+    expected.fillScreen(0);
+    canvas.fillScreen(0);
+    tft.fillScreen(0);
+    legacyDrawChar(expected, f, x, y, c, color, bg, sx, sy);
+    canvas.setFont(f);
+    canvas.drawChar(x, y, c, color, bg, sx, sy);
+    tft.setFont(f);
+    tft.drawChar(x, y, c, color, bg, sx, sy);
+
+    bool canvasOk = true, tftOk = true;
+    for (int16_t py = 0; py < H; py++) {
+      for (int16_t px = 0; px < W; px++) {
+        uint16_t want = expected.getPixel(px, py);
+        if (canvas.getPixel(px, py) != want)
+          canvasOk = false;
+        if (tft.getPixel(px, py) != want)
+          tftOk = false;
+      }
+    }
+    if (!canvasOk || !tftOk) {
+      printf("%s differs: char %u, font %d, size %ux%u at (%d,%d), %s\n",
+             canvasOk ? "MockTFT" : "GFXcanvas16", c, fi, sx, sy, x, y,
+             (bg == color) ? "transparent" : "opaque");
+      failures++;
+    }
+  }
+
+  if (failures)
+    printf("%d characters differ\n", failures);
+  return failures ? 1 : 0;
+}
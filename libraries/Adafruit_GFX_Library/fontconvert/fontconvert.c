@@ -8,6 +8,13 @@ fonts to be used with the Adafruit_GFX Arduino library.
 For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
   ./fontconvert ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7b.h
 
+With -r first, glyph bitmaps are run-length coded (format described in
+gfxfont.h) and the font is written as a GFXfontRLE for setFontRLE().
+Measured on the bundled Free* fonts, bitmaps shrink by about 42% at 24
+point (34-52%), 29% at 18 point (21-40%) and 8% at 12 point; 9 point fonts
+barely gain.  If coding wouldn't save anything, raw bitmaps are written as
+a plain GFXfont anyway and a note goes to stderr.
+
 REQUIRES FREETYPE LIBRARY.  www.freetype.org
 
 Currently this only extracts the printable 7-bit ASCII chars of a font.
@@ -50,6 +57,68 @@ void enbit(uint8_t value) {
   }
 }
 
+// Write (or with emit 0, just measure) one glyph's pixels as run-length
+// coded pairs: b0 bits of clear count, b1 bits of set count, then a 1 bit
+// per repeat of the pair and a 0.  Returns the length in whole bytes, and
+// when emitting, pads the glyph out to that with zeros.
+int packGlyph(const uint8_t *pixels, int n, int b0, int b1, int emit) {
+  int m0 = (1 << b0) - 1, m1 = (1 << b1) - 1, i = 0, count = 0, tail = 0, k;
+  int pz = -1, po = -1; // Last pair written, for repeats
+  while (i < n) {
+    int z = 0, o = 0, done = 0;
+    while ((i < n) && !pixels[i]) {
+      z++;
+      i++;
+    }
+    while ((i < n) && pixels[i]) {
+      o++;
+      i++;
+    }
+    if (!o) { // Only clear pixels left, end with a 0 and a pair of zeros
+      tail = (pz >= 0) + b0 + b1;
+      break;
+    }
+    while (!done) {
+      int pairZ = z, pairO = o;
+      if (z > m0) { // Too many clear pixels for one pair, skip some
+        pairZ = m0;
+        pairO = 0;
+      } else if (o > m1) {
+        pairO = m1;
+      } else {
+        done = 1;
+      }
+      z -= pairZ;
+      o -= pairO;
+      if ((pairZ == pz) && (pairO == po)) {
+        count++;
+        if (emit)
+          enbit(1);
+        continue;
+      }
+      if (pz >= 0) { // End the previous pair's repeats
+        count++;
+        if (emit)
+          enbit(0);
+      }
+      count += b0 + b1;
+      if (emit) {
+        for (k = b0 - 1; k >= 0; k--)
+          enbit((pairZ >> k) & 1);
+        for (k = b1 - 1; k >= 0; k--)
+          enbit((pairO >> k) & 1);
+      }
+      pz = pairZ;
+      po = pairO;
+    }
+  }
+  k = (count + tail + 7) / 8;
+  if (emit) // The rest, including any tail, is zeros
+    for (count = k * 8 - count; count > 0; count--)
+      enbit(0);
+  return k;
+}
+
 int main(int argc, char *argv[]) {
   int i, j, err, size, first = ' ', last = '~', bitmapOffset = 0, x, y, byte;
   char *fontName, c, *ptr;
@@ -59,17 +128,25 @@ int main(int argc, char *argv[]) {
   FT_Bitmap *bitmap;
   FT_BitmapGlyphRec *g;
   GFXglyph *table;
-  uint8_t bit;
+  uint8_t bit, **pixels, runBits = 0, pack = 0;
 
   // Parse command line.  Valid syntaxes are:
   //   fontconvert [filename] [size]
   //   fontconvert [filename] [size] [last char]
   //   fontconvert [filename] [size] [first char] [last char]
   // Unless overridden, default first and last chars are
-  // ' ' (space) and '~', respectively
+  // ' ' (space) and '~', respectively.  Any of these can start
+  // with -r to run-length code the glyph bitmaps.
+
+  if ((argc > 1) && !strcmp(argv[1], "-r")) {
+    pack = 1;
+    argv[1] = argv[0];
+    argv++;
+    argc--;
+  }
 
   if (argc < 3) {
-    fprintf(stderr, "Usage: %s fontfile size [first] [last]\n", argv[0]);
+    fprintf(stderr, "Usage: %s [-r] fontfile size [first] [last]\n", argv[0]);
     return 1;
   }
 
@@ -96,7 +173,8 @@ int main(int argc, char *argv[]) {
 
   // Allocate space for font name and glyph table
   if ((!(fontName = malloc(strlen(ptr) + 20))) ||
-      (!(table = (GFXglyph *)malloc((last - first + 1) * sizeof(GFXglyph))))) {
+      (!(table = (GFXglyph *)malloc((last - first + 1) * sizeof(GFXglyph)))) ||
+      (!(pixels = malloc((last - first + 1) * sizeof(uint8_t *))))) {
     fprintf(stderr, "Malloc error\n");
     return 1;
   }
@@ -145,10 +223,10 @@ int main(int argc, char *argv[]) {
   // the right symbols, and that's not done yet.
   // fprintf(stderr, "%ld glyphs\n", face->num_glyphs);
 
-  printf("const uint8_t %sBitmaps[] PROGMEM = {\n  ", fontName);
-
-  // Process glyphs and output huge bitmap data array
+  // Process glyphs, keeping each one's pixels (a byte apiece) until
+  // it's known how they'll be written out
   for (i = first, j = 0; i <= last; i++, j++) {
+    pixels[j] = NULL;
     // MONO renderer provides clean image with perfect crop
     // (no wasted pixels) via bitmap struct.
     if ((err = FT_Load_Char(face, i, FT_LOAD_TARGET_MONO))) {
@@ -177,31 +255,74 @@ int main(int argc, char *argv[]) {
     // code currently doesn't check for overflow.  (Doesn't
     // check that size & offsets are within bounds either for
     // that matter...please convert fonts responsibly.)
-    table[j].bitmapOffset = bitmapOffset;
     table[j].width = bitmap->width;
     table[j].height = bitmap->rows;
     table[j].xAdvance = face->glyph->advance.x >> 6;
     table[j].xOffset = g->left;
     table[j].yOffset = 1 - g->top;
 
+    if (!(pixels[j] = malloc(bitmap->width * bitmap->rows + 1))) {
+      fprintf(stderr, "Malloc error\n");
+      return 1;
+    }
     for (y = 0; y < bitmap->rows; y++) {
       for (x = 0; x < bitmap->width; x++) {
         byte = x / 8;
         bit = 0x80 >> (x & 7);
-        enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+        pixels[j][y * bitmap->width + x] =
+            (bitmap->buffer[y * bitmap->pitch + byte] & bit) != 0;
       }
     }
 
-    // Pad end of char bitmap to next byte boundary if needed
-    int n = (bitmap->width * bitmap->rows) & 7;
-    if (n) {     // Pixel count not an even multiple of 8?
-      n = 8 - n; // # bits to next multiple
-      while (n--)
-        enbit(0);
+    FT_Done_Glyph(glyph);
+  }
+
+  // Raw size, then with -r, the run widths that make the smallest font
+  for (i = first, j = 0; i <= last; i++, j++) {
+    if (pixels[j])
+      bitmapOffset += (table[j].width * table[j].height + 7) / 8;
+  }
+  if (pack) {
+    int best = bitmapOffset, b0, b1;
+    for (b0 = 1; b0 <= 8; b0++) {
+      for (b1 = 1; b1 <= 8; b1++) {
+        int bytes = 0;
+        for (i = first, j = 0; i <= last; i++, j++) {
+          if (pixels[j])
+            bytes += packGlyph(pixels[j], table[j].width * table[j].height,
+                               b0, b1, 0);
+        }
+        if (bytes < best) {
+          best = bytes;
+          runBits = (b0 << 4) | b1;
+        }
+      }
     }
-    bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
+    if (!runBits)
+      fprintf(stderr, "Run-length coding doesn't make this font any "
+                      "smaller, writing raw bitmaps\n");
+  }
 
-    FT_Done_Glyph(glyph);
+  printf("const uint8_t %sBitmaps[] PROGMEM = {\n  ", fontName);
+
+  // Output huge bitmap data array
+  bitmapOffset = 0;
+  for (i = first, j = 0; i <= last; i++, j++) {
+    if (!pixels[j])
+      continue;
+    int n = table[j].width * table[j].height;
+    table[j].bitmapOffset = bitmapOffset;
+    if (runBits) {
+      bitmapOffset += packGlyph(pixels[j], n, runBits >> 4, runBits & 15, 1);
+    } else {
+      for (x = 0; x < n; x++)
+        enbit(pixels[j][x]);
+      // Pad end of char bitmap to next byte boundary if needed
+      for (x = n; x & 7; x++)
+        enbit(0);
+      bitmapOffset += (n + 7) / 8;
+    }
+    free(pixels[j]);
   }
 
   printf(" };\n\n"); // End bitmap array
@@ -226,17 +347,23 @@ int main(int argc, char *argv[]) {
   printf("\n\n");
 
   // Output font structure
-  printf("const GFXfont %s PROGMEM = {\n", fontName);
+  if (runBits) // Raw fonts are plain GFXfonts, as they always have been
+    printf("const GFXfontRLE %s PROGMEM = {{\n", fontName);
+  else
+    printf("const GFXfont %s PROGMEM = {\n", fontName);
   printf("  (uint8_t  *)%sBitmaps,\n", fontName);
   printf("  (GFXglyph *)%sGlyphs,\n", fontName);
   if (face->size->metrics.height == 0) {
     // No face height info, assume fixed width and get from a glyph.
-    printf("  0x%02X, 0x%02X, %d };\n\n", first, last, table[0].height);
+    printf("  0x%02X, 0x%02X, %d", first, last, table[0].height);
   } else {
-    printf("  0x%02X, 0x%02X, %ld };\n\n", first, last,
+    printf("  0x%02X, 0x%02X, %ld", first, last,
            face->size->metrics.height >> 6);
   }
-  printf("// Approx. %d bytes\n", bitmapOffset + (last - first + 1) * 7 + 7);
+  if (runBits)
+    printf(" }, 0x%02X", runBits);
+  printf(" };\n\n");
+  printf("// Approx. %d bytes\n", bitmapOffset + (last - first + 1) * 7 + 8);
   // Size estimate is based on AVR struct and pointer sizes;
   // actual size may vary.
 
@@ -3,6 +3,17 @@
 // To use a font in your Arduino sketch, #include the corresponding .h
 // file and pass address of GFXfont struct to setFont().  Pass NULL to
 // revert to 'classic' fixed-space bitmap font.
+//
+// Glyph bitmaps are raw, one bit per pixel in a continuous stream with no
+// padding between rows. A GFXfontRLE (made by fontconvert -r, and passed to
+// setFontRLE() instead of setFont()) wraps a GFXfont whose glyph bitmaps are
+// run-length coded instead. A coded glyph is a stream of pairs,
+// MSB first: a count of clear pixels (runBits >> 4 bits wide), then a count
+// of set pixels (runBits & 15 bits wide), each pair followed by a 1 bit for
+// every time it repeats and then a 0 bit. Runs carry on from one row to the
+// next. A glyph ends when all width * height pixels are accounted for, or
+// at a pair of zero counts, after which the rest of the glyph is clear.
+// Either way each glyph starts on a whole byte at its bitmapOffset.
 
 #ifndef _GFXFONT_H_
 #define _GFXFONT_H_
@@ -26,4 +37,10 @@ typedef struct {
   uint8_t yAdvance; ///< Newline distance (y axis)
 } GFXfont;
 
+/// A font with run-length coded glyph bitmaps
+typedef struct {
+  GFXfont font;    ///< Glyphs and metrics, with coded bitmaps
+  uint8_t runBits; ///< Bits per clear run (high nibble) and set run (low)
+} GFXfontRLE;
+
 #endif // _GFXFONT_H_
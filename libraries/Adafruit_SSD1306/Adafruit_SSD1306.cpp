@@ -67,6 +67,8 @@
 #define WIRE_MAX 32 ///< Use common Arduino core default
 #endif
 
+#define SSD1306_WINDOW_COST 10 ///< Approx. bus bytes to start a new window
+
 #define ssd1306_swap(a, b)                                                     \
   (((a) ^= (b)), ((b) ^= (a)), ((a) ^= (b))) ///< No-temp-var swap operation
 
@@ -172,7 +174,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi,
                                    int8_t rst_pin, uint32_t clkDuring,
                                    uint32_t clkAfter)
     : Adafruit_GFX(w, h), spi(NULL), wire(twi ? twi : &Wire), buffer(NULL),
-      mosiPin(-1), clkPin(-1), dcPin(-1), csPin(-1), rstPin(rst_pin)
+      bufferShared(false), mosiPin(-1), clkPin(-1), dcPin(-1), csPin(-1),
+      rstPin(rst_pin)
 #if ARDUINO >= 157
       ,
       wireClk(clkDuring), restoreClk(clkAfter)
@@ -211,8 +214,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, int8_t mosi_pin,
                                    int8_t sclk_pin, int8_t dc_pin,
                                    int8_t rst_pin, int8_t cs_pin)
     : Adafruit_GFX(w, h), spi(NULL), wire(NULL), buffer(NULL),
-      mosiPin(mosi_pin), clkPin(sclk_pin), dcPin(dc_pin), csPin(cs_pin),
-      rstPin(rst_pin) {}
+      bufferShared(false), mosiPin(mosi_pin), clkPin(sclk_pin), dcPin(dc_pin),
+      csPin(cs_pin), rstPin(rst_pin) {}
 
 /*!
     @brief  Constructor for SPI SSD1306 displays, using native hardware SPI.
@@ -244,7 +247,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, SPIClass *spi,
                                    int8_t dc_pin, int8_t rst_pin, int8_t cs_pin,
                                    uint32_t bitrate)
     : Adafruit_GFX(w, h), spi(spi ? spi : &SPI), wire(NULL), buffer(NULL),
-      mosiPin(-1), clkPin(-1), dcPin(dc_pin), csPin(cs_pin), rstPin(rst_pin) {
+      bufferShared(false), mosiPin(-1), clkPin(-1), dcPin(dc_pin),
+      csPin(cs_pin), rstPin(rst_pin) {
 #ifdef SPI_HAS_TRANSACTION
   spiSettings = SPISettings(bitrate, MSBFIRST, SPI_MODE0);
 #endif
@@ -279,8 +283,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, SPIClass *spi,
 Adafruit_SSD1306::Adafruit_SSD1306(int8_t mosi_pin, int8_t sclk_pin,
                                    int8_t dc_pin, int8_t rst_pin, int8_t cs_pin)
     : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), spi(NULL), wire(NULL),
-      buffer(NULL), mosiPin(mosi_pin), clkPin(sclk_pin), dcPin(dc_pin),
-      csPin(cs_pin), rstPin(rst_pin) {}
+      buffer(NULL), bufferShared(false), mosiPin(mosi_pin), clkPin(sclk_pin),
+      dcPin(dc_pin), csPin(cs_pin), rstPin(rst_pin) {}
 
 /*!
     @brief  DEPRECATED constructor for SPI SSD1306 displays, using native
@@ -305,8 +309,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(int8_t mosi_pin, int8_t sclk_pin,
 */
 Adafruit_SSD1306::Adafruit_SSD1306(int8_t dc_pin, int8_t rst_pin, int8_t cs_pin)
     : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), spi(&SPI), wire(NULL),
-      buffer(NULL), mosiPin(-1), clkPin(-1), dcPin(dc_pin), csPin(cs_pin),
-      rstPin(rst_pin) {
+      buffer(NULL), bufferShared(false), mosiPin(-1), clkPin(-1),
+      dcPin(dc_pin), csPin(cs_pin), rstPin(rst_pin) {
 #ifdef SPI_HAS_TRANSACTION
   spiSettings = SPISettings(8000000, MSBFIRST, SPI_MODE0);
 #endif
@@ -328,8 +332,8 @@ Adafruit_SSD1306::Adafruit_SSD1306(int8_t dc_pin, int8_t rst_pin, int8_t cs_pin)
 */
 Adafruit_SSD1306::Adafruit_SSD1306(int8_t rst_pin)
     : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), spi(NULL), wire(&Wire),
-      buffer(NULL), mosiPin(-1), clkPin(-1), dcPin(-1), csPin(-1),
-      rstPin(rst_pin) {}
+      buffer(NULL), bufferShared(false), mosiPin(-1), clkPin(-1), dcPin(-1),
+      csPin(-1), rstPin(rst_pin) {}
 
 /*!
     @brief  Destructor for Adafruit_SSD1306 object.
@@ -463,8 +467,14 @@ void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
 bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset,
                              bool periphBegin) {
 
-  if ((!buffer) && !(buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8))))
+  // The per-page dirty column ranges go in the same allocation, just past
+  // the image itself, so getBuffer() still points at the image alone.
+  uint8_t pages = (HEIGHT + 7) / 8;
+  if ((!buffer) &&
+      !(buffer = (uint8_t *)malloc(WIDTH * pages + 2 * pages)))
     return false;
+  dirtyStart = &buffer[WIDTH * pages];
+  dirtyEnd = &dirtyStart[pages];
 
   clearDisplay();
   if (HEIGHT > 32) {
@@ -622,6 +632,7 @@ void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
       y = HEIGHT - y - 1;
       break;
     }
+    markDirty(y / 8, x, x);
     switch (color) {
     case SSD1306_WHITE:
       buffer[x + (y / 8) * WIDTH] |= (1 << (y & 7));
@@ -645,6 +656,14 @@ void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 void Adafruit_SSD1306::clearDisplay(void) {
   memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+  markAllDirty();
+}
+
+// Mark the whole screen as changed, so the next display() sends all of it.
+void Adafruit_SSD1306::markAllDirty(void) {
+  uint8_t pages = (HEIGHT + 7) / 8;
+  memset(dirtyStart, 0, pages);
+  memset(dirtyEnd, WIDTH - 1, pages);
 }
 
 /*!
@@ -707,6 +726,7 @@ void Adafruit_SSD1306::drawFastHLineInternal(int16_t x, int16_t y, int16_t w,
       w = (WIDTH - x);
     }
     if (w > 0) { // Proceed only if width is positive
+      markDirty(y / 8, x, x + w - 1);
       uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x], mask = 1 << (y & 7);
       switch (color) {
       case SSD1306_WHITE:
@@ -794,6 +814,8 @@ void Adafruit_SSD1306::drawFastVLineInternal(int16_t x, int16_t __y,
       // use local byte registers for faster juggling
       uint8_t y = __y, h = __h;
       uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x];
+      for (uint8_t page = y / 8; page <= (y + h - 1) / 8; page++)
+        markDirty(page, x, x);
 
       // do the first partial byte, if necessary - this requires some masking
       uint8_t mod = (y & 7);
@@ -911,28 +933,81 @@ bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
     @brief  Get base address of display buffer for direct reading or writing.
     @return Pointer to an unsigned 8-bit array, column-major, columns padded
             to full byte boundary if needed.
+    @note   The library can't see changes made through this pointer, so
+            once it has been called, display() goes back to sending the
+            whole screen every time. displayRegion() still sends just the
+            area asked for.
 */
-uint8_t *Adafruit_SSD1306::getBuffer(void) { return buffer; }
+uint8_t *Adafruit_SSD1306::getBuffer(void) {
+  bufferShared = true;
+  return buffer;
+}
 
 // REFRESH DISPLAY ---------------------------------------------------------
 
+// Send the part of the buffer from page0 to page1 and col0 to col1
+// (inclusive, unrotated) to the same window on the SSD1306. Horizontal
+// addressing mode wraps each page's row of columns on to the next page.
+// Transaction must be started/ended in calling function.
+void Adafruit_SSD1306::sendWindow(uint8_t page0, uint8_t page1, uint8_t col0,
+                                  uint8_t col1) {
+  uint8_t window[] = {SSD1306_PAGEADDR, page0, page1,
+                      SSD1306_COLUMNADDR, col0, col1};
+  if (wire) { // I2C
+    wire->beginTransmission(i2caddr);
+    WIRE_WRITE((uint8_t)0x00); // Co = 0, D/C = 0
+    for (uint8_t i = 0; i < sizeof(window); i++)
+      WIRE_WRITE(window[i]);
+    wire->endTransmission();
+
+    wire->beginTransmission(i2caddr);
+    WIRE_WRITE((uint8_t)0x40);
+    uint16_t bytesOut = 1;
+    for (uint8_t page = page0; page <= page1; page++) {
+      uint8_t *ptr = &buffer[page * WIDTH + col0];
+      for (uint8_t count = col1 - col0 + 1; count; count--) {
+        if (bytesOut >= WIRE_MAX) {
+          wire->endTransmission();
+          wire->beginTransmission(i2caddr);
+          WIRE_WRITE((uint8_t)0x40);
+          bytesOut = 1;
+        }
+        WIRE_WRITE(*ptr++);
+        bytesOut++;
+      }
+    }
+    wire->endTransmission();
+  } else { // SPI
+    SSD1306_MODE_COMMAND
+    for (uint8_t i = 0; i < sizeof(window); i++)
+      SPIwrite(window[i]);
+    SSD1306_MODE_DATA
+    for (uint8_t page = page0; page <= page1; page++) {
+      uint8_t *ptr = &buffer[page * WIDTH + col0];
+      for (uint8_t count = col1 - col0 + 1; count; count--)
+        SPIwrite(*ptr++);
+    }
+  }
+}
+
 /*!
     @brief  Push data currently in RAM to SSD1306 display.
     @return None (void).
     @note   Drawing operations are not visible until this function is
             called. Call after each graphics command, or after a whole set
             of graphics commands, as best needed by one's own application.
+            Only the columns of each 8-row page that have been drawn to
+            since the last call are sent, so updating a small part of the
+            screen is much quicker than redrawing all of it. Neighbouring
+            pages are sent together when that takes fewer bytes than
+            setting up a window for each.
 */
 void Adafruit_SSD1306::display(void) {
-  TRANSACTION_START
-  static const uint8_t PROGMEM dlist1[] = {
-      SSD1306_PAGEADDR,
-      0,                      // Page start address
-      0xFF,                   // Page end (not really, but works here)
-      SSD1306_COLUMNADDR, 0}; // Column start address
-  ssd1306_commandList(dlist1, sizeof(dlist1));
-  ssd1306_command1(WIDTH - 1); // Column end address
+  uint8_t pages = (HEIGHT + 7) / 8;
+  if (bufferShared)
+    markAllDirty();
 
+  TRANSACTION_START
 #if defined(ESP8266)
   // ESP8266 needs a periodic yield() call to avoid watchdog reset.
   // With the limited size of SSD1306 displays, and the fast bitrate
@@ -942,27 +1017,35 @@ void Adafruit_SSD1306::display(void) {
   // 32-byte transfer condition below.
   yield();
 #endif
-  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
-  uint8_t *ptr = buffer;
-  if (wire) { // I2C
-    wire->beginTransmission(i2caddr);
-    WIRE_WRITE((uint8_t)0x40);
-    uint16_t bytesOut = 1;
-    while (count--) {
-      if (bytesOut >= WIRE_MAX) {
-        wire->endTransmission();
-        wire->beginTransmission(i2caddr);
-        WIRE_WRITE((uint8_t)0x40);
-        bytesOut = 1;
-      }
-      WIRE_WRITE(*ptr++);
-      bytesOut++;
+  for (uint8_t page = 0; page < pages;) {
+    if (dirtyStart[page] > dirtyEnd[page]) { // Nothing changed here
+      page++;
+      continue;
+    }
+    uint8_t last = page, col0 = dirtyStart[page], col1 = dirtyEnd[page];
+    // Bytes it takes to send what's been gathered so far, counting a window
+    // setup (the PAGEADDR/COLUMNADDR commands and the start of the data)
+    // as SSD1306_WINDOW_COST bytes
+    uint16_t cost = col1 - col0 + 1 + SSD1306_WINDOW_COST;
+    while ((last + 1 < pages) &&
+           (dirtyStart[last + 1] <= dirtyEnd[last + 1])) {
+      uint8_t start = dirtyStart[last + 1], end = dirtyEnd[last + 1];
+      uint8_t next0 = (start < col0) ? start : col0,
+              next1 = (end > col1) ? end : col1;
+      uint16_t merged = (uint16_t)(next1 - next0 + 1) * (last + 2 - page) +
+                        SSD1306_WINDOW_COST;
+      if (merged > cost + (end - start + 1) + SSD1306_WINDOW_COST)
+        break; // Cheaper to give the next page its own window
+      col0 = next0;
+      col1 = next1;
+      cost = merged;
+      last++;
+    }
+    sendWindow(page, last, col0, col1);
+    for (; page <= last; page++) {
+      dirtyStart[page] = 0xFF;
+      dirtyEnd[page] = 0;
     }
-    wire->endTransmission();
-  } else { // SPI
-    SSD1306_MODE_DATA
-    while (count--)
-      SPIwrite(*ptr++);
   }
   TRANSACTION_END
 #if defined(ESP8266)
@@ -970,6 +1053,81 @@ void Adafruit_SSD1306::display(void) {
 #endif
 }
 
+/*!
+    @brief  Push one rectangle of the image in RAM to the SSD1306 display,
+            whether or not it has been drawn to.
+    @param  x
+            Leftmost column -- 0 at left to (screen width - 1) at right.
+    @param  y
+            Topmost row -- 0 at top to (screen height - 1) at bottom.
+    @param  w
+            Width of rectangle, in pixels.
+    @param  h
+            Height of rectangle, in pixels.
+    @return None (void).
+    @note   Coordinates follow the current rotation, like drawing. The
+            SSD1306 is written 8 rows at a time, so the rows above and
+            below the rectangle up to the next multiple of 8 are sent too.
+            Use this for something that has to appear now, such as a
+            readout, without waiting to send the rest of the screen.
+*/
+void Adafruit_SSD1306::displayRegion(int16_t x, int16_t y, int16_t w,
+                                     int16_t h) {
+  if (x < 0) { // Clip to screen
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if ((x + w) > width())
+    w = width() - x;
+  if ((y + h) > height())
+    h = height() - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  // Rotate opposite corners to find the same rectangle in RAM
+  int16_t x1 = x + w - 1, y1 = y + h - 1;
+  switch (getRotation()) {
+  case 1:
+    ssd1306_swap(x, y);
+    ssd1306_swap(x1, y1);
+    x = WIDTH - x - 1;
+    x1 = WIDTH - x1 - 1;
+    break;
+  case 2:
+    x = WIDTH - x - 1;
+    y = HEIGHT - y - 1;
+    x1 = WIDTH - x1 - 1;
+    y1 = HEIGHT - y1 - 1;
+    break;
+  case 3:
+    ssd1306_swap(x, y);
+    ssd1306_swap(x1, y1);
+    y = HEIGHT - y - 1;
+    y1 = HEIGHT - y1 - 1;
+    break;
+  }
+  if (x > x1)
+    ssd1306_swap(x, x1);
+  if (y > y1)
+    ssd1306_swap(y, y1);
+
+  uint8_t page0 = y / 8, page1 = y1 / 8;
+  TRANSACTION_START
+  sendWindow(page0, page1, x, x1);
+  TRANSACTION_END
+  // Pages whose changes were all inside the rectangle are up to date now
+  for (uint8_t page = page0; page <= page1; page++) {
+    if ((dirtyStart[page] >= x) && (dirtyEnd[page] <= x1)) {
+      dirtyStart[page] = 0xFF;
+      dirtyEnd[page] = 0;
+    }
+  }
+}
+
 // SCROLLING FUNCTIONS -----------------------------------------------------
 
 /*!
@@ -1073,11 +1231,16 @@ void Adafruit_SSD1306::startscrolldiagleft(uint8_t start, uint8_t stop) {
 /*!
     @brief  Cease a previously-begun scrolling action.
     @return None (void).
+    @note   The next display() sends the whole screen, to put back the
+            image scrolling moved.
 */
 void Adafruit_SSD1306::stopscroll(void) {
   TRANSACTION_START
   ssd1306_command1(SSD1306_DEACTIVATE_SCROLL);
   TRANSACTION_END
+  // Scrolling moved the image in the SSD1306's RAM, so the next display()
+  // has to rewrite all of it
+  markAllDirty();
 }
 
 // OTHER HARDWARE SETTINGS -------------------------------------------------
@@ -145,6 +145,7 @@ public:
   bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0,
              bool reset = true, bool periphBegin = true);
   void display(void);
+  void displayRegion(int16_t x, int16_t y, int16_t w, int16_t h);
   void clearDisplay(void);
   void invertDisplay(bool i);
   void dim(bool dim);
@@ -166,10 +167,21 @@ private:
   void drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color);
   void ssd1306_command1(uint8_t c);
   void ssd1306_commandList(const uint8_t *c, uint8_t n);
+  void sendWindow(uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1);
+  void markDirty(uint8_t page, uint8_t col0, uint8_t col1) {
+    if (col0 < dirtyStart[page])
+      dirtyStart[page] = col0;
+    if (col1 > dirtyEnd[page])
+      dirtyEnd[page] = col1;
+  }
+  void markAllDirty(void);
 
   SPIClass *spi;
   TwoWire *wire;
   uint8_t *buffer;
+  uint8_t *dirtyStart; // First changed column in each page, 0xFF if none
+  uint8_t *dirtyEnd;   // Last changed column in each page
+  bool bufferShared;   // getBuffer() was called, changes can't be tracked
   int8_t i2caddr, vccstate, page_end;
   int8_t mosiPin, clkPin, dcPin, csPin, rstPin;
 #ifdef HAVE_PORTREG
@@ -0,0 +1,77 @@
+/*!
+ * @file ssd1306_bench.cpp
+ *
+ * Bus traffic per display() for a few typical screen updates, counted by the
+ * recording Wire and SPI stand-ins, and what that comes to in time and frame
+ * rate at 400 kHz I2C and 8 MHz SPI. "whole screen" is what every display()
+ * cost before only changed regions were sent, and still costs after
+ * getBuffer().
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "ssd1306_mock.h"
+#include <Adafruit_SSD1306.h>
+
+typedef void (*Update)(Adafruit_SSD1306 &d, int frame);
+
+static void readout(Adafruit_SSD1306 &d, int frame) {
+  // One number, updated in place
+  d.fillRect(80, 24, 48, 16, SSD1306_BLACK);
+  d.setTextSize(2);
+  d.setTextColor(SSD1306_WHITE);
+  d.setCursor(80, 24);
+  d.print(1000 + frame);
+}
+
+static void bar(Adafruit_SSD1306 &d, int frame) {
+  // A bar graph along the bottom
+  int16_t w = (frame * 7) % 128;
+  d.fillRect(0, 56, w, 8, SSD1306_WHITE);
+  d.fillRect(w, 56, 128 - w, 8, SSD1306_BLACK);
+}
+
+static void cursor(Adafruit_SSD1306 &d, int frame) {
+  // A blinking text cursor
+  d.fillRect(60, 40, 6, 8, (frame & 1) ? SSD1306_WHITE : SSD1306_BLACK);
+}
+
+static void fullRedraw(Adafruit_SSD1306 &d, int frame) {
+  // Everything changes
+  d.clearDisplay();
+  d.drawCircle(64, 32, 10 + frame % 20, SSD1306_WHITE);
+}
+
+static void bench(const char *name, bool i2c, Update update) {
+  const int frames = 100;
+  Adafruit_SSD1306 *d;
+  if (i2c)
+    d = new Adafruit_SSD1306(128, 64, &Wire, -1);
+  else
+    d = new Adafruit_SSD1306(128, 64, &SPI, 9, -1, 10);
+  mockPanel.reset();
+  mockPanel.dcPin = 9;
+  d->begin(SSD1306_SWITCHCAPVCC, 0x3D);
+  d->display();
+  mockPanel.clearStats();
+  for (int frame = 0; frame < frames; frame++) {
+    update(*d, frame);
+    d->display();
+  }
+  double us = mockBusMicros(i2c ? 400000UL : 8000000UL, i2c) / frames;
+  printf("%-16s %-5s %7.1f bytes %8.1f us %8.1f fps\n", name,
+         i2c ? "I2C" : "SPI", (double)mockPanel.busBytes / frames, us,
+         1e6 / us);
+  delete d;
+}
+
+int main() {
+  printf("per frame, 128x64, bus time only\n");
+  for (int i2c = 1; i2c >= 0; i2c--) {
+    bench("whole screen", i2c, fullRedraw);
+    bench("readout", i2c, readout);
+    bench("bar graph", i2c, bar);
+    bench("cursor", i2c, cursor);
+  }
+  return 0;
+}
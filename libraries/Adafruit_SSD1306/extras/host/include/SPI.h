@@ -0,0 +1,39 @@
+/*!
+ * @file SPI.h
+ *
+ * Recording stand-in for the Arduino SPIClass, for the host build in
+ * extras/host. Each byte is counted and handed to the mock SSD1306 in
+ * ssd1306_mock.h as a command or data, going by its D/C pin.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _SSD1306_HOST_SPI_H_
+#define _SSD1306_HOST_SPI_H_
+
+#include <Arduino.h>
+
+#define SPI_HAS_TRANSACTION
+#define SPI_MODE0 0x00
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST,
+              uint8_t dataMode = SPI_MODE0) {
+    (void)clock;
+    (void)bitOrder;
+    (void)dataMode;
+  }
+};
+
+class SPIClass {
+public:
+  void begin(void) {}
+  void beginTransaction(SPISettings settings) { (void)settings; }
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif // _SSD1306_HOST_SPI_H_
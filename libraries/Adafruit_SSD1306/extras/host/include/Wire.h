@@ -0,0 +1,34 @@
+/*!
+ * @file Wire.h
+ *
+ * Recording stand-in for the Arduino TwoWire class, for the host build in
+ * extras/host. Each transmission is counted and handed to the mock SSD1306
+ * in ssd1306_mock.h instead of going out on a bus.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _SSD1306_HOST_WIRE_H_
+#define _SSD1306_HOST_WIRE_H_
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32 ///< Same as the AVR Wire library
+
+class TwoWire {
+public:
+  void begin(void) {}
+  void setClock(uint32_t clock) { (void)clock; }
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  uint8_t endTransmission(void);
+
+private:
+  uint8_t address;
+  uint8_t data[BUFFER_LENGTH];
+  uint8_t length;
+};
+
+extern TwoWire Wire;
+
+#endif // _SSD1306_HOST_WIRE_H_
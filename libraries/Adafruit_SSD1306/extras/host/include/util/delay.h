@@ -0,0 +1,6 @@
+/*!
+ * @file delay.h
+ *
+ * Adafruit_SSD1306.cpp includes the AVR <util/delay.h> on anything it
+ * doesn't recognise, and the host build doesn't need it. Empty on purpose.
+ */
@@ -0,0 +1,155 @@
+/*!
+ * @file ssd1306_mock.cpp
+ *
+ * The Arduino core functions, Wire and SPI for the host build, all of which
+ * feed mockPanel. See ssd1306_mock.h.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "ssd1306_mock.h"
+#include <SPI.h>
+#include <Wire.h>
+
+MockSSD1306 mockPanel;
+TwoWire Wire;
+SPIClass SPI;
+
+static uint8_t pinState[256];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) { pinState[pin] = val; }
+
+int digitalRead(uint8_t pin) { return pinState[pin]; }
+
+void delay(unsigned long ms) { (void)ms; }
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  address = addr;
+  length = 0;
+}
+
+size_t TwoWire::write(uint8_t d) {
+  if (length >= BUFFER_LENGTH)
+    return 0; // Like the real thing, drop what doesn't fit
+  data[length++] = d;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(void) {
+  mockPanel.transactions++;
+  mockPanel.busBytes += 1 + length; // Address byte, then the data
+  if (length) {
+    // Control byte: Co = 0, D/C# picks whether the rest are commands or data
+    bool isData = data[0] & 0x40;
+    for (uint8_t i = 1; i < length; i++) {
+      if (isData)
+        mockPanel.data(data[i]);
+      else
+        mockPanel.command(data[i]);
+    }
+  }
+  return 0;
+}
+
+uint8_t SPIClass::transfer(uint8_t d) {
+  mockPanel.transactions++;
+  mockPanel.busBytes++;
+  if ((mockPanel.dcPin >= 0) && pinState[mockPanel.dcPin])
+    mockPanel.data(d);
+  else
+    mockPanel.command(d);
+  return 0;
+}
+
+void MockSSD1306::reset(void) {
+  memset(ram, 0xA5, sizeof(ram)); // Not blank, so missed writes show up
+  horizontalAddressing = false;
+  page = column = pageStart = columnStart = 0;
+  pageEnd = 7;
+  columnEnd = 127;
+  argCount = argsWanted = 0;
+  dcPin = -1;
+  clearStats();
+}
+
+void MockSSD1306::clearStats(void) {
+  transactions = busBytes = dataBytes = windows = 0;
+}
+
+// How many argument bytes follow each command, from the datasheet
+static uint8_t argumentsFor(uint8_t c) {
+  switch (c) {
+  case 0x20: // MEMORYMODE
+  case 0x81: // SETCONTRAST
+  case 0x8D: // CHARGEPUMP
+  case 0xA8: // SETMULTIPLEX
+  case 0xD3: // SETDISPLAYOFFSET
+  case 0xD5: // SETDISPLAYCLOCKDIV
+  case 0xD9: // SETPRECHARGE
+  case 0xDA: // SETCOMPINS
+  case 0xDB: // SETVCOMDETECT
+    return 1;
+  case 0x21: // COLUMNADDR
+  case 0x22: // PAGEADDR
+  case 0xA3: // SET_VERTICAL_SCROLL_AREA
+    return 2;
+  case 0x29: // VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL
+  case 0x2A: // VERTICAL_AND_LEFT_HORIZONTAL_SCROLL
+    return 5;
+  case 0x26: // RIGHT_HORIZONTAL_SCROLL
+  case 0x27: // LEFT_HORIZONTAL_SCROLL
+    return 6;
+  default:
+    return 0;
+  }
+}
+
+void MockSSD1306::command(uint8_t c) {
+  if (argsWanted) {
+    args[argCount++] = c;
+    if (argCount < argsWanted)
+      return;
+    argsWanted = 0;
+    switch (args[0]) {
+    case 0x20:
+      horizontalAddressing = (args[1] == 0x00);
+      break;
+    case 0x21:
+      columnStart = column = args[1] & 0x7F;
+      columnEnd = args[2] & 0x7F;
+      break;
+    case 0x22:
+      pageStart = page = args[1] & 0x07;
+      pageEnd = args[2] & 0x07;
+      windows++;
+      break;
+    }
+    return;
+  }
+  args[0] = c;
+  argCount = 1;
+  argsWanted = argumentsFor(c) ? argumentsFor(c) + 1 : 0;
+}
+
+void MockSSD1306::data(uint8_t d) {
+  dataBytes++;
+  ram[page][column] = d;
+  if (!horizontalAddressing)
+    return; // The library always sets horizontal mode; anything else is a bug
+  if (column++ == columnEnd) {
+    column = columnStart;
+    if (page++ == pageEnd)
+      page = pageStart;
+  }
+}
+
+double mockBusMicros(uint32_t hz, bool i2c) {
+  double clocks = i2c ? 9.0 * mockPanel.busBytes + 2.0 * mockPanel.transactions
+                      : 8.0 * mockPanel.busBytes;
+  return clocks * 1e6 / hz;
+}
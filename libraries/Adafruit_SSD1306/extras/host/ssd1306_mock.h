@@ -0,0 +1,53 @@
+/*!
+ * @file ssd1306_mock.h
+ *
+ * A model of the SSD1306 controller for the host build: it follows the
+ * commands and data the library sends through the recording Wire and SPI
+ * stand-ins, keeps its own copy of the display RAM, and counts the bytes
+ * that would have gone over the bus. See extras/host/README.md.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _SSD1306_MOCK_H_
+#define _SSD1306_MOCK_H_
+
+#include <Arduino.h>
+
+/// What went over the bus, and what the SSD1306 made of it
+struct MockSSD1306 {
+  uint8_t ram[8][128];      ///< Display RAM, [page][column]
+  bool horizontalAddressing; ///< MEMORYMODE 0x00 was set
+  uint8_t page, column;      ///< Where the next data byte goes
+  uint8_t pageStart, pageEnd, columnStart, columnEnd; ///< Window
+
+  uint32_t transactions; ///< I2C transmissions, or SPI bytes
+  uint32_t busBytes;     ///< Bytes on the bus, I2C address bytes included
+  uint32_t dataBytes;    ///< Bytes written to display RAM
+  uint32_t windows;      ///< PAGEADDR commands
+
+  int8_t dcPin; ///< D/C pin when the library is using SPI
+
+  void reset(void);
+  void clearStats(void);
+  void command(uint8_t c);
+  void data(uint8_t d);
+
+private:
+  uint8_t args[6], argCount, argsWanted;
+};
+
+extern MockSSD1306 mockPanel;
+
+/*!
+    @brief  Bus time for what mockPanel has counted since clearStats().
+    @param  hz
+            Bus clock in Hz.
+    @param  i2c
+            true for I2C (9 clocks a byte plus a start and stop condition
+            per transmission), false for SPI (8 clocks a byte).
+    @return Microseconds.
+*/
+double mockBusMicros(uint32_t hz, bool i2c);
+
+#endif // _SSD1306_MOCK_H_
@@ -0,0 +1,219 @@
+/*!
+ * @file dirty_regions.cpp
+ *
+ * Draws at random on I2C and SPI displays of a few sizes, in every rotation,
+ * and checks after each display() or displayRegion() that the mock SSD1306's
+ * RAM matches the library's buffer, and that display() sends no more than
+ * it has to.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "ssd1306_mock.h"
+#include <Adafruit_SSD1306.h>
+
+static int failures = 0;
+static uint32_t seed = 12345;
+
+static long rnd(long howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+// Whether the panel shows what's in the buffer, in pages page0 to page1
+static bool panelMatches(Adafruit_SSD1306 &d, uint8_t page0 = 0,
+                         uint8_t page1 = 0xFF) {
+  uint8_t rotation = d.getRotation();
+  d.setRotation(0);
+  int16_t w = d.width(), h = d.height();
+  bool ok = true;
+  for (int16_t y = page0 * 8; (y < h) && (y / 8 <= page1); y++) {
+    for (int16_t x = 0; x < w; x++) {
+      bool lit = mockPanel.ram[y / 8][x] & (1 << (y & 7));
+      if (lit != d.getPixel(x, y))
+        ok = false;
+    }
+  }
+  d.setRotation(rotation);
+  return ok;
+}
+
+static void check(bool ok, const char *what, const char *name,
+                  uint8_t rotation, int step) {
+  if (!ok) {
+    printf("%s, rotation %u, step %d: %s\n", name, rotation, step, what);
+    failures++;
+  }
+}
+
+static void randomDrawing(Adafruit_SSD1306 &d) {
+  int16_t w = d.width(), h = d.height();
+  int16_t x = rnd(w + 20) - 10, y = rnd(h + 20) - 10;
+  uint16_t colors[] = {SSD1306_WHITE, SSD1306_BLACK, SSD1306_INVERSE};
+  uint16_t color = colors[rnd(3)];
+  switch (rnd(8)) {
+  case 0:
+    d.drawPixel(x, y, color);
+    break;
+  case 1:
+    d.drawFastHLine(x, y, rnd(w), color);
+    break;
+  case 2:
+    d.drawFastVLine(x, y, rnd(h), color);
+    break;
+  case 3:
+    d.fillRect(x, y, rnd(w / 2), rnd(h / 2), color);
+    break;
+  case 4:
+    d.drawLine(x, y, rnd(w), rnd(h), color);
+    break;
+  case 5:
+    d.fillCircle(x, y, rnd(12), color);
+    break;
+  case 6:
+    d.setTextColor(color);
+    d.setTextSize(1 + rnd(2));
+    d.setCursor(x, y);
+    d.print(rnd(10000));
+    break;
+  case 7:
+    d.drawRect(x, y, rnd(w), rnd(h), color);
+    break;
+  }
+}
+
+static void testDisplay(Adafruit_SSD1306 &d, const char *name, int8_t dcPin) {
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    mockPanel.reset();
+    mockPanel.dcPin = dcPin;
+    d.setRotation(0);
+    if (!d.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+      printf("%s: begin() failed\n", name);
+      failures++;
+      return;
+    }
+    d.setRotation(rotation);
+    d.display();
+    check(panelMatches(d), "splash screen differs", name, rotation, 0);
+
+    mockPanel.clearStats();
+    d.display();
+    check(mockPanel.dataBytes == 0, "display() with nothing drawn sent data",
+          name, rotation, 0);
+
+    for (int step = 1; step <= 300; step++) {
+      int ops = 1 + rnd(4);
+      while (ops--)
+        randomDrawing(d);
+      if (rnd(4)) {
+        d.display();
+        check(panelMatches(d), "display() left the panel different", name,
+              rotation, step);
+      } else {
+        // Send a random rectangle, then check the pages it covers
+        int16_t x = rnd(d.width()), y = rnd(d.height());
+        int16_t w = 1 + rnd(d.width()), h = 1 + rnd(d.height());
+        d.displayRegion(x, y, w, h);
+        // Rotate the rectangle's rows to pages the same way the library does
+        int16_t y1 = min(y + h, (int16_t)d.height()) - 1;
+        int16_t x1 = min(x + w, (int16_t)d.width()) - 1;
+        int16_t r0, r1;
+        switch (rotation) {
+        case 0:
+          r0 = y, r1 = y1;
+          break;
+        case 1:
+          r0 = x, r1 = x1;
+          break;
+        case 2:
+          r0 = d.height() - 1 - y1, r1 = d.height() - 1 - y;
+          break;
+        default:
+          r0 = d.width() - 1 - x1, r1 = d.width() - 1 - x;
+          break;
+        }
+        uint8_t rotationNow = d.getRotation();
+        d.setRotation(0);
+        int16_t physW = d.width();
+        d.setRotation(rotationNow);
+        bool ok = true;
+        // Only the columns asked for are sent, so check those
+        for (int16_t py = r0 - (r0 & 7); py <= (r1 | 7); py++) {
+          for (int16_t px = 0; px < physW; px++) {
+            int16_t qx, qy; // Rotated back to drawing coordinates
+            switch (rotation) {
+            case 0:
+              qx = px, qy = py;
+              break;
+            case 1:
+              qx = py, qy = physW - 1 - px;
+              break;
+            case 2:
+              qx = physW - 1 - px, qy = d.height() - 1 - py;
+              break;
+            default:
+              qx = d.width() - 1 - py, qy = px;
+              break;
+            }
+            if ((qx < x) || (qx > x1) || (qy < y) || (qy > y1))
+              continue;
+            bool lit = mockPanel.ram[py / 8][px] & (1 << (py & 7));
+            if (lit != d.getPixel(qx, qy))
+              ok = false;
+          }
+        }
+        check(ok, "displayRegion() left the region different", name,
+              rotation, step);
+      }
+    }
+    d.display();
+    check(panelMatches(d), "final display() left the panel different", name,
+          rotation, 301);
+
+    // A small readout should cost far less than the whole screen
+    mockPanel.clearStats();
+    d.fillRect(0, 0, 24, 16, SSD1306_BLACK);
+    d.setTextSize(2);
+    d.setTextColor(SSD1306_WHITE);
+    d.setCursor(0, 0);
+    d.print(42);
+    d.display();
+    check(panelMatches(d), "readout left the panel different", name,
+          rotation, 302);
+    check(mockPanel.dataBytes <= 3 * 24, "readout sent too much data", name,
+          rotation, 302);
+
+    // Hardware scrolling moves the image, so it all has to be sent again
+    d.startscrollright(0, 7);
+    d.stopscroll();
+    mockPanel.clearStats();
+    d.display();
+    check(mockPanel.dataBytes == (uint32_t)d.width() * d.height() / 8,
+          "display() after stopscroll() didn't send the whole screen", name,
+          rotation, 303);
+  }
+
+  // Writes through getBuffer() can't be tracked
+  d.setRotation(0);
+  uint8_t *buffer = d.getBuffer();
+  d.display();
+  buffer[5] ^= 0xFF;
+  d.display();
+  check(panelMatches(d), "write through getBuffer() didn't show", name, 0,
+        304);
+}
+
+int main() {
+  Adafruit_SSD1306 i2c64(128, 64, &Wire, -1);
+  testDisplay(i2c64, "I2C 128x64", -1);
+  Adafruit_SSD1306 i2c32(128, 32, &Wire, -1);
+  testDisplay(i2c32, "I2C 128x32", -1);
+  Adafruit_SSD1306 spi64(128, 64, &SPI, 9, -1, 10);
+  testDisplay(spi64, "SPI 128x64", 9);
+  Adafruit_SSD1306 spi16(96, 16, &SPI, 9, -1, 10);
+  testDisplay(spi16, "SPI 96x16", 9);
+
+  if (failures)
+    printf("%d checks failed\n", failures);
+  return failures ? 1 : 0;
+}
@@ -21,6 +21,13 @@ uint32_t _retry_cnt=0;
 
 // uint32_t CRGB::Squant = ((uint32_t)((__TIME__[4]-'0') * 28))<<16 | ((__TIME__[6]-'0')*50)<<8 | ((__TIME__[7]-'0')*28);
 
+CLEDController & CLEDController::setLeds(CRGB *data, int nLeds) {
+	m_Data = data;
+	m_nLeds = nLeds;
+	m_pTrackedSet = CRGBTrackedSet::find(data, size());
+	return *this;
+}
+
 CFastLED::CFastLED() {
 	// clear out the array of led controllers
 	// m_nControllers = 0;
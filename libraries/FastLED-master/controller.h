@@ -10,6 +10,8 @@
 #include "color.h"
 #include <stddef.h>
 
+class CRGBTrackedSet;
+
 FASTLED_NAMESPACE_BEGIN
 
 #define RO(X) RGB_BYTE(RGB_ORDER, X)
@@ -39,12 +41,14 @@ typedef uint8_t EDitherMode;
 class CLEDController {
 protected:
     friend class CFastLED;
+    friend class ::CRGBTrackedSet;
     CRGB *m_Data;
     CLEDController *m_pNext;
     CRGB m_ColorCorrection;
     CRGB m_ColorTemperature;
     EDitherMode m_DitherMode;
     int m_nLeds;
+    CRGBTrackedSet *m_pTrackedSet;
     static CLEDController *m_pHead;
     static CLEDController *m_pTail;
 
@@ -62,7 +66,7 @@ protected:
 
 public:
 	/// create an led controller object, add it to the chain of controllers
-    CLEDController() : m_Data(NULL), m_ColorCorrection(UncorrectedColor), m_ColorTemperature(UncorrectedTemperature), m_DitherMode(BINARY_DITHER), m_nLeds(0) {
+    CLEDController() : m_Data(NULL), m_ColorCorrection(UncorrectedColor), m_ColorTemperature(UncorrectedTemperature), m_DitherMode(BINARY_DITHER), m_nLeds(0), m_pTrackedSet(NULL) {
         m_pNext = NULL;
         if(m_pHead==NULL) { m_pHead = this; }
         if(m_pTail != NULL) { m_pTail->m_pNext = this; }
@@ -101,11 +105,7 @@ public:
     CLEDController *next() { return m_pNext; }
 
 	/// set the default array of leds to be used by this controller
-    CLEDController & setLeds(CRGB *data, int nLeds) {
-        m_Data = data;
-        m_nLeds = nLeds;
-        return *this;
-    }
+    CLEDController & setLeds(CRGB *data, int nLeds);
 
 	/// zero out the led data managed by this controller
     void clearLedData() {
@@ -120,6 +120,9 @@ public:
     /// Pointer to the CRGB array for this controller
     CRGB* leds() { return m_Data; }
 
+    /// The tracked set holding exactly the leds of this controller, or NULL if they aren't one
+    CRGBTrackedSet *trackedSet() { return m_pTrackedSet; }
+
     /// Reference to the n'th item in the controller
     CRGB &operator[](int x) { return m_Data[x]; }
 
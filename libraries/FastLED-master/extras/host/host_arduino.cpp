@@ -0,0 +1,17 @@
+/// @file host_arduino.cpp
+/// The Arduino core functions FastLED calls, on the host.  Time is whatever the tests set.
+
+#include <Arduino.h>
+
+unsigned long host_micros = 0;
+
+unsigned long millis() { return host_micros / 1000; }
+unsigned long micros() { return host_micros; }
+void delay(unsigned long ms) { host_micros += ms * 1000; }
+void delayMicroseconds(unsigned int us) { host_micros += us; }
+void yield() {}
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+
+// Sketches that blur in 2D provide the led layout for blur2d()
+uint16_t XY(uint8_t x, uint8_t y) { return (uint16_t)y * 16 + x; }
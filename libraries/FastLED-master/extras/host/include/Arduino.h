@@ -0,0 +1,35 @@
+/// @file Arduino.h
+/// Just enough of the Arduino core for FastLED to build on a desktop machine, for the tests in
+/// extras/host.  FastLED takes the AVR path for a platform it doesn't know, so the avr/ headers
+/// here stand in for avr-libc.  Nothing here is used when building for a board.
+
+#ifndef __INC_FASTLED_HOST_ARDUINO_H
+#define __INC_FASTLED_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+// No ports, FastPin is never used on the host
+#define digitalPinToBitMask(P) ((uint8_t)1)
+#define digitalPinToPort(P) (0)
+#define portOutputRegister(P) ((volatile uint8_t *)NULL)
+#define portInputRegister(P) ((volatile uint8_t *)NULL)
+#define portModeRegister(P) ((volatile uint8_t *)NULL)
+
+#endif
@@ -0,0 +1,10 @@
+/// @file avr/interrupt.h
+/// Stands in for avr-libc on the host, see extras/host/include/Arduino.h.  No interrupts.
+
+#ifndef __INC_FASTLED_HOST_AVR_INTERRUPT_H
+#define __INC_FASTLED_HOST_AVR_INTERRUPT_H
+
+#define cli()
+#define sei()
+
+#endif
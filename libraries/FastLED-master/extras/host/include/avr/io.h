@@ -0,0 +1,9 @@
+/// @file avr/io.h
+/// Stands in for avr-libc on the host, see extras/host/include/Arduino.h.  No registers.
+
+#ifndef __INC_FASTLED_HOST_AVR_IO_H
+#define __INC_FASTLED_HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#endif
@@ -0,0 +1,188 @@
+/// @file tracked_set.cpp
+/// Checks that a CRGBTrackedSet's running sums stay exact through every way of writing a led that
+/// it tracks: whole colors, the CRGB operations, and the r, g, b, red, green, blue and raw[]
+/// channels.  A random mix of writes goes to a tracked set and to a plain CRGB array, and after
+/// each one the leds have to match and the sums have to be those of the leds.
+///
+/// Then it checks that controllers find the tracked set holding their leds, as sets come and go,
+/// and that the power limit from the running sums is the one from walking the leds.
+
+#include <stdio.h>
+#include <FastLED.h>
+
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS 60
+
+static uint32_t seed = 1;
+
+static uint8_t rnd(uint8_t howbig) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % howbig;
+}
+
+static uint8_t rnd8() { return rnd(255) + (rnd(2) ? 1 : 0); }
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int n) {
+  if(!ok) {
+    if(failures < 20) { printf("%s, case %d\n", what, n); }
+    failures++;
+  }
+}
+
+// One random write, through a tracked led or a CRGB, the same for both from the same seed.  The values
+// are drawn first, as the order operands are evaluated in may differ between operators and calls.
+template<typename LED> static void write(LED led, LED other) {
+  uint8_t op = rnd(46), x = rnd(3), n = rnd(4), v1 = rnd8(), v2 = rnd8(), v3 = rnd8();
+  switch(op) {
+    case 0: led = CRGB(v1, v2, v3); break;
+    case 1: led = CHSV(v1, v2, v3); break;
+    case 2: led = (uint32_t)v1 << 16 | v2; break;
+    case 3: led = CRGB::Orange; break;
+    case 4: led = other; break;
+    case 5: led.r = v1; break;
+    case 6: led.g += v1; break;
+    case 7: led.b -= v1; break;
+    case 8: led.red *= n; break;
+    case 9: led.green /= n + 1; break;
+    case 10: led.blue |= v1; break;
+    case 11: led.r &= v1; break;
+    case 12: led.g ^= v1; break;
+    case 13: led.b <<= 1; break;
+    case 14: led.r >>= x; break;
+    case 15: ++led.g; break;
+    case 16: led.b--; break;
+    case 17: led.raw[x] = v1; break;
+    case 18: led[x] += v1; break;
+    case 19: led.r = other.g; break;
+    case 20: led.green %= n + x + 1; break;
+    case 21: led += other; break;
+    case 22: led -= CRGB(v1, v2, v3); break;
+    case 23: led |= other; break;
+    case 24: led &= CRGB(v1, v2, v3); break;
+    case 25: led |= v1; break;
+    case 26: led &= v1; break;
+    case 27: led /= x + 1; break;
+    case 28: led >>= x; break;
+    case 29: led *= n; break;
+    case 30: led %= v1; break;
+    case 31: ++led; break;
+    case 32: led--; break;
+    case 33: led.addToRGB(v1); break;
+    case 34: led.subtractFromRGB(v1); break;
+    case 35: led.nscale8(v1); break;
+    case 36: led.nscale8(CRGB(v1, v2, v3)); break;
+    case 37: led.nscale8_video(v1); break;
+    case 38: led.fadeToBlackBy(v1); break;
+    case 39: led.fadeLightBy(v1); break;
+    case 40: led.maximizeBrightness(v1); break;
+    case 41: led.setParity(x & 1); break;
+    case 42: led.setRGB(v1, v2, v3); break;
+    case 43: led.setHSV(v1, v2, v3); break;
+    case 44: led.setHue(v1); break;
+    default: led.setColorCode((uint32_t)v1 << 8); break;
+  }
+}
+
+static bool sums_match(const CRGBTrackedSet & set, const CRGB *leds) {
+  uint32_t sums[3] = { 0, 0, 0 };
+  for(int i = 0; i < NUM_LEDS; i++) {
+    for(int c = 0; c < 3; c++) { sums[c] += leds[i].raw[c]; }
+  }
+  return set.channelSum(0) == sums[0] && set.channelSum(1) == sums[1] && set.channelSum(2) == sums[2];
+}
+
+static void writes() {
+  CRGBTrackedArray<NUM_LEDS> tracked;
+  CRGB plain[NUM_LEDS];
+
+  tracked = CRGB::Black;
+  fill_solid(plain, NUM_LEDS, CRGB::Black);
+  for(int n = 0; n < 20000; n++) {
+    int i = rnd(NUM_LEDS);
+    int j = rnd(NUM_LEDS);
+    uint32_t s = seed;
+    write<CRGBTrackedSet::CRGBTrackedRef>(tracked[i], tracked[j]);
+    seed = s;
+    write<CRGB &>(plain[i], plain[j]);
+
+    // Now and then, the whole set
+    uint8_t op = rnd(200), v = rnd8();
+    if(op == 0) { tracked.fill_solid(CRGB(v, 0, 0)); fill_solid(plain, NUM_LEDS, CRGB(v, 0, 0)); }
+    if(op == 1) { tracked.nscale8(v); nscale8(plain, NUM_LEDS, v); }
+    if(op == 2) { tracked.set(i, CRGB(0, v, v)); plain[i] = CRGB(0, v, v); }
+
+    if(memcmp((const CRGB *)tracked, plain, sizeof(plain)) != 0) {
+      check(false, "leds differ", n);
+      return;
+    }
+    if(!sums_match(tracked, plain)) {
+      check(false, "sums differ from the leds", n);
+      return;
+    }
+  }
+
+  // The reads a CRGB has
+  const CRGB & led = tracked[3];
+  check(tracked[3].getLuma() == led.getLuma(), "getLuma", 0);
+  check(tracked[3].getAverageLight() == led.getAverageLight(), "getAverageLight", 0);
+  check(tracked[3].scale8(CRGB(128, 64, 32)) == led.scale8(CRGB(128, 64, 32)), "scale8", 0);
+  check(tracked[3].lerp8(CRGB::White, 100) == led.lerp8(CRGB::White, 100), "lerp8", 0);
+  check((bool)tracked[3] == (bool)led, "bool", 0);
+  check(tracked[3].r == led.r && tracked[3].raw[2] == led.b && tracked[3][1] == led.g, "channel reads", 0);
+}
+
+// Shows nothing, but is a controller for the power code
+class NullController : public CLEDController {
+public:
+  virtual void init() {}
+protected:
+  virtual void showColor(const struct CRGB &, int, CRGB) {}
+  virtual void show(const struct CRGB *, int, CRGB) {}
+};
+
+static void controllers() {
+  static CRGBTrackedArray<NUM_LEDS> tracked;
+  static CRGB plain[NUM_LEDS];
+  static NullController first, second;
+
+  FastLED.addLeds(&first, tracked, NUM_LEDS);
+  FastLED.addLeds(&second, plain, NUM_LEDS);
+  check(first.trackedSet() == &tracked, "set made before addLeds() not found", 0);
+  check(second.trackedSet() == NULL, "plain leds found a set", 0);
+  {
+    CRGBTrackedSet later(plain, NUM_LEDS);
+    check(second.trackedSet() == &later, "set made after addLeds() not found", 0);
+  }
+  check(second.trackedSet() == NULL, "set gone, still found", 0);
+
+  // The power limit from the running sums, against the one from walking a copy of the leds
+  static CRGB copy[NUM_LEDS];
+  for(int n = 0; n < 200; n++) {
+    for(int k = 0; k < 10; k++) {
+      int i = rnd(NUM_LEDS);
+      tracked[i].r = rnd8();
+      tracked[i].g += rnd8();
+      tracked[i] |= CRGB(0, 0, rnd8());
+      plain[i] = CHSV(rnd8(), 255, rnd8());
+    }
+    uint32_t mW = 500 + rnd8() * 40;
+    uint8_t fromSums = calculate_max_brightness_for_power_mW(255, mW);
+    memcpy(copy, (const CRGB *)tracked, sizeof(copy));
+    first.setLeds(copy, NUM_LEDS);
+    check(first.trackedSet() == NULL, "copy found a set", n);
+    check(fromSums == calculate_max_brightness_for_power_mW(255, mW), "power limit differs", n);
+    first.setLeds(tracked, NUM_LEDS);
+    check(first.trackedSet() == &tracked, "set not found again", n);
+  }
+}
+
+int main() {
+  writes();
+  controllers();
+  if(failures) { printf("%d cases failed\n", failures); }
+  else { printf("tracked sums exact through all writes\n"); }
+  return failures ? 1 : 0;
+}
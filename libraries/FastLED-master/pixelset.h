@@ -302,4 +302,225 @@ public:
   using CPixelView::operator=;
 };
 
+/// A set of CRGB leds that keeps running per-channel sums of its contents as it is written to.  The power
+/// management code keeps a pointer to the set in each controller whose leds are a tracked set, so it gets their
+/// power draw without walking the whole buffer on every show().  The sums are only exact as long as writes go
+/// through this object (operator[] and the members of the led it returns, fill_solid, nscale8, etc...).  If the
+/// led data is changed some other way (e.g. through the raw pointer, or via untracked()), call markDirty() so the
+/// sums get rebuilt on the next show(), or use setResyncInterval() to have them rebuilt every so many frames regardless.
+class CRGBTrackedSet {
+  CRGB * const m_pLeds;
+  const uint16_t m_nLeds;
+  uint32_t m_nSums[3];
+  uint16_t m_nResyncInterval;
+  uint16_t m_nFramesSinceResync;
+  bool m_bDirty;
+  CRGBTrackedSet *m_pNext;
+  static CRGBTrackedSet *m_pHead;
+
+  // not copyable, the sums (and the registry entry) belong to one block of led data
+  CRGBTrackedSet(const CRGBTrackedSet &);
+  CRGBTrackedSet & operator=(const CRGBTrackedSet &);
+
+  inline void track(const CRGB & oldcolor, const CRGB & newcolor) {
+    m_nSums[0] += (uint32_t)newcolor.r - oldcolor.r;
+    m_nSums[1] += (uint32_t)newcolor.g - oldcolor.g;
+    m_nSums[2] += (uint32_t)newcolor.b - oldcolor.b;
+  }
+
+  // point the controllers showing this block of leds at us, or at nothing if we are going away
+  void attach(CRGBTrackedSet *pSet);
+
+public:
+  /// A reference to a single channel of a led in a tracked set, what the r, g, b (etc...) members of a
+  /// CRGBTrackedRef are.  Assigning through it keeps the set's sum for that channel up to date.
+  class CRGBTrackedChannel {
+    uint32_t & sum;
+    uint8_t & value;
+  public:
+    inline CRGBTrackedChannel(uint32_t & _sum, uint8_t & _value) : sum(_sum), value(_value) {}
+
+    inline CRGBTrackedChannel & operator=(uint8_t rhs) { sum += (uint32_t)rhs - value; value = rhs; return *this; }
+    inline CRGBTrackedChannel & operator=(const CRGBTrackedChannel & rhs) { return *this = (uint8_t)rhs.value; }
+
+    inline operator uint8_t () const { return value; }
+
+    inline CRGBTrackedChannel & operator+=(int rhs) { return *this = (uint8_t)(value + rhs); }
+    inline CRGBTrackedChannel & operator-=(int rhs) { return *this = (uint8_t)(value - rhs); }
+    inline CRGBTrackedChannel & operator*=(int rhs) { return *this = (uint8_t)(value * rhs); }
+    inline CRGBTrackedChannel & operator/=(int rhs) { return *this = (uint8_t)(value / rhs); }
+    inline CRGBTrackedChannel & operator%=(int rhs) { return *this = (uint8_t)(value % rhs); }
+    inline CRGBTrackedChannel & operator&=(int rhs) { return *this = (uint8_t)(value & rhs); }
+    inline CRGBTrackedChannel & operator|=(int rhs) { return *this = (uint8_t)(value | rhs); }
+    inline CRGBTrackedChannel & operator^=(int rhs) { return *this = (uint8_t)(value ^ rhs); }
+    inline CRGBTrackedChannel & operator<<=(int rhs) { return *this = (uint8_t)(value << rhs); }
+    inline CRGBTrackedChannel & operator>>=(int rhs) { return *this = (uint8_t)(value >> rhs); }
+    inline CRGBTrackedChannel & operator++() { return *this = (uint8_t)(value + 1); }
+    inline CRGBTrackedChannel & operator--() { return *this = (uint8_t)(value - 1); }
+    inline uint8_t operator++(int) { uint8_t old = value; *this = (uint8_t)(old + 1); return old; }
+    inline uint8_t operator--(int) { uint8_t old = value; *this = (uint8_t)(old - 1); return old; }
+  };
+
+  /// The raw[] member of a CRGBTrackedRef, indexing its channels like CRGB::raw
+  class CRGBTrackedRaw {
+    uint32_t * const sums;
+    uint8_t * const values;
+  public:
+    inline CRGBTrackedRaw(uint32_t *_sums, uint8_t *_values) : sums(_sums), values(_values) {}
+    inline CRGBTrackedChannel operator[](uint8_t x) const { return CRGBTrackedChannel(sums[x], values[x]); }
+  };
+
+  /// A reference to a single led in a tracked set.  It has the members of a CRGB, and assigning through it or
+  /// any of its channels keeps the set's sums up to date.
+  class CRGBTrackedRef {
+    CRGBTrackedSet & set;
+    CRGB & led;
+  public:
+    CRGBTrackedChannel r, g, b;
+    CRGBTrackedChannel red, green, blue;
+    CRGBTrackedRaw raw;
+
+    inline CRGBTrackedRef(CRGBTrackedSet & _set, CRGB & _led) : set(_set), led(_led),
+      r(_set.m_nSums[0], _led.r), g(_set.m_nSums[1], _led.g), b(_set.m_nSums[2], _led.b),
+      red(_set.m_nSums[0], _led.r), green(_set.m_nSums[1], _led.g), blue(_set.m_nSums[2], _led.b),
+      raw(_set.m_nSums, _led.raw) {}
+
+    inline CRGBTrackedRef & operator=(const CRGB & rhs) { set.track(led, rhs); led = rhs; return *this; }
+    inline CRGBTrackedRef & operator=(const CHSV & rhs) { return *this = CRGB(rhs); }
+    inline CRGBTrackedRef & operator=(const uint32_t colorcode) { return *this = CRGB(colorcode); }
+    inline CRGBTrackedRef & operator=(const CRGBTrackedRef & rhs) { return *this = (const CRGB &)rhs.led; }
+
+    inline operator const CRGB & () const { return led; }
+
+    inline CRGBTrackedChannel operator[](uint8_t x) { return raw[x]; }
+    inline const uint8_t & operator[](uint8_t x) const { return led.raw[x]; }
+
+    inline CRGBTrackedRef & setRGB(uint8_t nr, uint8_t ng, uint8_t nb) { return *this = CRGB(nr, ng, nb); }
+    inline CRGBTrackedRef & setHSV(uint8_t hue, uint8_t sat, uint8_t val) { return *this = CHSV(hue, sat, val); }
+    inline CRGBTrackedRef & setHue(uint8_t hue) { return *this = CHSV(hue, 255, 255); }
+    inline CRGBTrackedRef & setColorCode(uint32_t colorcode) { return *this = CRGB(colorcode); }
+
+    inline CRGBTrackedRef & operator+=(const CRGB & rhs) { CRGB c = led; c += rhs; return *this = c; }
+    inline CRGBTrackedRef & operator-=(const CRGB & rhs) { CRGB c = led; c -= rhs; return *this = c; }
+    inline CRGBTrackedRef & operator|=(const CRGB & rhs) { CRGB c = led; c |= rhs; return *this = c; }
+    inline CRGBTrackedRef & operator&=(const CRGB & rhs) { CRGB c = led; c &= rhs; return *this = c; }
+    inline CRGBTrackedRef & operator|=(uint8_t d) { CRGB c = led; c |= d; return *this = c; }
+    inline CRGBTrackedRef & operator&=(uint8_t d) { CRGB c = led; c &= d; return *this = c; }
+    inline CRGBTrackedRef & operator/=(uint8_t d) { CRGB c = led; c /= d; return *this = c; }
+    inline CRGBTrackedRef & operator>>=(uint8_t d) { CRGB c = led; c >>= d; return *this = c; }
+    inline CRGBTrackedRef & operator*=(uint8_t d) { CRGB c = led; c *= d; return *this = c; }
+    inline CRGBTrackedRef & operator%=(uint8_t scaledown) { CRGB c = led; c %= scaledown; return *this = c; }
+    inline CRGBTrackedRef & operator++() { CRGB c = led; ++c; return *this = c; }
+    inline CRGBTrackedRef & operator--() { CRGB c = led; --c; return *this = c; }
+    inline CRGB operator++(int) { CRGB old = led; ++(*this); return old; }
+    inline CRGB operator--(int) { CRGB old = led; --(*this); return old; }
+    inline CRGBTrackedRef & addToRGB(uint8_t d) { CRGB c = led; c.addToRGB(d); return *this = c; }
+    inline CRGBTrackedRef & subtractFromRGB(uint8_t d) { CRGB c = led; c.subtractFromRGB(d); return *this = c; }
+    inline CRGBTrackedRef & nscale8(uint8_t scaledown) { CRGB c = led; c.nscale8(scaledown); return *this = c; }
+    inline CRGBTrackedRef & nscale8(const CRGB & scaledown) { CRGB c = led; c.nscale8(scaledown); return *this = c; }
+    inline CRGBTrackedRef & nscale8_video(uint8_t scaledown) { CRGB c = led; c.nscale8_video(scaledown); return *this = c; }
+    inline CRGBTrackedRef & fadeToBlackBy(uint8_t fade) { return nscale8(255 - fade); }
+    inline CRGBTrackedRef & fadeLightBy(uint8_t fade) { return nscale8_video(255 - fade); }
+    inline void maximizeBrightness(uint8_t limit = 255) { CRGB c = led; c.maximizeBrightness(limit); *this = c; }
+    inline void setParity(uint8_t parity) { CRGB c = led; c.setParity(parity); *this = c; }
+
+    inline explicit operator bool() const { return led; }
+    inline CRGB operator-() const { CRGB c = led; return -c; }
+    inline uint8_t getLuma() const { return led.getLuma(); }
+    inline uint8_t getAverageLight() const { return led.getAverageLight(); }
+    inline uint8_t getParity() const { CRGB c = led; return c.getParity(); }
+    inline CRGB scale8(const CRGB & scaledown) const { return led.scale8(scaledown); }
+    inline CRGB lerp8(const CRGB & other, fract8 frac) const { return led.lerp8(other, frac); }
+    inline CRGB lerp16(const CRGB & other, fract16 frac) const { return led.lerp16(other, frac); }
+  };
+
+  /// Track the given block of leds.  The sums start out dirty, and get built on first use.
+  /// @param leds point to the raw led data
+  /// @param nLeds how many leds in this set
+  CRGBTrackedSet(CRGB *leds, uint16_t nLeds) : m_pLeds(leds), m_nLeds(nLeds),
+    m_nResyncInterval(0), m_nFramesSinceResync(0), m_bDirty(true) {
+    m_nSums[0] = m_nSums[1] = m_nSums[2] = 0;
+    m_pNext = m_pHead;
+    m_pHead = this;
+    attach(this);
+  }
+
+  ~CRGBTrackedSet();
+
+  /// Get the size of this set
+  inline int size() const { return m_nLeds; }
+
+  /// Return a pointer to the first element in this set.  Writes through this pointer are not tracked.
+  inline operator CRGB* () const { return m_pLeds; }
+
+  /// access a single element in this set, just like an array operator
+  inline CRGBTrackedRef operator[](int x) { return CRGBTrackedRef(*this, m_pLeds[x]); }
+  /// read a single element in this set
+  inline const CRGB & operator[](int x) const { return m_pLeds[x]; }
+
+  /// Set a single led, keeping the sums up to date
+  inline void set(int x, const CRGB & color) { track(m_pLeds[x], color); m_pLeds[x] = color; }
+
+  /// Assign the passed in color to all elements in this set
+  inline CRGBTrackedSet & operator=(const CRGB & color) { return fill_solid(color); }
+
+  /// Assign the passed in color to all elements in this set.  The sums are set directly, no need to walk the leds twice.
+  inline CRGBTrackedSet & fill_solid(const CRGB & color) {
+    for(uint16_t i = 0; i < m_nLeds; ++i) { m_pLeds[i] = color; }
+    m_nSums[0] = (uint32_t)color.r * m_nLeds;
+    m_nSums[1] = (uint32_t)color.g * m_nLeds;
+    m_nSums[2] = (uint32_t)color.b * m_nLeds;
+    m_bDirty = false;
+    return *this;
+  }
+
+  /// Scale every led by the given scale.  Bulk operations rebuild the sums as they go.
+  inline CRGBTrackedSet & nscale8(uint8_t scaledown) {
+    m_nSums[0] = m_nSums[1] = m_nSums[2] = 0;
+    for(uint16_t i = 0; i < m_nLeds; ++i) {
+      m_pLeds[i].nscale8(scaledown);
+      m_nSums[0] += m_pLeds[i].r; m_nSums[1] += m_pLeds[i].g; m_nSums[2] += m_pLeds[i].b;
+    }
+    m_bDirty = false;
+    return *this;
+  }
+
+  /// Fade every led down by the given scale
+  inline CRGBTrackedSet & fadeToBlackBy(uint8_t fade) { return nscale8(255 - fade); }
+
+  /// Get an untracked view of the leds, for using the full set of CPixelView operations.  This marks
+  /// the sums dirty, so they get rebuilt on the next show().
+  inline CRGBSet untracked() { m_bDirty = true; return CRGBSet(m_pLeds, m_nLeds); }
+
+  /// Flag that the led data was changed behind our back, and the sums need to be rebuilt
+  inline void markDirty() { m_bDirty = true; }
+
+  /// Rebuild the sums from the led data every this many frames, to correct drift from untracked writes.
+  /// Zero (the default) only rebuilds the sums when they have been marked dirty.
+  inline void setResyncInterval(uint16_t frames) { m_nResyncInterval = frames; }
+
+  /// The running sum of one channel (0 red, 1 green, 2 blue) over the set, as of the last tracked write or resync
+  inline uint32_t channelSum(uint8_t x) const { return m_nSums[x]; }
+
+  /// Rebuild the running sums from the led data right now
+  void resync();
+
+  /// How many milliwatts the current led data would draw at brightness = 255.  This is the same value as
+  /// calculate_unscaled_power_mW() over the same leds, computed from the running sums.
+  uint32_t unscaled_power_mW();
+
+  /// Find the tracked set covering exactly the given block of leds, if there is one.  This walks all of
+  /// them; controllers look it up once, when their leds are set, and keep it.
+  static CRGBTrackedSet *find(const CRGB *leds, int nLeds);
+};
+
+/// A CRGBTrackedSet that owns its led data, the tracked counterpart to CRGBArray
+template<int SIZE>
+class CRGBTrackedArray : public CRGBTrackedSet {
+  CRGB rawleds[SIZE];
+public:
+  CRGBTrackedArray() : CRGBTrackedSet(rawleds, SIZE) {}
+  inline CRGBTrackedArray & operator=(const CRGB & color) { fill_solid(color); return *this; }
+};
+
 #endif
@@ -47,6 +47,21 @@ static const uint8_t gMCU_mW  =  25 * 5; // 25mA @ 5v = 125 mW
 static uint8_t  gMaxPowerIndicatorLEDPinNumber = 0; // default = Arduino onboard LED pin.  set to zero to skip this.
 
 
+static uint32_t scale_channel_sums_to_mW( uint32_t red32, uint32_t green32, uint32_t blue32, uint16_t numLeds)
+{
+    red32   *= gRed_mW;
+    green32 *= gGreen_mW;
+    blue32  *= gBlue_mW;
+
+    red32   >>= 8;
+    green32 >>= 8;
+    blue32  >>= 8;
+
+    uint32_t total = red32 + green32 + blue32 + (gDark_mW * numLeds);
+
+    return total;
+}
+
 uint32_t calculate_unscaled_power_mW( const CRGB* ledbuffer, uint16_t numLeds ) //25354
 {
     uint32_t red32 = 0, green32 = 0, blue32 = 0;
@@ -63,19 +78,70 @@ uint32_t calculate_unscaled_power_mW( const CRGB* ledbuffer, uint16_t numLeds )
         count--;
     }
 
-    red32   *= gRed_mW;
-    green32 *= gGreen_mW;
-    blue32  *= gBlue_mW;
+    return scale_channel_sums_to_mW( red32, green32, blue32, numLeds);
+}
 
-    red32   >>= 8;
-    green32 >>= 8;
-    blue32  >>= 8;
+FASTLED_NAMESPACE_END
 
-    uint32_t total = red32 + green32 + blue32 + (gDark_mW * numLeds);
+//// TRACKED LED SETS
 
-    return total;
+FASTLED_USING_NAMESPACE
+
+CRGBTrackedSet *CRGBTrackedSet::m_pHead = NULL;
+
+CRGBTrackedSet::~CRGBTrackedSet()
+{
+    for(CRGBTrackedSet **pp = &m_pHead; *pp; pp = &((*pp)->m_pNext)) {
+        if(*pp == this) { *pp = m_pNext; break; }
+    }
+    // another set may cover the same leds
+    attach(find(m_pLeds, m_nLeds));
 }
 
+void CRGBTrackedSet::attach(CRGBTrackedSet *pSet)
+{
+    for(CLEDController *pCur = CLEDController::head(); pCur; pCur = pCur->next()) {
+        if( pCur->m_Data == m_pLeds && pCur->size() == m_nLeds) {
+            pCur->m_pTrackedSet = pSet;
+        }
+    }
+}
+
+void CRGBTrackedSet::resync()
+{
+    uint32_t red32 = 0, green32 = 0, blue32 = 0;
+    for(uint16_t i = 0; i < m_nLeds; ++i) {
+        red32   += m_pLeds[i].r;
+        green32 += m_pLeds[i].g;
+        blue32  += m_pLeds[i].b;
+    }
+    m_nSums[0] = red32;
+    m_nSums[1] = green32;
+    m_nSums[2] = blue32;
+    m_nFramesSinceResync = 0;
+    m_bDirty = false;
+}
+
+uint32_t CRGBTrackedSet::unscaled_power_mW()
+{
+    if( m_bDirty || (m_nResyncInterval && ++m_nFramesSinceResync >= m_nResyncInterval)) {
+        resync();
+    }
+    return scale_channel_sums_to_mW( m_nSums[0], m_nSums[1], m_nSums[2], m_nLeds);
+}
+
+CRGBTrackedSet *CRGBTrackedSet::find(const CRGB *leds, int nLeds)
+{
+    for(CRGBTrackedSet *pCur = m_pHead; pCur; pCur = pCur->m_pNext) {
+        if( pCur->m_pLeds == leds && pCur->m_nLeds == nLeds) {
+            return pCur;
+        }
+    }
+    return NULL;
+}
+
+FASTLED_NAMESPACE_BEGIN
+
 
 uint8_t calculate_max_brightness_for_power_vmA(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_V, uint32_t max_power_mA) {
 	return calculate_max_brightness_for_power_mW(ledbuffer, numLeds, target_brightness, max_power_V * max_power_mA);
@@ -103,7 +169,13 @@ uint8_t calculate_max_brightness_for_power_mW( uint8_t target_brightness, uint32
 
     CLEDController *pCur = CLEDController::head();
 	while(pCur) {
-        total_mW += calculate_unscaled_power_mW( pCur->leds(), pCur->size());
+        // leds kept in a tracked set already have their channel sums, no need to walk them
+        CRGBTrackedSet *pTracked = pCur->trackedSet();
+        if( pTracked) {
+            total_mW += pTracked->unscaled_power_mW();
+        } else {
+            total_mW += calculate_unscaled_power_mW( pCur->leds(), pCur->size());
+        }
 		pCur = pCur->next();
 	}
 
@@ -40,6 +40,15 @@
 
 #include "I2CIO.h"
 
+// Most bytes Wire will take in one transaction
+#if defined(BUFFER_LENGTH)
+   #define I2CIO_WRITE_MAX BUFFER_LENGTH
+#elif defined(I2C_BUFFER_LENGTH)
+   #define I2CIO_WRITE_MAX I2C_BUFFER_LENGTH
+#else
+   #define I2CIO_WRITE_MAX 32
+#endif
+
 
 
 // CLASS VARIABLES
@@ -158,6 +167,36 @@ int I2CIO::write ( uint8_t value )
    return ( (status == 0) );
 }
 
+//
+// write - several values, one transaction per Wire buffer
+int I2CIO::write ( const uint8_t *values, uint8_t count )
+{
+   int status = 0;
+
+   if ( _initialised )
+   {
+      while ( ( count > 0 ) && ( status == 0 ) )
+      {
+         uint8_t chunk = ( count > I2CIO_WRITE_MAX ) ? I2CIO_WRITE_MAX : count;
+
+         Wire.beginTransmission ( _i2cAddr );
+         for ( uint8_t i = 0; i < chunk; i++ )
+         {
+            _shadow = ( values[i] & ~(_dirMask) );
+#if (ARDUINO <  100)
+            Wire.send ( _shadow );
+#else
+            Wire.write ( _shadow );
+#endif
+         }
+         status = Wire.endTransmission ();
+         values += chunk;
+         count  -= chunk;
+      }
+   }
+   return ( _initialised && (status == 0) );
+}
+
 //
 // digitalRead
 uint8_t I2CIO::digitalRead ( uint8_t pin )
@@ -121,7 +121,21 @@ public:
     @result     1 on success, 0 otherwise
     */   
    int write ( uint8_t value );
-   
+
+   /*!
+    @method
+    @abstract   Write a sequence of values to the device.
+    @discussion Writes each value in turn to the device, as write(value) does,
+    but in as few I2C transactions as the Wire buffer allows: the PCF8574
+    updates its port on every byte it receives, so one transaction can carry
+    many port changes. Each value is masked with the direction of the pins.
+
+    @param      values[in] values to be written to the device, in order.
+    @param      count[in] number of values.
+    @result     1 on success, 0 otherwise
+    */
+   int write ( const uint8_t *values, uint8_t count );
+
    /*!
     @method
     @abstract   Writes a digital level to a particular pin.
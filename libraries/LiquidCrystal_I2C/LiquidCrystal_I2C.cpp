@@ -33,6 +33,8 @@
 #include <Arduino.h>
 #endif
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 #include "I2CIO.h"
 #include "LiquidCrystal_I2C.h"
 
@@ -90,6 +92,14 @@
 #define D6 2
 #define D7 3
 
+/*!
+ @defined 
+ @abstract   Size of the LCD display RAM
+ @discussion 80 characters, 2 lines of 40 or 1 of 80, whatever the size of
+ the display. The shadow keeps a copy of all of it.
+ */
+#define DDRAM_SIZE 80
+
 
 // CONSTRUCTORS
 // ---------------------------------------------------------------------------
@@ -185,6 +195,58 @@ void LiquidCrystal_I2C::setBacklight( uint8_t value )
    }
 }
 
+//
+// write - a string, queued and sent together
+#if (ARDUINO <  100)
+void LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size)
+#else
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size)
+#endif
+{
+   _batch++;
+   for ( size_t i = 0; i < size; i++ )
+   {
+      send ( buffer[i], DATA );
+   }
+   _batch--;
+   if ( _batch == 0 )
+   {
+      sendQueue ( );
+   }
+#if (ARDUINO >= 100)
+   return ( size );
+#endif
+}
+
+//
+// shadow
+int LiquidCrystal_I2C::shadow ( void )
+{
+   if ( _shadow == NULL )
+   {
+      _shadow = (uint8_t *)malloc ( DDRAM_SIZE );
+      if ( _shadow == NULL )
+      {
+         return ( 0 );
+      }
+   }
+   clear ( );  // The shadow now knows what the LCD shows
+   return ( 1 );
+}
+
+//
+// noShadow
+void LiquidCrystal_I2C::noShadow ( void )
+{
+   if ( _shadow != NULL )
+   {
+      shadowSync ( );
+      sendQueue ( );
+      free ( _shadow );
+      _shadow = NULL;
+   }
+}
+
 
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
@@ -228,6 +290,13 @@ void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_
    _data_pins[1] = ( 1 << d5 );
    _data_pins[2] = ( 1 << d6 );
    _data_pins[3] = ( 1 << d7 );   
+   
+   _queued = 0;
+   _batch = 0;
+   _shadow = NULL;
+   _cursor = 0;
+   _lcdAddr = 0xFF;
+   _entryMode = LCD_ENTRYMODESET | LCD_ENTRYLEFT;
 }
 
 
@@ -238,10 +307,28 @@ void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_
 //
 // send - write either command or data
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) 
+{
+   if ( ( _shadow == NULL ) || ( mode == FOUR_BITS ) || 
+        shadowSend ( value, mode ) )
+   {
+      transfer ( value, mode );
+   }
+   
+   // Unless part of a string, the queue goes as one transaction now
+   if ( _batch == 0 )
+   {
+      sendQueue ( );
+   }
+}
+
+//
+// transfer
+void LiquidCrystal_I2C::transfer(uint8_t value, uint8_t mode) 
 {
    // No need to use the delay routines since the time taken to write takes
    // longer that what is needed both for toggling and enable pin an to execute
-   // the command.
+   // the command. That holds for writes queued in one transaction too: at
+   // 100kHz each byte takes 90us, and each nibble 2 bytes.
    
    if ( mode == FOUR_BITS )
    {
@@ -286,6 +373,176 @@ void LiquidCrystal_I2C::write4bits ( uint8_t value, uint8_t mode )
 // pulseEnable
 void LiquidCrystal_I2C::pulseEnable (uint8_t data)
 {
-   _i2cio.write (data | _En);   // En HIGH
-   _i2cio.write (data & ~_En);  // En LOW
-}
\ No newline at end of file
+   if ( _queued > LCD_I2C_QUEUE - 2 )
+   {
+      sendQueue ( );
+   }
+   _queue[_queued++] = data | _En;   // En HIGH
+   _queue[_queued++] = data & ~_En;  // En LOW
+}
+
+//
+// sendQueue
+void LiquidCrystal_I2C::sendQueue ()
+{
+   if ( _queued > 0 )
+   {
+      _i2cio.write ( _queue, _queued );
+      _queued = 0;
+   }
+}
+
+// Shadow of the display RAM
+//----------------------------------------------------------------------------
+
+//
+// shadowSend
+bool LiquidCrystal_I2C::shadowSend(uint8_t value, uint8_t mode)
+{
+   bool lazy;
+   
+   if ( mode == COMMAND )
+   {
+      // Decode the command from its highest bit set
+      if ( value & LCD_SETDDRAMADDR )
+      {
+         _cursor = value & 0x7F;        // Sent when a character needs it
+      }
+      else if ( value & LCD_SETCGRAMADDR )
+      {
+         _cursor = 0xFF;
+         _lcdAddr = 0xFF;
+         transfer ( value, COMMAND );
+      }
+      else if ( value & LCD_FUNCTIONSET )
+      {
+         transfer ( value, COMMAND );
+      }
+      else if ( value & LCD_CURSORSHIFT )
+      {
+         if ( ( value & LCD_DISPLAYMOVE ) || ( _cursor == 0xFF ) )
+         {
+            transfer ( value, COMMAND );
+         }
+         else                           // Sent when a character needs it
+         {
+            _cursor = shadowNext ( _cursor, value & LCD_MOVERIGHT );
+         }
+      }
+      else if ( value & LCD_DISPLAYCONTROL )
+      {
+         transfer ( value, COMMAND );
+      }
+      else if ( value & LCD_ENTRYMODESET )
+      {
+         _entryMode = value;
+         transfer ( value, COMMAND );
+      }
+      else if ( value & ( LCD_RETURNHOME | LCD_CLEARDISPLAY ) )
+      {
+         // Home and clear both move to 0, clear also sets the entry mode to
+         // increment and fills the display RAM with spaces
+         if ( value == LCD_CLEARDISPLAY )
+         {
+            memset ( _shadow, ' ', DDRAM_SIZE );
+            _entryMode |= LCD_ENTRYLEFT;
+         }
+         _cursor = 0;
+         _lcdAddr = 0;
+         transfer ( value, COMMAND );
+      }
+   }
+   
+   // Only skip what can't be seen: not with a cursor, not when every
+   // character written shifts the display
+   lazy = !( _displaycontrol & ( LCD_CURSORON | LCD_BLINKON ) ) && 
+          !( _entryMode & LCD_ENTRYSHIFTINCREMENT );
+   
+   if ( mode == COMMAND )
+   {
+      if ( !lazy )
+      {
+         shadowSync ( );
+      }
+      return ( false );
+   }
+   
+   // Characters written to CGRAM aren't shadowed
+   if ( _cursor == 0xFF )
+   {
+      return ( true );
+   }
+   
+   uint8_t addr = _cursor;
+   uint8_t index = shadowIndex ( addr );
+   
+   _cursor = shadowNext ( addr, _entryMode & LCD_ENTRYLEFT );
+   if ( lazy && ( index != 0xFF ) && ( _shadow[index] == value ) )
+   {
+      return ( false );                 // The LCD shows it already
+   }
+   if ( _lcdAddr != addr )
+   {
+      transfer ( LCD_SETDDRAMADDR | addr, COMMAND );
+   }
+   if ( index != 0xFF )
+   {
+      _shadow[index] = value;
+      _lcdAddr = _cursor;
+   }
+   else
+   {
+      _lcdAddr = 0xFF;                  // Not an address the LCD has
+   }
+   return ( true );
+}
+
+//
+// shadowIndex
+uint8_t LiquidCrystal_I2C::shadowIndex(uint8_t addr)
+{
+   // 2 lines of 40 at 0x00 and 0x40, or 1 line of 80 at 0x00
+   if ( _displayfunction & LCD_2LINE )
+   {
+      if ( ( addr & 0x3F ) >= DDRAM_SIZE / 2 )
+      {
+         return ( 0xFF );
+      }
+      return ( ( addr & 0x40 ) ? ( addr & 0x3F ) + DDRAM_SIZE / 2 : addr );
+   }
+   return ( ( addr < DDRAM_SIZE ) ? addr : 0xFF );
+}
+
+//
+// shadowNext
+uint8_t LiquidCrystal_I2C::shadowNext(uint8_t addr, bool right)
+{
+   // The LCD wraps from the end of each line to the start of the next, and
+   // from the last line to the first
+   if ( _displayfunction & LCD_2LINE )
+   {
+      if ( right )
+      {
+         return ( ( addr == 0x27 ) ? 0x40 : ( addr == 0x67 ) ? 0x00 : 
+                  ( addr + 1 ) & 0x7F );
+      }
+      return ( ( addr == 0x40 ) ? 0x27 : ( addr == 0x00 ) ? 0x67 : 
+               ( addr - 1 ) & 0x7F );
+   }
+   if ( right )
+   {
+      return ( ( addr >= DDRAM_SIZE - 1 ) ? 0x00 : addr + 1 );
+   }
+   return ( ( addr == 0x00 ) ? DDRAM_SIZE - 1 : addr - 1 );
+}
+
+//
+// shadowSync
+void LiquidCrystal_I2C::shadowSync()
+{
+   if ( ( _cursor != 0xFF ) && ( _cursor != _lcdAddr ) )
+   {
+      transfer ( LCD_SETDDRAMADDR | _cursor, COMMAND );
+      _lcdAddr = _cursor;
+   }
+}
@@ -34,6 +34,19 @@
 #include "I2CIO.h"
 #include "LCD.h"
 
+/*!
+ @defined 
+ @abstract   Bytes of IO expander writes queued before they are sent.
+ @discussion Writes to the IO expander are queued and sent together, in one
+ I2C transaction, at the end of each command or character, or of a whole
+ string when printing one. Every character takes 4 (E high and E low for
+ each nibble). 32 is the Wire buffer on AVR, I2CIO splits the queue if its
+ platform has a smaller one.
+ */
+#ifndef LCD_I2C_QUEUE
+#define LCD_I2C_QUEUE 32
+#endif
+
 
 class LiquidCrystal_I2C : public LCD 
 {
@@ -144,6 +157,54 @@ public:
     */
    void setBacklight ( uint8_t value );
    
+   /*!
+    @function
+    @abstract   Writes a string of characters to the LCD.
+    @discussion Writes the characters from the current cursor position, as
+    writing them one by one would, but sends them to the IO expander in as
+    few I2C transactions as the queue allows (8 characters in each with the
+    default LCD_I2C_QUEUE). All Print class methods printing strings and
+    numbers end up calling this method.
+    
+    @param      buffer[in] characters to write.
+    @param      size[in] number of characters.
+    */
+#if (ARDUINO <  100)
+   virtual void write(const uint8_t *buffer, size_t size);
+#else
+   virtual size_t write(const uint8_t *buffer, size_t size);
+#endif
+   using LCD::write;
+   
+   /*!
+    @function
+    @abstract   Keep a copy of the display's text and only send what changes.
+    @discussion Allocates a shadow of the LCD's display RAM (80 bytes) and
+    clears the display. From then on, writing a character to a cell that
+    already shows it sends nothing, and setCursor, moveCursorLeft and
+    moveCursorRight only send a command when a character actually has to be
+    written somewhere other than where the LCD's address counter already is.
+    Sketches that redraw the whole screen in every loop then only cost the
+    cells that changed. To get the most from it, overwrite old text with new
+    (padding with spaces) rather than calling clear, which still clears the
+    LCD itself.
+    
+    While the cursor or blinking is on, or autoscroll is enabled, every
+    write is sent, so the LCD looks exactly as it would without the shadow.
+    Characters written to CGRAM (createChar) are never shadowed.
+    
+    @result     1 if the shadow could be allocated, 0 otherwise.
+    */
+   int shadow ( void );
+   
+   /*!
+    @function
+    @abstract   Stop keeping a copy of the display's text.
+    @discussion Moves the LCD's cursor where it should be and releases the
+    shadow allocated by shadow. Every write is sent again from then on.
+    */
+   void noShadow ( void );
+   
 private:
    
    /*!
@@ -189,6 +250,60 @@ private:
     */
    void pulseEnable(uint8_t);
    
+   /*!
+    @method     
+    @abstract   Writes a value to the LCD, command or data, now.
+    @discussion Queues the nibbles of value, bypassing the shadow.
+    @param      value[in] Value to write to the LCD
+    @param      mode[in]  COMMAND, DATA or FOUR_BITS.
+    */
+   void transfer(uint8_t value, uint8_t mode);
+   
+   /*!
+    @method     
+    @abstract   Sends what has been queued for the IO expander.
+    @discussion Sends the queue in one I2C transaction, if the Wire buffer
+    allows, and empties it.
+    */
+   void sendQueue();
+   
+   /*!
+    @method     
+    @abstract   Keeps the shadow of the display up to date.
+    @discussion Follows a command or character on its way to the LCD,
+    updating the shadow and the address counter of the LCD, and sends the
+    command positioning the LCD if the character needs it.
+    @param      value[in] Value to write to the LCD
+    @param      mode[in]  COMMAND or DATA.
+    @result     true if value has to be sent, false if the LCD already
+    shows it or it only moves the cursor.
+    */
+   bool shadowSend(uint8_t value, uint8_t mode);
+   
+   /*!
+    @method     
+    @abstract   Index of a display RAM address in the shadow.
+    @param      addr[in] display RAM address.
+    @result     the index, 0xFF if the display has no such address.
+    */
+   uint8_t shadowIndex(uint8_t addr);
+   
+   /*!
+    @method     
+    @abstract   The display RAM address next to addr.
+    @param      addr[in] display RAM address.
+    @param      right[in] true for the next address, false for the previous.
+    @result     the address the LCD moves to from addr.
+    */
+   uint8_t shadowNext(uint8_t addr, bool right);
+   
+   /*!
+    @method     
+    @abstract   Moves the LCD's address counter to where the cursor should
+    be, if it isn't there already.
+    */
+   void shadowSync();
+   
    
    uint8_t _Addr;             // I2C Address of the IO expander
    uint8_t _backlightPinMask; // Backlight IO pin mask
@@ -198,6 +313,15 @@ private:
    uint8_t _Rw;               // LCD expander word for R/W pin
    uint8_t _Rs;               // LCD expander word for Register Select pin
    uint8_t _data_pins[4];     // LCD data lines
+   uint8_t _queue[LCD_I2C_QUEUE]; // IO expander writes not yet sent
+   uint8_t _queued;           // Number of writes queued
+   uint8_t _batch;            // Nesting of writes sent together
+   uint8_t *_shadow;          // Display RAM as the LCD has it, NULL if none
+   uint8_t _cursor;           // Display RAM address the cursor should be at,
+                              // 0xFF while writing to CGRAM
+   uint8_t _lcdAddr;          // Display RAM address the LCD is at, 0xFF if
+                              // unknown or in CGRAM
+   uint8_t _entryMode;        // Entry mode the LCD was last given
    
 };
 
@@ -0,0 +1,28 @@
+// ---------------------------------------------------------------------------
+// @file Arduino.h
+// Just enough of the Arduino core for LCD and LiquidCrystal_I2C to build on
+// a desktop machine, for the tests in extras/host. See extras/host/README.md.
+// Nothing here is used when building for a board.
+// ---------------------------------------------------------------------------
+#ifndef _LCD_HOST_ARDUINO_H_
+#define _LCD_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+// The LCD is a model that is always ready, so there's nothing to wait for
+inline void delay ( unsigned long ) { }
+inline void delayMicroseconds ( unsigned int ) { }
+
+#include "Print.h"
+
+#endif // _LCD_HOST_ARDUINO_H_
@@ -0,0 +1,33 @@
+// ---------------------------------------------------------------------------
+// @file Print.h
+// The parts of the Arduino Print class the tests in extras/host print with.
+// ---------------------------------------------------------------------------
+#ifndef _LCD_HOST_PRINT_H_
+#define _LCD_HOST_PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class Print
+{
+public:
+   virtual ~Print ( ) { }
+   virtual size_t write ( uint8_t ) = 0;
+   virtual size_t write ( const uint8_t *buffer, size_t size )
+   {
+      size_t n = 0;
+      while ( size-- )
+      {
+         n += write ( *buffer++ );
+      }
+      return ( n );
+   }
+   size_t write ( const char *str )
+   {
+      return ( write ( (const uint8_t *)str, strlen ( str ) ) );
+   }
+   size_t print ( const char *str ) { return ( write ( str ) ); }
+};
+
+#endif // _LCD_HOST_PRINT_H_
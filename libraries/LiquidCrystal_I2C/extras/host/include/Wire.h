@@ -0,0 +1,30 @@
+// ---------------------------------------------------------------------------
+// @file Wire.h
+// A Wire stand-in for the host build: the bytes of every transaction go to
+// the PCF8574 and HD44780 model in mock_lcd.h instead of a bus.
+// ---------------------------------------------------------------------------
+#ifndef _LCD_HOST_WIRE_H_
+#define _LCD_HOST_WIRE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// As on AVR, the most bytes one transaction can take
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+class TwoWire
+{
+public:
+   void begin ( ) { }
+   void beginTransmission ( uint8_t address );
+   size_t write ( uint8_t value );
+   uint8_t endTransmission ( );
+   uint8_t requestFrom ( uint8_t address, uint8_t count );
+   int read ( );
+};
+
+extern TwoWire Wire;
+
+#endif // _LCD_HOST_WIRE_H_
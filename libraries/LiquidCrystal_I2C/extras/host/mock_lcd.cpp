@@ -0,0 +1,219 @@
+// ---------------------------------------------------------------------------
+// @file mock_lcd.cpp
+// The HD44780 model of mock_lcd.h, and the Wire stand-in that feeds it.
+// ---------------------------------------------------------------------------
+#include <Wire.h>
+#include "mock_lcd.h"
+
+#define PCF_EN 0x40
+#define PCF_RS 0x10
+
+TwoWire Wire;
+MockLCD *mockLCD = NULL;
+
+//
+// reset
+void MockLCD::reset ( )
+{
+   memset ( ddram, ' ', sizeof ( ddram ) );
+   memset ( cgram, 0, sizeof ( cgram ) );
+   ac = 0;
+   cg = false;
+   fourBits = false;
+   twoLines = false;
+   entryMode = 0x02;
+   control = 0;
+   shift = 0;
+   transactions = 0;
+   bytes = 0;
+   longest = 0;
+   _port = 0;
+   _high = true;
+   _nibble = 0;
+   _inTransaction = 0;
+}
+
+//
+// port
+void MockLCD::port ( uint8_t value )
+{
+   if ( ( _port & PCF_EN ) && !( value & PCF_EN ) )
+   {
+      nibble ( value & PCF_RS, value & 0x0F );
+   }
+   _port = value;
+}
+
+//
+// nibble
+void MockLCD::nibble ( bool rs, uint8_t value )
+{
+   if ( !fourBits )
+   {
+      // D0-D3 aren't wired, so they read as 0
+      execute ( rs, value << 4 );
+      _high = true;
+   }
+   else if ( _high )
+   {
+      _nibble = value;
+      _high = false;
+   }
+   else
+   {
+      execute ( rs, ( _nibble << 4 ) | value );
+      _high = true;
+   }
+}
+
+//
+// same
+bool MockLCD::same ( const MockLCD &other, bool cursor ) const
+{
+   int width = twoLines ? 40 : 80;
+
+   return ( ( memcmp ( ddram, other.ddram, sizeof ( ddram ) ) == 0 ) &&
+            ( memcmp ( cgram, other.cgram, sizeof ( cgram ) ) == 0 ) &&
+            ( twoLines == other.twoLines ) &&
+            ( entryMode == other.entryMode ) &&
+            ( control == other.control ) &&
+            ( ( ( shift - other.shift ) % width ) == 0 ) &&
+            ( !cursor || ( ( ac == other.ac ) && ( cg == other.cg ) ) ) );
+}
+
+//
+// execute
+void MockLCD::execute ( bool rs, uint8_t value )
+{
+   bool right = entryMode & 0x02;
+
+   if ( rs )
+   {
+      if ( cg )
+      {
+         cgram[ac] = value;
+         ac = ( ac + ( right ? 1 : -1 ) ) & 0x3F;
+      }
+      else
+      {
+         ddram[ac] = value;
+         ac = next ( ac, right );
+         if ( entryMode & 0x01 )
+         {
+            shift += right ? -1 : 1;
+         }
+      }
+   }
+   else if ( value & 0x80 )            // Set DDRAM address
+   {
+      ac = value & 0x7F;
+      cg = false;
+   }
+   else if ( value & 0x40 )            // Set CGRAM address
+   {
+      ac = value & 0x3F;
+      cg = true;
+   }
+   else if ( value & 0x20 )            // Function set
+   {
+      fourBits = !( value & 0x10 );
+      if ( fourBits )
+      {
+         twoLines = value & 0x08;
+      }
+   }
+   else if ( value & 0x10 )            // Cursor or display shift
+   {
+      if ( value & 0x08 )
+      {
+         shift += ( value & 0x04 ) ? 1 : -1;
+      }
+      else if ( cg )
+      {
+         ac = ( ac + ( ( value & 0x04 ) ? 1 : -1 ) ) & 0x3F;
+      }
+      else
+      {
+         ac = next ( ac, value & 0x04 );
+      }
+   }
+   else if ( value & 0x08 )            // Display control
+   {
+      control = value & 0x07;
+   }
+   else if ( value & 0x04 )            // Entry mode set
+   {
+      entryMode = value & 0x03;
+   }
+   else if ( value & 0x02 )            // Return home
+   {
+      ac = 0;
+      cg = false;
+      shift = 0;
+   }
+   else if ( value & 0x01 )            // Clear display
+   {
+      memset ( ddram, ' ', sizeof ( ddram ) );
+      ac = 0;
+      cg = false;
+      shift = 0;
+      entryMode |= 0x02;
+   }
+}
+
+//
+// next
+uint8_t MockLCD::next ( uint8_t addr, bool right ) const
+{
+   if ( twoLines )
+   {
+      if ( right )
+      {
+         return ( ( addr == 0x27 ) ? 0x40 : ( addr == 0x67 ) ? 0x00 :
+                  ( addr + 1 ) & 0x7F );
+      }
+      return ( ( addr == 0x40 ) ? 0x27 : ( addr == 0x00 ) ? 0x67 :
+               ( addr - 1 ) & 0x7F );
+   }
+   if ( right )
+   {
+      return ( ( addr >= 0x4F ) ? 0x00 : addr + 1 );
+   }
+   return ( ( addr == 0x00 ) ? 0x4F : addr - 1 );
+}
+
+// The Wire stand-in
+//----------------------------------------------------------------------------
+
+void TwoWire::beginTransmission ( uint8_t )
+{
+   mockLCD->_inTransaction = 0;
+}
+
+size_t TwoWire::write ( uint8_t value )
+{
+   mockLCD->port ( value );
+   mockLCD->bytes++;
+   mockLCD->_inTransaction++;
+   return ( 1 );
+}
+
+uint8_t TwoWire::endTransmission ( )
+{
+   mockLCD->transactions++;
+   if ( mockLCD->_inTransaction > mockLCD->longest )
+   {
+      mockLCD->longest = mockLCD->_inTransaction;
+   }
+   return ( 0 );
+}
+
+uint8_t TwoWire::requestFrom ( uint8_t, uint8_t count )
+{
+   return ( count );
+}
+
+int TwoWire::read ( )
+{
+   return ( 0 );
+}
@@ -0,0 +1,61 @@
+// ---------------------------------------------------------------------------
+// @file mock_lcd.h
+// A model of an HD44780 LCD, driven either through a PCF8574 backpack wired
+// as LiquidCrystal_I2C's defaults (D4-D7 on P0-P3, RS on P4, EN on P6) or a
+// nibble at a time. It keeps what a real LCD keeps (display and character
+// RAM, address counter, entry mode, display control and shift) so tests
+// can compare two ways of driving it, and counts the I2C traffic.
+// ---------------------------------------------------------------------------
+#ifndef _MOCK_LCD_H_
+#define _MOCK_LCD_H_
+
+#include <stdint.h>
+#include <string.h>
+
+class MockLCD
+{
+public:
+   MockLCD ( ) { reset ( ); }
+
+   // Power on: 8 bit mode, one line, blank display
+   void reset ( );
+
+   // The PCF8574 port is set to value; a falling EN clocks a nibble in
+   void port ( uint8_t value );
+
+   // A nibble clocked in with RS set (data) or clear (command)
+   void nibble ( bool rs, uint8_t value );
+
+   // Does the LCD look and behave the same? With cursor, the address
+   // counter is compared too, as it shows.
+   bool same ( const MockLCD &other, bool cursor ) const;
+
+   uint8_t ddram[128];  // Display RAM, by address
+   uint8_t cgram[64];   // Character generator RAM
+   uint8_t ac;          // Address counter
+   bool cg;             // ac addresses CGRAM rather than DDRAM
+   bool fourBits;       // Interface is 4 bits wide
+   bool twoLines;       // Two lines of 40 rather than one of 80
+   uint8_t entryMode;   // Last entry mode set command, low 2 bits
+   uint8_t control;     // Last display control command, low 3 bits
+   int shift;           // Net display shifts to the right, mod 40 or 80
+
+   long transactions;   // I2C transactions seen
+   long bytes;          // Bytes written in them
+   int longest;         // Most bytes in one transaction
+
+private:
+   void execute ( bool rs, uint8_t value );
+   uint8_t next ( uint8_t addr, bool right ) const;
+
+   uint8_t _port;       // Last PCF8574 output
+   bool _high;          // The next nibble is the high one
+   uint8_t _nibble;     // High nibble received
+   int _inTransaction;  // Bytes in the current transaction
+   friend class TwoWire;
+};
+
+// The model the next Wire transaction goes to
+extern MockLCD *mockLCD;
+
+#endif // _MOCK_LCD_H_
@@ -0,0 +1,261 @@
+// ---------------------------------------------------------------------------
+// @file lcd_model.cpp
+// Checks that LiquidCrystal_I2C's queued expander writes and shadow() leave
+// an LCD just as sending each byte straight to it does. A random mix of LCD
+// calls goes to LiquidCrystal_I2C, through Wire and the PCF8574 model, and
+// to a reference LCD whose send() clocks the nibbles into a second model
+// directly, as the unqueued code did over one transaction per pulse. After
+// every call the two have to look the same, on 20x4, 16x4, 16x2 and 16x1
+// displays, with and without the shadow.
+//
+// Then it counts the transactions to redraw a 20x4 screen a line at a time
+// with setCursor() and print().
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+#include "mock_lcd.h"
+
+static uint32_t seed = 1;
+
+static long rnd ( long howbig )
+{
+   seed = seed * 1103515245UL + 12345UL;
+   return ( ( seed >> 8 ) % howbig );
+}
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what, int n )
+{
+   if ( !ok )
+   {
+      if ( failures < 20 )
+      {
+         printf ( "%s, case %d\n", what, n );
+      }
+      failures++;
+   }
+}
+
+// An LCD that hands each nibble to a model, no expander and no queue
+class DirectLCD : public LCD
+{
+public:
+   DirectLCD ( MockLCD &model ) : nibbles ( 0 ), _model ( model ) { }
+
+   void begin ( uint8_t cols, uint8_t lines, uint8_t dotsize = LCD_5x8DOTS )
+   {
+      _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+      LCD::begin ( cols, lines, dotsize );
+   }
+
+   void send ( uint8_t value, uint8_t mode )
+   {
+      if ( mode == FOUR_BITS )
+      {
+         _model.nibble ( false, value & 0x0F );
+         nibbles++;
+      }
+      else
+      {
+         _model.nibble ( mode == DATA, value >> 4 );
+         _model.nibble ( mode == DATA, value & 0x0F );
+         nibbles += 2;
+      }
+   }
+
+   long nibbles;   // Each was two transactions before writes were queued
+
+private:
+   MockLCD &_model;
+};
+
+// One random LCD call, the same for both LCDs from the same seed
+static void step ( LCD &lcd, uint8_t cols, uint8_t rows )
+{
+   char text[16];
+   uint8_t charmap[8];
+   int op = rnd ( 20 );
+
+   if ( op < 7 )
+   {
+      lcd.setCursor ( rnd ( cols ), rnd ( rows ) );
+   }
+   else if ( op < 13 )
+   {
+      // Few letters, so the shadow often has them already
+      int n = rnd ( 12 );
+      for ( int i = 0; i < n; i++ )
+      {
+         text[i] = 'A' + rnd ( 3 );
+      }
+      text[n] = 0;
+      lcd.print ( text );
+   }
+   else if ( op == 13 )
+   {
+      lcd.write ( (uint8_t)( 'A' + rnd ( 3 ) ) );
+   }
+   else if ( op == 14 )
+   {
+      if ( rnd ( 4 ) == 0 )
+      {
+         lcd.clear ( );
+      }
+      else
+      {
+         lcd.home ( );
+      }
+   }
+   else if ( op == 15 )
+   {
+      if ( rnd ( 2 ) )
+      {
+         lcd.moveCursorLeft ( );
+      }
+      else
+      {
+         lcd.moveCursorRight ( );
+      }
+   }
+   else if ( op == 16 )
+   {
+      switch ( rnd ( 10 ) )
+      {
+         case 0: lcd.rightToLeft ( ); break;
+         case 1: case 2: lcd.leftToRight ( ); break;
+         case 3: lcd.cursor ( ); break;
+         case 4: case 5: lcd.noCursor ( ); break;
+         case 6: lcd.blink ( ); break;
+         case 7: lcd.noBlink ( ); break;
+         case 8: lcd.autoscroll ( ); break;
+         default: lcd.noAutoscroll ( ); break;
+      }
+   }
+   else if ( op == 17 )
+   {
+      for ( int i = 0; i < 8; i++ )
+      {
+         charmap[i] = rnd ( 32 );
+      }
+      lcd.createChar ( rnd ( 8 ), charmap );
+   }
+   else if ( op == 18 )
+   {
+      if ( rnd ( 2 ) )
+      {
+         lcd.scrollDisplayLeft ( );
+      }
+      else
+      {
+         lcd.scrollDisplayRight ( );
+      }
+   }
+   else
+   {
+      // The end of the screen, and lines written past it
+      lcd.setCursor ( cols - 1 - rnd ( 2 ), rnd ( rows ) );
+      lcd.print ( "ABCDEFGHIJKLMNOPQRSTUVWXYZ" + rnd ( 20 ) );
+   }
+}
+
+static void compare ( uint8_t cols, uint8_t rows, bool useShadow, int n )
+{
+   MockLCD viaI2C, direct;
+   LiquidCrystal_I2C lcd ( 0x27 );
+   DirectLCD reference ( direct );
+
+   mockLCD = &viaI2C;
+   lcd.begin ( cols, rows );
+   reference.begin ( cols, rows );
+   if ( useShadow )
+   {
+      check ( lcd.shadow ( ) == 1, "shadow() failed", n );
+      reference.clear ( );
+   }
+   check ( viaI2C.same ( direct, true ), "different after begin()", n );
+
+   for ( int i = 0; i < 3000; i++ )
+   {
+      uint32_t s = seed;
+      step ( lcd, cols, rows );
+      seed = s;
+      step ( reference, cols, rows );
+      // The cursor shows where the address counter is, so it has to match
+      // then; otherwise the shadow can leave moving it for later
+      if ( !viaI2C.same ( direct, direct.control & 0x03 ) )
+      {
+         check ( false, "LCD differs", n * 10000 + i );
+         return;
+      }
+   }
+   lcd.noShadow ( );
+   check ( viaI2C.same ( direct, true ), "address differs after noShadow()",
+           n );
+   check ( viaI2C.longest <= BUFFER_LENGTH, "transaction too long", n );
+}
+
+// Transactions per 20x4 screen, the value in line 0 changing each time
+static double redraw ( bool useShadow, long *before )
+{
+   MockLCD viaI2C, direct;
+   LiquidCrystal_I2C lcd ( 0x27 );
+   DirectLCD reference ( direct );
+   char line[24];
+
+   mockLCD = &viaI2C;
+   lcd.begin ( 20, 4 );
+   reference.begin ( 20, 4 );
+   if ( useShadow )
+   {
+      lcd.shadow ( );
+   }
+   viaI2C.transactions = 0;
+   reference.nibbles = 0;
+   for ( int frame = 0; frame < 100; frame++ )
+   {
+      for ( int row = 0; row < 4; row++ )
+      {
+         snprintf ( line, sizeof ( line ), "Line %d %13d", row,
+                    row ? row * 1111 : frame );
+         lcd.setCursor ( 0, row );
+         lcd.print ( line );
+         reference.setCursor ( 0, row );
+         reference.print ( line );
+      }
+   }
+   check ( viaI2C.same ( direct, false ), "redraw differs", useShadow );
+   *before = reference.nibbles * 2 / 100;
+   return ( viaI2C.transactions / 100.0 );
+}
+
+int main ( )
+{
+   static const uint8_t sizes[][2] = { { 20, 4 }, { 16, 4 }, { 16, 2 },
+                                        { 16, 1 } };
+   int n = 0;
+   long before;
+
+   for ( int i = 0; i < 4; i++ )
+   {
+      for ( int useShadow = 0; useShadow < 2; useShadow++ )
+      {
+         seed = 7 + n;
+         compare ( sizes[i][0], sizes[i][1], useShadow, n++ );
+      }
+   }
+
+   double queued = redraw ( false, &before );
+   double shadowed = redraw ( true, &before );
+   printf ( "20x4 redraw: %ld transactions unqueued, %.1f queued, "
+            "%.1f with shadow()\n", before, queued, shadowed );
+   check ( queued <= 16, "too many transactions queued", 0 );
+   check ( shadowed <= 2, "too many transactions with shadow()", 0 );
+
+   if ( failures )
+   {
+      printf ( "%d cases differ\n", failures );
+   }
+   return ( failures ? 1 : 0 );
+}
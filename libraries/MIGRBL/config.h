@@ -179,6 +179,15 @@
 // we do not recommend keeping this option enabled. Try to only use this for setting up a new CNC.
 // #define REPORT_CONTROL_PIN_STATE // Default disabled. Uncomment to enable.
 
+// Counts where the time goes while a job runs, to tell why it runs slow: how long the stepper ISR,
+// the segment generator and the planner take, on average and at most, how long the protocol waited
+// for room in the planner buffer, how often the segment buffer ran dry with blocks still planned,
+// and how full the serial RX buffer got. '$P' prints them and '$PR' clears them, at any time, and
+// each status report adds ',Perf:' with the most the ISR and the segment generator took, in 
+// microseconds, and the underruns. Times are measured from Timer1, so only while the steppers run.
+// NOTE: Each stepper ISR takes a few microseconds more to count itself.
+// #define PERFORMANCE_COUNTERS // Default disabled. Uncomment to enable.
+
 // When Grbl powers-cycles or is hard reset with the Arduino reset button, Grbl boots up with no ALARM
 // by default. This is to make it as simple as possible for new users to start using Grbl. When homing
 // is enabled and a user has installed limit switches, Grbl will boot up in an ALARM state to indicate 
@@ -203,14 +212,72 @@
 // NOTE: Changing this value also changes the execution time of a segment in the step segment buffer. 
 // When increasing this value, this stores less overall time in the segment buffer and vice versa. Make
 // certain the step segment buffer is increased/decreased to account for these changes.
-#define ACCELERATION_TICKS_PER_SECOND 100 
+#ifndef ACCELERATION_TICKS_PER_SECOND
+  #define ACCELERATION_TICKS_PER_SECOND 100 
+#endif
+
+// Replaces the constant-acceleration (trapezoid) velocity profiles with jerk-limited (S-curve) ones.
+// With trapezoids, the acceleration steps straight to the $120-$122 values at every ramp start and
+// end, which rings the machine frame. Here the acceleration rises and falls no faster than the
+// $140-$142 max jerk settings allow, so a machine can often run a higher acceleration setting. Ramps
+// run through the junctions of short line segments, but each takes longer at the same acceleration.
+// A max jerk of 0, the default, follows the acceleration setting of the axis, reaching it in
+// JERK_RAMP_TIME. Set $140-$142 only to tune an axis beyond that.
+// NOTE: Adds the max jerk settings to the EEPROM data, which resets all Grbl settings to defaults
+// when this option is first enabled or disabled. Costs flash, and the segment generator works out
+// a new profile for most blocks: counted in the simulator and priced at avr-libc's float timings,
+// about 8 ms each on a 16MHz 328p. Programs of short segments much over 100 blocks a second, such
+// as extras/sim/gcode/circle.nc at 125, will outrun it there.
+// #define JERK_LIMITED_ACCELERATION // Default disabled. Uncomment to enable.
+
+// Time to reach the $120-$122 acceleration from none, for an axis whose max jerk setting is 0. Ramps
+// take about this much longer than trapezoids do.
+#ifndef JERK_RAMP_TIME
+  #define JERK_RAMP_TIME 0.02 // sec
+#endif
+
+// Input shaping. Every start, stop and change of acceleration kicks the machine frame, which then
+// rings at its resonant frequency and leaves ripples in the part. The segment generator can instead
+// split each change into a few impulses, timed so the ringing of one cancels that of the others: ZV
+// (2 impulses, half a period apart), ZVD (3, more tolerant of a wrong frequency) or MZV (3, shorter
+// than ZVD). Set the frequency of each axis in $150-$152 (Hz, 0 for none), its damping ratio in
+// $160-$162 and the shaper type in $170-$172 (0 ZV, 1 ZVD, 2 MZV). Measure the frequency from the
+// ripples: their spacing in mm over the feed rate in mm/sec is the period.
+// NOTE: Grbl steps all axes of a block together, so one shaper, made up of those of all axes, is
+// applied to the speed along the path. It lags the planned motion by up to a period or so, and a
+// run of short blocks that would get through INPUT_SHAPER_BLOCKS-3 of them before the shaped motion
+// follows is slowed down. That costs throughput on dense paths, more so at low frequencies: with the
+// defaults, a 50 mm circle in 0.2 mm blocks at 3000 mm/min takes 5.8 s unshaped, about as long with
+// shapers of 10 Hz and up, but 8.2 s at 7 Hz and 14.3 s at 5 Hz. Each more INPUT_SHAPER_BLOCKS
+// allows faster runs, for about 29 bytes of RAM. Corners between blocks are not shaped. Adds the
+// shaper settings to the EEPROM data, which resets all Grbl settings to defaults when this option
+// is first enabled or disabled. Costs about 550 bytes of RAM with the default buffer sizes.
+// #define INPUT_SHAPING // Default disabled. Uncomment to enable.
+// #define INPUT_SHAPER_BLOCKS 10 // Stepper blocks held for the shaped motion. Integer (5-255)
+// #define INPUT_SHAPER_HISTORY 16 // Samples of the planned motion kept for shaping. Integer (4-255)
+// #define INPUT_SHAPER_IMPULSES 9 // Impulses of the shaper of all axes at most. Integer (2-27)
+
+// Enables the G64 P<tolerance> path blending mode. CAM programs often describe curves as runs of very
+// short, nearly collinear lines, and each one takes a planner block. The planner then looks ahead
+// only a few millimeters and has to slow down for a stop that isn't there. In G64, mc_line() merges
+// each line into the one before it while every merged end point stays within the P tolerance of the
+// resulting line, so one block covers up to PATH_BLENDING_MAX_LINES of them. G64 without P uses
+// PATH_BLENDING_TOLERANCE, and P must be over zero. G61 and a reset return to exact path mode, where
+// every line is planned.
+// NOTE: The tolerance is in the current units. The path may cut a corner by up to that much.
+// #define PATH_BLENDING // Default disabled. Uncomment to enable.
+#define PATH_BLENDING_TOLERANCE 0.01 // Default G64 tolerance in mm. Float (mm)
+#define PATH_BLENDING_MAX_LINES 8 // Lines merged into one planner block at most. Integer (2-255)
 
 // Adaptive Multi-Axis Step Smoothing (AMASS) is an advanced feature that does what its name implies, 
 // smoothing the stepping of multi-axis motions. This feature smooths motion particularly at low step
 // frequencies below 10kHz, where the aliasing between axes of multi-axis motions can cause audible 
 // noise and shake your machine. At even lower step frequencies, AMASS adapts and provides even better
 // step smoothing. See stepper.c for more details on the AMASS system works.
-#define ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING  // Default enabled. Comment to disable.
+// NOTE: Defining NO_ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING at compile time also disables it.
+#ifndef NO_ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+  #define ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING  // Default enabled. Comment to disable.
+#endif
 
 // Sets the maximum step rate allowed to be written as a Grbl setting. This option enables an error 
 // check in the settings module to prevent settings values that will exceed this limitation. The maximum
@@ -300,6 +367,20 @@
 // bogged down by too many trig calculations. 
 #define N_ARC_CORRECTION 12 // Integer (1-255)
 
+// Plans each G2/G3 arc as a single planner block, instead of the many short lines mc_arc() cuts it
+// into by the $12 arc tolerance. The segment generator finds the point of the arc each step segment
+// ends at, by the same small angle rotation and N_ARC_CORRECTION corrections, and steps the chord to
+// it. An arc then takes one block, not hundreds, and its speed is limited by the acceleration it
+// takes to turn, not by the junction deviation between its lines.
+// NOTE: Adds about 17 bytes of RAM to each planner block. Reduce BLOCK_BUFFER_SIZE in planner.h if
+// needed. Arcs now take one block each, so fewer are needed. Not for COREXY.
+// #define ARC_BLOCKS // Default disabled. Uncomment to enable.
+
+// Share of the acceleration an arc block may use to turn at its nominal speed. The feed rate of a
+// tight arc is lowered to keep within it. What is left, sqrt(1-share^2) or more, changes speed along
+// the arc. ARC_BLOCKS only.
+#define ARC_CENTRIPETAL_SHARE 0.8 // Float (0.0-1.0)
+
 // The arc G2/3 g-code standard is problematic by definition. Radius-based arcs have horrible numerical 
 // errors when arc at semi-circles(pi) or full-circles(2*pi). Offset-based arcs are much more accurate 
 // but still have a problem when arcs are full-circles (2*pi). This define accounts for the floating 
@@ -373,6 +454,31 @@
 // case, please report any successes to grbl administrators!
 // #define ENABLE_XONXOFF // Default disabled. Uncomment to enable.
 
+// Enables the binary stream, as an alternative to lines of g-code text. A host opens it with a frame
+// and then sends G0/G1 moves already parsed into floats, and any other line as text, each in a frame
+// with a sequence number and a CRC. Grbl answers each frame as it executes it, with the free planner
+// blocks, and asks for it again from the first one lost or damaged. The host keeps as many frames 
+// in flight as fit in the RX buffer, so the planner stays full without waiting for each answer, and
+// Grbl skips the parsing of moves. See stream.h for the frames and extras/stream_binary.py for a host.
+// NOTE: The realtime command characters still work between frames, not inside them.
+// #define BINARY_STREAMING // Default disabled. Uncomment to enable.
+
+// Raster engraving: a binary stream frame carries a line of a bitmap as one move, with the power of
+// each of its pixels, and the stepper ISR sets the spindle PWM output to each pixel's power as the
+// steps pass it. A scan line then takes a few planner blocks and never stops, where a G1 S.. for
+// each pixel would stop at each one, as S waits for the planner buffer to empty. The power is
+// scaled by the speed along the line, so pixels burn as deep while it speeds up and slows down.
+// Pixels only burn while the spindle is on (M3/M4). After each raster line, the output goes back
+// to what S set, so send S0 for a laser to be off in between. See stream.h and extras/raster.py.
+// Needs BINARY_STREAMING and VARIABLE_SPINDLE.
+// NOTE: RASTER_PWM_OFF and RASTER_PWM_MAX are the PWM output at power 0 and at power 255. They
+// default to the range spindle_set_state() maps S to. For a laser, set them to 0 and 255. Where the
+// spindle enable pin is separate from PWM, as on the Mega2560, S0 turns it off, so use S1 instead.
+// #define RASTER_ENGRAVING // Default disabled. Uncomment to enable.
+// #define RASTER_BUFFER_SIZE 128 // Pixels planned and not yet burned, at most. Integer (80-255)
+// #define RASTER_PWM_OFF 9
+// #define RASTER_PWM_MAX 39
+
 // A simple software debouncing feature for hard limit switches. When enabled, the interrupt 
 // monitoring the hard limit switch pins will enable the Arduino's watchdog timer to re-check 
 // the limit pin state after a delay of about 32msec. This can help with CNC machines with 
@@ -408,6 +514,22 @@
   #error "USE_SPINDLE_DIR_AS_ENABLE_PIN may only be used with a 328p processor"
 #endif
 
+#if defined(BINARY_STREAMING) && defined(ENABLE_XONXOFF)
+  #error "BINARY_STREAMING may not be used with ENABLE_XONXOFF"
+#endif
+
+#if defined(ARC_BLOCKS) && defined(COREXY)
+  #error "ARC_BLOCKS may not be used with COREXY"
+#endif
+
+#if defined(INPUT_SHAPING) && defined(ARC_BLOCKS)
+  #error "INPUT_SHAPING may not be used with ARC_BLOCKS"
+#endif
+
+#if defined(RASTER_ENGRAVING) && !(defined(BINARY_STREAMING) && defined(VARIABLE_SPINDLE))
+  #error "RASTER_ENGRAVING may only be used with BINARY_STREAMING and VARIABLE_SPINDLE enabled"
+#endif
+
 // ---------------------------------------------------------------------------------------
 
 
@@ -88,4 +88,34 @@
   #include "defaults/defaults_simulator.h"
 #endif
 
+// Max jerk for JERK_LIMITED_ACCELERATION, where the defaults file doesn't set it. Zero follows the
+// acceleration settings, reaching them in JERK_RAMP_TIME (see config.h).
+#ifndef DEFAULT_X_JERK
+  #define DEFAULT_X_JERK 0.0 // mm/min^3
+#endif
+#ifndef DEFAULT_Y_JERK
+  #define DEFAULT_Y_JERK 0.0 // mm/min^3
+#endif
+#ifndef DEFAULT_Z_JERK
+  #define DEFAULT_Z_JERK 0.0 // mm/min^3
+#endif
+
+// Input shapers for INPUT_SHAPING, where the defaults file doesn't set them. None until the
+// resonant frequency of the machine is set.
+#ifndef DEFAULT_X_SHAPER_FREQUENCY
+  #define DEFAULT_X_SHAPER_FREQUENCY 0.0 // Hz
+  #define DEFAULT_X_SHAPER_DAMPING 0.1
+  #define DEFAULT_X_SHAPER_TYPE SHAPER_ZV
+#endif
+#ifndef DEFAULT_Y_SHAPER_FREQUENCY
+  #define DEFAULT_Y_SHAPER_FREQUENCY 0.0 // Hz
+  #define DEFAULT_Y_SHAPER_DAMPING 0.1
+  #define DEFAULT_Y_SHAPER_TYPE SHAPER_ZV
+#endif
+#ifndef DEFAULT_Z_SHAPER_FREQUENCY
+  #define DEFAULT_Z_SHAPER_FREQUENCY 0.0 // Hz
+  #define DEFAULT_Z_SHAPER_DAMPING 0.1
+  #define DEFAULT_Z_SHAPER_TYPE SHAPER_ZV
+#endif
+
 #endif
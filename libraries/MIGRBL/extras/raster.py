@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Engraves a grayscale image with Grbl built with RASTER_ENGRAVING, streaming it in raster frames.
+
+Each row of pixels goes along X as one or more raster frames of stream.h, which carry the power of
+each pixel, so Grbl never stops within a row. Dark pixels burn the most. Rows start and end past
+their first and last pixels to burn, by the overscan, so the speed is steady where they burn, and
+blank rows are skipped. The image is a PGM file (P2 or P5), as most image tools save it:
+
+    convert photo.jpg -resize 400x photo.pgm
+    raster.py -p 0.2 -f 1500 /dev/ttyACM0 photo.pgm
+    raster.py --write photo.bin photo.pgm      # frames for extras/sim, built with -DGRBL_RASTER=ON
+
+The lower left corner of the image is at X0 Y0 of the work coordinate system. Needs pyserial to
+stream, and stream_binary.py beside it.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import stream_binary  # noqa: E402
+
+
+def read_pgm(path):
+    """(width, height, rows of values 0-255, 0 black) of a P2 or P5 PGM file"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos)
+            continue
+        end = pos
+        while end < len(data) and not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    magic, width, height, maxval = fields[0], int(fields[1]), int(fields[2]), int(fields[3])
+    if magic == b'P5':
+        if maxval > 255:
+            sys.exit('%s: 16 bit PGM is not supported' % path)
+        values = list(data[pos + 1:pos + 1 + width * height])
+    elif magic == b'P2':
+        values = [int(v) for v in data[pos:].split()[:width * height]]
+    else:
+        sys.exit('%s: not a PGM file' % path)
+    if len(values) < width * height:
+        sys.exit('%s: too short' % path)
+    values = [v * 255 // maxval for v in values]
+    return width, height, [values[r * width:(r + 1) * width] for r in range(height)]
+
+
+def line(text, number):
+    return number, text, stream_binary.TYPE_LINE, text.encode()
+
+
+def move(kind, number, text, x, y=None, feed=None, power=b''):
+    mask = 1
+    payload = struct.pack('<f', x)
+    if y is not None:
+        mask |= 2
+        payload += struct.pack('<f', y)
+    if feed is not None:
+        mask |= stream_binary.MASK_FEED_RATE
+        payload += struct.pack('<f', feed)
+    return number, text, kind, bytes([mask]) + payload + power
+
+
+def frames(rows, pixel, feed, overscan, bidirectional, negative):
+    """(line number, text, type, payload) of the job, as stream_binary.frames() gives them"""
+    yield line('G21G90G94', None)
+    yield line('M3S0', None)
+    forward = True
+    height = len(rows)
+    for r, row in enumerate(rows):
+        power = [v if negative else 255 - v for v in row]
+        burned = [i for i, p in enumerate(power) if p]
+        if not burned:
+            continue
+        first, last = burned[0], burned[-1] + 1
+        y = (height - 1 - r + 0.5) * pixel
+        label = 'row %d' % r
+        if not forward:
+            power = power[::-1]
+            first, last = len(row) - last, len(row) - first
+        sign = 1 if forward else -1
+        origin = 0.0 if forward else len(row) * pixel
+        start = origin + sign * first * pixel
+        yield move(stream_binary.TYPE_RAPID, r, label, start - sign * overscan, y)
+        yield move(stream_binary.TYPE_LINEAR, r, label, start, feed=feed)
+        # Frames of as many pixels as fit after the axis mask and the X end point
+        room = stream_binary.PAYLOAD_MAX - 1 - 4
+        i = first
+        while i < last:
+            n = min(room, last - i)
+            end = origin + sign * (i + n) * pixel
+            yield move(stream_binary.TYPE_RASTER, r, label, end, power=bytes(power[i:i + n]))
+            i += n
+        yield move(stream_binary.TYPE_LINEAR, r, label, origin + sign * last * pixel + sign * overscan)
+        if bidirectional:
+            forward = not forward
+    yield line('M5', None)
+    yield line('G0X0Y0', None)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('port', nargs='?', help='serial port of Grbl')
+    parser.add_argument('image', help='PGM file')
+    parser.add_argument('-p', '--pixel', type=float, default=0.1, help='pixel size in mm (default 0.1)')
+    parser.add_argument('-f', '--feed', type=float, default=1000.0, help='mm/min along the rows (default 1000)')
+    parser.add_argument('-o', '--overscan', type=float, default=2.0,
+                        help='mm to speed up in before the first pixel of a row and slow down in after '
+                             'the last (default 2)')
+    parser.add_argument('--bidirectional', action='store_true', help='every other row right to left')
+    parser.add_argument('--negative', action='store_true', help='light pixels burn the most')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('-t', '--timeout', type=float, default=2.0,
+                        help='seconds without an answer before sending again (default 2)')
+    parser.add_argument('-w', '--write', metavar='FILE', help='write the frames to FILE, not to Grbl')
+    parser.add_argument('-v', '--verbose', action='store_true')
+    args = parser.parse_args()
+    if args.pixel <= 0 or args.feed <= 0 or args.overscan < 0:
+        parser.error('the pixel size and feed rate must be positive, the overscan not negative')
+    _, _, rows = read_pgm(args.image)
+    todo = frames(rows, args.pixel, args.feed, args.overscan, args.bidirectional, args.negative)
+    if args.write:
+        stream_binary.write(args.write, todo)
+        return 0
+    if not args.port:
+        parser.error('the serial port is needed, or --write')
+    return 1 if stream_binary.stream(args.port, todo, args.baud, args.timeout, args.verbose) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,21 @@
+; Arcs, a dwell and a spindle change: each makes Grbl wait for the steppers
+G21 G90 G94
+G0 X0 Y0
+M3 S500
+F2000
+G2 X20 Y0 I10 J0
+G3 X0 Y0 I-10 J0
+G2 X20 Y0 I10 J0
+G3 X0 Y0 I-10 J0
+G2 X20 Y0 I10 J0
+G3 X0 Y0 I-10 J0
+G2 X20 Y0 I10 J0
+G3 X0 Y0 I-10 J0
+G2 X20 Y0 I10 J0
+G3 X0 Y0 I-10 J0
+G4 P0.5
+M5
+G0 X-10 Y10
+G3 X-10 Y10 I10 J0 F1500
+G0 X0 Y0
+M2
@@ -0,0 +1,1227 @@
+; CAM-style toolpath: a 60 x 40 mm rounded rectangle and a wave, in 0.2 mm chords at 3000 mm/min
+; With -DGRBL_BLENDING=ON, add G64 P0.01 to the G21 line to merge the chords
+$110=3000
+$111=3000
+$120=200
+$121=200
+G21 G90 G94
+G0 X10.000 Y0.000
+F3000
+G1 X10.200 Y0.000
+G1 X10.400 Y0.000
+G1 X10.600 Y0.000
+G1 X10.800 Y0.000
+G1 X11.000 Y0.000
+G1 X11.200 Y0.000
+G1 X11.400 Y0.000
+G1 X11.600 Y0.000
+G1 X11.800 Y0.000
+G1 X12.000 Y0.000
+G1 X12.200 Y0.000
+G1 X12.400 Y0.000
+G1 X12.600 Y0.000
+G1 X12.800 Y0.000
+G1 X13.000 Y0.000
+G1 X13.200 Y0.000
+G1 X13.400 Y0.000
+G1 X13.600 Y0.000
+G1 X13.800 Y0.000
+G1 X14.000 Y0.000
+G1 X14.200 Y0.000
+G1 X14.400 Y0.000
+G1 X14.600 Y0.000
+G1 X14.800 Y0.000
+G1 X15.000 Y0.000
+G1 X15.200 Y0.000
+G1 X15.400 Y0.000
+G1 X15.600 Y0.000
+G1 X15.800 Y0.000
+G1 X16.000 Y0.000
+G1 X16.200 Y0.000
+G1 X16.400 Y0.000
+G1 X16.600 Y0.000
+G1 X16.800 Y0.000
+G1 X17.000 Y0.000
+G1 X17.200 Y0.000
+G1 X17.400 Y0.000
+G1 X17.600 Y0.000
+G1 X17.800 Y0.000
+G1 X18.000 Y0.000
+G1 X18.200 Y0.000
+G1 X18.400 Y0.000
+G1 X18.600 Y0.000
+G1 X18.800 Y0.000
+G1 X19.000 Y0.000
+G1 X19.200 Y0.000
+G1 X19.400 Y0.000
+G1 X19.600 Y0.000
+G1 X19.800 Y0.000
+G1 X20.000 Y0.000
+G1 X20.200 Y0.000
+G1 X20.400 Y0.000
+G1 X20.600 Y0.000
+G1 X20.800 Y0.000
+G1 X21.000 Y0.000
+G1 X21.200 Y0.000
+G1 X21.400 Y0.000
+G1 X21.600 Y0.000
+G1 X21.800 Y0.000
+G1 X22.000 Y0.000
+G1 X22.200 Y0.000
+G1 X22.400 Y0.000
+G1 X22.600 Y0.000
+G1 X22.800 Y0.000
+G1 X23.000 Y0.000
+G1 X23.200 Y0.000
+G1 X23.400 Y0.000
+G1 X23.600 Y0.000
+G1 X23.800 Y0.000
+G1 X24.000 Y0.000
+G1 X24.200 Y0.000
+G1 X24.400 Y0.000
+G1 X24.600 Y0.000
+G1 X24.800 Y0.000
+G1 X25.000 Y0.000
+G1 X25.200 Y0.000
+G1 X25.400 Y0.000
+G1 X25.600 Y0.000
+G1 X25.800 Y0.000
+G1 X26.000 Y0.000
+G1 X26.200 Y0.000
+G1 X26.400 Y0.000
+G1 X26.600 Y0.000
+G1 X26.800 Y0.000
+G1 X27.000 Y0.000
+G1 X27.200 Y0.000
+G1 X27.400 Y0.000
+G1 X27.600 Y0.000
+G1 X27.800 Y0.000
+G1 X28.000 Y0.000
+G1 X28.200 Y0.000
+G1 X28.400 Y0.000
+G1 X28.600 Y0.000
+G1 X28.800 Y0.000
+G1 X29.000 Y0.000
+G1 X29.200 Y0.000
+G1 X29.400 Y0.000
+G1 X29.600 Y0.000
+G1 X29.800 Y0.000
+G1 X30.000 Y0.000
+G1 X30.200 Y0.000
+G1 X30.400 Y0.000
+G1 X30.600 Y0.000
+G1 X30.800 Y0.000
+G1 X31.000 Y0.000
+G1 X31.200 Y0.000
+G1 X31.400 Y0.000
+G1 X31.600 Y0.000
+G1 X31.800 Y0.000
+G1 X32.000 Y0.000
+G1 X32.200 Y0.000
+G1 X32.400 Y0.000
+G1 X32.600 Y0.000
+G1 X32.800 Y0.000
+G1 X33.000 Y0.000
+G1 X33.200 Y0.000
+G1 X33.400 Y0.000
+G1 X33.600 Y0.000
+G1 X33.800 Y0.000
+G1 X34.000 Y0.000
+G1 X34.200 Y0.000
+G1 X34.400 Y0.000
+G1 X34.600 Y0.000
+G1 X34.800 Y0.000
+G1 X35.000 Y0.000
+G1 X35.200 Y0.000
+G1 X35.400 Y0.000
+G1 X35.600 Y0.000
+G1 X35.800 Y0.000
+G1 X36.000 Y0.000
+G1 X36.200 Y0.000
+G1 X36.400 Y0.000
+G1 X36.600 Y0.000
+G1 X36.800 Y0.000
+G1 X37.000 Y0.000
+G1 X37.200 Y0.000
+G1 X37.400 Y0.000
+G1 X37.600 Y0.000
+G1 X37.800 Y0.000
+G1 X38.000 Y0.000
+G1 X38.200 Y0.000
+G1 X38.400 Y0.000
+G1 X38.600 Y0.000
+G1 X38.800 Y0.000
+G1 X39.000 Y0.000
+G1 X39.200 Y0.000
+G1 X39.400 Y0.000
+G1 X39.600 Y0.000
+G1 X39.800 Y0.000
+G1 X40.000 Y0.000
+G1 X40.200 Y0.000
+G1 X40.400 Y0.000
+G1 X40.600 Y0.000
+G1 X40.800 Y0.000
+G1 X41.000 Y0.000
+G1 X41.200 Y0.000
+G1 X41.400 Y0.000
+G1 X41.600 Y0.000
+G1 X41.800 Y0.000
+G1 X42.000 Y0.000
+G1 X42.200 Y0.000
+G1 X42.400 Y0.000
+G1 X42.600 Y0.000
+G1 X42.800 Y0.000
+G1 X43.000 Y0.000
+G1 X43.200 Y0.000
+G1 X43.400 Y0.000
+G1 X43.600 Y0.000
+G1 X43.800 Y0.000
+G1 X44.000 Y0.000
+G1 X44.200 Y0.000
+G1 X44.400 Y0.000
+G1 X44.600 Y0.000
+G1 X44.800 Y0.000
+G1 X45.000 Y0.000
+G1 X45.200 Y0.000
+G1 X45.400 Y0.000
+G1 X45.600 Y0.000
+G1 X45.800 Y0.000
+G1 X46.000 Y0.000
+G1 X46.200 Y0.000
+G1 X46.400 Y0.000
+G1 X46.600 Y0.000
+G1 X46.800 Y0.000
+G1 X47.000 Y0.000
+G1 X47.200 Y0.000
+G1 X47.400 Y0.000
+G1 X47.600 Y0.000
+G1 X47.800 Y0.000
+G1 X48.000 Y0.000
+G1 X48.200 Y0.000
+G1 X48.400 Y0.000
+G1 X48.600 Y0.000
+G1 X48.800 Y0.000
+G1 X49.000 Y0.000
+G1 X49.200 Y0.000
+G1 X49.400 Y0.000
+G1 X49.600 Y0.000
+G1 X49.800 Y0.000
+G1 X50.000 Y0.000
+G1 X50.199 Y0.002
+G1 X50.398 Y0.008
+G1 X50.596 Y0.018
+G1 X50.795 Y0.032
+G1 X50.993 Y0.049
+G1 X51.190 Y0.071
+G1 X51.387 Y0.097
+G1 X51.584 Y0.126
+G1 X51.780 Y0.160
+G1 X51.975 Y0.197
+G1 X52.170 Y0.238
+G1 X52.363 Y0.283
+G1 X52.556 Y0.332
+G1 X52.748 Y0.385
+G1 X52.939 Y0.441
+G1 X53.128 Y0.502
+G1 X53.316 Y0.566
+G1 X53.503 Y0.634
+G1 X53.689 Y0.705
+G1 X53.873 Y0.780
+G1 X54.055 Y0.859
+G1 X54.236 Y0.942
+G1 X54.415 Y1.028
+G1 X54.593 Y1.117
+G1 X54.769 Y1.210
+G1 X54.942 Y1.307
+G1 X55.114 Y1.407
+G1 X55.284 Y1.510
+G1 X55.452 Y1.617
+G1 X55.618 Y1.727
+G1 X55.781 Y1.840
+G1 X55.942 Y1.957
+G1 X56.101 Y2.077
+G1 X56.257 Y2.199
+G1 X56.411 Y2.325
+G1 X56.562 Y2.454
+G1 X56.711 Y2.586
+G1 X56.857 Y2.721
+G1 X57.000 Y2.859
+G1 X57.141 Y3.000
+G1 X57.279 Y3.143
+G1 X57.414 Y3.289
+G1 X57.546 Y3.438
+G1 X57.675 Y3.589
+G1 X57.801 Y3.743
+G1 X57.923 Y3.899
+G1 X58.043 Y4.058
+G1 X58.160 Y4.219
+G1 X58.273 Y4.382
+G1 X58.383 Y4.548
+G1 X58.490 Y4.716
+G1 X58.593 Y4.886
+G1 X58.693 Y5.058
+G1 X58.790 Y5.231
+G1 X58.883 Y5.407
+G1 X58.972 Y5.585
+G1 X59.058 Y5.764
+G1 X59.141 Y5.945
+G1 X59.220 Y6.127
+G1 X59.295 Y6.311
+G1 X59.366 Y6.497
+G1 X59.434 Y6.684
+G1 X59.498 Y6.872
+G1 X59.559 Y7.061
+G1 X59.615 Y7.252
+G1 X59.668 Y7.444
+G1 X59.717 Y7.637
+G1 X59.762 Y7.830
+G1 X59.803 Y8.025
+G1 X59.840 Y8.220
+G1 X59.874 Y8.416
+G1 X59.903 Y8.613
+G1 X59.929 Y8.810
+G1 X59.951 Y9.007
+G1 X59.968 Y9.205
+G1 X59.982 Y9.404
+G1 X59.992 Y9.602
+G1 X59.998 Y9.801
+G1 X60.000 Y10.000
+G1 X60.000 Y10.200
+G1 X60.000 Y10.400
+G1 X60.000 Y10.600
+G1 X60.000 Y10.800
+G1 X60.000 Y11.000
+G1 X60.000 Y11.200
+G1 X60.000 Y11.400
+G1 X60.000 Y11.600
+G1 X60.000 Y11.800
+G1 X60.000 Y12.000
+G1 X60.000 Y12.200
+G1 X60.000 Y12.400
+G1 X60.000 Y12.600
+G1 X60.000 Y12.800
+G1 X60.000 Y13.000
+G1 X60.000 Y13.200
+G1 X60.000 Y13.400
+G1 X60.000 Y13.600
+G1 X60.000 Y13.800
+G1 X60.000 Y14.000
+G1 X60.000 Y14.200
+G1 X60.000 Y14.400
+G1 X60.000 Y14.600
+G1 X60.000 Y14.800
+G1 X60.000 Y15.000
+G1 X60.000 Y15.200
+G1 X60.000 Y15.400
+G1 X60.000 Y15.600
+G1 X60.000 Y15.800
+G1 X60.000 Y16.000
+G1 X60.000 Y16.200
+G1 X60.000 Y16.400
+G1 X60.000 Y16.600
+G1 X60.000 Y16.800
+G1 X60.000 Y17.000
+G1 X60.000 Y17.200
+G1 X60.000 Y17.400
+G1 X60.000 Y17.600
+G1 X60.000 Y17.800
+G1 X60.000 Y18.000
+G1 X60.000 Y18.200
+G1 X60.000 Y18.400
+G1 X60.000 Y18.600
+G1 X60.000 Y18.800
+G1 X60.000 Y19.000
+G1 X60.000 Y19.200
+G1 X60.000 Y19.400
+G1 X60.000 Y19.600
+G1 X60.000 Y19.800
+G1 X60.000 Y20.000
+G1 X60.000 Y20.200
+G1 X60.000 Y20.400
+G1 X60.000 Y20.600
+G1 X60.000 Y20.800
+G1 X60.000 Y21.000
+G1 X60.000 Y21.200
+G1 X60.000 Y21.400
+G1 X60.000 Y21.600
+G1 X60.000 Y21.800
+G1 X60.000 Y22.000
+G1 X60.000 Y22.200
+G1 X60.000 Y22.400
+G1 X60.000 Y22.600
+G1 X60.000 Y22.800
+G1 X60.000 Y23.000
+G1 X60.000 Y23.200
+G1 X60.000 Y23.400
+G1 X60.000 Y23.600
+G1 X60.000 Y23.800
+G1 X60.000 Y24.000
+G1 X60.000 Y24.200
+G1 X60.000 Y24.400
+G1 X60.000 Y24.600
+G1 X60.000 Y24.800
+G1 X60.000 Y25.000
+G1 X60.000 Y25.200
+G1 X60.000 Y25.400
+G1 X60.000 Y25.600
+G1 X60.000 Y25.800
+G1 X60.000 Y26.000
+G1 X60.000 Y26.200
+G1 X60.000 Y26.400
+G1 X60.000 Y26.600
+G1 X60.000 Y26.800
+G1 X60.000 Y27.000
+G1 X60.000 Y27.200
+G1 X60.000 Y27.400
+G1 X60.000 Y27.600
+G1 X60.000 Y27.800
+G1 X60.000 Y28.000
+G1 X60.000 Y28.200
+G1 X60.000 Y28.400
+G1 X60.000 Y28.600
+G1 X60.000 Y28.800
+G1 X60.000 Y29.000
+G1 X60.000 Y29.200
+G1 X60.000 Y29.400
+G1 X60.000 Y29.600
+G1 X60.000 Y29.800
+G1 X60.000 Y30.000
+G1 X59.998 Y30.199
+G1 X59.992 Y30.398
+G1 X59.982 Y30.596
+G1 X59.968 Y30.795
+G1 X59.951 Y30.993
+G1 X59.929 Y31.190
+G1 X59.903 Y31.387
+G1 X59.874 Y31.584
+G1 X59.840 Y31.780
+G1 X59.803 Y31.975
+G1 X59.762 Y32.170
+G1 X59.717 Y32.363
+G1 X59.668 Y32.556
+G1 X59.615 Y32.748
+G1 X59.559 Y32.939
+G1 X59.498 Y33.128
+G1 X59.434 Y33.316
+G1 X59.366 Y33.503
+G1 X59.295 Y33.689
+G1 X59.220 Y33.873
+G1 X59.141 Y34.055
+G1 X59.058 Y34.236
+G1 X58.972 Y34.415
+G1 X58.883 Y34.593
+G1 X58.790 Y34.769
+G1 X58.693 Y34.942
+G1 X58.593 Y35.114
+G1 X58.490 Y35.284
+G1 X58.383 Y35.452
+G1 X58.273 Y35.618
+G1 X58.160 Y35.781
+G1 X58.043 Y35.942
+G1 X57.923 Y36.101
+G1 X57.801 Y36.257
+G1 X57.675 Y36.411
+G1 X57.546 Y36.562
+G1 X57.414 Y36.711
+G1 X57.279 Y36.857
+G1 X57.141 Y37.000
+G1 X57.000 Y37.141
+G1 X56.857 Y37.279
+G1 X56.711 Y37.414
+G1 X56.562 Y37.546
+G1 X56.411 Y37.675
+G1 X56.257 Y37.801
+G1 X56.101 Y37.923
+G1 X55.942 Y38.043
+G1 X55.781 Y38.160
+G1 X55.618 Y38.273
+G1 X55.452 Y38.383
+G1 X55.284 Y38.490
+G1 X55.114 Y38.593
+G1 X54.942 Y38.693
+G1 X54.769 Y38.790
+G1 X54.593 Y38.883
+G1 X54.415 Y38.972
+G1 X54.236 Y39.058
+G1 X54.055 Y39.141
+G1 X53.873 Y39.220
+G1 X53.689 Y39.295
+G1 X53.503 Y39.366
+G1 X53.316 Y39.434
+G1 X53.128 Y39.498
+G1 X52.939 Y39.559
+G1 X52.748 Y39.615
+G1 X52.556 Y39.668
+G1 X52.363 Y39.717
+G1 X52.170 Y39.762
+G1 X51.975 Y39.803
+G1 X51.780 Y39.840
+G1 X51.584 Y39.874
+G1 X51.387 Y39.903
+G1 X51.190 Y39.929
+G1 X50.993 Y39.951
+G1 X50.795 Y39.968
+G1 X50.596 Y39.982
+G1 X50.398 Y39.992
+G1 X50.199 Y39.998
+G1 X50.000 Y40.000
+G1 X49.800 Y40.000
+G1 X49.600 Y40.000
+G1 X49.400 Y40.000
+G1 X49.200 Y40.000
+G1 X49.000 Y40.000
+G1 X48.800 Y40.000
+G1 X48.600 Y40.000
+G1 X48.400 Y40.000
+G1 X48.200 Y40.000
+G1 X48.000 Y40.000
+G1 X47.800 Y40.000
+G1 X47.600 Y40.000
+G1 X47.400 Y40.000
+G1 X47.200 Y40.000
+G1 X47.000 Y40.000
+G1 X46.800 Y40.000
+G1 X46.600 Y40.000
+G1 X46.400 Y40.000
+G1 X46.200 Y40.000
+G1 X46.000 Y40.000
+G1 X45.800 Y40.000
+G1 X45.600 Y40.000
+G1 X45.400 Y40.000
+G1 X45.200 Y40.000
+G1 X45.000 Y40.000
+G1 X44.800 Y40.000
+G1 X44.600 Y40.000
+G1 X44.400 Y40.000
+G1 X44.200 Y40.000
+G1 X44.000 Y40.000
+G1 X43.800 Y40.000
+G1 X43.600 Y40.000
+G1 X43.400 Y40.000
+G1 X43.200 Y40.000
+G1 X43.000 Y40.000
+G1 X42.800 Y40.000
+G1 X42.600 Y40.000
+G1 X42.400 Y40.000
+G1 X42.200 Y40.000
+G1 X42.000 Y40.000
+G1 X41.800 Y40.000
+G1 X41.600 Y40.000
+G1 X41.400 Y40.000
+G1 X41.200 Y40.000
+G1 X41.000 Y40.000
+G1 X40.800 Y40.000
+G1 X40.600 Y40.000
+G1 X40.400 Y40.000
+G1 X40.200 Y40.000
+G1 X40.000 Y40.000
+G1 X39.800 Y40.000
+G1 X39.600 Y40.000
+G1 X39.400 Y40.000
+G1 X39.200 Y40.000
+G1 X39.000 Y40.000
+G1 X38.800 Y40.000
+G1 X38.600 Y40.000
+G1 X38.400 Y40.000
+G1 X38.200 Y40.000
+G1 X38.000 Y40.000
+G1 X37.800 Y40.000
+G1 X37.600 Y40.000
+G1 X37.400 Y40.000
+G1 X37.200 Y40.000
+G1 X37.000 Y40.000
+G1 X36.800 Y40.000
+G1 X36.600 Y40.000
+G1 X36.400 Y40.000
+G1 X36.200 Y40.000
+G1 X36.000 Y40.000
+G1 X35.800 Y40.000
+G1 X35.600 Y40.000
+G1 X35.400 Y40.000
+G1 X35.200 Y40.000
+G1 X35.000 Y40.000
+G1 X34.800 Y40.000
+G1 X34.600 Y40.000
+G1 X34.400 Y40.000
+G1 X34.200 Y40.000
+G1 X34.000 Y40.000
+G1 X33.800 Y40.000
+G1 X33.600 Y40.000
+G1 X33.400 Y40.000
+G1 X33.200 Y40.000
+G1 X33.000 Y40.000
+G1 X32.800 Y40.000
+G1 X32.600 Y40.000
+G1 X32.400 Y40.000
+G1 X32.200 Y40.000
+G1 X32.000 Y40.000
+G1 X31.800 Y40.000
+G1 X31.600 Y40.000
+G1 X31.400 Y40.000
+G1 X31.200 Y40.000
+G1 X31.000 Y40.000
+G1 X30.800 Y40.000
+G1 X30.600 Y40.000
+G1 X30.400 Y40.000
+G1 X30.200 Y40.000
+G1 X30.000 Y40.000
+G1 X29.800 Y40.000
+G1 X29.600 Y40.000
+G1 X29.400 Y40.000
+G1 X29.200 Y40.000
+G1 X29.000 Y40.000
+G1 X28.800 Y40.000
+G1 X28.600 Y40.000
+G1 X28.400 Y40.000
+G1 X28.200 Y40.000
+G1 X28.000 Y40.000
+G1 X27.800 Y40.000
+G1 X27.600 Y40.000
+G1 X27.400 Y40.000
+G1 X27.200 Y40.000
+G1 X27.000 Y40.000
+G1 X26.800 Y40.000
+G1 X26.600 Y40.000
+G1 X26.400 Y40.000
+G1 X26.200 Y40.000
+G1 X26.000 Y40.000
+G1 X25.800 Y40.000
+G1 X25.600 Y40.000
+G1 X25.400 Y40.000
+G1 X25.200 Y40.000
+G1 X25.000 Y40.000
+G1 X24.800 Y40.000
+G1 X24.600 Y40.000
+G1 X24.400 Y40.000
+G1 X24.200 Y40.000
+G1 X24.000 Y40.000
+G1 X23.800 Y40.000
+G1 X23.600 Y40.000
+G1 X23.400 Y40.000
+G1 X23.200 Y40.000
+G1 X23.000 Y40.000
+G1 X22.800 Y40.000
+G1 X22.600 Y40.000
+G1 X22.400 Y40.000
+G1 X22.200 Y40.000
+G1 X22.000 Y40.000
+G1 X21.800 Y40.000
+G1 X21.600 Y40.000
+G1 X21.400 Y40.000
+G1 X21.200 Y40.000
+G1 X21.000 Y40.000
+G1 X20.800 Y40.000
+G1 X20.600 Y40.000
+G1 X20.400 Y40.000
+G1 X20.200 Y40.000
+G1 X20.000 Y40.000
+G1 X19.800 Y40.000
+G1 X19.600 Y40.000
+G1 X19.400 Y40.000
+G1 X19.200 Y40.000
+G1 X19.000 Y40.000
+G1 X18.800 Y40.000
+G1 X18.600 Y40.000
+G1 X18.400 Y40.000
+G1 X18.200 Y40.000
+G1 X18.000 Y40.000
+G1 X17.800 Y40.000
+G1 X17.600 Y40.000
+G1 X17.400 Y40.000
+G1 X17.200 Y40.000
+G1 X17.000 Y40.000
+G1 X16.800 Y40.000
+G1 X16.600 Y40.000
+G1 X16.400 Y40.000
+G1 X16.200 Y40.000
+G1 X16.000 Y40.000
+G1 X15.800 Y40.000
+G1 X15.600 Y40.000
+G1 X15.400 Y40.000
+G1 X15.200 Y40.000
+G1 X15.000 Y40.000
+G1 X14.800 Y40.000
+G1 X14.600 Y40.000
+G1 X14.400 Y40.000
+G1 X14.200 Y40.000
+G1 X14.000 Y40.000
+G1 X13.800 Y40.000
+G1 X13.600 Y40.000
+G1 X13.400 Y40.000
+G1 X13.200 Y40.000
+G1 X13.000 Y40.000
+G1 X12.800 Y40.000
+G1 X12.600 Y40.000
+G1 X12.400 Y40.000
+G1 X12.200 Y40.000
+G1 X12.000 Y40.000
+G1 X11.800 Y40.000
+G1 X11.600 Y40.000
+G1 X11.400 Y40.000
+G1 X11.200 Y40.000
+G1 X11.000 Y40.000
+G1 X10.800 Y40.000
+G1 X10.600 Y40.000
+G1 X10.400 Y40.000
+G1 X10.200 Y40.000
+G1 X10.000 Y40.000
+G1 X9.801 Y39.998
+G1 X9.602 Y39.992
+G1 X9.404 Y39.982
+G1 X9.205 Y39.968
+G1 X9.007 Y39.951
+G1 X8.810 Y39.929
+G1 X8.613 Y39.903
+G1 X8.416 Y39.874
+G1 X8.220 Y39.840
+G1 X8.025 Y39.803
+G1 X7.830 Y39.762
+G1 X7.637 Y39.717
+G1 X7.444 Y39.668
+G1 X7.252 Y39.615
+G1 X7.061 Y39.559
+G1 X6.872 Y39.498
+G1 X6.684 Y39.434
+G1 X6.497 Y39.366
+G1 X6.311 Y39.295
+G1 X6.127 Y39.220
+G1 X5.945 Y39.141
+G1 X5.764 Y39.058
+G1 X5.585 Y38.972
+G1 X5.407 Y38.883
+G1 X5.231 Y38.790
+G1 X5.058 Y38.693
+G1 X4.886 Y38.593
+G1 X4.716 Y38.490
+G1 X4.548 Y38.383
+G1 X4.382 Y38.273
+G1 X4.219 Y38.160
+G1 X4.058 Y38.043
+G1 X3.899 Y37.923
+G1 X3.743 Y37.801
+G1 X3.589 Y37.675
+G1 X3.438 Y37.546
+G1 X3.289 Y37.414
+G1 X3.143 Y37.279
+G1 X3.000 Y37.141
+G1 X2.859 Y37.000
+G1 X2.721 Y36.857
+G1 X2.586 Y36.711
+G1 X2.454 Y36.562
+G1 X2.325 Y36.411
+G1 X2.199 Y36.257
+G1 X2.077 Y36.101
+G1 X1.957 Y35.942
+G1 X1.840 Y35.781
+G1 X1.727 Y35.618
+G1 X1.617 Y35.452
+G1 X1.510 Y35.284
+G1 X1.407 Y35.114
+G1 X1.307 Y34.942
+G1 X1.210 Y34.769
+G1 X1.117 Y34.593
+G1 X1.028 Y34.415
+G1 X0.942 Y34.236
+G1 X0.859 Y34.055
+G1 X0.780 Y33.873
+G1 X0.705 Y33.689
+G1 X0.634 Y33.503
+G1 X0.566 Y33.316
+G1 X0.502 Y33.128
+G1 X0.441 Y32.939
+G1 X0.385 Y32.748
+G1 X0.332 Y32.556
+G1 X0.283 Y32.363
+G1 X0.238 Y32.170
+G1 X0.197 Y31.975
+G1 X0.160 Y31.780
+G1 X0.126 Y31.584
+G1 X0.097 Y31.387
+G1 X0.071 Y31.190
+G1 X0.049 Y30.993
+G1 X0.032 Y30.795
+G1 X0.018 Y30.596
+G1 X0.008 Y30.398
+G1 X0.002 Y30.199
+G1 X0.000 Y30.000
+G1 X0.000 Y29.800
+G1 X0.000 Y29.600
+G1 X0.000 Y29.400
+G1 X0.000 Y29.200
+G1 X0.000 Y29.000
+G1 X0.000 Y28.800
+G1 X0.000 Y28.600
+G1 X0.000 Y28.400
+G1 X0.000 Y28.200
+G1 X0.000 Y28.000
+G1 X0.000 Y27.800
+G1 X0.000 Y27.600
+G1 X0.000 Y27.400
+G1 X0.000 Y27.200
+G1 X0.000 Y27.000
+G1 X0.000 Y26.800
+G1 X0.000 Y26.600
+G1 X0.000 Y26.400
+G1 X0.000 Y26.200
+G1 X0.000 Y26.000
+G1 X0.000 Y25.800
+G1 X0.000 Y25.600
+G1 X0.000 Y25.400
+G1 X0.000 Y25.200
+G1 X0.000 Y25.000
+G1 X0.000 Y24.800
+G1 X0.000 Y24.600
+G1 X0.000 Y24.400
+G1 X0.000 Y24.200
+G1 X0.000 Y24.000
+G1 X0.000 Y23.800
+G1 X0.000 Y23.600
+G1 X0.000 Y23.400
+G1 X0.000 Y23.200
+G1 X0.000 Y23.000
+G1 X0.000 Y22.800
+G1 X0.000 Y22.600
+G1 X0.000 Y22.400
+G1 X0.000 Y22.200
+G1 X0.000 Y22.000
+G1 X0.000 Y21.800
+G1 X0.000 Y21.600
+G1 X0.000 Y21.400
+G1 X0.000 Y21.200
+G1 X0.000 Y21.000
+G1 X0.000 Y20.800
+G1 X0.000 Y20.600
+G1 X0.000 Y20.400
+G1 X0.000 Y20.200
+G1 X0.000 Y20.000
+G1 X0.000 Y19.800
+G1 X0.000 Y19.600
+G1 X0.000 Y19.400
+G1 X0.000 Y19.200
+G1 X0.000 Y19.000
+G1 X0.000 Y18.800
+G1 X0.000 Y18.600
+G1 X0.000 Y18.400
+G1 X0.000 Y18.200
+G1 X0.000 Y18.000
+G1 X0.000 Y17.800
+G1 X0.000 Y17.600
+G1 X0.000 Y17.400
+G1 X0.000 Y17.200
+G1 X0.000 Y17.000
+G1 X0.000 Y16.800
+G1 X0.000 Y16.600
+G1 X0.000 Y16.400
+G1 X0.000 Y16.200
+G1 X0.000 Y16.000
+G1 X0.000 Y15.800
+G1 X0.000 Y15.600
+G1 X0.000 Y15.400
+G1 X0.000 Y15.200
+G1 X0.000 Y15.000
+G1 X0.000 Y14.800
+G1 X0.000 Y14.600
+G1 X0.000 Y14.400
+G1 X0.000 Y14.200
+G1 X0.000 Y14.000
+G1 X0.000 Y13.800
+G1 X0.000 Y13.600
+G1 X0.000 Y13.400
+G1 X0.000 Y13.200
+G1 X0.000 Y13.000
+G1 X0.000 Y12.800
+G1 X0.000 Y12.600
+G1 X0.000 Y12.400
+G1 X0.000 Y12.200
+G1 X0.000 Y12.000
+G1 X0.000 Y11.800
+G1 X0.000 Y11.600
+G1 X0.000 Y11.400
+G1 X0.000 Y11.200
+G1 X0.000 Y11.000
+G1 X0.000 Y10.800
+G1 X0.000 Y10.600
+G1 X0.000 Y10.400
+G1 X0.000 Y10.200
+G1 X0.000 Y10.000
+G1 X0.002 Y9.801
+G1 X0.008 Y9.602
+G1 X0.018 Y9.404
+G1 X0.032 Y9.205
+G1 X0.049 Y9.007
+G1 X0.071 Y8.810
+G1 X0.097 Y8.613
+G1 X0.126 Y8.416
+G1 X0.160 Y8.220
+G1 X0.197 Y8.025
+G1 X0.238 Y7.830
+G1 X0.283 Y7.637
+G1 X0.332 Y7.444
+G1 X0.385 Y7.252
+G1 X0.441 Y7.061
+G1 X0.502 Y6.872
+G1 X0.566 Y6.684
+G1 X0.634 Y6.497
+G1 X0.705 Y6.311
+G1 X0.780 Y6.127
+G1 X0.859 Y5.945
+G1 X0.942 Y5.764
+G1 X1.028 Y5.585
+G1 X1.117 Y5.407
+G1 X1.210 Y5.231
+G1 X1.307 Y5.058
+G1 X1.407 Y4.886
+G1 X1.510 Y4.716
+G1 X1.617 Y4.548
+G1 X1.727 Y4.382
+G1 X1.840 Y4.219
+G1 X1.957 Y4.058
+G1 X2.077 Y3.899
+G1 X2.199 Y3.743
+G1 X2.325 Y3.589
+G1 X2.454 Y3.438
+G1 X2.586 Y3.289
+G1 X2.721 Y3.143
+G1 X2.859 Y3.000
+G1 X3.000 Y2.859
+G1 X3.143 Y2.721
+G1 X3.289 Y2.586
+G1 X3.438 Y2.454
+G1 X3.589 Y2.325
+G1 X3.743 Y2.199
+G1 X3.899 Y2.077
+G1 X4.058 Y1.957
+G1 X4.219 Y1.840
+G1 X4.382 Y1.727
+G1 X4.548 Y1.617
+G1 X4.716 Y1.510
+G1 X4.886 Y1.407
+G1 X5.058 Y1.307
+G1 X5.231 Y1.210
+G1 X5.407 Y1.117
+G1 X5.585 Y1.028
+G1 X5.764 Y0.942
+G1 X5.945 Y0.859
+G1 X6.127 Y0.780
+G1 X6.311 Y0.705
+G1 X6.497 Y0.634
+G1 X6.684 Y0.566
+G1 X6.872 Y0.502
+G1 X7.061 Y0.441
+G1 X7.252 Y0.385
+G1 X7.444 Y0.332
+G1 X7.637 Y0.283
+G1 X7.830 Y0.238
+G1 X8.025 Y0.197
+G1 X8.220 Y0.160
+G1 X8.416 Y0.126
+G1 X8.613 Y0.097
+G1 X8.810 Y0.071
+G1 X9.007 Y0.049
+G1 X9.205 Y0.032
+G1 X9.404 Y0.018
+G1 X9.602 Y0.008
+G1 X9.801 Y0.002
+G1 X10.000 Y0.000
+G0 X0 Y-10
+G1 X0.200 Y-9.874
+G1 X0.400 Y-9.749
+G1 X0.600 Y-9.624
+G1 X0.800 Y-9.500
+G1 X1.000 Y-9.376
+G1 X1.200 Y-9.254
+G1 X1.400 Y-9.133
+G1 X1.600 Y-9.013
+G1 X1.800 Y-8.896
+G1 X2.000 Y-8.780
+G1 X2.200 Y-8.666
+G1 X2.400 Y-8.555
+G1 X2.600 Y-8.446
+G1 X2.800 Y-8.340
+G1 X3.000 Y-8.237
+G1 X3.200 Y-8.137
+G1 X3.400 Y-8.040
+G1 X3.600 Y-7.946
+G1 X3.800 Y-7.857
+G1 X4.000 Y-7.771
+G1 X4.200 Y-7.688
+G1 X4.400 Y-7.610
+G1 X4.600 Y-7.537
+G1 X4.800 Y-7.467
+G1 X5.000 Y-7.402
+G1 X5.200 Y-7.341
+G1 X5.400 Y-7.286
+G1 X5.600 Y-7.234
+G1 X5.800 Y-7.188
+G1 X6.000 Y-7.147
+G1 X6.200 Y-7.111
+G1 X6.400 Y-7.079
+G1 X6.600 Y-7.053
+G1 X6.800 Y-7.032
+G1 X7.000 Y-7.016
+G1 X7.200 Y-7.006
+G1 X7.400 Y-7.001
+G1 X7.600 Y-7.001
+G1 X7.800 Y-7.006
+G1 X8.000 Y-7.016
+G1 X8.200 Y-7.032
+G1 X8.400 Y-7.053
+G1 X8.600 Y-7.079
+G1 X8.800 Y-7.111
+G1 X9.000 Y-7.147
+G1 X9.200 Y-7.188
+G1 X9.400 Y-7.234
+G1 X9.600 Y-7.286
+G1 X9.800 Y-7.341
+G1 X10.000 Y-7.402
+G1 X10.200 Y-7.467
+G1 X10.400 Y-7.537
+G1 X10.600 Y-7.610
+G1 X10.800 Y-7.688
+G1 X11.000 Y-7.771
+G1 X11.200 Y-7.857
+G1 X11.400 Y-7.946
+G1 X11.600 Y-8.040
+G1 X11.800 Y-8.137
+G1 X12.000 Y-8.237
+G1 X12.200 Y-8.340
+G1 X12.400 Y-8.446
+G1 X12.600 Y-8.555
+G1 X12.800 Y-8.666
+G1 X13.000 Y-8.780
+G1 X13.200 Y-8.896
+G1 X13.400 Y-9.013
+G1 X13.600 Y-9.133
+G1 X13.800 Y-9.254
+G1 X14.000 Y-9.376
+G1 X14.200 Y-9.500
+G1 X14.400 Y-9.624
+G1 X14.600 Y-9.749
+G1 X14.800 Y-9.874
+G1 X15.000 Y-10.000
+G1 X15.200 Y-10.126
+G1 X15.400 Y-10.251
+G1 X15.600 Y-10.376
+G1 X15.800 Y-10.500
+G1 X16.000 Y-10.624
+G1 X16.200 Y-10.746
+G1 X16.400 Y-10.867
+G1 X16.600 Y-10.987
+G1 X16.800 Y-11.104
+G1 X17.000 Y-11.220
+G1 X17.200 Y-11.334
+G1 X17.400 Y-11.445
+G1 X17.600 Y-11.554
+G1 X17.800 Y-11.660
+G1 X18.000 Y-11.763
+G1 X18.200 Y-11.863
+G1 X18.400 Y-11.960
+G1 X18.600 Y-12.054
+G1 X18.800 Y-12.143
+G1 X19.000 Y-12.229
+G1 X19.200 Y-12.312
+G1 X19.400 Y-12.390
+G1 X19.600 Y-12.463
+G1 X19.800 Y-12.533
+G1 X20.000 Y-12.598
+G1 X20.200 Y-12.659
+G1 X20.400 Y-12.714
+G1 X20.600 Y-12.766
+G1 X20.800 Y-12.812
+G1 X21.000 Y-12.853
+G1 X21.200 Y-12.889
+G1 X21.400 Y-12.921
+G1 X21.600 Y-12.947
+G1 X21.800 Y-12.968
+G1 X22.000 Y-12.984
+G1 X22.200 Y-12.994
+G1 X22.400 Y-12.999
+G1 X22.600 Y-12.999
+G1 X22.800 Y-12.994
+G1 X23.000 Y-12.984
+G1 X23.200 Y-12.968
+G1 X23.400 Y-12.947
+G1 X23.600 Y-12.921
+G1 X23.800 Y-12.889
+G1 X24.000 Y-12.853
+G1 X24.200 Y-12.812
+G1 X24.400 Y-12.766
+G1 X24.600 Y-12.714
+G1 X24.800 Y-12.659
+G1 X25.000 Y-12.598
+G1 X25.200 Y-12.533
+G1 X25.400 Y-12.463
+G1 X25.600 Y-12.390
+G1 X25.800 Y-12.312
+G1 X26.000 Y-12.229
+G1 X26.200 Y-12.143
+G1 X26.400 Y-12.054
+G1 X26.600 Y-11.960
+G1 X26.800 Y-11.863
+G1 X27.000 Y-11.763
+G1 X27.200 Y-11.660
+G1 X27.400 Y-11.554
+G1 X27.600 Y-11.445
+G1 X27.800 Y-11.334
+G1 X28.000 Y-11.220
+G1 X28.200 Y-11.104
+G1 X28.400 Y-10.987
+G1 X28.600 Y-10.867
+G1 X28.800 Y-10.746
+G1 X29.000 Y-10.624
+G1 X29.200 Y-10.500
+G1 X29.400 Y-10.376
+G1 X29.600 Y-10.251
+G1 X29.800 Y-10.126
+G1 X30.000 Y-10.000
+G1 X30.200 Y-9.874
+G1 X30.400 Y-9.749
+G1 X30.600 Y-9.624
+G1 X30.800 Y-9.500
+G1 X31.000 Y-9.376
+G1 X31.200 Y-9.254
+G1 X31.400 Y-9.133
+G1 X31.600 Y-9.013
+G1 X31.800 Y-8.896
+G1 X32.000 Y-8.780
+G1 X32.200 Y-8.666
+G1 X32.400 Y-8.555
+G1 X32.600 Y-8.446
+G1 X32.800 Y-8.340
+G1 X33.000 Y-8.237
+G1 X33.200 Y-8.137
+G1 X33.400 Y-8.040
+G1 X33.600 Y-7.946
+G1 X33.800 Y-7.857
+G1 X34.000 Y-7.771
+G1 X34.200 Y-7.688
+G1 X34.400 Y-7.610
+G1 X34.600 Y-7.537
+G1 X34.800 Y-7.467
+G1 X35.000 Y-7.402
+G1 X35.200 Y-7.341
+G1 X35.400 Y-7.286
+G1 X35.600 Y-7.234
+G1 X35.800 Y-7.188
+G1 X36.000 Y-7.147
+G1 X36.200 Y-7.111
+G1 X36.400 Y-7.079
+G1 X36.600 Y-7.053
+G1 X36.800 Y-7.032
+G1 X37.000 Y-7.016
+G1 X37.200 Y-7.006
+G1 X37.400 Y-7.001
+G1 X37.600 Y-7.001
+G1 X37.800 Y-7.006
+G1 X38.000 Y-7.016
+G1 X38.200 Y-7.032
+G1 X38.400 Y-7.053
+G1 X38.600 Y-7.079
+G1 X38.800 Y-7.111
+G1 X39.000 Y-7.147
+G1 X39.200 Y-7.188
+G1 X39.400 Y-7.234
+G1 X39.600 Y-7.286
+G1 X39.800 Y-7.341
+G1 X40.000 Y-7.402
+G1 X40.200 Y-7.467
+G1 X40.400 Y-7.537
+G1 X40.600 Y-7.610
+G1 X40.800 Y-7.688
+G1 X41.000 Y-7.771
+G1 X41.200 Y-7.857
+G1 X41.400 Y-7.946
+G1 X41.600 Y-8.040
+G1 X41.800 Y-8.137
+G1 X42.000 Y-8.237
+G1 X42.200 Y-8.340
+G1 X42.400 Y-8.446
+G1 X42.600 Y-8.555
+G1 X42.800 Y-8.666
+G1 X43.000 Y-8.780
+G1 X43.200 Y-8.896
+G1 X43.400 Y-9.013
+G1 X43.600 Y-9.133
+G1 X43.800 Y-9.254
+G1 X44.000 Y-9.376
+G1 X44.200 Y-9.500
+G1 X44.400 Y-9.624
+G1 X44.600 Y-9.749
+G1 X44.800 Y-9.874
+G1 X45.000 Y-10.000
+G1 X45.200 Y-10.126
+G1 X45.400 Y-10.251
+G1 X45.600 Y-10.376
+G1 X45.800 Y-10.500
+G1 X46.000 Y-10.624
+G1 X46.200 Y-10.746
+G1 X46.400 Y-10.867
+G1 X46.600 Y-10.987
+G1 X46.800 Y-11.104
+G1 X47.000 Y-11.220
+G1 X47.200 Y-11.334
+G1 X47.400 Y-11.445
+G1 X47.600 Y-11.554
+G1 X47.800 Y-11.660
+G1 X48.000 Y-11.763
+G1 X48.200 Y-11.863
+G1 X48.400 Y-11.960
+G1 X48.600 Y-12.054
+G1 X48.800 Y-12.143
+G1 X49.000 Y-12.229
+G1 X49.200 Y-12.312
+G1 X49.400 Y-12.390
+G1 X49.600 Y-12.463
+G1 X49.800 Y-12.533
+G1 X50.000 Y-12.598
+G1 X50.200 Y-12.659
+G1 X50.400 Y-12.714
+G1 X50.600 Y-12.766
+G1 X50.800 Y-12.812
+G1 X51.000 Y-12.853
+G1 X51.200 Y-12.889
+G1 X51.400 Y-12.921
+G1 X51.600 Y-12.947
+G1 X51.800 Y-12.968
+G1 X52.000 Y-12.984
+G1 X52.200 Y-12.994
+G1 X52.400 Y-12.999
+G1 X52.600 Y-12.999
+G1 X52.800 Y-12.994
+G1 X53.000 Y-12.984
+G1 X53.200 Y-12.968
+G1 X53.400 Y-12.947
+G1 X53.600 Y-12.921
+G1 X53.800 Y-12.889
+G1 X54.000 Y-12.853
+G1 X54.200 Y-12.812
+G1 X54.400 Y-12.766
+G1 X54.600 Y-12.714
+G1 X54.800 Y-12.659
+G1 X55.000 Y-12.598
+G1 X55.200 Y-12.533
+G1 X55.400 Y-12.463
+G1 X55.600 Y-12.390
+G1 X55.800 Y-12.312
+G1 X56.000 Y-12.229
+G1 X56.200 Y-12.143
+G1 X56.400 Y-12.054
+G1 X56.600 Y-11.960
+G1 X56.800 Y-11.863
+G1 X57.000 Y-11.763
+G1 X57.200 Y-11.660
+G1 X57.400 Y-11.554
+G1 X57.600 Y-11.445
+G1 X57.800 Y-11.334
+G1 X58.000 Y-11.220
+G1 X58.200 Y-11.104
+G1 X58.400 Y-10.987
+G1 X58.600 Y-10.867
+G1 X58.800 Y-10.746
+G1 X59.000 Y-10.624
+G1 X59.200 Y-10.500
+G1 X59.400 Y-10.376
+G1 X59.600 Y-10.251
+G1 X59.800 Y-10.126
+G1 X60.000 Y-10.000
+M2
@@ -0,0 +1,795 @@
+; 50 mm circle in 0.2 mm segments at 3000 mm/min, on a machine that can do it
+$110=3000
+$111=3000
+$120=200
+$121=200
+G21 G90 G94
+G0 X25 Y0
+F3000
+G1 X24.999 Y0.200
+G1 X24.997 Y0.400
+G1 X24.993 Y0.600
+G1 X24.987 Y0.800
+G1 X24.980 Y1.000
+G1 X24.971 Y1.200
+G1 X24.961 Y1.400
+G1 X24.949 Y1.600
+G1 X24.935 Y1.799
+G1 X24.920 Y1.999
+G1 X24.903 Y2.198
+G1 X24.885 Y2.398
+G1 X24.865 Y2.597
+G1 X24.843 Y2.796
+G1 X24.820 Y2.994
+G1 X24.795 Y3.193
+G1 X24.769 Y3.391
+G1 X24.741 Y3.589
+G1 X24.711 Y3.787
+G1 X24.680 Y3.985
+G1 X24.648 Y4.182
+G1 X24.613 Y4.380
+G1 X24.578 Y4.576
+G1 X24.540 Y4.773
+G1 X24.501 Y4.969
+G1 X24.461 Y5.165
+G1 X24.418 Y5.361
+G1 X24.375 Y5.556
+G1 X24.330 Y5.751
+G1 X24.283 Y5.946
+G1 X24.234 Y6.140
+G1 X24.184 Y6.333
+G1 X24.133 Y6.527
+G1 X24.080 Y6.720
+G1 X24.025 Y6.912
+G1 X23.969 Y7.104
+G1 X23.912 Y7.296
+G1 X23.853 Y7.487
+G1 X23.792 Y7.678
+G1 X23.730 Y7.868
+G1 X23.666 Y8.058
+G1 X23.601 Y8.247
+G1 X23.534 Y8.435
+G1 X23.466 Y8.624
+G1 X23.396 Y8.811
+G1 X23.325 Y8.998
+G1 X23.252 Y9.185
+G1 X23.178 Y9.370
+G1 X23.102 Y9.556
+G1 X23.025 Y9.740
+G1 X22.946 Y9.924
+G1 X22.866 Y10.107
+G1 X22.784 Y10.290
+G1 X22.701 Y10.472
+G1 X22.616 Y10.654
+G1 X22.530 Y10.834
+G1 X22.443 Y11.014
+G1 X22.354 Y11.193
+G1 X22.264 Y11.372
+G1 X22.172 Y11.550
+G1 X22.079 Y11.727
+G1 X21.984 Y11.903
+G1 X21.888 Y12.079
+G1 X21.791 Y12.254
+G1 X21.692 Y12.428
+G1 X21.592 Y12.601
+G1 X21.490 Y12.773
+G1 X21.388 Y12.945
+G1 X21.283 Y13.116
+G1 X21.178 Y13.286
+G1 X21.071 Y13.455
+G1 X20.962 Y13.623
+G1 X20.853 Y13.790
+G1 X20.741 Y13.957
+G1 X20.629 Y14.122
+G1 X20.515 Y14.287
+G1 X20.400 Y14.451
+G1 X20.284 Y14.614
+G1 X20.166 Y14.775
+G1 X20.048 Y14.936
+G1 X19.927 Y15.096
+G1 X19.806 Y15.255
+G1 X19.683 Y15.413
+G1 X19.559 Y15.570
+G1 X19.434 Y15.727
+G1 X19.307 Y15.882
+G1 X19.180 Y16.036
+G1 X19.051 Y16.189
+G1 X18.921 Y16.341
+G1 X18.789 Y16.491
+G1 X18.657 Y16.641
+G1 X18.523 Y16.790
+G1 X18.388 Y16.938
+G1 X18.252 Y17.084
+G1 X18.114 Y17.230
+G1 X17.976 Y17.374
+G1 X17.836 Y17.518
+G1 X17.695 Y17.660
+G1 X17.553 Y17.801
+G1 X17.410 Y17.941
+G1 X17.266 Y18.080
+G1 X17.121 Y18.217
+G1 X16.975 Y18.354
+G1 X16.827 Y18.489
+G1 X16.679 Y18.623
+G1 X16.529 Y18.756
+G1 X16.378 Y18.888
+G1 X16.227 Y19.018
+G1 X16.074 Y19.148
+G1 X15.920 Y19.276
+G1 X15.765 Y19.402
+G1 X15.610 Y19.528
+G1 X15.453 Y19.652
+G1 X15.295 Y19.775
+G1 X15.136 Y19.897
+G1 X14.976 Y20.018
+G1 X14.816 Y20.137
+G1 X14.654 Y20.255
+G1 X14.492 Y20.371
+G1 X14.328 Y20.487
+G1 X14.164 Y20.601
+G1 X13.998 Y20.713
+G1 X13.832 Y20.825
+G1 X13.665 Y20.935
+G1 X13.497 Y21.044
+G1 X13.328 Y21.151
+G1 X13.158 Y21.257
+G1 X12.988 Y21.362
+G1 X12.816 Y21.465
+G1 X12.644 Y21.567
+G1 X12.471 Y21.667
+G1 X12.297 Y21.766
+G1 X12.123 Y21.864
+G1 X11.947 Y21.960
+G1 X11.771 Y22.055
+G1 X11.594 Y22.149
+G1 X11.417 Y22.241
+G1 X11.238 Y22.332
+G1 X11.059 Y22.421
+G1 X10.879 Y22.509
+G1 X10.699 Y22.595
+G1 X10.518 Y22.680
+G1 X10.336 Y22.763
+G1 X10.153 Y22.845
+G1 X9.970 Y22.926
+G1 X9.786 Y23.005
+G1 X9.602 Y23.083
+G1 X9.417 Y23.159
+G1 X9.231 Y23.233
+G1 X9.045 Y23.306
+G1 X8.858 Y23.378
+G1 X8.671 Y23.448
+G1 X8.483 Y23.517
+G1 X8.294 Y23.584
+G1 X8.105 Y23.650
+G1 X7.915 Y23.714
+G1 X7.725 Y23.776
+G1 X7.535 Y23.837
+G1 X7.344 Y23.897
+G1 X7.152 Y23.955
+G1 X6.960 Y24.012
+G1 X6.768 Y24.066
+G1 X6.575 Y24.120
+G1 X6.382 Y24.172
+G1 X6.188 Y24.222
+G1 X5.994 Y24.271
+G1 X5.800 Y24.318
+G1 X5.605 Y24.364
+G1 X5.410 Y24.408
+G1 X5.214 Y24.450
+G1 X5.018 Y24.491
+G1 X4.822 Y24.531
+G1 X4.626 Y24.568
+G1 X4.429 Y24.605
+G1 X4.232 Y24.639
+G1 X4.034 Y24.672
+G1 X3.837 Y24.704
+G1 X3.639 Y24.734
+G1 X3.441 Y24.762
+G1 X3.242 Y24.789
+G1 X3.044 Y24.814
+G1 X2.845 Y24.838
+G1 X2.646 Y24.860
+G1 X2.447 Y24.880
+G1 X2.248 Y24.899
+G1 X2.049 Y24.916
+G1 X1.849 Y24.932
+G1 X1.650 Y24.946
+G1 X1.450 Y24.958
+G1 X1.250 Y24.969
+G1 X1.050 Y24.978
+G1 X0.850 Y24.986
+G1 X0.650 Y24.992
+G1 X0.450 Y24.996
+G1 X0.250 Y24.999
+G1 X0.050 Y25.000
+G1 X-0.150 Y25.000
+G1 X-0.350 Y24.998
+G1 X-0.550 Y24.994
+G1 X-0.750 Y24.989
+G1 X-0.950 Y24.982
+G1 X-1.150 Y24.974
+G1 X-1.350 Y24.964
+G1 X-1.550 Y24.952
+G1 X-1.749 Y24.939
+G1 X-1.949 Y24.924
+G1 X-2.148 Y24.908
+G1 X-2.348 Y24.890
+G1 X-2.547 Y24.870
+G1 X-2.746 Y24.849
+G1 X-2.945 Y24.826
+G1 X-3.143 Y24.802
+G1 X-3.342 Y24.776
+G1 X-3.540 Y24.748
+G1 X-3.738 Y24.719
+G1 X-3.936 Y24.688
+G1 X-4.133 Y24.656
+G1 X-4.330 Y24.622
+G1 X-4.527 Y24.587
+G1 X-4.724 Y24.550
+G1 X-4.920 Y24.511
+G1 X-5.116 Y24.471
+G1 X-5.312 Y24.429
+G1 X-5.507 Y24.386
+G1 X-5.702 Y24.341
+G1 X-5.897 Y24.295
+G1 X-6.091 Y24.247
+G1 X-6.285 Y24.197
+G1 X-6.479 Y24.146
+G1 X-6.672 Y24.093
+G1 X-6.864 Y24.039
+G1 X-7.056 Y23.983
+G1 X-7.248 Y23.926
+G1 X-7.439 Y23.867
+G1 X-7.630 Y23.807
+G1 X-7.821 Y23.745
+G1 X-8.010 Y23.682
+G1 X-8.200 Y23.617
+G1 X-8.388 Y23.551
+G1 X-8.577 Y23.483
+G1 X-8.764 Y23.413
+G1 X-8.951 Y23.342
+G1 X-9.138 Y23.270
+G1 X-9.324 Y23.196
+G1 X-9.509 Y23.121
+G1 X-9.694 Y23.044
+G1 X-9.878 Y22.966
+G1 X-10.062 Y22.886
+G1 X-10.245 Y22.805
+G1 X-10.427 Y22.722
+G1 X-10.608 Y22.638
+G1 X-10.789 Y22.552
+G1 X-10.969 Y22.465
+G1 X-11.149 Y22.376
+G1 X-11.327 Y22.287
+G1 X-11.505 Y22.195
+G1 X-11.683 Y22.102
+G1 X-11.859 Y22.008
+G1 X-12.035 Y21.912
+G1 X-12.210 Y21.815
+G1 X-12.384 Y21.717
+G1 X-12.558 Y21.617
+G1 X-12.730 Y21.516
+G1 X-12.902 Y21.413
+G1 X-13.073 Y21.309
+G1 X-13.243 Y21.204
+G1 X-13.413 Y21.097
+G1 X-13.581 Y20.989
+G1 X-13.749 Y20.880
+G1 X-13.915 Y20.769
+G1 X-14.081 Y20.657
+G1 X-14.246 Y20.544
+G1 X-14.410 Y20.429
+G1 X-14.573 Y20.313
+G1 X-14.735 Y20.196
+G1 X-14.896 Y20.077
+G1 X-15.056 Y19.958
+G1 X-15.216 Y19.836
+G1 X-15.374 Y19.714
+G1 X-15.531 Y19.590
+G1 X-15.688 Y19.465
+G1 X-15.843 Y19.339
+G1 X-15.997 Y19.212
+G1 X-16.150 Y19.083
+G1 X-16.303 Y18.953
+G1 X-16.454 Y18.822
+G1 X-16.604 Y18.690
+G1 X-16.753 Y18.556
+G1 X-16.901 Y18.422
+G1 X-17.048 Y18.286
+G1 X-17.194 Y18.149
+G1 X-17.338 Y18.011
+G1 X-17.482 Y17.871
+G1 X-17.625 Y17.731
+G1 X-17.766 Y17.589
+G1 X-17.906 Y17.446
+G1 X-18.045 Y17.302
+G1 X-18.183 Y17.157
+G1 X-18.320 Y17.011
+G1 X-18.455 Y16.864
+G1 X-18.590 Y16.716
+G1 X-18.723 Y16.567
+G1 X-18.855 Y16.416
+G1 X-18.986 Y16.265
+G1 X-19.115 Y16.112
+G1 X-19.244 Y15.959
+G1 X-19.371 Y15.804
+G1 X-19.497 Y15.649
+G1 X-19.621 Y15.492
+G1 X-19.745 Y15.335
+G1 X-19.867 Y15.176
+G1 X-19.988 Y15.017
+G1 X-20.107 Y14.856
+G1 X-20.225 Y14.695
+G1 X-20.342 Y14.532
+G1 X-20.458 Y14.369
+G1 X-20.572 Y14.205
+G1 X-20.685 Y14.040
+G1 X-20.797 Y13.874
+G1 X-20.908 Y13.707
+G1 X-21.017 Y13.539
+G1 X-21.124 Y13.370
+G1 X-21.231 Y13.201
+G1 X-21.336 Y13.030
+G1 X-21.439 Y12.859
+G1 X-21.541 Y12.687
+G1 X-21.642 Y12.514
+G1 X-21.742 Y12.341
+G1 X-21.840 Y12.166
+G1 X-21.937 Y11.991
+G1 X-22.032 Y11.815
+G1 X-22.126 Y11.639
+G1 X-22.218 Y11.461
+G1 X-22.309 Y11.283
+G1 X-22.399 Y11.104
+G1 X-22.487 Y10.924
+G1 X-22.574 Y10.744
+G1 X-22.659 Y10.563
+G1 X-22.743 Y10.381
+G1 X-22.825 Y10.199
+G1 X-22.906 Y10.016
+G1 X-22.985 Y9.832
+G1 X-23.063 Y9.648
+G1 X-23.140 Y9.463
+G1 X-23.215 Y9.277
+G1 X-23.288 Y9.091
+G1 X-23.360 Y8.905
+G1 X-23.431 Y8.717
+G1 X-23.500 Y8.530
+G1 X-23.567 Y8.341
+G1 X-23.633 Y8.152
+G1 X-23.698 Y7.963
+G1 X-23.761 Y7.773
+G1 X-23.822 Y7.583
+G1 X-23.882 Y7.392
+G1 X-23.941 Y7.200
+G1 X-23.998 Y7.008
+G1 X-24.053 Y6.816
+G1 X-24.107 Y6.623
+G1 X-24.159 Y6.430
+G1 X-24.210 Y6.237
+G1 X-24.259 Y6.043
+G1 X-24.306 Y5.848
+G1 X-24.352 Y5.654
+G1 X-24.397 Y5.458
+G1 X-24.440 Y5.263
+G1 X-24.481 Y5.067
+G1 X-24.521 Y4.871
+G1 X-24.559 Y4.675
+G1 X-24.596 Y4.478
+G1 X-24.631 Y4.281
+G1 X-24.664 Y4.084
+G1 X-24.696 Y3.886
+G1 X-24.726 Y3.688
+G1 X-24.755 Y3.490
+G1 X-24.782 Y3.292
+G1 X-24.808 Y3.094
+G1 X-24.832 Y2.895
+G1 X-24.854 Y2.696
+G1 X-24.875 Y2.497
+G1 X-24.894 Y2.298
+G1 X-24.912 Y2.099
+G1 X-24.928 Y1.899
+G1 X-24.942 Y1.700
+G1 X-24.955 Y1.500
+G1 X-24.966 Y1.300
+G1 X-24.976 Y1.100
+G1 X-24.984 Y0.900
+G1 X-24.990 Y0.700
+G1 X-24.995 Y0.500
+G1 X-24.998 Y0.300
+G1 X-25.000 Y0.100
+G1 X-25.000 Y-0.100
+G1 X-24.998 Y-0.300
+G1 X-24.995 Y-0.500
+G1 X-24.990 Y-0.700
+G1 X-24.984 Y-0.900
+G1 X-24.976 Y-1.100
+G1 X-24.966 Y-1.300
+G1 X-24.955 Y-1.500
+G1 X-24.942 Y-1.700
+G1 X-24.928 Y-1.899
+G1 X-24.912 Y-2.099
+G1 X-24.894 Y-2.298
+G1 X-24.875 Y-2.497
+G1 X-24.854 Y-2.696
+G1 X-24.832 Y-2.895
+G1 X-24.808 Y-3.094
+G1 X-24.782 Y-3.292
+G1 X-24.755 Y-3.490
+G1 X-24.726 Y-3.688
+G1 X-24.696 Y-3.886
+G1 X-24.664 Y-4.084
+G1 X-24.631 Y-4.281
+G1 X-24.596 Y-4.478
+G1 X-24.559 Y-4.675
+G1 X-24.521 Y-4.871
+G1 X-24.481 Y-5.067
+G1 X-24.440 Y-5.263
+G1 X-24.397 Y-5.458
+G1 X-24.352 Y-5.654
+G1 X-24.306 Y-5.848
+G1 X-24.259 Y-6.043
+G1 X-24.210 Y-6.237
+G1 X-24.159 Y-6.430
+G1 X-24.107 Y-6.623
+G1 X-24.053 Y-6.816
+G1 X-23.998 Y-7.008
+G1 X-23.941 Y-7.200
+G1 X-23.882 Y-7.392
+G1 X-23.822 Y-7.583
+G1 X-23.761 Y-7.773
+G1 X-23.698 Y-7.963
+G1 X-23.633 Y-8.152
+G1 X-23.567 Y-8.341
+G1 X-23.500 Y-8.530
+G1 X-23.431 Y-8.717
+G1 X-23.360 Y-8.905
+G1 X-23.288 Y-9.091
+G1 X-23.215 Y-9.277
+G1 X-23.140 Y-9.463
+G1 X-23.063 Y-9.648
+G1 X-22.985 Y-9.832
+G1 X-22.906 Y-10.016
+G1 X-22.825 Y-10.199
+G1 X-22.743 Y-10.381
+G1 X-22.659 Y-10.563
+G1 X-22.574 Y-10.744
+G1 X-22.487 Y-10.924
+G1 X-22.399 Y-11.104
+G1 X-22.309 Y-11.283
+G1 X-22.218 Y-11.461
+G1 X-22.126 Y-11.639
+G1 X-22.032 Y-11.815
+G1 X-21.937 Y-11.991
+G1 X-21.840 Y-12.166
+G1 X-21.742 Y-12.341
+G1 X-21.642 Y-12.514
+G1 X-21.541 Y-12.687
+G1 X-21.439 Y-12.859
+G1 X-21.336 Y-13.030
+G1 X-21.231 Y-13.201
+G1 X-21.124 Y-13.370
+G1 X-21.017 Y-13.539
+G1 X-20.908 Y-13.707
+G1 X-20.797 Y-13.874
+G1 X-20.685 Y-14.040
+G1 X-20.572 Y-14.205
+G1 X-20.458 Y-14.369
+G1 X-20.342 Y-14.532
+G1 X-20.225 Y-14.695
+G1 X-20.107 Y-14.856
+G1 X-19.988 Y-15.017
+G1 X-19.867 Y-15.176
+G1 X-19.745 Y-15.335
+G1 X-19.621 Y-15.492
+G1 X-19.497 Y-15.649
+G1 X-19.371 Y-15.804
+G1 X-19.244 Y-15.959
+G1 X-19.115 Y-16.112
+G1 X-18.986 Y-16.265
+G1 X-18.855 Y-16.416
+G1 X-18.723 Y-16.567
+G1 X-18.590 Y-16.716
+G1 X-18.455 Y-16.864
+G1 X-18.320 Y-17.011
+G1 X-18.183 Y-17.157
+G1 X-18.045 Y-17.302
+G1 X-17.906 Y-17.446
+G1 X-17.766 Y-17.589
+G1 X-17.625 Y-17.731
+G1 X-17.482 Y-17.871
+G1 X-17.338 Y-18.011
+G1 X-17.194 Y-18.149
+G1 X-17.048 Y-18.286
+G1 X-16.901 Y-18.422
+G1 X-16.753 Y-18.556
+G1 X-16.604 Y-18.690
+G1 X-16.454 Y-18.822
+G1 X-16.303 Y-18.953
+G1 X-16.150 Y-19.083
+G1 X-15.997 Y-19.212
+G1 X-15.843 Y-19.339
+G1 X-15.688 Y-19.465
+G1 X-15.531 Y-19.590
+G1 X-15.374 Y-19.714
+G1 X-15.216 Y-19.836
+G1 X-15.056 Y-19.958
+G1 X-14.896 Y-20.077
+G1 X-14.735 Y-20.196
+G1 X-14.573 Y-20.313
+G1 X-14.410 Y-20.429
+G1 X-14.246 Y-20.544
+G1 X-14.081 Y-20.657
+G1 X-13.915 Y-20.769
+G1 X-13.749 Y-20.880
+G1 X-13.581 Y-20.989
+G1 X-13.413 Y-21.097
+G1 X-13.243 Y-21.204
+G1 X-13.073 Y-21.309
+G1 X-12.902 Y-21.413
+G1 X-12.730 Y-21.516
+G1 X-12.558 Y-21.617
+G1 X-12.384 Y-21.717
+G1 X-12.210 Y-21.815
+G1 X-12.035 Y-21.912
+G1 X-11.859 Y-22.008
+G1 X-11.683 Y-22.102
+G1 X-11.505 Y-22.195
+G1 X-11.327 Y-22.287
+G1 X-11.149 Y-22.376
+G1 X-10.969 Y-22.465
+G1 X-10.789 Y-22.552
+G1 X-10.608 Y-22.638
+G1 X-10.427 Y-22.722
+G1 X-10.245 Y-22.805
+G1 X-10.062 Y-22.886
+G1 X-9.878 Y-22.966
+G1 X-9.694 Y-23.044
+G1 X-9.509 Y-23.121
+G1 X-9.324 Y-23.196
+G1 X-9.138 Y-23.270
+G1 X-8.951 Y-23.342
+G1 X-8.764 Y-23.413
+G1 X-8.577 Y-23.483
+G1 X-8.388 Y-23.551
+G1 X-8.200 Y-23.617
+G1 X-8.010 Y-23.682
+G1 X-7.821 Y-23.745
+G1 X-7.630 Y-23.807
+G1 X-7.439 Y-23.867
+G1 X-7.248 Y-23.926
+G1 X-7.056 Y-23.983
+G1 X-6.864 Y-24.039
+G1 X-6.672 Y-24.093
+G1 X-6.479 Y-24.146
+G1 X-6.285 Y-24.197
+G1 X-6.091 Y-24.247
+G1 X-5.897 Y-24.295
+G1 X-5.702 Y-24.341
+G1 X-5.507 Y-24.386
+G1 X-5.312 Y-24.429
+G1 X-5.116 Y-24.471
+G1 X-4.920 Y-24.511
+G1 X-4.724 Y-24.550
+G1 X-4.527 Y-24.587
+G1 X-4.330 Y-24.622
+G1 X-4.133 Y-24.656
+G1 X-3.936 Y-24.688
+G1 X-3.738 Y-24.719
+G1 X-3.540 Y-24.748
+G1 X-3.342 Y-24.776
+G1 X-3.143 Y-24.802
+G1 X-2.945 Y-24.826
+G1 X-2.746 Y-24.849
+G1 X-2.547 Y-24.870
+G1 X-2.348 Y-24.890
+G1 X-2.148 Y-24.908
+G1 X-1.949 Y-24.924
+G1 X-1.749 Y-24.939
+G1 X-1.550 Y-24.952
+G1 X-1.350 Y-24.964
+G1 X-1.150 Y-24.974
+G1 X-0.950 Y-24.982
+G1 X-0.750 Y-24.989
+G1 X-0.550 Y-24.994
+G1 X-0.350 Y-24.998
+G1 X-0.150 Y-25.000
+G1 X0.050 Y-25.000
+G1 X0.250 Y-24.999
+G1 X0.450 Y-24.996
+G1 X0.650 Y-24.992
+G1 X0.850 Y-24.986
+G1 X1.050 Y-24.978
+G1 X1.250 Y-24.969
+G1 X1.450 Y-24.958
+G1 X1.650 Y-24.946
+G1 X1.849 Y-24.932
+G1 X2.049 Y-24.916
+G1 X2.248 Y-24.899
+G1 X2.447 Y-24.880
+G1 X2.646 Y-24.860
+G1 X2.845 Y-24.838
+G1 X3.044 Y-24.814
+G1 X3.242 Y-24.789
+G1 X3.441 Y-24.762
+G1 X3.639 Y-24.734
+G1 X3.837 Y-24.704
+G1 X4.034 Y-24.672
+G1 X4.232 Y-24.639
+G1 X4.429 Y-24.605
+G1 X4.626 Y-24.568
+G1 X4.822 Y-24.531
+G1 X5.018 Y-24.491
+G1 X5.214 Y-24.450
+G1 X5.410 Y-24.408
+G1 X5.605 Y-24.364
+G1 X5.800 Y-24.318
+G1 X5.994 Y-24.271
+G1 X6.188 Y-24.222
+G1 X6.382 Y-24.172
+G1 X6.575 Y-24.120
+G1 X6.768 Y-24.066
+G1 X6.960 Y-24.012
+G1 X7.152 Y-23.955
+G1 X7.344 Y-23.897
+G1 X7.535 Y-23.837
+G1 X7.725 Y-23.776
+G1 X7.915 Y-23.714
+G1 X8.105 Y-23.650
+G1 X8.294 Y-23.584
+G1 X8.483 Y-23.517
+G1 X8.671 Y-23.448
+G1 X8.858 Y-23.378
+G1 X9.045 Y-23.306
+G1 X9.231 Y-23.233
+G1 X9.417 Y-23.159
+G1 X9.602 Y-23.083
+G1 X9.786 Y-23.005
+G1 X9.970 Y-22.926
+G1 X10.153 Y-22.845
+G1 X10.336 Y-22.763
+G1 X10.518 Y-22.680
+G1 X10.699 Y-22.595
+G1 X10.879 Y-22.509
+G1 X11.059 Y-22.421
+G1 X11.238 Y-22.332
+G1 X11.417 Y-22.241
+G1 X11.594 Y-22.149
+G1 X11.771 Y-22.055
+G1 X11.947 Y-21.960
+G1 X12.123 Y-21.864
+G1 X12.297 Y-21.766
+G1 X12.471 Y-21.667
+G1 X12.644 Y-21.567
+G1 X12.816 Y-21.465
+G1 X12.988 Y-21.362
+G1 X13.158 Y-21.257
+G1 X13.328 Y-21.151
+G1 X13.497 Y-21.044
+G1 X13.665 Y-20.935
+G1 X13.832 Y-20.825
+G1 X13.998 Y-20.713
+G1 X14.164 Y-20.601
+G1 X14.328 Y-20.487
+G1 X14.492 Y-20.371
+G1 X14.654 Y-20.255
+G1 X14.816 Y-20.137
+G1 X14.976 Y-20.018
+G1 X15.136 Y-19.897
+G1 X15.295 Y-19.775
+G1 X15.453 Y-19.652
+G1 X15.610 Y-19.528
+G1 X15.765 Y-19.402
+G1 X15.920 Y-19.276
+G1 X16.074 Y-19.148
+G1 X16.227 Y-19.018
+G1 X16.378 Y-18.888
+G1 X16.529 Y-18.756
+G1 X16.679 Y-18.623
+G1 X16.827 Y-18.489
+G1 X16.975 Y-18.354
+G1 X17.121 Y-18.217
+G1 X17.266 Y-18.080
+G1 X17.410 Y-17.941
+G1 X17.553 Y-17.801
+G1 X17.695 Y-17.660
+G1 X17.836 Y-17.518
+G1 X17.976 Y-17.374
+G1 X18.114 Y-17.230
+G1 X18.252 Y-17.084
+G1 X18.388 Y-16.938
+G1 X18.523 Y-16.790
+G1 X18.657 Y-16.641
+G1 X18.789 Y-16.491
+G1 X18.921 Y-16.341
+G1 X19.051 Y-16.189
+G1 X19.180 Y-16.036
+G1 X19.307 Y-15.882
+G1 X19.434 Y-15.727
+G1 X19.559 Y-15.570
+G1 X19.683 Y-15.413
+G1 X19.806 Y-15.255
+G1 X19.927 Y-15.096
+G1 X20.048 Y-14.936
+G1 X20.166 Y-14.775
+G1 X20.284 Y-14.614
+G1 X20.400 Y-14.451
+G1 X20.515 Y-14.287
+G1 X20.629 Y-14.122
+G1 X20.741 Y-13.957
+G1 X20.853 Y-13.790
+G1 X20.962 Y-13.623
+G1 X21.071 Y-13.455
+G1 X21.178 Y-13.286
+G1 X21.283 Y-13.116
+G1 X21.388 Y-12.945
+G1 X21.490 Y-12.773
+G1 X21.592 Y-12.601
+G1 X21.692 Y-12.428
+G1 X21.791 Y-12.254
+G1 X21.888 Y-12.079
+G1 X21.984 Y-11.903
+G1 X22.079 Y-11.727
+G1 X22.172 Y-11.550
+G1 X22.264 Y-11.372
+G1 X22.354 Y-11.193
+G1 X22.443 Y-11.014
+G1 X22.530 Y-10.834
+G1 X22.616 Y-10.654
+G1 X22.701 Y-10.472
+G1 X22.784 Y-10.290
+G1 X22.866 Y-10.107
+G1 X22.946 Y-9.924
+G1 X23.025 Y-9.740
+G1 X23.102 Y-9.556
+G1 X23.178 Y-9.370
+G1 X23.252 Y-9.185
+G1 X23.325 Y-8.998
+G1 X23.396 Y-8.811
+G1 X23.466 Y-8.624
+G1 X23.534 Y-8.435
+G1 X23.601 Y-8.247
+G1 X23.666 Y-8.058
+G1 X23.730 Y-7.868
+G1 X23.792 Y-7.678
+G1 X23.853 Y-7.487
+G1 X23.912 Y-7.296
+G1 X23.969 Y-7.104
+G1 X24.025 Y-6.912
+G1 X24.080 Y-6.720
+G1 X24.133 Y-6.527
+G1 X24.184 Y-6.333
+G1 X24.234 Y-6.140
+G1 X24.283 Y-5.946
+G1 X24.330 Y-5.751
+G1 X24.375 Y-5.556
+G1 X24.418 Y-5.361
+G1 X24.461 Y-5.165
+G1 X24.501 Y-4.969
+G1 X24.540 Y-4.773
+G1 X24.578 Y-4.576
+G1 X24.613 Y-4.380
+G1 X24.648 Y-4.182
+G1 X24.680 Y-3.985
+G1 X24.711 Y-3.787
+G1 X24.741 Y-3.589
+G1 X24.769 Y-3.391
+G1 X24.795 Y-3.193
+G1 X24.820 Y-2.994
+G1 X24.843 Y-2.796
+G1 X24.865 Y-2.597
+G1 X24.885 Y-2.398
+G1 X24.903 Y-2.198
+G1 X24.920 Y-1.999
+G1 X24.935 Y-1.799
+G1 X24.949 Y-1.600
+G1 X24.961 Y-1.400
+G1 X24.971 Y-1.200
+G1 X24.980 Y-1.000
+G1 X24.987 Y-0.800
+G1 X24.993 Y-0.600
+G1 X24.997 Y-0.400
+G1 X24.999 Y-0.200
+G1 X25.000 Y-0.000
+G0 X0 Y0
+M2
@@ -0,0 +1,13 @@
+$110=6000
+$111=6000
+$120=1000
+$121=1000
+G21 G90 G94
+G1 X20 F6000
+G4 P0.3
+G1 X0
+G4 P0.3
+G1 X20 Y20
+G4 P0.3
+G1 X0 Y0
+G4 P0.3
@@ -0,0 +1,70 @@
+; 40x30 mm zigzag at 1000 mm/min, 1 mm step-over, with a Z plunge
+G21 G90 G94
+G0 Z2
+G0 X0 Y0
+G1 Z-1 F300
+F1000
+G1 X40 Y0
+G1 Y1
+G1 X0 Y1
+G1 Y2
+G1 X40 Y2
+G1 Y3
+G1 X0 Y3
+G1 Y4
+G1 X40 Y4
+G1 Y5
+G1 X0 Y5
+G1 Y6
+G1 X40 Y6
+G1 Y7
+G1 X0 Y7
+G1 Y8
+G1 X40 Y8
+G1 Y9
+G1 X0 Y9
+G1 Y10
+G1 X40 Y10
+G1 Y11
+G1 X0 Y11
+G1 Y12
+G1 X40 Y12
+G1 Y13
+G1 X0 Y13
+G1 Y14
+G1 X40 Y14
+G1 Y15
+G1 X0 Y15
+G1 Y16
+G1 X40 Y16
+G1 Y17
+G1 X0 Y17
+G1 Y18
+G1 X40 Y18
+G1 Y19
+G1 X0 Y19
+G1 Y20
+G1 X40 Y20
+G1 Y21
+G1 X0 Y21
+G1 Y22
+G1 X40 Y22
+G1 Y23
+G1 X0 Y23
+G1 Y24
+G1 X40 Y24
+G1 Y25
+G1 X0 Y25
+G1 Y26
+G1 X40 Y26
+G1 Y27
+G1 X0 Y27
+G1 Y28
+G1 X40 Y28
+G1 Y29
+G1 X0 Y29
+G1 Y30
+G1 X40 Y30
+G0 Z2
+G0 X0 Y0
+M2
@@ -0,0 +1,36 @@
+/*
+  avr/interrupt.h - interrupt handlers as plain functions, for the host simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef avr_interrupt_h
+#define avr_interrupt_h
+
+#include <avr/io.h>
+
+// ISR(TIMER1_COMPA_vect) defines a function TIMER1_COMPA_vect(), which the simulator calls
+// when the timer would have interrupted the main program.
+#define ISR(vector, ...) void vector(void)
+
+void TIMER1_COMPA_vect(void);
+void TIMER0_OVF_vect(void);
+void TIMER0_COMPA_vect(void);
+
+// The simulator runs interrupts only where the main program waits, so there is nothing to mask.
+#define sei() (SREG |= 0x80)
+#define cli() (SREG &= ~0x80)
+
+#endif
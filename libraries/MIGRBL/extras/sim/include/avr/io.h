@@ -0,0 +1,125 @@
+/*
+  avr/io.h - ATmega328p registers as plain variables, for the host simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Grbl reads and writes these as it would on the chip. Only the simulator gives them meaning:
+// it runs the timer interrupts from TCCR1B, OCR1A, TIMSK1, TCCR0B, TCNT0 and TIMSK0, and reads
+// the step and direction pins from the STEP_PORT and DIRECTION_PORT ports after each of them.
+
+#ifndef avr_io_h
+#define avr_io_h
+
+#include <stdint.h>
+
+// X(name, type). Defined once, in simulator.c.
+#define SIM_REGISTERS(X) \
+  X(PINB, uint8_t) X(DDRB, uint8_t) X(PORTB, uint8_t) \
+  X(PINC, uint8_t) X(DDRC, uint8_t) X(PORTC, uint8_t) \
+  X(PIND, uint8_t) X(DDRD, uint8_t) X(PORTD, uint8_t) \
+  X(TCCR0A, uint8_t) X(TCCR0B, uint8_t) X(TCNT0, uint8_t) X(OCR0A, uint8_t) X(OCR0B, uint8_t) \
+  X(TIMSK0, uint8_t) X(TIFR0, uint8_t) \
+  X(TCCR1A, uint8_t) X(TCCR1B, uint8_t) X(TCCR1C, uint8_t) X(TCNT1, uint16_t) \
+  X(OCR1A, uint16_t) X(OCR1B, uint16_t) X(TIMSK1, uint8_t) X(TIFR1, uint8_t) \
+  X(TCCR2A, uint8_t) X(TCCR2B, uint8_t) X(TCNT2, uint8_t) X(OCR2A, uint8_t) X(OCR2B, uint8_t) \
+  X(TIMSK2, uint8_t) \
+  X(PCICR, uint8_t) X(PCMSK0, uint8_t) X(PCMSK1, uint8_t) X(PCMSK2, uint8_t) \
+  X(WDTCSR, uint8_t) X(MCUSR, uint8_t) \
+  X(EECR, uint8_t) X(EEDR, uint8_t) X(EEAR, uint16_t) X(SPMCSR, uint8_t) \
+  X(UCSR0A, uint8_t) X(UCSR0B, uint8_t) X(UCSR0C, uint8_t) X(UBRR0H, uint8_t) \
+  X(UBRR0L, uint8_t) X(UDR0, uint8_t) \
+  X(SREG, uint8_t)
+
+#define SIM_DECLARE_REGISTER(name, type) extern volatile type name;
+SIM_REGISTERS(SIM_DECLARE_REGISTER)
+
+// Timer/Counter 0
+#define WGM00 0
+#define WGM01 1
+#define COM0B0 4
+#define COM0B1 5
+#define COM0A0 6
+#define COM0A1 7
+#define CS00 0
+#define CS01 1
+#define CS02 2
+#define WGM02 3
+#define TOIE0 0
+#define OCIE0A 1
+#define OCIE0B 2
+
+// Timer/Counter 1
+#define WGM10 0
+#define WGM11 1
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM12 3
+#define WGM13 4
+#define TOIE1 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCF1A 1
+
+// Timer/Counter 2
+#define WGM20 0
+#define WGM21 1
+#define COM2B0 4
+#define COM2B1 5
+#define COM2A0 6
+#define COM2A1 7
+#define CS20 0
+#define CS21 1
+#define CS22 2
+#define WGM22 3
+#define WGM23 4 // Not on the chip, but named by cpu_map_atmega328p.h
+
+// Pin change interrupts
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+
+// Watchdog
+#define WDP0 0
+#define WDP1 1
+#define WDP2 2
+#define WDE 3
+#define WDCE 4
+#define WDP3 5
+#define WDIE 6
+#define WDIF 7
+
+// EEPROM
+#define EERE 0
+#define EEPE 1
+#define EEMPE 2
+#define EERIE 3
+#define EEPM0 4
+#define EEPM1 5
+#define SELFPRGEN 0
+
+// USART 0
+#define U2X0 1
+#define UDRIE0 5
+#define RXCIE0 7
+#define TXEN0 3
+#define RXEN0 4
+
+#endif
@@ -0,0 +1,28 @@
+/*
+  util/delay.h - busy waits that pass simulated time, for the host simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef util_delay_h
+#define util_delay_h
+
+// Runs any interrupts that fall due meanwhile, as the chip would. See simulator.c.
+void sim_delay_us(double us);
+
+#define _delay_ms(ms) sim_delay_us((ms)*1000.0)
+#define _delay_us(us) sim_delay_us(us)
+
+#endif
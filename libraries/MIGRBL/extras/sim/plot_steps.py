@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Plots the step rate of one axis from step logs of grbl_sim -s, as an SVG file.
+
+Each step's rate is one over the time since the step before on that axis, in mm/min, signed by its
+direction. Give several logs to compare them, such as the same file run with and without a shaper:
+
+    build/grbl_sim -s plain.csv ring.nc
+    build/grbl_sim -s shaped.csv shaped.nc
+    plot_steps.py -a X -o rate.svg plain.csv shaped.csv
+
+Needs nothing outside the standard library.
+"""
+
+import argparse
+import csv
+import math
+import sys
+
+COLORS = ['#1f77b4', '#d62728', '#2ca02c', '#9467bd', '#ff7f0e', '#8c564b']
+WIDTH, HEIGHT = 900, 360
+LEFT, RIGHT, TOP, BOTTOM = 70, 20, 20, 40
+
+
+def rates(path, axis, steps_per_mm):
+    """(time in s, rate in mm/min) for each step of axis but the first"""
+    points = []
+    last = None
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            if row['axis'] != axis:
+                continue
+            t = float(row['t_us'])
+            if last is not None and t > last:
+                rate = 60e6/(t-last)/steps_per_mm
+                points.append((t/1e6, rate if row['dir'] == '1' else -rate))
+            last = t
+    return points
+
+
+def ticks(low, high, count=6):
+    """Round values for the grid lines between low and high"""
+    span = (high-low) or 1.0
+    step = 10 ** math.floor(math.log10(span/count))
+    for factor in (1, 2, 5, 10):
+        if span/(step*factor) <= count:
+            step *= factor
+            break
+    first = int(low/step) * step
+    return [first + n*step for n in range(int((high-first)/step)+1) if first + n*step >= low]
+
+
+def svg(traces, names, start, end):
+    points = [p for trace in traces for p in trace if start <= p[0] <= end]
+    if not points:
+        sys.exit('no steps on that axis in that time')
+    t0, t1 = start, min(end, max(p[0] for p in points))
+    r0, r1 = min(0.0, min(p[1] for p in points)), max(0.0, max(p[1] for p in points))
+
+    def x(t):
+        return LEFT + (t-t0)/((t1-t0) or 1.0)*(WIDTH-LEFT-RIGHT)
+
+    def y(r):
+        return TOP + (r1-r)/((r1-r0) or 1.0)*(HEIGHT-TOP-BOTTOM)
+
+    out = ['<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" font-family="sans-serif" '
+           'font-size="11">' % (WIDTH, HEIGHT),
+           '<rect width="100%" height="100%" fill="white"/>']
+    for t in ticks(t0, t1):
+        out.append('<line x1="%.1f" y1="%d" x2="%.1f" y2="%d" stroke="#ddd"/>' % (x(t), TOP, x(t), HEIGHT-BOTTOM))
+        out.append('<text x="%.1f" y="%d" text-anchor="middle">%g</text>' % (x(t), HEIGHT-BOTTOM+14, round(t, 6)))
+    for r in ticks(r0, r1):
+        out.append('<line x1="%d" y1="%.1f" x2="%d" y2="%.1f" stroke="#ddd"/>' % (LEFT, y(r), WIDTH-RIGHT, y(r)))
+        out.append('<text x="%d" y="%.1f" text-anchor="end">%g</text>' % (LEFT-4, y(r)+4, round(r, 6)))
+    out.append('<text x="%d" y="%d" text-anchor="middle">s</text>' % ((LEFT+WIDTH-RIGHT)//2, HEIGHT-6))
+    out.append('<text x="14" y="%d" transform="rotate(-90 14 %d)" text-anchor="middle">mm/min</text>'
+               % ((TOP+HEIGHT-BOTTOM)//2, (TOP+HEIGHT-BOTTOM)//2))
+    for idx, (trace, name) in enumerate(zip(traces, names)):
+        color = COLORS[idx % len(COLORS)]
+        path = ' '.join('%.1f,%.1f' % (x(t), y(r)) for t, r in trace if t0 <= t <= t1)
+        out.append('<polyline points="%s" fill="none" stroke="%s" stroke-width="1"/>' % (path, color))
+        out.append('<text x="%d" y="%d" fill="%s">%s</text>' % (LEFT+8, TOP+14+14*idx, color, name))
+    out.append('</svg>')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('logs', nargs='+', help='step logs, as grbl_sim -s writes them')
+    parser.add_argument('-a', '--axis', default='X', choices='XYZ')
+    parser.add_argument('-m', '--steps-per-mm', type=float, default=250.0, help='as $100-$102 (default 250)')
+    parser.add_argument('--start', type=float, default=0.0, help='seconds')
+    parser.add_argument('--end', type=float, default=float('inf'), help='seconds')
+    parser.add_argument('-o', '--output', default='steps.svg')
+    args = parser.parse_args()
+    traces = [rates(path, args.axis, args.steps_per_mm) for path in args.logs]
+    with open(args.output, 'w') as f:
+        f.write(svg(traces, args.logs, args.start, args.end))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
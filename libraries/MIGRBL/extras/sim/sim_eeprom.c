@@ -0,0 +1,64 @@
+/*
+  sim_eeprom.c - EEPROM of the host simulator, in RAM
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Takes the place of eeprom.c. Starts erased, so each run begins with the default settings; put
+// '$' setting lines at the top of the G-code to change them.
+
+#include "grbl.h"
+
+#define EEPROM_SIZE 1024 // ATmega328p
+
+static unsigned char eeprom[EEPROM_SIZE];
+static unsigned char erased = false;
+
+
+unsigned char eeprom_get_char(unsigned int addr)
+{
+  if (!erased) { memset(eeprom, 0xff, EEPROM_SIZE); erased = true; }
+  return(eeprom[addr % EEPROM_SIZE]);
+}
+
+
+void eeprom_put_char(unsigned int addr, unsigned char new_value)
+{
+  if (!erased) { memset(eeprom, 0xff, EEPROM_SIZE); erased = true; }
+  eeprom[addr % EEPROM_SIZE] = new_value;
+}
+
+
+// As eeprom.c
+void memcpy_to_eeprom_with_checksum(unsigned int destination, char *source, unsigned int size) {
+  unsigned char checksum = 0;
+  for(; size > 0; size--) {
+    checksum = (checksum << 1) || (checksum >> 7);
+    checksum += *source;
+    eeprom_put_char(destination++, *(source++));
+  }
+  eeprom_put_char(destination, checksum);
+}
+
+int memcpy_from_eeprom_with_checksum(char *destination, unsigned int source, unsigned int size) {
+  unsigned char data, checksum = 0;
+  for(; size > 0; size--) {
+    data = eeprom_get_char(source++);
+    checksum = (checksum << 1) || (checksum >> 7);
+    checksum += data;
+    *(destination++) = data;
+  }
+  return(checksum == eeprom_get_char(source));
+}
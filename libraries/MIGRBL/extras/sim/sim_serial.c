@@ -0,0 +1,402 @@
+/*
+  sim_serial.c - serial port of the host simulator, with a G-code sender on its other end
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Takes the place of serial.c. Grbl's side keeps the RX buffer and picks off realtime commands as
+// the USART interrupt does; what Grbl writes goes straight to the sender. The sender streams the
+// file as a host would: each character takes 10 bit times, and a line is only started if Grbl's
+// RX buffer has room for it, counting the characters of lines not yet answered (stream.py's
+// character counting). A response takes its own length in bit times to reach the sender.
+//
+// Built with BINARY_STREAMING, a file of binary stream frames, as extras/stream_binary.py --write
+// makes them, is sent a frame at a time in the same way, and Grbl's acks answer them. See stream.h.
+
+#include "simulator.h"
+#include <errno.h>
+
+#define SIM_ACK_QUEUE 256
+
+uint8_t sim_verbose = false;
+uint32_t sim_errors = 0, sim_alarms = 0, sim_rx_overflows = 0;
+
+static uint8_t rx_buffer[RX_BUFFER_SIZE];
+static uint8_t rx_head = 0, rx_tail = 0;
+static uint8_t idle_reads = false; // SERIAL_NO_DATA before, too
+static uint32_t lines_read = 0; // Newlines Grbl's main loop has read
+#ifdef BINARY_STREAMING
+  #define SIM_FRAME_LENGTH 0xFF
+  static uint8_t rx_frame_bytes = 0;   // Of a frame still to come, as serial.c counts them
+  static uint8_t read_frame_bytes = 0; // Of a frame still to be read by the main loop
+#endif
+
+// Sender
+static uint8_t **lines = NULL;      // Each ends in '\n', or is a frame
+static uint32_t *line_length = NULL;
+static char **line_text = NULL;     // For the reports
+static uint32_t line_count = 0;
+static uint32_t next_line = 0;     // Next to send
+static uint32_t next_char = 0;     // Of the line being sent, 0 when between lines
+static uint8_t send_response;
+static double char_cycles;
+static uint64_t tx_free = 0;       // When the line is free for the next character
+static uint64_t char_at = SIM_NEVER; // When the character being sent arrives
+static uint32_t outstanding = 0;   // Characters sent and not yet answered
+static uint32_t sent_length[SIM_ACK_QUEUE]; // Of each line not yet answered
+static uint64_t ack_at[SIM_ACK_QUEUE];      // When its answer reaches the sender, SIM_NEVER before
+static uint32_t sent_head = 0, sent_tail = 0, ack_head = 0;
+
+// Grbl's response being written
+static char response[128];
+static uint8_t response_length = 0;
+#ifdef BINARY_STREAMING
+  static uint8_t response_frame = false;
+#endif
+
+
+static void add_line(uint8_t *data, uint32_t length, char *text)
+{
+  static uint32_t size = 0;
+  if (line_count == size) {
+    size = size ? 2*size : 256;
+    lines = realloc(lines, size*sizeof(uint8_t *));
+    line_length = realloc(line_length, size*sizeof(uint32_t));
+    line_text = realloc(line_text, size*sizeof(char *));
+  }
+  lines[line_count] = data;
+  line_length[line_count] = length;
+  line_text[line_count] = text;
+  line_count++;
+}
+
+
+#ifdef BINARY_STREAMING
+// What a frame asks for, for the reports
+static char *frame_text(const uint8_t *frame)
+{
+  uint8_t length = frame[1]-STREAM_LENGTH_MIN;
+  uint8_t type = frame[3];
+  const uint8_t *payload = &frame[4];
+  char text[128];
+  switch (type) {
+    case STREAM_TYPE_OPEN: return(strdup("(open)"));
+    case STREAM_TYPE_CLOSE: return(strdup("(close)"));
+    case STREAM_TYPE_LINE:
+      snprintf(text, sizeof(text), "%.*s", length, (const char *)payload);
+      return(strdup(text));
+    case STREAM_TYPE_RAPID: case STREAM_TYPE_LINEAR: {
+      uint8_t n = snprintf(text, sizeof(text), (type == STREAM_TYPE_RAPID) ? "G0" : "G1");
+      uint8_t idx, at = 1;
+      float value;
+      for (idx=0; idx<=N_AXIS && at+sizeof(float) <= length; idx++) {
+        if (idx == N_AXIS) {
+          if (type == STREAM_TYPE_RAPID || bit_isfalse(payload[0],STREAM_MASK_FEED_RATE)) { break; }
+        } else if (bit_isfalse(payload[0],bit(idx))) {
+          continue;
+        }
+        memcpy(&value, &payload[at], sizeof(float));
+        at += sizeof(float);
+        n += snprintf(&text[n], sizeof(text)-n, "%c%.3f", "XYZF"[idx], value);
+      }
+      return(strdup(text));
+    }
+  }
+  return(strdup("(frame)"));
+}
+
+
+static uint8_t open_frames(FILE *f)
+{
+  int c;
+  while ((c = fgetc(f)) != EOF) {
+    int length = fgetc(f);
+    if (c != STREAM_SYNC || length < STREAM_LENGTH_MIN || length > STREAM_LENGTH_MAX) { return(false); }
+    uint8_t *frame = malloc(length+2);
+    frame[0] = c;
+    frame[1] = length;
+    if (fread(&frame[2], 1, length, f) != (size_t)length) { return(false); }
+    add_line(frame, length+2, frame_text(frame));
+  }
+  return(true);
+}
+#endif
+
+
+uint8_t sim_serial_open(const char *path, uint32_t baud, uint8_t one_at_a_time)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) { return(false); }
+  send_response = one_at_a_time;
+  char_cycles = 10.0*F_CPU/baud;
+  #ifdef BINARY_STREAMING
+    int first = fgetc(f);
+    ungetc(first, f);
+    if (first == STREAM_SYNC) {
+      uint8_t ok = open_frames(f);
+      fclose(f);
+      if (!ok) { errno = EINVAL; }
+      return(ok);
+    }
+  #endif
+  char buf[512];
+  while (fgets(buf, sizeof(buf), f)) {
+    size_t n = strlen(buf);
+    while (n > 0 && (buf[n-1] == '\n' || buf[n-1] == '\r' || buf[n-1] == ' ' || buf[n-1] == '\t')) { n--; }
+    buf[n] = 0;
+    char *text = strdup(buf);
+    buf[n++] = '\n';
+    uint8_t *data = malloc(n);
+    memcpy(data, buf, n);
+    add_line(data, n, text);
+  }
+  fclose(f);
+  return(true);
+}
+
+
+const char *sim_serial_text(uint32_t line)
+{
+  if (line == 0 || line > line_count) { return(""); }
+  return(line_text[line-1]);
+}
+
+
+uint32_t sim_serial_line() { return(lines_read); }
+
+
+uint8_t sim_serial_busy()
+{
+  return(next_line < line_count || next_char > 0 || rx_head != rx_tail);
+}
+
+
+uint8_t sim_serial_done()
+{
+  return(!sim_serial_busy() && sent_head == sent_tail);
+}
+
+
+// Can a character go now? Starts the next line if it fits.
+static uint8_t can_send()
+{
+  if (next_char > 0) { return(true); }
+  if (next_line >= line_count || sent_head-sent_tail >= SIM_ACK_QUEUE) { return(false); }
+  uint32_t length = line_length[next_line];
+  if (sent_head != sent_tail) {
+    if (send_response || outstanding+length > RX_BUFFER_SIZE-1) { return(false); }
+  }
+  sent_length[sent_head % SIM_ACK_QUEUE] = length;
+  ack_at[sent_head % SIM_ACK_QUEUE] = SIM_NEVER;
+  sent_head++;
+  outstanding += length;
+  return(true);
+}
+
+
+uint64_t sim_serial_next_event()
+{
+  uint64_t t = (sent_tail != ack_head) ? ack_at[sent_tail % SIM_ACK_QUEUE] : SIM_NEVER;
+  if (char_at == SIM_NEVER && can_send()) {
+    uint64_t start = (tx_free > sim_now) ? tx_free : sim_now;
+    char_at = start + (uint64_t)(char_cycles+0.5);
+  }
+  return(char_at < t ? char_at : t);
+}
+
+
+#ifdef BINARY_STREAMING
+// Follows a byte through the frames as serial.c does. Returns true if it is part of one, and counts
+// *bytes down to 0 at the end of it.
+static uint8_t frame_byte(uint8_t *bytes, uint8_t data)
+{
+  if (*bytes == 0) {
+    if (data == STREAM_SYNC) { *bytes = SIM_FRAME_LENGTH; return(true); }
+    return(false);
+  }
+  if (*bytes == SIM_FRAME_LENGTH) {
+    *bytes = ((data < STREAM_LENGTH_MIN) || (data > STREAM_LENGTH_MAX)) ? 0 : data;
+  } else {
+    (*bytes)--;
+  }
+  return(true);
+}
+#endif
+
+
+// A character reaches the USART, as ISR(SERIAL_RX) in serial.c
+static void receive(uint8_t data)
+{
+  uint8_t command = data;
+  #ifdef BINARY_STREAMING
+    if (frame_byte(&rx_frame_bytes, data)) { command = 0; } // Not a realtime command, whatever it looks like
+  #endif
+  switch (command) {
+    case CMD_STATUS_REPORT: bit_true_atomic(sys_rt_exec_state, EXEC_STATUS_REPORT); break;
+    case CMD_CYCLE_START:   bit_true_atomic(sys_rt_exec_state, EXEC_CYCLE_START); break;
+    case CMD_FEED_HOLD:     bit_true_atomic(sys_rt_exec_state, EXEC_FEED_HOLD); break;
+    case CMD_SAFETY_DOOR:   bit_true_atomic(sys_rt_exec_state, EXEC_SAFETY_DOOR); break;
+    case CMD_RESET:         mc_reset(); break;
+    default: {
+      uint8_t next_head = rx_head + 1;
+      if (next_head == RX_BUFFER_SIZE) { next_head = 0; }
+      if (next_head != rx_tail) {
+        rx_buffer[rx_head] = data;
+        rx_head = next_head;
+        #ifdef PERFORMANCE_COUNTERS
+          if (serial_get_rx_buffer_count() > perf.rx_high) { perf.rx_high = serial_get_rx_buffer_count(); }
+        #endif
+      } else {
+        sim_rx_overflows++;
+      }
+    }
+  }
+}
+
+
+void sim_serial_event()
+{
+  uint64_t ack = (sent_tail != ack_head) ? ack_at[sent_tail % SIM_ACK_QUEUE] : SIM_NEVER;
+  if (ack <= char_at) {
+    outstanding -= sent_length[sent_tail % SIM_ACK_QUEUE];
+    sent_tail++;
+    return;
+  }
+  uint8_t c = lines[next_line][next_char++];
+  if (next_char == line_length[next_line]) {
+    next_line++;
+    next_char = 0;
+  }
+  tx_free = char_at;
+  char_at = SIM_NEVER;
+  receive(c);
+}
+
+
+void serial_init() { }
+
+
+// Answers the oldest line still waiting, once it has crossed the line. error is NULL for an ok.
+static void answer(uint8_t length, const char *error)
+{
+  if (ack_head >= lines_read) { return; }
+  if (ack_head != sent_head) {
+    ack_at[ack_head % SIM_ACK_QUEUE] = sim_now + (uint64_t)(length*char_cycles+0.5);
+    ack_head++;
+  }
+  if (error) {
+    sim_errors++;
+    printf("line %lu: %s: %s\n", (unsigned long)lines_read, sim_serial_text(lines_read), error);
+  }
+}
+
+
+#ifdef BINARY_STREAMING
+static void read_frame()
+{
+  uint8_t *frame = (uint8_t *)response;
+  char text[32];
+  if (frame[3] == STREAM_TYPE_ACK) {
+    snprintf(text, sizeof(text), "error:%u", frame[4]);
+    answer(response_length, frame[4] == STATUS_OK ? NULL : text);
+    if (sim_verbose) { printf("ack %u: status %u, %u blocks free\n", frame[2], frame[4], frame[5]); }
+  } else {
+    // Nothing is lost between the sender and Grbl here, so there's nothing to send again
+    sim_errors++;
+    printf("line %lu: %s: nak %u: reason %u\n", (unsigned long)lines_read, sim_serial_text(lines_read),
+      frame[2], frame[4]);
+  }
+}
+#endif
+
+
+void serial_write(uint8_t data)
+{
+  #ifdef BINARY_STREAMING
+    if (response_frame || (response_length == 0 && data == STREAM_SYNC)) {
+      response_frame = true;
+      response[response_length++] = data;
+      if (response_length < 2 || response_length < (uint8_t)response[1]+2) { return; }
+      read_frame();
+      response_frame = false;
+      response_length = 0;
+      return;
+    }
+  #endif
+  if (data == '\r') { return; }
+  if (data != '\n') {
+    if (response_length < sizeof(response)-1) { response[response_length++] = data; }
+    return;
+  }
+  response[response_length] = 0;
+  uint8_t is_error = !strncmp(response, "error", 5);
+  if (is_error || !strncmp(response, "ok", 2)) {
+    answer(response_length+2, is_error ? response : NULL);
+  } else if (!strncmp(response, "ALARM", 5)) {
+    sim_alarms++;
+    printf("line %lu: %s\n", (unsigned long)lines_read, response);
+  }
+  if (sim_verbose) { printf("%s\n", response); }
+  response_length = 0;
+}
+
+
+uint8_t serial_read_byte(uint8_t *data)
+{
+  if (rx_head == rx_tail) {
+    // Once around the main loop first, for its auto cycle start
+    if (idle_reads) { sim_wait(); } else { idle_reads = true; }
+    return(false);
+  }
+  idle_reads = 0;
+  *data = rx_buffer[rx_tail];
+  if (++rx_tail == RX_BUFFER_SIZE) { rx_tail = 0; }
+  #ifdef BINARY_STREAMING
+    if (frame_byte(&read_frame_bytes, *data)) {
+      if (read_frame_bytes == 0) { lines_read++; }
+      return(true);
+    }
+  #endif
+  if (*data == '\n') { lines_read++; }
+  return(true);
+}
+
+
+uint8_t serial_read()
+{
+  uint8_t data;
+  if (!serial_read_byte(&data)) { return SERIAL_NO_DATA; }
+  return data;
+}
+
+
+void serial_reset_read_buffer()
+{
+  rx_tail = rx_head;
+  #ifdef BINARY_STREAMING
+    rx_frame_bytes = 0;
+    read_frame_bytes = 0;
+  #endif
+}
+
+
+uint8_t serial_get_rx_buffer_count()
+{
+  if (rx_head >= rx_tail) { return(rx_head-rx_tail); }
+  return (RX_BUFFER_SIZE - (rx_tail-rx_head));
+}
+
+
+uint8_t serial_get_tx_buffer_count() { return(0); }
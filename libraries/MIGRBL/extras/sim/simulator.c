@@ -0,0 +1,735 @@
+/*
+  simulator.c - runs Grbl on the host, on simulated time
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Grbl's own main(), planner, segment generator and stepper ISR run unchanged. Time only passes
+   where the main program would wait for an interrupt: when the serial buffer is empty, when the
+   planner buffer is full, while it synchronizes with the steppers, in a hold, and in the delays.
+   There the simulator runs the next thing due, a Timer1 compare (the stepper ISR, at the period
+   OCR1A and the TCCR1B prescaler give), a Timer0 overflow (the end of a step pulse) or a character
+   on the serial line, and then lets the main program look. Everything else the main program does
+   takes no time, except that -p charges each planned block a fixed time, as parsing and planning
+   it would take on the chip. Interrupts take no time either.
+
+   The linker's --wrap puts the functions below named __wrap_* in front of the planner and protocol
+   calls made from other files, which is how the waits and each planned block are seen without
+   changing Grbl. After every interrupt the step pins are read, to log each step and to follow
+   each planner block to its last step.
+
+   With -r, each axis also drags a mass on a spring, of that resonant frequency and damping ratio,
+   from the position its steps have taken it to. Between steps the mass swings freely, which is
+   solved exactly, so how far it rings tells how much a velocity profile shakes the machine.
+
+   With -w, each change of the spindle PWM output is logged with where the steps have taken X and Y,
+   which draws what a raster engraving burned. */
+
+#include "simulator.h"
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_BLOCKS 512 // Blocks planned and not yet stepped out, at most
+
+#define SIM_REGISTER(name, type) volatile type name;
+SIM_REGISTERS(SIM_REGISTER)
+
+int grbl_main(void); // main.c, renamed
+plan_block_t *__real_plan_get_current_block(); // Not the wrapped one below
+
+uint64_t sim_now = 0;
+
+// Options
+static double plan_cost = 0;     // Simulated time each planned block takes, in microseconds
+static double time_limit = 3600; // Seconds
+static FILE *step_log = NULL, *block_log = NULL, *power_log = NULL;
+
+// Timers
+static uint8_t t1_armed = false, in_t1 = false;
+static uint64_t t1_at, t0_ovf_at = SIM_NEVER, t0_compa_at = SIM_NEVER;
+static uint64_t block_start = 0;   // Of the block being stepped out
+static uint64_t stopped_at = SIM_NEVER; // Starved, waiting for the next cycle
+
+// Step pins, and where they have taken the machine
+static uint8_t step_pins = 0;
+static int32_t position[N_AXIS];
+static uint32_t axis_steps[N_AXIS];
+static uint64_t last_step[N_AXIS], shortest_step[N_AXIS];
+static uint32_t pulse_overlaps = 0;
+
+// Resonance of each axis, from -r
+typedef struct {
+  double offset;    // Of the mass from the step position (mm)
+  double speed;     // Of the mass, relative (mm/s)
+  uint64_t at;      // Time of the above
+  double peak;      // Largest offset (mm)
+  double ringing;   // Largest amplitude left swinging once the axis stood still for a period (mm)
+} sim_mass_t;
+static double resonance_hz = 0, resonance_damping = 0.05;
+static sim_mass_t mass[N_AXIS];
+
+// Blocks, as planned, waiting for their steps
+typedef struct {
+  uint32_t line;
+  uint32_t steps;       // On all axes
+  float millimeters;
+  float feed_rate;      // Commanded, within the axis maximum rates (mm/min)
+  double plan_ns;       // Host time of plan_buffer_line()
+} sim_block_t;
+static sim_block_t blocks[SIM_BLOCKS];
+static uint16_t block_head = 0, block_tail = 0;
+static uint32_t block_steps_done = 0;
+static int32_t planned[N_AXIS];
+
+// Results
+static uint32_t blocks_done = 0, blocks_slow = 0, blocks_dry = 0;
+static double total_mm = 0, motion_seconds = 0, commanded_seconds = 0;
+static double plan_ns_total = 0, plan_ns_max = 0;
+static uint32_t plan_calls = 0;
+static uint32_t stops = 0, sync_stops = 0, planner_starved = 0, segment_starved = 0;
+static double starved_seconds = 0;
+static uint8_t syncing = false;
+static uint32_t raster_lines = 0, raster_pixels = 0;
+static int16_t last_pwm = -1;
+
+
+static double host_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return(ts.tv_sec*1e9 + ts.tv_nsec);
+}
+
+
+static double seconds(uint64_t cycles) { return((double)cycles/F_CPU); }
+
+
+static uint32_t t1_period()
+{
+  static const uint16_t prescale[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+  return((uint32_t)(OCR1A+1) * prescale[TCCR1B & 0x07]);
+}
+
+
+static uint32_t t0_prescale()
+{
+  static const uint16_t prescale[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+  return(prescale[TCCR0B & 0x07]);
+}
+
+
+static void block_done();
+
+
+// Lets the mass of an axis swing freely until the given time.
+static void mass_run(uint8_t idx, uint64_t until)
+{
+  sim_mass_t *m = &mass[idx];
+  double t = seconds(until-m->at);
+  m->at = until;
+  if (resonance_hz == 0 || t <= 0) { return; }
+  double w = 2*M_PI*resonance_hz;
+  double zw = resonance_damping*w;
+  double wd = w*sqrt(1-resonance_damping*resonance_damping);
+  double b = (m->speed + zw*m->offset)/wd;
+  if (t*resonance_hz >= 1) { // Standing still. The offset swings within this, decaying.
+    double amplitude = sqrt(m->offset*m->offset + b*b);
+    m->ringing = max(m->ringing, amplitude);
+    m->peak = max(m->peak, amplitude);
+  }
+  double decay = exp(-zw*t), c = cos(wd*t), s = sin(wd*t);
+  double offset = decay*(m->offset*c + b*s);
+  m->speed = decay*(m->speed*c - (zw*m->speed + w*w*m->offset)/wd*s);
+  m->offset = offset;
+  m->peak = max(m->peak, fabs(offset));
+}
+
+
+// The steppers ran out of segments. Sorts out why.
+static void cycle_stopped()
+{
+  stops++;
+  if (__real_plan_get_current_block() && sys.state == STATE_CYCLE) {
+    segment_starved++;
+    stopped_at = sim_now;
+    printf("%.6f s, line %lu: segment buffer ran empty with blocks planned\n",
+      seconds(sim_now), (unsigned long)sim_serial_line());
+  } else if (syncing) {
+    sync_stops++;
+  } else if (sim_serial_busy()) {
+    planner_starved++;
+    stopped_at = sim_now;
+  }
+  #ifdef ARC_BLOCKS
+    // The steps of an arc are only foreseen to within a few, as the chords the segment generator
+    // steps may cut across a step at the top of the arc. Once the planner is empty, the blocks still
+    // followed are done, however many steps they were short.
+    if (!__real_plan_get_current_block()) {
+      while (block_tail != block_head) {
+        block_steps_done = max(block_steps_done, blocks[block_tail % SIM_BLOCKS].steps);
+        block_done();
+      }
+      block_steps_done = 0;
+    }
+  #endif
+}
+
+
+// Follows what the main program and the interrupts did to the timer registers
+static void timers_update()
+{
+  if ((TIMSK1 & (1<<OCIE1A)) && t1_period()) {
+    if (!t1_armed) {
+      t1_armed = true;
+      t1_at = sim_now + t1_period();
+      if (stopped_at != SIM_NEVER) { starved_seconds += seconds(sim_now-stopped_at); }
+      stopped_at = SIM_NEVER;
+      // A block not yet begun starts now. One stopped halfway counts the stop in its time.
+      if (block_steps_done == 0) { block_start = sim_now; }
+    }
+  } else if (t1_armed) {
+    t1_armed = false;
+    cycle_stopped();
+  }
+  if (!t0_prescale()) { t0_ovf_at = t0_compa_at = SIM_NEVER; }
+}
+
+
+// Sets TCNT1 to the count since the last Timer1 compare, as the main program would read it then.
+static void timer1_count()
+{
+  uint32_t period = t1_period();
+  if (!t1_armed || !period) { return; }
+  TCNT1 = (sim_now+period-t1_at)/(period/(OCR1A+1));
+}
+
+
+static uint64_t next_event()
+{
+  timers_update();
+  uint64_t t = sim_serial_next_event();
+  if (t1_armed && !in_t1 && t1_at < t) { t = t1_at; }
+  if (t0_ovf_at < t) { t = t0_ovf_at; }
+  if (t0_compa_at < t) { t = t0_compa_at; }
+  return(t);
+}
+
+
+// A block has had all its steps
+static void block_done()
+{
+  sim_block_t *b = &blocks[block_tail % SIM_BLOCKS];
+  uint64_t start = block_start;
+  double s = seconds(sim_now-start);
+  double achieved = (s > 0) ? b->millimeters/s*60 : 0;
+  if (block_log) {
+    fprintf(block_log, "%lu,%lu,%.4f,%.1f,%.1f,%.4f,%.4f,%.2f\n", (unsigned long)blocks_done,
+      (unsigned long)b->line, b->millimeters, b->feed_rate, achieved, seconds(start)*1000,
+      seconds(sim_now)*1000, b->plan_ns/1000);
+  }
+  blocks_done++;
+  if (achieved < 0.5*b->feed_rate) { blocks_slow++; }
+  total_mm += b->millimeters;
+  motion_seconds += s;
+  commanded_seconds += b->millimeters/b->feed_rate*60;
+  block_steps_done -= b->steps;
+  block_start = sim_now;
+  block_tail++;
+}
+
+
+// Reads the step and direction pins after an interrupt
+static void pins_changed()
+{
+  uint8_t step_invert = 0, dir_invert = 0, idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(settings.step_invert_mask,bit(idx))) { step_invert |= get_step_pin_mask(idx); }
+    if (bit_istrue(settings.dir_invert_mask,bit(idx))) { dir_invert |= get_direction_pin_mask(idx); }
+  }
+  uint8_t pins = (STEP_PORT ^ step_invert) & STEP_MASK;
+  uint8_t rising = pins & ~step_pins;
+  step_pins = pins;
+  if (!rising) { return; }
+  uint8_t directions = DIRECTION_PORT ^ dir_invert;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (!(rising & get_step_pin_mask(idx))) { continue; }
+    int8_t dir = (directions & get_direction_pin_mask(idx)) ? -1 : 1;
+    position[idx] += dir;
+    mass_run(idx, sim_now);
+    mass[idx].offset -= dir/settings.steps_per_mm[idx]; // The spring's end moves on a step
+    if (axis_steps[idx]++ && sim_now-last_step[idx] < shortest_step[idx]) {
+      shortest_step[idx] = sim_now-last_step[idx];
+    }
+    last_step[idx] = sim_now;
+    block_steps_done++;
+    if (step_log) { fprintf(step_log, "%.4f,%c,%d\n", seconds(sim_now)*1e6, "XYZABC"[idx], dir); }
+  }
+  while (block_tail != block_head && block_steps_done >= blocks[block_tail % SIM_BLOCKS].steps) {
+    block_done();
+  }
+}
+
+
+// Logs the spindle PWM output if it changed. Zero while the output is off.
+static void power_changed()
+{
+  if (!power_log) { return; }
+  int16_t pwm = (TCCRA_REGISTER & (1<<COMB_BIT)) ? OCR_REGISTER : 0;
+  if (pwm == last_pwm) { return; }
+  last_pwm = pwm;
+  fprintf(power_log, "%.4f,%.4f,%.4f,%d\n", seconds(sim_now)*1e6, position[X_AXIS]/settings.steps_per_mm[X_AXIS],
+    position[Y_AXIS]/settings.steps_per_mm[Y_AXIS], pwm);
+}
+
+
+// Runs the events due at the next event time
+static void run_event()
+{
+  uint64_t t = next_event();
+  if (t == SIM_NEVER) { return; }
+  power_changed(); // By the main program, since the last event
+  sim_now = t;
+  if (sim_now > time_limit*F_CPU) { sim_finish(1, "time limit reached"); }
+  if (t0_compa_at == t) {
+    t0_compa_at = SIM_NEVER;
+    #ifdef STEP_PULSE_DELAY
+      TIMER0_COMPA_vect();
+    #endif
+    pins_changed();
+  } else if (t0_ovf_at == t) {
+    TIMER0_OVF_vect();
+    t0_ovf_at = t0_prescale() ? t + 256*t0_prescale() : SIM_NEVER;
+    pins_changed();
+  } else if (t1_armed && !in_t1 && t1_at == t) {
+    if (t0_ovf_at != SIM_NEVER) { pulse_overlaps++; } // The last pulse hasn't ended
+    in_t1 = true;
+    TCNT1 = 0; // Counting from this compare
+    TIMER1_COMPA_vect();
+    in_t1 = false;
+    // The ISR reloads Timer0 for the pulse it started, and OCR1A for the next compare
+    if (t0_prescale()) {
+      t0_ovf_at = t + (256-TCNT0)*t0_prescale();
+      if (TIMSK0 & (1<<OCIE0A)) { t0_compa_at = t + ((uint8_t)(OCR0A-TCNT0) ? (uint8_t)(OCR0A-TCNT0) : 256)*t0_prescale(); }
+    }
+    if (t1_armed) { t1_at = t + t1_period(); }
+    pins_changed();
+  } else {
+    sim_serial_event();
+  }
+  power_changed();
+  timer1_count();
+}
+
+
+static void run_until(uint64_t t)
+{
+  while (next_event() <= t) { run_event(); }
+  if (t > sim_now) { sim_now = t; }
+  timer1_count();
+}
+
+
+void sim_delay_us(double us)
+{
+  run_until(sim_now + (uint64_t)(us*TICKS_PER_MICROSECOND));
+}
+
+
+void sim_wait()
+{
+  static uint16_t idle = 0; // Waits in a row with nothing to run
+  if (next_event() == SIM_NEVER) {
+    if (sim_serial_done()) { sim_finish(0, NULL); }
+    // Grbl may still have something to start, such as a cycle, on its way round the loop
+    if (++idle < 1000) { return; }
+    sim_finish(1, __real_plan_get_current_block() ? "Grbl is idle with blocks planned and nothing will start them"
+      : "nothing left to happen, but the G-code isn't all done");
+  }
+  idle = 0;
+  run_event();
+}
+
+
+void __real_st_prep_buffer();
+void __wrap_st_prep_buffer()
+{
+  __real_st_prep_buffer();
+  if (syncing || sys.suspend || sys.state == STATE_HOMING) { sim_wait(); }
+}
+
+
+uint8_t __real_plan_check_full_buffer();
+uint8_t __wrap_plan_check_full_buffer()
+{
+  static uint8_t full = 0; // In a row. mc_line() starts the cycle after the first.
+  if (!__real_plan_check_full_buffer()) { full = 0; return(false); }
+  if (full++) { sim_wait(); }
+  return(true);
+}
+
+
+// protocol_buffer_synchronize() waits on this. If the steppers stopped short, with the segment
+// buffer starved, it would wait forever on the chip too.
+plan_block_t *__wrap_plan_get_current_block()
+{
+  plan_block_t *block = __real_plan_get_current_block();
+  if (block && syncing && !t1_armed && sys.state == STATE_IDLE && !sys_rt_exec_state) { sim_wait(); }
+  return(block);
+}
+
+
+void __real_protocol_buffer_synchronize();
+void __wrap_protocol_buffer_synchronize()
+{
+  uint8_t was = syncing;
+  syncing = true;
+  __real_protocol_buffer_synchronize();
+  syncing = was;
+}
+
+
+void __real_plan_reset();
+void __wrap_plan_reset()
+{
+  __real_plan_reset();
+  block_tail = block_head;
+  block_steps_done = 0;
+  memset(planned, 0, sizeof(planned));
+}
+
+
+void __real_plan_sync_position();
+void __wrap_plan_sync_position()
+{
+  __real_plan_sync_position();
+  memcpy(planned, sys.position, sizeof(planned));
+  // The steps not yet taken were thrown away with their blocks
+  memcpy(position, sys.position, sizeof(position));
+}
+
+
+// Follows a block the planner kept to its last step
+static void block_add(uint32_t steps, float mm, float feed_rate, double ns, uint8_t ahead)
+{
+  // The planner had only the block being stepped out, which it plans down to a stop
+  if (ahead <= 1 && t1_armed) { blocks_dry++; }
+  if ((uint16_t)(block_head-block_tail) >= SIM_BLOCKS) { sim_finish(1, "too many blocks in flight"); }
+  sim_block_t *b = &blocks[block_head % SIM_BLOCKS];
+  b->line = sim_serial_line();
+  b->steps = steps;
+  b->millimeters = mm;
+  b->feed_rate = feed_rate;
+  b->plan_ns = ns;
+  block_head++;
+}
+
+
+static void plan_timed(double ns)
+{
+  plan_calls++;
+  plan_ns_total += ns;
+  if (ns > plan_ns_max) { plan_ns_max = ns; }
+}
+
+
+// Works out the block as plan_buffer_line() does, to know its steps and commanded feed rate
+static void block_planned(float *target, float feed_rate, uint8_t invert_feed_rate, double ns,
+  uint8_t ahead)
+{
+  plan_timed(ns);
+  int32_t target_steps[N_AXIS];
+  float delta_mm[N_AXIS], mm = 0;
+  uint32_t steps = 0;
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    target_steps[idx] = lround(target[idx]*settings.steps_per_mm[idx]);
+    steps += labs(target_steps[idx]-planned[idx]);
+    delta_mm[idx] = (target_steps[idx]-planned[idx])/settings.steps_per_mm[idx];
+    mm += delta_mm[idx]*delta_mm[idx];
+  }
+  if (steps == 0) { return; } // Dropped by the planner
+  memcpy(planned, target_steps, sizeof(planned));
+  mm = sqrt(mm);
+
+  if (feed_rate < 0) { feed_rate = 1e38; }
+  else if (invert_feed_rate) { feed_rate *= mm; }
+  if (feed_rate < MINIMUM_FEED_RATE) { feed_rate = MINIMUM_FEED_RATE; }
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (delta_mm[idx] != 0) { feed_rate = min(feed_rate, settings.max_rate[idx]*fabs(mm/delta_mm[idx])); }
+  }
+  block_add(steps, mm, feed_rate, ns, ahead);
+}
+
+
+#ifdef ARC_BLOCKS
+  // Works out the arc as plan_buffer_arc() does. Its steps are those of the path rounded to steps,
+  // taken at every half step along it. The segment generator steps chords of it, so may take a few
+  // less.
+  static void arc_planned(float *target, float *offset, float radius, float angular_travel,
+    uint8_t axis_linear, float feed_rate, uint8_t invert_feed_rate, double ns, uint8_t ahead)
+  {
+    plan_timed(ns);
+    uint8_t axis_0 = (axis_linear+1) % N_AXIS;
+    uint8_t axis_1 = (axis_linear+2) % N_AXIS;
+    int32_t target_steps[N_AXIS], last[N_AXIS], point[N_AXIS];
+    uint8_t idx;
+    float max_steps_per_mm = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      target_steps[idx] = lround(target[idx]*settings.steps_per_mm[idx]);
+      last[idx] = 0;
+      max_steps_per_mm = max(max_steps_per_mm, settings.steps_per_mm[idx]);
+    }
+    float plane_mm = fabs(angular_travel)*radius;
+    float linear_mm = (target_steps[axis_linear]-planned[axis_linear])/settings.steps_per_mm[axis_linear];
+    float mm = sqrt(plane_mm*plane_mm + linear_mm*linear_mm);
+
+    uint32_t steps = 0, i, n = ceil(2*mm*max_steps_per_mm)+1;
+    for (i=1; i<=n; i++) {
+      if (i == n) {
+        for (idx=0; idx<N_AXIS; idx++) { point[idx] = target_steps[idx]-planned[idx]; }
+      } else {
+        double angle = angular_travel*i/n;
+        point[axis_0] = lround(-offset[axis_0]*(cos(angle)-1)*settings.steps_per_mm[axis_0] +
+                               offset[axis_1]*sin(angle)*settings.steps_per_mm[axis_0]);
+        point[axis_1] = lround(-offset[axis_0]*sin(angle)*settings.steps_per_mm[axis_1] -
+                               offset[axis_1]*(cos(angle)-1)*settings.steps_per_mm[axis_1]);
+        point[axis_linear] = lround(linear_mm*i/n*settings.steps_per_mm[axis_linear]);
+      }
+      for (idx=0; idx<N_AXIS; idx++) {
+        steps += labs(point[idx]-last[idx]);
+        last[idx] = point[idx];
+      }
+    }
+    memcpy(planned, target_steps, sizeof(planned));
+
+    if (invert_feed_rate) { feed_rate *= mm; }
+    if (feed_rate < MINIMUM_FEED_RATE) { feed_rate = MINIMUM_FEED_RATE; }
+    if (linear_mm != 0) { feed_rate = min(feed_rate, settings.max_rate[axis_linear]*fabs(mm/linear_mm)); }
+    if (plane_mm > 0) {
+      float plane_acceleration = min(settings.acceleration[axis_0], settings.acceleration[axis_1]);
+      feed_rate = min(feed_rate, min(settings.max_rate[axis_0], settings.max_rate[axis_1])*mm/plane_mm);
+      feed_rate = min(feed_rate, sqrt(ARC_CENTRIPETAL_SHARE*plane_acceleration*radius)*mm/plane_mm);
+    }
+    if (steps) { block_add(steps, mm, feed_rate, ns, ahead); }
+  }
+
+
+  #ifdef USE_LINE_NUMBERS
+    void __real_plan_buffer_arc(float *target, float *offset, float radius, float angular_travel,
+      uint8_t axis_linear, float feed_rate, uint8_t invert_feed_rate, int32_t line_number);
+    void __wrap_plan_buffer_arc(float *target, float *offset, float radius, float angular_travel,
+      uint8_t axis_linear, float feed_rate, uint8_t invert_feed_rate, int32_t line_number)
+    {
+      uint8_t ahead = plan_get_block_buffer_count();
+      double t0 = host_ns();
+      __real_plan_buffer_arc(target, offset, radius, angular_travel, axis_linear, feed_rate,
+        invert_feed_rate, line_number);
+      arc_planned(target, offset, radius, angular_travel, axis_linear, feed_rate, invert_feed_rate,
+        host_ns()-t0, ahead);
+      sim_delay_us(plan_cost);
+    }
+  #else
+    void __real_plan_buffer_arc(float *target, float *offset, float radius, float angular_travel,
+      uint8_t axis_linear, float feed_rate, uint8_t invert_feed_rate);
+    void __wrap_plan_buffer_arc(float *target, float *offset, float radius, float angular_travel,
+      uint8_t axis_linear, float feed_rate, uint8_t invert_feed_rate)
+    {
+      uint8_t ahead = plan_get_block_buffer_count();
+      double t0 = host_ns();
+      __real_plan_buffer_arc(target, offset, radius, angular_travel, axis_linear, feed_rate,
+        invert_feed_rate);
+      arc_planned(target, offset, radius, angular_travel, axis_linear, feed_rate, invert_feed_rate,
+        host_ns()-t0, ahead);
+      sim_delay_us(plan_cost);
+    }
+  #endif
+#endif
+
+
+#ifdef USE_LINE_NUMBERS
+  void __real_plan_buffer_line(float *target, float feed_rate, uint8_t invert_feed_rate, int32_t line_number);
+  void __wrap_plan_buffer_line(float *target, float feed_rate, uint8_t invert_feed_rate, int32_t line_number)
+  {
+    uint8_t ahead = plan_get_block_buffer_count();
+    double t0 = host_ns();
+    __real_plan_buffer_line(target, feed_rate, invert_feed_rate, line_number);
+    block_planned(target, feed_rate, invert_feed_rate, host_ns()-t0, ahead);
+    sim_delay_us(plan_cost);
+  }
+#else
+  void __real_plan_buffer_line(float *target, float feed_rate, uint8_t invert_feed_rate);
+  void __wrap_plan_buffer_line(float *target, float feed_rate, uint8_t invert_feed_rate)
+  {
+    uint8_t ahead = plan_get_block_buffer_count();
+    double t0 = host_ns();
+    __real_plan_buffer_line(target, feed_rate, invert_feed_rate);
+    block_planned(target, feed_rate, invert_feed_rate, host_ns()-t0, ahead);
+    sim_delay_us(plan_cost);
+  }
+#endif
+
+
+#ifdef RASTER_ENGRAVING
+  // mc_raster() waits on this for room for the pixels, as it waits on plan_check_full_buffer().
+  uint8_t __real_st_raster_fits(uint8_t pixels);
+  uint8_t __wrap_st_raster_fits(uint8_t pixels)
+  {
+    static uint8_t full = 0; // In a row. The cycle is started after the first.
+    if (__real_st_raster_fits(pixels)) { full = 0; return(true); }
+    if (full++) { sim_wait(); }
+    return(false);
+  }
+
+
+  #ifdef USE_LINE_NUMBERS
+    void __real_plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels,
+      int32_t line_number);
+    void __wrap_plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels,
+      int32_t line_number)
+    {
+      uint8_t ahead = plan_get_block_buffer_count();
+      double t0 = host_ns();
+      __real_plan_buffer_raster(target, feed_rate, power, pixels, line_number);
+      block_planned(target, feed_rate, false, host_ns()-t0, ahead);
+      raster_lines++;
+      raster_pixels += pixels;
+      sim_delay_us(plan_cost);
+    }
+  #else
+    void __real_plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels);
+    void __wrap_plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels)
+    {
+      uint8_t ahead = plan_get_block_buffer_count();
+      double t0 = host_ns();
+      __real_plan_buffer_raster(target, feed_rate, power, pixels);
+      block_planned(target, feed_rate, false, host_ns()-t0, ahead);
+      raster_lines++;
+      raster_pixels += pixels;
+      sim_delay_us(plan_cost);
+    }
+  #endif
+#endif
+
+
+void sim_finish(int code, const char *why)
+{
+  if (why) { printf("stopped at %.6f s: %s\n", seconds(sim_now), why); }
+  printf("%.3f s simulated, %lu lines, %lu blocks, %.1f mm\n", seconds(sim_now),
+    (unsigned long)sim_serial_line(), (unsigned long)blocks_done, total_mm);
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    printf("  %c: %lu steps, to %ld", "XYZABC"[idx], (unsigned long)axis_steps[idx], (long)position[idx]);
+    if (axis_steps[idx] > 1) { printf(", %.1f us apart at least", seconds(shortest_step[idx])*1e6); }
+    printf("\n");
+  }
+  if (resonance_hz > 0) {
+    printf("resonance: %.1f Hz, damping %.3f, at most", resonance_hz, resonance_damping);
+    for (idx=0; idx<N_AXIS; idx++) {
+      // Once more after the last step, standing still
+      mass_run(idx, max(sim_now, mass[idx].at + (uint64_t)(F_CPU/resonance_hz) + 1));
+      printf("%s %c %.4f mm off, %.4f mm ringing", idx ? ";" : ":", "XYZABC"[idx], mass[idx].peak,
+        mass[idx].ringing);
+    }
+    printf("\n");
+  }
+  if (motion_seconds > 0) {
+    printf("feed: %.1f%% of commanded overall (%.3f s at the commanded rates, %.3f s moving), "
+      "%lu blocks under half\n", 100*commanded_seconds/motion_seconds, commanded_seconds,
+      motion_seconds, (unsigned long)blocks_slow);
+    printf("planner: %lu blocks came in while moving on the last one planned\n",
+      (unsigned long)blocks_dry);
+  }
+  if (raster_lines) {
+    printf("raster: %lu lines, %lu pixels\n", (unsigned long)raster_lines, (unsigned long)raster_pixels);
+  }
+  if (plan_calls) {
+    printf("plan_buffer_line(): %.2f us a block, at most %.2f us (host time)\n",
+      plan_ns_total/plan_calls/1000, plan_ns_max/1000);
+  }
+  printf("stops: %lu, %lu to synchronize, %lu planner starved, %lu segment buffer starved "
+    "(%.3f s stopped starved)\n", (unsigned long)stops, (unsigned long)sync_stops,
+    (unsigned long)planner_starved, (unsigned long)segment_starved, starved_seconds);
+  if (pulse_overlaps) { printf("step pulses overlapping the next step: %lu\n", (unsigned long)pulse_overlaps); }
+  #ifdef PERFORMANCE_COUNTERS
+    printf("counters ($P): %.3f s waiting for the planner buffer, %lu underruns, RX buffer %u at most\n",
+      perf.blocked, (unsigned long)perf.underruns, perf.rx_high);
+  #endif
+  if (sim_rx_overflows) { printf("serial characters lost: %lu\n", (unsigned long)sim_rx_overflows); }
+  printf("errors: %lu, alarms: %lu\n", (unsigned long)sim_errors, (unsigned long)sim_alarms);
+  if (step_log) { fclose(step_log); }
+  if (block_log) { fclose(block_log); }
+  if (power_log) { fclose(power_log); }
+  fflush(stdout);
+  exit((code || sim_errors || sim_alarms) ? 1 : 0);
+}
+
+
+static void usage()
+{
+  printf("usage: grbl_sim [options] file.nc\n"
+    "  -b baud    serial line rate (default %d)\n"
+    "  -k         send a line only once the last is answered, not character counting\n"
+    "  -s file    log each step: time in us, axis, direction\n"
+    "  -l file    log each block: line, mm, commanded and achieved mm/min, start and end ms,\n"
+    "             host us in plan_buffer_line()\n"
+    "  -p us      simulated time to parse and plan each block (default 0)\n"
+    "  -r hz[,damping]  resonance of every axis, to measure its ringing (default damping 0.05)\n"
+    "  -t seconds stop after this much simulated time (default 3600)\n"
+    "  -w file    log each change of the spindle PWM output: time in us, X and Y mm, PWM (0 off)\n"
+    "  -v         print what Grbl sends back\n", BAUD_RATE);
+  exit(2);
+}
+
+
+int main(int argc, char *argv[])
+{
+  uint32_t baud = BAUD_RATE;
+  uint8_t send_response = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "b:ks:l:p:r:t:vw:")) != -1) {
+    switch (opt) {
+      case 'b': baud = atol(optarg); break;
+      case 'k': send_response = true; break;
+      case 's':
+        if (!(step_log = fopen(optarg, "w"))) { perror(optarg); return(2); }
+        fprintf(step_log, "t_us,axis,dir\n");
+        break;
+      case 'l':
+        if (!(block_log = fopen(optarg, "w"))) { perror(optarg); return(2); }
+        fprintf(block_log, "block,line,mm,commanded,achieved,start_ms,end_ms,plan_us\n");
+        break;
+      case 'p': plan_cost = atof(optarg); break;
+      case 'r':
+        resonance_hz = atof(optarg);
+        if (strchr(optarg, ',')) { resonance_damping = atof(strchr(optarg, ',')+1); }
+        if (resonance_hz <= 0 || resonance_damping < 0 || resonance_damping >= 1) { usage(); }
+        break;
+      case 't': time_limit = atof(optarg); break;
+      case 'v': sim_verbose = true; break;
+      case 'w':
+        if (!(power_log = fopen(optarg, "w"))) { perror(optarg); return(2); }
+        fprintf(power_log, "t_us,x_mm,y_mm,pwm\n");
+        break;
+      default: usage();
+    }
+  }
+  if (optind != argc-1 || baud == 0) { usage(); }
+  if (!sim_serial_open(argv[optind], baud, send_response)) { perror(argv[optind]); return(2); }
+  // Switches open: limit, control and probe inputs sit high on their pull-ups
+  PINB = PINC = PIND = 0xff;
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { shortest_step[idx] = SIM_NEVER; }
+  return(grbl_main());
+}
@@ -0,0 +1,50 @@
+/*
+  simulator.h - runs Grbl on the host, on simulated time
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef simulator_h
+#define simulator_h
+
+#include "grbl.h"
+#include <stdio.h>
+
+#define SIM_NEVER UINT64_MAX
+
+// Simulated time, in CPU cycles since power-up.
+extern uint64_t sim_now;
+
+// The main program is waiting for an interrupt to change something. Runs the next event (a timer
+// interrupt or a character on the serial line), or ends the run if there will never be one.
+void sim_wait();
+
+// Ends the run with the report. Code 0 when the G-code was all sent and executed.
+void sim_finish(int code, const char *why);
+
+// Host side of the serial line, in sim_serial.c. Sends the G-code lines of a file, with character
+// counting or, if send_response, one line at a time after each "ok" or "error".
+uint8_t sim_serial_open(const char *path, uint32_t baud, uint8_t send_response);
+uint64_t sim_serial_next_event();  // When the next character arrives or response is read, or SIM_NEVER
+void sim_serial_event();           // Runs that
+uint8_t sim_serial_busy();         // True while there's G-code not yet read by Grbl's main loop
+uint8_t sim_serial_done();         // True once every line is sent and answered
+uint32_t sim_serial_line();        // File line of the G-code Grbl is executing, 1 is the first
+const char *sim_serial_text(uint32_t line); // Text of a file line
+
+extern uint8_t sim_verbose;        // Echo what Grbl sends back
+extern uint32_t sim_errors, sim_alarms, sim_rx_overflows;
+
+#endif
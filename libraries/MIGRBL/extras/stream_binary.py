@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""Streams a G-code file to Grbl built with BINARY_STREAMING, in the frames of stream.h.
+
+G0 and G1 moves in absolute distance mode go as pre-parsed floats, so Grbl's parser has nothing to
+do for them. Every other line goes as text, cleaned up as Grbl's main loop would. Frames are sent
+as long as the bytes not yet answered fit in the window Grbl gives, and from the one Grbl asks for
+again upon a NAK or a timeout.
+
+    stream_binary.py /dev/ttyACM0 part.nc
+    stream_binary.py --write part.bin part.nc     # frames for extras/sim, built with -DGRBL_BINARY=ON
+
+Needs pyserial to stream.
+"""
+
+import argparse
+import re
+import struct
+import sys
+import time
+
+SYNC = 0xA5
+LENGTH_MIN = 4
+PAYLOAD_MAX = 79  # LINE_BUFFER_SIZE-1
+
+TYPE_OPEN, TYPE_CLOSE, TYPE_RAPID, TYPE_LINEAR, TYPE_RASTER, TYPE_LINE = 0x01, 0x02, 0x10, 0x11, 0x12, 0x20
+TYPE_ACK, TYPE_NAK = 0x80, 0x81
+MASK_FEED_RATE = 0x80
+NAK_REASONS = {1: 'CRC', 2: 'sequence', 3: 'format', 4: 'not open'}
+MM_PER_INCH = 25.4
+WORD = re.compile(r'([A-Z])([-+]?[0-9.]+)')
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frame(sequence, kind, payload=b''):
+    body = bytes([sequence & 0xFF, kind]) + payload
+    crc = crc16(body)
+    return bytes([SYNC, len(body) + 2]) + body + bytes([crc & 0xFF, crc >> 8])
+
+
+def clean(line):
+    """As Grbl's main loop leaves a line: no comments, spaces or block delete, upper case."""
+    line = re.sub(r'\([^)]*\)?', '', line).split(';')[0]
+    return re.sub(r'[\s/]', '', line).upper()
+
+
+class Encoder:
+    """Turns cleaned lines into frame types and payloads, keeping the modal state they depend on."""
+
+    def __init__(self):
+        self.motion = 0  # G0, G1 or anything else as None
+        self.absolute = True
+        self.inches = False
+        self.inverse_time = False
+
+    def encode(self, line):
+        words = WORD.findall(line)
+        if ''.join(l + v for l, v in words) != line:
+            return TYPE_LINE, line.encode()
+        g = [float(v) for l, v in words if l == 'G']
+        axes = {l: float(v) for l, v in words if l in 'XYZ'}
+        others = [l for l, v in words if l not in 'GXYZF']
+        motion = self.motion
+        simple = not others and len(words) == len({l for l, v in words})
+        for code in g:
+            if code in (0, 1):
+                motion = int(code)
+            elif code in (2, 3, 80) or 38 <= code < 39:
+                motion = None
+            elif code in (20, 21, 90, 91, 93, 94):
+                pass
+            else:
+                simple = False
+        self.motion = motion
+        self.absolute = (91 not in g) and (90 in g or self.absolute)
+        self.inches = (21 not in g) and (20 in g or self.inches)
+        self.inverse_time = (94 not in g) and (93 in g or self.inverse_time)
+        if not (simple and axes and motion is not None and self.absolute and not self.inverse_time):
+            return TYPE_LINE, line.encode()
+        if any(code not in (0, 1) for code in g):
+            return TYPE_LINE, line.encode()  # Sets a mode as well
+        scale = MM_PER_INCH if self.inches else 1.0
+        mask = 0
+        payload = b''
+        for idx, axis in enumerate('XYZ'):
+            if axis in axes:
+                mask |= 1 << idx
+                payload += struct.pack('<f', axes[axis] * scale)
+        feed = dict(words).get('F')
+        if feed is not None:
+            if motion == 0:
+                return TYPE_LINE, line.encode()  # F with G0 only sets the feed rate
+            mask |= MASK_FEED_RATE
+            payload += struct.pack('<f', float(feed) * scale)
+        return (TYPE_RAPID if motion == 0 else TYPE_LINEAR), bytes([mask]) + payload
+
+
+def frames(path):
+    """(line number, text, type, payload) for each line of the file that isn't empty"""
+    encoder = Encoder()
+    with open(path) as f:
+        for number, text in enumerate(f, 1):
+            line = clean(text)
+            if not line:
+                continue
+            if len(line) > PAYLOAD_MAX:
+                sys.exit('line %d: longer than %d characters' % (number, PAYLOAD_MAX))
+            kind, payload = encoder.encode(line)
+            yield number, text.strip(), kind, payload
+
+
+class Reader:
+    """Splits what Grbl sends into frames and lines of text."""
+
+    def __init__(self, port):
+        self.port = port
+        self.data = b''
+
+    def read(self, timeout):
+        self.port.timeout = timeout
+        self.data += self.port.read(max(1, self.port.in_waiting))
+        while self.data:
+            if self.data[0] == SYNC:
+                if len(self.data) < 2 or len(self.data) < self.data[1] + 2:
+                    return None
+                raw, self.data = self.data[:self.data[1] + 2], self.data[self.data[1] + 2:]
+                if crc16(raw[2:-2]) != raw[-2] | (raw[-1] << 8):
+                    continue  # Damaged. Its frames are sent again upon the timeout.
+                return raw[3], raw[2], raw[4:-2]
+            end = self.data.find(b'\n')
+            if end < 0:
+                return None
+            text, self.data = self.data[:end].strip(), self.data[end + 1:]
+            if text:
+                print(text.decode(errors='replace'))
+        return None
+
+
+def stream(port_name, todo, baud, timeout, verbose):
+    """Sends the frames of todo, as frames() gives them, and returns the number of errors."""
+    import serial
+    port = serial.Serial(port_name, baud)
+    port.write(b'\r\n\r\n')  # Wake up grbl
+    time.sleep(2)
+    port.reset_input_buffer()
+    reader = Reader(port)
+
+    port.write(frame(0, TYPE_OPEN))
+    window = None
+    deadline = time.time() + timeout
+    while window is None:
+        answer = reader.read(0.1)
+        if answer and answer[0] == TYPE_ACK:
+            window = answer[2][2]
+        elif time.time() > deadline:
+            sys.exit('no answer to open. Is Grbl built with BINARY_STREAMING?')
+
+    todo = list(todo)
+    todo.append((None, '(close)', TYPE_CLOSE, b''))
+    sent = []  # (sequence, bytes, line number, text) not yet answered
+    sequence = 1
+    errors = 0
+    next_frame = 0
+    last_answer = time.time()
+    while next_frame < len(todo) or sent:
+        while next_frame < len(todo):
+            number, text, kind, payload = todo[next_frame]
+            data = frame(sequence, kind, payload)
+            if sent and sum(len(s[1]) for s in sent) + len(data) > window:
+                break
+            port.write(data)
+            sent.append((sequence & 0xFF, data, number, text))
+            sequence += 1
+            next_frame += 1
+        answer = reader.read(0.05)
+        if answer is None:
+            if sent and time.time() - last_answer > timeout:
+                for s in sent:
+                    port.write(s[1])  # Go back to the oldest not answered
+                last_answer = time.time()
+            continue
+        kind, answered, payload = answer
+        last_answer = time.time()
+        if kind == TYPE_ACK:
+            if answered not in [s[0] for s in sent]:
+                continue  # Answered again, as it was sent again
+            while sent[0][0] != answered:
+                sent.pop(0)  # Its ack was lost, but Grbl executed it, as it did the ones after
+            _, _, number, text = sent.pop(0)
+            if payload[0] != 0:
+                errors += 1
+                print('line %s: %s: error:%d' % (number, text, payload[0]))
+            elif verbose:
+                print('line %s: %s: ok, %d blocks free' % (number, text, payload[1]))
+        elif kind == TYPE_NAK:
+            if verbose:
+                print('nak %d: %s' % (answered, NAK_REASONS.get(payload[0], payload[0])))
+            resend = [s for s in sent if ((s[0] - answered) & 0xFF) < 128]
+            for s in resend:
+                port.write(s[1])
+    port.close()
+    return errors
+
+
+def write(out, todo):
+    """Writes the frames of todo, as frames() gives them, between open and close."""
+    sequence = 0
+    with open(out, 'wb') as f:
+        f.write(frame(sequence, TYPE_OPEN))
+        for _, _, kind, payload in todo:
+            sequence += 1
+            f.write(frame(sequence, kind, payload))
+        f.write(frame(sequence + 1, TYPE_CLOSE))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('port', nargs='?', help='serial port of Grbl')
+    parser.add_argument('file', help='G-code file')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('-t', '--timeout', type=float, default=2.0,
+                        help='seconds without an answer before sending again (default 2)')
+    parser.add_argument('-w', '--write', metavar='FILE', help='write the frames to FILE, not to Grbl')
+    parser.add_argument('-v', '--verbose', action='store_true')
+    args = parser.parse_args()
+    if args.write:
+        write(args.write, frames(args.file))
+        return 0
+    if not args.port:
+        parser.error('the serial port is needed, or --write')
+    return 1 if stream(args.port, frames(args.file), args.baud, args.timeout, args.verbose) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -87,6 +87,9 @@ uint8_t gc_execute_line(char *line)
   uint8_t coord_select = 0; // Tracks G10 P coordinate selection for execution
   float coordinate_data[N_AXIS]; // Multi-use variable to store coordinate data for execution
   float parameter_data[N_AXIS]; // Multi-use variable to store parameter data for execution
+  #ifdef PATH_BLENDING
+    float blending_tolerance = PATH_BLENDING_TOLERANCE; // G64 P value in mm for execution
+  #endif
   
   // Initialize bitflag tracking variables for axis indices compatible operations.
   uint8_t axis_words = 0; // XYZ tracking
@@ -262,8 +265,16 @@ uint8_t gc_execute_line(char *line)
           case 61:
             word_bit = MODAL_GROUP_G13;
             if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
-            // gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
+            #ifdef PATH_BLENDING
+              gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
+            #endif
             break;
+          #ifdef PATH_BLENDING
+            case 64:
+              word_bit = MODAL_GROUP_G13;
+              gc_block.modal.control = CONTROL_MODE_CONTINUOUS; // G64
+              break;
+          #endif
           default: FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported G command]
         }      
         if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [Unsupported or invalid Gxx.x command]
@@ -524,7 +535,19 @@ uint8_t gc_execute_line(char *line)
     }
   }
   
-  // [16. Set path control mode ]: N/A. Only G61. G61.1 and G64 NOT SUPPORTED.
+  // [16. Set path control mode ]: G61.1 NOT SUPPORTED. G64 only with PATH_BLENDING, where its optional
+  // P word is the blending tolerance. P belongs to G4 or G10 instead, when either is in the block.
+  // A zero tolerance would blend nothing, so G64 P0 is an error rather than G61 reported as G64.
+  #ifdef PATH_BLENDING
+    if (bit_istrue(command_words,bit(MODAL_GROUP_G13)) && (gc_block.modal.control == CONTROL_MODE_CONTINUOUS)) {
+      if ((gc_block.non_modal_command == NON_MODAL_NO_ACTION) && bit_istrue(value_words,bit(WORD_P))) {
+        if (gc_block.values.p == 0.0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G64 P0. Use G61.]
+        blending_tolerance = gc_block.values.p;
+        if (gc_block.modal.units == UNITS_MODE_INCHES) { blending_tolerance *= MM_PER_INCH; }
+        bit_false(value_words,bit(WORD_P));
+      }
+    }
+  #endif
   // [17. Set distance mode ]: N/A. Only G91.1. G90.1 NOT SUPPORTED.
   // [18. Set retract mode ]: NOT SUPPORTED.
   
@@ -905,8 +928,16 @@ uint8_t gc_execute_line(char *line)
     memcpy(gc_state.coord_system,coordinate_data,sizeof(coordinate_data));
   }
   
-  // [16. Set path control mode ]: G61.1/G64 NOT SUPPORTED
-  // gc_state.modal.control = gc_block.modal.control; // NOTE: Always default.
+  // [16. Set path control mode ]: G61.1 NOT SUPPORTED. G64 only with PATH_BLENDING.
+  #ifdef PATH_BLENDING
+    if (bit_istrue(command_words,bit(MODAL_GROUP_G13))) {
+      gc_state.modal.control = gc_block.modal.control;
+      if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) { mc_path_blending(blending_tolerance); }
+      else { mc_path_blending(0.0); } // Plans the held line, if any.
+    }
+  #else
+    // gc_state.modal.control = gc_block.modal.control; // NOTE: Always default.
+  #endif
   
   // [17. Set distance mode ]:
   gc_state.modal.distance = gc_block.modal.distance;
@@ -1071,6 +1102,81 @@ uint8_t gc_execute_line(char *line)
   // TODO: % to denote start of program.
   return(STATUS_OK);
 }
+
+
+#ifdef BINARY_STREAMING
+// Checks the feed rate of a pre-parsed G0 or G1 and computes its target in machine coordinates.
+// Other axes stay where they are.
+static uint8_t gc_motion_target(uint8_t motion, uint8_t axes, float *coord, float feed_rate, float *target)
+{
+  if (motion == MOTION_MODE_LINEAR) {
+    if (gc_state.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { return(STATUS_GCODE_UNDEFINED_FEED_RATE); }
+    if (feed_rate < 0.0) { return(STATUS_NEGATIVE_VALUE); }
+    if (feed_rate > 0.0) { gc_state.feed_rate = feed_rate; }
+    if (gc_state.feed_rate == 0.0) { return(STATUS_GCODE_UNDEFINED_FEED_RATE); }
+  }
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_isfalse(axes,bit(idx))) {
+      target[idx] = gc_state.position[idx];
+    } else {
+      target[idx] = coord[idx] + gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+      if (idx == TOOL_LENGTH_OFFSET_AXIS) { target[idx] += gc_state.tool_length_offset; }
+    }
+  }
+  gc_state.modal.motion = motion;
+  gc_state.line_number = 0;
+  return(STATUS_OK);
+}
+
+
+// Executes a G0 or G1 in absolute distance mode, with its end point given per axis in axes as floats
+// in mm in the work coordinate system, as the binary stream sends them pre-parsed. The feed rate is in
+// mm/min, or zero to keep the last. See stream.c.
+uint8_t gc_execute_motion(uint8_t motion, uint8_t axes, float *coord, float feed_rate)
+{
+  float target[N_AXIS];
+  uint8_t status = gc_motion_target(motion, axes, coord, feed_rate, target);
+  if (status != STATUS_OK) { return(status); }
+  if (motion == MOTION_MODE_SEEK) {
+    #ifdef USE_LINE_NUMBERS
+      mc_line(target, -1.0, false, gc_state.line_number);
+    #else
+      mc_line(target, -1.0, false);
+    #endif
+  } else {
+    #ifdef USE_LINE_NUMBERS
+      mc_line(target, gc_state.feed_rate, gc_state.modal.feed_rate, gc_state.line_number);
+    #else
+      mc_line(target, gc_state.feed_rate, gc_state.modal.feed_rate);
+    #endif
+  }
+  memcpy(gc_state.position, target, sizeof(target));
+  return(STATUS_OK);
+}
+
+
+#ifdef RASTER_ENGRAVING
+// Executes a raster line: a G1 as gc_execute_motion() does, with the power of each of its pixels.
+// With the spindle off, it's a plain G1.
+uint8_t gc_execute_raster(uint8_t axes, float *coord, float feed_rate, uint8_t *power, uint8_t pixels)
+{
+  if (gc_state.modal.spindle == SPINDLE_DISABLE) {
+    return(gc_execute_motion(MOTION_MODE_LINEAR, axes, coord, feed_rate));
+  }
+  float target[N_AXIS];
+  uint8_t status = gc_motion_target(MOTION_MODE_LINEAR, axes, coord, feed_rate, target);
+  if (status != STATUS_OK) { return(status); }
+  #ifdef USE_LINE_NUMBERS
+    mc_raster(target, gc_state.feed_rate, power, pixels, gc_state.line_number);
+  #else
+    mc_raster(target, gc_state.feed_rate, power, pixels);
+  #endif
+  memcpy(gc_state.position, target, sizeof(target));
+  return(STATUS_OK);
+}
+#endif
+#endif
         
 
 /* 
@@ -1095,5 +1201,5 @@ uint8_t gc_execute_line(char *line)
    group 8 = {*M7} enable mist coolant (* Compile-option)
    group 9 = {M48, M49} enable/disable feed and speed override switches
    group 10 = {G98, G99} return mode canned cycles
-   group 13 = {G61.1, G64} path control mode (G61 is supported)
+   group 13 = {G61.1, *G64} path control mode (G61 is supported) (* Compile-option)
 */
@@ -50,6 +50,7 @@
 #include "gcode.h"
 #include "limits.h"
 #include "motion_control.h"
+#include "performance.h"
 #include "planner.h"
 #include "print.h"
 #include "probe.h"
@@ -58,5 +59,6 @@
 #include "serial.h"
 #include "spindle_control.h"
 #include "stepper.h"
+#include "stream.h"
 
 #endif
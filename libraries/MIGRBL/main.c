@@ -70,6 +70,12 @@ int main(void)
     probe_init();
     plan_reset(); // Clear block buffer and planner variables
     st_reset(); // Clear stepper subsystem variables.
+    #ifdef PATH_BLENDING
+      mc_blend_reset(); // Drop any line held for path blending. G61 is the default.
+    #endif
+    #ifdef BINARY_STREAMING
+      stream_reset(); // Back to lines of text until the host opens the stream again.
+    #endif
 
     // Sync cleared gcode and planner positions to current system position.
     plan_sync_position();
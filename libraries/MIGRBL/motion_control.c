@@ -22,6 +22,125 @@
 
 #include "grbl.h"
 
+#ifdef PATH_BLENDING
+  // The line held back from the planner in G64 path blending mode, while the lines that follow it
+  // are merged into it. See mc_line().
+  typedef struct {
+    float tolerance;          // G64 blending tolerance in mm. Zero in G61 exact path mode.
+    uint8_t count;            // Lines merged into the held line. Zero when no line is held.
+    float feed_rate;          // Of every line merged. Inverse time lines are never held.
+    #ifdef USE_LINE_NUMBERS
+      int32_t line_number;    // Of the last line merged
+    #endif
+    float start[N_AXIS];      // Planner position the held line starts from
+    float target[N_AXIS];     // End of the last line merged
+    float point[PATH_BLENDING_MAX_LINES-1][N_AXIS]; // Ends of the lines merged before the last one
+  } blend_t;
+  static blend_t blend;
+#endif
+
+
+// Waits for room in the planner buffer. Returns without it upon a system abort.
+static void mc_wait_for_buffer()
+{
+  #ifdef PERFORMANCE_COUNTERS
+    uint32_t start = st_cycles();
+  #endif
+  // If the buffer is full: good! That means we are well ahead of the robot. 
+  // Remain in this loop until there is room in the buffer.
+  do {
+    protocol_execute_realtime(); // Check for any run-time commands
+    if (sys.abort) { return; } // Bail, if system abort.
+    if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
+    else { break; }
+  } while (1);
+  #ifdef PERFORMANCE_COUNTERS
+    perf.blocked += (st_cycles()-start)*(1.0/F_CPU);
+  #endif
+}
+
+
+// Waits for room in the planner buffer and plans the line.
+#ifdef USE_LINE_NUMBERS
+  static void mc_plan_line(float *target, float feed_rate, uint8_t invert_feed_rate, int32_t line_number)
+#else
+  static void mc_plan_line(float *target, float feed_rate, uint8_t invert_feed_rate)
+#endif
+{
+  mc_wait_for_buffer();
+  if (sys.abort) { return; }
+
+  // Plan and queue motion into planner buffer
+  #ifdef USE_LINE_NUMBERS
+    plan_buffer_line(target, feed_rate, invert_feed_rate, line_number);
+  #else
+    plan_buffer_line(target, feed_rate, invert_feed_rate);
+  #endif
+}
+
+
+#ifdef PATH_BLENDING
+  // Returns true if the held line can be stretched to end at the target instead. Every end point
+  // merged so far must lie within the blending tolerance of the new line, in order along it and
+  // not past its end, so the path neither cuts in by more than the tolerance nor turns back.
+  static uint8_t mc_blend_fits(float *target)
+  {
+    float chord[N_AXIS];
+    float length_sqr = 0.0;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      chord[idx] = target[idx]-blend.start[idx];
+      length_sqr += chord[idx]*chord[idx];
+    }
+    if (length_sqr == 0.0) { return(false); }
+    float inv_length = 1.0/sqrt(length_sqr);
+    float tolerance_sqr = blend.tolerance*blend.tolerance;
+    float last_along = 0.0;
+    uint8_t i;
+    for (i=0; i<blend.count; i++) {
+      float *point = (i+1 < blend.count) ? blend.point[i] : blend.target;
+      float along = 0.0, distance_sqr = 0.0;
+      for (idx=0; idx<N_AXIS; idx++) {
+        float delta = point[idx]-blend.start[idx];
+        along += delta*chord[idx];
+        distance_sqr += delta*delta;
+      }
+      along *= inv_length; // Distance along the new line
+      if ((along < last_along) || (along*along > length_sqr)) { return(false); }
+      if (distance_sqr-along*along > tolerance_sqr) { return(false); } // Distance off it, squared
+      last_along = along;
+    }
+    return(true);
+  }
+
+
+  // Plans the held line, if there is one.
+  void mc_blend_flush()
+  {
+    if (!blend.count) { return; }
+    blend.count = 0;
+    #ifdef USE_LINE_NUMBERS
+      mc_plan_line(blend.target, blend.feed_rate, false, blend.line_number);
+    #else
+      mc_plan_line(blend.target, blend.feed_rate, false);
+    #endif
+  }
+
+
+  void mc_path_blending(float tolerance)
+  {
+    mc_blend_flush();
+    blend.tolerance = tolerance;
+  }
+
+
+  void mc_blend_reset()
+  {
+    blend.count = 0;
+    blend.tolerance = 0.0;
+  }
+#endif
+
 
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
@@ -57,24 +176,80 @@
   // doesn't update the machine position values. Since the position values used by the g-code
   // parser and planner are separate from the system machine positions, this is doable.
 
-  // If the buffer is full: good! That means we are well ahead of the robot. 
-  // Remain in this loop until there is room in the buffer.
-  do {
-    protocol_execute_realtime(); // Check for any run-time commands
-    if (sys.abort) { return; } // Bail, if system abort.
-    if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
-    else { break; }
-  } while (1);
+  #ifdef PATH_BLENDING
+    // In G64, each line is held back from the planner, so the next one can be merged into it if
+    // the merged line stays within the blending tolerance of all of their end points. The held line
+    // is planned once one doesn't fit, or when the planner buffer is about to run dry, on any 
+    // buffer synchronize, on a '$' command, or on a switch back to G61.
+    // NOTE: Inverse time lines are never merged, since each one carries its own duration.
+    if ((blend.tolerance > 0.0) && !invert_feed_rate) {
+      if (blend.count) {
+        if ((blend.count < PATH_BLENDING_MAX_LINES) && (feed_rate == blend.feed_rate) && mc_blend_fits(target)) {
+          memcpy(blend.point[blend.count-1], blend.target, sizeof(blend.target));
+          memcpy(blend.target, target, sizeof(blend.target));
+          #ifdef USE_LINE_NUMBERS
+            blend.line_number = line_number;
+          #endif
+          blend.count++;
+          return;
+        }
+        mc_blend_flush();
+        if (sys.abort) { return; }
+      }
+      plan_get_position(blend.start);
+      memcpy(blend.target, target, sizeof(blend.target));
+      blend.feed_rate = feed_rate;
+      #ifdef USE_LINE_NUMBERS
+        blend.line_number = line_number;
+      #endif
+      blend.count = 1;
+      return;
+    }
+    mc_blend_flush();
+  #endif
 
-  // Plan and queue motion into planner buffer
   #ifdef USE_LINE_NUMBERS
-    plan_buffer_line(target, feed_rate, invert_feed_rate, line_number);
+    mc_plan_line(target, feed_rate, invert_feed_rate, line_number);
   #else
-    plan_buffer_line(target, feed_rate, invert_feed_rate);
+    mc_plan_line(target, feed_rate, invert_feed_rate);
   #endif
 }
 
 
+#ifdef RASTER_ENGRAVING
+  // Execute a raster line, as a feed move in absolute millimeter coordinates along which the power
+  // of each pixel sets the spindle PWM output in turn. Waits for room in the planner buffer and
+  // for the pixels in the raster buffer, which is freed as the blocks before are burned.
+  #ifdef USE_LINE_NUMBERS
+    void mc_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels, int32_t line_number)
+  #else
+    void mc_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels)
+  #endif
+  {
+    if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) { limits_soft_check(target); }
+    if (sys.state == STATE_CHECK_MODE) { return; }
+    #ifdef PATH_BLENDING
+      mc_blend_flush(); // Raster lines are never merged.
+      if (sys.abort) { return; }
+    #endif
+
+    mc_wait_for_buffer();
+    while (!st_raster_fits(pixels)) {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return; } // Bail, if system abort.
+      protocol_auto_cycle_start(); // The raster lines planned have to burn to make room.
+    }
+    if (sys.abort) { return; }
+
+    #ifdef USE_LINE_NUMBERS
+      plan_buffer_raster(target, feed_rate, power, pixels, line_number);
+    #else
+      plan_buffer_raster(target, feed_rate, power, pixels);
+    #endif
+  }
+#endif
+
+
 // Execute an arc in offset mode format. position == current xyz, target == target xyz, 
 // offset == offset from current xyz, axis_X defines circle plane in tool space, axis_linear is
 // the direction of helical travel, radius == circle radius, isclockwise boolean. Used
@@ -112,6 +287,43 @@
   uint16_t segments = floor(fabs(0.5*angular_travel*radius)/
                           sqrt(settings.arc_tolerance*(2*radius - settings.arc_tolerance)) );
   
+  #ifdef ARC_BLOCKS
+    // Plan the arc as a single block, which the segment generator follows. An arc too short to cut
+    // into segments is still a line to the target, below.
+    if (segments) {
+      if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) { 
+        // Check the end of the arc, and each point furthest along a plane axis that it passes.
+        limits_soft_check(target);
+        float angle_0 = atan2(r_axis1, r_axis0);
+        uint8_t quadrant;
+        for (quadrant=0; quadrant<4; quadrant++) {
+          float turn = fmod(quadrant*M_PI_2 - angle_0 + 4*M_PI, 2*M_PI); // Counter-clockwise to it
+          if (angular_travel < 0.0) { turn -= 2*M_PI; } // Clockwise to it
+          if (fabs(turn) <= fabs(angular_travel)) {
+            float point[N_AXIS];
+            memcpy(point, target, sizeof(point));
+            point[axis_0] = center_axis0 + ((quadrant == 0) ? radius : ((quadrant == 2) ? -radius : 0.0));
+            point[axis_1] = center_axis1 + ((quadrant == 1) ? radius : ((quadrant == 3) ? -radius : 0.0));
+            point[axis_linear] = position[axis_linear] + (target[axis_linear]-position[axis_linear])*turn/angular_travel;
+            limits_soft_check(point);
+          }
+        }
+      }
+      if (sys.state == STATE_CHECK_MODE) { return; }
+      #ifdef PATH_BLENDING
+        mc_blend_flush(); // Held lines come first.
+      #endif
+      mc_wait_for_buffer();
+      if (sys.abort) { return; }
+      #ifdef USE_LINE_NUMBERS
+        plan_buffer_arc(target, offset, radius, angular_travel, axis_linear, feed_rate, invert_feed_rate, line_number);
+      #else
+        plan_buffer_arc(target, offset, radius, angular_travel, axis_linear, feed_rate, invert_feed_rate);
+      #endif
+      return;
+    }
+  #endif
+
   if (segments) { 
     // Multiply inverse feed_rate to compensate for the fact that this movement is approximated
     // by a number of discrete segments. The inverse feed_rate should be correct for the sum of 
@@ -34,6 +34,28 @@ void mc_line(float *target, float feed_rate, uint8_t invert_feed_rate, int32_t l
 void mc_line(float *target, float feed_rate, uint8_t invert_feed_rate);
 #endif
 
+#ifdef PATH_BLENDING
+  // Sets the G64 blending tolerance in mm, or zero for G61 exact path mode. Plans the held line.
+  void mc_path_blending(float tolerance);
+
+  // Plans the line held back for path blending, if any. Must be called before anything that waits
+  // for the planner buffer to empty.
+  void mc_blend_flush();
+
+  // Drops the held line and returns to exact path mode. Called upon a system abort.
+  void mc_blend_reset();
+#endif
+
+#ifdef RASTER_ENGRAVING
+  // Execute a raster line: a feed move as mc_line(), along which the power of each of the pixels,
+  // 0-255, sets the spindle PWM output in turn.
+  #ifdef USE_LINE_NUMBERS
+    void mc_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels, int32_t line_number);
+  #else
+    void mc_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels);
+  #endif
+#endif
+
 // Execute an arc in offset mode format. position == current xyz, target == target xyz, 
 // offset == offset from current xyz, axis_XXX defines circle plane in tool space, axis_linear is
 // the direction of helical travel, radius == circle radius, is_clockwise_arc boolean. Used
@@ -0,0 +1,47 @@
+/*
+  performance.c - counters of where the time goes, for profiling a job
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef PERFORMANCE_COUNTERS
+
+perf_t perf;
+
+
+void perf_reset()
+{
+  uint8_t sreg = SREG;
+  cli();
+  memset(&perf, 0, sizeof(perf));
+  SREG = sreg;
+}
+
+
+void perf_add(perf_timer_t *timer, uint32_t cycles)
+{
+  if (cycles == 0) { return; } // Timed while the steppers were idle, and the clock stood.
+  if (timer->total & 0x80000000) { // Keeps the average, which is all the total is for.
+    timer->total >>= 1;
+    timer->count >>= 1;
+  }
+  timer->total += cycles;
+  timer->count++;
+  if (cycles > timer->max) { timer->max = cycles; }
+}
+
+#endif
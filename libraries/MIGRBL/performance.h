@@ -0,0 +1,50 @@
+/*
+  performance.h - counters of where the time goes, for profiling a job
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef performance_h
+#define performance_h
+
+#ifdef PERFORMANCE_COUNTERS
+
+// Time taken by one kind of work, in CPU cycles. The total and count are halved together before
+// the total overflows, so the average holds on a long job.
+typedef struct {
+  uint32_t total;
+  uint32_t count;
+  uint32_t max;
+} perf_timer_t;
+
+typedef struct {
+  perf_timer_t isr;      // Stepper ISR, from its compare to its end, with the interrupts it lets in
+  perf_timer_t prep;     // st_prep_buffer() calls that prepped a segment, while the steppers ran
+  perf_timer_t planner;  // Plan recalculations of each block planned while the steppers ran
+  float blocked;         // Seconds waiting for room in the planner buffer
+  uint16_t underruns;    // Times the segment buffer ran empty in a cycle, with blocks still planned
+  uint8_t rx_high;       // Most characters in the serial RX buffer at once
+} perf_t;
+extern perf_t perf;
+
+// Clears all counters. Also $PR.
+void perf_reset();
+
+// Adds a time taken, in CPU cycles, as st_cycles() gives them. Zero is taken as not timed.
+void perf_add(perf_timer_t *timer, uint32_t cycles);
+
+#endif
+
+#endif
@@ -38,6 +38,13 @@ typedef struct {
                                      // i.e. arcs, canned cycles, and backlash compensation.
   float previous_unit_vec[N_AXIS];   // Unit vector of previous path line segment
   float previous_nominal_speed_sqr;  // Nominal speed of previous path line segment
+  #ifdef INPUT_SHAPING
+    float shaper_block_time[INPUT_SHAPER_BLOCKS-4]; // Least times of the last blocks queued (min)
+    float shaper_block_mm[INPUT_SHAPER_BLOCKS-4];   // And their lengths (mm)
+    uint8_t shaper_block_index;      // Of the oldest of them, written over next
+    uint8_t shaper_block_count;      // Queued since the reset, up to INPUT_SHAPER_BLOCKS-4
+    float shaper_speed;              // Last speed limit set for the shaper (mm/min)
+  #endif
 } planner_t;
 static planner_t pl;
 
@@ -60,6 +67,48 @@ static uint8_t plan_prev_block_index(uint8_t block_index)
 }
 
 
+#ifdef JERK_LIMITED_ACCELERATION
+  // Max jerk of an axis. A zero $14x setting follows the axis acceleration setting, so that it is
+  // reached in JERK_RAMP_TIME whatever $12x is changed to.
+  static float plan_axis_jerk(uint8_t idx)
+  {
+    if (settings.jerk[idx] > 0.0) { return(settings.jerk[idx]); }
+    return(settings.acceleration[idx]*(60.0/JERK_RAMP_TIME)); // mm/min^3, as the time is in sec
+  }
+
+
+  // A jerk-limited ramp between two speeds, with no acceleration at either end, that reaches the
+  // full acceleration covers (v1^2-v0^2)/(2*a) + (v0+v1)*a/(2*j) mm. This solves for v1 directly.
+  // A shorter ramp never reaches it and covers (2*v0+dv)*sqrt(dv/j) mm, a cubic in sqrt(dv).
+  static float plan_compute_jerk_limited_speed(float speed, float distance, float acceleration, float jerk)
+  {
+    float k = 0.5*acceleration*acceleration/jerk; // Half the least dv at full acceleration
+    if (distance >= 2*(speed+k)*acceleration/jerk) {
+      float speed_k = speed-k;
+      return( sqrt(speed_k*speed_k + 2*acceleration*distance) - k );
+    }
+    // Solve s^3 + 2*v0*s - distance*sqrt(j) = 0 for s = sqrt(dv). Cardano's formula, rearranged so
+    // it doesn't cancel when v0 is large.
+    float p = (2.0/3.0)*speed;
+    float q = 0.5*distance*sqrt(jerk);
+    float r = cbrt(q + sqrt(q*q + p*p*p));
+    r *= r;
+    float s = 2*q/(r + p + p*p/r);
+    return( speed + s*s );
+  }
+
+
+  // Returns true if the acceleration must be zero at the entry of this block, so a ramp group
+  // starts there: the entry speed is at its maximum, or the nominal speed drops.
+  static uint8_t plan_ramp_group_starts(uint8_t block_index)
+  {
+    plan_block_t *block = &block_buffer[block_index];
+    if (block->entry_speed_sqr == block->max_entry_speed_sqr) { return(true); }
+    return( block->nominal_speed_sqr < block_buffer[plan_prev_block_index(block_index)].nominal_speed_sqr );
+  }
+#endif
+
+
 /*                            PLANNER SPEED DEFINITION                                              
                                      +--------+   <- current->nominal_speed
                                     /          \                                
@@ -124,7 +173,63 @@ static uint8_t plan_prev_block_index(uint8_t block_index)
   to compute an optimal plan, so select carefully. The Arduino 328p memory is already maxed out, but future
   ARM versions should have enough memory and speed for look-ahead blocks numbering up to a hundred or more.
 
+  JERK-LIMITED ACCELERATION: The acceleration can only return to zero gradually, so if every block
+  ramped with none at its junctions, as trapezoids do, a path of short line segments could hardly
+  accelerate at all. Instead, the blocks between two junctions where the acceleration must be zero 
+  form a ramp group, and the segment generator runs its S-curve ramps straight across the junctions
+  inside it. A group ends at a junction at its maximum entry speed or where the nominal speed drops. 
+  The reverse pass decelerates over a whole group at once, from the speed at its far end, with the 
+  least acceleration and jerk of its blocks. There is no forward pass. The segment generator only
+  accelerates as far as it can, and the planned pointer moves on at maximum entry speeds.
 */
+#ifdef JERK_LIMITED_ACCELERATION
+static void planner_recalculate() 
+{   
+  // Initialize block index to the last block in the planner buffer.
+  uint8_t block_index = plan_prev_block_index(block_buffer_head);
+        
+  // Bail. Can't do anything with one only one plan-able block.
+  if (block_index == block_buffer_planned) { return; }
+
+  // Reverse pass, from a complete stop at the end of the buffer to the planned pointer.
+  uint8_t planned_index = block_buffer_planned;
+  float exit_speed = 0.0; // At the end of the ramp group
+  float group_mm = 0.0;
+  float acceleration = SOME_LARGE_VALUE;
+  float jerk = SOME_LARGE_VALUE;
+  float entry_speed;
+  plan_block_t *current;
+  while (block_index != block_buffer_planned) {
+    current = &block_buffer[block_index];
+    group_mm += current->millimeters;
+    acceleration = min(acceleration, current->acceleration);
+    jerk = min(jerk, current->jerk);
+    if (current->entry_speed_sqr != current->max_entry_speed_sqr) {
+      entry_speed = plan_compute_jerk_limited_speed(exit_speed, group_mm, acceleration, jerk);
+      if (entry_speed*entry_speed < current->max_entry_speed_sqr) {
+        current->entry_speed_sqr = entry_speed*entry_speed;
+      } else {
+        current->entry_speed_sqr = current->max_entry_speed_sqr;
+      }
+    }
+    if (plan_ramp_group_starts(block_index)) {
+      // Nothing after the last maximum entry speed can change the plan before it.
+      if (planned_index == block_buffer_planned && current->entry_speed_sqr == current->max_entry_speed_sqr) {
+        planned_index = block_index;
+      }
+      exit_speed = sqrt(current->entry_speed_sqr);
+      group_mm = 0.0;
+      acceleration = SOME_LARGE_VALUE;
+      jerk = SOME_LARGE_VALUE;
+    }
+    block_index = plan_prev_block_index(block_index);
+
+    // Check if the exit speed of the tail block changed. If so, update current stepper parameters.
+    if (block_index == block_buffer_tail) { st_update_plan_block_parameters(); }
+  }
+  block_buffer_planned = planned_index;
+}
+#else
 static void planner_recalculate() 
 {   
   // Initialize block index to the last block in the planner buffer.
@@ -141,7 +246,7 @@ static void planner_recalculate()
   plan_block_t *current = &block_buffer[block_index];
 
   // Calculate maximum entry speed for last block in buffer, where the exit speed is always zero.
-  current->entry_speed_sqr = min( current->max_entry_speed_sqr, 2*current->acceleration*current->millimeters);
+  current->entry_speed_sqr = min( current->max_entry_speed_sqr, 2*current->acceleration*current->millimeters );
   
   block_index = plan_prev_block_index(block_index);
   if (block_index == block_buffer_planned) { // Only two plannable blocks in buffer. Reverse pass complete.
@@ -196,6 +301,7 @@ static void planner_recalculate()
     block_index = plan_next_block_index( block_index );
   } 
 }
+#endif
 
 
 void plan_reset() 
@@ -234,6 +340,31 @@ float plan_get_exec_block_exit_speed()
 }
 
 
+#ifdef JERK_LIMITED_ACCELERATION
+  float plan_get_exec_ramp_group(float *exit_speed, float *acceleration, float *jerk)
+  {
+    plan_block_t *block = &block_buffer[block_buffer_tail];
+    *acceleration = block->acceleration;
+    *jerk = block->jerk;
+    float group_mm = 0.0;
+    uint8_t block_index = plan_next_block_index(block_buffer_tail);
+    while (block_index != block_buffer_head) {
+      if (plan_ramp_group_starts(block_index)) { 
+        *exit_speed = sqrt(block_buffer[block_index].entry_speed_sqr);
+        return(group_mm); 
+      }
+      block = &block_buffer[block_index];
+      group_mm += block->millimeters;
+      *acceleration = min(*acceleration, block->acceleration);
+      *jerk = min(*jerk, block->jerk);
+      block_index = plan_next_block_index(block_index);
+    }
+    *exit_speed = 0.0; // Stops at the end of the buffer
+    return(group_mm);
+  }
+#endif
+
+
 // Returns the availability status of the block ring buffer. True, if full.
 uint8_t plan_check_full_buffer()
 {
@@ -242,6 +373,143 @@ uint8_t plan_check_full_buffer()
 }
 
 
+// Completes a new block with its entry junction speed limit from the unit vectors of the directions
+// it enters and leaves in, which differ for an arc. Adds it to the buffer and recalculates the plan.
+// Also sets where the next block starts from.
+static void plan_queue_block(plan_block_t *block, float *unit_vec, float *exit_unit_vec, float feed_rate,
+  int32_t *target_steps)
+{
+  // Compute cosine of angle between previous and current path. Cos(theta) of the junction between
+  // the current move and the previous move is simply the dot product of the two unit vectors, 
+  // where prev_unit_vec is negative. Used later to compute maximum junction speed.
+  float junction_cos_theta = 0;
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { junction_cos_theta -= pl.previous_unit_vec[idx] * unit_vec[idx]; }
+
+  // TODO: Need to check this method handling zero junction speeds when starting from rest.
+  if (block_buffer_head == block_buffer_tail) {
+  
+    // Initialize block entry speed as zero. Assume it will be starting from rest. Planner will correct this later.
+    block->entry_speed_sqr = 0.0;
+    block->max_junction_speed_sqr = 0.0; // Starting from rest. Enforce start from zero velocity.
+  
+  } else {
+    /* 
+       Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
+       Let a circle be tangent to both previous and current path line segments, where the junction 
+       deviation is defined as the distance from the junction to the closest edge of the circle, 
+       colinear with the circle center. The circular segment joining the two paths represents the 
+       path of centripetal acceleration. Solve for max velocity based on max acceleration about the
+       radius of the circle, defined indirectly by junction deviation. This may be also viewed as 
+       path width or max_jerk in the previous Grbl version. This approach does not actually deviate 
+       from path, but used as a robust way to compute cornering speeds, as it takes into account the
+       nonlinearities of both the junction angle and junction velocity.
+
+       NOTE: If the junction deviation value is finite, Grbl executes the motions in an exact path 
+       mode (G61). If the junction deviation value is zero, Grbl will execute the motion in an exact
+       stop mode (G61.1) manner. In the future, if continuous mode (G64) is desired, the math here
+       is exactly the same. Instead of motioning all the way to junction point, the machine will
+       just follow the arc circle defined here. The Arduino doesn't have the CPU cycles to perform
+       a continuous mode path, but ARM-based microcontrollers most certainly do. 
+       
+       NOTE: The max junction speed is a fixed value, since machine acceleration limits cannot be
+       changed dynamically during operation nor can the line move geometry. This must be kept in
+       memory in the event of a feedrate override changing the nominal speeds of blocks, which can 
+       change the overall maximum entry speed conditions of all blocks.
+    */
+    // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
+    if (junction_cos_theta > 0.999999) {
+      //  For a 0 degree acute junction, just set minimum junction speed. 
+      block->max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED;
+    } else {
+      junction_cos_theta = max(junction_cos_theta,-0.999999); // Check for numerical round-off to avoid divide by zero.
+      float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
+
+      // TODO: Technically, the acceleration used in calculation needs to be limited by the minimum of the
+      // two junctions. However, this shouldn't be a significant problem except in extreme circumstances.
+      block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                                   (block->acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+
+      #ifdef JERK_LIMITED_ACCELERATION
+        // The centripetal acceleration around the junction circle must also rise and fall within the
+        // jerk limit over the arc, which turns through 2*acos(sin_theta_d2) radians. For radius r, this
+        // holds if v^3 <= jerk*r^2*acos(sin_theta_d2), and acos(x) >= sqrt(1-x^2) keeps it trig free.
+        float radius = settings.junction_deviation*sin_theta_d2/(1.0-sin_theta_d2);
+        float junction_speed = cbrt(block->jerk*radius*radius*sqrt(1.0-sin_theta_d2*sin_theta_d2));
+        block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                                     min(block->max_junction_speed_sqr, junction_speed*junction_speed) );
+      #endif
+    }
+  }
+
+  #ifdef INPUT_SHAPING
+    // The shaped motion trails the planned one by a few blocks at most, and the stepper blocks only
+    // hold INPUT_SHAPER_BLOCKS-3 of them for it, this one and the last others. Either of two limits
+    // keeps it within them when the planned motion reaches the end of this block. The shaped motion
+    // is then no further behind than st_shaper_lag_speed() allows for, at this block's speed, as no
+    // block slows down faster than the acceleration of all axes together. At steady speed that is
+    // the mean shaper delay, so steady runs of short blocks, such as dense arcs, mostly keep their
+    // feed. Or else the run must not go through faster than the shaper window. This block is held
+    // to the speed that takes its run that long, and if need be lower, so the run does at the
+    // nominal speeds of the others. Their actual speeds are never higher. Long blocks need neither.
+    float window = st_shaper_window();
+    if (window > 0.0 && pl.shaper_block_count == INPUT_SHAPER_BLOCKS-4) {
+      float run_mm = block->millimeters;
+      float acceleration_sqr = 0.0;
+      uint8_t idx;
+      for (idx=0; idx<INPUT_SHAPER_BLOCKS-4; idx++) { run_mm += pl.shaper_block_mm[idx]; }
+      for (idx=0; idx<N_AXIS; idx++) { acceleration_sqr += settings.acceleration[idx]*settings.acceleration[idx]; }
+      float lag_speed = st_shaper_lag_speed(run_mm, sqrt(acceleration_sqr));
+      float window_speed = run_mm/window;
+      for (idx=0; idx<INPUT_SHAPER_BLOCKS-4; idx++) { window -= pl.shaper_block_time[idx]; }
+      if (window > 0.0) { window_speed = min(window_speed, block->millimeters/window); }
+      // Runs of blocks of slightly different lengths would get a slightly different limit each, and
+      // the planner would then slow down and speed up at every block. So the last limit is kept
+      // while it holds and this one isn't much higher, and a new one is set a little lower.
+      float speed = max(lag_speed, window_speed);
+      if ((speed < pl.shaper_speed) || (speed > 1.03125*pl.shaper_speed)) { pl.shaper_speed = 0.984375*speed; }
+      feed_rate = min(feed_rate, pl.shaper_speed);
+    }
+    pl.shaper_block_time[pl.shaper_block_index] = block->millimeters/feed_rate;
+    pl.shaper_block_mm[pl.shaper_block_index] = block->millimeters;
+    if (++pl.shaper_block_index == INPUT_SHAPER_BLOCKS-4) { pl.shaper_block_index = 0; }
+    if (pl.shaper_block_count < INPUT_SHAPER_BLOCKS-4) { pl.shaper_block_count++; }
+  #endif
+
+  // Store block nominal speed
+  block->nominal_speed_sqr = feed_rate*feed_rate; // (mm/min). Always > 0
+  
+  // Compute the junction maximum entry based on the minimum of the junction speed and neighboring nominal speeds.
+  block->max_entry_speed_sqr = min(block->max_junction_speed_sqr, 
+                                   min(block->nominal_speed_sqr,pl.previous_nominal_speed_sqr));
+  
+  // Update previous path unit_vector and nominal speed (squared)
+  memcpy(pl.previous_unit_vec, exit_unit_vec, sizeof(pl.previous_unit_vec)); // pl.previous_unit_vec[] = exit_unit_vec[]
+  pl.previous_nominal_speed_sqr = block->nominal_speed_sqr;
+
+  #ifdef RASTER_ENGRAVING
+    block->raster_start = st_raster_head();
+    block->raster_pixels = 0; // Set by plan_buffer_raster() for a raster line
+  #endif
+    
+  // Update planner position
+  memcpy(pl.position, target_steps, sizeof(pl.position)); // pl.position[] = target_steps[]
+
+  // New block is all set. Update buffer head and next buffer head indices.
+  block_buffer_head = next_buffer_head;  
+  next_buffer_head = plan_next_block_index(block_buffer_head);
+  
+  // Finish up by recalculating the plan with the new block.
+  #ifdef PERFORMANCE_COUNTERS
+    uint32_t start = st_cycles();
+    planner_recalculate();
+    perf_add(&perf.planner, st_cycles()-start);
+  #else
+    planner_recalculate();
+  #endif
+}
+
+
 /* Add a new linear movement to the buffer. target[N_AXIS] is the signed, absolute target position
    in millimeters. Feed rate specifies the speed of the motion. If feed rate is inverted, the feed
    rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
@@ -264,9 +532,15 @@ uint8_t plan_check_full_buffer()
   block->millimeters = 0;
   block->direction_bits = 0;
   block->acceleration = SOME_LARGE_VALUE; // Scaled down to maximum acceleration later
+  #ifdef JERK_LIMITED_ACCELERATION
+    block->jerk = SOME_LARGE_VALUE; // Scaled down to maximum jerk later
+  #endif
   #ifdef USE_LINE_NUMBERS
     block->line_number = line_number;
   #endif
+  #ifdef ARC_BLOCKS
+    block->arc_axis = 0; // Line
+  #endif
 
   // Compute and store initial move distance data.
   // TODO: After this for-loop, we don't touch the stepper algorithm data. Might be a good idea
@@ -329,7 +603,6 @@ uint8_t plan_check_full_buffer()
   // if they are also orthogonal/independent. Operates on the absolute value of the unit vector.
   float inverse_unit_vec_value;
   float inverse_millimeters = 1.0/block->millimeters;  // Inverse millimeters to remove multiple float divides	
-  float junction_cos_theta = 0;
   for (idx=0; idx<N_AXIS; idx++) {
     if (unit_vec[idx] != 0) {  // Avoid divide by zero.
       unit_vec[idx] *= inverse_millimeters;  // Complete unit vector calculation
@@ -338,82 +611,132 @@ uint8_t plan_check_full_buffer()
       // Check and limit feed rate against max individual axis velocities and accelerations
       feed_rate = min(feed_rate,settings.max_rate[idx]*inverse_unit_vec_value);
       block->acceleration = min(block->acceleration,settings.acceleration[idx]*inverse_unit_vec_value);
-
-      // Incrementally compute cosine of angle between previous and current path. Cos(theta) of the junction
-      // between the current move and the previous move is simply the dot product of the two unit vectors, 
-      // where prev_unit_vec is negative. Used later to compute maximum junction speed.
-      junction_cos_theta -= pl.previous_unit_vec[idx] * unit_vec[idx];
+      #ifdef JERK_LIMITED_ACCELERATION
+        block->jerk = min(block->jerk,plan_axis_jerk(idx)*inverse_unit_vec_value);
+      #endif
     }
   }
   
-  // TODO: Need to check this method handling zero junction speeds when starting from rest.
-  if (block_buffer_head == block_buffer_tail) {
-  
-    // Initialize block entry speed as zero. Assume it will be starting from rest. Planner will correct this later.
-    block->entry_speed_sqr = 0.0;
-    block->max_junction_speed_sqr = 0.0; // Starting from rest. Enforce start from zero velocity.
-  
-  } else {
-    /* 
-       Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
-       Let a circle be tangent to both previous and current path line segments, where the junction 
-       deviation is defined as the distance from the junction to the closest edge of the circle, 
-       colinear with the circle center. The circular segment joining the two paths represents the 
-       path of centripetal acceleration. Solve for max velocity based on max acceleration about the
-       radius of the circle, defined indirectly by junction deviation. This may be also viewed as 
-       path width or max_jerk in the previous Grbl version. This approach does not actually deviate 
-       from path, but used as a robust way to compute cornering speeds, as it takes into account the
-       nonlinearities of both the junction angle and junction velocity.
+  plan_queue_block(block, unit_vec, unit_vec, feed_rate, target_steps);
+}
 
-       NOTE: If the junction deviation value is finite, Grbl executes the motions in an exact path 
-       mode (G61). If the junction deviation value is zero, Grbl will execute the motion in an exact
-       stop mode (G61.1) manner. In the future, if continuous mode (G64) is desired, the math here
-       is exactly the same. Instead of motioning all the way to junction point, the machine will
-       just follow the arc circle defined here. The Arduino doesn't have the CPU cycles to perform
-       a continuous mode path, but ARM-based microcontrollers most certainly do. 
-       
-       NOTE: The max junction speed is a fixed value, since machine acceleration limits cannot be
-       changed dynamically during operation nor can the line move geometry. This must be kept in
-       memory in the event of a feedrate override changing the nominal speeds of blocks, which can 
-       change the overall maximum entry speed conditions of all blocks.
-    */
-    // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
-    if (junction_cos_theta > 0.999999) {
-      //  For a 0 degree acute junction, just set minimum junction speed. 
-      block->max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED;
-    } else {
-      junction_cos_theta = max(junction_cos_theta,-0.999999); // Check for numerical round-off to avoid divide by zero.
-      float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
 
-      // TODO: Technically, the acceleration used in calculation needs to be limited by the minimum of the
-      // two junctions. However, this shouldn't be a significant problem except in extreme circumstances.
-      block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
-                                   (block->acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+#ifdef ARC_BLOCKS
+  /* Add a new arc to the buffer as a single block. See planner.h for the arguments. The block moves
+     from the planner position to target, and the segment generator follows the arc between them.
+     The arc is limited as a line would be by the plane axes for its travel in the plane, taken in
+     whatever direction, and by the linear axis for its helical travel. Turning takes acceleration
+     as well: the nominal speed is lowered to keep the centripetal acceleration within 
+     ARC_CENTRIPETAL_SHARE of the plane acceleration limit, and what is left at that speed is the 
+     acceleration along the arc. The junction speeds come from the directions it starts and ends in.
+     NOTE: The centripetal acceleration begins at the entry junction. The junction deviation limit
+     there still applies, as for any junction. */
+  #ifdef USE_LINE_NUMBERS
+    void plan_buffer_arc(float *target, float *offset, float radius, float angular_travel, uint8_t axis_linear,
+      float feed_rate, uint8_t invert_feed_rate, int32_t line_number)
+  #else
+    void plan_buffer_arc(float *target, float *offset, float radius, float angular_travel, uint8_t axis_linear,
+      float feed_rate, uint8_t invert_feed_rate)
+  #endif
+  {
+    plan_block_t *block = &block_buffer[block_buffer_head];
+    uint8_t axis_0 = (axis_linear+1) % N_AXIS;
+    uint8_t axis_1 = (axis_linear+2) % N_AXIS;
+    block->step_event_count = 0;
+    block->direction_bits = 0;
+    #ifdef USE_LINE_NUMBERS
+      block->line_number = line_number;
+    #endif
 
+    // Net steps from start to end, for the position the next block starts from.
+    int32_t target_steps[N_AXIS];
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      target_steps[idx] = lround(target[idx]*settings.steps_per_mm[idx]);
+      block->steps[idx] = labs(target_steps[idx]-pl.position[idx]);
+      block->step_event_count = max(block->step_event_count, block->steps[idx]);
+      if (target_steps[idx] < pl.position[idx]) { block->direction_bits |= get_direction_pin_mask(idx); }
+    }
+
+    // Arc length, and the share of it in the plane and along the linear axis.
+    float plane_mm = fabs(angular_travel)*radius;
+    float linear_mm = (target_steps[axis_linear]-pl.position[axis_linear])/settings.steps_per_mm[axis_linear];
+    block->millimeters = sqrt(plane_mm*plane_mm + linear_mm*linear_mm);
+    float plane_share = plane_mm/block->millimeters;
+    float linear_share = fabs(linear_mm)/block->millimeters;
+    block->arc_axis = axis_linear+1;
+    block->arc_radius[0] = -offset[axis_0];
+    block->arc_radius[1] = -offset[axis_1];
+    block->arc_angle_per_mm = angular_travel/block->millimeters;
+    block->arc_linear_per_mm = linear_mm/block->millimeters;
+
+    if (invert_feed_rate) { feed_rate *= block->millimeters; }
+    if (feed_rate < MINIMUM_FEED_RATE) { feed_rate = MINIMUM_FEED_RATE; }
+
+    // Speed and acceleration limits. The plane travel may point along either plane axis.
+    float plane_acceleration = min(settings.acceleration[axis_0], settings.acceleration[axis_1]);
+    block->acceleration = SOME_LARGE_VALUE;
+    #ifdef JERK_LIMITED_ACCELERATION
+      block->jerk = SOME_LARGE_VALUE;
+    #endif
+    if (linear_share > 0.0) {
+      feed_rate = min(feed_rate, settings.max_rate[axis_linear]/linear_share);
+      block->acceleration = settings.acceleration[axis_linear]/linear_share;
+      #ifdef JERK_LIMITED_ACCELERATION
+        block->jerk = plan_axis_jerk(axis_linear)/linear_share;
+      #endif
     }
+    if (plane_share > 0.0) {
+      feed_rate = min(feed_rate, min(settings.max_rate[axis_0], settings.max_rate[axis_1])/plane_share);
+      feed_rate = min(feed_rate, sqrt(ARC_CENTRIPETAL_SHARE*plane_acceleration*radius)/plane_share);
+      float plane_speed = feed_rate*plane_share;
+      float centripetal = plane_speed*plane_speed/radius;
+      block->acceleration = min(block->acceleration,
+        sqrt(plane_acceleration*plane_acceleration - centripetal*centripetal)/plane_share);
+      #ifdef JERK_LIMITED_ACCELERATION
+        block->jerk = min(block->jerk, min(plan_axis_jerk(axis_0), plan_axis_jerk(axis_1))/plane_share);
+      #endif
+    }
+
+    // Directions the arc starts and ends in. Tangent to the circle, turning the way the arc does.
+    float unit_vec[N_AXIS], exit_unit_vec[N_AXIS];
+    float tangent_scale = (angular_travel < 0.0 ? -plane_share : plane_share)/radius;
+    float cos_T = cos(angular_travel);
+    float sin_T = sin(angular_travel);
+    float r_axis0 = block->arc_radius[0]*cos_T - block->arc_radius[1]*sin_T; // End radius vector
+    float r_axis1 = block->arc_radius[0]*sin_T + block->arc_radius[1]*cos_T;
+    unit_vec[axis_0] = -block->arc_radius[1]*tangent_scale;
+    unit_vec[axis_1] = block->arc_radius[0]*tangent_scale;
+    unit_vec[axis_linear] = block->arc_linear_per_mm;
+    exit_unit_vec[axis_0] = -r_axis1*tangent_scale;
+    exit_unit_vec[axis_1] = r_axis0*tangent_scale;
+    exit_unit_vec[axis_linear] = block->arc_linear_per_mm;
+
+    plan_queue_block(block, unit_vec, exit_unit_vec, feed_rate, target_steps);
   }
+#endif
 
-  // Store block nominal speed
-  block->nominal_speed_sqr = feed_rate*feed_rate; // (mm/min). Always > 0
-  
-  // Compute the junction maximum entry based on the minimum of the junction speed and neighboring nominal speeds.
-  block->max_entry_speed_sqr = min(block->max_junction_speed_sqr, 
-                                   min(block->nominal_speed_sqr,pl.previous_nominal_speed_sqr));
-  
-  // Update previous path unit_vector and nominal speed (squared)
-  memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
-  pl.previous_nominal_speed_sqr = block->nominal_speed_sqr;
-    
-  // Update planner position
-  memcpy(pl.position, target_steps, sizeof(target_steps)); // pl.position[] = target_steps[]
 
-  // New block is all set. Update buffer head and next buffer head indices.
-  block_buffer_head = next_buffer_head;  
-  next_buffer_head = plan_next_block_index(block_buffer_head);
-  
-  // Finish up by recalculating the plan with the new block.
-  planner_recalculate();
-}
+#ifdef RASTER_ENGRAVING
+  // Add a raster line to the buffer. See planner.h. A zero-length line isn't planned, and its pixels
+  // are dropped with it.
+  #ifdef USE_LINE_NUMBERS
+    void plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels, int32_t line_number)
+  #else
+    void plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels)
+  #endif
+  {
+    uint8_t block_index = block_buffer_head;
+    #ifdef USE_LINE_NUMBERS
+      plan_buffer_line(target, feed_rate, false, line_number);
+    #else
+      plan_buffer_line(target, feed_rate, false);
+    #endif
+    if (block_buffer_head == block_index) { return; }
+    block_buffer[block_index].raster_pixels = pixels;
+    st_raster_push(power, pixels);
+  }
+#endif
 
 
 // Reset the planner position vectors. Called by the system abort/initialization routine.
@@ -438,6 +761,17 @@ void plan_sync_position()
 }
 
 
+#ifdef PATH_BLENDING
+  // Returns the planner position vector in mm. Where the last block buffered ends.
+  // NOTE: The planner position is kept in the machine (not motor) frame, also with COREXY.
+  void plan_get_position(float *position)
+  {
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) { position[idx] = pl.position[idx]/settings.steps_per_mm[idx]; }
+  }
+#endif
+
+
 // Returns the number of active blocks are in the planner buffer.
 uint8_t plan_get_block_buffer_count()
 {
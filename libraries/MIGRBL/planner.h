@@ -48,7 +48,22 @@ typedef struct {
   float max_junction_speed_sqr;  // Junction entry speed limit based on direction vectors in (mm/min)^2
   float nominal_speed_sqr;       // Axis-limit adjusted nominal speed for this block in (mm/min)^2
   float acceleration;            // Axis-limit adjusted line acceleration in (mm/min^2)
+  #ifdef JERK_LIMITED_ACCELERATION
+    float jerk;                  // Axis-limit adjusted line jerk in (mm/min^3)
+  #endif
   float millimeters;             // The remaining distance for this block to be executed in (mm)
+  #ifdef ARC_BLOCKS
+    // Arc geometry. The steps and direction bits above are the net move from start to end.
+    uint8_t arc_axis;            // The helical (linear) axis plus one, or zero for a line. The arc is in
+                                 //   the plane of the next two axes, in order.
+    float arc_radius[2];         // Radius vector from the center to the start of the arc in (mm)
+    float arc_angle_per_mm;      // Signed angle turned, counter-clockwise, per mm of travel in (rad/mm)
+    float arc_linear_per_mm;     // Signed helical travel per mm of travel
+  #endif
+  #ifdef RASTER_ENGRAVING
+    uint8_t raster_start;        // Raster buffer index of its first pixel, or of the next pixels planned
+    uint8_t raster_pixels;       // Pixels along it, or zero for a plain move
+  #endif
   // uint8_t max_override;       // Maximum override value based on axis speed limits
 
   #ifdef USE_LINE_NUMBERS
@@ -69,6 +84,31 @@ void plan_reset();
   void plan_buffer_line(float *target, float feed_rate, uint8_t invert_feed_rate);
 #endif
 
+#ifdef ARC_BLOCKS
+  // Add a new arc to the buffer, as a single block. target[N_AXIS] is the signed, absolute end of the
+  // arc in millimeters and offset[N_AXIS] the vector from its start to the center. The arc turns by
+  // angular_travel radians, counter-clockwise positive, in the plane of the two axes after axis_linear,
+  // along which it travels helically. Feed rate as plan_buffer_line().
+  #ifdef USE_LINE_NUMBERS
+    void plan_buffer_arc(float *target, float *offset, float radius, float angular_travel, uint8_t axis_linear,
+      float feed_rate, uint8_t invert_feed_rate, int32_t line_number);
+  #else
+    void plan_buffer_arc(float *target, float *offset, float radius, float angular_travel, uint8_t axis_linear,
+      float feed_rate, uint8_t invert_feed_rate);
+  #endif
+#endif
+
+#ifdef RASTER_ENGRAVING
+  // Add a raster line to the buffer: a feed move as plan_buffer_line(), along which the power of
+  // each of the pixels, 0-255, sets the spindle PWM output in turn. Assumes the raster buffer has
+  // room for them, as st_raster_fits() tells.
+  #ifdef USE_LINE_NUMBERS
+    void plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels, int32_t line_number);
+  #else
+    void plan_buffer_raster(float *target, float feed_rate, uint8_t *power, uint8_t pixels);
+  #endif
+#endif
+
 // Called when the current block is no longer needed. Discards the block and makes the memory
 // availible for new blocks.
 void plan_discard_current_block();
@@ -82,9 +122,21 @@ uint8_t plan_next_block_index(uint8_t block_index);
 // Called by step segment buffer when computing executing block velocity profile.
 float plan_get_exec_block_exit_speed();
 
+#ifdef JERK_LIMITED_ACCELERATION
+  // Called by step segment buffer when computing the profile of the ramp group the executing block
+  // is in. Returns the distance the group runs on past the block and its exit speed, acceleration 
+  // and jerk.
+  float plan_get_exec_ramp_group(float *exit_speed, float *acceleration, float *jerk);
+#endif
+
 // Reset the planner position vector (in steps)
 void plan_sync_position();
 
+#ifdef PATH_BLENDING
+  // Returns the planner position vector in mm. Where the last block buffered ends.
+  void plan_get_position(float *position);
+#endif
+
 // Reinitialize plan with a partially completed block
 void plan_cycle_reinitialize();
 
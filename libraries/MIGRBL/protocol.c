@@ -30,6 +30,33 @@
 static char line[LINE_BUFFER_SIZE]; // Line to be executed. Zero-terminated.
 
 
+// Executes one line of formatted input, either g-code or a Grbl '$' system command, such as settings,
+// initiating the homing cycle, and toggling switch states. Returns its status. Also called for the
+// lines of the binary stream.
+uint8_t protocol_execute_command(char *line)
+{
+  if (line[0] == 0) {
+    // Empty or comment line. Send status message for syncing purposes.
+    return(STATUS_OK);
+
+  } else if (line[0] == '$') {
+    // Grbl '$' system command
+    #ifdef PATH_BLENDING
+      mc_blend_flush(); // Planned before the command runs, as it would have been in G61.
+      if (sys.abort) { return(STATUS_OK); }
+    #endif
+    return(system_execute_line(line));
+    
+  } else if (sys.state == STATE_ALARM) {
+    // Everything else is gcode. Block if in alarm mode.
+    return(STATUS_ALARM_LOCK);
+
+  } 
+  // Parse and execute g-code block!
+  return(gc_execute_line(line));
+}
+
+
 // Directs and executes one line of formatted input from protocol_process. While mostly
 // incoming streaming g-code blocks, this also directs and executes Grbl internal commands,
 // such as settings, initiating the homing cycle, and toggling switch states.
@@ -42,22 +69,7 @@ static void protocol_execute_line(char *line)
     report_echo_line_received(line);
   #endif
 
-  if (line[0] == 0) {
-    // Empty or comment line. Send status message for syncing purposes.
-    report_status_message(STATUS_OK);
-
-  } else if (line[0] == '$') {
-    // Grbl '$' system command
-    report_status_message(system_execute_line(line));
-    
-  } else if (sys.state == STATE_ALARM) {
-    // Everything else is gcode. Block if in alarm mode.
-    report_status_message(STATUS_ALARM_LOCK);
-
-  } else {
-    // Parse and execute g-code block!
-    report_status_message(gc_execute_line(line));
-  }
+  report_status_message(protocol_execute_command(line));
 }
 
 
@@ -106,7 +118,13 @@ void protocol_main_loop()
     // With a better processor, it would be very easy to pull this initial parsing out as a 
     // seperate task to be shared by the g-code parser and Grbl's system commands.
     
+    #ifdef BINARY_STREAMING
+    while(serial_read_byte(&c)) {
+      // Frames of the binary stream come between lines of text. See stream.c.
+      if ((char_counter == 0) && (comment == COMMENT_NONE) && stream_read(c)) { continue; }
+    #else
     while((c = serial_read()) != SERIAL_NO_DATA) {
+    #endif
       if ((c == '\n') || (c == '\r')) { // End of line reached
         line[char_counter] = 0; // Set string termination character.
         protocol_execute_line(line); // Line is complete. Execute it!
@@ -160,6 +178,11 @@ void protocol_main_loop()
     // If there are no more characters in the serial read buffer to be processed and executed,
     // this indicates that g-code streaming has either filled the planner buffer or has 
     // completed. In either case, auto-cycle start, if enabled, any queued moves.
+    #ifdef PATH_BLENDING
+      // Plan the line held for path blending once the steppers are on the last block, rather than
+      // let them stop while the next line is still on its way. 
+      if (plan_get_block_buffer_count() < 2) { mc_blend_flush(); }
+    #endif
     protocol_auto_cycle_start();
 
     protocol_execute_realtime();  // Runtime command check point.
@@ -377,6 +400,13 @@ void protocol_execute_realtime()
 // during a synchronize call, if it should happen. Also, waits for clean cycle end.
 void protocol_buffer_synchronize()
 {
+  #ifdef PATH_BLENDING
+    // The held line is part of the buffered motion. If the steppers ran out of segments while it
+    // was planned, settle their cycle stop first, so the cycle start below restarts them.
+    mc_blend_flush();
+    protocol_execute_realtime();
+    if (sys.abort) { return; }
+  #endif
   // If system is queued, ensure cycle resumes if the auto start flag is present.
   protocol_auto_cycle_start();
   do {
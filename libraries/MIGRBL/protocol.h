@@ -39,6 +39,9 @@ void protocol_main_loop();
 // Checks and executes a realtime command at various stop points in main program
 void protocol_execute_realtime();
 
+// Executes a line of g-code or a '$' command, as the main loop has cleaned it up. Returns its status.
+uint8_t protocol_execute_command(char *line);
+
 // Notify the stepper subsystem to start executing the g-code program in buffer.
 // void protocol_cycle_start();
 
@@ -163,8 +163,12 @@ void report_grbl_help() {
                         "$Nx=line (save startup block)\r\n"
                         "$C (check gcode mode)\r\n"
                         "$X (kill alarm lock)\r\n"
-                        "$H (run homing cycle)\r\n"
-                        "~ (cycle start)\r\n"
+                        "$H (run homing cycle)\r\n"));
+    #ifdef PERFORMANCE_COUNTERS
+      printPgmString(PSTR("$P (view performance counters)\r\n"
+                          "$PR (clear performance counters)\r\n"));
+    #endif
+    printPgmString(PSTR("~ (cycle start)\r\n"
                         "! (feed hold)\r\n"
                         "? (current status)\r\n"
                         "ctrl-x (reset Grbl)\r\n"));
@@ -228,6 +232,9 @@ void report_grbl_settings() {
   uint8_t idx, set_idx;
   uint8_t val = AXIS_SETTINGS_START_VAL;
   for (set_idx=0; set_idx<AXIS_N_SETTINGS; set_idx++) {
+    #if defined(INPUT_SHAPING) && !defined(JERK_LIMITED_ACCELERATION)
+      if (set_idx == 4) { val += AXIS_SETTINGS_INCREMENT; continue; } // No max jerk settings.
+    #endif
     for (idx=0; idx<N_AXIS; idx++) {
       printPgmString(PSTR("$"));
       print_uint8_base10(val+idx);
@@ -237,6 +244,14 @@ void report_grbl_settings() {
         case 1: printFloat_SettingValue(settings.max_rate[idx]); break;
         case 2: printFloat_SettingValue(settings.acceleration[idx]/(60*60)); break;
         case 3: printFloat_SettingValue(-settings.max_travel[idx]); break;
+        #ifdef JERK_LIMITED_ACCELERATION
+          case 4: printFloat_SettingValue(settings.jerk[idx]/(60*60*60)); break;
+        #endif
+        #ifdef INPUT_SHAPING
+          case 5: printFloat_SettingValue(settings.shaper_frequency[idx]); break;
+          case 6: printFloat_SettingValue(settings.shaper_damping[idx]); break;
+          case 7: print_uint8_base10(settings.shaper_type[idx]); break;
+        #endif
       }
       #ifdef REPORT_GUI_MODE
         printPgmString(PSTR("\r\n"));
@@ -252,6 +267,14 @@ void report_grbl_settings() {
           case 1: printPgmString(PSTR(" max rate, mm/min")); break;
           case 2: printPgmString(PSTR(" accel, mm/sec^2")); break;
           case 3: printPgmString(PSTR(" max travel, mm")); break;
+          #ifdef JERK_LIMITED_ACCELERATION
+            case 4: printPgmString(PSTR(" max jerk, mm/sec^3")); break;
+          #endif
+          #ifdef INPUT_SHAPING
+            case 5: printPgmString(PSTR(" shaper freq, Hz")); break;
+            case 6: printPgmString(PSTR(" shaper damping")); break;
+            case 7: printPgmString(PSTR(" shaper type, 0=ZV 1=ZVD 2=MZV")); break;
+          #endif
         }      
         printPgmString(PSTR(")\r\n"));
       #endif
@@ -351,6 +374,11 @@ void report_gcode_modes()
   
   if (gc_state.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { printPgmString(PSTR(" G93")); }
   else { printPgmString(PSTR(" G94")); }
+
+  #ifdef PATH_BLENDING
+    if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) { printPgmString(PSTR(" G64")); }
+    else { printPgmString(PSTR(" G61")); }
+  #endif
     
   switch (gc_state.modal.program_flow) {
     case PROGRAM_FLOW_RUNNING : printPgmString(PSTR(" M0")); break;
@@ -413,7 +441,41 @@ void report_echo_line_received(char *line)
 }
 
 
- // Prints real-time data. This function grabs a real-time snapshot of the stepper subprogram 
+ #ifdef PERFORMANCE_COUNTERS
+  // Prints the average and the most time taken, in microseconds.
+  static void report_perf_timer(const char *name, perf_timer_t *timer)
+  {
+    printPgmString(name);
+    printFloat(timer->count ? (float)timer->total/timer->count/TICKS_PER_MICROSECOND : 0.0, 1);
+    printPgmString(PSTR(","));
+    printFloat((float)timer->max/TICKS_PER_MICROSECOND, 1);
+    printPgmString(PSTR("]\r\n"));
+  }
+
+
+  // Performance counters print out. The ISR updates them, so they're copied first.
+  void report_performance()
+  {
+    perf_t counters;
+    uint8_t sreg = SREG;
+    cli();
+    memcpy(&counters, &perf, sizeof(perf));
+    SREG = sreg;
+    report_perf_timer(PSTR("[ISR:"), &counters.isr);
+    report_perf_timer(PSTR("[PREP:"), &counters.prep);
+    report_perf_timer(PSTR("[PLAN:"), &counters.planner);
+    printPgmString(PSTR("[WAIT:"));
+    printFloat(counters.blocked, 3);
+    printPgmString(PSTR("]\r\n[UNDERRUN:"));
+    print_uint32_base10(counters.underruns);
+    printPgmString(PSTR("]\r\n[RX:"));
+    print_uint8_base10(counters.rx_high);
+    printPgmString(PSTR("]\r\n"));
+  }
+#endif
+
+
+// Prints real-time data. This function grabs a real-time snapshot of the stepper subprogram 
  // and the actual location of the CNC machine. Users may change the following function to their
  // specific needs, but the desired real-time data report must be as short as possible. This is
  // requires as it minimizes the computational overhead and allows grbl to keep running smoothly, 
@@ -501,6 +563,21 @@ void report_realtime_status()
     print_unsigned_int8(limits_get_state(),2,N_AXIS);
   }
   
+  #ifdef PERFORMANCE_COUNTERS
+    // Report the most the stepper ISR and the segment generator took, in us, and the underruns
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t isr_max = perf.isr.max;
+    uint32_t underruns = perf.underruns;
+    SREG = sreg;
+    printPgmString(PSTR(",Perf:"));
+    print_uint32_base10(isr_max/TICKS_PER_MICROSECOND);
+    printPgmString(PSTR(","));
+    print_uint32_base10(perf.prep.max/TICKS_PER_MICROSECOND);
+    printPgmString(PSTR(","));
+    print_uint32_base10(underruns);
+  #endif
+
   #ifdef REPORT_CONTROL_PIN_STATE 
     printPgmString(PSTR(",Ctl:"));
     print_uint8_base2(CONTROL_PIN & CONTROL_MASK);
@@ -110,4 +110,9 @@ void report_startup_line(uint8_t n, char *line);
 // Prints build info and user info
 void report_build_info(char *line);
 
+#ifdef PERFORMANCE_COUNTERS
+// Prints the performance counters
+void report_performance();
+#endif
+
 #endif
@@ -34,6 +34,11 @@ volatile uint8_t serial_tx_buffer_tail = 0;
 #ifdef ENABLE_XONXOFF
   volatile uint8_t flow_ctrl = XON_SENT; // Flow control state variable
 #endif
+
+#ifdef BINARY_STREAMING
+  #define SERIAL_RX_FRAME_LENGTH 0xFF // Sync byte read. Longer than any frame.
+  static volatile uint8_t serial_rx_frame_bytes = 0; // Of a binary stream frame still to come
+#endif
   
 
 // Returns the number of bytes used in the RX serial buffer.
@@ -156,11 +161,64 @@ uint8_t serial_read()
 }
 
 
+#ifdef BINARY_STREAMING
+uint8_t serial_read_byte(uint8_t *data)
+{
+  if (serial_rx_buffer_head == serial_rx_buffer_tail) { return(false); }
+  *data = serial_read();
+  return(true);
+}
+#endif
+
+
+// Writes a received byte to the RX buffer, unless it is full.
+static void serial_rx_write(uint8_t data)
+{
+  uint8_t next_head = serial_rx_buffer_head + 1;
+  if (next_head == RX_BUFFER_SIZE) { next_head = 0; }
+
+  // Write data to buffer unless it is full.
+  if (next_head != serial_rx_buffer_tail) {
+    serial_rx_buffer[serial_rx_buffer_head] = data;
+    serial_rx_buffer_head = next_head;    
+
+    #ifdef PERFORMANCE_COUNTERS
+      uint8_t count = serial_get_rx_buffer_count();
+      if (count > perf.rx_high) { perf.rx_high = count; }
+    #endif
+    
+    #ifdef ENABLE_XONXOFF
+      if ((serial_get_rx_buffer_count() >= RX_BUFFER_FULL) && flow_ctrl == XON_SENT) {
+        flow_ctrl = SEND_XOFF;
+        UCSR0B |=  (1 << UDRIE0); // Force TX
+      } 
+    #endif
+    
+  }
+  //TODO: else alarm on overflow?
+}
+
+
 ISR(SERIAL_RX)
 {
   uint8_t data = UDR0;
-  uint8_t next_head;
   
+  #ifdef BINARY_STREAMING
+    // Any byte of a binary stream frame may look like a realtime command, so a frame goes into the
+    // buffer whole. Its sync byte never does, and the length after it says how much follows.
+    if (serial_rx_frame_bytes) {
+      if (serial_rx_frame_bytes == SERIAL_RX_FRAME_LENGTH) {
+        if ((data < STREAM_LENGTH_MIN) || (data > STREAM_LENGTH_MAX)) { serial_rx_frame_bytes = 0; } // Dropped by stream_read()
+        else { serial_rx_frame_bytes = data; }
+      } else {
+        serial_rx_frame_bytes--;
+      }
+      serial_rx_write(data);
+      return;
+    }
+    if (data == STREAM_SYNC) { serial_rx_frame_bytes = SERIAL_RX_FRAME_LENGTH; }
+  #endif
+
   // Pick off realtime command characters directly from the serial stream. These characters are
   // not passed into the buffer, but these set system state flag bits for realtime execution.
   switch (data) {
@@ -169,24 +227,7 @@ ISR(SERIAL_RX)
     case CMD_FEED_HOLD:     bit_true_atomic(sys_rt_exec_state, EXEC_FEED_HOLD); break; // Set as true
     case CMD_SAFETY_DOOR:   bit_true_atomic(sys_rt_exec_state, EXEC_SAFETY_DOOR); break; // Set as true
     case CMD_RESET:         mc_reset(); break; // Call motion control reset routine.
-    default: // Write character to buffer    
-      next_head = serial_rx_buffer_head + 1;
-      if (next_head == RX_BUFFER_SIZE) { next_head = 0; }
-    
-      // Write data to buffer unless it is full.
-      if (next_head != serial_rx_buffer_tail) {
-        serial_rx_buffer[serial_rx_buffer_head] = data;
-        serial_rx_buffer_head = next_head;    
-        
-        #ifdef ENABLE_XONXOFF
-          if ((serial_get_rx_buffer_count() >= RX_BUFFER_FULL) && flow_ctrl == XON_SENT) {
-            flow_ctrl = SEND_XOFF;
-            UCSR0B |=  (1 << UDRIE0); // Force TX
-          } 
-        #endif
-        
-      }
-      //TODO: else alarm on overflow?
+    default: serial_rx_write(data); // Write character to buffer    
   }
 }
 
@@ -195,6 +236,10 @@ void serial_reset_read_buffer()
 {
   serial_rx_buffer_tail = serial_rx_buffer_head;
 
+  #ifdef BINARY_STREAMING
+    serial_rx_frame_bytes = 0; // A frame cut short by the reset would swallow the commands after it
+  #endif
+
   #ifdef ENABLE_XONXOFF
     flow_ctrl = XON_SENT;
   #endif
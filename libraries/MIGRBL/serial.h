@@ -51,6 +51,12 @@ void serial_write(uint8_t data);
 // Fetches the first byte in the serial read buffer. Called by main program.
 uint8_t serial_read();
 
+#ifdef BINARY_STREAMING
+  // Fetches the first byte in the serial read buffer into data. Returns false if there is none, as
+  // a byte of a binary stream frame may equal SERIAL_NO_DATA.
+  uint8_t serial_read_byte(uint8_t *data);
+#endif
+
 // Reset and empty data in read buffer. Used by e-stop and reset.
 void serial_reset_read_buffer();
 
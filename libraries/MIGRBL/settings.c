@@ -91,6 +91,23 @@ void settings_restore(uint8_t restore_flag) {
 	settings.max_travel[X_AXIS] = (-DEFAULT_X_MAX_TRAVEL);
 	settings.max_travel[Y_AXIS] = (-DEFAULT_Y_MAX_TRAVEL);
 	settings.max_travel[Z_AXIS] = (-DEFAULT_Z_MAX_TRAVEL);    
+	#ifdef JERK_LIMITED_ACCELERATION
+	settings.jerk[X_AXIS] = DEFAULT_X_JERK;
+	settings.jerk[Y_AXIS] = DEFAULT_Y_JERK;
+	settings.jerk[Z_AXIS] = DEFAULT_Z_JERK;
+	#endif
+	#ifdef INPUT_SHAPING
+	settings.shaper_frequency[X_AXIS] = DEFAULT_X_SHAPER_FREQUENCY;
+	settings.shaper_frequency[Y_AXIS] = DEFAULT_Y_SHAPER_FREQUENCY;
+	settings.shaper_frequency[Z_AXIS] = DEFAULT_Z_SHAPER_FREQUENCY;
+	settings.shaper_damping[X_AXIS] = DEFAULT_X_SHAPER_DAMPING;
+	settings.shaper_damping[Y_AXIS] = DEFAULT_Y_SHAPER_DAMPING;
+	settings.shaper_damping[Z_AXIS] = DEFAULT_Z_SHAPER_DAMPING;
+	settings.shaper_type[X_AXIS] = DEFAULT_X_SHAPER_TYPE;
+	settings.shaper_type[Y_AXIS] = DEFAULT_Y_SHAPER_TYPE;
+	settings.shaper_type[Z_AXIS] = DEFAULT_Z_SHAPER_TYPE;
+	st_shaper_init();
+	#endif
 
 	write_global_settings();
   }
@@ -172,6 +189,34 @@ uint8_t read_global_settings() {
 }
 
 
+#ifdef INPUT_SHAPING
+// Sets an input shaper setting of an axis, if the shaper of all axes then still fits.
+static uint8_t settings_store_shaper_setting(uint8_t set_idx, uint8_t axis, float value) {
+  float frequency = settings.shaper_frequency[axis];
+  float damping = settings.shaper_damping[axis];
+  uint8_t type = settings.shaper_type[axis];
+  switch (set_idx) {
+    case 5: settings.shaper_frequency[axis] = value; break;
+    case 6: 
+      if (value >= 1.0) { return(STATUS_INVALID_STATEMENT); } // Underdamped only.
+      settings.shaper_damping[axis] = value; 
+      break;
+    default:
+      if (value > SHAPER_MZV) { return(STATUS_INVALID_STATEMENT); }
+      settings.shaper_type[axis] = trunc(value);
+  }
+  if (!st_shaper_init()) { // Too many impulses. Restore the old value.
+    settings.shaper_frequency[axis] = frequency;
+    settings.shaper_damping[axis] = damping;
+    settings.shaper_type[axis] = type;
+    st_shaper_init();
+    return(STATUS_INVALID_STATEMENT);
+  }
+  return(STATUS_OK);
+}
+#endif
+
+
 // A helper method to set settings from command line
 uint8_t settings_store_global_setting(uint8_t parameter, float value) {
   if (value < 0.0) { return(STATUS_NEGATIVE_VALUE); } 
@@ -198,6 +243,19 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
             break;
           case 2: settings.acceleration[parameter] = value*60*60; break; // Convert to mm/min^2 for grbl internal use.
           case 3: settings.max_travel[parameter] = -value; break;  // Store as negative for grbl internal use.
+          #ifdef JERK_LIMITED_ACCELERATION
+            case 4: settings.jerk[parameter] = value*60*60*60; break; // Convert to mm/min^3 for grbl internal use.
+          #endif
+          #ifdef INPUT_SHAPING
+            #ifndef JERK_LIMITED_ACCELERATION
+              case 4: return(STATUS_INVALID_STATEMENT); // No max jerk settings.
+            #endif
+            case 5: case 6: case 7: {
+              uint8_t status = settings_store_shaper_setting(set_idx, parameter, value);
+              if (status != STATUS_OK) { return(status); }
+              break;
+            }
+          #endif
         }
         break; // Exit while-loop after setting has been configured and proceed to the EEPROM write call.
       } else {
@@ -27,7 +27,15 @@
 
 // Version of the EEPROM data. Will be used to migrate existing data from older versions of Grbl
 // when firmware is upgraded. Always stored in byte 0 of eeprom
-#define SETTINGS_VERSION 9  // NOTE: Check settings_reset() when moving to next version.
+#if defined(JERK_LIMITED_ACCELERATION) && defined(INPUT_SHAPING)
+  #define SETTINGS_VERSION 12  // Version 9 with the axis max jerk and input shaper settings.
+#elif defined(INPUT_SHAPING)
+  #define SETTINGS_VERSION 11  // Version 9 with the axis input shaper settings.
+#elif defined(JERK_LIMITED_ACCELERATION)
+  #define SETTINGS_VERSION 10  // Version 9 with the axis max jerk settings.
+#else
+  #define SETTINGS_VERSION 9  // NOTE: Check settings_reset() when moving to next version.
+#endif
 
 // Define bit flag masks for the boolean settings in settings.flag.
 #define BITFLAG_REPORT_INCHES      bit(0)
@@ -71,7 +79,13 @@
 // #define SETTING_INDEX_G92    N_COORDINATE_SYSTEM+2  // Coordinate offset (G92.2,G92.3 not supported)
 
 // Define Grbl axis settings numbering scheme. Starts at START_VAL, every INCREMENT, over N_SETTINGS.
-#define AXIS_N_SETTINGS          4
+#if defined(INPUT_SHAPING)
+  #define AXIS_N_SETTINGS        8 // Max jerk, if any, then shaper frequency, damping and type.
+#elif defined(JERK_LIMITED_ACCELERATION)
+  #define AXIS_N_SETTINGS        5
+#else
+  #define AXIS_N_SETTINGS        4
+#endif
 #define AXIS_SETTINGS_START_VAL  100 // NOTE: Reserving settings values >= 100 for axis settings. Up to 255.
 #define AXIS_SETTINGS_INCREMENT  10  // Must be greater than the number of axis settings
 
@@ -82,6 +96,14 @@ typedef struct {
   float max_rate[N_AXIS];
   float acceleration[N_AXIS];
   float max_travel[N_AXIS];
+  #ifdef JERK_LIMITED_ACCELERATION
+    float jerk[N_AXIS];
+  #endif
+  #ifdef INPUT_SHAPING
+    float shaper_frequency[N_AXIS]; // (Hz) None if zero
+    float shaper_damping[N_AXIS];
+    uint8_t shaper_type[N_AXIS];
+  #endif
 
   // Remaining Grbl settings
   uint8_t pulse_microseconds;
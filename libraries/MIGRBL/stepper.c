@@ -28,6 +28,7 @@
 #define RAMP_ACCEL 0
 #define RAMP_CRUISE 1
 #define RAMP_DECEL 2
+#define JERK_SEARCH_ITERATIONS 8 // Most false position steps for S-curve peak speeds and block end times
 
 // Define Adaptive Multi-Axis Step-Smoothing(AMASS) levels and cutoff frequencies. The highest level
 // frequency bin starts at 0Hz and ends at its cutoff frequency. The next lower level frequency bin
@@ -51,12 +52,27 @@
 // NOTE: This data is copied from the prepped planner blocks so that the planner blocks may be
 // discarded when entirely consumed and completed by the segment buffer. Also, AMASS alters this
 // data for its own use. 
+// NOTE: With INPUT_SHAPING, the shaped motion trails the planned one by up to INPUT_SHAPER_BLOCKS
+// blocks, which have to be kept as well.
 typedef struct {  
   uint8_t direction_bits;
   uint32_t steps[N_AXIS];
   uint32_t step_event_count;
+  #ifdef INPUT_SHAPING
+    float millimeters;   // Length of the planner block (mm)
+  #endif
+  #ifdef RASTER_ENGRAVING
+    uint8_t raster_start;     // Raster buffer index of its first pixel. Those before are burned once it starts.
+    uint32_t raster_steps;    // Pixels, as the axis steps, for their Bresenham counter. Zero for none.
+    float raster_step_rate;   // Step events per minute at the nominal speed (1/min)
+  #endif
 } st_block_t;
-static st_block_t st_block_buffer[SEGMENT_BUFFER_SIZE-1];
+#ifdef INPUT_SHAPING
+  #define ST_BLOCK_BUFFER_SIZE (SEGMENT_BUFFER_SIZE-1+INPUT_SHAPER_BLOCKS)
+#else
+  #define ST_BLOCK_BUFFER_SIZE (SEGMENT_BUFFER_SIZE-1)
+#endif
+static st_block_t st_block_buffer[ST_BLOCK_BUFFER_SIZE];
 
 // Primary stepper segment ring buffer. Contains small, short line segments for the stepper 
 // algorithm to execute, which are "checked-out" incrementally from the first block in the
@@ -71,6 +87,9 @@ typedef struct {
   #else
     uint8_t prescaler;      // Without AMASS, a prescaler is required to adjust for slow timing.
   #endif
+  #ifdef RASTER_ENGRAVING
+    uint16_t raster_gain;   // Pixel power scale for the segment speed. 256 at the nominal speed.
+  #endif
 } segment_t;
 static segment_t segment_buffer[SEGMENT_BUFFER_SIZE];
 
@@ -91,6 +110,15 @@ typedef struct {
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     uint32_t steps[N_AXIS];
   #endif
+  #ifdef RASTER_ENGRAVING
+    uint32_t counter_raster;  // Bresenham counter of the pixels
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      uint32_t raster_steps;
+    #endif
+    uint8_t raster_on;        // The PWM output is set by the pixels
+    uint16_t spindle_pwm;     // PWM output and mode the spindle had before, to go back to
+    uint8_t spindle_tccra;
+  #endif
 
   uint16_t step_count;       // Steps remaining in line segment motion  
   uint8_t exec_block_index; // Tracks the current st_block index. Change indicates new block.
@@ -104,6 +132,20 @@ static volatile uint8_t segment_buffer_tail;
 static uint8_t segment_buffer_head;
 static uint8_t segment_next_head;
 
+#ifdef RASTER_ENGRAVING
+  #if (RASTER_BUFFER_SIZE <= STREAM_PAYLOAD_MAX) || (RASTER_BUFFER_SIZE > 255)
+    #error "RASTER_BUFFER_SIZE must hold the pixels of a frame, and be 255 at most"
+  #endif
+  #if (RASTER_PWM_MAX <= RASTER_PWM_OFF) || (RASTER_PWM_MAX-RASTER_PWM_OFF > 255)
+    #error "RASTER_PWM_MAX must be above RASTER_PWM_OFF, by 255 at most"
+  #endif
+  // Raster ring buffer of the pixels of the planned raster blocks, as their PWM output above
+  // RASTER_PWM_OFF at full power. The tail is the pixel being burned.
+  static uint8_t raster_buffer[RASTER_BUFFER_SIZE];
+  static uint8_t raster_head;
+  static volatile uint8_t raster_tail;
+#endif
+
 // Step and direction port invert masks. 
 static uint8_t step_port_invert_mask;
 static uint8_t dir_port_invert_mask;
@@ -111,11 +153,45 @@ static uint8_t dir_port_invert_mask;
 // Used to avoid ISR nesting of the "Stepper Driver Interrupt". Should never occur though.
 static volatile uint8_t busy;   
 
+#ifdef PERFORMANCE_COUNTERS
+  // CPU cycles of the Timer1 periods ended so far. Only runs while the steppers do.
+  static volatile uint32_t st_clock;
+
+  // CPU cycles per Timer1 count, as a shift, from its prescaler.
+  static uint8_t st_timer1_shift()
+  {
+    switch (TCCR1B & ((1<<CS12)|(1<<CS11)|(1<<CS10))) {
+      case (1<<CS11): return(3); // 1/8
+      case ((1<<CS11)|(1<<CS10)): return(6); // 1/64
+      default: return(0);
+    }
+  }
+#endif
+
 // Pointers for the step segment being prepped from the planner buffer. Accessed only by the
 // main program. Pointers may be planning segments or planner blocks ahead of what being executed.
 static plan_block_t *pl_block;     // Pointer to the planner block being prepped
 static st_block_t *st_prep_block;  // Pointer to the stepper block data being prepped 
 
+#ifdef JERK_LIMITED_ACCELERATION
+// An S-curve ramp between two speeds. The acceleration moves from its start value to its peak at the
+// jerk limit by the accel time, holds until the peak time, then falls to zero by the end time. Times
+// are from the start of the ramp, and distances are traveled from it.
+typedef struct {
+  float start_speed;   // (mm/min)
+  float end_speed;     // (mm/min)
+  float start_accel;   // In the direction of the ramp (mm/min^2)
+  float accel;         // Peak acceleration (mm/min^2)
+  float jerk;          // (mm/min^3)
+  float accel_time;    // (min)
+  float peak_time;     // (min)
+  float end_time;      // (min)
+  float accel_mm;      // (mm)
+  float peak_mm;       // (mm)
+  float length;        // (mm)
+} st_ramp_t;
+#endif
+
 // Segment preparation data struct. Contains all the necessary information to compute new segments
 // based on the current executing planner block.
 typedef struct {
@@ -135,9 +211,64 @@ typedef struct {
   float exit_speed;       // Exit speed of executing block (mm/min)
   float accelerate_until; // Acceleration ramp end measured from end of block (mm)
   float decelerate_after; // Deceleration ramp start measured from end of block (mm)
+
+  #ifdef JERK_LIMITED_ACCELERATION
+    uint8_t recalculate_profile; // Flag to recompute the profile when the next block is loaded
+    float accel_limit;   // Of the ramp group being executed (mm/min^2)
+    float jerk_limit;    // Of the ramp group being executed (mm/min^3)
+    float group_mm;      // Ramp group distance past the end of block (mm)
+    st_ramp_t ramp;      // Ramp being executed
+    float ramp_end_mm;   // Ramp end measured from end of block, negative past it (mm)
+    float ramp_time;     // Time into the ramp at the end of the segment buffer (min)
+    float ramp_mm;       // Distance into the ramp at the end of the segment buffer (mm)
+  #endif
+
+  #ifdef ARC_BLOCKS
+    uint8_t arc_axis;          // Of the planner block being prepped. Zero for a line.
+    uint8_t arc_count;         // Small angle rotations since the last exact one
+    float arc_mm;              // Length of the arc (mm)
+    float arc_angle;           // Angle turned at the end of the segment buffer (rad)
+    float arc_radius[2];       // Radius vector there (mm)
+    int32_t arc_steps[N_AXIS]; // Steps taken from the start of the arc there
+  #endif
+
+  #ifdef INPUT_SHAPING
+    // The segments computed above are samples of the planned velocity profile, and no longer go to
+    // the stepper ISR. The shaped motion is made from them, trailing behind in the stepper blocks.
+    float profile_mm;        // Planned distance remaining in block st_block_index (mm)
+    uint8_t history_head;    // Newest sample of the planned profile
+    uint8_t history_count;
+    float history_dt[INPUT_SHAPER_HISTORY]; // Time of each sample (min)
+    float history_mm[INPUT_SHAPER_HISTORY]; // Distance planned in it (mm)
+    float shaper_lead;       // Time of the newest samples not yet shaped (min)
+    float shaper_idle;       // Time the planned profile has stood still (min)
+    uint8_t shaper_flush;    // Flag the shaped motion to go on to the planned one
+    float shaper_dt;         // Shaped time not yet in segments (min)
+    float shaper_mm;         // Shaped distance not yet in segments (mm)
+    uint8_t shaped_index;    // Stepper block the shaped motion is in
+    float shaped_mm_remaining;    // Distance remaining in it (mm)
+    float shaped_steps_remaining;
+    float shaped_step_per_mm;
+    float shaped_dt_remainder;
+  #endif
 } st_prep_t;
 static st_prep_t prep;
 
+#ifdef INPUT_SHAPING
+// The input shaper of all axes: impulses of the given amplitudes at the given delays. The shaped
+// motion is the sum of the planned one, scaled by each amplitude and delayed by each delay.
+typedef struct {
+  uint8_t count;
+  float amplitude[INPUT_SHAPER_IMPULSES]; // Sum to one
+  float delay[INPUT_SHAPER_IMPULSES];     // (min)
+  float duration;                         // Longest delay (min)
+  float window;                           // Least time for INPUT_SHAPER_BLOCKS-3 blocks in a row (min)
+  float lag;                              // Mean delay, plus a segment (min)
+  float lag_sqr;                          // Half the mean square of the same (min^2)
+} st_shaper_t;
+static st_shaper_t shaper;
+#endif
+
 
 /*    BLOCK VELOCITY PROFILE DEFINITION 
           __________________________
@@ -208,6 +339,24 @@ void st_wake_up()
 }
 
 
+#ifdef RASTER_ENGRAVING
+  // Hands the PWM output over to the pixels, turning it on even if the spindle speed is zero, or
+  // back to the spindle as it was.
+  static void st_raster_output(uint8_t on)
+  {
+    if (on) {
+      st.spindle_pwm = OCR_REGISTER;
+      st.spindle_tccra = TCCRA_REGISTER;
+      TCCRA_REGISTER |= (1<<COMB_BIT);
+    } else {
+      OCR_REGISTER = st.spindle_pwm;
+      TCCRA_REGISTER = st.spindle_tccra;
+    }
+    st.raster_on = on;
+  }
+#endif
+
+
 // Stepper shutdown
 void st_go_idle() 
 {
@@ -215,6 +364,10 @@ void st_go_idle()
   TIMSK1 &= ~(1<<OCIE1A); // Disable Timer1 interrupt
   TCCR1B = (TCCR1B & ~((1<<CS12) | (1<<CS11))) | (1<<CS10); // Reset clock to no prescaling.
   busy = false;
+  #ifdef RASTER_ENGRAVING
+    // Stopped on a pixel, such as in a feed hold. It's burned on once moving again.
+    if (st.raster_on) { st_raster_output(false); }
+  #endif
   
   // Set stepper driver idle state, disabled or enabled, depending on settings and circumstances.
   bool pin_state = false; // Keep enabled.
@@ -281,7 +434,14 @@ void st_go_idle()
 ISR(TIMER1_COMPA_vect)
 {        
 // SPINDLE_ENABLE_PORT ^= 1<<SPINDLE_ENABLE_BIT; // Debug: Used to time ISR
+  #ifdef PERFORMANCE_COUNTERS
+    // OCR1A and the prescaler still hold the period that just ended. A new segment sets them after.
+    st_clock += (uint32_t)(OCR1A+1) << st_timer1_shift();
+  #endif
   if (busy) { return; } // The busy-flag is used to avoid reentering this interrupt
+  #ifdef PERFORMANCE_COUNTERS
+    uint32_t isr_start = st_clock;
+  #endif
   
   // Set the direction pins a couple of nanoseconds before we step the steppers
   DIRECTION_PORT = (DIRECTION_PORT & ~DIRECTION_MASK) | (st.dir_outbits & DIRECTION_MASK);
@@ -311,7 +471,15 @@ ISR(TIMER1_COMPA_vect)
 
       #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
         // With AMASS is disabled, set timer prescaler for segments with slow step frequencies (< 250Hz).
+        #ifdef PERFORMANCE_COUNTERS
+          uint8_t isr_shift = st_timer1_shift();
+        #endif
         TCCR1B = (TCCR1B & ~(0x07<<CS10)) | (st.exec_segment->prescaler<<CS10);
+        #ifdef PERFORMANCE_COUNTERS
+          // Timer1 counted this far at the old prescaler. The end of the ISR reads it at the new one.
+          uint32_t isr_count = TCNT1;
+          isr_start += (isr_count << st_timer1_shift()) - (isr_count << isr_shift);
+        #endif
       #endif
 
       // Initialize step segment timing per step and load number of steps to execute.
@@ -325,6 +493,10 @@ ISR(TIMER1_COMPA_vect)
         
         // Initialize Bresenham line and distance counters
         st.counter_x = st.counter_y = st.counter_z = (st.exec_block->step_event_count >> 1);
+        #ifdef RASTER_ENGRAVING
+          st.counter_raster = 0; // The first pixel starts with the block.
+          raster_tail = st.exec_block->raster_start;
+        #endif
       }
       st.dir_outbits = st.exec_block->direction_bits ^ dir_port_invert_mask; 
 
@@ -334,9 +506,26 @@ ISR(TIMER1_COMPA_vect)
         st.steps[Y_AXIS] = st.exec_block->steps[Y_AXIS] >> st.exec_segment->amass_level;
         st.steps[Z_AXIS] = st.exec_block->steps[Z_AXIS] >> st.exec_segment->amass_level;
       #endif
+
+      #ifdef RASTER_ENGRAVING
+        // Each segment scales the power by its own speed.
+        if (st.exec_block->raster_steps) {
+          #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+            st.raster_steps = st.exec_block->raster_steps >> st.exec_segment->amass_level;
+          #endif
+          if (!st.raster_on) { st_raster_output(true); }
+          OCR_REGISTER = RASTER_PWM_OFF + ((raster_buffer[raster_tail]*st.exec_segment->raster_gain+128) >> 8);
+        } else if (st.raster_on) {
+          st_raster_output(false);
+        }
+      #endif
       
     } else {
       // Segment buffer empty. Shutdown.
+      #ifdef PERFORMANCE_COUNTERS
+        // Starved, unless the motion is done or held.
+        if ((sys.state == STATE_CYCLE) && plan_get_block_buffer_count()) { perf.underruns++; }
+      #endif
       st_go_idle();
       bit_true_atomic(sys_rt_exec_state,EXEC_CYCLE_STOP); // Flag main program for cycle end
       return; // Nothing to do but exit.
@@ -385,6 +574,24 @@ ISR(TIMER1_COMPA_vect)
     else { sys.position[Z_AXIS]++; }
   }  
 
+  #ifdef RASTER_ENGRAVING
+    // The pixels are traced as one more axis, which sets the PWM output instead of stepping.
+    if (st.raster_on) {
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st.counter_raster += st.raster_steps;
+      #else
+        st.counter_raster += st.exec_block->raster_steps;
+      #endif
+      if (st.counter_raster > st.exec_block->step_event_count) {
+        st.counter_raster -= st.exec_block->step_event_count;
+        uint8_t pixel = raster_tail+1;
+        if (pixel == RASTER_BUFFER_SIZE) { pixel = 0; }
+        raster_tail = pixel;
+        OCR_REGISTER = RASTER_PWM_OFF + ((raster_buffer[pixel]*st.exec_segment->raster_gain+128) >> 8);
+      }
+    }
+  #endif
+
   // During a homing cycle, lock out and prevent desired axes from moving.
   if (sys.state == STATE_HOMING) { st.step_outbits &= sys.homing_axis_lock; }   
 
@@ -396,6 +603,10 @@ ISR(TIMER1_COMPA_vect)
   }
 
   st.step_outbits ^= step_port_invert_mask;  // Apply step port invert mask    
+  #ifdef PERFORMANCE_COUNTERS
+    // Timer1 counts from this compare, and the clock has any compare since, as it let them in.
+    perf_add(&perf.isr, st_clock-isr_start + ((uint32_t)TCNT1 << st_timer1_shift()));
+  #endif
   busy = false;
 // SPINDLE_ENABLE_PORT ^= 1<<SPINDLE_ENABLE_BIT; // Debug: Used to time ISR
 }
@@ -459,8 +670,15 @@ void st_reset()
   segment_buffer_head = 0; // empty = tail
   segment_next_head = 1;
   busy = false;
+  #ifdef RASTER_ENGRAVING
+    raster_head = 0;
+    raster_tail = 0;
+  #endif
   
   st_generate_step_dir_invert_masks();
+  #ifdef INPUT_SHAPING
+    st_shaper_init(); // Settings may have been restored.
+  #endif
       
   // Initialize step and direction port pins.
   STEP_PORT = (STEP_PORT & ~STEP_MASK) | step_port_invert_mask;
@@ -498,6 +716,9 @@ void stepper_init()
 // Called by planner_recalculate() when the executing block is updated by the new plan.
 void st_update_plan_block_parameters()
 { 
+  #ifdef JERK_LIMITED_ACCELERATION
+    prep.recalculate_profile = true; // The ramp group may have changed, even between blocks.
+  #endif
   if (pl_block != NULL) { // Ignore if at start of a new block.
     prep.flag_partial_block = true;
     pl_block->entry_speed_sqr = prep.current_speed*prep.current_speed; // Update entry speed.
@@ -506,6 +727,630 @@ void st_update_plan_block_parameters()
 }
 
 
+#ifdef JERK_LIMITED_ACCELERATION
+  // Plans the S-curve ramp from start_speed to end_speed within the limits of the ramp group, with
+  // the acceleration starting at start_accel (negative when slowing down). Returns its length.
+  static float st_ramp_plan(st_ramp_t *ramp, float start_speed, float start_accel, float end_speed)
+  {
+    float sign = (end_speed < start_speed) ? -1.0 : 1.0;
+    float delta_speed = sign*(end_speed-start_speed);
+    float jerk = prep.jerk_limit;
+    float accel = prep.accel_limit;
+    float peak_time = 0.0; // Time at peak acceleration
+    // The ramp group may have a lower acceleration limit than the one carried into it.
+    start_accel = sign*start_accel;
+    if (start_accel > accel) { start_accel = accel; }
+    else if (start_accel < -accel) { start_accel = -accel; }
+    float full_speed = 0.5*(2*accel*accel-start_accel*start_accel)/jerk; // Least delta speed at full accel
+    if (delta_speed == 0.0 && start_accel >= 0.0) {
+      accel = 0.0;
+      start_accel = 0.0;
+    } else if (delta_speed >= full_speed) {
+      peak_time = (delta_speed-full_speed)/accel;
+    } else {
+      accel = sqrt(jerk*delta_speed + 0.5*start_accel*start_accel);
+      if (accel < start_accel) {
+        // Too close to the end speed to ease off at the jerk limit. Ease off just fast enough.
+        accel = start_accel;
+        jerk = 0.5*start_accel*start_accel/delta_speed;
+      }
+    }
+    ramp->start_speed = start_speed;
+    ramp->end_speed = end_speed;
+    ramp->start_accel = start_accel;
+    ramp->accel = accel;
+    ramp->jerk = jerk;
+    ramp->accel_time = (accel-start_accel)/jerk;
+    ramp->peak_time = ramp->accel_time + peak_time;
+    float end_time = accel/jerk;
+    ramp->end_time = ramp->peak_time + end_time;
+
+    float time = ramp->accel_time;
+    ramp->accel_mm = time*(start_speed + sign*time*(0.5*start_accel + jerk*time/6.0));
+    float speed = start_speed + sign*time*(start_accel + 0.5*jerk*time);
+    ramp->peak_mm = ramp->accel_mm + peak_time*(speed + 0.5*sign*accel*peak_time);
+    ramp->length = ramp->peak_mm + end_time*(end_speed - sign*jerk*end_time*end_time/6.0);
+    return(ramp->length);
+  }
+
+
+  // Starts the ramp from the current speed to end_speed at mm_remaining from the end of the block.
+  static void st_ramp_start(float end_speed, float start_accel, float mm_remaining)
+  {
+    prep.ramp_end_mm = mm_remaining - st_ramp_plan(&prep.ramp, prep.current_speed, start_accel, end_speed);
+    prep.ramp_time = 0.0;
+    prep.ramp_mm = 0.0;
+  }
+
+
+  // Returns the distance traveled time into the ramp, and the speed then.
+  static float st_ramp_position(float time, float *speed)
+  {
+    st_ramp_t *ramp = &prep.ramp;
+    float sign = (ramp->end_speed < ramp->start_speed) ? -1.0 : 1.0;
+    if (time < ramp->accel_time) {
+      *speed = ramp->start_speed + sign*time*(ramp->start_accel + 0.5*ramp->jerk*time);
+      return( time*(ramp->start_speed + sign*time*(0.5*ramp->start_accel + ramp->jerk*time/6.0)) );
+    }
+    if (time < ramp->peak_time) {
+      float accel_time = ramp->accel_time;
+      float accel_speed = ramp->start_speed + sign*accel_time*(ramp->start_accel + 0.5*ramp->jerk*accel_time);
+      time -= accel_time;
+      *speed = accel_speed + sign*ramp->accel*time;
+      return( ramp->accel_mm + time*(accel_speed + 0.5*sign*ramp->accel*time) );
+    }
+    time = ramp->end_time-time; // Time left
+    *speed = ramp->end_speed - 0.5*sign*ramp->jerk*time*time;
+    return( ramp->length - time*(ramp->end_speed - sign*ramp->jerk*time*time/6.0) );
+  }
+
+
+  // Returns the acceleration at the end of the segment buffer. Negative when slowing down.
+  static float st_ramp_acceleration()
+  {
+    st_ramp_t *ramp = &prep.ramp;
+    if (prep.ramp_type == RAMP_CRUISE || prep.ramp_time >= ramp->end_time) { return(0.0); }
+    float accel;
+    if (prep.ramp_time < ramp->accel_time) { accel = ramp->start_accel + ramp->jerk*prep.ramp_time; }
+    else if (prep.ramp_time < ramp->peak_time) { accel = ramp->accel; }
+    else { accel = ramp->jerk*(ramp->end_time-prep.ramp_time); }
+    if (ramp->end_speed < ramp->start_speed) { return(-accel); }
+    return(accel);
+  }
+
+
+  // False position search (Illinois) for where a rising function of x crosses zero, from a
+  // bracket with low_mm at most and high_mm over it. Far fewer steps than bisection here.
+  typedef struct {
+    float low;       // Short of the crossing
+    float high;      // Past it
+    float low_mm;    // Function at low, scaled down by the Illinois rule
+    float high_mm;   // Function at high, scaled down by the Illinois rule
+    float low_gap;   // How far below zero the function is at low, unscaled
+    float high_gap;  // How far above zero it is at high, unscaled
+    int8_t side;     // Which end moved last: -1 low, 1 high
+  } st_search_t;
+
+
+  // Returns the next x to try.
+  static float st_search_next(st_search_t *search)
+  {
+    return( search->low + (search->high-search->low)*search->low_mm/(search->low_mm-search->high_mm) );
+  }
+
+
+  // Moves an end of the bracket to x, where the function is mm.
+  static void st_search_update(st_search_t *search, float x, float mm)
+  {
+    if (mm > 0.0) {
+      search->high = x;
+      search->high_mm = mm;
+      search->high_gap = mm;
+      if (search->side > 0) { search->low_mm *= 0.5; } // Same end twice. Pull the next try across.
+      search->side = 1;
+    } else {
+      search->low = x;
+      search->low_mm = mm;
+      search->low_gap = -mm;
+      if (search->side < 0) { search->high_mm *= 0.5; }
+      search->side = -1;
+    }
+  }
+
+
+  // Returns the distance needed to ramp from the current speed and acceleration to cruise_speed,
+  // then down to the exit speed of the ramp group.
+  static float st_profile_length(float start_accel, float cruise_speed)
+  {
+    st_ramp_t ramp;
+    return( st_ramp_plan(&ramp, prep.current_speed, start_accel, cruise_speed) + 
+            st_ramp_plan(&ramp, cruise_speed, 0.0, prep.exit_speed) );
+  }
+
+
+  // Computes the jerk-limited velocity profile from the current speed and acceleration to the end
+  // of the ramp group: an S-curve ramp to the cruise speed, a cruise, then an S-curve ramp to the 
+  // exit speed of the group, ending without acceleration. The cruise speed is the nominal speed if
+  // there is room for it, or else found by bisection, and may be below the current speed. If the
+  // exit speed is out of reach, the ramp to it runs on past the end of the group.
+  static void st_prep_jerk_profile(float mm_remaining)
+  {
+    float start_accel = st_ramp_acceleration();
+    prep.group_mm = plan_get_exec_ramp_group(&prep.exit_speed, &prep.accel_limit, &prep.jerk_limit);
+    prep.recalculate_profile = false;
+    float group_mm = mm_remaining+prep.group_mm;
+
+    // The speed carries on changing while the acceleration eases off at the jerk limit, so the
+    // cruise speed is either at or above both, or at or below both. The profile length isn't
+    // monotonic across the two, so the higher is searched first.
+    // The search stops once the profile ends within a step of the end of the group. Each profile
+    // length is two ramp plans, about 1 ms of soft float on the 328p, so it takes as few as it can.
+    float eased_speed = prep.current_speed + 0.5*start_accel*fabs(start_accel)/prep.jerk_limit;
+    float low_speed = max(prep.current_speed, eased_speed);
+    float high_speed = max(sqrt(pl_block->nominal_speed_sqr), low_speed);
+    float high_mm = st_profile_length(start_accel, high_speed) - group_mm; // Past the group end
+    if (high_mm > 0.0) { // No cruise at nominal speed
+      float low_mm = st_profile_length(start_accel, low_speed) - group_mm;
+      if (low_mm > 0.0) { // Must slow down
+        high_speed = min(prep.current_speed, eased_speed);
+        high_mm = st_profile_length(start_accel, high_speed) - group_mm;
+        low_speed = prep.exit_speed;
+        low_mm = st_profile_length(start_accel, low_speed) - group_mm;
+        if (high_speed < low_speed || low_mm > 0.0) {
+          high_speed = low_speed; // Can't make the exit speed. Ramp straight to it.
+        }
+      }
+      if (high_speed > low_speed) {
+        st_search_t search = { low_speed, high_speed, low_mm, high_mm, -low_mm, high_mm, 0 };
+        uint8_t i;
+        for (i=0; i<JERK_SEARCH_ITERATIONS && search.low_gap > prep.req_mm_increment; i++) {
+          prep.maximum_speed = st_search_next(&search);
+          st_search_update(&search, prep.maximum_speed,
+            st_profile_length(start_accel, prep.maximum_speed) - group_mm);
+        }
+        low_speed = search.low;
+        high_speed = search.high;
+        if (low_speed > 0.0) { high_speed = low_speed; } // Else just past the end, but not stopped.
+      }
+    }
+    prep.maximum_speed = high_speed;
+
+    st_ramp_t ramp;
+    float accelerate_mm = st_ramp_plan(&ramp, prep.current_speed, start_accel, prep.maximum_speed);
+    prep.accelerate_until = mm_remaining-accelerate_mm;
+    prep.decelerate_after = st_ramp_plan(&ramp, prep.maximum_speed, 0.0, prep.exit_speed)-prep.group_mm;
+    if (accelerate_mm > 0.0) {
+      prep.ramp_type = RAMP_ACCEL;
+      st_ramp_start(prep.maximum_speed, start_accel, mm_remaining);
+    } else if (mm_remaining > prep.decelerate_after) {
+      prep.ramp_type = RAMP_CRUISE;
+    } else {
+      prep.ramp_type = RAMP_DECEL;
+      st_ramp_start(prep.exit_speed, 0.0, mm_remaining);
+    }
+  }
+#endif
+
+
+#ifdef ARC_BLOCKS
+  // Starts to prep an arc block. Its segments step the chords between points of the arc, and
+  // each chord has its own Bresenham data. See st_arc_chord().
+  static void st_arc_start()
+  {
+    uint8_t axis_linear = pl_block->arc_axis-1;
+    uint8_t axis_0 = (axis_linear+1) % N_AXIS;
+    uint8_t axis_1 = (axis_linear+2) % N_AXIS;
+    // A chord takes as many step events as its longest axis has steps. At most this many per mm.
+    prep.step_per_mm = max(settings.steps_per_mm[axis_linear],
+                           max(settings.steps_per_mm[axis_0], settings.steps_per_mm[axis_1]));
+    prep.arc_mm = pl_block->millimeters;
+    prep.arc_angle = 0.0;
+    prep.arc_radius[0] = pl_block->arc_radius[0];
+    prep.arc_radius[1] = pl_block->arc_radius[1];
+    prep.arc_count = 0;
+    memset(prep.arc_steps, 0, sizeof(prep.arc_steps));
+  }
+
+
+  // Prepares the Bresenham data of the chord from where the last arc segment ended to the point of
+  // the arc mm_remaining from its end, and points the segment at it. Returns its step events. With
+  // none, nothing is kept, and the next segment starts from the same point.
+  // NOTE: The radius vector is rotated by the small angle approximation of mc_arc(), with an exact
+  // rotation every N_ARC_CORRECTION segments. The end of the arc is where the planner put it.
+  static uint32_t st_arc_chord(segment_t *prep_segment, float mm_remaining)
+  {
+    uint8_t axis_linear = pl_block->arc_axis-1;
+    uint8_t axis_0 = (axis_linear+1) % N_AXIS;
+    uint8_t axis_1 = (axis_linear+2) % N_AXIS;
+    int32_t target[N_AXIS]; // Steps from the start of the arc
+    float angle = prep.arc_angle;
+    float r_axis0 = prep.arc_radius[0];
+    float r_axis1 = prep.arc_radius[1];
+    uint8_t count = prep.arc_count;
+    uint8_t idx;
+    if (mm_remaining == 0.0) {
+      for (idx=0; idx<N_AXIS; idx++) {
+        target[idx] = pl_block->steps[idx];
+        if (pl_block->direction_bits & get_direction_pin_mask(idx)) { target[idx] = -target[idx]; }
+      }
+    } else {
+      float mm_done = prep.arc_mm - mm_remaining;
+      angle = pl_block->arc_angle_per_mm*mm_done;
+      if (++count < N_ARC_CORRECTION) {
+        float theta = angle - prep.arc_angle;
+        float cos_T = 2.0 - theta*theta;
+        float sin_T = theta*0.16666667*(cos_T + 4.0);
+        cos_T *= 0.5;
+        float r_axisi = r_axis0*sin_T + r_axis1*cos_T;
+        r_axis0 = r_axis0*cos_T - r_axis1*sin_T;
+        r_axis1 = r_axisi;
+      } else {
+        float cos_Ti = cos(angle);
+        float sin_Ti = sin(angle);
+        r_axis0 = pl_block->arc_radius[0]*cos_Ti - pl_block->arc_radius[1]*sin_Ti;
+        r_axis1 = pl_block->arc_radius[0]*sin_Ti + pl_block->arc_radius[1]*cos_Ti;
+        count = 0;
+      }
+      target[axis_0] = lround((r_axis0-pl_block->arc_radius[0])*settings.steps_per_mm[axis_0]);
+      target[axis_1] = lround((r_axis1-pl_block->arc_radius[1])*settings.steps_per_mm[axis_1]);
+      target[axis_linear] = lround(pl_block->arc_linear_per_mm*mm_done*settings.steps_per_mm[axis_linear]);
+    }
+
+    uint32_t steps[N_AXIS];
+    uint32_t step_event_count = 0;
+    uint8_t direction_bits = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      int32_t delta = target[idx]-prep.arc_steps[idx];
+      if (delta < 0) { 
+        direction_bits |= get_direction_pin_mask(idx); 
+        delta = -delta;
+      }
+      steps[idx] = delta;
+      step_event_count = max(step_event_count, steps[idx]);
+    }
+    if (step_event_count == 0) { return(0); }
+
+    if ( ++prep.st_block_index == ST_BLOCK_BUFFER_SIZE ) { prep.st_block_index = 0; }
+    st_prep_block = &st_block_buffer[prep.st_block_index];
+    // Multiplied as for AMASS, also without it. Only the ratios count, and the Bresenham counters
+    // then start halfway through a step, even for a chord of a single step.
+    st_prep_block->direction_bits = direction_bits;
+    for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = steps[idx] << MAX_AMASS_LEVEL; }
+    st_prep_block->step_event_count = step_event_count << MAX_AMASS_LEVEL;
+    #ifdef RASTER_ENGRAVING
+      st_prep_block->raster_start = pl_block->raster_start;
+      st_prep_block->raster_steps = 0;
+    #endif
+    prep_segment->st_block_index = prep.st_block_index;
+
+    memcpy(prep.arc_steps, target, sizeof(target));
+    prep.arc_angle = angle;
+    prep.arc_radius[0] = r_axis0;
+    prep.arc_radius[1] = r_axis1;
+    prep.arc_count = count;
+    return(step_event_count);
+  }
+#endif
+
+
+// Computes the timer period of a prepped segment from its time per step (min/step), with the AMASS
+// level or timer prescaler that period needs. With RASTER_ENGRAVING, also the power scale of its speed.
+static void st_prep_segment_rate(segment_t *prep_segment, float inv_rate)
+{
+  // Compute CPU cycles per step for the prepped segment.
+  uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60)*inv_rate ); // (cycles/step)    
+
+  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING        
+    // Compute step timing and multi-axis smoothing level.
+    // NOTE: AMASS overdrives the timer with each level, so only one prescalar is required.
+    if (cycles < AMASS_LEVEL1) { prep_segment->amass_level = 0; }
+    else {
+      if (cycles < AMASS_LEVEL2) { prep_segment->amass_level = 1; }
+      else if (cycles < AMASS_LEVEL3) { prep_segment->amass_level = 2; }
+      else { prep_segment->amass_level = 3; }    
+      cycles >>= prep_segment->amass_level; 
+      prep_segment->n_step <<= prep_segment->amass_level;
+    }
+    if (cycles < (1UL << 16)) { prep_segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
+    else { prep_segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
+  #else 
+    // Compute step timing and timer prescalar for normal step generation.
+    if (cycles < (1UL << 16)) { // < 65536  (4.1ms @ 16MHz)
+      prep_segment->prescaler = 1; // prescaler: 0
+      prep_segment->cycles_per_tick = cycles;
+    } else if (cycles < (1UL << 19)) { // < 524288 (32.8ms@16MHz)
+      prep_segment->prescaler = 2; // prescaler: 8
+      prep_segment->cycles_per_tick = cycles >> 3;
+    } else { 
+      prep_segment->prescaler = 3; // prescaler: 64
+      if (cycles < (1UL << 22)) { // < 4194304 (262ms@16MHz)
+        prep_segment->cycles_per_tick =  cycles >> 6;
+      } else { // Just set the slowest speed possible. (Around 4 step/sec.)
+        prep_segment->cycles_per_tick = 0xffff;
+      }
+    }
+  #endif
+
+  #ifdef RASTER_ENGRAVING
+    // The power of the pixels goes with the speed, so they burn as deep speeding up or slowing down.
+    st_block_t *block = &st_block_buffer[prep_segment->st_block_index];
+    if (block->raster_steps) {
+      float gain = 256.0/(inv_rate*block->raster_step_rate);
+      prep_segment->raster_gain = (gain < 255.5) ? (uint16_t)(gain+0.5) : 256;
+    }
+  #endif
+}
+
+
+#ifdef INPUT_SHAPING
+  /* INPUT SHAPING
+     The planned velocity profile is sampled into the history, a segment at a time, but the steps
+     follow the shaped profile: at each moment, the sum of the planned speeds at each impulse's
+     delay before, scaled by its amplitude. The shaped distance over the newest samples is then
+     the sum, over the impulses, of the planned distance in the same time span moved back by the
+     delay. Every start and stop of the acceleration becomes a few smaller ones, spaced so the
+     frame's ringing from each cancels that of the others.
+       The shaped motion trails the planned one by up to the longest delay. It keeps its own place
+     in the stepper blocks, and makes the segments, so the planner blocks may be discarded as soon
+     as they are planned through. It never runs ahead of the planned motion, and goes on to it
+     exactly once the planned motion has stood still for the longest delay, so no step is lost to
+     round-off or to samples merged in the history.
+  */
+
+  // Impulses of the shaper of one axis, from its settings. Returns how many.
+  static uint8_t st_shaper_axis_impulses(uint8_t idx, float *amplitude, float *delay)
+  {
+    float damping = settings.shaper_damping[idx];
+    float root = sqrt(1.0-damping*damping);
+    float period = 1.0/(60.0*settings.shaper_frequency[idx]*root); // Damped period (min)
+    float k;
+    uint8_t count = 3;
+    switch (settings.shaper_type[idx]) {
+      case SHAPER_ZVD:
+        k = exp(-damping*M_PI/root);
+        amplitude[0] = 1.0; amplitude[1] = 2.0*k; amplitude[2] = k*k;
+        delay[1] = 0.5*period; delay[2] = period;
+        break;
+      case SHAPER_MZV:
+        k = exp(-0.75*damping*M_PI/root);
+        amplitude[0] = 1.0-M_SQRT1_2; amplitude[1] = (M_SQRT2-1.0)*k; amplitude[2] = amplitude[0]*k*k;
+        delay[1] = 0.375*period; delay[2] = 0.75*period;
+        break;
+      default: // SHAPER_ZV
+        k = exp(-damping*M_PI/root);
+        amplitude[0] = 1.0; amplitude[1] = k;
+        delay[1] = 0.5*period;
+        count = 2;
+    }
+    delay[0] = 0.0;
+    float sum = 0.0;
+    uint8_t i;
+    for (i=0; i<count; i++) { sum += amplitude[i]; }
+    for (i=0; i<count; i++) { amplitude[i] /= sum; }
+    return(count);
+  }
+
+
+  uint8_t st_shaper_init()
+  {
+    shaper.count = 1;
+    shaper.amplitude[0] = 1.0;
+    shaper.delay[0] = 0.0;
+    shaper.duration = 0.0;
+    shaper.window = 0.0;
+    shaper.lag = 0.0;
+    shaper.lag_sqr = 0.0;
+    uint8_t idx, prior, i, j;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (settings.shaper_frequency[idx] == 0.0) { continue; }
+      // Axes with the same shaper need it only once.
+      for (prior=0; prior<idx; prior++) {
+        if ((settings.shaper_frequency[prior] == settings.shaper_frequency[idx]) &&
+            (settings.shaper_damping[prior] == settings.shaper_damping[idx]) &&
+            (settings.shaper_type[prior] == settings.shaper_type[idx])) { break; }
+      }
+      if (prior < idx) { continue; }
+      float amplitude[3], delay[3];
+      uint8_t count = st_shaper_axis_impulses(idx, amplitude, delay);
+      if (shaper.count*count > INPUT_SHAPER_IMPULSES) {
+        shaper.count = 1;
+        shaper.amplitude[0] = 1.0;
+        shaper.delay[0] = 0.0;
+        return(false);
+      }
+      // Convolve with the impulses so far. From the last one down, so none is written over before
+      // it is used.
+      i = shaper.count;
+      while (i--) {
+        float a = shaper.amplitude[i];
+        float d = shaper.delay[i];
+        for (j=0; j<count; j++) {
+          shaper.amplitude[i*count+j] = a*amplitude[j];
+          shaper.delay[i*count+j] = d+delay[j];
+        }
+      }
+      shaper.count *= count;
+    }
+    for (i=0; i<shaper.count; i++) {
+      shaper.duration = max(shaper.duration, shaper.delay[i]);
+      float dt = shaper.delay[i]+DT_SEGMENT;
+      shaper.lag += shaper.amplitude[i]*dt;
+      shaper.lag_sqr += 0.5*shaper.amplitude[i]*dt*dt;
+    }
+    if (shaper.duration > 0.0) {
+      // The shaped motion may be this far behind, plus a segment. As long as no INPUT_SHAPER_BLOCKS-3
+      // blocks in a row take less, the stepper blocks always hold all it still needs.
+      shaper.window = shaper.duration+DT_SEGMENT;
+    }
+    return(true);
+  }
+
+
+  float st_shaper_window()
+  {
+    return(shaper.window);
+  }
+
+
+  // The shaped position is the planned one at each delay, weighted by the amplitudes, which are all
+  // positive. The planned motion is now at speed, and slowed down at most at acceleration, so over a
+  // delay dt it covered at most dt*speed + acceleration*dt^2/2. So the shaped motion is at most
+  // lag*speed + lag_sqr*acceleration behind.
+  float st_shaper_lag_speed(float mm, float acceleration)
+  {
+    mm -= shaper.lag_sqr*acceleration;
+    if (mm <= 0.0) { return(0.0); }
+    return(mm/shaper.lag);
+  }
+
+
+  // Adds a sample of the planned profile, which went mm in dt. When the history is full, the two
+  // oldest samples are merged, losing some detail of the motion furthest behind.
+  static void st_shaper_push(float dt, float mm)
+  {
+    if (prep.history_count == INPUT_SHAPER_HISTORY) {
+      uint8_t oldest = prep.history_head+1;
+      if (oldest == INPUT_SHAPER_HISTORY) { oldest = 0; }
+      uint8_t next = oldest+1;
+      if (next == INPUT_SHAPER_HISTORY) { next = 0; }
+      prep.history_dt[next] += prep.history_dt[oldest];
+      prep.history_mm[next] += prep.history_mm[oldest];
+      prep.history_count--;
+    }
+    if ( ++prep.history_head == INPUT_SHAPER_HISTORY ) { prep.history_head = 0; }
+    prep.history_dt[prep.history_head] = dt;
+    prep.history_mm[prep.history_head] = mm;
+    prep.history_count++;
+    prep.shaper_lead += dt;
+  }
+
+
+  // Distance planned in the last age minutes of the history. Even within a sample.
+  static float st_shaper_history_mm(float age)
+  {
+    float mm = 0.0;
+    uint8_t idx = prep.history_head;
+    uint8_t count = prep.history_count;
+    while (count--) {
+      float dt = prep.history_dt[idx];
+      if (age < dt) { return(mm + prep.history_mm[idx]*age/dt); }
+      mm += prep.history_mm[idx];
+      age -= dt;
+      if (idx == 0) { idx = INPUT_SHAPER_HISTORY; }
+      idx--;
+    }
+    return(mm);
+  }
+
+
+  // True if the shaped motion is where the planned one is.
+  static uint8_t st_shaper_caught_up()
+  {
+    return((prep.shaped_index == prep.st_block_index) && (prep.shaped_mm_remaining == prep.profile_mm));
+  }
+
+
+  // Shapes the newest samples of the planned profile, and prepares a segment of what they give, up
+  // to the end of a stepper block. What is left of them goes in the next call.
+  static void st_shaper_prep_segment()
+  {
+    if (prep.shaper_dt == 0.0) {
+      float dt = prep.shaper_lead;
+      float mm = 0.0;
+      prep.shaper_flush = (prep.shaper_idle >= shaper.duration);
+      if (!prep.shaper_flush) {
+        uint8_t i;
+        for (i=0; i<shaper.count; i++) {
+          mm += shaper.amplitude[i]*(st_shaper_history_mm(shaper.delay[i]+dt) - st_shaper_history_mm(shaper.delay[i]));
+        }
+      }
+      prep.shaper_dt = dt;
+      prep.shaper_mm = mm;
+      prep.shaper_lead = 0.0;
+    }
+
+    // Move on to the next stepper block, once through this one.
+    if ((prep.shaped_mm_remaining == 0.0) && (prep.shaped_index != prep.st_block_index)) {
+      if ( ++prep.shaped_index == ST_BLOCK_BUFFER_SIZE ) { prep.shaped_index = 0; }
+      st_block_t *block = &st_block_buffer[prep.shaped_index];
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        prep.shaped_steps_remaining = block->step_event_count >> MAX_AMASS_LEVEL;
+      #else
+        prep.shaped_steps_remaining = block->step_event_count;
+      #endif
+      prep.shaped_mm_remaining = block->millimeters;
+      prep.shaped_step_per_mm = prep.shaped_steps_remaining/block->millimeters;
+      prep.shaped_dt_remainder = 0.0;
+    }
+
+    float dt = prep.shaper_dt;
+    float mm_remaining = prep.shaped_mm_remaining - prep.shaper_mm;
+    if (prep.shaped_index == prep.st_block_index) {
+      // Never past the planned motion. Anything more is round-off.
+      if (prep.shaper_flush || (mm_remaining < prep.profile_mm)) { mm_remaining = prep.profile_mm; }
+      prep.shaper_dt = 0.0;
+    } else if (prep.shaper_flush || (mm_remaining < 0.0)) {
+      // Through the end of the block. The rest goes into the next, in the rest of the time. 
+      if (!prep.shaper_flush) {
+        dt *= prep.shaped_mm_remaining/prep.shaper_mm;
+        prep.shaper_dt -= dt;
+        prep.shaper_mm -= prep.shaped_mm_remaining;
+      }
+      mm_remaining = 0.0;
+    } else {
+      prep.shaper_dt = 0.0;
+    }
+    prep.shaped_mm_remaining = mm_remaining;
+
+    // As for the planned segments in st_prep_buffer(), with the shaped motion's own partial steps.
+    segment_t *prep_segment = &segment_buffer[segment_buffer_head];
+    prep_segment->st_block_index = prep.shaped_index;
+    float steps_remaining = prep.shaped_step_per_mm*mm_remaining;
+    float n_steps_remaining = ceil(steps_remaining);
+    float last_n_steps_remaining = ceil(prep.shaped_steps_remaining);
+    prep_segment->n_step = last_n_steps_remaining-n_steps_remaining;
+    if (prep_segment->n_step == 0) { // Not a whole step yet. Its time goes to the next segment.
+      prep.shaped_dt_remainder += dt;
+      prep.shaped_steps_remaining = steps_remaining;
+      return;
+    }
+    dt += prep.shaped_dt_remainder;
+    float inv_rate = dt/(last_n_steps_remaining - steps_remaining);
+    prep.shaped_dt_remainder = (n_steps_remaining - steps_remaining)*inv_rate;
+    prep.shaped_steps_remaining = steps_remaining;
+    st_prep_segment_rate(prep_segment, inv_rate);
+
+    // Segment complete! Increment segment buffer indices.
+    segment_buffer_head = segment_next_head;
+    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+  }
+
+
+  // Called while the planned motion stands still. Samples it standing, so the shaped motion goes
+  // on to it. Returns false once there.
+  static uint8_t st_shaper_drain()
+  {
+    if (st_shaper_caught_up()) { return(false); }
+    st_shaper_push(DT_SEGMENT, 0.0);
+    prep.shaper_idle += DT_SEGMENT;
+    return(true);
+  }
+
+
+  // Ends a motion suspend, once the shaped motion has stopped where the planned one did. That is
+  // between steps, so the block is left with the steps not yet taken, as without shaping.
+  static void st_shaper_hold()
+  {
+    prep.shaped_dt_remainder = 0.0;
+    prep.shaped_steps_remaining = ceil(prep.shaped_steps_remaining);
+    prep.shaped_mm_remaining = prep.shaped_steps_remaining/prep.shaped_step_per_mm;
+    prep.profile_mm = prep.shaped_mm_remaining;
+    pl_block->millimeters = prep.shaped_mm_remaining;
+    plan_cycle_reinitialize();
+  }
+#endif
+
+
 /* Prepares step segment buffer. Continuously called from main program. 
 
    The segment buffer is an intermediary buffer interface between the execution of steps
@@ -519,28 +1364,86 @@ void st_update_plan_block_parameters()
    Currently, the segment buffer conservatively holds roughly up to 40-50 msec of steps.
    NOTE: Computation units are in steps, millimeters, and minutes.
 */
-void st_prep_buffer()
+#ifdef PERFORMANCE_COUNTERS
+  static void st_prep_segments();
+
+  // Times st_prep_segments(), the segment generator, when it prepped a segment.
+  void st_prep_buffer()
+  {
+    uint8_t head = segment_buffer_head;
+    uint32_t start = st_cycles();
+    st_prep_segments();
+    if (segment_buffer_head != head) { perf_add(&perf.prep, st_cycles()-start); }
+  }
+
+  static void st_prep_segments()
+#else
+  void st_prep_buffer()
+#endif
 {
 
+  #ifndef INPUT_SHAPING // The shaped motion may have to stop yet. Checked below.
   if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) { 
     // Check if we still need to generate more segments for a motion suspend.
     if (prep.current_speed == 0.0) { return; } // Nothing to do. Bail.
   }
+  #endif
   
   while (segment_buffer_tail != segment_next_head) { // Check if we need to fill the buffer.
 
+    #ifdef INPUT_SHAPING
+      // Shape what was planned before planning more.
+      if ((prep.shaper_lead > 0.0) || (prep.shaper_dt > 0.0)) {
+        st_shaper_prep_segment();
+        continue;
+      }
+      if ((sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) && (prep.current_speed == 0.0)) {
+        // The planned motion has stopped for the motion suspend. Done once the shaped one has too.
+        if (st_shaper_drain()) { continue; }
+        if (pl_block != NULL) { st_shaper_hold(); }
+        return;
+      }
+    #endif
+
     // Determine if we need to load a new planner block or if the block has been replanned. 
     if (pl_block == NULL) {
       pl_block = plan_get_current_block(); // Query planner for a queued block
-      if (pl_block == NULL) { return; } // No planner blocks. Exit.
+      if (pl_block == NULL) { // No planner blocks. Exit.
+        #ifdef JERK_LIMITED_ACCELERATION
+          // The last block was planned to a stop. The next one starts from rest.
+          prep.current_speed = 0.0;
+          prep.ramp_time = prep.ramp.end_time;
+        #endif
+        #ifdef INPUT_SHAPING
+          if (st_shaper_drain()) { continue; } // The shaped motion goes on to where the planned one stopped.
+        #endif
+        return; 
+      }
                       
       // Check if the segment buffer completed the last planner block. If so, load the Bresenham
       // data for the block. If not, we are still mid-block and the velocity profile was updated. 
       if (prep.flag_partial_block) {
         prep.flag_partial_block = false; // Reset flag
       } else {
+        #ifdef INPUT_SHAPING
+          // Never load over a stepper block the shaped motion still needs. The planner's speed limit
+          // keeps it close enough behind, but should it fall back, the planned motion waits for it.
+          uint8_t blocks_behind = prep.st_block_index - prep.shaped_index;
+          if (prep.st_block_index < prep.shaped_index) { blocks_behind += ST_BLOCK_BUFFER_SIZE; }
+          if (blocks_behind+2 > INPUT_SHAPER_BLOCKS) {
+            pl_block = NULL;
+            st_shaper_drain();
+            continue;
+          }
+        #endif
+        #ifdef ARC_BLOCKS
+          prep.arc_axis = pl_block->arc_axis;
+        if (prep.arc_axis) { 
+          st_arc_start(); // No Bresenham data until its first chord.
+        } else {
+        #endif
         // Increment stepper common data index to store new planner block data. 
-        if ( ++prep.st_block_index == (SEGMENT_BUFFER_SIZE-1) ) { prep.st_block_index = 0; }
+        if ( ++prep.st_block_index == ST_BLOCK_BUFFER_SIZE ) { prep.st_block_index = 0; }
         
         // Prepare and copy Bresenham algorithm segment data from the new planner block, so that
         // when the segment buffer completes the planner block, it may be discarded when the 
@@ -565,16 +1468,45 @@ void st_prep_buffer()
         // Initialize segment buffer data for generating the segments.
         prep.steps_remaining = pl_block->step_event_count;
         prep.step_per_mm = prep.steps_remaining/pl_block->millimeters;
+        #ifdef RASTER_ENGRAVING
+          st_prep_block->raster_start = pl_block->raster_start;
+          #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+            st_prep_block->raster_steps = (uint32_t)pl_block->raster_pixels << MAX_AMASS_LEVEL;
+          #else
+            st_prep_block->raster_steps = pl_block->raster_pixels;
+          #endif
+          st_prep_block->raster_step_rate = prep.step_per_mm*sqrt(pl_block->nominal_speed_sqr);
+        #endif
+        #ifdef INPUT_SHAPING
+          st_prep_block->millimeters = pl_block->millimeters;
+          prep.profile_mm = pl_block->millimeters;
+        #endif
+        #ifdef ARC_BLOCKS
+        }
+        #endif
         prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
         
         prep.dt_remainder = 0.0; // Reset for new planner block
 
-        if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) {
-          // Override planner block entry speed and enforce deceleration during feed hold.
-          prep.current_speed = prep.exit_speed; 
-          pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed; 
-        }
-        else { prep.current_speed = sqrt(pl_block->entry_speed_sqr); }
+        #ifdef JERK_LIMITED_ACCELERATION
+          // Carry on at the speed and acceleration the last block ended with. The profile of the
+          // ramp group moves along to the new block, unless it starts a new group.
+          if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) {
+            pl_block->entry_speed_sqr = prep.current_speed*prep.current_speed; 
+          }
+          prep.group_mm -= pl_block->millimeters;
+          if (prep.group_mm < -0.5*pl_block->millimeters) { prep.recalculate_profile = true; }
+          prep.accelerate_until += pl_block->millimeters;
+          prep.decelerate_after += pl_block->millimeters;
+          prep.ramp_end_mm += pl_block->millimeters;
+        #else
+          if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) {
+            // Override planner block entry speed and enforce deceleration during feed hold.
+            prep.current_speed = prep.exit_speed; 
+            pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed; 
+          }
+          else { prep.current_speed = sqrt(pl_block->entry_speed_sqr); }
+        #endif
       }
      
       /* --------------------------------------------------------------------------------- 
@@ -584,6 +1516,20 @@ void st_prep_buffer()
          hold, override the planner velocities and decelerate to the target exit speed.
       */
       prep.mm_complete = 0.0; // Default velocity profile complete at 0.0mm from end of block.
+    #ifdef JERK_LIMITED_ACCELERATION
+      if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) { // [Forced Deceleration to Zero Velocity]
+        // Decelerate to a stop from the current speed and acceleration, through the next blocks
+        // if need be. The profile is recomputed on resuming.
+        float start_accel = st_ramp_acceleration();
+        prep.accel_limit = pl_block->acceleration;
+        prep.jerk_limit = pl_block->jerk;
+        prep.ramp_type = RAMP_DECEL;
+        st_ramp_start(0.0, start_accel, pl_block->millimeters);
+        if (prep.ramp_end_mm > 0.0) { prep.mm_complete = prep.ramp_end_mm; } // End of feed hold.
+      } else if (prep.recalculate_profile) { // [Normal Operation]
+        st_prep_jerk_profile(pl_block->millimeters);
+      }
+    #else
       float inv_2_accel = 0.5/pl_block->acceleration;
       if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) { // [Forced Deceleration to Zero Velocity]
         // Compute velocity profile parameters for a feed hold in-progress. This profile overrides
@@ -635,6 +1581,7 @@ void st_prep_buffer()
           prep.maximum_speed = prep.exit_speed;
         }
       }  
+    #endif
     }
 
     // Initialize new segment
@@ -667,6 +1614,68 @@ void st_prep_buffer()
     if (minimum_mm < 0.0) { minimum_mm = 0.0; }
 
     do {
+    #ifdef JERK_LIMITED_ACCELERATION
+      if (prep.ramp_type == RAMP_CRUISE) {
+        float mm_end = max(prep.decelerate_after, prep.mm_complete);
+        mm_var = mm_remaining - prep.maximum_speed*time_var;
+        if (mm_var < mm_end) { // End of cruise or of block.
+          time_var = (mm_remaining - mm_end)/prep.maximum_speed;
+          mm_remaining = mm_end;
+          if (mm_end == prep.decelerate_after) { // Cruise-deceleration junction.
+            prep.ramp_type = RAMP_DECEL;
+            st_ramp_start(prep.exit_speed, 0.0, mm_remaining);
+          }
+        } else { // Cruising only.
+          mm_remaining = mm_var; 
+        } 
+      } else {
+        // S-curve ramp. Speed and distance follow from the time into it. A deceleration ramp ends
+        // where the profile does, and any ramp may run on into the next block.
+        float mm_end = prep.mm_complete;
+        if (prep.ramp_type == RAMP_ACCEL) { mm_end = max(prep.ramp_end_mm, prep.mm_complete); }
+        float ramp_time = prep.ramp_time + time_var;
+        if (ramp_time > prep.ramp.end_time) {
+          ramp_time = prep.ramp.end_time;
+          time_var = ramp_time - prep.ramp_time;
+        }
+        float ramp_mm = st_ramp_position(ramp_time, &speed_var);
+        mm_var = mm_remaining - (ramp_mm - prep.ramp_mm);
+        if (mm_var < mm_end && prep.ramp_end_mm < prep.mm_complete-prep.req_mm_increment) {
+          // The ramp runs on into the next block. Find when it crosses the end of this one, to a
+          // tenth of a step, from the start of the segment (short of it) and ramp_time (past it).
+          float crossing_mm = prep.ramp_mm + mm_remaining - mm_end; // Into the ramp
+          st_search_t search = { prep.ramp_time, ramp_time, prep.ramp_mm-crossing_mm, ramp_mm-crossing_mm,
+                                 crossing_mm-prep.ramp_mm, ramp_mm-crossing_mm, 0 };
+          uint8_t i;
+          for (i=0; i<JERK_SEARCH_ITERATIONS && search.high_gap > 0.1*prep.req_mm_increment; i++) {
+            float time = st_search_next(&search);
+            st_search_update(&search, time, st_ramp_position(time, &speed_var) - crossing_mm);
+          }
+          ramp_time = search.high;
+          ramp_mm = st_ramp_position(ramp_time, &speed_var);
+          time_var = ramp_time - prep.ramp_time;
+          mm_var = mm_end;
+        } else if (ramp_time == prep.ramp.end_time || mm_var < mm_end) {
+          // End of ramp. Round-off may leave it a little short of or past where it was planned to end.
+          ramp_time = prep.ramp.end_time;
+          ramp_mm = prep.ramp.length;
+          speed_var = prep.ramp.end_speed;
+          time_var = ramp_time - prep.ramp_time;
+          mm_var = mm_end;
+        }
+        prep.ramp_time = ramp_time;
+        prep.ramp_mm = ramp_mm;
+        prep.current_speed = speed_var;
+        mm_remaining = mm_var;
+        if (ramp_time == prep.ramp.end_time && prep.ramp_type == RAMP_ACCEL) {
+          if (mm_remaining > prep.decelerate_after) { prep.ramp_type = RAMP_CRUISE; }
+          else {
+            prep.ramp_type = RAMP_DECEL;
+            st_ramp_start(prep.exit_speed, 0.0, mm_remaining);
+          }
+        }
+      }
+    #else
       switch (prep.ramp_type) {
         case RAMP_ACCEL: 
           // NOTE: Acceleration ramp only computes during first do-while loop.
@@ -712,6 +1721,7 @@ void st_prep_buffer()
           time_var = 2.0*(mm_remaining-prep.mm_complete)/(prep.current_speed+prep.exit_speed);
           mm_remaining = prep.mm_complete; 
       }
+    #endif
       dt += time_var; // Add computed ramp time to total segment time.
       if (dt < dt_max) { time_var = dt_max - dt; } // **Incomplete** At ramp junction.
       else {
@@ -726,6 +1736,23 @@ void st_prep_buffer()
       }
     } while (mm_remaining > prep.mm_complete); // **Complete** Exit loop. Profile complete.
 
+    #ifdef INPUT_SHAPING
+      // The segment is only a sample of the planned profile. The shaped one makes the segments.
+      st_shaper_push(dt, pl_block->millimeters-mm_remaining);
+      prep.shaper_idle = 0.0;
+      prep.profile_mm = mm_remaining;
+      if (mm_remaining > prep.mm_complete) { 
+        pl_block->millimeters = mm_remaining;
+      } else if (mm_remaining > 0.0) { // At end of forced-termination. Completed above once shaped.
+        pl_block->millimeters = mm_remaining;
+        prep.current_speed = 0.0;
+      } else { // End of planner block
+        pl_block = NULL;
+        plan_discard_current_block();
+      }
+      continue;
+    #endif
+
    
     /* -----------------------------------------------------------------------------------
        Compute segment step rate, steps to execute, and apply necessary rate corrections.
@@ -738,19 +1765,48 @@ void st_prep_buffer()
        supported by Grbl (i.e. exceeding 10 meters axis travel at 200 step/mm).
     */
     float steps_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
+    #ifdef ARC_BLOCKS
+      if (prep.arc_axis) {
+        // An arc segment steps the whole chord to where it ends, with no partial step left over.
+        prep.steps_remaining = st_arc_chord(prep_segment, mm_remaining);
+        steps_remaining = 0.0;
+      }
+    #endif
     float n_steps_remaining = ceil(steps_remaining); // Round-up current steps remaining
     float last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
     prep_segment->n_step = last_n_steps_remaining-n_steps_remaining; // Compute number of steps to execute.
     
     // Bail if we are at the end of a feed hold and don't have a step to execute.
     if (prep_segment->n_step == 0) {
+      #ifdef ARC_BLOCKS
+        if (prep.arc_axis) {
+          // Not a whole step along the chord yet. Its time goes to the next segment, unless the
+          // arc or a feed hold ends here.
+          if (mm_remaining > prep.mm_complete) {
+            prep.dt_remainder += dt;
+            pl_block->millimeters = mm_remaining;
+            continue;
+          } 
+          if (mm_remaining == 0.0) {
+            pl_block = NULL;
+            plan_discard_current_block();
+            continue;
+          }
+        }
+      #endif
       if (sys.state & (STATE_HOLD|STATE_MOTION_CANCEL|STATE_SAFETY_DOOR)) {
         // Less than one step to decelerate to zero speed, but already very close. AMASS 
         // requires full steps to execute. So, just bail.
         prep.current_speed = 0.0; // NOTE: (=0.0) Used to indicate completed segment calcs for hold.
+        #ifdef JERK_LIMITED_ACCELERATION
+          prep.ramp_time = prep.ramp.end_time; // Hold ramp done.
+        #endif
         prep.dt_remainder = 0.0;
         prep.steps_remaining = n_steps_remaining;
         pl_block->millimeters = prep.steps_remaining/prep.step_per_mm; // Update with full steps.
+        #ifdef ARC_BLOCKS
+          if (prep.arc_axis) { pl_block->millimeters = mm_remaining; } // The next chord starts where the last ended.
+        #endif
         plan_cycle_reinitialize();         
         return; // Segment not generated, but current step data still retained.
       }
@@ -768,39 +1824,7 @@ void st_prep_buffer()
     float inv_rate = dt/(last_n_steps_remaining - steps_remaining); // Compute adjusted step rate inverse
     prep.dt_remainder = (n_steps_remaining - steps_remaining)*inv_rate; // Update segment partial step time
 
-    // Compute CPU cycles per step for the prepped segment.
-    uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60)*inv_rate ); // (cycles/step)    
-
-    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING        
-      // Compute step timing and multi-axis smoothing level.
-      // NOTE: AMASS overdrives the timer with each level, so only one prescalar is required.
-      if (cycles < AMASS_LEVEL1) { prep_segment->amass_level = 0; }
-      else {
-        if (cycles < AMASS_LEVEL2) { prep_segment->amass_level = 1; }
-        else if (cycles < AMASS_LEVEL3) { prep_segment->amass_level = 2; }
-        else { prep_segment->amass_level = 3; }    
-        cycles >>= prep_segment->amass_level; 
-        prep_segment->n_step <<= prep_segment->amass_level;
-      }
-      if (cycles < (1UL << 16)) { prep_segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
-      else { prep_segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
-    #else 
-      // Compute step timing and timer prescalar for normal step generation.
-      if (cycles < (1UL << 16)) { // < 65536  (4.1ms @ 16MHz)
-        prep_segment->prescaler = 1; // prescaler: 0
-        prep_segment->cycles_per_tick = cycles;
-      } else if (cycles < (1UL << 19)) { // < 524288 (32.8ms@16MHz)
-        prep_segment->prescaler = 2; // prescaler: 8
-        prep_segment->cycles_per_tick = cycles >> 3;
-      } else { 
-        prep_segment->prescaler = 3; // prescaler: 64
-        if (cycles < (1UL << 22)) { // < 4194304 (262ms@16MHz)
-          prep_segment->cycles_per_tick =  cycles >> 6;
-        } else { // Just set the slowest speed possible. (Around 4 step/sec.)
-          prep_segment->cycles_per_tick = 0xffff;
-        }
-      }
-    #endif
+    st_prep_segment_rate(prep_segment, inv_rate);
 
     // Segment complete! Increment segment buffer indices.
     segment_buffer_head = segment_next_head;
@@ -821,6 +1845,9 @@ void st_prep_buffer()
         prep.dt_remainder = 0.0;
         prep.steps_remaining = ceil(steps_remaining);
         pl_block->millimeters = prep.steps_remaining/prep.step_per_mm; // Update with full steps.
+        #ifdef ARC_BLOCKS
+          if (prep.arc_axis) { pl_block->millimeters = mm_remaining; } // The next chord starts where the last ended.
+        #endif
         plan_cycle_reinitialize(); 
         return; // Bail!
       } else { // End of planner block
@@ -834,6 +1861,57 @@ void st_prep_buffer()
 }      
 
 
+#ifdef RASTER_ENGRAVING
+  uint8_t st_raster_fits(uint8_t pixels)
+  {
+    // The pixels of the last block burned are only let go of when a block starts. Nothing else
+    // will start while all motion is done, so they're let go of here.
+    if ((segment_buffer_tail == segment_buffer_head) && (plan_get_block_buffer_count() == 0)) {
+      #ifdef INPUT_SHAPING
+        if (st_shaper_caught_up()) { raster_tail = raster_head; }
+      #else
+        raster_tail = raster_head;
+      #endif
+    }
+    uint8_t tail = raster_tail; // Moved on by the stepper ISR
+    uint8_t used = raster_head-tail;
+    if (raster_head < tail) { used += RASTER_BUFFER_SIZE; }
+    return(used+pixels < RASTER_BUFFER_SIZE);
+  }
+
+
+  uint8_t st_raster_head() { return(raster_head); }
+
+
+  void st_raster_push(uint8_t *power, uint8_t pixels)
+  {
+    while (pixels--) {
+      // As PWM output, rounded.
+      raster_buffer[raster_head] = ((uint16_t)(*power++)*(RASTER_PWM_MAX-RASTER_PWM_OFF)+127)/255;
+      if (++raster_head == RASTER_BUFFER_SIZE) { raster_head = 0; }
+    }
+  }
+#endif
+
+#ifdef PERFORMANCE_COUNTERS
+  uint32_t st_cycles()
+  {
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t cycles = st_clock;
+    if (TIMSK1 & (1<<OCIE1A)) {
+      uint16_t count = TCNT1;
+      // A compare held off by cli(). Timer1 has started over, but the ISR hasn't counted the period.
+      if ((TIFR1 & (1<<OCF1A)) && (count < (OCR1A >> 1))) {
+        cycles += (uint32_t)(OCR1A+1) << st_timer1_shift();
+      }
+      cycles += (uint32_t)count << st_timer1_shift();
+    }
+    SREG = sreg;
+    return(cycles);
+  }
+#endif
+
 // Called by realtime status reporting to fetch the current speed being executed. This value
 // however is not exactly the current speed, but the speed computed in the last step segment
 // in the segment buffer. It will always be behind by up to the number of segment blocks (-1)
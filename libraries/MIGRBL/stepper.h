@@ -26,6 +26,35 @@
   #define SEGMENT_BUFFER_SIZE 6
 #endif
 
+#ifdef INPUT_SHAPING
+  #ifndef INPUT_SHAPER_BLOCKS
+    #define INPUT_SHAPER_BLOCKS 10
+  #endif
+  #ifndef INPUT_SHAPER_HISTORY
+    #define INPUT_SHAPER_HISTORY 16
+  #endif
+  #ifndef INPUT_SHAPER_IMPULSES
+    #define INPUT_SHAPER_IMPULSES 9
+  #endif
+
+  // Input shaper types, as in the $170-$172 settings.
+  #define SHAPER_ZV 0
+  #define SHAPER_ZVD 1
+  #define SHAPER_MZV 2
+#endif
+
+#ifdef RASTER_ENGRAVING
+  #ifndef RASTER_BUFFER_SIZE
+    #define RASTER_BUFFER_SIZE 128
+  #endif
+  #ifndef RASTER_PWM_OFF
+    #define RASTER_PWM_OFF 9
+  #endif
+  #ifndef RASTER_PWM_MAX
+    #define RASTER_PWM_MAX 39
+  #endif
+#endif
+
 // Initialize and setup the stepper motor subsystem
 void stepper_init();
 
@@ -47,6 +76,39 @@ void st_prep_buffer();
 // Called by planner_recalculate() when the executing block is updated by the new plan.
 void st_update_plan_block_parameters();
 
+#ifdef INPUT_SHAPING
+// Makes up the input shaper of all axes from their settings. Returns false, and shapes nothing, if
+// it has more than INPUT_SHAPER_IMPULSES impulses.
+uint8_t st_shaper_init();
+
+// Called by the planner. The least time INPUT_SHAPER_BLOCKS-3 blocks in a row may take, for the
+// shaped motion to follow without running out of stepper blocks. Zero if there is no limit. (min)
+float st_shaper_window();
+
+// Called by the planner. The fastest speed the planned motion may be at, for the shaped motion not
+// to be more than mm behind it, if it never slows down faster than acceleration. Only call it if
+// st_shaper_window() is not zero. (mm/min)
+float st_shaper_lag_speed(float mm, float acceleration);
+#endif
+
+#ifdef RASTER_ENGRAVING
+// Returns true if the raster buffer has room for the power of this many more pixels.
+uint8_t st_raster_fits(uint8_t pixels);
+
+// Index in the raster buffer the power of the next pixels goes to.
+uint8_t st_raster_head();
+
+// Called by the planner. Copies the power of the pixels of the block just planned, 0-255 each, into
+// the raster buffer.
+void st_raster_push(uint8_t *power, uint8_t pixels);
+#endif
+
+#ifdef PERFORMANCE_COUNTERS
+// Returns a clock in CPU cycles, from Timer1. It only runs while the steppers do, so it times work
+// done during a cycle.
+uint32_t st_cycles();
+#endif
+
 // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
 #ifdef REPORT_REALTIME_RATE
 float st_get_realtime_rate();
@@ -0,0 +1,230 @@
+/*
+  stream.c - binary stream of pre-parsed moves and g-code lines, in checksummed frames
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef BINARY_STREAMING
+
+#if RX_BUFFER_SIZE < STREAM_LENGTH_MAX+3
+  #error "BINARY_STREAMING needs an RX buffer that holds the longest frame"
+#endif
+
+// Frame reader states
+#define STREAM_READ_SYNC 0
+#define STREAM_READ_LENGTH 1
+#define STREAM_READ_BODY 2
+
+typedef struct {
+  uint8_t open;          // Frames are expected, not lines of text
+  uint8_t sequence;      // Of the next frame expected
+  uint8_t nak_sent;      // For the frame expected, as it was out of sequence
+  uint8_t last_status;   // Of the last frame executed, to answer it again
+  uint8_t read_state;
+  uint8_t length;        // Of the frame being read, after its length byte
+  uint8_t count;         // Bytes of it read
+  uint8_t frame[STREAM_LENGTH_MAX+1]; // From the sequence number on. One more for a line's terminator.
+} stream_t;
+static stream_t stream;
+
+
+void stream_reset()
+{
+  memset(&stream, 0, sizeof(stream));
+}
+
+
+// CRC-16-CCITT, one byte at a time. Same as _crc_xmodem_update() of avr-libc.
+static uint16_t stream_crc_update(uint16_t crc, uint8_t data)
+{
+  uint8_t i;
+  crc ^= (uint16_t)data << 8;
+  for (i=0; i<8; i++) {
+    if (crc & 0x8000) { crc = (crc << 1) ^ 0x1021; }
+    else { crc <<= 1; }
+  }
+  return(crc);
+}
+
+
+static void stream_write_byte(uint8_t data, uint16_t *crc)
+{
+  serial_write(data);
+  *crc = stream_crc_update(*crc, data);
+}
+
+
+static void stream_write_frame(uint8_t sequence, uint8_t type, uint8_t *payload, uint8_t length)
+{
+  uint16_t crc = 0xFFFF;
+  serial_write(STREAM_SYNC);
+  serial_write(length+STREAM_LENGTH_MIN);
+  stream_write_byte(sequence, &crc);
+  stream_write_byte(type, &crc);
+  uint8_t idx;
+  for (idx=0; idx<length; idx++) { stream_write_byte(payload[idx], &crc); }
+  serial_write(crc & 0xff);
+  serial_write(crc >> 8);
+}
+
+
+static void stream_ack(uint8_t sequence, uint8_t status)
+{
+  uint8_t payload[3];
+  payload[0] = status;
+  payload[1] = BLOCK_BUFFER_SIZE-1-plan_get_block_buffer_count(); // Free planner blocks
+  payload[2] = RX_BUFFER_SIZE-1; // Window. Only read in answer to STREAM_TYPE_OPEN.
+  stream_write_frame(sequence, STREAM_TYPE_ACK, payload, 3);
+}
+
+
+static void stream_nak(uint8_t reason)
+{
+  stream.nak_sent = true;
+  stream_write_frame(stream.sequence, STREAM_TYPE_NAK, &reason, 1);
+}
+
+
+// Reads a G0, a G1 or a raster line from the payload and executes it.
+static uint8_t stream_execute_motion(uint8_t type, uint8_t *payload, uint8_t length)
+{
+  if (length == 0) { return(STATUS_INVALID_STATEMENT); }
+  uint8_t axes = payload[0];
+  float coord[N_AXIS];
+  float feed_rate = 0.0;
+  uint8_t idx;
+  uint8_t n = 1;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(axes,bit(idx))) {
+      if (n+sizeof(float) > length) { return(STATUS_INVALID_STATEMENT); }
+      memcpy(&coord[idx], &payload[n], sizeof(float));
+      n += sizeof(float);
+    }
+  }
+  if ((type != STREAM_TYPE_RAPID) && bit_istrue(axes,STREAM_MASK_FEED_RATE)) {
+    if (n+sizeof(float) > length) { return(STATUS_INVALID_STATEMENT); }
+    memcpy(&feed_rate, &payload[n], sizeof(float));
+    n += sizeof(float);
+  }
+  #ifdef RASTER_ENGRAVING
+    if (type == STREAM_TYPE_RASTER) {
+      if (n == length) { return(STATUS_INVALID_STATEMENT); } // No pixels
+      if (sys.state == STATE_ALARM) { return(STATUS_ALARM_LOCK); }
+      return(gc_execute_raster(axes, coord, feed_rate, &payload[n], length-n));
+    }
+  #endif
+  if (n != length) { return(STATUS_INVALID_STATEMENT); }
+  if (sys.state == STATE_ALARM) { return(STATUS_ALARM_LOCK); }
+  if (type == STREAM_TYPE_RAPID) { return(gc_execute_motion(MOTION_MODE_SEEK, axes, coord, 0.0)); }
+  return(gc_execute_motion(MOTION_MODE_LINEAR, axes, coord, feed_rate));
+}
+
+
+// Checks a frame read in full, and executes it if it is the one expected.
+static void stream_execute_frame()
+{
+  uint8_t *frame = stream.frame;
+  uint8_t length = stream.length-STREAM_LENGTH_MIN; // Of the payload
+  uint16_t crc = 0xFFFF;
+  uint8_t idx;
+  for (idx=0; idx<length+2; idx++) { crc = stream_crc_update(crc, frame[idx]); }
+  if (crc != (frame[length+2] | ((uint16_t)frame[length+3] << 8))) {
+    if (stream.open) { stream_nak(STREAM_NAK_CRC); }
+    return;
+  }
+
+  uint8_t sequence = frame[0];
+  uint8_t type = frame[1];
+  uint8_t *payload = &frame[2];
+  if (type == STREAM_TYPE_OPEN) {
+    stream.open = true;
+    stream.sequence = sequence+1;
+    stream.nak_sent = false;
+    stream.last_status = STATUS_OK;
+    stream_ack(sequence, STATUS_OK);
+    return;
+  }
+  if (!stream.open) {
+    stream_nak(STREAM_NAK_NOT_OPEN);
+    return;
+  }
+  if (sequence != stream.sequence) {
+    if (sequence == (uint8_t)(stream.sequence-1)) {
+      stream_ack(sequence, stream.last_status); // Its answer was lost. Not executed again.
+    } else if ((uint8_t)(stream.sequence-sequence) >= 128) { // Ahead. One was lost.
+      if (!stream.nak_sent) { stream_nak(STREAM_NAK_SEQUENCE); }
+    } // Else sent again after it was executed. Dropped.
+    return;
+  }
+  stream.sequence++;
+  stream.nak_sent = false;
+
+  protocol_execute_realtime(); // Runtime command check point.
+  if (sys.abort) { return; } // Bail to calling function upon system abort
+
+  uint8_t status;
+  switch (type) {
+    case STREAM_TYPE_CLOSE:
+      stream.open = false;
+      status = STATUS_OK;
+      break;
+    case STREAM_TYPE_RAPID: case STREAM_TYPE_LINEAR:
+    #ifdef RASTER_ENGRAVING
+      case STREAM_TYPE_RASTER:
+    #endif
+      status = stream_execute_motion(type, payload, length);
+      break;
+    case STREAM_TYPE_LINE:
+      payload[length] = 0; // Over the CRC, already checked.
+      status = protocol_execute_command((char *)payload);
+      break;
+    default:
+      status = STATUS_INVALID_STATEMENT;
+  }
+  stream.last_status = status;
+  stream_ack(sequence, status);
+}
+
+
+uint8_t stream_read(uint8_t data)
+{
+  switch (stream.read_state) {
+    case STREAM_READ_SYNC:
+      if (data == STREAM_SYNC) { stream.read_state = STREAM_READ_LENGTH; }
+      else { return(stream.open); } // Text, unless open. Then dropped.
+      break;
+    case STREAM_READ_LENGTH:
+      if ((data < STREAM_LENGTH_MIN) || (data > STREAM_LENGTH_MAX)) {
+        stream.read_state = STREAM_READ_SYNC;
+        if (stream.open) { stream_nak(STREAM_NAK_FORMAT); }
+      } else {
+        stream.length = data;
+        stream.count = 0;
+        stream.read_state = STREAM_READ_BODY;
+      }
+      break;
+    default: // STREAM_READ_BODY
+      stream.frame[stream.count++] = data;
+      if (stream.count == stream.length) {
+        stream.read_state = STREAM_READ_SYNC;
+        stream_execute_frame();
+      }
+  }
+  return(true);
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+  stream.h - binary stream of pre-parsed moves and g-code lines, in checksummed frames
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef stream_h
+#define stream_h
+
+/* Frames, both ways:
+
+     STREAM_SYNC, length, sequence, type, payload..., CRC low byte, CRC high byte
+
+   The length counts the bytes after it. The CRC is CRC-16-CCITT (polynomial 0x1021, preset 0xFFFF)
+   of the sequence number, type and payload. Floats are IEEE 754 single precision, little endian,
+   as the AVR keeps them.
+
+   The host opens the stream with STREAM_TYPE_OPEN, at any sequence number, and numbers each frame
+   after it by one more, modulo 256. Grbl executes frames in sequence, and answers each with
+   STREAM_TYPE_ACK once it has executed it: a move is then in the planner. Frames not yet answered
+   wait in the RX buffer, so the host may have as many bytes of frames in flight as the window the
+   answer to STREAM_TYPE_OPEN gives. Upon a damaged frame, or one out of sequence, Grbl answers
+   STREAM_TYPE_NAK with the sequence number it expects, drops frames until that one comes, and
+   the host sends all frames again from it. A frame sent again after it was executed is dropped,
+   and the last one answered again. While the stream is open, bytes between frames are dropped,
+   except realtime commands. */
+
+#define STREAM_SYNC 0xA5
+#define STREAM_PAYLOAD_MAX (LINE_BUFFER_SIZE-1)
+#define STREAM_LENGTH_MIN 4 // Sequence, type and CRC
+#define STREAM_LENGTH_MAX (STREAM_LENGTH_MIN+STREAM_PAYLOAD_MAX)
+
+// Host to Grbl
+#define STREAM_TYPE_OPEN   0x01 // No payload. Starts the stream at this sequence number.
+#define STREAM_TYPE_CLOSE  0x02 // No payload. Back to lines of g-code text.
+#define STREAM_TYPE_RAPID  0x10 // G0. Axis mask, then a float for each axis in it: the absolute end point
+                                //   in mm, in the work coordinate system. Other axes stay.
+#define STREAM_TYPE_LINEAR 0x11 // G1. As STREAM_TYPE_RAPID, then the feed rate in mm/min if bit 7 of the
+                                //   mask is set. Always units per minute.
+#define STREAM_TYPE_RASTER 0x12 // G1 along a raster line, with RASTER_ENGRAVING. As STREAM_TYPE_LINEAR, then
+                                //   the power of each pixel along it, 0-255, one byte each, one at least.
+                                //   The pixels are spread evenly over the line. Planned as a plain G1
+                                //   while the spindle is off.
+#define STREAM_TYPE_LINE   0x20 // A line of g-code or a '$' command, upper case, without spaces, comments
+                                //   or newline, as the main loop leaves a line of text.
+
+// Grbl to host
+#define STREAM_TYPE_ACK    0x80 // Status code, as the error codes of report.c, and free planner blocks.
+                                //   Answering STREAM_TYPE_OPEN, also the window in bytes.
+#define STREAM_TYPE_NAK    0x81 // Reason. The sequence number is the one expected.
+
+#define STREAM_MASK_FEED_RATE bit(7)
+
+// NAK reasons
+#define STREAM_NAK_CRC 1
+#define STREAM_NAK_SEQUENCE 2
+#define STREAM_NAK_FORMAT 3     // Bad length. A bad type or payload is answered with an error status.
+#define STREAM_NAK_NOT_OPEN 4
+
+
+// Closes the stream and drops any frame begun. Called at startup and reset.
+void stream_reset();
+
+// Takes a byte read by the main loop, between lines of text. Returns true if it was part of a frame,
+// or dropped between frames. A frame is executed once all of it is in.
+uint8_t stream_read(uint8_t data);
+
+#endif
@@ -160,6 +160,13 @@ uint8_t system_execute_line(char *line)
 //       break;
       }
       break;
+    #ifdef PERFORMANCE_COUNTERS
+      case 'P' : // Print or clear performance counters. Any time, to profile a running job.
+        if ( line[char_counter+1] == 0 ) { report_performance(); }
+        else if ( (line[char_counter+1] == 'R') && (line[char_counter+2] == 0) ) { perf_reset(); }
+        else { return(STATUS_INVALID_STATEMENT); }
+        break;
+    #endif
     default : 
       // Block any system command that requires the state as IDLE/ALARM. (i.e. EEPROM, homing)
       if ( !(sys.state == STATE_IDLE || sys.state == STATE_ALARM) ) { return(STATUS_IDLE_ERROR); }
@@ -171,6 +171,31 @@ public:
 
 
 
+	/** Fills a block with successive levels of the ADSR, the same as calling next() num_samples times.
+	Call this in updateAudioBlock(), see AUDIO_BLOCK_SIZE.
+	@param out where to write the levels.
+	@param num_samples how many levels to write.
+	 */
+	inline
+	void nextBlock(unsigned char * out, size_t num_samples)
+	{
+		if (!adsr_playing) {
+			for (size_t i = 0; i < num_samples; ++i) out[i] = 0;
+			return;
+		}
+		// interpolate in short chunks, to keep the Q15n16 scratch space small
+		Q15n16 levels[16];
+		while (num_samples) {
+			size_t n = (num_samples < 16) ? num_samples : 16;
+			transition.nextBlock(levels, n);
+			for (size_t i = 0; i < n; ++i) out[i] = Q15n16_to_Q8n0(levels[i]);
+			out += n;
+			num_samples -= n;
+		}
+	}
+
+
+
 	/** Start the attack phase of the ADSR.  This will restart the ADSR no matter what phase it is up to.
 	@param reset If true, the envelope will start from 0, even if it is still playing (often useful for effect envelopes).
 	If false (default if omitted), the envelope will start rising from the current level, which could be non-zero, if
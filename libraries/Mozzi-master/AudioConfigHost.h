@@ -0,0 +1,16 @@
+#ifndef AUDIOCONFIGHOST_H
+#define AUDIOCONFIGHOST_H
+
+#if not IS_HOST()
+#error This header should be included for the host renderer, only
+#endif
+
+/* The host renderer writes 16 bit WAV files, so give the sketch the full 16 bits */
+#define AUDIO_BITS 16
+
+/** @ingroup core
+*/
+/* Used internally to put the 0-biased generated audio into the centre of the output range (16 bits) */
+#define AUDIO_BIAS ((uint16_t) 1 << (AUDIO_BITS - 1))
+
+#endif        //  #ifndef AUDIOCONFIGHOST_H
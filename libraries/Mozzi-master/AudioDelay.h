@@ -87,6 +87,27 @@ public:
 	}
 
 	
+	/** Input a block of values to the delay and retrieve the delayed signal, the same as calling next(in_value) on each of them.
+	Uses the delay time set with set() or the constructor.
+	@param in the signal input.
+	@param out the delayed signal output.  This can be the same as in.
+	@param num_samples how many samples to process.
+	*/
+	inline
+	void nextBlock(const T * in, T * out, size_t num_samples)
+	{
+		unsigned int write_pos = _write_pos;
+		const unsigned int delaytime_cells = _delaytime_cells;
+		for (size_t i = 0; i < num_samples; ++i) {
+			++write_pos &= (NUM_BUFFER_SAMPLES - 1);
+			T in_value = in[i];
+			delay_array[write_pos] = in_value;
+			out[i] = delay_array[(write_pos - delaytime_cells) & (NUM_BUFFER_SAMPLES - 1)];
+		}
+		_write_pos = write_pos;
+	}
+
+
 	/** Set the delay time, measured in cells.
 	@param delaytime_cells how many cells to delay the input signal by.
 	*/
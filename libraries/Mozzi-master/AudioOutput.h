@@ -231,6 +231,13 @@ inline void audioOutput(const AudioOutput f)
 #endif
 
 
+///////////////////// HOST
+#if IS_HOST()
+#include "AudioConfigHost.h"
+// audioOutput() is implemented by the host renderer, see extras/host
+#endif
+
+
 ///////////////////// TEENSY3
 #if IS_TEENSY3()
 #include "AudioConfigTeensy3_12bit.h"
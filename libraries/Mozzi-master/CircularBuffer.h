@@ -1,75 +1,178 @@
 /*
-Modified from https://en.wikipedia.org/wiki/Circular_buffer
-Mirroring version
-On 18 April 2014, the simplified version on the Wikipedia page for power of 2 sized buffers 
-doesn't work - cbIsEmpty() returns true whether the buffer is full or empty.
+Single producer, single consumer ring buffer, for passing samples between
+audioHook() and the audio interrupt without turning interrupts off.
+
+Each index is only ever written by one side: end by the writer, start by the
+reader.  One cell is always left empty, so start == end can only mean empty, and
+the buffer holds NUM_ITEMS-1 items.  The indices are bytes for sizes up to 256,
+so they are read and written in one go even on AVR.
+
+(This replaces the "mirroring" version modified from https://en.wikipedia.org/wiki/Circular_buffer,
+which was fixed at 256 cells.)
 */
 
-/** Circular buffer object.  Has a fixed number of cells, set to 256.
+#ifndef CIRCULARBUFFER_H_
+#define CIRCULARBUFFER_H_
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+// the smallest index type that covers NUM_ITEMS cells, see CircularBuffer
+template <bool FITS_IN_A_BYTE>
+struct CircularBufferIndex
+{
+	typedef unsigned int type;
+};
+
+template <>
+struct CircularBufferIndex<true>
+{
+	typedef uint8_t type;
+};
+
+/** Circular buffer object.
 @tparam ITEM_TYPE the kind of data to store, eg. int, int8_t etc.
+@tparam NUM_ITEMS the number of cells, a power of two.  One is always kept free, so the buffer holds NUM_ITEMS-1 items.
 */
-template <class ITEM_TYPE>
+template <class ITEM_TYPE, unsigned int NUM_ITEMS = 256>
 class CircularBuffer
 {
+	static_assert(NUM_ITEMS >= 2 && (NUM_ITEMS & (NUM_ITEMS - 1)) == 0, "CircularBuffer size must be a power of two");
+
+	typedef typename CircularBufferIndex<(NUM_ITEMS <= 256)>::type index_t;
 
 public:
 	/** Constructor
 	*/
-	CircularBuffer(): start(0),end(0),s_msb(0),e_msb(0)
+	CircularBuffer(): start(0),end(0),num_buffers_read(0),num_underruns(0),low_watermark(NUM_ITEMS - 1),high_watermark(0),started(false)
 	{
 	}
 
 	inline
 	bool isFull() {
-		return end == start && e_msb != s_msb;
+		return ((end + 1) & MASK) == start;
 	}
 
 	inline
 	bool isEmpty() {
-		return end == start && e_msb == s_msb;
+		return end == start;
 	}
 
+	/** Number of items waiting to be read. */
+	inline
+	unsigned int available() {
+		return (index_t) (end - start) & MASK;
+	}
+
+	/** Write an item.  Only call this from the writing side, after checking isFull(). */
 	inline
 	void write(ITEM_TYPE in) {
-		items[end] = in;
-		//if (isFull()) cbIncrStart(); /* full, overwrite moves start pointer */
-		cbIncrEnd();
+		const index_t e = end;
+		items[e] = in;
+		compilerBarrier(); // the item has to be in place before the reader can see the new end
+		end = (e + 1) & MASK;
+		started = true;
+		const unsigned int fill = (index_t) (e + 1 - start) & MASK;
+		if (fill > high_watermark) high_watermark = fill;
 	}
 
+	/** Read the oldest item.  Only call this from the reading side.  If the buffer is empty,
+	this returns the last item read again, rather than going past end, and counts an underrun
+	(unless nothing has been written yet). */
 	inline
 	ITEM_TYPE read() {
-		ITEM_TYPE out = items[start];
-		cbIncrStart();
+		const index_t s = start;
+		if (s == end) {
+			// nothing written yet is start up, not an underrun
+			if (started) {
+				++num_underruns;
+				low_watermark = 0;
+			}
+			return items[(s - 1) & MASK];
+		}
+		ITEM_TYPE out = items[s];
+		compilerBarrier(); // finish reading the item before the writer can reuse its cell
+		const index_t next_start = (s + 1) & MASK;
+		start = next_start;
+		if (next_start == 0) num_buffers_read++;
+		const unsigned int fill = (index_t) (end - s - 1) & MASK;
+		if (fill < low_watermark) low_watermark = fill;
 		return out;
 	}
 
+	/** Number of items read since the buffer was made.  Call this from the writing side; on AVR
+	the audio interrupt is held off while the multi-byte count is read. */
 	inline
 	unsigned long count() {
-		return (num_buffers_read << 8) + start;
+		unsigned long n;
+#if defined(__AVR__)
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#endif
+		{
+			n = (num_buffers_read * NUM_ITEMS) + start;
+		}
+		return n;
 	}
 
-private:
-	ITEM_TYPE items[256];
-	uint8_t         start;  /* index of oldest itement              */
-	uint8_t         end;    /* index at which to write new itement  */
-	uint8_t         s_msb;
-	uint8_t         e_msb;
-	unsigned long num_buffers_read;
+	/** Number of times read() was called on an empty buffer.  Call this from the writing side, as
+	count(). */
+	inline
+	unsigned long underruns() {
+		unsigned long n;
+#if defined(__AVR__)
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#endif
+		{
+			n = num_underruns;
+		}
+		return n;
+	}
 
+	/** The fewest items there have been left in the buffer after a read, since the last resetWatermarks().
+	Close to 0 means the writer is only just keeping up. */
+	inline
+	unsigned int lowWatermark() {
+		return low_watermark;
+	}
 
+	/** The most items there have been in the buffer after a write, since the last resetWatermarks(). */
 	inline
-	void cbIncrStart() {
-		start++;
-		if (start == 0) {
-			s_msb ^= 1;
-			num_buffers_read++;
-		}
+	unsigned int highWatermark() {
+		return high_watermark;
 	}
 
+	/** Start measuring the watermarks (and counting underruns) again from now, with both
+	watermarks at the number of items in the buffer.  Call this from the writing side; on AVR
+	the audio interrupt is held off while the multi-byte counter is cleared. */
 	inline
-	void cbIncrEnd() {
-		end++;
-		if (end == 0) e_msb ^= 1;
+	void resetWatermarks() {
+#if defined(__AVR__)
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#endif
+		{
+			const index_t fill = available();
+			low_watermark = fill;
+			high_watermark = fill;
+			num_underruns = 0;
+		}
 	}
 
+private:
+	static const index_t MASK = NUM_ITEMS - 1;
+
+	ITEM_TYPE items[NUM_ITEMS];
+	volatile index_t start;  /* index of oldest item, only written by the reader */
+	volatile index_t end;    /* index at which to write the next item, only written by the writer */
+	volatile unsigned long num_buffers_read; /* only written by the reader */
+	volatile unsigned long num_underruns;    /* only written by the reader, and by resetWatermarks() */
+	volatile index_t low_watermark;
+	volatile index_t high_watermark;
+	volatile bool started; /* something has been written, so reading an empty buffer is an underrun */
+
+	static inline void compilerBarrier() {
+		__asm__ __volatile__ ("" ::: "memory");
+	}
 };
+
+#endif /* CIRCULARBUFFER_H_ */
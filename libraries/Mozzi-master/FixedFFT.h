@@ -0,0 +1,194 @@
+/*
+ * FixedFFT.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef FIXEDFFT_H_
+#define FIXEDFFT_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+#include "tables/fft_twiddle1024_int16.h"
+
+/** @ingroup sensortools
+An in-place fixed point Fast Fourier Transform, for finding out what frequencies there are in a signal,
+without any floating point maths.
+
+Put the signal in real() (and imag(), usually zeros), call window() if you want a Hann window,
+then transform().  Afterwards, bin k of real() and imag() holds frequency k*AUDIO_RATE/NUM_POINTS
+(if the input was at AUDIO_RATE), up to bin NUM_POINTS/2; for a real signal, the bins above that
+mirror the ones below.  SpectrumAnalyser wraps this up for audio input.
+
+The transform works in Q15: radix-4 butterflies, with one radix-2 stage at the end when NUM_POINTS
+is not a power of four.  The twiddle factors come from a quarter sine table in tables/fft_twiddle1024_int16.h.
+Each butterfly scales its output down, so the results are the true transform divided by NUM_POINTS,
+and nothing can overflow as long as the inputs stay within -16384 to 16383.
+
+@tparam NUM_POINTS the size of the transform, a power of two from 4 to 1024.
+The data takes 4*NUM_POINTS bytes of RAM, so on AVR stay with 64 or 128.
+@note Timing: extras/host/bench/mozzi_bench gives cycle counts for each size on the host.
+*/
+template <unsigned int NUM_POINTS>
+class FixedFFT
+{
+	static_assert(NUM_POINTS >= 4 && NUM_POINTS <= FFT_TWIDDLE1024_PERIOD && (NUM_POINTS & (NUM_POINTS - 1)) == 0,
+	              "FixedFFT size must be a power of two from 4 to 1024");
+
+public:
+	/** The real parts, in and out. */
+	inline
+	int16_t * real() { return re; }
+
+	/** The imaginary parts, in and out.  Set them to 0 for a real signal. */
+	inline
+	int16_t * imag() { return im; }
+
+
+	/** Multiply the input by a Hann window, to cut the leakage between bins you get from chopping
+	a continuous signal into blocks.  Call this before transform(). */
+	void window()
+	{
+		for (unsigned int n = 0; n < NUM_POINTS; ++n) {
+			// (1 - cos(2 pi n / NUM_POINTS)) / 2, in Q15
+			const int16_t w = (int16_t) ((32767 - cosine(n * (FFT_TWIDDLE1024_PERIOD / NUM_POINTS))) >> 1);
+			re[n] = (int16_t) (((int32_t) re[n] * w) >> 15);
+			im[n] = (int16_t) (((int32_t) im[n] * w) >> 15);
+		}
+	}
+
+
+	/** Transform real() and imag() in place, from time to frequency.  See the class description for scaling. */
+	void transform()
+	{
+		unsigned int size = NUM_POINTS;
+		for (; size >= 4; size >>= 2) {
+			const unsigned int quarter = size >> 2;
+			const unsigned int stride = FFT_TWIDDLE1024_PERIOD / size;
+			for (unsigned int j = 0; j < quarter; ++j) {
+				// W = exp(-2 pi i j / size), and W^2, W^3
+				const unsigned int k = j * stride;
+				const int16_t w1r = cosine(k), w1s = sine(k);
+				const int16_t w2r = cosine(2 * k), w2s = sine(2 * k);
+				const int16_t w3r = cosine(3 * k), w3s = sine(3 * k);
+				for (unsigned int i0 = j; i0 < NUM_POINTS; i0 += size) {
+					const unsigned int i1 = i0 + quarter, i2 = i1 + quarter, i3 = i2 + quarter;
+					const int32_t s02r = (int32_t) re[i0] + re[i2], s02i = (int32_t) im[i0] + im[i2];
+					const int32_t d02r = (int32_t) re[i0] - re[i2], d02i = (int32_t) im[i0] - im[i2];
+					const int32_t s13r = (int32_t) re[i1] + re[i3], s13i = (int32_t) im[i1] + im[i3];
+					const int32_t d13r = (int32_t) re[i1] - re[i3], d13i = (int32_t) im[i1] - im[i3];
+
+					// outputs go in bit reversed order, like two radix-2 stages
+					re[i0] = (int16_t) ((s02r + s13r) >> 2);
+					im[i0] = (int16_t) ((s02i + s13i) >> 2);
+					rotate(re[i1], im[i1], (s02r - s13r) >> 2, (s02i - s13i) >> 2, w2r, w2s);
+					rotate(re[i2], im[i2], (d02r + d13i) >> 2, (d02i - d13r) >> 2, w1r, w1s);
+					rotate(re[i3], im[i3], (d02r - d13i) >> 2, (d02i + d13r) >> 2, w3r, w3s);
+				}
+			}
+		}
+		if (size == 2) {
+			for (unsigned int i = 0; i < NUM_POINTS; i += 2) {
+				const int16_t ar = re[i], ai = im[i];
+				re[i] = (int16_t) (((int32_t) ar + re[i + 1]) >> 1);
+				im[i] = (int16_t) (((int32_t) ai + im[i + 1]) >> 1);
+				re[i + 1] = (int16_t) (((int32_t) ar - re[i + 1]) >> 1);
+				im[i + 1] = (int16_t) (((int32_t) ai - im[i + 1]) >> 1);
+			}
+		}
+		bitReverse();
+	}
+
+
+	/** The power in a bin after transform(), re*re + im*im.
+	@param bin from 0 to NUM_POINTS-1.
+	*/
+	inline
+	uint32_t power(unsigned int bin)
+	{
+		return (uint32_t) ((int32_t) re[bin] * re[bin]) + (uint32_t) ((int32_t) im[bin] * im[bin]);
+	}
+
+
+	/** The magnitude of a bin after transform(), the square root of power().
+	@param bin from 0 to NUM_POINTS-1.
+	*/
+	uint16_t magnitude(unsigned int bin)
+	{
+		uint32_t n = power(bin);
+		uint32_t root = 0;
+		uint32_t b = 1UL << 30;
+		while (b > n) b >>= 2;
+		while (b) {
+			if (n >= root + b) {
+				n -= root + b;
+				root = (root >> 1) + b;
+			} else {
+				root >>= 1;
+			}
+			b >>= 2;
+		}
+		return (uint16_t) root;
+	}
+
+private:
+	int16_t re[NUM_POINTS];
+	int16_t im[NUM_POINTS];
+
+	// sin(2 pi k / FFT_TWIDDLE1024_PERIOD) from the quarter wave table
+	static inline
+	int16_t sine(unsigned int k)
+	{
+		const unsigned int quarter = FFT_TWIDDLE1024_PERIOD / 4;
+		k &= FFT_TWIDDLE1024_PERIOD - 1;
+		const unsigned int i = k & (quarter - 1);
+		switch (k / quarter) {
+		case 0: return FLASH_OR_RAM_READ<const int16_t>(FFT_TWIDDLE1024_DATA + i);
+		case 1: return FLASH_OR_RAM_READ<const int16_t>(FFT_TWIDDLE1024_DATA + quarter - i);
+		case 2: return -FLASH_OR_RAM_READ<const int16_t>(FFT_TWIDDLE1024_DATA + i);
+		default: return -FLASH_OR_RAM_READ<const int16_t>(FFT_TWIDDLE1024_DATA + quarter - i);
+		}
+	}
+
+	static inline
+	int16_t cosine(unsigned int k)
+	{
+		return sine(k + FFT_TWIDDLE1024_PERIOD / 4);
+	}
+
+	// (xr + i xi) * (wr - i ws), where wr - i ws is the twiddle exp(-i theta).
+	// All 16 bit operands, so AVR can use its 16x16 bit multiply.
+	static inline
+	void rotate(int16_t & out_r, int16_t & out_i, int16_t xr, int16_t xi, int16_t wr, int16_t ws)
+	{
+		out_r = (int16_t) (((int32_t) xr * wr + (int32_t) xi * ws) >> 15);
+		out_i = (int16_t) (((int32_t) xi * wr - (int32_t) xr * ws) >> 15);
+	}
+
+	// put the bins back in order after transform()
+	void bitReverse()
+	{
+		unsigned int j = 0;
+		for (unsigned int i = 0; i < NUM_POINTS - 1; ++i) {
+			if (i < j) {
+				int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+				t = im[i]; im[i] = im[j]; im[j] = t;
+			}
+			unsigned int k = NUM_POINTS >> 1;
+			while (k <= j) {
+				j -= k;
+				k >>= 1;
+			}
+			j += k;
+		}
+	}
+};
+
+#endif /* FIXEDFFT_H_ */
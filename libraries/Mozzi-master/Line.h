@@ -64,6 +64,25 @@ public:
 
 
 
+	/** Fills a block with successive steps along the line, the same as calling next() num_steps times,
+	but only touching the volatile state once.
+	@param out where to write the values.
+	@param num_steps how many steps to take.
+	 */
+	inline
+	void nextBlock(T * out, size_t num_steps)
+	{
+		T value = current_value;
+		const T step = step_size;
+		for (size_t i = 0; i < num_steps; ++i) {
+			value += step;
+			out[i] = value;
+		}
+		current_value = value;
+	}
+
+
+
 	/** Set the current value of the line. 
 	The Line will continue incrementing from this
 	value using any previously calculated step size.
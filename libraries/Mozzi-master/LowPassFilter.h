@@ -96,6 +96,27 @@ public:
     return buf1;
   }
 
+  /** Filter a block of samples, the same as calling next() on each of them.
+  The filter state is kept in locals for the whole block.
+  @param in the signal input.
+  @param out the signal output.  This can be the same as in, to filter in place.
+  @param num_samples how many samples to filter.
+  */
+  inline void nextBlock(const int * in, int * out, size_t num_samples)
+	{
+    int b0 = buf0;
+    int b1 = buf1;
+    const uint8_t _f = f;
+    const unsigned int _fb = fb;
+    for (size_t i = 0; i < num_samples; ++i) {
+      b0 += fxmul(((in[i] - b0) + fxmul(_fb, b0 - b1)), _f);
+      b1 += ifxmul(b0 - b1, _f);
+      out[i] = b1;
+    }
+    buf0 = b0;
+    buf1 = b1;
+  }
+
 private:
   uint8_t q;
   uint8_t f;
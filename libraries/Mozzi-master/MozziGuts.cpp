@@ -86,9 +86,9 @@ uint64_t samples_written_to_buffer = 0;
 //-----------------------------------------------------------------------------------------------------------------
 // ring buffer for audio output
 #if (STEREO_HACK == true)
-CircularBuffer<StereoOutput> output_buffer;  // fixed size 256
+CircularBuffer<StereoOutput, AUDIO_OUTPUT_BUFFER_SIZE> output_buffer;
 #else
-CircularBuffer<AudioOutput_t> output_buffer;  // fixed size 256
+CircularBuffer<AudioOutput_t, AUDIO_OUTPUT_BUFFER_SIZE> output_buffer;
 #endif
 //-----------------------------------------------------------------------------------------------------------------
 #endif
@@ -141,14 +141,14 @@ static uint8_t mozzi_TCCR4A, mozzi_TCCR4B, mozzi_TCCR4C, mozzi_TCCR4D,
 #if (USE_AUDIO_INPUT == true)
 
 // ring buffer for audio input
-CircularBuffer<unsigned int> input_buffer; // fixed size 256
+CircularBuffer<unsigned int, AUDIO_INPUT_BUFFER_SIZE> input_buffer;
 
-static boolean audio_input_is_available;
 static int audio_input; // holds the latest audio from input_buffer
 uint8_t adc_count = 0;
 
 int getAudioInput() { return audio_input; }
 
+#if !IS_HOST()
 static void startFirstAudioADC() {
 #if IS_TEENSY3()
   adc->startSingleRead(
@@ -161,6 +161,7 @@ static void startFirstAudioADC() {
   adcStartConversion(adcPinToChannelNum(AUDIO_INPUT_PIN));
 #endif
 }
+#endif
 
 /*
 static void receiveFirstAudioADC()
@@ -176,11 +177,16 @@ static void startSecondAudioADC() {
   uint8_t dummy = AUDIO_INPUT_PIN;
   adc.setPins(&dummy, 1);
   adc.startConversion();
+#elif IS_HOST()
+  // conversions are immediate on the host, so the sample goes straight in
+  if (!input_buffer.isFull())
+    input_buffer.write(analogRead(AUDIO_INPUT_PIN));
 #else
   ADCSRA |= (1 << ADSC); // start a second conversion on the current channel
 #endif
 }
 
+#if !IS_HOST()
 static void receiveSecondAudioADC() {
   if (!input_buffer.isFull())
 #if IS_TEENSY3()
@@ -191,6 +197,7 @@ static void receiveSecondAudioADC() {
     input_buffer.write(ADC);
 #endif
 }
+#endif
 
 #if IS_TEENSY3() || IS_STM32() || IS_AVR()
 #if IS_TEENSY3()
@@ -322,6 +329,30 @@ inline void advanceControlLoop() {
   }
 }
 
+#if defined(AUDIO_BLOCK_SIZE)
+static AudioOutput_t audio_block[AUDIO_BLOCK_SIZE];
+static uint16_t audio_block_pos = AUDIO_BLOCK_SIZE;
+
+// Fills audio_block with calls to updateAudioBlock(), splitting it wherever a
+// control step falls so updateControl() still runs at CONTROL_RATE.
+static void renderAudioBlock() {
+  uint16_t done = 0;
+  while (done < AUDIO_BLOCK_SIZE) {
+    if (!update_control_counter) {
+      update_control_counter = update_control_timeout;
+      updateControl();
+      adcStartReadCycle();
+    }
+    uint16_t n = AUDIO_BLOCK_SIZE - done;
+    if (n > update_control_counter) n = update_control_counter;
+    updateAudioBlock(audio_block + done, n);
+    update_control_counter -= n;
+    done += n;
+  }
+  audio_block_pos = 0;
+}
+#endif
+
 void audioHook() // 2us on AVR excluding updateAudio()
 {
 // setPin13High();
@@ -330,6 +361,17 @@ void audioHook() // 2us on AVR excluding updateAudio()
     audio_input = input_buffer.read();
 #endif
 
+#if defined(AUDIO_BLOCK_SIZE)
+  // hand out samples from the current block for as long as there is room,
+  // rendering the next block whenever this one runs out
+  while (canBufferAudioOutput()) {
+    if (audio_block_pos == AUDIO_BLOCK_SIZE) renderAudioBlock();
+    bufferAudioOutput(audio_block[audio_block_pos++]);
+  }
+#if IS_ESP8266()
+  yield();
+#endif
+#else
   if (canBufferAudioOutput()) {
     advanceControlLoop();
 #if (STEREO_HACK == true)
@@ -343,6 +385,7 @@ void audioHook() // 2us on AVR excluding updateAudio()
     yield();
 #endif
   }
+#endif
   // setPin13Low();
 }
 
@@ -361,6 +404,17 @@ static void CACHED_FUNCTION_ATTR defaultAudioOutput() {
 }
 #endif
 
+#if IS_HOST()
+/* There is no audio timer on the host. The host renderer (see extras/host) calls this
+instead, to take the next sample out of the output buffer, whenever it wants one.
+Returns false if the buffer is empty. */
+bool hostAudioOutputTick() {
+  if (output_buffer.isEmpty()) return false;
+  defaultAudioOutput();
+  return true;
+}
+#endif
+
 #if (AUDIO_MODE == STANDARD) || (AUDIO_MODE == STANDARD_PLUS) || IS_STM32()
 #if IS_TEENSY3()
 IntervalTimer timer1;
@@ -714,6 +768,7 @@ void stopMozzi() {
 #endif
 #elif IS_SAMD21()
 #elif IS_ESP32()
+#elif IS_HOST()
 #else
 
   noInterrupts();
@@ -767,6 +822,18 @@ unsigned long audioTicks() {
 
 unsigned long mozziMicros() { return audioTicks() * MICROS_PER_AUDIO_TICK; }
 
+#if (BYPASS_MOZZI_OUTPUT_BUFFER != true)
+unsigned long audioOutputUnderruns() { return output_buffer.underruns(); }
+unsigned int audioOutputBufferLowWatermark() { return output_buffer.lowWatermark(); }
+unsigned int audioOutputBufferHighWatermark() { return output_buffer.highWatermark(); }
+void resetAudioOutputBufferStats() { output_buffer.resetWatermarks(); }
+#else
+unsigned long audioOutputUnderruns() { return 0; }
+unsigned int audioOutputBufferLowWatermark() { return 0; }
+unsigned int audioOutputBufferHighWatermark() { return 0; }
+void resetAudioOutputBufferStats() {}
+#endif
+
 // Unmodified TimerOne.cpp has TIMER3_OVF_vect.
 // Watch out if you update the library file.
 // The symptom will be no sound.
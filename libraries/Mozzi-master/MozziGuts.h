@@ -199,6 +199,8 @@ HIFI is not available/not required on Teensy 3.* or ARM.
 #include "AudioConfigESP32.h"
 #elif IS_SAMD21()
 #include "AudioConfigSAMD21.h"
+#elif IS_HOST()
+#include "AudioConfigHost.h"
 #elif IS_AVR() && (AUDIO_MODE == STANDARD)
 #include "AudioConfigStandard9bitPwm.h"
 #elif IS_AVR() && (AUDIO_MODE == STANDARD_PLUS)
@@ -218,6 +220,28 @@ HIFI is not available/not required on Teensy 3.* or ARM.
 extern int audio_out_1, audio_out_2;
 #endif
 
+#if defined(AUDIO_BLOCK_SIZE)
+#if (STEREO_HACK == true)
+#error AUDIO_BLOCK_SIZE does not work with STEREO_HACK, use AUDIO_CHANNELS STEREO instead
+#endif
+#if (AUDIO_BLOCK_SIZE < 1) || (AUDIO_BLOCK_SIZE > 256) || (AUDIO_BLOCK_SIZE & (AUDIO_BLOCK_SIZE - 1))
+#error AUDIO_BLOCK_SIZE must be a power of two, no larger than 256
+#endif
+#endif
+
+#if !defined(AUDIO_OUTPUT_BUFFER_SIZE)
+#define AUDIO_OUTPUT_BUFFER_SIZE 256
+#endif
+#if !defined(AUDIO_INPUT_BUFFER_SIZE)
+#define AUDIO_INPUT_BUFFER_SIZE 256
+#endif
+#if (AUDIO_OUTPUT_BUFFER_SIZE < 2) || (AUDIO_OUTPUT_BUFFER_SIZE & (AUDIO_OUTPUT_BUFFER_SIZE - 1)) || (AUDIO_INPUT_BUFFER_SIZE < 2) || (AUDIO_INPUT_BUFFER_SIZE & (AUDIO_INPUT_BUFFER_SIZE - 1))
+#error AUDIO_OUTPUT_BUFFER_SIZE and AUDIO_INPUT_BUFFER_SIZE must be powers of two
+#endif
+#if IS_AVR() && ((AUDIO_OUTPUT_BUFFER_SIZE > 256) || (AUDIO_INPUT_BUFFER_SIZE > 256))
+#error On AVR, AUDIO_OUTPUT_BUFFER_SIZE and AUDIO_INPUT_BUFFER_SIZE can be at most 256
+#endif
+
 #include "AudioOutput.h"
 
 // common numeric types
@@ -309,6 +333,17 @@ In HIFI mode, it's a 14 bit number between -16384 and 16383 inclusive.
 */
 AudioOutput_t updateAudio();
 
+#if defined(AUDIO_BLOCK_SIZE)
+/** @ingroup core
+The block based alternative to updateAudio(), used when \#define AUDIO_BLOCK_SIZE is set in Mozzi/mozzi_config.h.
+Fill out[0] to out[num_samples-1] with audio samples.  num_samples is at most AUDIO_BLOCK_SIZE, and never spans
+a control step, so values set in updateControl() hold for the whole block.
+@param out where to write the audio samples.
+@param num_samples how many samples to write.
+*/
+void updateAudioBlock(AudioOutput_t * out, size_t num_samples);
+#endif
+
 /** @ingroup core
 This is where you put your control code. You need updateControl() somewhere in
 your sketch, even if it's empty. updateControl() is called at the control rate
@@ -358,7 +393,7 @@ int getAudioInput();
 /** @ingroup core
 An alternative for Arduino time functions like micros() and millis(). This is slightly faster than micros(),
 and also it is synchronized with the currently processed audio sample (which, due to the audio
-output buffer, could diverge up to 256/AUDIO_RATE seconds from the current time).
+output buffer, could diverge up to AUDIO_OUTPUT_BUFFER_SIZE/AUDIO_RATE seconds from the current time).
 audioTicks() is updated each time an audio sample
 is output, so the resolution is 1/AUDIO_RATE microseconds (61 microseconds when AUDIO_RATE is
 16384 Hz).
@@ -371,7 +406,7 @@ unsigned long audioTicks();
 /** @ingroup core
 An alternative for Arduino time functions like micros() and millis(). This is slightly faster than micros(),
 and also it is synchronized with the currently processed audio sample (which, due to the audio
-output buffer, could diverge up to 256/AUDIO_RATE seconds from the current time).
+output buffer, could diverge up to AUDIO_OUTPUT_BUFFER_SIZE/AUDIO_RATE seconds from the current time).
 audioTicks() is updated each time an audio sample
 is output, so the resolution is 1/AUDIO_RATE microseconds (61 microseconds when AUDIO_RATE is
 16384 Hz).
@@ -381,6 +416,37 @@ is output, so the resolution is 1/AUDIO_RATE microseconds (61 microseconds when
 unsigned long mozziMicros();
 
 
+/** @ingroup core
+How many times the audio output found the output buffer empty, since startMozzi() or the last
+resetAudioOutputBufferStats().  Each underrun repeats the previous sample, and is heard as a glitch.
+If this goes up, something is keeping loop() from calling audioHook() often enough, or updateAudio()
+is too slow.  Always 0 with BYPASS_MOZZI_OUTPUT_BUFFER.
+*/
+unsigned long audioOutputUnderruns();
+
+
+/** @ingroup core
+The fewest samples there have been waiting in the output buffer, since startMozzi() or the last
+resetAudioOutputBufferStats().  If this stays well above 0, you could make AUDIO_OUTPUT_BUFFER_SIZE
+smaller, for less latency.  If it reaches 0, expect underruns.
+*/
+unsigned int audioOutputBufferLowWatermark();
+
+
+/** @ingroup core
+The most samples there have been waiting in the output buffer, since startMozzi() or the last
+resetAudioOutputBufferStats().  This is normally AUDIO_OUTPUT_BUFFER_SIZE-1, as audioHook() keeps the buffer full.
+*/
+unsigned int audioOutputBufferHighWatermark();
+
+
+/** @ingroup core
+Clears the underrun count and sets both watermarks to what is in the buffer now, to measure again
+from here, for example after a slow setup step.
+*/
+void resetAudioOutputBufferStats();
+
+
 
 
 // internal use
@@ -94,6 +94,29 @@ public:
 	}
 
 
+	/** Fills a block with successive samples, the same as calling next() num_samples times.
+	The phase is kept in a local for the whole block, so this is quicker than next() in a loop.
+	For use in updateAudioBlock(), see AUDIO_BLOCK_SIZE.
+	@param out where to write the samples.
+	@param num_samples how many samples to write.
+	*/
+	inline
+	void nextBlock(int8_t * out, size_t num_samples)
+	{
+		unsigned long phase = phase_fractional;
+		const unsigned long phase_inc = phase_increment_fractional;
+		for (size_t i = 0; i < num_samples; ++i) {
+			phase += phase_inc;
+#ifdef OSCIL_DITHER_PHASE
+			out[i] = FLASH_OR_RAM_READ<const int8_t>(table + (((phase + ((int)(xorshift96()>>16))) >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1)));
+#else
+			out[i] = FLASH_OR_RAM_READ<const int8_t>(table + ((phase >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1)));
+#endif
+		}
+		phase_fractional = phase;
+	}
+
+
 	/** Change the sound table which will be played by the Oscil.
 	@param TABLE_NAME is the name of the array in the table ".h" file you're using.
 	*/
@@ -0,0 +1,167 @@
+/*
+ * SpectrumAnalyser.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef SPECTRUMANALYSER_H_
+#define SPECTRUMANALYSER_H_
+
+#include "MozziGuts.h"
+#include "FixedFFT.h"
+
+/** @ingroup sensortools
+Finds the spectrum of a stream of audio, such as getAudioInput(), using FixedFFT.
+
+Feed it a sample at a time with next() in updateAudio().  Every NUM_POINTS/2 samples a new frame is ready,
+overlapping the last one by half.  Then call update() in updateControl(), which windows and transforms the latest
+NUM_POINTS samples, and read the result with power(), magnitude() or bandPower().  update() is the slow part, so it
+belongs in updateControl() (or loop()), never in updateAudio().  If frames come faster than updateControl() runs,
+the ones in between are skipped, and update() always looks at the most recent samples.
+
+@tparam NUM_POINTS the size of the transform, a power of two from 4 to 1024.  The frequency resolution is
+AUDIO_RATE/NUM_POINTS Hz per bin.  This takes 6*NUM_POINTS bytes of RAM.
+@tparam INPUT_BITS how many bits the signed input to next() has, including the sign, from 1 to 14.  The default, 10, suits
+getAudioInput()-512 on AVR.
+*/
+template <unsigned int NUM_POINTS, uint8_t INPUT_BITS = 10>
+class SpectrumAnalyser
+{
+	static_assert(INPUT_BITS >= 1 && INPUT_BITS <= 14, "SpectrumAnalyser input can have 1 to 14 bits");
+
+public:
+	/** Constructor.
+	*/
+	SpectrumAnalyser(): write_pos(0), samples_since_frame(0), frame_ready(false)
+	{
+		for (unsigned int i = 0; i < NUM_POINTS; ++i) history[i] = 0;
+	}
+
+
+	/** Add the next sample.  Call this in updateAudio().
+	@param sample a signed sample, INPUT_BITS wide.
+	*/
+	inline
+	void next(int sample)
+	{
+		history[write_pos] = (int16_t) sample;
+		write_pos = (write_pos + 1) & (NUM_POINTS - 1);
+		if (++samples_since_frame == NUM_POINTS / 2) {
+			samples_since_frame = 0;
+			frame_ready = true;
+		}
+	}
+
+
+	/** Whether enough new samples have come in for update() to do anything. */
+	inline
+	bool ready()
+	{
+		return frame_ready;
+	}
+
+
+	/** If a new frame is ready, window and transform the latest NUM_POINTS samples.  Call this in updateControl().
+	@return true if there is a new spectrum, false if nothing changed.
+	*/
+	bool update()
+	{
+		if (!frame_ready) return false;
+		frame_ready = false;
+		int16_t * re = fft.real();
+		int16_t * im = fft.imag();
+		// oldest first, scaled up to 14 bits, inside the +-16384 FixedFFT can take without overflowing.
+		// A multiply rather than a shift, as the samples are negative half the time.
+		for (unsigned int i = 0; i < NUM_POINTS; ++i) {
+			re[i] = (int16_t) (history[(write_pos + i) & (NUM_POINTS - 1)] * (1 << (14 - INPUT_BITS)));
+			im[i] = 0;
+		}
+		fft.window();
+		fft.transform();
+		return true;
+	}
+
+
+	/** The power in one bin of the latest spectrum.
+	@param bin from 0 to NUM_POINTS/2.  Bin k is centred on k*AUDIO_RATE/NUM_POINTS Hz.
+	*/
+	inline
+	uint32_t power(unsigned int bin)
+	{
+		return fft.power(bin);
+	}
+
+
+	/** The magnitude of one bin of the latest spectrum, the square root of power().
+	@param bin from 0 to NUM_POINTS/2.
+	*/
+	inline
+	uint16_t magnitude(unsigned int bin)
+	{
+		return fft.magnitude(bin);
+	}
+
+
+	/** The total power from bin first to bin last, inclusive, for band energy meters and the like.
+	This saturates rather than wrapping around.
+	*/
+	uint32_t bandPower(unsigned int first, unsigned int last)
+	{
+		uint32_t sum = 0;
+		for (unsigned int bin = first; bin <= last; ++bin) {
+			const uint32_t p = fft.power(bin);
+			sum = (sum + p < sum) ? 0xFFFFFFFFUL : sum + p;
+		}
+		return sum;
+	}
+
+
+	/** The bin with the most power, from 1 to NUM_POINTS/2 (bin 0, DC, is left out).
+	A rough pitch detector for clear, single notes.
+	*/
+	unsigned int peakBin()
+	{
+		unsigned int peak = 1;
+		uint32_t peak_power = 0;
+		for (unsigned int bin = 1; bin <= NUM_POINTS / 2; ++bin) {
+			const uint32_t p = fft.power(bin);
+			if (p > peak_power) {
+				peak_power = p;
+				peak = bin;
+			}
+		}
+		return peak;
+	}
+
+
+	/** The centre frequency of a bin, in Hz.
+	@param bin from 0 to NUM_POINTS/2.
+	*/
+	static inline
+	unsigned int binFrequency(unsigned int bin)
+	{
+		return (unsigned int) (((unsigned long) bin * AUDIO_RATE) / NUM_POINTS);
+	}
+
+
+	/** The bin a frequency falls in, rounded to the nearest.
+	@param freq in Hz, from 0 to AUDIO_RATE/2.
+	*/
+	static inline
+	unsigned int frequencyToBin(unsigned int freq)
+	{
+		return (unsigned int) (((unsigned long) freq * NUM_POINTS + AUDIO_RATE / 2) / AUDIO_RATE);
+	}
+
+private:
+	int16_t history[NUM_POINTS];
+	unsigned int write_pos;
+	unsigned int samples_since_frame;
+	bool frame_ready;
+	FixedFFT<NUM_POINTS> fft;
+};
+
+#endif /* SPECTRUMANALYSER_H_ */
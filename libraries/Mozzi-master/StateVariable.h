@@ -116,11 +116,36 @@ public:
     return next(input, Int2Type<FILTER_TYPE>());
   }
 
+  /** Filter a block of samples, the same as calling next() on each of them.
+  The filter state (and the volatile frequency) is only loaded and stored once per block.
+  @param in the signal input.
+  @param out the signal output.  This can be the same as in, to filter in place.
+  @param num_samples how many samples to filter.
+  */
+  inline void nextBlock(const int *in, int *out, size_t num_samples) {
+    int _low = low, _band = band;
+    const Q15n16 _f = f;
+    for (size_t i = 0; i < num_samples; ++i) {
+      _low += ((_f * _band) >> 16);
+      int high = (((long)in[i] - _low - (((long)_band * q) >> 8)) * scale) >> 8;
+      _band += ((_f * high) >> 16);
+      out[i] = output(_low, _band, high, Int2Type<FILTER_TYPE>());
+    }
+    low = _low;
+    band = _band;
+  }
+
 private:
   int low, band;
   Q0n8 q, scale;
   volatile Q15n16 f;
 
+  // pick the output of nextBlock() depending on the filter type, see meta.h.
+  static inline int output(int low, int, int, Int2Type<LOWPASS>) { return low; }
+  static inline int output(int, int band, int, Int2Type<BANDPASS>) { return band; }
+  static inline int output(int, int, int high, Int2Type<HIGHPASS>) { return high; }
+  static inline int output(int low, int, int high, Int2Type<NOTCH>) { return high + low; }
+
   /** Calculate the next sample, given an input signal.
   @param in the signal input.
   @return the signal output.
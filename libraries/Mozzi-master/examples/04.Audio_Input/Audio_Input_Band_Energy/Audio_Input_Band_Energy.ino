@@ -0,0 +1,92 @@
+/*
+  Example of measuring the energy in frequency bands of audio input,
+  using Mozzi sonification library.
+
+  Demonstrates SpectrumAnalyser, which runs a FixedFFT over overlapping
+  frames of getAudioInput().  The energy in 4 bands sets the volume of
+  4 sine waves, one at the centre of each band, for a simple
+  vocoder-like resynthesis of the input.
+
+  Configuration: requires these lines in the Mozzi/mozzi_config.h file:
+  #define USE_AUDIO_INPUT true
+  #define AUDIO_INPUT_PIN 0
+
+  Circuit:
+    Audio input on pin analog 0
+    Output on DAC/A14 on Teensy 3.0, 3.1, or digital pin 9 on a Uno or similar, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+  Mozzi documentation/API
+  https://sensorium.github.io/Mozzi/doc/html/index.html
+
+  Mozzi help/discussion/announcements:
+  https://groups.google.com/forum/#!forum/mozzi-users
+
+  CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <SpectrumAnalyser.h>
+#include <Oscil.h>
+#include <tables/sin2048_int8.h>
+
+#if (USE_AUDIO_INPUT != true)
+#error This example needs #define USE_AUDIO_INPUT true in mozzi_config.h
+#endif
+
+#define CONTROL_RATE 128 // faster than usual, to keep up with the analyser
+
+// 64 points at 16384 Hz gives bins 256 Hz wide, and a new frame every 2 ms
+SpectrumAnalyser <64> analyser;
+
+// first and last bins of each band, roughly an octave apart
+const byte band_first[4] = { 1, 3, 6, 12 };
+const byte band_last[4] = { 2, 5, 11, 24 };
+
+Oscil <SIN2048_NUM_CELLS, AUDIO_RATE> aSin0(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, AUDIO_RATE> aSin1(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, AUDIO_RATE> aSin2(SIN2048_DATA);
+Oscil <SIN2048_NUM_CELLS, AUDIO_RATE> aSin3(SIN2048_DATA);
+
+byte gain[4];
+
+
+void setup(){
+  aSin0.setFreq((int) analyser.binFrequency((band_first[0] + band_last[0]) / 2));
+  aSin1.setFreq((int) analyser.binFrequency((band_first[1] + band_last[1]) / 2));
+  aSin2.setFreq((int) analyser.binFrequency((band_first[2] + band_last[2]) / 2));
+  aSin3.setFreq((int) analyser.binFrequency((band_first[3] + band_last[3]) / 2));
+  startMozzi(CONTROL_RATE);
+}
+
+
+void updateControl(){
+  if (analyser.update()) {
+    for (byte i = 0; i < 4; i++) {
+      // add up the magnitudes across the band, which is quicker than
+      // the square root of bandPower() and close enough for a meter
+      unsigned int level = 0;
+      for (byte bin = band_first[i]; bin <= band_last[i]; bin++) {
+        level += analyser.magnitude(bin);
+      }
+      level >>= 3;
+      gain[i] = (level > 255) ? 255 : level;
+    }
+  }
+}
+
+
+AudioOutput_t updateAudio(){
+  // subtracting 512 moves the unsigned audio data into 0-centred,
+  // signed range required by all Mozzi units
+  analyser.next(getAudioInput() - 512);
+  // 4 signals of 8 bits times 8 bits of gain add up to 18 bits
+  int32_t asig = (int32_t) aSin0.next() * gain[0] + (int32_t) aSin1.next() * gain[1] +
+                 (int32_t) aSin2.next() * gain[2] + (int32_t) aSin3.next() * gain[3];
+  return MonoOutput::fromNBit(18, asig);
+}
+
+
+void loop(){
+  audioHook();
+}
@@ -0,0 +1,89 @@
+/*  Example of rendering audio a block at a time,
+    using Mozzi sonification library.
+
+    Demonstrates updateAudioBlock() and the nextBlock() functions
+    of Oscil, ADSR and LowPassFilter.
+
+    IMPORTANT: this sketch requires \#define AUDIO_BLOCK_SIZE 32
+    (or another power of two) in mozzi_config.h.
+    It is meant for 32 bit boards, like the ESP32, STM32 or SAMD21,
+    where the block size costs little RAM.
+
+    Circuit: Audio output on digital pin 9 on a Uno or similar, or
+    DAC/A14 on Teensy 3.1, or
+    check the README or http://sensorium.github.io/Mozzi/
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <Oscil.h>
+#include <ADSR.h>
+#include <LowPassFilter.h>
+#include <EventDelay.h>
+#include <mozzi_rand.h>
+#include <mozzi_midi.h>
+#include <tables/saw2048_int8.h>
+
+#if !defined(AUDIO_BLOCK_SIZE)
+#error This example needs AUDIO_BLOCK_SIZE to be defined in mozzi_config.h
+#endif
+
+#define NUM_VOICES 4
+
+Oscil<SAW2048_NUM_CELLS, AUDIO_RATE> aSaw[NUM_VOICES];
+ADSR<CONTROL_RATE, AUDIO_RATE> envelope[NUM_VOICES];
+LowPassFilter lpf;
+EventDelay noteDelay;
+
+uint8_t next_voice = 0;
+
+void setup(){
+  for (uint8_t i = 0; i < NUM_VOICES; i++){
+    aSaw[i].setTable(SAW2048_DATA);
+    envelope[i].setADLevels(255, 128);
+    envelope[i].setTimes(20, 200, 300, 400);
+  }
+  lpf.setCutoffFreqAndResonance(90, 180);
+  noteDelay.set(250);
+  startMozzi();
+}
+
+void loop(){
+  audioHook();
+}
+
+void updateControl(){
+  if (noteDelay.ready()){
+    aSaw[next_voice].setFreq(mtof(rand(36) + 36));
+    envelope[next_voice].noteOn();
+    next_voice = (next_voice + 1) % NUM_VOICES;
+    noteDelay.start();
+  }
+  for (uint8_t i = 0; i < NUM_VOICES; i++){
+    envelope[i].update();
+  }
+}
+
+void updateAudioBlock(AudioOutput_t * out, size_t num_samples){
+  int8_t wave[AUDIO_BLOCK_SIZE];
+  unsigned char gain[AUDIO_BLOCK_SIZE];
+  int mix[AUDIO_BLOCK_SIZE];
+
+  for (size_t n = 0; n < num_samples; n++) mix[n] = 0;
+  for (uint8_t i = 0; i < NUM_VOICES; i++){
+    aSaw[i].nextBlock(wave, num_samples);
+    envelope[i].nextBlock(gain, num_samples);
+    for (size_t n = 0; n < num_samples; n++) mix[n] += (int)wave[n] * gain[n];
+  }
+  // 8 bit wave * 8 bit gain * 4 voices = 18 bits, the filter wants 8 bits
+  for (size_t n = 0; n < num_samples; n++) mix[n] >>= 10;
+  lpf.nextBlock(mix, mix, num_samples);
+  for (size_t n = 0; n < num_samples; n++) out[n] = MonoOutput::from8Bit(mix[n]).clip();
+}
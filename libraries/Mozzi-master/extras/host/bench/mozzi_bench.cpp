@@ -0,0 +1,180 @@
+/*
+ * mozzi_bench.cpp
+ *
+ * Times the main audio units on the host, in cycles per sample (time stamp
+ * counter cycles on x86, nanoseconds elsewhere), one sample at a time with
+ * next() and, where there is one, a block at a time with nextBlock().
+ *
+ * Then times FixedFFT at each size from 64 to 1024 points, in cycles per
+ * transform (window included).
+ *
+ * usage: mozzi_bench [num_samples]
+ *
+ * The numbers are for comparing versions of the code on the same machine, they
+ * don't say much about how long a unit takes on a board.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mozzi_host.h"
+#include <MozziGuts.h>
+#include <Oscil.h>
+#include <ADSR.h>
+#include <LowPassFilter.h>
+#include <StateVariable.h>
+#include <ReverbTank.h>
+#include <WaveShaper.h>
+#include <SampleHuffman.h>
+#include <FixedFFT.h>
+#include <tables/saw2048_int8.h>
+#include <tables/waveshape_chebyshev_3rd_256_int8.h>
+#include "../../../examples/08.Samples/SampleHuffman_Umpah/umpah_huff.h"
+
+// the core library calls these, the benchmark doesn't use them
+void updateControl() {}
+AudioOutput_t updateAudio() { return MonoOutput::from8Bit(0); }
+
+#define BLOCK 32
+#define REPEATS 5
+
+static unsigned long num_samples = 1UL << 16;
+static volatile int sink; // keeps the compiler from dropping the work being timed
+
+// Runs f over num_samples samples a few times, and prints the best time.
+template <class F>
+static void bench(const char * name, F f)
+{
+	uint64_t best = ~(uint64_t) 0;
+	for (int r = 0; r < REPEATS; ++r) {
+		uint64_t start = hostCycles();
+		f();
+		uint64_t t = hostCycles() - start;
+		if (t < best) best = t;
+	}
+	printf("%-28s %8.2f\n", name, (double) best / num_samples);
+}
+
+template <unsigned int N>
+static void benchFFT()
+{
+	static FixedFFT<N> fft;
+	uint64_t best = ~(uint64_t) 0;
+	for (int r = 0; r < REPEATS; ++r) {
+		for (unsigned int i = 0; i < N; ++i) {
+			fft.real()[i] = (int16_t) ((i * 997) % 16384 - 8192);
+			fft.imag()[i] = 0;
+		}
+		uint64_t start = hostCycles();
+		fft.window();
+		fft.transform();
+		uint64_t t = hostCycles() - start;
+		if (t < best) best = t;
+	}
+	sink = fft.real()[1];
+	char name[32];
+	snprintf(name, sizeof(name), "FixedFFT<%u>", N);
+	printf("%-28s %10.0f\n", name, (double) best);
+}
+
+int main(int argc, char ** argv)
+{
+	if (argc > 1) num_samples = strtoul(argv[1], 0, 0) & ~(unsigned long) (BLOCK - 1);
+	if (!num_samples) num_samples = BLOCK;
+
+	printf("%-28s %8s\n", "unit", "cycles/sample");
+
+	static int8_t block8[BLOCK];
+	static unsigned char levels[BLOCK];
+	static int in[BLOCK], out[BLOCK];
+	for (int i = 0; i < BLOCK; ++i) in[i] = (i * 997) % 512 - 256;
+
+	Oscil<SAW2048_NUM_CELLS, AUDIO_RATE> aSaw(SAW2048_DATA);
+	aSaw.setFreq(440);
+	bench("Oscil next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += aSaw.next();
+		sink = s;
+	});
+	bench("Oscil nextBlock", [&] {
+		for (unsigned long i = 0; i < num_samples; i += BLOCK) aSaw.nextBlock(block8, BLOCK);
+		sink = block8[0];
+	});
+
+	ADSR<AUDIO_RATE, AUDIO_RATE> envelope;
+	envelope.setADLevels(255, 128);
+	envelope.setTimes(50, 200, 60000, 500);
+	envelope.noteOn();
+	envelope.update();
+	bench("ADSR next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += envelope.next();
+		sink = s;
+	});
+	bench("ADSR nextBlock", [&] {
+		for (unsigned long i = 0; i < num_samples; i += BLOCK) envelope.nextBlock(levels, BLOCK);
+		sink = levels[0];
+	});
+
+	LowPassFilter lpf;
+	lpf.setCutoffFreqAndResonance(100, 200);
+	bench("LowPassFilter next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += lpf.next(in[i & (BLOCK - 1)]);
+		sink = s;
+	});
+	bench("LowPassFilter nextBlock", [&] {
+		for (unsigned long i = 0; i < num_samples; i += BLOCK) lpf.nextBlock(in, out, BLOCK);
+		sink = out[0];
+	});
+
+	StateVariable<LOWPASS> svf;
+	svf.setResonance(25);
+	svf.setCentreFreq(1200);
+	bench("StateVariable next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += svf.next(in[i & (BLOCK - 1)]);
+		sink = s;
+	});
+	bench("StateVariable nextBlock", [&] {
+		for (unsigned long i = 0; i < num_samples; i += BLOCK) svf.nextBlock(in, out, BLOCK);
+		sink = out[0];
+	});
+
+	ReverbTank reverb;
+	bench("ReverbTank next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += reverb.next(in[i & (BLOCK - 1)]);
+		sink = s;
+	});
+
+	WaveShaper<char> cheby(CHEBYSHEV_3RD_256_DATA);
+	bench("WaveShaper next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += cheby.next((byte) i);
+		sink = s;
+	});
+
+	SampleHuffman umpah(UMPAH_SOUNDDATA, UMPAH_HUFFMAN, UMPAH_SOUNDDATA_BITS);
+	umpah.setLoopingOn();
+	umpah.start();
+	bench("SampleHuffman next", [&] {
+		int s = 0;
+		for (unsigned long i = 0; i < num_samples; ++i) s += umpah.next();
+		sink = s;
+	});
+
+	printf("\n%-28s %10s\n", "transform", "cycles");
+	benchFFT<64>();
+	benchFFT<128>();
+	benchFFT<256>();
+	benchFFT<512>();
+	benchFFT<1024>();
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Arduino.h
+ *
+ * Just enough of the Arduino core for Mozzi sketches to build on a desktop
+ * machine, for offline rendering and benchmarking.  See extras/host/README.md.
+ *
+ * Time (millis(), micros()) is virtual, it advances with the audio samples
+ * rendered, so renders are repeatable however fast the host is.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef MOZZI_HOST_ARDUINO_H_
+#define MOZZI_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define A0 0
+#define A1 1
+#define A2 2
+#define A3 3
+#define A4 4
+#define A5 5
+#define A6 6
+#define A7 7
+
+#define PROGMEM
+#define F(string_literal) (string_literal)
+
+#define PI 3.1415926535897932384626433832795
+#define TWO_PI 6.283185307179586476925286766559
+
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+/** Serial output goes to stderr, so stdout only has the renderer's own results.  Input is always empty. */
+class HostSerial
+{
+public:
+	void begin(unsigned long) {}
+	int available() { return 0; }
+	int read() { return -1; }
+	void flush() {}
+
+	size_t print(const char * s);
+	size_t print(char c);
+	size_t print(int n, int base = 10) { return print((long) n, base); }
+	size_t print(unsigned int n, int base = 10) { return print((unsigned long) n, base); }
+	size_t print(long n, int base = 10);
+	size_t print(unsigned long n, int base = 10);
+	size_t print(double n, int digits = 2);
+
+	size_t println() { return print('\n'); }
+	template <class T> size_t println(T x) { size_t n = print(x); return n + println(); }
+	template <class T> size_t println(T x, int format) { size_t n = print(x, format); return n + println(); }
+	size_t write(uint8_t c) { return print((char) c); }
+};
+
+extern HostSerial Serial;
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+/* The sketch */
+void setup();
+void loop();
+
+#endif /* MOZZI_HOST_ARDUINO_H_ */
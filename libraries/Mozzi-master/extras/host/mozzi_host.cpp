@@ -0,0 +1,117 @@
+/*
+ * mozzi_host.cpp
+ *
+ * The Arduino functions declared in include/Arduino.h, and audioOutput() for
+ * Mozzi built for the host.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "mozzi_host.h"
+#include "MozziGuts.h"
+#include "AudioOutput.h"
+
+static uint64_t audio_ticks = 0;
+static HostAudioSink audio_sink = 0;
+static int analog_inputs[NUM_ANALOG_INPUTS];
+static int digital_inputs[64];
+
+HostSerial Serial;
+
+void audioOutput(const AudioOutput f)
+{
+	int32_t frame[2] = { f.l(), f.r() };
+	if (audio_sink) audio_sink(frame, AUDIO_CHANNELS);
+	++audio_ticks;
+}
+
+void hostSetAudioSink(HostAudioSink sink) { audio_sink = sink; }
+
+uint64_t hostAudioTicks() { return audio_ticks; }
+
+void hostSetAnalogInput(uint8_t pin, int value)
+{
+	if (pin < NUM_ANALOG_INPUTS) analog_inputs[pin] = value;
+}
+
+void hostSetDigitalInput(uint8_t pin, int value)
+{
+	if (pin < 64) digital_inputs[pin] = value;
+}
+
+uint64_t hostCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t pin) { return (pin < 64) ? digital_inputs[pin] : LOW; }
+int analogRead(uint8_t pin) { return (pin < NUM_ANALOG_INPUTS) ? analog_inputs[pin] : 0; }
+void analogWrite(uint8_t, int) {}
+
+unsigned long millis() { return (unsigned long) ((audio_ticks * 1000) / AUDIO_RATE); }
+unsigned long micros() { return (unsigned long) ((audio_ticks * 1000000) / AUDIO_RATE); }
+
+// Virtual time only moves when samples are rendered, so there is nothing to wait for.
+void delay(unsigned long) {}
+void delayMicroseconds(unsigned int) {}
+
+// A fixed seed, so that renders are repeatable.  Mozzi sketches normally use
+// mozzi_rand's xorshift96() instead, which is already deterministic.
+static unsigned long random_state = 1;
+
+void randomSeed(unsigned long seed) { if (seed) random_state = seed; }
+
+long random(long howbig)
+{
+	if (howbig == 0) return 0;
+	random_state = random_state * 1103515245UL + 12345UL;
+	return (long) ((random_state >> 16) % (unsigned long) howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+	if (howsmall >= howbig) return howsmall;
+	return random(howbig - howsmall) + howsmall;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+
+size_t HostSerial::print(const char * s) { return fputs(s, stderr) >= 0 ? strlen(s) : 0; }
+size_t HostSerial::print(char c) { return fputc(c, stderr) == EOF ? 0 : 1; }
+size_t HostSerial::print(double n, int digits) { return fprintf(stderr, "%.*f", digits, n); }
+size_t HostSerial::print(unsigned long n, int base)
+{
+	if (base == HEX) return fprintf(stderr, "%lX", n);
+	if (base != BIN) return fprintf(stderr, "%lu", n);
+	char buf[8 * sizeof(n) + 1];
+	char * p = &buf[sizeof(buf) - 1];
+	*p = '\0';
+	do { *--p = '0' + (n & 1); n >>= 1; } while (n);
+	return print(p);
+}
+size_t HostSerial::print(long n, int base)
+{
+	if (base == DEC) return fprintf(stderr, "%ld", n);
+	return print((unsigned long) n, base);
+}
@@ -0,0 +1,43 @@
+/*
+ * mozzi_host.h
+ *
+ * Interface between Mozzi built for the host (\#define MOZZI_HOST) and the
+ * programs driving it: the offline renderer and the benchmarks.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef MOZZI_HOST_H_
+#define MOZZI_HOST_H_
+
+#include <stdint.h>
+
+/** Defined in MozziGuts.cpp.  Takes the next sample out of Mozzi's output
+buffer and passes it to audioOutput(), the same as the audio timer interrupt does
+on a board.  Returns false if the buffer is empty. */
+bool hostAudioOutputTick();
+
+/** Where audioOutput() puts the samples it gets, if set.  Channels are
+interleaved when AUDIO_CHANNELS is STEREO. */
+typedef void (*HostAudioSink)(const int32_t * frame, uint8_t num_channels);
+void hostSetAudioSink(HostAudioSink sink);
+
+/** Number of samples output since the program started.  millis() and micros()
+are derived from this. */
+uint64_t hostAudioTicks();
+
+/** Set what analogRead() (and so mozziAnalogRead()) returns for a pin. With
+USE_AUDIO_INPUT, the renderer sets AUDIO_INPUT_PIN before each sample. */
+void hostSetAnalogInput(uint8_t pin, int value);
+
+/** Set what digitalRead() returns for a pin. */
+void hostSetDigitalInput(uint8_t pin, int value);
+
+/** A cheap, monotonic cycle count for benchmarks: the time stamp counter on x86,
+nanoseconds elsewhere. */
+uint64_t hostCycles();
+
+#endif /* MOZZI_HOST_H_ */
@@ -0,0 +1,185 @@
+/*
+ * render_main.cpp
+ *
+ * Runs a Mozzi sketch on the host, as fast as it will go, and writes what it
+ * plays to a WAV file.  Each sketch is linked against this file to make its
+ * own renderer, see CMakeLists.txt.
+ *
+ * usage: <sketch> [--seconds S] [--out file.wav] [--input file.wav | --tone HZ]
+ *                 [--analog PIN=VALUE]... [--expect HASH]
+ *
+ * Prints a hash of the rendered samples on stdout, and timing (cycles per
+ * sample, speed relative to real time) on stderr.  With --expect, the exit
+ * code says whether the hash matched, which is what the golden tests use.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "mozzi_host.h"
+#include "MozziGuts.h"
+
+static std::vector<int16_t> rendered;
+static uint64_t hash = 14695981039346656037ULL; // FNV-1a, 64 bit
+
+static void collectSample(const int32_t * frame, uint8_t num_channels)
+{
+	for (uint8_t i = 0; i < num_channels; ++i) {
+		int32_t s = frame[i];
+		if (s > 32767) s = 32767;
+		if (s < -32768) s = -32768;
+		rendered.push_back((int16_t) s);
+		uint16_t u = (uint16_t) s;
+		hash = (hash ^ (u & 0xff)) * 1099511628211ULL;
+		hash = (hash ^ (u >> 8)) * 1099511628211ULL;
+	}
+}
+
+static void put16(FILE * f, uint16_t v) { fputc(v & 0xff, f); fputc(v >> 8, f); }
+static void put32(FILE * f, uint32_t v) { put16(f, v & 0xffff); put16(f, v >> 16); }
+
+static bool writeWav(const char * path, const std::vector<int16_t> & samples, uint16_t num_channels)
+{
+	FILE * f = fopen(path, "wb");
+	if (!f) return false;
+	uint32_t data_bytes = samples.size() * sizeof(int16_t);
+	fwrite("RIFF", 1, 4, f); put32(f, 36 + data_bytes); fwrite("WAVE", 1, 4, f);
+	fwrite("fmt ", 1, 4, f); put32(f, 16); put16(f, 1); put16(f, num_channels);
+	put32(f, AUDIO_RATE); put32(f, AUDIO_RATE * num_channels * 2); put16(f, num_channels * 2); put16(f, 16);
+	fwrite("data", 1, 4, f); put32(f, data_bytes);
+	for (size_t i = 0; i < samples.size(); ++i) put16(f, (uint16_t) samples[i]);
+	fclose(f);
+	return true;
+}
+
+// Reads the first channel of a 16 bit PCM WAV file, for audio input.
+static bool readWav(const char * path, std::vector<int16_t> & samples)
+{
+	FILE * f = fopen(path, "rb");
+	if (!f) return false;
+	unsigned char header[12];
+	if (fread(header, 1, 12, f) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) { fclose(f); return false; }
+	uint16_t num_channels = 1, bits = 16;
+	unsigned char chunk[8];
+	while (fread(chunk, 1, 8, f) == 8) {
+		uint32_t size = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) | ((uint32_t) chunk[7] << 24);
+		if (!memcmp(chunk, "fmt ", 4)) {
+			unsigned char fmt[16];
+			if (size < 16 || fread(fmt, 1, 16, f) != 16) break;
+			num_channels = fmt[2] | (fmt[3] << 8);
+			bits = fmt[14] | (fmt[15] << 8);
+			fseek(f, size - 16, SEEK_CUR);
+		} else if (!memcmp(chunk, "data", 4)) {
+			if (bits != 16 || !num_channels) break;
+			std::vector<int16_t> frame(num_channels);
+			for (uint32_t i = 0; i < size / (2 * num_channels); ++i) {
+				if (fread(&frame[0], 2, num_channels, f) != num_channels) break;
+				samples.push_back(frame[0]);
+			}
+			fclose(f);
+			return true;
+		} else {
+			fseek(f, size + (size & 1), SEEK_CUR);
+		}
+	}
+	fclose(f);
+	return false;
+}
+
+static void usage(const char * name)
+{
+	fprintf(stderr, "usage: %s [--seconds S] [--out file.wav] [--input file.wav | --tone HZ] [--analog PIN=VALUE]... [--expect HASH]\n", name);
+	exit(2);
+}
+
+int main(int argc, char ** argv)
+{
+	double seconds = 2;
+	const char * out_path = 0;
+	const char * input_path = 0;
+	const char * expect = 0;
+	double tone = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc) out_path = argv[++i];
+		else if (!strcmp(argv[i], "--input") && i + 1 < argc) input_path = argv[++i];
+		else if (!strcmp(argv[i], "--expect") && i + 1 < argc) expect = argv[++i];
+		else if (!strcmp(argv[i], "--tone") && i + 1 < argc) tone = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--analog") && i + 1 < argc) {
+			int pin, value;
+			if (sscanf(argv[++i], "%d=%d", &pin, &value) != 2) usage(argv[0]);
+			hostSetAnalogInput(pin, value);
+		}
+		else usage(argv[0]);
+	}
+
+	std::vector<int16_t> input;
+	if (input_path && !readWav(input_path, input)) {
+		fprintf(stderr, "%s: can't read 16 bit PCM from %s\n", argv[0], input_path);
+		return 2;
+	}
+	if (tone > 0) {
+		// one second of a sine at half scale, looped
+		for (unsigned long i = 0; i < AUDIO_RATE; ++i) input.push_back((int16_t) lrint(16384 * sin(2 * M_PI * tone * i / AUDIO_RATE)));
+	}
+
+	const uint64_t num_samples = (uint64_t) (seconds * AUDIO_RATE);
+	rendered.reserve(num_samples * AUDIO_CHANNELS);
+	hostSetAudioSink(collectSample);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	uint64_t cycles = hostCycles();
+
+	setup();
+	uint64_t idle_loops = 0;
+	while (hostAudioTicks() < num_samples) {
+		loop();
+		// like the audio interrupt on a board, take one sample each time round
+#if (USE_AUDIO_INPUT == true)
+		if (!input.empty()) {
+			// scale to the 10 bits an AVR ADC would give
+			int16_t in = input[hostAudioTicks() % input.size()];
+			hostSetAnalogInput(AUDIO_INPUT_PIN, ((int32_t) in + 32768) >> 6);
+		}
+#endif
+		if (hostAudioOutputTick()) {
+			idle_loops = 0;
+		} else if (++idle_loops > 1000000) {
+			fprintf(stderr, "%s: the sketch stopped producing audio, is audioHook() in loop()?\n", argv[0]);
+			return 1;
+		}
+	}
+
+	cycles = hostCycles() - cycles;
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	fprintf(stderr, "%" PRIu64 " samples, %.1f cycles/sample, %.1fx real time\n",
+	        num_samples, (double) cycles / num_samples, elapsed > 0 ? seconds / elapsed : 0.);
+	printf("%016" PRIx64 "\n", hash);
+
+	if (out_path && !writeWav(out_path, rendered, AUDIO_CHANNELS)) {
+		fprintf(stderr, "%s: can't write %s\n", argv[0], out_path);
+		return 2;
+	}
+
+	if (expect) {
+		char actual[17];
+		snprintf(actual, sizeof(actual), "%016" PRIx64, hash);
+		if (strcmp(actual, expect)) {
+			fprintf(stderr, "%s: output changed, expected %s, got %s\n", argv[0], expect, actual);
+			return 1;
+		}
+	}
+	return 0;
+}
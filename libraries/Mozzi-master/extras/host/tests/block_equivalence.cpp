@@ -0,0 +1,175 @@
+/*
+ * block_equivalence.cpp
+ *
+ * Checks that the nextBlock() functions used with AUDIO_BLOCK_SIZE give
+ * exactly the same samples as calling next() once per sample, over blocks of
+ * awkward sizes and with parameters changing between blocks.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+
+#include "mozzi_host.h"
+#include <MozziGuts.h>
+#include <Oscil.h>
+#include <Line.h>
+#include <ADSR.h>
+#include <LowPassFilter.h>
+#include <StateVariable.h>
+#include <AudioDelay.h>
+#include <tables/saw2048_int8.h>
+
+// the core library calls these, the test doesn't use them
+void updateControl() {}
+AudioOutput_t updateAudio() { return MonoOutput::from8Bit(0); }
+
+#define NUM_SAMPLES 4096
+#define MAX_BLOCK 64
+
+static const size_t block_sizes[] = { 1, 3, 16, 17, 32, 64 };
+#define NUM_BLOCK_SIZES (sizeof(block_sizes) / sizeof(block_sizes[0]))
+static int failures = 0;
+
+// Globals, like in a sketch, so the state the constructors leave alone starts
+// at 0.  Each block size gets its own pair: a is run with next(), b with nextBlock().
+static Oscil<SAW2048_NUM_CELLS, AUDIO_RATE> oscil_a[NUM_BLOCK_SIZES], oscil_b[NUM_BLOCK_SIZES];
+static Line<long> line_a[NUM_BLOCK_SIZES], line_b[NUM_BLOCK_SIZES];
+static ADSR<CONTROL_RATE, AUDIO_RATE> adsr_a[NUM_BLOCK_SIZES], adsr_b[NUM_BLOCK_SIZES];
+static LowPassFilter lpf_a[NUM_BLOCK_SIZES], lpf_b[NUM_BLOCK_SIZES];
+static StateVariable<LOWPASS> svf_low_a[NUM_BLOCK_SIZES], svf_low_b[NUM_BLOCK_SIZES];
+static StateVariable<BANDPASS> svf_band_a[NUM_BLOCK_SIZES], svf_band_b[NUM_BLOCK_SIZES];
+static StateVariable<HIGHPASS> svf_high_a[NUM_BLOCK_SIZES], svf_high_b[NUM_BLOCK_SIZES];
+static StateVariable<NOTCH> svf_notch_a[NUM_BLOCK_SIZES], svf_notch_b[NUM_BLOCK_SIZES];
+static AudioDelay<256> delay_a[NUM_BLOCK_SIZES], delay_b[NUM_BLOCK_SIZES];
+
+static void check(const char * name, size_t block_size, long i, long expected, long actual)
+{
+	if (expected == actual) return;
+	printf("%s, blocks of %u: sample %ld is %ld, next() gives %ld\n", name, (unsigned) block_size, i, actual, expected);
+	++failures;
+}
+
+static int input(long i)
+{
+	return ((i * 997) % 511) - 255;
+}
+
+static void testOscil(size_t k)
+{
+	const size_t block_size = block_sizes[k];
+	Oscil<SAW2048_NUM_CELLS, AUDIO_RATE> & a = oscil_a[k], & b = oscil_b[k];
+	a.setTable(SAW2048_DATA);
+	b.setTable(SAW2048_DATA);
+	int8_t out[MAX_BLOCK];
+	for (long i = 0; i < NUM_SAMPLES; i += block_size) {
+		a.setFreq((int) (110 + i / 8));
+		b.setFreq((int) (110 + i / 8));
+		b.nextBlock(out, block_size);
+		for (size_t j = 0; j < block_size; ++j) check("Oscil", block_size, i + j, a.next(), out[j]);
+	}
+}
+
+static void testLine(size_t k)
+{
+	const size_t block_size = block_sizes[k];
+	Line<long> & a = line_a[k], & b = line_b[k];
+	long out[MAX_BLOCK];
+	a.set(-100000, 100000, 1000);
+	b.set(-100000, 100000, 1000);
+	for (long i = 0; i < NUM_SAMPLES; i += block_size) {
+		b.nextBlock(out, block_size);
+		for (size_t j = 0; j < block_size; ++j) check("Line", block_size, i + j, a.next(), out[j]);
+	}
+}
+
+static void testADSR(size_t k)
+{
+	const size_t block_size = block_sizes[k];
+	ADSR<CONTROL_RATE, AUDIO_RATE> & a = adsr_a[k], & b = adsr_b[k];
+	a.setADLevels(255, 100);
+	b.setADLevels(255, 100);
+	a.setTimes(20, 40, 60, 80);
+	b.setTimes(20, 40, 60, 80);
+	unsigned char out[MAX_BLOCK];
+	const long control_step = AUDIO_RATE / CONTROL_RATE;
+	for (long i = 0; i < NUM_SAMPLES * 4; ) {
+		if (i % (control_step * 64) == 0) {
+			a.noteOn();
+			b.noteOn();
+		}
+		a.update();
+		b.update();
+		// blocks never cross a control step, as in MozziGuts
+		for (long step_end = i + control_step; i < step_end; ) {
+			size_t n = (step_end - i < (long) block_size) ? step_end - i : block_size;
+			b.nextBlock(out, n);
+			for (size_t j = 0; j < n; ++j) check("ADSR", block_size, i + j, a.next(), out[j]);
+			i += n;
+		}
+	}
+}
+
+static void testLowPassFilter(size_t k)
+{
+	const size_t block_size = block_sizes[k];
+	LowPassFilter & a = lpf_a[k], & b = lpf_b[k];
+	int in[MAX_BLOCK], out[MAX_BLOCK];
+	for (long i = 0; i < NUM_SAMPLES; i += block_size) {
+		a.setCutoffFreqAndResonance((uint8_t) (i / 16), 200);
+		b.setCutoffFreqAndResonance((uint8_t) (i / 16), 200);
+		for (size_t j = 0; j < block_size; ++j) in[j] = input(i + j);
+		b.nextBlock(in, out, block_size);
+		for (size_t j = 0; j < block_size; ++j) check("LowPassFilter", block_size, i + j, a.next(in[j]), out[j]);
+	}
+}
+
+template <int8_t FILTER_TYPE>
+static void testStateVariable(const char * name, size_t block_size, StateVariable<FILTER_TYPE> & a, StateVariable<FILTER_TYPE> & b)
+{
+	a.setResonance(25);
+	b.setResonance(25);
+	int in[MAX_BLOCK], out[MAX_BLOCK];
+	for (long i = 0; i < NUM_SAMPLES; i += block_size) {
+		a.setCentreFreq(200 + i / 2);
+		b.setCentreFreq(200 + i / 2);
+		for (size_t j = 0; j < block_size; ++j) in[j] = input(i + j);
+		b.nextBlock(in, out, block_size);
+		for (size_t j = 0; j < block_size; ++j) check(name, block_size, i + j, a.next(in[j]), out[j]);
+	}
+}
+
+static void testAudioDelay(size_t k)
+{
+	const size_t block_size = block_sizes[k];
+	AudioDelay<256> & a = delay_a[k], & b = delay_b[k];
+	a.set(100);
+	b.set(100);
+	int8_t in[MAX_BLOCK], out[MAX_BLOCK];
+	for (long i = 0; i < NUM_SAMPLES; i += block_size) {
+		for (size_t j = 0; j < block_size; ++j) in[j] = (int8_t) input(i + j);
+		b.nextBlock(in, out, block_size);
+		for (size_t j = 0; j < block_size; ++j) check("AudioDelay", block_size, i + j, a.next(in[j]), out[j]);
+	}
+}
+
+int main()
+{
+	for (size_t k = 0; k < NUM_BLOCK_SIZES; ++k) {
+		size_t n = block_sizes[k];
+		testOscil(k);
+		testLine(k);
+		testADSR(k);
+		testLowPassFilter(k);
+		testStateVariable("StateVariable<LOWPASS>", n, svf_low_a[k], svf_low_b[k]);
+		testStateVariable("StateVariable<BANDPASS>", n, svf_band_a[k], svf_band_b[k]);
+		testStateVariable("StateVariable<HIGHPASS>", n, svf_high_a[k], svf_high_b[k]);
+		testStateVariable("StateVariable<NOTCH>", n, svf_notch_a[k], svf_notch_b[k]);
+		testAudioDelay(k);
+	}
+	if (failures) printf("%d samples differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * circular_buffer.cpp
+ *
+ * Checks CircularBuffer at a few sizes: full and empty, wrapping, count(),
+ * the watermarks and underruns.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+
+#include <Arduino.h>
+#include <CircularBuffer.h>
+
+static int failures = 0;
+
+#define CHECK(name, condition) \
+	do { if (!(condition)) { printf("size %u: %s: %s is false\n", (unsigned) N, name, #condition); ++failures; } } while (0)
+
+template <unsigned int N>
+static void test()
+{
+	static CircularBuffer<int, N> buffer;
+
+	CHECK("new", buffer.isEmpty());
+	CHECK("new", !buffer.isFull());
+	CHECK("new", buffer.count() == 0);
+
+	// reading before anything is written is start up, not an underrun
+	buffer.read();
+	CHECK("start up", buffer.underruns() == 0);
+
+	// fill it, it holds N-1
+	unsigned int n = 0;
+	while (!buffer.isFull()) buffer.write(n++);
+	CHECK("fill", n == N - 1);
+	CHECK("fill", buffer.available() == N - 1);
+	CHECK("fill", buffer.highWatermark() == N - 1);
+
+	// go round a few times, keeping it half full
+	int expected = 0;
+	bool in_order = true;
+	for (unsigned int i = 0; i < N / 2; ++i) in_order &= (buffer.read() == expected++);
+	for (unsigned int i = 0; i < 3 * N; ++i) {
+		buffer.write(n++);
+		in_order &= (buffer.read() == expected++);
+	}
+	CHECK("wrap", in_order);
+	CHECK("wrap", buffer.available() == N - 1 - N / 2);
+	CHECK("wrap", buffer.count() == (unsigned long) expected);
+	CHECK("wrap", buffer.lowWatermark() == N - 1 - N / 2);
+
+	// empty it, then underrun twice
+	while (!buffer.isEmpty()) in_order &= (buffer.read() == expected++);
+	CHECK("empty", in_order);
+	CHECK("empty", buffer.lowWatermark() == 0);
+	CHECK("empty", buffer.underruns() == 0);
+	CHECK("underrun", buffer.read() == expected - 1);
+	CHECK("underrun", buffer.read() == expected - 1);
+	CHECK("underrun", buffer.underruns() == 2);
+	CHECK("underrun", buffer.count() == (unsigned long) expected);
+
+	// the watermarks restart from what is in the buffer, and it still counts underruns
+	buffer.resetWatermarks();
+	CHECK("reset", buffer.underruns() == 0);
+	CHECK("reset", buffer.highWatermark() == 0);
+	CHECK("reset", buffer.lowWatermark() == 0);
+	buffer.read();
+	CHECK("reset", buffer.underruns() == 1);
+	buffer.write(1);
+	if (!buffer.isFull()) buffer.write(2);
+	CHECK("reset", buffer.highWatermark() == (N > 2 ? 2u : 1u));
+	buffer.resetWatermarks();
+	CHECK("reset", buffer.highWatermark() == buffer.available());
+	CHECK("reset", buffer.lowWatermark() == buffer.available());
+}
+
+int main()
+{
+	test<2>();
+	test<16>();
+	test<256>();
+	test<1024>();
+	if (failures) printf("%d checks failed\n", failures);
+	return failures ? 1 : 0;
+}
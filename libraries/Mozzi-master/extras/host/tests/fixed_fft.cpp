@@ -0,0 +1,117 @@
+/*
+ * fixed_fft.cpp
+ *
+ * Checks FixedFFT against a floating point DFT at every size, and that
+ * SpectrumAnalyser finds a sine wave in the right bin.
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "mozzi_host.h"
+#include <MozziGuts.h>
+#include <FixedFFT.h>
+#include <SpectrumAnalyser.h>
+
+// the core library calls these, the test doesn't use them
+void updateControl() {}
+AudioOutput_t updateAudio() { return MonoOutput::from8Bit(0); }
+
+static int failures = 0;
+
+template <unsigned int N>
+static void testTransform()
+{
+	static FixedFFT<N> fft;
+	static double in_re[N], in_im[N];
+	unsigned long seed = 12345;
+	for (unsigned int n = 0; n < N; ++n) {
+		// noise plus a couple of tones, within the +-16384 FixedFFT takes
+		seed = seed * 1103515245UL + 12345UL;
+		in_re[n] = 6000 * sin(2 * M_PI * 3 * n / N) + 4000 * cos(2 * M_PI * (N / 4 - 1) * n / N) + (long) ((seed >> 16) % 4000) - 2000;
+		in_im[n] = (long) ((seed >> 4) % 4000) - 2000;
+		fft.real()[n] = (int16_t) lrint(in_re[n]);
+		fft.imag()[n] = (int16_t) lrint(in_im[n]);
+		in_re[n] = fft.real()[n];
+		in_im[n] = fft.imag()[n];
+	}
+	fft.transform();
+
+	// the rounding in each butterfly adds up, by about a bit per stage
+	double max_error = 0;
+	for (unsigned int k = 0; k < N; ++k) {
+		double re = 0, im = 0;
+		for (unsigned int n = 0; n < N; ++n) {
+			const double a = -2 * M_PI * k * n / N;
+			re += in_re[n] * cos(a) - in_im[n] * sin(a);
+			im += in_re[n] * sin(a) + in_im[n] * cos(a);
+		}
+		max_error = fmax(max_error, fabs(re / N - fft.real()[k]));
+		max_error = fmax(max_error, fabs(im / N - fft.imag()[k]));
+	}
+	const double allowed = 1 + log2((double) N);
+	if (max_error > allowed) {
+		printf("FixedFFT<%u>: off by up to %.1f, more than %.1f\n", N, max_error, allowed);
+		++failures;
+	}
+}
+
+template <unsigned int N, uint8_t BITS = 10>
+static void testAnalyser(unsigned int bin)
+{
+	static SpectrumAnalyser<N, BITS> analyser;
+	const double freq = SpectrumAnalyser<N>::binFrequency(bin);
+	if (SpectrumAnalyser<N>::frequencyToBin((unsigned int) freq) != bin) {
+		printf("SpectrumAnalyser<%u>: bin %u is %.0f Hz, which maps back to bin %u\n", N, bin, freq, SpectrumAnalyser<N>::frequencyToBin((unsigned int) freq));
+		++failures;
+	}
+	for (unsigned int i = 0; i < 3 * N / 2; ++i) {
+		analyser.next((int) lrint(500.0 * (1 << BITS) / 1024 * sin(2 * M_PI * freq * i / AUDIO_RATE)));
+	}
+	if (!analyser.update()) {
+		printf("SpectrumAnalyser<%u>: no frame after %u samples\n", N, 3 * N / 2);
+		++failures;
+	}
+	if (analyser.update()) {
+		printf("SpectrumAnalyser<%u>: two frames from one\n", N);
+		++failures;
+	}
+	if (analyser.peakBin() != bin) {
+		printf("SpectrumAnalyser<%u>: a sine in bin %u peaks in bin %u\n", N, bin, analyser.peakBin());
+		++failures;
+	}
+	// a Hann window spreads a centred sine over 3 bins
+	const uint32_t total = analyser.bandPower(1, N / 2);
+	const uint32_t around = analyser.bandPower(bin - 1, bin + 1);
+	if (around < total - total / 100) {
+		printf("SpectrumAnalyser<%u>: only %lu of %lu power around bin %u\n", N, (unsigned long) around, (unsigned long) total, bin);
+		++failures;
+	}
+}
+
+int main()
+{
+	testTransform<4>();
+	testTransform<8>();
+	testTransform<16>();
+	testTransform<32>();
+	testTransform<64>();
+	testTransform<128>();
+	testTransform<256>();
+	testTransform<512>();
+	testTransform<1024>();
+
+	testAnalyser<64>(5);
+	testAnalyser<128>(17);
+	testAnalyser<1024>(300);
+	testAnalyser<128, 14>(17);
+	testAnalyser<128, 4>(17);
+
+	if (failures) printf("%d checks failed\n", failures);
+	return failures ? 1 : 0;
+}
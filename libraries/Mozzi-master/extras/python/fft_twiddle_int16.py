@@ -0,0 +1,37 @@
+## generates the quarter sine wave used for FFT twiddle factors and windows,
+## in Q15 (-32767 to 32767), with one extra cell at the end for sin(pi/2)
+
+
+import array
+import os
+import textwrap
+import math
+
+def generate(outfile, tablename, quarterlength):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* sin(2*pi*i/' + str(4*quarterlength) + ') in Q15, for i from 0 to ' + str(quarterlength) + ', see FixedFFT.h */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(quarterlength+1)+'\n')
+    fout.write('#define ' + tablename + '_PERIOD '+ str(4*quarterlength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(int16_t) ' + tablename + '_DATA [] = {'
+
+    try:
+        for num in range(quarterlength+1):
+            x = float(num)/(4*quarterlength)
+            scaled = int(round(32767*math.sin(2*math.pi*x)))
+            outstring += str(scaled) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+generate("~/Desktop/fft_twiddle1024_int16.h", "FFT_TWIDDLE1024", 256)
@@ -15,11 +15,12 @@
 #define IS_AVR() (defined(__AVR__))  // "Classic" Arduino boards
 #define IS_SAMD21() (defined(ARDUINO_ARCH_SAMD))
 #define IS_TEENSY3() (defined(__MK20DX128__) || defined(__MK20DX256__) || defined(__MK64FX512__) || defined(__MK66FX1M0__) || defined(__MKL26Z64__) )  // 32bit arm-based Teensy
-#define IS_STM32() (defined(__arm__) && !IS_TEENSY3() && !IS_SAMD21())  // STM32 boards (note that only the maple based core is supported at this time. If another cores is to be supported in the future, this define should be split.
+#define IS_STM32() (defined(__arm__) && !IS_TEENSY3() && !IS_SAMD21() && !IS_HOST())  // STM32 boards (note that only the maple based core is supported at this time. If another cores is to be supported in the future, this define should be split.
 #define IS_ESP8266() (defined(ESP8266))
 #define IS_ESP32() (defined(ESP32))
+#define IS_HOST() (defined(MOZZI_HOST))  // Offline rendering on a desktop machine, see extras/host
 
-#if !(IS_AVR() || IS_TEENSY3() || IS_STM32() || IS_ESP8266() || IS_SAMD21() || IS_ESP32())
+#if !(IS_AVR() || IS_TEENSY3() || IS_STM32() || IS_ESP8266() || IS_SAMD21() || IS_ESP32() || IS_HOST())
 #error Your hardware is not supported by Mozzi or not recognized. Edit hardware_defines.h to proceed.
 #endif
 
@@ -28,9 +29,11 @@
 #define NUM_ANALOG_INPUTS 16  // probably wrong, but mostly needed to allocate an array of readings
 #elif IS_ESP8266()
 #define NUM_ANALOG_INPUTS 1
+#elif IS_HOST()
+#define NUM_ANALOG_INPUTS 16
 #endif
 
-#if IS_AVR()
+#if IS_AVR() || IS_HOST()  // the host renders at the AVR rate by default, so sketches sound the same as on a Uno
 #define AUDIO_RATE_PLATFORM_DEFAULT 16384
 #else
 #define AUDIO_RATE_PLATFORM_DEFAULT 32768
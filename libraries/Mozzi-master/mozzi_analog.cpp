@@ -80,6 +80,8 @@ void setupMozziADC(int8_t speed) {
 	ADCSRA |= (1 << ADIE); // adc Enable Interrupt
 	setupFastAnalogRead(speed);
 	adcDisconnectAllDigitalIns();
+#elif IS_HOST()
+	// nothing to set up, the host reads its inputs directly
 #else
 #warning Fast ADC not implemented on this platform
 #endif
@@ -183,6 +185,8 @@ void adcStartConversion(uint8_t channel) {
 	// start the conversion
 	ADCSRA |= (1 << ADSC);
 #endif
+#elif IS_HOST()
+	// analog reads are synchronous on the host, see mozziAnalogRead()
 #else
 #warning Fast analog read not implemented on this platform
 #endif
@@ -230,6 +234,8 @@ int mozziAnalogRead(uint8_t pin) {
 #if IS_ESP8266() || IS_ESP32()
 #warning Asynchronouos analog reads not implemented for this platform
 	return analogRead(pin);
+#elif IS_HOST()
+	return analogRead(pin);
 #else
 // ADC lib converts pin/channel in startSingleRead
 #if IS_AVR()
@@ -99,6 +99,35 @@ compile time.
 #define AUDIO_CHANNELS MONO
 //#define AUDIO_CHANNELS STEREO
 
+/** @ingroup core
+Put \#define AUDIO_BLOCK_SIZE 32 (or another power of two, up to 256) in Mozzi/mozzi_config.h to render audio
+in blocks rather than one sample at a time.  Your sketch then provides
+updateAudioBlock(AudioOutput_t * out, size_t num_samples) instead of updateAudio(), and fills all of out[]
+in one go, typically using the nextBlock() functions of Oscil, ADSR, LowPassFilter, StateVariable and AudioDelay.
+This saves the per sample function call and state load/store overhead of the audio units, and lets the
+compiler unroll (and on some chips, vectorise) the inner loops, so you can fit more voices on ESP32, STM32 or SAMD.
+Blocks are split at control steps, so num_samples can be smaller than AUDIO_BLOCK_SIZE, and updateControl() is
+still called at CONTROL_RATE.  For exact timing, AUDIO_BLOCK_SIZE should divide AUDIO_RATE/CONTROL_RATE.
+Leave this undefined to keep using updateAudio().
+@note This costs AUDIO_BLOCK_SIZE samples of RAM and that much extra latency, so it is mostly useful on 32 bit boards.
+*/
+//#define AUDIO_BLOCK_SIZE 32
+
+/** @ingroup core
+The number of samples in the ring buffer between audioHook() and the audio output interrupt, a power of two.
+The default is 256 (at 16384 Hz, about 15 ms).  A bigger buffer rides out longer stalls in loop() or updateControl()
+without glitches, at the cost of that much more latency and RAM; a smaller one does the opposite.
+audioOutputBufferLowWatermark() and audioOutputUnderruns() show how close to empty the buffer really gets, to help you choose.
+On AVR the buffer can't be bigger than 256.  Not used with BYPASS_MOZZI_OUTPUT_BUFFER.
+*/
+//#define AUDIO_OUTPUT_BUFFER_SIZE 256
+
+/** @ingroup core
+The number of samples in the ring buffer for audio input, with USE_AUDIO_INPUT, a power of two.
+The default is 256, and on AVR it can't be bigger than that.
+*/
+//#define AUDIO_INPUT_BUFFER_SIZE 256
+
 /** @ingroup core
 Defining this option as true in mozzi_config.h allows to completely customize the audio output, e.g. for connecting to external DACs.
 For more detail, @see AudioOuput .
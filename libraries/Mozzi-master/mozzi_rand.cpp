@@ -144,6 +144,8 @@ void randSeed() {
 	x = RANDOM_REG32;
 	y = random (0xFFFFFFFF) ^ RANDOM_REG32;
 	z = random (0xFFFFFFFF) ^ RANDOM_REG32;
+#elif IS_HOST()
+	// keep the default seed, so offline renders are repeatable
 #else
 #warning Automatic random seeding not implemented on this platform
 #endif
@@ -10,6 +10,13 @@ RHDatagram::RHDatagram(RHGenericDriver& driver, uint8_t thisAddress)
     _driver(driver),
     _thisAddress(thisAddress)
 {
+#if RH_ENABLE_AGGREGATION
+    _aggregationLatency = 0;
+    _aggTxLen = 0;
+    _aggTxCount = 0;
+    _aggRxLen = 0;
+    _aggRxPos = 0;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -36,27 +43,146 @@ bool RHDatagram::sendto(uint8_t* buf, uint8_t len, uint8_t address)
     return _driver.send(buf, len);
 }
 
-bool RHDatagram::recvfrom(uint8_t* buf, uint8_t* len, uint8_t* from, uint8_t* to, uint8_t* id, uint8_t* flags)
+void RHDatagram::setAggregationLatency(uint16_t latency)
 {
-    if (_driver.recv(buf, len))
+#if RH_ENABLE_AGGREGATION
+    _aggregationLatency = latency;
+#else
+    (void)latency;
+#endif
+}
+
+bool RHDatagram::queueto(uint8_t* buf, uint8_t len, uint8_t address)
+{
+#if !RH_ENABLE_AGGREGATION
+    return sendAggregate(buf, len, address, RH_FLAGS_NONE);
+#else
+    bool ret = true;
+    uint8_t maxLen = _driver.maxMessageLength();
+#if RH_AGGREGATE_MAX_LEN < 255
+    if (maxLen > RH_AGGREGATE_MAX_LEN)
+	maxLen = RH_AGGREGATE_MAX_LEN;
+#endif
+
+    // Send what is queued first if this one is for somewhere else, or will not fit with it
+    if (_aggTxCount && (address != _aggTxAddress || _aggTxLen + 1 + len > maxLen))
+	ret = flushAggregate();
+    if (len + 1 > maxLen)
+	return sendAggregate(buf, len, address, RH_FLAGS_NONE) && ret;
+
+    if (!_aggTxCount)
     {
-	if (from)  *from =  headerFrom();
-	if (to)    *to =    headerTo();
-	if (id)    *id =    headerId();
-	if (flags) *flags = headerFlags();
+	_aggTxAddress = address;
+	_aggTxStart = millis();
+    }
+    _aggTxBuf[_aggTxLen++] = len;
+    memcpy(_aggTxBuf + _aggTxLen, buf, len);
+    _aggTxLen += len;
+    _aggTxCount++;
+
+    // Send now if there is no latency budget, or no room for another message
+    if (_aggregationLatency == 0 || _aggTxLen + 2 > maxLen)
+	ret = flushAggregate() && ret;
+    return ret;
+#endif
+}
+
+bool RHDatagram::pollAggregate()
+{
+#if RH_ENABLE_AGGREGATION
+    if (_aggTxCount && (millis() - _aggTxStart) >= _aggregationLatency)
+	return flushAggregate();
+#endif
+    return true;
+}
+
+bool RHDatagram::flushAggregate()
+{
+#if !RH_ENABLE_AGGREGATION
+    return true;
+#else
+    if (!_aggTxCount)
 	return true;
+    bool ret;
+    if (_aggTxCount == 1)
+	// Nothing to share the frame with: send it as an ordinary message
+	ret = sendAggregate(_aggTxBuf + 1, _aggTxLen - 1, _aggTxAddress, RH_FLAGS_NONE);
+    else
+	ret = sendAggregate(_aggTxBuf, _aggTxLen, _aggTxAddress, RH_FLAGS_AGGREGATE);
+    _aggTxLen = 0;
+    _aggTxCount = 0;
+    return ret;
+#endif
+}
+
+#if RH_ENABLE_AGGREGATION
+// Whether the len octets at buf are a whole aggregate: length octets and messages that fill it exactly
+static bool aggregateIsWhole(const uint8_t* buf, uint8_t len)
+{
+#if RH_AGGREGATE_MAX_LEN < 255
+    if (len > RH_AGGREGATE_MAX_LEN)
+	return false; // Did not fit in the buffer
+#endif
+    uint16_t pos = 0;
+    while (pos < len)
+	pos += 1 + buf[pos];
+    return len && pos == len;
+}
+#endif
+
+bool RHDatagram::recvfrom(uint8_t* buf, uint8_t* len, uint8_t* from, uint8_t* to, uint8_t* id, uint8_t* flags)
+{
+#if !RH_ENABLE_AGGREGATION
+    if (_driver.available() && (_driver.headerFlags() & RH_FLAGS_AGGREGATE))
+    {
+	// Can't take it apart: drop it, so it is not acknowledged as delivered
+	_driver.recv(NULL, NULL);
+	return false;
     }
-    return false;
+    return recvfromFrame(buf, len, from, to, id, flags);
+#else
+    if (!aggregatePending() && _driver.available() && (_driver.headerFlags() & RH_FLAGS_AGGREGATE))
+    {
+	// A new aggregate: keep it, and return its messages one at a time
+	uint8_t aggLen = sizeof(_aggRxBuf);
+	if (recvfromFrame(_aggRxBuf, &aggLen, &_aggRxFrom, &_aggRxTo, &_aggRxId, &_aggRxFlags))
+	{
+	    // Drop it if it was truncated or is too long, perhaps from a sender with a larger
+	    // RH_AGGREGATE_MAX_LEN, before any of it is delivered and so acknowledged
+	    if (!aggregateIsWhole(_aggRxBuf, aggLen))
+		return false;
+	    _aggRxLen = aggLen;
+	    _aggRxPos = 0;
+	}
+    }
+    if (!aggregatePending())
+	return recvfromFrame(buf, len, from, to, id, flags);
+
+    uint8_t msgLen = _aggRxBuf[_aggRxPos++];
+    if (buf && len)
+    {
+	if (*len > msgLen)
+	    *len = msgLen;
+	memcpy(buf, _aggRxBuf + _aggRxPos, *len);
+    }
+    _aggRxPos += msgLen;
+    if (from)  *from =  _aggRxFrom;
+    if (to)    *to =    _aggRxTo;
+    if (id)    *id =    _aggRxId;
+    if (flags) *flags = _aggRxFlags & ~RH_FLAGS_AGGREGATE;
+    return true;
+#endif
 }
 
 bool RHDatagram::available()
 {
-    return _driver.available();
+    return aggregatePending() || _driver.available();
 }
 
 void RHDatagram::waitAvailable()
 {
-    _driver.waitAvailable();
+    if (!aggregatePending())
+	_driver.waitAvailable();
 }
 
 bool RHDatagram::waitPacketSent()
@@ -71,7 +197,7 @@ bool RHDatagram::waitPacketSent(uint16_t timeout)
 
 bool RHDatagram::waitAvailableTimeout(uint16_t timeout)
 {
-    return _driver.waitAvailableTimeout(timeout);
+    return aggregatePending() || _driver.waitAvailableTimeout(timeout);
 }
 
 uint8_t RHDatagram::thisAddress()
@@ -119,5 +245,41 @@ uint8_t RHDatagram::headerFlags()
     return _driver.headerFlags();
 }
 
+////////////////////////////////////////////////////////////////////
+// Protected methods
+bool RHDatagram::sendAggregate(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags)
+{
+    setHeaderFlags(flags, RH_FLAGS_AGGREGATE);
+    bool ret = sendto(buf, len, address);
+    setHeaderFlags(RH_FLAGS_NONE, RH_FLAGS_AGGREGATE);
+    return ret;
+}
+
+bool RHDatagram::recvfromFrame(uint8_t* buf, uint8_t* len, uint8_t* from, uint8_t* to, uint8_t* id, uint8_t* flags)
+{
+    if (_driver.recv(buf, len))
+    {
+	if (from)  *from =  headerFrom();
+	if (to)    *to =    headerTo();
+	if (id)    *id =    headerId();
+	if (flags) *flags = headerFlags();
+	return true;
+    }
+    return false;
+}
 
+bool RHDatagram::aggregatePending()
+{
+#if RH_ENABLE_AGGREGATION
+    return _aggRxPos < _aggRxLen;
+#else
+    return false;
+#endif
+}
 
+void RHDatagram::discardAggregate()
+{
+#if RH_ENABLE_AGGREGATION
+    _aggRxPos = _aggRxLen = 0;
+#endif
+}
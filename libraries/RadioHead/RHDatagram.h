@@ -12,6 +12,28 @@
 // Not all radios support this length, and many are much smaller
 #define RH_MAX_MESSAGE_LEN 255
 
+// Set in the FLAGS header of a frame that carries several datagrams aggregated by RHDatagram::queueto()
+#define RH_FLAGS_AGGREGATE 0x10
+
+// Set this to 1, here or in the compiler flags, to build RHDatagram with queueto() aggregation.
+// It costs each instance of RHDatagram, and of each manager built on it, two buffers of
+// RH_AGGREGATE_MAX_LEN octets, so it is off unless asked for. See the Aggregation section below.
+#ifndef RH_ENABLE_AGGREGATION
+ #define RH_ENABLE_AGGREGATION 0
+#endif
+
+// The longest aggregate frame RHDatagram will assemble or take apart. There is one buffer of this
+// size for sending and one for receiving in each instance, so it is kept small on small Arduinos.
+// You can define it to be different before including this file, but all nodes that
+// exchange aggregates must agree.
+#ifndef RH_AGGREGATE_MAX_LEN
+ #if (RH_PLATFORM == RH_PLATFORM_ARDUINO) && !defined(__arm__)
+  #define RH_AGGREGATE_MAX_LEN 32
+ #else
+  #define RH_AGGREGATE_MAX_LEN RH_MAX_MESSAGE_LEN
+ #endif
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHDatagram RHDatagram.h <RHDatagram.h>
 /// \brief Manager class for addressed, unreliable messages
@@ -41,6 +63,31 @@
 /// -ID A message ID, distinct (over short time scales) for each message sent by a particilar node
 /// -FLAGS A bitmask of flags. The most significant 4 bits are reserved for use by RadioHead. The least
 /// significant 4 bits are reserved for applications.
+///
+/// \par Aggregation
+///
+/// Every frame pays for the preamble, sync word, headers and CRC, and with RHReliableDatagram an ACK too,
+/// which for short messages is far more airtime than the message itself. Datagrams sent with queueto() 
+/// instead of sendto() are held and coalesced into one frame with any others queued to the same address,
+/// up to the smaller of driver->maxMessageLength() and RH_AGGREGATE_MAX_LEN. The frame is transmitted when
+/// it is full, when a datagram for another address is queued, when flushAggregate() is called, or when 
+/// pollAggregate() finds the oldest datagram in it has waited for the latency set by setAggregationLatency().
+/// Call pollAggregate() frequently, such as in your main loop.
+///
+/// An aggregate frame has RH_FLAGS_AGGREGATE set in FLAGS, and carries each datagram as a length 
+/// octet followed by the data. A lone queued datagram is sent as an ordinary frame.
+/// recvfrom() takes received aggregates apart and returns their datagrams one per call, each with
+/// the headers of the frame, so receivers need no changes other than being built
+/// with a version of RadioHead that understands aggregates. RHReliableDatagram sends an aggregate 
+/// with sendtoWait(), so it is acknowledged and retransmitted as one message. An aggregate whose length
+/// octets do not add up to the length of the frame, such as one longer than RH_AGGREGATE_MAX_LEN, is dropped
+/// before any of it is delivered, so RHReliableDatagram does not acknowledge it and the sender retransmits it.
+///
+/// Aggregation is only built when RH_ENABLE_AGGREGATION is 1. Otherwise queueto() sends each datagram
+/// at once, as sendto() does, and received aggregate frames are dropped unacknowledged.
+/// Nodes built with an older version of RadioHead cannot take RH_FLAGS_AGGREGATE frames apart: they deliver the
+/// whole frame, length octets and all, as one message. Only call queueto() in a network where all
+/// nodes that may receive its frames understand aggregates, and use sendto() in mixed networks.
 class RHDatagram
 {
 public:
@@ -69,6 +116,31 @@ public:
     /// \return true if the message not too loing fot eh driver, and the message was transmitted.
     bool sendto(uint8_t* buf, uint8_t len, uint8_t address);
 
+    /// Sets how long a datagram queued by queueto() may wait for others to the same address 
+    /// before pollAggregate() transmits them.
+    /// \param[in] latency The latency budget in milliseconds. 0 (the default) makes queueto() transmit at once.
+    void setAggregationLatency(uint16_t latency);
+
+    /// Queues a message for the node(s) with the given address, to be transmitted in one frame with
+    /// others queued to the same address. See the Aggregation section above. Queued messages are not
+    /// copied anywhere else, and are lost if the node is reset before they are transmitted.
+    /// If the message is too long to share a frame, it is transmitted on its own, after anything already queued.
+    /// \param[in] buf Pointer to the binary message to send
+    /// \param[in] len Number of octets to send
+    /// \param[in] address The address to send the message to.
+    /// \return false if a frame transmitted by this call failed (with RHReliableDatagram, was not 
+    /// acknowledged). This may have been an aggregate of messages queued earlier.
+    bool queueto(uint8_t* buf, uint8_t len, uint8_t address);
+
+    /// Transmits the queued aggregate if its oldest message has waited for the 
+    /// latency set by setAggregationLatency(). Call this frequently.
+    /// \return false if an aggregate was transmitted and failed, else true.
+    bool pollAggregate();
+
+    /// Transmits the queued aggregate now, if there is one.
+    /// \return false if an aggregate was transmitted and failed, else true.
+    bool flushAggregate();
+
     /// Turns the receiver on if it not already on.
     /// If there is a valid message available for this node, copy it to buf and return true
     /// The SRC address is placed in *from if present and not NULL.
@@ -84,6 +156,8 @@ public:
     /// \param[in] flags If present and not NULL, the referenced uint8_t will be set to the FLAGS
     /// (not just those addressed to this node).
     /// \return true if a valid message was copied to buf
+    /// If the message came in an aggregate frame, it is the next one from that frame, and RH_FLAGS_AGGREGATE
+    /// is cleared in *flags.
     bool recvfrom(uint8_t* buf, uint8_t* len, uint8_t* from = NULL, uint8_t* to = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
 
     /// Tests whether a new message is available
@@ -91,7 +165,8 @@ public:
     /// On most drivers, this will also put the Driver into RHModeRx mode until
     /// a message is actually received bythe transport, when it will be returned to RHModeIdle.
     /// This can be called multiple times in a timeout loop.
-    /// \return true if a new, complete, error-free uncollected message is available to be retreived by recv()
+    /// \return true if a new, complete, error-free uncollected message is available to be retreived by recv(),
+    /// or there are messages left from an aggregate frame
     bool            available();
 
     /// Starts the Driver receiver and blocks until a valid received 
@@ -151,11 +226,72 @@ public:
     uint8_t         thisAddress();
 
 protected:
+    /// Transmits a frame assembled by queueto(). Subclasses override this to transmit the 
+    /// way their own messages are, such as with acknowledgement.
+    /// \param[in] buf Pointer to the frame
+    /// \param[in] len Number of octets in the frame
+    /// \param[in] address The address to send it to.
+    /// \param[in] flags RH_FLAGS_AGGREGATE for an aggregate, or RH_FLAGS_NONE for a single message
+    /// \return true if the frame was transmitted
+    virtual bool    sendAggregate(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags);
+
+    /// Receives the next frame from the driver as it is, even if it is an aggregate and even if
+    /// there are messages left from an earlier aggregate. Parameters are as for recvfrom().
+    /// \return true if a frame was copied to buf
+    bool            recvfromFrame(uint8_t* buf, uint8_t* len, uint8_t* from = NULL, uint8_t* to = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
+
+    /// Tests whether there are messages left from a received aggregate frame
+    /// \return true if the next recvfrom() will return one of them
+    bool            aggregatePending();
+
+    /// Discards any messages left from a received aggregate frame
+    void            discardAggregate();
+
     /// The Driver we are to use
     RHGenericDriver&        _driver;
 
     /// The address of this node
     uint8_t         _thisAddress;
+
+#if RH_ENABLE_AGGREGATION
+private:
+    /// Latency budget for queued messages in milliseconds, 0 for none
+    uint16_t        _aggregationLatency;
+
+    /// The aggregate being assembled: a length octet and the data for each message
+    uint8_t         _aggTxBuf[RH_AGGREGATE_MAX_LEN];
+
+    /// Number of octets in _aggTxBuf
+    uint8_t         _aggTxLen;
+
+    /// Number of messages in _aggTxBuf
+    uint8_t         _aggTxCount;
+
+    /// Where the aggregate being assembled is going
+    uint8_t         _aggTxAddress;
+
+    /// millis() when the first message was queued in _aggTxBuf
+    unsigned long   _aggTxStart;
+
+    /// The aggregate being taken apart. Where frames can be longer, an octet to spare tells one that is too long
+#if RH_AGGREGATE_MAX_LEN < 255
+    uint8_t         _aggRxBuf[RH_AGGREGATE_MAX_LEN + 1];
+#else
+    uint8_t         _aggRxBuf[RH_AGGREGATE_MAX_LEN];
+#endif
+
+    /// Number of octets in _aggRxBuf
+    uint8_t         _aggRxLen;
+
+    /// Offset of the next message in _aggRxBuf
+    uint8_t         _aggRxPos;
+
+    /// Headers of the aggregate being taken apart
+    uint8_t         _aggRxFrom;
+    uint8_t         _aggRxTo;
+    uint8_t         _aggRxId;
+    uint8_t         _aggRxFlags;
+#endif
 };
 
 #endif
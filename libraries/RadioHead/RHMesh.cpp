@@ -13,18 +13,34 @@
 
 #include <RHMesh.h>
 
-uint8_t RHMesh::_tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
-
 ////////////////////////////////////////////////////////////////////
 // Constructors
 RHMesh::RHMesh(RHGenericDriver& driver, uint8_t thisAddress) 
     : RHRouter(driver, thisAddress)
 {
+    _rebroadcastJitter = RH_MESH_DEFAULT_REBROADCAST_JITTER;
+    setExpandingRing(RH_MESH_DEFAULT_RING_TTL_START, RH_MESH_DEFAULT_RING_TTL_THRESHOLD);
+    memset(_requestCacheSource, RH_BROADCAST_ADDRESS, sizeof(_requestCacheSource));
+    _requestCacheNext = 0;
 }
 
 ////////////////////////////////////////////////////////////////////
 // Public methods
 
+////////////////////////////////////////////////////////////////////
+void RHMesh::setRebroadcastJitter(uint16_t jitter)
+{
+    _rebroadcastJitter = jitter;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHMesh::setExpandingRing(uint8_t ttlStart, uint8_t ttlThreshold, uint16_t hopTimeout)
+{
+    _ringTtlStart = ttlStart;
+    _ringTtlThreshold = ttlThreshold;
+    _ringHopTimeout = hopTimeout;
+}
+
 ////////////////////////////////////////////////////////////////////
 // Discovers a route to the destination (if necessary), sends and 
 // waits for delivery to the next hop (but not for delivery to the final destination)
@@ -51,36 +67,48 @@ uint8_t RHMesh::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address, uint8_t f
 bool RHMesh::doArp(uint8_t address)
 {
     // Need to discover a route
-    // Broadcast a route discovery message with nothing in it
-    MeshRouteDiscoveryMessage* p = (MeshRouteDiscoveryMessage*)&_tmpMessage;
-    p->header.msgType = RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST;
-    p->destlen = 1; 
-    p->dest = address; // Who we are looking for
-    uint8_t error = RHRouter::sendtoWait((uint8_t*)p, sizeof(RHMesh::MeshMessageHeader) + 2, RH_BROADCAST_ADDRESS);
-    if (error !=  RH_ROUTER_ERROR_NONE)
-	return false;
-    
-    // Wait for a reply, which will be unicast back to us
-    // It will contain the complete route to the destination
-    uint8_t messageLen = sizeof(_tmpMessage);
-    // FIXME: timeout should be configurable
-    unsigned long starttime = millis();
-    while ((millis() - starttime) < 4000)
+    // Broadcast route discovery messages with nothing in them, each going further than the last,
+    // until one gets a reply
+    uint8_t ttl = _ringTtlStart;
+    while (1)
     {
-	if (RHRouter::recvfromAck(_tmpMessage, &messageLen))
+	// 0 is no limit
+	if (ttl > _ringTtlThreshold || ttl >= _max_hops)
+	    ttl = 0;
+	MeshRouteDiscoveryMessage* p = (MeshRouteDiscoveryMessage*)&_tmpMessage;
+	p->header.msgType = RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST;
+	p->destlen = 1; 
+	p->dest = address; // Who we are looking for
+	uint8_t error = RHRouter::sendtoWait((uint8_t*)p, sizeof(RHMesh::MeshMessageHeader) + 2, RH_BROADCAST_ADDRESS, ttl);
+	if (error !=  RH_ROUTER_ERROR_NONE)
+	    return false;
+    
+	// Wait for a reply, which will be unicast back to us
+	// It will contain the complete route to the destination
+	// FIXME: network wide timeout should be configurable
+	unsigned long timeout = ttl ? (unsigned long)_ringHopTimeout * ttl * 2 : RH_MESH_DISCOVERY_TIMEOUT;
+	unsigned long starttime = millis();
+	while ((millis() - starttime) < timeout)
 	{
-	    if (   messageLen > 1
-		&& p->header.msgType == RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE)
+	    uint8_t messageLen = sizeof(_tmpMessage);
+	    if (RHRouter::recvfromAck(_tmpMessage, &messageLen))
 	    {
-		// Got a reply, now add the next hop to the dest to the routing table
-		// The first hop taken is the first octet
-		addRouteTo(address, headerFrom());
-		return true;
+		if (   messageLen > 1
+		    && p->header.msgType == RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE
+		    && p->dest == address)
+		{
+		    // Got a reply, now add the next hop to the dest to the routing table
+		    // The first hop taken is the first octet
+		    addRouteTo(address, headerFrom(), Valid, messageLen - sizeof(MeshMessageHeader) - 1, _driver.lastRssi());
+		    return true;
+		}
 	    }
+	    YIELD;
 	}
-	YIELD;
+	if (!ttl)
+	    return false;
+	ttl = ttl * 2;
     }
-    return false;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -95,16 +123,18 @@ void RHMesh::peekAtMessage(RoutedMessage* message, uint8_t messageLen)
 	// being routed back to the originator here. Want to scrape some routing data out of the response
 	// We can find the routes to all the nodes between here and the responding node
 	MeshRouteDiscoveryMessage* d = (MeshRouteDiscoveryMessage*)message->data;
-	addRouteTo(d->dest, headerFrom());
 	uint8_t numRoutes = messageLen - sizeof(RoutedMessageHeader) - sizeof(MeshMessageHeader) - 2;
+	int8_t rssi = _driver.lastRssi();
 	uint8_t i;
-	// Find us in the list of nodes that were traversed to get to the responding node
+	// Find us in the list of nodes that were traversed to get to the responding node.
+	// The originator is not in the list
 	for (i = 0; i < numRoutes; i++)
 	    if (d->route[i] == _thisAddress)
 		break;
-	i++;
-	while (i++ < numRoutes)
-	    addRouteTo(d->route[i], headerFrom());
+	uint8_t first = (i < numRoutes) ? i + 1 : 0;
+	learnRouteTo(d->dest, headerFrom(), numRoutes + 1 - first, rssi);
+	for (i = first; i < numRoutes; i++)
+	    learnRouteTo(d->route[i], headerFrom(), i + 1 - first, rssi);
     }
     else if (   messageLen > 1 
 	     && m->msgType == RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE)
@@ -147,6 +177,35 @@ bool RHMesh::isPhysicalAddress(uint8_t* address, uint8_t addresslen)
     return addresslen == 1 && address[0] == _thisAddress;
 }
 
+////////////////////////////////////////////////////////////////////
+void RHMesh::learnRouteTo(uint8_t dest, uint8_t next_hop, uint8_t hops, int8_t quality)
+{
+    // Keep a route we already have if it is better. Each hop counts as much as RH_MESH_DB_PER_HOP
+    // of the RSSI from the next hop, so a route with an extra hop but a next hop that is
+    // heard much better is preferred
+    RoutingTableEntry* route = getRouteTo(dest);
+    if (   !route
+	|| route->state != Valid
+	|| route->next_hop == next_hop
+	|| !route->hops
+	|| (int16_t)quality - RH_MESH_DB_PER_HOP * hops > (int16_t)route->quality - RH_MESH_DB_PER_HOP * route->hops)
+	addRouteTo(dest, next_hop, Valid, hops, quality);
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHMesh::seenRequest(uint8_t source, uint8_t id)
+{
+    uint8_t i;
+    for (i = 0; i < RH_MESH_REQUEST_CACHE_SIZE; i++)
+	if (_requestCacheSource[i] == source && _requestCacheId[i] == id)
+	    return true;
+    // Remember it in place of the oldest
+    _requestCacheSource[_requestCacheNext] = source;
+    _requestCacheId[_requestCacheNext] = id;
+    _requestCacheNext = (_requestCacheNext + 1) % RH_MESH_REQUEST_CACHE_SIZE;
+    return false;
+}
+
 ////////////////////////////////////////////////////////////////////
 bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* dest, uint8_t* id, uint8_t* flags)
 {     
@@ -194,9 +253,13 @@ bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* d
 		    return false; // Already been through us. Discard
 	    
 	    // Hasnt been past us yet, record routes back to the earlier nodes
-	    addRouteTo(_source, headerFrom()); // The originator
+	    int8_t rssi = _driver.lastRssi();
+	    learnRouteTo(_source, headerFrom(), numRoutes + 1, rssi); // The originator
 	    for (i = 0; i < numRoutes; i++)
-		addRouteTo(d->route[i], headerFrom());
+		learnRouteTo(d->route[i], headerFrom(), numRoutes - i, rssi);
+	    // Have we had this one by another path? Then we have replied to it or rebroadcast it already
+	    if (seenRequest(_source, _id))
+		return false;
 	    if (isPhysicalAddress(&d->dest, d->destlen))
 	    {
 		// This route discovery is for us. Unicast the whole route back to the originator
@@ -205,14 +268,18 @@ bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* d
 		d->header.msgType = RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE;
 		RHRouter::sendtoWait((uint8_t*)d, tmpMessageLen, _source);
 	    }
-	    else if (i < _max_hops)
+	    else if (i < _max_hops && (!_flags || numRoutes + 1 < _flags))
 	    {
-		// Its for someone else, rebroadcast it, after adding ourselves to the list
+		// Its for someone else, and may go further (FLAGS is the TTL, 0 for no limit).
+		// Rebroadcast it, after adding ourselves to the list
 		d->route[numRoutes] = _thisAddress;
 		tmpMessageLen++;
-		// Have to impersonate the source
+		// Dont all rebroadcast it at once
+		if (_rebroadcastJitter)
+		    delay(random(0, _rebroadcastJitter));
+		// Have to impersonate the source, and keep its ID and TTL
 		// REVISIT: if this fails what can we do?
-		RHRouter::sendtoFromSourceWait(_tmpMessage, tmpMessageLen, RH_BROADCAST_ADDRESS, _source);
+		RHRouter::sendtoFromSourceIdWait(_tmpMessage, tmpMessageLen, RH_BROADCAST_ADDRESS, _source, _id, _flags);
 	    }
 	}
     }
@@ -15,6 +15,28 @@
 #define RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE       2
 #define RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE                  3
 
+// Number of recent route discovery requests each node remembers, so it handles each only once
+#define RH_MESH_REQUEST_CACHE_SIZE 8
+
+// Default maximum random delay in milliseconds before rebroadcasting a route discovery request
+#define RH_MESH_DEFAULT_REBROADCAST_JITTER 100
+
+// Time in milliseconds to wait for a reply to a route discovery request that may go anywhere in the network
+#define RH_MESH_DISCOVERY_TIMEOUT 4000
+
+// Default time in milliseconds to wait for each hop of a route discovery request limited by 
+// the expanding ring search, there and back
+#define RH_MESH_DEFAULT_RING_HOP_TIMEOUT 250
+
+// When choosing between routes to a node, each hop counts as much as this many dB of the RSSI
+// of the next hop
+#define RH_MESH_DB_PER_HOP 3
+
+// Defaults for the expanding ring search: the first search is this many hops
+#define RH_MESH_DEFAULT_RING_TTL_START 1
+// and the search is network wide after this many hops
+#define RH_MESH_DEFAULT_RING_TTL_THRESHOLD 3
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHMesh RHMesh.h <RHMesh.h>
 /// \brief RHRouter subclass for sending addressed, optionally acknowledged datagrams
@@ -46,6 +68,22 @@
 /// If a node receives a RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST that already has itself 
 /// listed in the visited nodes, it knows it has already seen and rebroadcast this request, 
 /// and threfore ignores it. This prevents broadcast storms.
+/// Each node also remembers the SOURCE and ID of the last RH_MESH_REQUEST_CACHE_SIZE requests it has 
+/// handled, and does not reply to or rebroadcast further copies of them that reach it by other paths,
+/// though it may learn better routes from them. Without this, a node would rebroadcast a request
+/// once for every path to it, and in a large mesh the copies would use most of the airtime.
+/// Before rebroadcasting a request, a node waits a random time up to the rebroadcast jitter 
+/// (see setRebroadcastJitter()), so that the neighbours that all heard the same request do not 
+/// all rebroadcast it at the same moment, and collide.
+///
+/// Route discovery uses an expanding ring search: the first request only goes 
+/// RH_MESH_DEFAULT_RING_TTL_START hops from the requester. If no reply comes, the next goes twice as far, 
+/// and so on, until the requests go further than RH_MESH_DEFAULT_RING_TTL_THRESHOLD hops, when
+/// one last request goes anywhere in the network. So finding a nearby node does not flood the 
+/// whole network. See setExpandingRing(). The hop limit (TTL) is carried in the FLAGS of the request. 
+/// 0 means no limit, so nodes with earlier versions of RHMesh, which send 0, and relay requests 
+/// with 0, still work with these.
+///
 /// When a node receives a RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST it can use the list of 
 /// nodes aready visited to deduce routes back towards the originating (requesting node). 
 /// This also means that when the destination node of the request is reached, it (and all 
@@ -64,7 +102,11 @@
 ///
 /// Note that there is a race condition here that can effect routing on multipath routes. For example, 
 /// if the route to the destination can traverse several paths, last reply from the destination 
-/// will be the one used.
+/// will be the one used. Since nodes handle only the first copy of each request they get, 
+/// which has usually taken the fewest hops, usually there is only one reply.
+///
+/// The routes learned from requests and replies record the number of hops to the destination
+/// and the RSSI of the message they were learned from. See RHRouter::RoutingTableEntry.
 ///
 /// \par Route Failure
 ///
@@ -144,6 +186,23 @@ public:
     /// \param[in] thisAddress The address to assign to this node. Defaults to 0
     RHMesh(RHGenericDriver& driver, uint8_t thisAddress = 0);
 
+    /// Sets the maximum random delay before this node rebroadcasts a route discovery request.
+    /// It should be a few times the time it takes to transmit a short message with your radio 
+    /// and modulation, so that neighbours rebroadcasting the same request are unlikely to collide.
+    /// \param[in] jitter The maximum delay in milliseconds. Defaults to RH_MESH_DEFAULT_REBROADCAST_JITTER. 
+    /// 0 rebroadcasts at once
+    void setRebroadcastJitter(uint16_t jitter);
+
+    /// Sets up the expanding ring search used to discover routes.
+    /// \param[in] ttlStart The number of hops the first route discovery request may go. 
+    /// 0 disables the expanding ring search, so every request may go anywhere in the network
+    /// \param[in] ttlThreshold If the number of hops would be more than this, the request may 
+    /// go anywhere in the network instead
+    /// \param[in] hopTimeout The time in milliseconds to wait for a reply for each hop the
+    /// request may go. Should allow for the rebroadcast jitter and the transmission of
+    /// the request and the reply
+    void setExpandingRing(uint8_t ttlStart, uint8_t ttlThreshold, uint16_t hopTimeout = RH_MESH_DEFAULT_RING_HOP_TIMEOUT);
+
     /// Sends a message to the destination node. Initialises the RHRouter message header 
     /// (the SOURCE address is set to the address of this node, HOPS to 0) and calls 
     /// route() which looks up in the routing table the next hop to deliver to.
@@ -220,7 +279,8 @@ protected:
     virtual uint8_t route(RoutedMessage* message, uint8_t messageLen);
 
     /// Try to resolve a route for the given address. Blocks while discovering the route
-    /// which may take up to 4000 msec.
+    /// which may take up to RH_MESH_DISCOVERY_TIMEOUT (4000) msec, plus the time taken by 
+    /// the expanding ring search.
     /// Virtual so subclasses can override.
     /// \param [in] address The physical address to resolve
     /// \return true if the address was resolved and added to the local routing table
@@ -238,9 +298,42 @@ protected:
     /// \return true if the physical address of this node is identical to address
     virtual bool isPhysicalAddress(uint8_t* address, uint8_t addresslen);
 
+    /// Adds a route learned from a route discovery request or reply to the local routing table,
+    /// unless there is already a better route to dest. Each hop counts as much as 
+    /// RH_MESH_DB_PER_HOP of quality.
+    /// \param [in] dest The destination node address
+    /// \param [in] next_hop The address of the next hop to send messages destined for dest
+    /// \param [in] hops The number of hops to dest
+    /// \param [in] quality The RSSI of the message the route was learned from
+    void learnRouteTo(uint8_t dest, uint8_t next_hop, uint8_t hops, int8_t quality);
+
+    /// Tests whether this node has already handled a route discovery request, and remembers it if not.
+    /// \param [in] source The originator of the request
+    /// \param [in] id The end to end ID of the request
+    /// \return true if the request has been handled already
+    bool seenRequest(uint8_t source, uint8_t id);
+
+    /// Maximum random delay before rebroadcasting a route discovery request
+    uint16_t _rebroadcastJitter;
+
+    /// Number of hops the first route discovery request may go, or 0 for no limit
+    uint8_t  _ringTtlStart;
+
+    /// The number of hops after which route discovery requests may go anywhere
+    uint8_t  _ringTtlThreshold;
+
+    /// Time to wait for each hop of a route discovery request limited by the expanding ring search
+    uint16_t _ringHopTimeout;
+
 private:
-    /// Temporary message buffer
-    static uint8_t _tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
+    /// Temporary message buffer. One for each instance, so several nodes can run in one process,
+    /// as they do in tools/netSimulator.cpp
+    uint8_t _tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
+
+    /// SOURCE and ID of recent route discovery requests, most recent at _requestCacheNext - 1
+    uint8_t _requestCacheSource[RH_MESH_REQUEST_CACHE_SIZE];
+    uint8_t _requestCacheId[RH_MESH_REQUEST_CACHE_SIZE];
+    uint8_t _requestCacheNext;
 
 };
 
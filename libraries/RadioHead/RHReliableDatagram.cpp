@@ -45,6 +45,12 @@ uint8_t RHReliableDatagram::retries()
 
 ////////////////////////////////////////////////////////////////////
 bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
+{
+    return sendtoWaitFlags(buf, len, address, RH_FLAGS_NONE);
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::sendtoWaitFlags(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags)
 {
     // Assemble the message
     uint8_t thisSequenceNumber = ++_lastSequenceNumber;
@@ -52,7 +58,7 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
     while (retries++ <= _retries)
     {
 	setHeaderId(thisSequenceNumber);
-	setHeaderFlags(RH_FLAGS_NONE, RH_FLAGS_ACK); // Clear the ACK flag
+	setHeaderFlags(flags, RH_FLAGS_ACK | RH_FLAGS_AGGREGATE); // Clear the ACK flag, and set aggregate only if asked
 	sendto(buf, len, address);
 	waitPacketSent();
 
@@ -70,21 +76,22 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
 	uint16_t timeout = _timeout + (_timeout * random(0, 256) / 256);
         while ((millis() - thisSendTime) < timeout)
 	{
-	    if (available())
+	    // Only look at new frames, so messages left from a received aggregate are not discarded
+	    if (_driver.available())
 	    {
-		uint8_t from, to, id, flags;
-		if (recvfrom(0, 0, &from, &to, &id, &flags)) // Discards the message
+		uint8_t from, to, id, rxFlags;
+		if (recvfromFrame(0, 0, &from, &to, &id, &rxFlags)) // Discards the message
 		{
 		    // Now have a message: is it our ACK?
 		    if (   from == address 
 			   && to == _thisAddress 
-			   && (flags & RH_FLAGS_ACK) 
+			   && (rxFlags & RH_FLAGS_ACK) 
 			   && (id == thisSequenceNumber))
 		    {
 			// Its the ACK we are waiting for
 			return true;
 		    }
-		    else if (   !(flags & RH_FLAGS_ACK)
+		    else if (   !(rxFlags & RH_FLAGS_ACK)
 				&& (id == _seenIds[from]))
 		    {
 			// This is a request we have already received. ACK it again
@@ -110,9 +117,19 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
     uint8_t _to;
     uint8_t _id;
     uint8_t _flags;
+    // Messages after the first in an aggregate were acknowledged with it
+    bool aggregated = aggregatePending();
     // Get the message before its clobbered by the ACK (shared rx and tx buffer in RH
     if (available() && recvfrom(buf, len, &_from, &_to, &_id, &_flags))
     {
+	if (aggregated)
+	{
+	    if (from)  *from =  _from;
+	    if (to)    *to =    _to;
+	    if (id)    *id =    _id;
+	    if (flags) *flags = _flags;
+	    return true;
+	}
 	// Never ACK an ACK
 	if (!(_flags & RH_FLAGS_ACK))
 	{
@@ -133,7 +150,8 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
 		_seenIds[_from] = _id;
 		return true;
 	    }
-	    // Else just re-ack it and wait for a new one
+	    // Else just re-ack it and wait for a new one, ignoring the rest of it if it was an aggregate
+	    discardAggregate();
 	}
     }
     // No message for us available
@@ -165,7 +183,7 @@ void RHReliableDatagram::resetRetransmissions()
 void RHReliableDatagram::acknowledge(uint8_t id, uint8_t from)
 {
     setHeaderId(id);
-    setHeaderFlags(RH_FLAGS_ACK);
+    setHeaderFlags(RH_FLAGS_ACK, RH_FLAGS_AGGREGATE);
     // We would prefer to send a zero length ACK,
     // but if an RH_RF22 receives a 0 length message with a CRC error, it will never receive
     // a 0 length message again, until its reset, which makes everything hang :-(
@@ -176,3 +194,8 @@ void RHReliableDatagram::acknowledge(uint8_t id, uint8_t from)
     waitPacketSent();
 }
 
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::sendAggregate(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags)
+{
+    return sendtoWaitFlags(buf, len, address, flags);
+}
@@ -59,6 +59,9 @@
 /// This will be recognised as "pure ALOHA". 
 /// The addition of Clear Channel Assessment (CCA) is desirable and planned.
 ///
+/// Messages queued with RHDatagram::queueto() are sent by sendtoWait() as one aggregate frame,
+/// which is acknowledged once, and when received are returned one at a time by recvfromAck().
+///
 /// There is no message queuing or threading in RHReliableDatagram. 
 /// sendtoWait() waits until an acknowledgement is received, retransmitting
 /// up to (by default) 3 retries time with a default 200ms timeout. 
@@ -159,12 +162,20 @@ protected:
     /// Blocks until the ACK has been sent
     void acknowledge(uint8_t id, uint8_t from);
 
+    /// Sends an aggregate assembled by RHDatagram::queueto() with sendtoWait(), so it
+    /// is acknowledged and retransmitted as one message
+    /// \return true if an acknowledgement was received
+    virtual bool sendAggregate(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags);
+
     /// Checks whether the message currently in the Rx buffer is a new message, not previously received
     /// based on the from address and the sequence.  If it is new, it is acknowledged and returns true
     /// \return true if there is a message received and it is a new message
     bool haveNewMessage();
 
 private:
+    /// sendtoWait(), with the given RadioHead FLAGS (RH_FLAGS_AGGREGATE or RH_FLAGS_NONE) set
+    bool sendtoWaitFlags(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags);
+
     /// Count of retransmissions we have had to send
     uint32_t _retransmissions;
 
@@ -13,8 +13,6 @@
 
 #include <RHRouter.h>
 
-RHRouter::RoutedMessage RHRouter::_tmpMessage;
-
 ////////////////////////////////////////////////////////////////////
 // Constructors
 RHRouter::RHRouter(RHGenericDriver& driver, uint8_t thisAddress) 
@@ -41,65 +39,82 @@ void RHRouter::setMaxHops(uint8_t max_hops)
 }
 
 ////////////////////////////////////////////////////////////////////
-void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state)
+void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state, uint8_t hops, int8_t quality)
 {
-    uint8_t i;
-
-    // First look for an existing entry we can update
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    if (state == Invalid)
     {
-	if (_routes[i].dest == dest)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	deleteRouteTo(dest);
+	return;
     }
 
-    // Look for an invalid entry we can use
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    // First look for an existing entry we can update
+    uint8_t i = findRoute(dest);
+    if (i == RH_ROUTING_TABLE_SIZE)
     {
-	if (_routes[i].state == Invalid)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	// Need to make room for a new one?
+	if (_numRoutes >= RH_ROUTING_TABLE_SIZE)
+	    retireOldestRoute();
+	// Use the first free entry at or after where it hashes to
+	for (i = dest % RH_ROUTING_TABLE_SIZE; _routes[i].state != Invalid; i = (i + 1) % RH_ROUTING_TABLE_SIZE)
+	    ;
+	_numRoutes++;
     }
+    _routes[i].dest = dest;
+    _routes[i].next_hop = next_hop;
+    _routes[i].state = state;
+    _routes[i].hops = hops;
+    _routes[i].quality = quality;
+    _routes[i].updated = _routes[i].used = millis();
+}
 
-    // Need to make room for a new one
-    retireOldestRoute();
-    // Should be an invalid slot now
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+////////////////////////////////////////////////////////////////////
+uint8_t RHRouter::findRoute(uint8_t dest)
+{
+    // Look from where it hashes to, up to the next free entry
+    uint8_t i = dest % RH_ROUTING_TABLE_SIZE;
+    uint8_t n;
+    for (n = 0; n < RH_ROUTING_TABLE_SIZE && _routes[i].state != Invalid; n++)
     {
-	if (_routes[i].state == Invalid)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	}
+	if (_routes[i].dest == dest)
+	    return i;
+	i = (i + 1) % RH_ROUTING_TABLE_SIZE;
     }
+    return RH_ROUTING_TABLE_SIZE;
 }
 
 ////////////////////////////////////////////////////////////////////
 RHRouter::RoutingTableEntry* RHRouter::getRouteTo(uint8_t dest)
 {
-    uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-	if (_routes[i].dest == dest && _routes[i].state != Invalid)
-	    return &_routes[i];
-    return NULL;
+    uint8_t i = findRoute(dest);
+    return i == RH_ROUTING_TABLE_SIZE ? NULL : &_routes[i];
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::deleteRoute(uint8_t index)
 {
-    // Delete a route by copying following routes on top of it
-    memcpy(&_routes[index], &_routes[index+1], 
-	   sizeof(RoutingTableEntry) * (RH_ROUTING_TABLE_SIZE - index - 1));
-    _routes[RH_ROUTING_TABLE_SIZE - 1].state = Invalid;
+    if (_routes[index].state == Invalid)
+	return;
+    _routes[index].state = Invalid;
+    _numRoutes--;
+
+    // Move back any following routes that could no longer be found past the hole,
+    // so there are no free entries between a route and where it hashes to
+    uint8_t hole = index;
+    uint8_t i = index;
+    uint8_t n;
+    for (n = 1; n < RH_ROUTING_TABLE_SIZE; n++)
+    {
+	i = (i + 1) % RH_ROUTING_TABLE_SIZE;
+	if (_routes[i].state == Invalid)
+	    break;
+	uint8_t home = _routes[i].dest % RH_ROUTING_TABLE_SIZE;
+	// Can stay if its home is cyclically after the hole and at or before it
+	if (hole <= i ? (home > hole && home <= i) : (home > hole || home <= i))
+	    continue;
+	_routes[hole] = _routes[i];
+	_routes[i].state = Invalid;
+	hole = i;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -109,13 +124,21 @@ void RHRouter::printRoutingTable()
     uint8_t i;
     for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
     {
+	if (_routes[i].state == Invalid)
+	    continue;
 	Serial.print(i, DEC);
 	Serial.print(" Dest: ");
 	Serial.print(_routes[i].dest, DEC);
 	Serial.print(" Next Hop: ");
 	Serial.print(_routes[i].next_hop, DEC);
 	Serial.print(" State: ");
-	Serial.println(_routes[i].state, DEC);
+	Serial.print(_routes[i].state, DEC);
+	Serial.print(" Hops: ");
+	Serial.print(_routes[i].hops, DEC);
+	Serial.print(" Quality: ");
+	Serial.print(_routes[i].quality, DEC);
+	Serial.print(" Age: ");
+	Serial.println(millis() - _routes[i].updated, DEC);
     }
 #endif
 }
@@ -123,23 +146,26 @@ void RHRouter::printRoutingTable()
 ////////////////////////////////////////////////////////////////////
 bool RHRouter::deleteRouteTo(uint8_t dest)
 {
-    uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-    {
-	if (_routes[i].dest == dest)
-	{
-	    deleteRoute(i);
-	    return true;
-	}
-    }
-    return false;
+    uint8_t i = findRoute(dest);
+    if (i == RH_ROUTING_TABLE_SIZE)
+	return false;
+    deleteRoute(i);
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::retireOldestRoute()
 {
-    // We just obliterate the first in the table and clear the last
-    deleteRoute(0);
+    // Delete the least recently used
+    unsigned long now = millis();
+    uint8_t oldest = RH_ROUTING_TABLE_SIZE;
+    uint8_t i;
+    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+	if (   _routes[i].state != Invalid
+	    && (oldest == RH_ROUTING_TABLE_SIZE || now - _routes[i].used > now - _routes[oldest].used))
+	    oldest = i;
+    if (oldest != RH_ROUTING_TABLE_SIZE)
+	deleteRoute(oldest);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -148,6 +174,7 @@ void RHRouter::clearRoutingTable()
     uint8_t i;
     for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
 	_routes[i].state = Invalid;
+    _numRoutes = 0;
 }
 
 
@@ -159,6 +186,15 @@ uint8_t RHRouter::sendtoWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t fl
 ////////////////////////////////////////////////////////////////////
 // Waits for delivery to the next hop (but not for delivery to the final destination)
 uint8_t RHRouter::sendtoFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t flags)
+{
+    if (((uint16_t)len + sizeof(RoutedMessageHeader)) > _driver.maxMessageLength())
+	return RH_ROUTER_ERROR_INVALID_LENGTH;
+
+    return sendtoFromSourceIdWait(buf, len, dest, source, _lastE2ESequenceNumber++, flags);
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHRouter::sendtoFromSourceIdWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t id, uint8_t flags)
 {
     if (((uint16_t)len + sizeof(RoutedMessageHeader)) > _driver.maxMessageLength())
 	return RH_ROUTER_ERROR_INVALID_LENGTH;
@@ -167,7 +203,7 @@ uint8_t RHRouter::sendtoFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest,
     _tmpMessage.header.source = source;
     _tmpMessage.header.dest = dest;
     _tmpMessage.header.hops = 0;
-    _tmpMessage.header.id = _lastE2ESequenceNumber++;
+    _tmpMessage.header.id = id;
     _tmpMessage.header.flags = flags;
     memcpy(_tmpMessage.data, buf, len);
 
@@ -185,6 +221,7 @@ uint8_t RHRouter::route(RoutedMessage* message, uint8_t messageLen)
 	if (!route)
 	    return RH_ROUTER_ERROR_NO_ROUTE;
 	next_hop = route->next_hop;
+	route->used = millis();
     }
 
     if (!RHReliableDatagram::sendtoWait((uint8_t*)message, messageLen, next_hop))
@@ -12,8 +12,16 @@
 // Default max number of hops we will route
 #define RH_DEFAULT_MAX_HOPS 30
 
-// The default size of the routing table we keep
-#define RH_ROUTING_TABLE_SIZE 10
+// The default size of the routing table we keep. Small AVR processors dont have room for many
+// routes, but others can afford one for each node of a good sized mesh.
+// You can define your own before including RHRouter.h
+#ifndef RH_ROUTING_TABLE_SIZE
+ #if (RH_PLATFORM == RH_PLATFORM_ARDUINO) && !defined(__arm__)
+  #define RH_ROUTING_TABLE_SIZE 10
+ #else
+  #define RH_ROUTING_TABLE_SIZE 64
+ #endif
+#endif
 
 // Error codes
 #define RH_ROUTER_ERROR_NONE              0
@@ -90,9 +98,17 @@
 /// You can also use addRouteTo() to change a route and 
 /// deleteRouteTo() to delete a route at run time. Youcan also clear the entire routing table
 ///
-/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which is 10)
-/// if more than RH_ROUTING_TABLE_SIZE are added, the oldest (first) one will be removed by calling 
-/// retireOldestRoute()
+/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which is 10
+/// on small AVR processors and 64 on others). You can define RH_ROUTING_TABLE_SIZE yourself before
+/// including RHRouter.h.
+/// If more than RH_ROUTING_TABLE_SIZE are added, the least recently used one will be removed by calling 
+/// retireOldestRoute(). So in a network bigger than the table, the routes to the nodes this node
+/// actually talks to stay in the table, and those it only learned in passing are dropped first.
+///
+/// The table is a hash table keyed by destination address, so finding a route takes about the same
+/// time however big the table is. As well as the next hop, each route records how many hops away
+/// the destination is and the RSSI of the message the route was learned from, if they are known,
+/// and when the route was last updated and last used. See RoutingTableEntry.
 ///
 /// \par Message Format
 ///
@@ -162,9 +178,13 @@ public:
     /// Defines an entry in the routing table
     typedef struct
     {
-	uint8_t      dest;      ///< Destination node address
-	uint8_t      next_hop;  ///< Send via this next hop address
-	uint8_t      state;     ///< State of this route, one of RouteState
+	uint8_t       dest;      ///< Destination node address
+	uint8_t       next_hop;  ///< Send via this next hop address
+	uint8_t       state;     ///< State of this route, one of RouteState
+	uint8_t       hops;      ///< Number of hops to dest, 1 if next_hop is dest, or 0 if not known
+	int8_t        quality;   ///< RSSI in dBm of the message from next_hop this route was learned from, or 0 if not known
+	unsigned long updated;   ///< millis() when this route was added or last updated. Gives the age of the route
+	unsigned long used;      ///< millis() when this route was last used to send a message, or updated
     } RoutingTableEntry;
 
     /// Constructor. 
@@ -185,11 +205,14 @@ public:
     void setMaxHops(uint8_t max_hops);
 
     /// Adds a route to the local routing table, or updates it if already present.
-    /// If there is not enough room the oldest (first) route will be deleted by calling retireOldestRoute().
+    /// If there is not enough room the least recently used route will be deleted by calling retireOldestRoute().
     /// \param [in] dest The destination node address. RH_BROADCAST_ADDRESS is permitted.
     /// \param [in] next_hop The address of the next hop to send messages destined for dest
-    /// \param [in] state The satte of the route. Defaults to Valid
-    void addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state = Valid);
+    /// \param [in] state The satte of the route. Defaults to Valid. Invalid deletes any route to dest.
+    /// \param [in] hops The number of hops to dest, if known. Defaults to 0, not known
+    /// \param [in] quality The RSSI in dBm of the message the route was learned from, if known. 
+    /// Defaults to 0, not known
+    void addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state = Valid, uint8_t hops = 0, int8_t quality = 0);
 
     /// Finds and returns a RoutingTableEntry for the given destination node
     /// \param [in] dest The desired destination node address.
@@ -201,7 +224,7 @@ public:
     /// \return true if the route was present
     bool deleteRouteTo(uint8_t dest);
 
-    /// Deletes the oldest (first) route from the 
+    /// Deletes the least recently used route from the 
     /// local routing table
     void retireOldestRoute();
 
@@ -299,10 +322,27 @@ protected:
     /// \param [in] messageLen Length of message in octets
     virtual uint8_t route(RoutedMessage* message, uint8_t messageLen);
 
+    /// Similar to sendtoFromSourceWait(), but also sets the end to end ID, instead of using the next 
+    /// from this node. Lets subclasses relay a message on behalf of its originator, keeping the 
+    /// SOURCE and ID that identify it end to end.
+    /// \param [in] buf The application message data.
+    /// \param [in] len Number of octets in the application message data. 0 is permitted.
+    /// \param [in] dest The destination node address.
+    /// \param [in] source The (fake) originating node address.
+    /// \param [in] id The end to end ID.
+    /// \param [in] flags Flags delivered end-to-end to the dest address.
+    /// \return The result code, as for sendtoFromSourceWait()
+    uint8_t sendtoFromSourceIdWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t id, uint8_t flags);
+
     /// Deletes a specific rout entry from therouting table
     /// \param [in] index The 0 based index of the routing table entry to delete
     void deleteRoute(uint8_t index);
 
+    /// Finds the index in the routing table of the route to the given destination
+    /// \param [in] dest The destination node address
+    /// \return The 0 based index of the routing table entry, or RH_ROUTING_TABLE_SIZE if there is none
+    uint8_t findRoute(uint8_t dest);
+
     /// The last end-to-end sequence number to be used
     /// Defaults to 0
     uint8_t _lastE2ESequenceNumber;
@@ -313,11 +353,15 @@ protected:
 
 private:
 
-    /// Temporary mesage buffer
-    static RoutedMessage _tmpMessage;
+    /// Temporary mesage buffer. One for each instance, so several nodes can run in one process
+    RoutedMessage        _tmpMessage;
 
-    /// Local routing table
+    /// Local routing table. A hash table with open addressing. Routes are placed at the
+    /// first free entry at or after their dest modulo RH_ROUTING_TABLE_SIZE
     RoutingTableEntry    _routes[RH_ROUTING_TABLE_SIZE];
+
+    /// Number of valid entries in _routes
+    uint8_t              _numRoutes;
 };
 
 /// @example rf22_router_client.pde
@@ -0,0 +1,576 @@
+// RHWindowedDatagram.cpp
+//
+// Define addressed, reliable datagrams, sent several at a time
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+// (see http://www.hoperf.com)
+
+#include <RHWindowedDatagram.h>
+
+// Bit arrays indexed by node address
+static bool bitIsSet(const uint8_t* bits, uint8_t address)
+{
+    return bits[address >> 3] & (1 << (address & 7));
+}
+
+static void setBit(uint8_t* bits, uint8_t address)
+{
+    bits[address >> 3] |= (1 << (address & 7));
+}
+
+static void clearBit(uint8_t* bits, uint8_t address)
+{
+    bits[address >> 3] &= ~(1 << (address & 7));
+}
+
+////////////////////////////////////////////////////////////////////
+// Constructors
+RHWindowedDatagram::RHWindowedDatagram(RHGenericDriver& driver, uint8_t thisAddress)
+    : RHDatagram(driver, thisAddress)
+{
+    _windowSize = RH_WINDOW_DEFAULT_SIZE;
+    _retries = RH_DEFAULT_RETRIES;
+    _timeout = RH_DEFAULT_TIMEOUT;
+    _retransmissions = 0;
+    _failures = 0;
+    memset(_txNext, 0, sizeof(_txNext));
+    memset(_rxNext, 0, sizeof(_rxNext));
+    memset(_rxMask, 0, sizeof(_rxMask));
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////
+// Public methods
+bool RHWindowedDatagram::init()
+{
+    reset();
+    return RHDatagram::init();
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::reset()
+{
+    uint8_t i;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+	_slots[i].valid = false;
+    // Every destination starts a new sequence with the first message sent to it
+    memset(_txSyn, 0, sizeof(_txSyn));
+    memset(_txLost, 0xff, sizeof(_txLost));
+    _rxBufValid = false;
+    _srtt = 0;
+    _rttvar = 0;
+    _rto = _timeout;
+    _backoff = 0;
+    _backedOffAt = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::setWindowSize(uint8_t size)
+{
+    if (size < 1)
+	size = 1;
+    if (size > RH_WINDOW_MAX_SIZE)
+	size = RH_WINDOW_MAX_SIZE;
+    _windowSize = size;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::setTimeout(uint16_t timeout)
+{
+    _timeout = timeout;
+    if (!_srtt)
+	_rto = timeout;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::setRetries(uint8_t retries)
+{
+    _retries = retries;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHWindowedDatagram::send(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags)
+{
+    if (len == 0 || len > RH_WINDOW_MAX_MESSAGE_LEN || len >= _driver.maxMessageLength())
+	return false;
+#if RH_WINDOW_NODES < 256
+    if (address != RH_BROADCAST_ADDRESS && address >= RH_WINDOW_NODES)
+	return false;
+#endif
+
+    uint8_t i;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+	if (!_slots[i].valid)
+	    break;
+    if (i == RH_WINDOW_MAX_SIZE)
+	return false; // No free transmit buffer
+    WindowSlot* slot = &_slots[i];
+
+    slot->id = 0;
+    if (address != RH_BROADCAST_ADDRESS)
+    {
+	uint8_t oldest;
+	bool busy = oldestTo(address, &oldest);
+	if (bitIsSet(_txLost, address))
+	{
+	    // Wait for the rest of the old sequence to be acknowledged or given up
+	    if (busy)
+		return false;
+	    // Start a new sequence, far enough away from the old one for the receiver to notice.
+	    // Its next expected number is within RH_WINDOW_MAX_SIZE behind _txNext.
+	    _txNext[address] += random(2 * RH_WINDOW_MAX_SIZE + 1, 256 - 2 * RH_WINDOW_MAX_SIZE);
+	    clearBit(_txLost, address);
+	    setBit(_txSyn, address);
+	}
+	else if (busy && (uint8_t)(_txNext[address] - oldest) >= _windowSize)
+	    return false; // Window full
+	slot->id = _txNext[address]++;
+    }
+    slot->to = address;
+    slot->flags = flags & RH_FLAGS_APPLICATION_SPECIFIC;
+    slot->len = len;
+    slot->tries = 0;
+    slot->sent = false;
+    memcpy(slot->data + 1, buf, len);
+    slot->valid = true;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::poll()
+{
+    receive();
+
+    // Give up messages that have had all their retries
+    uint8_t i;
+    unsigned long now = millis();
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* slot = &_slots[i];
+	if (   slot->valid
+	    && slot->sent
+	    && slot->tries > _retries
+	    && (now - slot->sentAt) >= slot->timeout)
+	{
+	    slot->valid = false;
+	    _failures++;
+	    setBit(_txLost, slot->to);
+	}
+    }
+
+    // Start the next transmission, if the transmitter is free
+    if (_driver.mode() == RHGenericDriver::RHModeTx)
+	return;
+    i = nextDue();
+    if (i < RH_WINDOW_MAX_SIZE)
+	transmit(i);
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHWindowedDatagram::flush(uint16_t timeout)
+{
+    unsigned long starttime = millis();
+    while ((millis() - starttime) < timeout)
+    {
+	poll();
+	if (!outstanding())
+	    return true;
+	YIELD;
+    }
+    return !outstanding();
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHWindowedDatagram::outstanding()
+{
+    uint8_t i, count = 0;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+	if (_slots[i].valid)
+	    count++;
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHWindowedDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from, uint8_t* to, uint8_t* id, uint8_t* flags)
+{
+    poll();
+    if (!_rxBufValid)
+	return false;
+    if (from)  *from =  _rxFrom;
+    if (to)    *to =    _rxTo;
+    if (id)    *id =    _rxId;
+    if (flags) *flags = _rxFlags;
+    if (*len > _rxBufLen)
+	*len = _rxBufLen;
+    memcpy(buf, _rxBuf, *len);
+    _rxBufValid = false;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHWindowedDatagram::recvfromAckTimeout(uint8_t* buf, uint8_t* len, uint16_t timeout, uint8_t* from, uint8_t* to, uint8_t* id, uint8_t* flags)
+{
+    unsigned long starttime = millis();
+    while ((millis() - starttime) < timeout)
+    {
+	if (recvfromAck(buf, len, from, to, id, flags))
+	    return true;
+	YIELD;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+uint16_t RHWindowedDatagram::retransmitTimeout()
+{
+    uint32_t timeout = (uint32_t)_rto << _backoff;
+    return timeout > RH_WINDOW_MAX_TIMEOUT ? RH_WINDOW_MAX_TIMEOUT : timeout;
+}
+
+////////////////////////////////////////////////////////////////////
+uint32_t RHWindowedDatagram::retransmissions()
+{
+    return _retransmissions;
+}
+
+////////////////////////////////////////////////////////////////////
+uint32_t RHWindowedDatagram::failures()
+{
+    return _failures;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::resetRetransmissions()
+{
+    _retransmissions = 0;
+    _failures = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+// Protected methods
+void RHWindowedDatagram::receive()
+{
+    if (!available())
+	return;
+
+    // Read into the receive buffer if it is free. Else only an acknowledgement is of any use,
+    // and its payload is 1 octet
+    uint8_t ackBuf[1];
+    uint8_t* buf = _rxBufValid ? ackBuf : _rxBuf;
+    uint8_t len = _rxBufValid ? sizeof(ackBuf) : sizeof(_rxBuf);
+    uint8_t from, to, id, flags;
+    if (!recvfrom(buf, &len, &from, &to, &id, &flags))
+	return;
+
+    if (flags & RH_FLAGS_ACK)
+    {
+#if RH_WINDOW_NODES < 256
+	if (from >= RH_WINDOW_NODES)
+	    return;
+#endif
+	if (to == _thisAddress && len >= 1)
+	    acknowledged(from, id, buf[0]);
+	return;
+    }
+
+    if (to == RH_BROADCAST_ADDRESS)
+    {
+	// Not acknowledged or sequenced
+	if (!_rxBufValid)
+	{
+	    _rxBufLen = len;
+	    _rxFrom = from;
+	    _rxTo = to;
+	    _rxId = id;
+	    _rxFlags = flags & RH_FLAGS_APPLICATION_SPECIFIC;
+	    _rxBufValid = true;
+	}
+	return;
+    }
+    if (to != _thisAddress)
+	return;
+#if RH_WINDOW_NODES < 256
+    if (from >= RH_WINDOW_NODES)
+	return;
+#endif
+
+    if (_rxBufValid)
+    {
+	// No room for it, so tell the sender what we do have. It will send this one again
+	if (!(flags & RH_FLAGS_WINDOW_MORE))
+	    acknowledge(from);
+	return;
+    }
+
+    if (flags & RH_FLAGS_WINDOW_SYN)
+    {
+	if (len < 1)
+	    return;
+	// The first octet is the oldest message the sender still has outstanding
+	int8_t ahead = (int8_t)(_rxBuf[0] - _rxNext[from]);
+	if (ahead > RH_WINDOW_MAX_SIZE || ahead < -RH_WINDOW_MAX_SIZE)
+	{
+	    // A new sequence
+	    _rxNext[from] = _rxBuf[0];
+	    _rxMask[from] = 0;
+	}
+	else if (ahead > 0)
+	{
+	    // The sender has given up the ones before
+	    advance(from, ahead);
+	}
+	len--;
+	memmove(_rxBuf, _rxBuf + 1, len);
+    }
+
+    bool isNew = false;
+    uint8_t ahead = id - _rxNext[from];
+    uint8_t behind = _rxNext[from] - id;
+    if (ahead == 0)
+    {
+	isNew = true;
+	advance(from, 1);
+    }
+    else if (ahead <= RH_WINDOW_MAX_SIZE)
+    {
+	uint8_t bit = 1 << (ahead - 1);
+	isNew = !(_rxMask[from] & bit);
+	_rxMask[from] |= bit;
+    }
+    else if (behind > RH_WINDOW_MAX_SIZE)
+    {
+	// Outside the window: from a sequence we do not know. Ignore it until the sender starts a new one
+	return;
+    }
+    // Else a duplicate, because our acknowledgement was lost. Acknowledge it again
+
+    if (isNew)
+    {
+	_rxBufLen = len;
+	_rxFrom = from;
+	_rxTo = to;
+	_rxId = id;
+	_rxFlags = flags & RH_FLAGS_APPLICATION_SPECIFIC;
+	_rxBufValid = true;
+    }
+    if (!(flags & RH_FLAGS_WINDOW_MORE))
+	acknowledge(from);
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::advance(uint8_t from, uint8_t count)
+{
+    // Step past count messages, then past any that had already been received after them
+    uint8_t next = _rxNext[from];
+    uint8_t mask = _rxMask[from];
+    bool have = false;
+    while (count || have)
+    {
+	if (count)
+	    count--;
+	have = mask & 1;
+	mask >>= 1;
+	next++;
+    }
+    _rxNext[from] = next;
+    _rxMask[from] = mask;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::acknowledged(uint8_t from, uint8_t next, uint8_t mask)
+{
+    uint8_t i;
+    bool any = false;
+    unsigned long latest = 0;
+    uint8_t latestTries = 0;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* slot = &_slots[i];
+	if (!slot->valid || !slot->sent || slot->to != from)
+	    continue;
+	uint8_t ahead = slot->id - next;
+	uint8_t behind = next - slot->id;
+	if (   (behind >= 1 && behind <= RH_WINDOW_MAX_SIZE)
+	    || (ahead >= 1 && ahead <= RH_WINDOW_MAX_SIZE && (mask & (1 << (ahead - 1)))))
+	{
+	    if (!any || (long)(slot->sentAt - latest) > 0)
+	    {
+		latest = slot->sentAt;
+		latestTries = slot->tries;
+	    }
+	    slot->valid = false;
+	    any = true;
+	}
+    }
+    if (!any)
+	return;
+
+    // The receiver is following this sequence
+    clearBit(_txSyn, from);
+    clearBit(_txLost, from);
+
+    // The acknowledgement answers the latest message it acknowledges. Unless that was retransmitted,
+    // when we cannot know which transmission was acknowledged
+    if (latestTries != 1)
+	return;
+    measured(millis() - latest);
+
+    // Messages are received in the order they are sent, so any sent before that one
+    // and still unacknowledged were lost. Send them again without waiting for the timeout
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* slot = &_slots[i];
+	if (slot->valid && slot->sent && slot->to == from && (long)(latest - slot->sentAt) > 0)
+	    slot->timeout = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::acknowledge(uint8_t to)
+{
+    setHeaderId(_rxNext[to]);
+    setHeaderFlags(RH_FLAGS_ACK, RH_FLAGS_RESERVED | RH_FLAGS_APPLICATION_SPECIFIC);
+    sendto(&_rxMask[to], 1, to);
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHWindowedDatagram::nextDue(uint8_t exclude)
+{
+    uint8_t i;
+    uint8_t best = RH_WINDOW_MAX_SIZE;
+    uint8_t bestAge = 0;
+    unsigned long now = millis();
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* slot = &_slots[i];
+	if (!slot->valid || i == exclude)
+	    continue;
+	if (slot->sent && (slot->tries > _retries || (now - slot->sentAt) < slot->timeout))
+	    continue;
+	// Broadcasts first, then the oldest sequence numbers
+	uint8_t age = (slot->to == RH_BROADCAST_ADDRESS) ? 255 : (uint8_t)(_txNext[slot->to] - slot->id);
+	if (best == RH_WINDOW_MAX_SIZE || age > bestAge)
+	{
+	    best = i;
+	    bestAge = age;
+	}
+    }
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::transmit(uint8_t index)
+{
+    WindowSlot* slot = &_slots[index];
+    uint8_t flags = slot->flags;
+    uint8_t* data = slot->data + 1;
+    uint8_t len = slot->len;
+    if (slot->to != RH_BROADCAST_ADDRESS)
+    {
+	// Tell the receiver to hold its acknowledgement if the next transmission is to it too
+	uint8_t next = nextDue(index);
+	if (next < RH_WINDOW_MAX_SIZE && _slots[next].to == slot->to)
+	    flags |= RH_FLAGS_WINDOW_MORE;
+	if (bitIsSet(_txSyn, slot->to))
+	{
+	    flags |= RH_FLAGS_WINDOW_SYN;
+	    oldestTo(slot->to, &slot->data[0]);
+	    data--;
+	    len++;
+	}
+    }
+    setHeaderId(slot->id);
+    setHeaderFlags(flags, RH_FLAGS_RESERVED | RH_FLAGS_APPLICATION_SPECIFIC);
+    sendto(data, len, slot->to);
+
+    if (slot->to == RH_BROADCAST_ADDRESS)
+    {
+	slot->valid = false; // Never acknowledged
+	return;
+    }
+    unsigned long now = millis();
+    if (slot->sent)
+    {
+	_retransmissions++;
+	// If it timed out, back off exponentially, but only once for all the messages that
+	// timed out with the current timeout
+	if (slot->timeout && (long)(slot->sentAt - _backedOffAt) > 0)
+	{
+	    if (_backoff < RH_WINDOW_MAX_BACKOFF)
+		_backoff++;
+	    _backedOffAt = now;
+	}
+    }
+    slot->sent = true;
+    slot->tries++;
+    slot->sentAt = now;
+    // Add up to a quarter at random to avoid colliding again with another node that timed out
+    // at the same time
+    uint32_t timeout = retransmitTimeout();
+    timeout += timeout * random(0, 256) / 1024;
+    slot->timeout = timeout > RH_WINDOW_MAX_TIMEOUT ? RH_WINDOW_MAX_TIMEOUT : timeout;
+
+    // The acknowledgement of the earlier messages to this node waits for this one, so restart their timeouts
+    uint8_t i;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* other = &_slots[i];
+	if (   other == slot || !other->valid || !other->sent || other->to != slot->to
+	    || (now - other->sentAt) >= other->timeout)
+	    continue; // Not waiting, or already due
+	timeout = now - other->sentAt + slot->timeout;
+	other->timeout = timeout > 0xffff ? 0xffff : timeout;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHWindowedDatagram::oldestTo(uint8_t to, uint8_t* oldest)
+{
+    uint8_t i;
+    bool found = false;
+    uint8_t oldestAge = 0;
+    for (i = 0; i < RH_WINDOW_MAX_SIZE; i++)
+    {
+	WindowSlot* slot = &_slots[i];
+	if (!slot->valid || slot->to != to)
+	    continue;
+	uint8_t age = _txNext[to] - slot->id;
+	if (!found || age > oldestAge)
+	{
+	    *oldest = slot->id;
+	    oldestAge = age;
+	    found = true;
+	}
+    }
+    return found;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHWindowedDatagram::measured(uint16_t rtt)
+{
+    if (rtt < 1)
+	rtt = 1;
+    if (rtt > RH_WINDOW_MAX_TIMEOUT)
+	rtt = RH_WINDOW_MAX_TIMEOUT;
+    // As TCP: srtt = 7/8 srtt + 1/8 rtt and rttvar = 3/4 rttvar + 1/4 |srtt - rtt|, in fixed point
+    if (!_srtt)
+    {
+	_srtt = (uint32_t)rtt << 3;
+	_rttvar = (uint32_t)rtt << 1;
+    }
+    else
+    {
+	int32_t err = (int32_t)rtt - (int32_t)(_srtt >> 3);
+	_srtt += err;
+	if (err < 0)
+	    err = -err;
+	_rttvar += err - (int32_t)(_rttvar >> 2);
+    }
+    uint32_t rto = (_srtt >> 3) + _rttvar;
+    if (rto < RH_WINDOW_MIN_TIMEOUT)
+	rto = RH_WINDOW_MIN_TIMEOUT;
+    if (rto > RH_WINDOW_MAX_TIMEOUT)
+	rto = RH_WINDOW_MAX_TIMEOUT;
+    _rto = rto;
+    _backoff = 0;
+}
@@ -0,0 +1,366 @@
+// RHWindowedDatagram.h
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+
+#ifndef RHWindowedDatagram_h
+#define RHWindowedDatagram_h
+
+#include <RHReliableDatagram.h>
+
+// Flags used by RHWindowedDatagram in the top 4 bits of the FLAGS header, beside RH_FLAGS_ACK.
+// SYN: the first payload octet is the sequence number of the oldest message the sender still has
+// outstanding, so the receiver can (re)synchronise to a new sequence from this sender.
+#define RH_FLAGS_WINDOW_SYN  0x40
+// MORE: the sender has another message for this receiver, and will transmit it straight after this one.
+// The receiver holds back its acknowledgement until the last one of the burst.
+#define RH_FLAGS_WINDOW_MORE 0x20
+
+// The largest number of messages that can be unacknowledged at once to any one node.
+// This is also the number of transmit buffers, shared by all destinations.
+// The acknowledgement carries 8 bits of selective acknowledgements, so it cannot be more than 8
+#define RH_WINDOW_MAX_SIZE 8
+
+// The default window size. Can be reduced at run time with setWindowSize()
+#define RH_WINDOW_DEFAULT_SIZE RH_WINDOW_MAX_SIZE
+
+// The largest message that can be queued by send(). Each of the RH_WINDOW_MAX_SIZE transmit buffers is this
+// big, so reduce it if you are short of RAM, or increase it for radios with long messages, such as RH_RF95.
+#define RH_WINDOW_MAX_MESSAGE_LEN 60
+
+// Sequence numbers are kept for node addresses below RH_WINDOW_NODES, about 3 octets per node.
+// Small AVR processors only have room for a few nodes, but others can keep all 256 addresses.
+// Messages to or from nodes with higher addresses are refused.
+// You can define your own before including RHWindowedDatagram.h
+#ifndef RH_WINDOW_NODES
+ #if (RH_PLATFORM == RH_PLATFORM_ARDUINO) && !defined(__arm__)
+  #define RH_WINDOW_NODES 16
+ #else
+  #define RH_WINDOW_NODES 256
+ #endif
+#endif
+
+// Limits for the adaptive retransmit timeout, in milliseconds
+#define RH_WINDOW_MIN_TIMEOUT 50
+#define RH_WINDOW_MAX_TIMEOUT 10000
+
+// The retransmit timeout doubles at most this many times. Most losses on a radio link are noise or
+// collisions, which waiting longer does not help
+#define RH_WINDOW_MAX_BACKOFF 3
+
+/////////////////////////////////////////////////////////////////////
+/// \class RHWindowedDatagram RHWindowedDatagram.h <RHWindowedDatagram.h>
+/// \brief RHDatagram subclass for sending addressed, acknowledged, retransmitted datagrams
+/// several at a time, without blocking.
+///
+/// Manager class that extends RHDatagram to define addressed, reliable datagrams with a sliding window
+/// of unacknowledged messages and selective retransmission.
+/// Where RHReliableDatagram::sendtoWait() sends one message and then blocks until it is acknowledged,
+/// RHWindowedDatagram::send() queues the message and returns at once. poll() transmits queued messages
+/// as soon as the transmitter is free, up to the window size ahead of the oldest unacknowledged message
+/// to each node, collects acknowledgements and received messages, and retransmits only the messages
+/// that were not acknowledged in time. This keeps the radio busy with data instead of waiting for
+/// acknowledgements, and keeps the CPU free for the application.
+///
+/// You must call poll() (or recvfromAck(), which calls it) frequently, preferably on every pass of your
+/// main loop. Nothing is sent or received between calls.
+///
+/// RHWindowedDatagram only interoperates with other RHWindowedDatagram nodes, not RHReliableDatagram.
+///
+/// \par Sequence numbers
+///
+/// Each node keeps a separate 8 bit sequence number for each node it sends to, and remembers, for each
+/// node that sends to it, the next sequence number it expects and which of the following
+/// RH_WINDOW_MAX_SIZE messages it has already received. This extends the _seenIds duplicate
+/// detection of RHReliableDatagram to a window of messages.
+///
+/// Messages are delivered to the application as they arrive. If a message is lost and retransmitted,
+/// messages sent after it may be delivered before it. Duplicates are never delivered.
+///
+/// A node starts a new sequence to a destination when it first sends to it, and again after a message to
+/// it has failed, and nothing more is outstanding to it. The messages carry the RH_FLAGS_WINDOW_SYN flag
+/// until the first acknowledgement comes back, so a receiver that was reset, or that missed the
+/// failed messages, can follow. The new sequence starts well away from the old one, so the receiver can
+/// tell it is new.
+///
+/// \par Acknowledgements
+///
+/// An acknowledgement consists of a message with:
+/// - TO set to the from address of the acknowledged message(s)
+/// - FROM set to this node address
+/// - ID set to the next sequence number expected from that node: all before it have been received
+///   (cumulative acknowledgement)
+/// - FLAGS with the RH_FLAGS_ACK bit set
+/// - 1 octet of payload, a bitmap of the following messages that have also been received: bit 0
+///   for ID+1, bit 1 for ID+2 etc (selective acknowledgement).
+///
+/// Every acknowledgement carries the complete state, so a lost acknowledgement is made good by the next one.
+///
+/// Since most radios are half-duplex, the receiver does not acknowledge a message with
+/// RH_FLAGS_WINDOW_MORE set, as the sender will be transmitting the next one. It acknowledges the last
+/// message of each burst, and with it all of the burst.
+///
+/// Messages arrive in the order they were sent, so if the latest message an acknowledgement covers
+/// was sent once, any message sent before it, and not covered itself, was lost. The sender retransmits it at once,
+/// without waiting for its timeout.
+///
+/// \par Timeouts
+///
+/// The retransmit timeout adapts to the measured time from transmitting a message to its acknowledgement
+/// (the round trip time), as in TCP: it is the smoothed round trip time plus 4 times its mean deviation,
+/// between RH_WINDOW_MIN_TIMEOUT and RH_WINDOW_MAX_TIMEOUT. Until the first measurement, it is the
+/// timeout set by setTimeout(), which defaults to RH_DEFAULT_TIMEOUT. Each acknowledgement measures
+/// only the latest message it covers, and only if it was sent once. When messages time out, the
+/// timeout doubles, once for all the messages sent with the old one, and stays doubled until a message
+/// is acknowledged first time (Karn's algorithm). It doubles at most RH_WINDOW_MAX_BACKOFF times.
+/// The timeout is randomly lengthened by up to a quarter to avoid repeated collisions. There is one
+/// measurement for the node, whichever nodes it sends to.
+///
+/// The timeouts of the messages outstanding to a node restart whenever another message is sent to it,
+/// as their acknowledgement waits for the end of the burst.
+///
+/// A message that has not been acknowledged after the retries set by setRetries() is given up, and
+/// counted by failures().
+///
+/// \par Memory
+///
+/// RHWindowedDatagram needs RH_WINDOW_MAX_SIZE buffers of RH_WINDOW_MAX_MESSAGE_LEN octets to
+/// transmit, one to receive, and about 3 octets of sequence numbers for each of RH_WINDOW_NODES
+/// addresses: about 1.5 kbytes with the defaults, or 750 octets on small AVR processors, where
+/// RH_WINDOW_NODES is 16 (node addresses 0 to 15). That is still a lot for an Arduino Uno, so reduce
+/// RH_WINDOW_MAX_MESSAGE_LEN if you can. You can define RH_WINDOW_NODES yourself before including
+/// RHWindowedDatagram.h. If RH_ENABLE_AGGREGATION is 1 (see RHDatagram), add the two aggregation buffers
+/// RHDatagram then has: about 2 * RH_AGGREGATE_MAX_LEN octets, 65 on small AVR processors and 510 elsewhere.
+///
+/// \par Testing
+///
+/// The examples simulator_window_client and simulator_window_server measure the throughput of
+/// RHWindowedDatagram on Linux. See RH_TCP.
+class RHWindowedDatagram : public RHDatagram
+{
+public:
+    /// Constructor.
+    /// \param[in] driver The RadioHead driver to use to transport messages.
+    /// \param[in] thisAddress The address to assign to this node. Defaults to 0
+    RHWindowedDatagram(RHGenericDriver& driver, uint8_t thisAddress = 0);
+
+    /// Initialise this instance and the driver connected to it.
+    /// Forgets all queued and received messages and the measured round trip time.
+    bool init();
+
+    /// Sets the number of messages that may be unacknowledged at once to any one node.
+    /// Defaults to RH_WINDOW_DEFAULT_SIZE. A window size of 1 sends one message at a time, as
+    /// RHReliableDatagram does.
+    /// \param[in] size The new window size, 1 to RH_WINDOW_MAX_SIZE
+    void setWindowSize(uint8_t size);
+
+    /// Sets the retransmit timeout to use until the round trip time has been measured, in milliseconds.
+    /// Defaults to RH_DEFAULT_TIMEOUT.
+    /// \param[in] timeout The new timeout in milliseconds
+    void setTimeout(uint16_t timeout);
+
+    /// Sets the maximum number of retries. Defaults to RH_DEFAULT_RETRIES at construction time.
+    /// If set to 0, each message will only ever be sent once.
+    /// \param[in] retries The maximum number a retries.
+    void setRetries(uint8_t retries);
+
+    /// Queues a message for transmission to the given address, and returns without waiting.
+    /// poll() transmits it when the transmitter is free, and retransmits it until it is acknowledged
+    /// or the retries are exhausted.
+    /// Messages to RH_BROADCAST_ADDRESS are sent once and not acknowledged.
+    /// \param[in] buf Pointer to the binary message to send
+    /// \param[in] len Number of octets to send, at most RH_WINDOW_MAX_MESSAGE_LEN, and 1 less than the
+    /// driver's maxMessageLength()
+    /// \param[in] address The address to send the message to
+    /// \param[in] flags Application flags (the lower 4 bits) to deliver with the message
+    /// \return true if the message was queued. false if it is too long, or there is no free transmit
+    /// buffer or the window to address is full: poll() and try again.
+    bool send(uint8_t* buf, uint8_t len, uint8_t address, uint8_t flags = 0);
+
+    /// Does all the work of the window: receives and acknowledges messages, processes acknowledgements,
+    /// gives up messages that have exhausted their retries, and starts the transmission of the
+    /// next message that is due, if the transmitter is free. Never blocks.
+    /// Call this frequently.
+    void poll();
+
+    /// Polls until all queued messages have been acknowledged or given up, or the timeout expires.
+    /// \param[in] timeout Maximum time to wait in milliseconds
+    /// \return true if nothing is left outstanding
+    bool flush(uint16_t timeout);
+
+    /// Returns the number of queued messages not yet acknowledged or given up
+    /// \return The number of messages outstanding
+    uint8_t outstanding();
+
+    /// Calls poll(), then if a message has been received for this node, copy it to buf and return true,
+    /// else return false. The message has already been acknowledged (unless it was broadcast).
+    /// If a message is copied, *len is set to the length.
+    /// Only one received message is held, so call this often enough to collect messages as
+    /// they come: while a message is waiting to be collected, further messages are not acknowledged,
+    /// and are retransmitted by their senders.
+    /// \param[in] buf Location to copy the received message
+    /// \param[in,out] len Available space in buf. Set to the actual number of octets copied.
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the FROM address
+    /// \param[in] to If present and not NULL, the referenced uint8_t will be set to the TO address
+    /// \param[in] id If present and not NULL, the referenced uint8_t will be set to the sequence number
+    /// \param[in] flags If present and not NULL, the referenced uint8_t will be set to the application FLAGS
+    /// \return true if a message was copied to buf
+    bool recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from = NULL, uint8_t* to = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
+
+    /// Similar to recvfromAck(), but polls until a message is received for this node or the timeout expires.
+    /// \param[in] buf Location to copy the received message
+    /// \param[in,out] len Available space in buf. Set to the actual number of octets copied.
+    /// \param[in] timeout Maximum time to wait in milliseconds
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the FROM address
+    /// \param[in] to If present and not NULL, the referenced uint8_t will be set to the TO address
+    /// \param[in] id If present and not NULL, the referenced uint8_t will be set to the sequence number
+    /// \param[in] flags If present and not NULL, the referenced uint8_t will be set to the application FLAGS
+    /// \return true if a message was copied to buf
+    bool recvfromAckTimeout(uint8_t* buf, uint8_t* len,  uint16_t timeout, uint8_t* from = NULL, uint8_t* to = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
+
+    /// Returns the current retransmit timeout, including any backoff, before randomisation.
+    /// \return The timeout in milliseconds
+    uint16_t retransmitTimeout();
+
+    /// Returns the number of retransmissions
+    /// we have had to send since starting or since the last call to resetRetransmissions().
+    /// \return The number of retransmissions since initialisation.
+    uint32_t retransmissions();
+
+    /// Returns the number of messages given up after exhausting their retries
+    /// since starting or since the last call to resetRetransmissions().
+    /// \return The number of failed messages
+    uint32_t failures();
+
+    /// Resets the count of retransmissions and failures to 0.
+    void resetRetransmissions();
+
+protected:
+    /// \brief A queued message and its transmission state
+    typedef struct
+    {
+	bool          valid;    ///< In use
+	bool          sent;     ///< Transmitted at least once
+	uint8_t       to;       ///< Destination address
+	uint8_t       id;       ///< Sequence number
+	uint8_t       flags;    ///< Application flags
+	uint8_t       tries;    ///< Number of transmissions so far
+	uint8_t       len;      ///< Length of data
+	uint16_t      timeout;  ///< Retransmit timeout of the last transmission, 0 if known to be lost
+	unsigned long sentAt;   ///< millis() at the last transmission
+	uint8_t       data[RH_WINDOW_MAX_MESSAGE_LEN + 1]; ///< Room for the SYN octet, then the message
+    } WindowSlot;
+
+    /// Forgets all queued and received messages and the measured round trip time
+    void reset();
+
+    /// Receives and processes one message from the driver, if there is one
+    void receive();
+
+    /// Moves the next sequence number expected from a node past some messages, and then past any
+    /// that were received after them
+    /// \param[in] from The node address
+    /// \param[in] count The number of messages to step past
+    void advance(uint8_t from, uint8_t count);
+
+    /// Processes an acknowledgement from a node
+    /// \param[in] from The node that sent the acknowledgement
+    /// \param[in] next The next sequence number it expects from us
+    /// \param[in] mask Which of the sequence numbers after next it has received
+    void acknowledged(uint8_t from, uint8_t next, uint8_t mask);
+
+    /// Transmits an acknowledgement of the messages received from a node
+    /// \param[in] to The node to acknowledge
+    void acknowledge(uint8_t to);
+
+    /// Returns the slot to transmit next: a message not yet transmitted or due for retransmission,
+    /// the oldest first.
+    /// \param[in] exclude A slot to disregard
+    /// \return The index of the slot, or RH_WINDOW_MAX_SIZE if none is due
+    uint8_t nextDue(uint8_t exclude = RH_WINDOW_MAX_SIZE);
+
+    /// Transmits a slot and updates its state
+    /// \param[in] index The index of the slot
+    void transmit(uint8_t index);
+
+    /// Returns the oldest sequence number outstanding to a node
+    /// \param[in] to The node address
+    /// \param[out] oldest Set to the oldest sequence number, if there is one
+    /// \return true if anything is outstanding to the node
+    bool oldestTo(uint8_t to, uint8_t* oldest);
+
+    /// Updates the retransmit timeout with a new round trip time measurement
+    /// \param[in] rtt The round trip time in milliseconds
+    void measured(uint16_t rtt);
+
+private:
+    /// The transmit buffers
+    WindowSlot    _slots[RH_WINDOW_MAX_SIZE];
+
+    /// Current window size
+    uint8_t       _windowSize;
+
+    // Retries (0 means one try only)
+    uint8_t       _retries;
+
+    /// Initial retransmit timeout (milliseconds)
+    uint16_t      _timeout;
+
+    /// Smoothed round trip time, 8 times milliseconds. 0 until measured.
+    uint32_t      _srtt;
+
+    /// Mean deviation of the round trip time, 4 times milliseconds
+    uint32_t      _rttvar;
+
+    /// Current retransmit timeout (milliseconds)
+    uint16_t      _rto;
+
+    /// How many times _rto has been doubled since it was last measured
+    uint8_t       _backoff;
+
+    /// millis() when _rto was last doubled
+    unsigned long _backedOffAt;
+
+    /// Count of retransmissions we have had to send
+    uint32_t      _retransmissions;
+
+    /// Count of messages given up
+    uint32_t      _failures;
+
+    /// The next sequence number to send, indexed by destination address
+    uint8_t       _txNext[RH_WINDOW_NODES];
+
+    /// Bits, indexed by destination address: send with RH_FLAGS_WINDOW_SYN, as the node
+    /// has not acknowledged anything since the sequence started
+    uint8_t       _txSyn[(RH_WINDOW_NODES + 7) / 8];
+
+    /// Bits, indexed by destination address: a message failed, start a new sequence when
+    /// nothing is outstanding
+    uint8_t       _txLost[(RH_WINDOW_NODES + 7) / 8];
+
+    /// The next sequence number expected, indexed by source address
+    uint8_t       _rxNext[RH_WINDOW_NODES];
+
+    /// The messages received after the next expected, indexed by source address.
+    /// Bit 0 for _rxNext + 1 etc.
+    uint8_t       _rxMask[RH_WINDOW_NODES];
+
+    /// The received message waiting for recvfromAck(), with room for the SYN octet
+    uint8_t       _rxBuf[RH_WINDOW_MAX_MESSAGE_LEN + 1];
+
+    /// Length of the message in _rxBuf
+    uint8_t       _rxBufLen;
+
+    /// There is a message in _rxBuf
+    bool          _rxBufValid;
+
+    /// Headers of the message in _rxBuf
+    uint8_t       _rxFrom;
+    uint8_t       _rxTo;
+    uint8_t       _rxId;
+    uint8_t       _rxFlags;
+};
+
+/// @example simulator_window_client.pde
+/// @example simulator_window_server.pde
+
+#endif
@@ -21,9 +21,9 @@
 
 RH_TCP::RH_TCP(const char* server)
     : _server(server),
+      _socket(-1),
       _rxBufLen(0),
-      _rxBufValid(false),
-      _socket(-1)
+      _rxBufValid(false)
 {
 }
     
@@ -118,63 +118,67 @@ void RH_TCP::checkForEvents()
     static uint16_t socketBufLen = 0;
 
     // Read at most the amount of space we have left in the buffer
-    ssize_t count = read(_socket, socketBuf + socketBufLen, sizeof(socketBuf) - socketBufLen);
-    if (count < 0)
+    if (socketBufLen < sizeof(socketBuf))
     {
-	if (errno != EAGAIN)
+	ssize_t count = read(_socket, socketBuf + socketBufLen, sizeof(socketBuf) - socketBufLen);
+	if (count < 0)
 	{
-	    fprintf(stderr,"RH_TCP::checkForEvents read error: %s\n", strerror(errno));
+	    if (errno != EAGAIN)
+	    {
+		fprintf(stderr,"RH_TCP::checkForEvents read error: %s\n", strerror(errno));
+		exit(1);
+	    }
+	}
+	else if (count == 0)
+	{
+	    // End of file
+	    fprintf(stderr,"RH_TCP::checkForEvents unexpected end of file on read\n");
 	    exit(1);
 	}
+	else
+	    socketBufLen += count;
     }
-    else if (count == 0)
-    {
-	// End of file
-	fprintf(stderr,"RH_TCP::checkForEvents unexpected end of file on read\n");
-	exit(1);
-    }
-    else
+
+    // Packets that arrived while the last one was still uncollected wait in socketBuf,
+    // as they would in the radio's FIFO, instead of overwriting it
+    while (socketBufLen >= 5 && !_rxBufFull && !_rxBufValid)
     {
-	socketBufLen += count;
-	while (socketBufLen >= 5)
+	RHTcpTypeMessage* message = ((RHTcpTypeMessage*)socketBuf);
+	uint32_t len = ntohl(message->length);
+	uint32_t messageLen = len + sizeof(message->length);
+	if (len > sizeof(socketBuf) - sizeof(message->length))
 	{
-	    RHTcpTypeMessage* message = ((RHTcpTypeMessage*)socketBuf);
-	    uint32_t len = ntohl(message->length);
-	    uint32_t messageLen = len + sizeof(message->length);
-	    if (len > sizeof(socketBuf) - sizeof(message->length))
-	    {
-		// Bogus length
-		fprintf(stderr, "RH_TCP::checkForEvents read ridiculous length: %d. Corrupt message stream? Aborting\n", len);
-		exit(1);
-	    }
-	    if (socketBufLen >= len + sizeof(message->length))
+	    // Bogus length
+	    fprintf(stderr, "RH_TCP::checkForEvents read ridiculous length: %d. Corrupt message stream? Aborting\n", len);
+	    exit(1);
+	}
+	if (socketBufLen < messageLen)
+	    break; // Wait for the rest of this message
+
+	// Got at least all of this message
+	if (message->type == RH_TCP_MESSAGE_TYPE_PACKET && len >= 5)
+	{
+	    // REVISIT: need to check if we are actually receiving?
+	    // Its a new packet, extract the headers and payload
+	    RHTcpPacket* packet = ((RHTcpPacket*)socketBuf);
+	    _rxHeaderTo    = packet->to;
+	    _rxHeaderFrom  = packet->from;
+	    _rxHeaderId    = packet->id;
+	    _rxHeaderFlags = packet->flags;
+	    uint32_t payloadLen = len - 5;
+	    if (payloadLen <= sizeof(_rxBuf))
 	    {
-		// Got at least all of this message
-		if (message->type == RH_TCP_MESSAGE_TYPE_PACKET && len >= 5)
-		{
-		    // REVISIT: need to check if we are actually receiving?
-		    // Its a new packet, extract the headers and payload
-		    RHTcpPacket* packet = ((RHTcpPacket*)socketBuf);
-		    _rxHeaderTo    = packet->to;
-		    _rxHeaderFrom  = packet->from;
-		    _rxHeaderId    = packet->id;
-		    _rxHeaderFlags = packet->flags;
-		    uint32_t payloadLen = len - 5;
-		    if (payloadLen <= sizeof(_rxBuf))
-		    {
-			// Enough room in our receiver buffer
-			memcpy(_rxBuf, packet->payload, payloadLen);
-			_rxBufLen = payloadLen;
-			_rxBufFull = true;
-		    }
-		}
-		// check for other message types here
-		// Now remove the used message by copying the trailing bytes (maybe start of a new message?)
-		// to the top of the buffer
-		memcpy(socketBuf, socketBuf + messageLen, sizeof(socketBuf) - messageLen);
-		socketBufLen -= messageLen;
+		// Enough room in our receiver buffer
+		memcpy(_rxBuf, packet->payload, payloadLen);
+		_rxBufLen = payloadLen;
+		_rxBufFull = true;
 	    }
 	}
+	// check for other message types here
+	// Now remove the used message by copying the trailing bytes (maybe start of a new message?)
+	// to the top of the buffer
+	memmove(socketBuf, socketBuf + messageLen, socketBufLen - messageLen);
+	socketBufLen -= messageLen;
     }
 }
 
@@ -253,14 +257,14 @@ bool RH_TCP::sendPacket(const uint8_t* data, uint8_t len)
     if (_socket < 0)
 	return false;
     RHTcpPacket m;
-    m.length = htonl(len + 4);
+    m.length = htonl(len + 5); // type, to, from, id, flags and the payload
     m.type  = RH_TCP_MESSAGE_TYPE_PACKET;
     m.to    = _txHeaderTo;
     m.from  = _txHeaderFrom;
     m.id    = _txHeaderId;
     m.flags = _txHeaderFlags;
     memcpy(m.payload, data, len);
-    ssize_t sent = write(_socket, &m, len + 8);
+    ssize_t sent = write(_socket, &m, len + 9);
     return sent > 0;
 }
 
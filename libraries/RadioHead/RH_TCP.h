@@ -58,11 +58,25 @@
 /// The simulated sketches send messages out to the 'ether' over the TCP connection to the etherServer.
 /// etherServer manages the delivery of each message to any other RH_TCP sketches that are running.
 ///
+/// tools/etherSimulator.cpp is the same server in C++, for hosts without the Perl POE library.
+/// It takes the same arguments and configuration file. It also sends the messages of each sketch
+/// one after another, and loses a message at a sketch that is transmitting while it arrives,
+/// as a half-duplex radio would. Build it with
+/// \code
+/// g++ -O2 -I . -o etherSimulator tools/etherSimulator.cpp
+/// \endcode
+///
+/// tools/netSimulator.cpp does not use RH_TCP. It runs a whole network of RHMesh, RHRouter
+/// or RHReliableDatagram nodes in one process, on simulated time, with a model of each radio's airtime,
+/// the links between the nodes, collisions and half duplex, and reports how many messages got through,
+/// how long they took and how much airtime they used. So you can test a network of dozens of nodes
+/// for hours in seconds, and repeatably. See the comments in it, and tools/mesh60.conf.
+///
 /// \par Prerequisites
 ///
 /// g++ compiler installed and in your $PATH
 /// Perl
-/// Perl POE library
+/// Perl POE library (not needed for tools/etherSimulator.cpp)
 ///
 class RH_TCP : public RHGenericDriver
 {
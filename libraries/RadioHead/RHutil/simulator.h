@@ -72,6 +72,33 @@ public:
 	print((unsigned int)ch, base);
 	printf("\n");
     }
+    size_t print(int n, int base = DEC)
+    {
+	if (base == DEC)
+	    return printf("%d", n);
+	else if (base == HEX)
+	    return printf("%02x", (unsigned int)n);
+	else if (base == OCT)
+	    return printf("%o", (unsigned int)n);
+	// TODO: BIN
+	return 0;
+    }
+    size_t print(signed char n, int base = DEC)
+    {
+	return print((int)n, base);
+    }
+    size_t println(unsigned long n, int base = DEC)
+    {
+	size_t len = 0;
+	if (base == DEC)
+	    len = printf("%lu", n);
+	else if (base == HEX)
+	    len = printf("%02lx", n);
+	else if (base == OCT)
+	    len = printf("%lo", n);
+	// TODO: BIN
+	return len + printf("\n");
+    }
 
 };
 
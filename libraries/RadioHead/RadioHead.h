@@ -106,6 +106,7 @@
 /// For use with simulated sketches compiled and running on Linux.
 /// Works with tools/etherSimulator.pl to pass messages between simulated sketches, allowing
 /// testing of Manager classes on Linux and without need for real radios or other transport hardware.
+/// tools/netSimulator.cpp simulates whole networks of Manager nodes, with collisions, link loss and airtime.
 ///
 /// Drivers can be used on their own to provide unaddressed, unreliable datagrams. 
 /// All drivers have the same identical API.
@@ -118,11 +119,16 @@
 /// The following Mangers are provided:
 ///
 /// - RHDatagram
-/// Addressed, unreliable variable length messages, with optional broadcast facilities.
+/// Addressed, unreliable variable length messages, with optional broadcast facilities,
+/// and optional aggregation of short messages into shared frames.
 ///
 /// - RHReliableDatagram
 /// Addressed, reliable, retransmitted, acknowledged variable length messages.
 ///
+/// - RHWindowedDatagram
+/// Addressed, reliable messages like RHReliableDatagram, but sent several at a time without blocking,
+/// with selective acknowledgement and retransmission.
+///
 /// - RHRouter
 /// Multi-hop delivery from source node to destination node via 0 or more intermediate nodes, with manual routing.
 ///
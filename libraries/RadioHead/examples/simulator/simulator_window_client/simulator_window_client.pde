@@ -0,0 +1,85 @@
+// simulator_window_client.pde
+// -*- mode: C++ -*-
+// Example sketch showing how to stream addressed, reliable messages
+// with the RHWindowedDatagram class, using the RH_SIMULATOR driver to control a SIMULATOR radio.
+// It sends a number of messages as fast as it can, then reports the throughput.
+// It is designed to work with the other example simulator_window_server
+// Tested on Linux
+// Build with
+// cd whatever/RadioHead 
+// tools/simBuild examples/simulator/simulator_window_client/simulator_window_client.pde
+// Run with ./simulator_window_client [windowsize]
+// A window size of 1 sends one message at a time, as RHReliableDatagram does.
+// Make sure you also have the 'Luminiferous Ether' simulator tools/etherSimulator.pl 
+// or tools/etherSimulator.cpp running, with -b 50000 or more: RH_TCP::send() takes 10ms,
+// which must be long enough for a message to go through the ether
+
+#include <RHWindowedDatagram.h>
+#include <RH_TCP.h>
+
+#define CLIENT_ADDRESS 1
+#define SERVER_ADDRESS 2
+
+// How many messages to send, and how long each is
+#define MESSAGES 200
+#define MESSAGE_LEN 50
+
+// Singleton instance of the radio driver
+RH_TCP driver;
+
+// Class to manage message delivery and receipt, using the driver declared above
+RHWindowedDatagram manager(driver, CLIENT_ADDRESS);
+
+void setup() 
+{
+  Serial.begin(9600);
+  if (!manager.init())
+    Serial.println("init failed");
+
+  // Maybe set the window size from the command line
+  if (_simulator_argc >= 2)
+     manager.setWindowSize(atoi(_simulator_argv[1]));
+}
+
+uint8_t data[MESSAGE_LEN];
+uint16_t sent = 0;
+unsigned long start = 0;
+
+void loop()
+{
+  if (sent == 0)
+    start = millis();
+
+  // Queue as many messages as the window allows
+  while (sent < MESSAGES)
+  {
+    memset(data, 'a' + (sent % 26), sizeof(data));
+    if (!manager.send(data, sizeof(data), SERVER_ADDRESS))
+      break;
+    sent++;
+  }
+  manager.poll();
+
+  if (sent == MESSAGES)
+  {
+    if (!manager.flush(10000))
+      Serial.println("flush failed, is simulator_window_server running?");
+    unsigned long elapsed = millis() - start;
+    Serial.print("sent ");
+    Serial.print((unsigned int)MESSAGES);
+    Serial.print(" messages in ");
+    Serial.print((unsigned int)elapsed);
+    Serial.print(" ms: ");
+    Serial.print((unsigned int)(elapsed ? (unsigned long)MESSAGES * MESSAGE_LEN * 1000 / elapsed : 0));
+    Serial.println(" bytes/s");
+    Serial.print("retransmissions: ");
+    Serial.print((unsigned int)manager.retransmissions());
+    Serial.print(" failures: ");
+    Serial.print((unsigned int)manager.failures());
+    Serial.print(" timeout: ");
+    Serial.print((unsigned int)manager.retransmitTimeout());
+    Serial.println(" ms");
+    exit(0);
+  }
+}
+
@@ -0,0 +1,54 @@
+// simulator_window_server.pde
+// -*- mode: C++ -*-
+// Example sketch showing how to receive a stream of addressed, reliable messages
+// with the RHWindowedDatagram class, using the RH_SIMULATOR driver to control a SIMULATOR radio.
+// It is designed to work with the other example simulator_window_client
+// Tested on Linux
+// Build with
+// cd whatever/RadioHead 
+// tools/simBuild examples/simulator/simulator_window_server/simulator_window_server.pde
+// Run with ./simulator_window_server
+// Make sure you also have the 'Luminiferous Ether' simulator tools/etherSimulator.pl 
+// or tools/etherSimulator.cpp running
+
+#include <RHWindowedDatagram.h>
+#include <RH_TCP.h>
+
+#define CLIENT_ADDRESS 1
+#define SERVER_ADDRESS 2
+
+// Singleton instance of the radio driver
+RH_TCP driver;
+
+// Class to manage message delivery and receipt, using the driver declared above
+RHWindowedDatagram manager(driver, SERVER_ADDRESS);
+
+void setup() 
+{
+  Serial.begin(9600);
+  if (!manager.init())
+    Serial.println("init failed");
+}
+
+// Dont put this on the stack:
+uint8_t buf[RH_WINDOW_MAX_MESSAGE_LEN];
+unsigned int received = 0;
+
+void loop()
+{
+  // Acknowledgements are sent from here too, so call it often
+  uint8_t len = sizeof(buf);
+  uint8_t from;
+  if (manager.recvfromAck(buf, &len, &from))
+  {
+    received++;
+    if (received % 50 == 0)
+    {
+      Serial.print("got ");
+      Serial.print(received);
+      Serial.print(" messages, the last from : 0x");
+      Serial.println(from, HEX);
+    }
+  }
+}
+
@@ -0,0 +1,282 @@
+// etherSimulator.cpp
+// Simulates the luminiferous ether for RH_TCP, as etherSimulator.pl does, without needing Perl POE.
+// Connects multiple instances of RH_TCP clients together and passes simulated messages between them.
+//
+// Build with
+// cd whatever/RadioHead
+// g++ -O2 -I . -o etherSimulator tools/etherSimulator.cpp
+// usage: etherSimulator [-h] [-c configfile] [-b bitspersec] [-p portnumber]
+//
+// The config file is the same as for etherSimulator.pl, see chain.conf.
+//
+// Unlike etherSimulator.pl, each client transmits one message at a time: a message sent while
+// the client is still transmitting the previous one goes on the air when that one ends.
+// A message is lost by a receiver if any other message reaches it while it is in the air,
+// or if the receiver itself is transmitting meanwhile, as with a real half-duplex radio.
+
+#include <stdint.h>
+#include <RHTcpProtocol.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <list>
+#include <map>
+#include <vector>
+
+// A message on its way to one client
+struct Reception
+{
+    double               start;    // Seconds, when it begins to arrive
+    double               end;      // When it has arrived
+    bool                 lost;     // Collided with another, or the receiver was transmitting
+    std::vector<uint8_t> message;  // RHTcpPacket from the type on
+};
+
+// A connected RH_TCP client
+struct Client
+{
+    int                    fd;
+    int                    thisAddress;   // -1 until notified
+    std::vector<uint8_t>   inbuf;
+    std::list<std::pair<double, double> > transmitting; // Start and end times of its transmissions
+    std::list<Reception>   receiving;
+};
+
+static std::list<Client> clients;
+static std::map<int, std::map<int, double> > netconfig;
+static double bps = 10000;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-h] [-c configfile] [-b bitspersec] [-p portnumber]\n", name);
+    exit(1);
+}
+
+// Reads lines of the form probability:nodea:nodeb:probability
+static void readConfig(const char* path)
+{
+    FILE* f = fopen(path, "r");
+    if (!f)
+    {
+	fprintf(stderr, "Could not open config file %s: %s\n", path, strerror(errno));
+	exit(1);
+    }
+    char line[200];
+    while (fgets(line, sizeof(line), f))
+    {
+	int a, b;
+	double p;
+	if (sscanf(line, "probability:%d:%d:%lf", &a, &b, &p) == 3)
+	{
+	    netconfig[a][b] = p;
+	    netconfig[b][a] = p; // Bidirectional
+	}
+    }
+    fclose(f);
+}
+
+// Return true if the message is simulated to have been received successfully
+// taking into account the probability of sucessful delivery
+static bool willDeliverFromTo(int from, int to)
+{
+    if (netconfig.count(from) && netconfig[from].count(to))
+	return drand48() < netconfig[from][to];
+    return true;
+}
+
+static bool overlaps(double start1, double end1, double start2, double end2)
+{
+    return start1 < end2 && start2 < end1;
+}
+
+// A client transmits a packet: it goes on the air after anything it is still transmitting
+static void transmit(Client& sender, const uint8_t* message, uint32_t len)
+{
+    double t = now();
+    double start = t;
+    if (!sender.transmitting.empty() && sender.transmitting.back().second > start)
+	start = sender.transmitting.back().second;
+    // Airtime of the headers and payload, as etherSimulator.pl
+    double end = start + (len - 1) * 8 / bps;
+    sender.transmitting.push_back(std::make_pair(start, end));
+
+    // The sender cannot hear anything while it transmits
+    std::list<Reception>::iterator r;
+    for (r = sender.receiving.begin(); r != sender.receiving.end(); r++)
+	if (overlaps(r->start, r->end, start, end))
+	    r->lost = true;
+
+    std::list<Client>::iterator c;
+    for (c = clients.begin(); c != clients.end(); c++)
+    {
+	if (&*c == &sender)
+	    continue; // Dont deliver back to the same client
+	if (!willDeliverFromTo(sender.thisAddress, c->thisAddress))
+	    continue;
+	Reception reception;
+	reception.start = start;
+	reception.end = end;
+	reception.lost = false;
+	reception.message.assign(message, message + len);
+	// Collisions with other messages reaching this client
+	for (r = c->receiving.begin(); r != c->receiving.end(); r++)
+	    if (overlaps(r->start, r->end, start, end))
+	    {
+		r->lost = true;
+		reception.lost = true;
+	    }
+	// Or the client is transmitting
+	std::list<std::pair<double, double> >::iterator tx;
+	for (tx = c->transmitting.begin(); tx != c->transmitting.end(); tx++)
+	    if (overlaps(tx->first, tx->second, start, end))
+		reception.lost = true;
+	c->receiving.push_back(reception);
+    }
+}
+
+// Handles complete messages in a client's input buffer
+static void clientInput(Client& client)
+{
+    while (client.inbuf.size() >= 4)
+    {
+	uint32_t len = ntohl(*(uint32_t*)&client.inbuf[0]);
+	if (len > sizeof(RHTcpTypeMessage))
+	{
+	    fprintf(stderr, "ridiculous length %u from client, dropping it\n", len);
+	    client.inbuf.clear();
+	    return;
+	}
+	if (client.inbuf.size() < len + 4)
+	    return;
+	const uint8_t* message = &client.inbuf[4];
+	if (len >= 2 && message[0] == RH_TCP_MESSAGE_TYPE_THISADDRESS)
+	    client.thisAddress = message[1];
+	else if (len >= 5 && message[0] == RH_TCP_MESSAGE_TYPE_PACKET)
+	    transmit(client, message, len);
+	client.inbuf.erase(client.inbuf.begin(), client.inbuf.begin() + len + 4);
+    }
+}
+
+// Delivers messages that have finished arriving, and forgets finished transmissions
+static void deliverMessages()
+{
+    double t = now();
+    std::list<Client>::iterator c;
+    for (c = clients.begin(); c != clients.end(); c++)
+    {
+	while (!c->receiving.empty() && c->receiving.front().end <= t)
+	{
+	    // Receptions of later messages may have ended earlier
+	    std::list<Reception>::iterator r;
+	    for (r = c->receiving.begin(); r != c->receiving.end(); )
+	    {
+		if (r->end > t)
+		{
+		    r++;
+		    continue;
+		}
+		if (!r->lost)
+		{
+		    uint32_t len = htonl(r->message.size());
+		    if (   write(c->fd, &len, sizeof(len)) != sizeof(len)
+			|| write(c->fd, &r->message[0], r->message.size()) != (ssize_t)r->message.size())
+			fprintf(stderr, "write to client failed: %s\n", strerror(errno));
+		}
+		r = c->receiving.erase(r);
+	    }
+	}
+	while (!c->transmitting.empty() && c->transmitting.front().second <= t)
+	    c->transmitting.pop_front();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int port = 4000;
+    int opt;
+    while ((opt = getopt(argc, argv, "hc:b:p:")) != -1)
+    {
+	switch (opt)
+	{
+	case 'c': readConfig(optarg); break;
+	case 'b': bps = atof(optarg); break;
+	case 'p': port = atoi(optarg); break;
+	default:  usage(argv[0]);
+	}
+    }
+    if (bps <= 0)
+	usage(argv[0]);
+    srand48(getpid() ^ time(NULL));
+
+    int listener = socket(AF_INET6, SOCK_STREAM, 0);
+    int on = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in6 addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_any;
+    addr.sin6_port = htons(port);
+    if (listener < 0 || bind(listener, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listener, 10) < 0)
+    {
+	fprintf(stderr, "could not listen on port %d: %s\n", port, strerror(errno));
+	return 1;
+    }
+
+    while (1)
+    {
+	std::vector<struct pollfd> fds(1);
+	fds[0].fd = listener;
+	fds[0].events = POLLIN;
+	std::list<Client>::iterator c;
+	for (c = clients.begin(); c != clients.end(); c++)
+	{
+	    struct pollfd p;
+	    p.fd = c->fd;
+	    p.events = POLLIN;
+	    fds.push_back(p);
+	}
+	poll(&fds[0], fds.size(), 1);
+
+	if (fds[0].revents & POLLIN)
+	{
+	    Client client;
+	    client.fd = accept(listener, NULL, NULL);
+	    client.thisAddress = -1;
+	    if (client.fd >= 0)
+		clients.push_back(client);
+	}
+	size_t i = 1;
+	for (c = clients.begin(); c != clients.end() && i < fds.size(); i++)
+	{
+	    if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+	    {
+		uint8_t buf[1000];
+		ssize_t count = read(c->fd, buf, sizeof(buf));
+		if (count <= 0)
+		{
+		    close(c->fd);
+		    c = clients.erase(c);
+		    continue;
+		}
+		c->inbuf.insert(c->inbuf.end(), buf, buf + count);
+		clientInput(*c);
+	    }
+	    c++;
+	}
+	deliverMessages();
+    }
+}
@@ -0,0 +1,1015 @@
+// netSimulator.cpp
+// Runs a whole network of RadioHead nodes in one process, on simulated time, and measures how well
+// their messages get through.
+//
+// Each node is an instance of RHMesh, RHRouter or RHReliableDatagram with a simulated radio.
+// Unlike etherSimulator.pl, which passes messages between separate sketch processes in real time,
+// time here only passes while nodes wait: in millis(), delay(), or polling the radio. So an hour of
+// traffic takes seconds, and the same seed gives the same run.
+//
+// The radios model:
+// - airtime, from the bit rate and packet format (FSK) or the spreading factor, bandwidth and
+//   coding rate (LoRa) of the modem configuration
+// - a link between each pair of nodes, with an RSSI and a probability of losing each packet. Links
+//   may be different in each direction, and come from the config file or from the distance between
+//   nodes
+// - collisions: a packet is lost if another overlaps it at the receiver, unless it is stronger by
+//   the capture threshold
+// - half duplex: a radio hears nothing while it transmits, or before it has been put back into
+//   receive mode afterwards
+//
+// Build with
+// cd whatever/RadioHead
+// g++ -O2 -I . -DRH_ENABLE_AGGREGATION=1 -o netSimulator tools/netSimulator.cpp RHGenericDriver.cpp RHDatagram.cpp RHReliableDatagram.cpp RHRouter.cpp RHMesh.cpp
+// (RH_ENABLE_AGGREGATION is only needed for the aggregate: directive)
+// usage: netSimulator [-h] [-t seconds] [-s seed] [-q microseconds] [-v] configfile
+//   -t simulated time to run, default 600 seconds
+//   -s seed for the random numbers, default 1
+//   -q simulated time each poll of the radio takes, and the time to start transmitting,
+//      default 1000 microseconds. A call to millis() takes 1/16 of it
+//   -v print statistics for each node
+//
+// The config file has one directive on each line. See tools/mesh60.conf.
+// radio:<modem>
+//   RF95:Bw125Cr45Sf128 (the default), RF95:Bw500Cr45Sf128, RF95:Bw31_25Cr48Sf512, RF95:Bw125Cr48Sf4096,
+//   RF69:GFSK_Rb2Fd5, RF69:GFSK_Rb55555Fd50, RF69:GFSK_Rb250Fd250,
+//   RF22:FSK_Rb2_4Fd36, RF22:GFSK_Rb125Fd125,
+//   fsk:<bits per second> or lora:<spreading factor>:<bandwidth Hz>:<coding rate denominator 5-8>
+// manager:<mesh|router|reliable>   default mesh
+// aggregate:<latency ms>   for manager:reliable, send with RHDatagram::queueto() and this latency budget
+// node:<address>[:<x>:<y>]         a node, optionally at x, y metres
+// grid:<first address>:<rows>:<columns>:<spacing metres>   many nodes, on a grid
+// pathloss:<tx power dBm>:<path loss at 1 metre dB>:<exponent>   RSSI from the distance between
+//   nodes that have positions. The loss probability rises from 0 at 6dB above the sensitivity to 1 at it
+// link:<nodea>:<nodeb>:<rssi dBm>[:<loss probability>]   both directions
+// oneway:<from>:<to>:<rssi dBm>[:<loss probability>]     one direction
+// probability:<nodea>:<nodeb>:<delivery probability>     as for etherSimulator.pl
+// default:<rssi dBm>[:<loss probability>] or default:none   for pairs of nodes not otherwise given.
+//   The default is -60dBm and no loss, so every node hears every other, as with etherSimulator.pl
+// capture:<dB>   how much stronger a packet must be to survive a collision, default 6
+// route:<node>:<destination>:<next hop>   a static route, for manager:router
+// traffic:<from|*>:<to|*>:<interval ms>:<length>   from sends length octets to to, every interval
+//   on average. * as from is every node but to, and as to is a different random node each time
+
+#include <RHMesh.h>
+#include <errno.h>
+#include <math.h>
+#include <setjmp.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <queue>
+#include <vector>
+
+SerialSimulator Serial;
+
+int    _simulator_argc;
+char** _simulator_argv;
+
+class Node;
+class SimRadio;
+
+// Simulated time, in microseconds
+static uint64_t now = 0;
+
+// Simulated time each poll of the radio takes
+static uint64_t quantum = 1000;
+
+// The node running, or NULL when the scheduler is
+static Node* current = NULL;
+
+// swapcontext() saves and restores the signal mask with a system call each time, which would take most
+// of the run time. So it only starts each node, and _setjmp()/_longjmp() switch between them after that
+static ucontext_t schedulerContext;
+static jmp_buf    schedulerJump;
+
+// Waits, letting other nodes run, until the simulated time t
+static void waitUntil(uint64_t t);
+
+/////////////////////////////////////////////////////////////////////
+// Arduino functions
+
+unsigned long millis()
+{
+    // A node polling the time is spinning, waiting for something. Spinning loops poll the radio too,
+    // which takes the most time
+    if (current)
+	waitUntil(now + quantum / 16 + 1);
+    return now / 1000;
+}
+
+void delay(unsigned long ms)
+{
+    if (current)
+	waitUntil(now + ms * 1000);
+}
+
+long random(long from, long to)
+{
+    return from + (lrand48() % (to - from));
+}
+
+long random(long to)
+{
+    return random(0, to);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Modem configurations
+
+typedef struct
+{
+    const char* name;
+    bool        lora;
+    uint32_t    bitrate;      // FSK, bits per second
+    uint8_t     sf;           // LoRa spreading factor
+    uint32_t    bandwidth;    // LoRa, Hz
+    uint8_t     cr;           // LoRa coding rate denominator, 5 to 8
+    uint8_t     preamble;     // octets (FSK) or symbols (LoRa)
+    uint8_t     sync;         // FSK sync word octets
+    uint8_t     maxLen;       // Largest message the driver accepts
+    int16_t     sensitivity;  // dBm
+} ModemConfig;
+
+// The RadioHead drivers' own modem configurations
+static const ModemConfig modems[] =
+{
+    { "RF95:Bw125Cr45Sf128",   true,  0,      7,  125000, 5, 8, 0, 251, -123 },
+    { "RF95:Bw500Cr45Sf128",   true,  0,      7,  500000, 5, 8, 0, 251, -117 },
+    { "RF95:Bw31_25Cr48Sf512", true,  0,      9,  31250,  8, 8, 0, 251, -133 },
+    { "RF95:Bw125Cr48Sf4096",  true,  0,      12, 125000, 8, 8, 0, 251, -136 },
+    { "RF69:GFSK_Rb2Fd5",      false, 2000,   0,  0,      0, 4, 2, 60,  -114 },
+    { "RF69:GFSK_Rb55555Fd50", false, 55555,  0,  0,      0, 4, 2, 60,  -100 },
+    { "RF69:GFSK_Rb250Fd250",  false, 250000, 0,  0,      0, 4, 2, 60,  -88  },
+    { "RF22:FSK_Rb2_4Fd36",    false, 2400,   0,  0,      0, 4, 2, 50,  -117 },
+    { "RF22:GFSK_Rb125Fd125",  false, 125000, 0,  0,      0, 4, 2, 50,  -97  },
+};
+
+static ModemConfig modem = modems[0];
+
+// Time on the air of a message of len octets, with the 4 RadioHead header octets, in microseconds
+static uint64_t airtime(uint8_t len)
+{
+    uint32_t payload = len + 4;
+    if (modem.lora)
+    {
+	// As in the Semtech SX1276 datasheet, with explicit header and CRC
+	double symbol = (double)(1 << modem.sf) * 1e6 / modem.bandwidth;
+	bool lowDataRate = symbol > 16000; // As the LowDataRateOptimize recommendation
+	double bits = 8.0 * payload - 4 * modem.sf + 28 + 16;
+	double symbols = ceil(bits / (4 * (modem.sf - (lowDataRate ? 2 : 0)))) * modem.cr;
+	if (symbols < 0)
+	    symbols = 0;
+	return (uint64_t)((modem.preamble + 4.25 + 8 + symbols) * symbol);
+    }
+    // Preamble, sync words, length, headers, payload and CRC
+    uint32_t octets = modem.preamble + modem.sync + 1 + payload + 2;
+    return (uint64_t)octets * 8 * 1000000 / modem.bitrate;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Links between nodes
+
+typedef struct
+{
+    bool   heard;  // In range at all
+    int8_t rssi;   // dBm
+    double loss;   // Probability of losing each packet
+} Link;
+
+static std::map<std::pair<uint8_t, uint8_t>, Link> links; // Given in the config file, by from and to
+static Link defaultLink = { true, -60, 0 };
+static bool   pathLoss = false;
+static double txPower, pathLoss1m, pathLossExponent;
+static int    captureThreshold = 6;
+
+/////////////////////////////////////////////////////////////////////
+// Transmissions in progress
+
+struct Transmission;
+
+// A transmission reaching one radio
+typedef struct
+{
+    Transmission* transmission;
+    SimRadio*     radio;
+    int8_t        rssi;
+    double        loss;
+    bool          lost;
+} Reception;
+
+struct Transmission
+{
+    SimRadio*               sender;
+    uint64_t                end;
+    uint8_t                 to, from, id, flags;
+    uint8_t                 len;
+    uint8_t                 data[RH_MAX_MESSAGE_LEN];
+    std::vector<Reception*> receptions;
+};
+
+// Pending ends of transmissions, earliest first
+typedef std::pair<uint64_t, Transmission*> TransmissionEnd;
+static std::priority_queue<TransmissionEnd, std::vector<TransmissionEnd>, std::greater<TransmissionEnd> > transmissionEnds;
+
+// Counts over the whole network
+static uint32_t framesSent = 0;
+static uint64_t airtimeUsed = 0;
+static uint32_t framesHeard = 0;      // Receptions begun by radios in range
+static uint32_t lostCollision = 0;
+static uint32_t lostNotListening = 0; // The receiver was transmitting or not in receive mode
+static uint32_t lostLink = 0;
+static uint32_t framesReceived = 0;
+
+/////////////////////////////////////////////////////////////////////
+// The simulated radio driver
+
+class SimRadio : public RHGenericDriver
+{
+public:
+    SimRadio(Node* node) : _node(node), _txEnd(0), _bufLen(0), _rxBufValid(false) {}
+
+    virtual bool init()
+    {
+	_mode = RHModeIdle;
+	return true;
+    }
+
+    virtual bool available()
+    {
+	// As the real drivers, back to receive mode as soon as a transmission has finished.
+	// Then a poll takes time
+	if (_mode != RHModeTx)
+	    _mode = RHModeRx;
+	if (current)
+	    waitUntil(now + quantum);
+	return _mode == RHModeRx && _rxBufValid;
+    }
+
+    virtual bool recv(uint8_t* buf, uint8_t* len)
+    {
+	if (!available())
+	    return false;
+	if (buf && len)
+	{
+	    if (*len > _bufLen)
+		*len = _bufLen;
+	    memcpy(buf, _buf, *len);
+	}
+	_rxBufValid = false;
+	return true;
+    }
+
+    virtual bool send(const uint8_t* data, uint8_t len);
+
+    virtual uint8_t maxMessageLength()
+    {
+	return modem.maxLen;
+    }
+
+    virtual bool waitPacketSent()
+    {
+	while (_mode == RHModeTx)
+	    waitUntil(_txEnd);
+	return true;
+    }
+
+    virtual bool waitPacketSent(uint16_t timeout)
+    {
+	uint64_t end = now + (uint64_t)timeout * 1000;
+	while (_mode == RHModeTx && now < end)
+	    waitUntil(std::min(_txEnd, end));
+	return _mode != RHModeTx;
+    }
+
+    // The end of this radio's transmission
+    void sent()
+    {
+	_mode = RHModeIdle;
+    }
+
+    // The end of a transmission that reached this radio
+    void received(Reception* reception);
+
+    Node*                 _node;
+    uint64_t              _txEnd;
+    std::list<Reception*> _receiving;
+    uint8_t               _buf[RH_MAX_MESSAGE_LEN];
+    uint8_t               _bufLen;
+    bool                  _rxBufValid;
+};
+
+/////////////////////////////////////////////////////////////////////
+// Nodes
+
+#define NODE_STACK_SIZE 65536
+
+// Traffic a node sends
+typedef struct
+{
+    int      to;        // Node address, or -1 for a random one each time
+    uint32_t interval;  // Average milliseconds between messages
+    uint8_t  len;
+    uint64_t next;      // When the next message is due
+} Traffic;
+
+// A message sent, by source address and sequence number
+typedef struct
+{
+    uint64_t sentAt;
+    bool     delivered;
+} SentMessage;
+
+static std::map<uint32_t, SentMessage> sentMessages;
+static std::vector<uint32_t> latencies; // Milliseconds
+static uint32_t messagesSent = 0;
+static uint32_t sendFailures = 0;
+static uint32_t messagesDelivered = 0;
+static uint32_t duplicatesDelivered = 0;
+static uint32_t octetsDelivered = 0;
+static std::vector<uint8_t> addresses;
+static int aggregationLatency = -1;   // Milliseconds, or -1 to send each message with sendtoWait()
+
+// Like a sketch running on a node: setup() once, then loop() for ever.
+// Each runs in its own context, so it can block in RadioHead calls while the others run.
+class Node
+{
+public:
+    Node(uint8_t address) : _address(address), _driver(this), _hasPosition(false), _sent(0), _failures(0), _received(0)
+    {
+	_stack = new char[NODE_STACK_SIZE];
+	getcontext(&_context);
+	_context.uc_stack.ss_sp = _stack;
+	_context.uc_stack.ss_size = NODE_STACK_SIZE;
+	_context.uc_link = NULL;
+	makecontext(&_context, run, 0);
+	_started = false;
+	_wakeAt = 0;
+    }
+    virtual ~Node() { delete[] _stack; }
+
+    virtual void setup() = 0;
+
+    // Sends a message to another node, returning true if the manager accepted it
+    virtual bool sendMessage(uint8_t* buf, uint8_t len, uint8_t to) = 0;
+
+    // Receives a message for this node, if there is one, and does what else the manager does
+    // while receiving, such as forwarding
+    virtual bool recvMessage(uint8_t* buf, uint8_t* len, uint8_t* source) = 0;
+
+    void loop();
+
+    // The entry point of every node's context
+    static void run()
+    {
+	current->setup();
+	while (1)
+	    current->loop();
+    }
+
+    uint8_t              _address;
+    SimRadio             _driver;
+    bool                 _hasPosition;
+    double               _x, _y;
+    std::vector<Traffic> _traffic;
+    ucontext_t           _context;
+    jmp_buf              _jump;
+    bool                 _started;
+    char*                _stack;
+    uint64_t             _wakeAt;
+    uint32_t             _sent, _failures, _received;
+};
+
+void Node::loop()
+{
+    uint8_t buf[RH_MAX_MESSAGE_LEN];
+    uint8_t len = sizeof(buf);
+    uint8_t source;
+    if (recvMessage(buf, &len, &source))
+    {
+	_received++;
+	if (len >= 2)
+	{
+	    uint32_t key = ((uint32_t)source << 16) | (buf[0] << 8) | buf[1];
+	    std::map<uint32_t, SentMessage>::iterator m = sentMessages.find(key);
+	    if (m == sentMessages.end())
+		;
+	    else if (m->second.delivered)
+		duplicatesDelivered++;
+	    else
+	    {
+		m->second.delivered = true;
+		messagesDelivered++;
+		octetsDelivered += len;
+		latencies.push_back((now - m->second.sentAt) / 1000);
+	    }
+	}
+    }
+
+    std::vector<Traffic>::iterator t;
+    for (t = _traffic.begin(); t != _traffic.end(); t++)
+    {
+	if (now < t->next)
+	    continue;
+	// Next one at a random time, interval on average
+	t->next = now + (uint64_t)t->interval * (500 + random(1000)) ;
+	uint8_t to = t->to;
+	if (t->to < 0)
+	{
+	    do
+		to = addresses[random(addresses.size())];
+	    while (to == _address);
+	}
+	uint16_t seq = _sent++;
+	memset(buf, 'x', t->len);
+	buf[0] = seq >> 8;
+	buf[1] = seq;
+	SentMessage m = { now, false };
+	sentMessages[((uint32_t)_address << 16) | seq] = m;
+	messagesSent++;
+	if (!sendMessage(buf, t->len, to))
+	{
+	    _failures++;
+	    sendFailures++;
+	}
+    }
+}
+
+class MeshNode : public Node
+{
+public:
+    MeshNode(uint8_t address) : Node(address), _manager(_driver, address) {}
+    virtual void setup() { _manager.init(); }
+    virtual bool sendMessage(uint8_t* buf, uint8_t len, uint8_t to)
+    {
+	return _manager.sendtoWait(buf, len, to) == RH_ROUTER_ERROR_NONE;
+    }
+    virtual bool recvMessage(uint8_t* buf, uint8_t* len, uint8_t* source)
+    {
+	return _manager.recvfromAck(buf, len, source);
+    }
+    RHMesh _manager;
+};
+
+class RouterNode : public Node
+{
+public:
+    RouterNode(uint8_t address) : Node(address), _manager(_driver, address) {}
+    virtual void setup() { _manager.init(); }
+    virtual bool sendMessage(uint8_t* buf, uint8_t len, uint8_t to)
+    {
+	return _manager.sendtoWait(buf, len, to) == RH_ROUTER_ERROR_NONE;
+    }
+    virtual bool recvMessage(uint8_t* buf, uint8_t* len, uint8_t* source)
+    {
+	return _manager.recvfromAck(buf, len, source);
+    }
+    RHRouter _manager;
+};
+
+class ReliableNode : public Node
+{
+public:
+    ReliableNode(uint8_t address) : Node(address), _manager(_driver, address) {}
+    virtual void setup()
+    {
+	_manager.init();
+	if (aggregationLatency >= 0)
+	    _manager.setAggregationLatency(aggregationLatency);
+    }
+    virtual bool sendMessage(uint8_t* buf, uint8_t len, uint8_t to)
+    {
+	if (aggregationLatency >= 0)
+	    return _manager.queueto(buf, len, to);
+	return _manager.sendtoWait(buf, len, to);
+    }
+    virtual bool recvMessage(uint8_t* buf, uint8_t* len, uint8_t* source)
+    {
+	if (aggregationLatency >= 0 && !_manager.pollAggregate())
+	    sendFailures++;
+	return _manager.recvfromAck(buf, len, source);
+    }
+    RHReliableDatagram _manager;
+};
+
+static std::map<uint8_t, Node*> nodes;
+
+/////////////////////////////////////////////////////////////////////
+// Scheduling
+
+// Nodes waiting, earliest first, then in the order they started waiting
+typedef struct
+{
+    uint64_t at;
+    uint64_t order;
+    Node*    node;
+} Wake;
+
+struct WakeLater
+{
+    bool operator()(const Wake& a, const Wake& b) const
+    {
+	return a.at > b.at || (a.at == b.at && a.order > b.order);
+    }
+};
+
+static std::priority_queue<Wake, std::vector<Wake>, WakeLater> wakes;
+static uint64_t wakeOrder = 0;
+
+static void waitUntil(uint64_t t)
+{
+    current->_wakeAt = t;
+    if (!_setjmp(current->_jump))
+	_longjmp(schedulerJump, 1);
+}
+
+/////////////////////////////////////////////////////////////////////
+// The ether
+
+static Link linkBetween(Node* from, Node* to)
+{
+    std::map<std::pair<uint8_t, uint8_t>, Link>::iterator l = links.find(std::make_pair(from->_address, to->_address));
+    if (l != links.end())
+	return l->second;
+    if (pathLoss && from->_hasPosition && to->_hasPosition)
+    {
+	double distance = hypot(from->_x - to->_x, from->_y - to->_y);
+	if (distance < 1)
+	    distance = 1;
+	Link link;
+	double rssi = txPower - pathLoss1m - 10 * pathLossExponent * log10(distance);
+	link.heard = rssi >= modem.sensitivity;
+	link.rssi = rssi < -128 ? -128 : (rssi > 127 ? 127 : (int8_t)rssi);
+	link.loss = rssi >= modem.sensitivity + 6 ? 0 : (modem.sensitivity + 6 - rssi) / 6;
+	return link;
+    }
+    return defaultLink;
+}
+
+// Link quality does not change during a run
+static std::map<std::pair<uint8_t, uint8_t>, Link> linkCache;
+
+static const Link& cachedLink(Node* from, Node* to)
+{
+    std::pair<uint8_t, uint8_t> key = std::make_pair(from->_address, to->_address);
+    std::map<std::pair<uint8_t, uint8_t>, Link>::iterator l = linkCache.find(key);
+    if (l == linkCache.end())
+	l = linkCache.insert(std::make_pair(key, linkBetween(from, to))).first;
+    return l->second;
+}
+
+bool SimRadio::send(const uint8_t* data, uint8_t len)
+{
+    if (len > maxMessageLength())
+	return false;
+    waitPacketSent();
+    // Loading the FIFO and switching the radio to transmit
+    if (current)
+	waitUntil(now + quantum);
+
+    // This radio hears nothing more while it transmits
+    std::list<Reception*>::iterator r;
+    for (r = _receiving.begin(); r != _receiving.end(); r++)
+    {
+	if (!(*r)->lost)
+	{
+	    (*r)->lost = true;
+	    lostNotListening++;
+	}
+    }
+
+    Transmission* transmission = new Transmission;
+    transmission->sender = this;
+    transmission->end = now + airtime(len);
+    transmission->to = _txHeaderTo;
+    transmission->from = _txHeaderFrom;
+    transmission->id = _txHeaderId;
+    transmission->flags = _txHeaderFlags;
+    transmission->len = len;
+    memcpy(transmission->data, data, len);
+    _mode = RHModeTx;
+    _txEnd = transmission->end;
+    framesSent++;
+    airtimeUsed += transmission->end - now;
+    _txGood++;
+
+    std::map<uint8_t, Node*>::iterator n;
+    for (n = nodes.begin(); n != nodes.end(); n++)
+    {
+	SimRadio* radio = &n->second->_driver;
+	if (radio == this)
+	    continue;
+	const Link& link = cachedLink(_node, n->second);
+	if (!link.heard)
+	    continue;
+	framesHeard++;
+	Reception* reception = new Reception;
+	reception->transmission = transmission;
+	reception->radio = radio;
+	reception->rssi = link.rssi;
+	reception->loss = link.loss;
+	reception->lost = false;
+	if (radio->_mode != RHModeRx)
+	{
+	    reception->lost = true;
+	    lostNotListening++;
+	}
+	else
+	{
+	    // Collisions with whatever else this radio is receiving
+	    for (r = radio->_receiving.begin(); r != radio->_receiving.end(); r++)
+	    {
+		Reception* other = *r;
+		if (reception->rssi < other->rssi + captureThreshold && !reception->lost)
+		{
+		    reception->lost = true;
+		    lostCollision++;
+		}
+		if (other->rssi < reception->rssi + captureThreshold && !other->lost)
+		{
+		    other->lost = true;
+		    lostCollision++;
+		}
+	    }
+	}
+	radio->_receiving.push_back(reception);
+	transmission->receptions.push_back(reception);
+    }
+    transmissionEnds.push(std::make_pair(transmission->end, transmission));
+    return true;
+}
+
+void SimRadio::received(Reception* reception)
+{
+    _receiving.remove(reception);
+    if (reception->lost)
+	return;
+    if (reception->loss > 0 && drand48() < reception->loss)
+    {
+	lostLink++;
+	return;
+    }
+    framesReceived++;
+    Transmission* transmission = reception->transmission;
+    _lastRssi = reception->rssi;
+    // As the real drivers: a new packet replaces one not yet collected
+    if (_promiscuous || transmission->to == _thisAddress || transmission->to == RH_BROADCAST_ADDRESS)
+    {
+	_rxHeaderTo = transmission->to;
+	_rxHeaderFrom = transmission->from;
+	_rxHeaderId = transmission->id;
+	_rxHeaderFlags = transmission->flags;
+	memcpy(_buf, transmission->data, transmission->len);
+	_bufLen = transmission->len;
+	_rxBufValid = true;
+	_rxGood++;
+    }
+}
+
+static void endTransmission(Transmission* transmission)
+{
+    transmission->sender->sent();
+    std::vector<Reception*>::iterator r;
+    for (r = transmission->receptions.begin(); r != transmission->receptions.end(); r++)
+    {
+	(*r)->radio->received(*r);
+	delete *r;
+    }
+    delete transmission;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Configuration
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-h] [-t seconds] [-s seed] [-q microseconds] [-v] configfile\n", name);
+    exit(1);
+}
+
+static char managerName[20] = "mesh";
+
+static Node* addNode(int address)
+{
+    if (address < 0 || address >= RH_BROADCAST_ADDRESS)
+    {
+	fprintf(stderr, "bad node address %d\n", address);
+	exit(1);
+    }
+    if (nodes.count(address))
+	return nodes[address];
+    Node* node;
+    if (!strcmp(managerName, "mesh"))
+	node = new MeshNode(address);
+    else if (!strcmp(managerName, "router"))
+	node = new RouterNode(address);
+    else if (!strcmp(managerName, "reliable"))
+	node = new ReliableNode(address);
+    else
+    {
+	fprintf(stderr, "unknown manager %s\n", managerName);
+	exit(1);
+    }
+    nodes[address] = node;
+    addresses.push_back(address);
+    return node;
+}
+
+static void addLink(int from, int to, int rssi, double loss)
+{
+    Link link;
+    link.heard = rssi >= modem.sensitivity;
+    link.rssi = rssi;
+    link.loss = loss;
+    links[std::make_pair((uint8_t)from, (uint8_t)to)] = link;
+}
+
+// Traffic and routes refer to nodes, which may be given later
+typedef struct
+{
+    int from, to, interval, len;
+} TrafficLine;
+
+static void readConfig(const char* path)
+{
+    FILE* f = fopen(path, "r");
+    if (!f)
+    {
+	fprintf(stderr, "Could not open config file %s: %s\n", path, strerror(errno));
+	exit(1);
+    }
+    std::vector<TrafficLine> traffic;
+    std::vector<std::vector<int> > routes;
+    char line[200];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+	lineNumber++;
+	char name[40];
+	int a, b, c, d;
+	double x, y, z;
+	if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+	    continue;
+	else if (sscanf(line, "radio:lora:%d:%d:%d", &a, &b, &c) == 3)
+	{
+	    modem.name = "lora";
+	    modem.lora = true;
+	    modem.sf = a;
+	    modem.bandwidth = b;
+	    modem.cr = c;
+	}
+	else if (sscanf(line, "radio:fsk:%d", &a) == 1)
+	{
+	    modem = modems[4];
+	    modem.name = "fsk";
+	    modem.bitrate = a;
+	}
+	else if (sscanf(line, "radio:%39[^ \t\r\n]", name) == 1)
+	{
+	    size_t i;
+	    for (i = 0; i < sizeof(modems) / sizeof(modems[0]); i++)
+		if (!strcmp(modems[i].name, name))
+		    break;
+	    if (i == sizeof(modems) / sizeof(modems[0]))
+	    {
+		fprintf(stderr, "%s:%d: unknown radio %s\n", path, lineNumber, name);
+		exit(1);
+	    }
+	    modem = modems[i];
+	}
+	else if (sscanf(line, "manager:%19[a-z]", managerName) == 1)
+	    ;
+	else if (sscanf(line, "aggregate:%d", &a) == 1 && a >= 0)
+	{
+#if !RH_ENABLE_AGGREGATION
+	    fprintf(stderr, "%s:%d: aggregate: needs netSimulator built with -DRH_ENABLE_AGGREGATION=1\n", path, lineNumber);
+	    exit(1);
+#endif
+	    aggregationLatency = a;
+	}
+	else if (sscanf(line, "node:%d:%lf:%lf", &a, &x, &y) == 3)
+	{
+	    Node* node = addNode(a);
+	    node->_hasPosition = true;
+	    node->_x = x;
+	    node->_y = y;
+	}
+	else if (sscanf(line, "node:%d", &a) == 1)
+	    addNode(a);
+	else if (sscanf(line, "grid:%d:%d:%d:%lf", &a, &b, &c, &x) == 4)
+	{
+	    int row, column;
+	    for (row = 0; row < b; row++)
+		for (column = 0; column < c; column++)
+		{
+		    Node* node = addNode(a + row * c + column);
+		    node->_hasPosition = true;
+		    node->_x = column * x;
+		    node->_y = row * x;
+		}
+	}
+	else if (sscanf(line, "pathloss:%lf:%lf:%lf", &x, &y, &z) == 3)
+	{
+	    pathLoss = true;
+	    txPower = x;
+	    pathLoss1m = y;
+	    pathLossExponent = z;
+	}
+	else if (sscanf(line, "link:%d:%d:%d:%lf", &a, &b, &c, &x) >= 3)
+	{
+	    if (sscanf(line, "link:%d:%d:%d:%lf", &a, &b, &c, &x) == 3)
+		x = 0;
+	    addLink(a, b, c, x);
+	    addLink(b, a, c, x);
+	}
+	else if (sscanf(line, "oneway:%d:%d:%d:%lf", &a, &b, &c, &x) >= 3)
+	{
+	    if (sscanf(line, "oneway:%d:%d:%d:%lf", &a, &b, &c, &x) == 3)
+		x = 0;
+	    addLink(a, b, c, x);
+	}
+	else if (sscanf(line, "probability:%d:%d:%lf", &a, &b, &x) == 3)
+	{
+	    addLink(a, b, defaultLink.rssi, 1 - x);
+	    addLink(b, a, defaultLink.rssi, 1 - x);
+	}
+	else if (!strncmp(line, "default:none", 12))
+	    defaultLink.heard = false;
+	else if (sscanf(line, "default:%d:%lf", &a, &x) >= 1)
+	{
+	    if (sscanf(line, "default:%d:%lf", &a, &x) == 1)
+		x = 0;
+	    defaultLink.heard = a >= modem.sensitivity;
+	    defaultLink.rssi = a;
+	    defaultLink.loss = x;
+	}
+	else if (sscanf(line, "capture:%d", &a) == 1)
+	    captureThreshold = a;
+	else if (sscanf(line, "route:%d:%d:%d", &a, &b, &c) == 3)
+	{
+	    std::vector<int> route;
+	    route.push_back(a);
+	    route.push_back(b);
+	    route.push_back(c);
+	    routes.push_back(route);
+	}
+	else if (sscanf(line, "traffic:%39[^:]:%d:%d:%d", name, &b, &c, &d) == 4
+		 || sscanf(line, "traffic:%39[^:]:*:%d:%d", name, &c, &d) == 3)
+	{
+	    TrafficLine t;
+	    t.from = strcmp(name, "*") ? atoi(name) : -1;
+	    t.to = strstr(line + 8, ":*:") == line + 8 + strlen(name) ? -1 : b;
+	    t.interval = c;
+	    t.len = d;
+	    traffic.push_back(t);
+	}
+	else
+	{
+	    fprintf(stderr, "%s:%d: cannot understand %s", path, lineNumber, line);
+	    exit(1);
+	}
+    }
+    fclose(f);
+
+    if (nodes.size() < 2)
+    {
+	fprintf(stderr, "%s: need at least 2 nodes\n", path);
+	exit(1);
+    }
+    size_t i;
+    for (i = 0; i < routes.size(); i++)
+    {
+	RouterNode* node = dynamic_cast<RouterNode*>(nodes.count(routes[i][0]) ? nodes[routes[i][0]] : NULL);
+	if (node)
+	    node->_manager.addRouteTo(routes[i][1], routes[i][2]);
+    }
+    // Leave room for the RHRouter and RHMesh headers
+    uint8_t maxLen = modem.maxLen - sizeof(RHRouter::RoutedMessageHeader) - sizeof(RHMesh::MeshMessageHeader);
+    for (i = 0; i < traffic.size(); i++)
+    {
+	TrafficLine& t = traffic[i];
+	if (t.len < 2 || t.len > maxLen || t.interval < 1)
+	{
+	    fprintf(stderr, "%s: traffic length must be 2 to %d octets, and the interval at least 1ms\n", path, maxLen);
+	    exit(1);
+	}
+	std::map<uint8_t, Node*>::iterator n;
+	for (n = nodes.begin(); n != nodes.end(); n++)
+	{
+	    if (t.from >= 0 ? n->first != t.from : n->first == t.to)
+		continue;
+	    Traffic traffic;
+	    traffic.to = t.to;
+	    traffic.interval = t.interval;
+	    traffic.len = t.len;
+	    // The first at a random time in the first interval
+	    traffic.next = (uint64_t)random(t.interval) * 1000;
+	    n->second->_traffic.push_back(traffic);
+	}
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+// Results
+
+static uint32_t percentile(std::vector<uint32_t>& sorted, int percent)
+{
+    return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+static void report(bool verbose)
+{
+    printf("%u nodes, %s, %s, %.3f s simulated\n", (unsigned)nodes.size(), managerName, modem.name, now / 1e6);
+    printf("messages: %u sent, %u delivered (%.1f%%), %u sends failed, %u duplicates\n",
+	   messagesSent, messagesDelivered, messagesSent ? 100.0 * messagesDelivered / messagesSent : 0,
+	   sendFailures, duplicatesDelivered);
+    if (latencies.size())
+    {
+	std::sort(latencies.begin(), latencies.end());
+	printf("latency ms: min %u, median %u, 90%% %u, 99%% %u, max %u\n",
+	       latencies[0], percentile(latencies, 50), percentile(latencies, 90),
+	       percentile(latencies, 99), latencies[latencies.size() - 1]);
+    }
+    printf("frames: %u sent, %u heard, of which lost: %u to collisions, %u not listening, %u to link loss\n",
+	   framesSent, framesHeard, lostCollision, lostNotListening, lostLink);
+    printf("airtime: %.3f s, %.2f ms per octet delivered\n",
+	   airtimeUsed / 1e6, octetsDelivered ? airtimeUsed / 1e3 / octetsDelivered : 0);
+    if (verbose)
+    {
+	std::map<uint8_t, Node*>::iterator n;
+	for (n = nodes.begin(); n != nodes.end(); n++)
+	{
+	    Node* node = n->second;
+	    printf("node %u: %u sent, %u failed, %u received, %u frames sent, %u frames received\n",
+		   n->first, node->_sent, node->_failures, node->_received,
+		   node->_driver.txGood(), node->_driver.rxGood());
+	}
+    }
+}
+
+int main(int argc, char** argv)
+{
+    _simulator_argc = argc;
+    _simulator_argv = argv;
+    double seconds = 600;
+    long seed = 1;
+    bool verbose = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "ht:s:q:v")) != -1)
+    {
+	switch (opt)
+	{
+	case 't': seconds = atof(optarg); break;
+	case 's': seed = atol(optarg); break;
+	case 'q': quantum = atol(optarg); break;
+	case 'v': verbose = true; break;
+	default:  usage(argv[0]);
+	}
+    }
+    if (optind != argc - 1 || quantum < 1)
+	usage(argv[0]);
+    srand48(seed);
+    readConfig(argv[optind]);
+
+    std::map<uint8_t, Node*>::iterator n;
+    for (n = nodes.begin(); n != nodes.end(); n++)
+    {
+	Wake wake = { 0, wakeOrder++, n->second };
+	wakes.push(wake);
+    }
+
+    uint64_t end = (uint64_t)(seconds * 1e6);
+    while (1)
+    {
+	Wake wake = wakes.top();
+	if (!transmissionEnds.empty() && transmissionEnds.top().first <= wake.at)
+	{
+	    now = transmissionEnds.top().first;
+	    Transmission* transmission = transmissionEnds.top().second;
+	    transmissionEnds.pop();
+	    endTransmission(transmission);
+	    continue;
+	}
+	if (wake.at > end)
+	    break;
+	wakes.pop();
+	now = wake.at;
+	current = wake.node;
+	if (!_setjmp(schedulerJump))
+	{
+	    if (current->_started)
+		_longjmp(current->_jump, 1);
+	    current->_started = true;
+	    swapcontext(&schedulerContext, &current->_context);
+	}
+	wake.at = current->_wakeAt;
+	wake.order = wakeOrder++;
+	wakes.push(wake);
+	current = NULL;
+    }
+    now = end;
+    report(verbose);
+    return 0;
+}